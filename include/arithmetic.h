@@ -4,6 +4,8 @@
  *
  * Provides arithmetic expansion using the shunting yard algorithm.
  * Supports all POSIX arithmetic operators, variables, and proper error handling.
+ * Expressions are compiled to postfix programs that are cached by text, so
+ * repeated evaluation of the same expression skips tokenizing and parsing.
  *
  * @author Michael Berry <trismegustis@gmail.com>
  * @copyright Copyright (C) 2021-2026 Michael Berry
@@ -53,6 +55,59 @@ char *arithm_expand(const char *orig_expr);
 typedef struct executor executor_t;
 char *arithm_expand_with_executor(executor_t *executor, const char *orig_expr);
 
+/** @brief Compiled arithmetic expression (opaque) */
+typedef struct arithm_program arithm_program_t;
+
+/**
+ * @brief Compiled program cache statistics
+ */
+typedef struct arithm_cache_stats {
+    unsigned long hits;    /**< Evaluations that reused a compiled program */
+    unsigned long misses;  /**< Evaluations that compiled the text */
+    unsigned long flushes; /**< Times the full cache was emptied */
+    size_t entries;        /**< Programs currently cached */
+} arithm_cache_stats_t;
+
+/**
+ * @brief Compile an arithmetic expression
+ *
+ * Parse errors do not fail compilation: they are recorded in the program
+ * and raised when evaluation reaches them, after any side effects that
+ * precede them in the expression.
+ *
+ * @param orig_expr Arithmetic expression string (with or without $(( )) wrapper)
+ * @return Compiled program (free with arithm_program_free), or NULL on
+ *         allocation failure
+ */
+arithm_program_t *arithm_compile(const char *orig_expr);
+
+/**
+ * @brief Evaluate a compiled arithmetic expression
+ *
+ * Variables are looked up and assigned through the executor's symbol
+ * table when one is given, otherwise through the global symbol table.
+ *
+ * @param executor Executor context for scoped variable resolution (may be NULL)
+ * @param program Compiled program
+ * @return String representation of the result, or NULL on error
+ */
+char *arithm_program_eval(executor_t *executor,
+                          const arithm_program_t *program);
+
+/**
+ * @brief Free a compiled arithmetic expression
+ *
+ * @param program Program to free (NULL is safely ignored)
+ */
+void arithm_program_free(arithm_program_t *program);
+
+/**
+ * @brief Get compiled program cache statistics
+ *
+ * @param stats Output statistics
+ */
+void arithm_get_cache_stats(arithm_cache_stats_t *stats);
+
 /**
  * @brief Initialize the arithmetic expansion module
  *
@@ -64,7 +119,8 @@ void arithm_init(void);
 /**
  * @brief Clean up arithmetic expansion module resources
  *
- * Call this during shell shutdown to free any allocated resources.
+ * Call this during shell shutdown to free any allocated resources,
+ * including the compiled program cache.
  */
 void arithm_cleanup(void);
 
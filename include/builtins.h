@@ -412,15 +412,9 @@ int bin_popd(int argc, char **argv);
 int bin_dirs(int argc, char **argv);
 
 /* ============================================================================
- * Command Hash Table
+ * Command Lookup
  * ============================================================================ */
 
-/** @brief Initialize the command hash table */
-void init_command_hash(void);
-
-/** @brief Free the command hash table */
-void free_command_hash(void);
-
 /**
  * @brief Check if a command is a builtin
  *
@@ -434,12 +428,12 @@ bool is_builtin(const char *name);
 /**
  * @brief Find a command in PATH
  *
+ * Uncached search of the shell's PATH; see command_hash_lookup() for the
+ * remembering variant used to execute commands.
+ *
  * @param command Command name to search for
  * @return Full path or NULL (caller must free)
  */
 char *find_command_in_path(const char *command);
 
-/** Command hash table for PATH caching */
-extern ht_strstr_t *command_hash;
-
 #endif
@@ -0,0 +1,103 @@
+/**
+ * @file command_hash.h
+ * @brief Remembered command locations used for exec resolution
+ *
+ * Maps command names to the absolute path found by a PATH search so that
+ * repeated commands skip the search and are executed directly from the
+ * remembered path. This is the table behind the POSIX hash builtin.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#ifndef COMMAND_HASH_H
+#define COMMAND_HASH_H
+
+#include <stdio.h>
+
+/**
+ * @brief Command hash statistics
+ */
+typedef struct command_hash_stats {
+    unsigned long hits;          /**< Lookups answered from the table */
+    unsigned long misses;        /**< Lookups that searched PATH */
+    unsigned long invalidations; /**< Table flushes (PATH or dir changed) */
+    unsigned long entries;       /**< Currently remembered commands */
+    unsigned long path_generation; /**< Distinct PATH values seen */
+} command_hash_stats_t;
+
+/** @brief Initialize the command hash table */
+void init_command_hash(void);
+
+/** @brief Free the command hash table */
+void free_command_hash(void);
+
+/**
+ * @brief Resolve a command name to an absolute path
+ *
+ * Returns the remembered location when it is still valid, otherwise
+ * searches the shell's PATH and, if hashall is enabled, remembers the
+ * result. The table is flushed whenever PATH changes or the mtime of a
+ * PATH directory changes. Names containing a slash are returned as-is
+ * if they exist.
+ *
+ * @param command Command name
+ * @return Newly allocated path (caller must free), or NULL if not found
+ */
+char *command_hash_lookup(const char *command);
+
+/**
+ * @brief Get the PATH commands are searched in
+ *
+ * Uses the shell variable so plain assignments take effect, falling back
+ * to the environment when the shell has no PATH variable.
+ *
+ * @return PATH value (borrowed), or NULL if there is none
+ */
+const char *command_search_path(void);
+
+/**
+ * @brief Search a colon-separated directory list for an executable
+ *
+ * Performs an uncached search; empty list entries are skipped.
+ *
+ * @param command Command name (must not contain a slash)
+ * @param search_path Colon-separated directory list
+ * @return Newly allocated path (caller must free), or NULL if not found
+ */
+char *command_path_search(const char *command, const char *search_path);
+
+/**
+ * @brief Search PATH for a command and remember its location
+ *
+ * @param command Command name
+ * @return 0 on success, -1 if the command was not found
+ */
+int command_hash_remember(const char *command);
+
+/**
+ * @brief Get the remembered location of a command without searching
+ *
+ * @param command Command name
+ * @return Remembered path (borrowed), or NULL if not remembered
+ */
+const char *command_hash_get(const char *command);
+
+/** @brief Forget all remembered locations */
+void command_hash_clear(void);
+
+/**
+ * @brief Print remembered locations as "name<TAB>path" lines
+ *
+ * @param out Output stream
+ */
+void command_hash_print(FILE *out);
+
+/**
+ * @brief Get command hash statistics
+ *
+ * @param stats Output statistics
+ */
+void command_hash_get_stats(command_hash_stats_t *stats);
+
+#endif /* COMMAND_HASH_H */
@@ -171,6 +171,7 @@ typedef struct {
     bool lle_dedup_unicode_normalize;            /**< Use Unicode NFC normalization */
     bool lle_enable_history_cache;               /**< Enable history cache */
     int lle_cache_size;                          /**< Cache size */
+    bool lle_lazy_history;                       /**< Decode history on use */
     bool lle_readline_compatible_mode;           /**< Readline compatibility mode */
 
     /* Completion settings */
@@ -248,6 +249,9 @@ typedef struct {
 
     /* Script execution control */
     bool script_execution; /**< Enable script execution */
+    bool script_parse_whole; /**< Parse sourced files and scripts whole */
+    bool script_ast_cache;   /**< Reuse ASTs of unchanged sourced files */
+    bool script_parse_cache; /**< Keep parsed startup files on disk */
 
     /* Shell mode settings (Phase 0: Extended Language Support) */
     int shell_mode;            /**< Shell mode: 0=posix, 1=bash, 2=zsh, 3=lush */
@@ -49,6 +49,7 @@ typedef enum {
 #define THEME_NAME_MAX 64
 #include "composition_engine.h"
 #include "layer_events.h"
+#include "output_frame.h"
 #include "terminal_control.h"
 
 #include <stdbool.h>
@@ -283,6 +284,9 @@ typedef struct {
     lle_notification_state_t notification_copy;  // Copy of notification data
     bool notification_visible;   // Notification visibility state
     bool notification_state_changed; // Flag: notification changed, needs redraw
+
+    // Terminal output (one write per redraw)
+    output_frame_t output_frame; // Redraw output collected before writing
 } display_controller_t;
 
 // ============================================================================
@@ -663,6 +667,37 @@ bool display_controller_has_notification(const display_controller_t *controller)
 bool display_controller_check_and_clear_notification_changed(
     display_controller_t *controller);
 
+// ============================================================================
+// TERMINAL OUTPUT
+// ============================================================================
+
+/**
+ * Enable or disable synchronized output.
+ *
+ * When enabled, each redraw frame is wrapped in DEC mode 2026 begin/end
+ * sequences so the terminal presents it atomically. Only enable this when
+ * the terminal reports support for synchronized output.
+ *
+ * @param controller The display controller
+ * @param enabled Whether to wrap redraws in synchronized updates
+ */
+void display_controller_set_synchronized_output(
+    display_controller_t *controller, bool enabled);
+
+/**
+ * Get terminal output statistics.
+ *
+ * Reports the number of redraw frames written and the bytes and write
+ * system calls per frame.
+ *
+ * @param controller The display controller
+ * @param stats Buffer to receive output statistics
+ * @return DISPLAY_CONTROLLER_SUCCESS on success, error code on failure
+ */
+display_controller_error_t
+display_controller_get_output_stats(const display_controller_t *controller,
+                                    output_frame_stats_t *stats);
+
 // ============================================================================
 // PERFORMANCE AND MONITORING FUNCTIONS
 // ============================================================================
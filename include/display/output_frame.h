@@ -0,0 +1,155 @@
+/**
+ * @file output_frame.h
+ * @brief Output frame - collects a redraw and writes it in one system call
+ *
+ * Display code appends cursor movement, clears and text to a frame instead
+ * of writing each piece to the terminal. Flushing the frame issues a single
+ * writev(), optionally wrapped in DEC mode 2026 synchronized-update
+ * sequences so the terminal presents the whole redraw at once. Over slow
+ * links this avoids one packet per fragment and the tearing that causes.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ * @license MIT
+ */
+
+#ifndef OUTPUT_FRAME_H
+#define OUTPUT_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define OUTPUT_FRAME_INITIAL_CAPACITY 4096
+
+/* DEC private mode 2026: begin/end synchronized update */
+#define OUTPUT_FRAME_SYNC_BEGIN "\033[?2026h"
+#define OUTPUT_FRAME_SYNC_END "\033[?2026l"
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * Output statistics, per frame and cumulative
+ */
+typedef struct {
+    uint64_t frames;                  // Frames flushed
+    uint64_t bytes;                   // Bytes written by all frames
+    uint64_t syscalls;                // write calls made by all frames
+    size_t last_frame_bytes;          // Bytes written by the last frame
+    unsigned int last_frame_syscalls; // write calls made by the last frame
+    size_t max_frame_bytes;           // Largest frame written
+} output_frame_stats_t;
+
+/**
+ * Output collected for one redraw
+ */
+typedef struct {
+    int fd;                     // Destination file descriptor
+    char *data;                 // Pending output
+    size_t length;              // Bytes pending
+    size_t capacity;            // Allocated size of data
+    bool synchronized;          // Wrap frames in DEC mode 2026
+    size_t frame_bytes;         // Bytes written for the frame in progress
+    unsigned int frame_calls;   // write calls for the frame in progress
+    output_frame_stats_t stats; // Output statistics
+} output_frame_t;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Initialize an empty frame. No memory is allocated until the first append.
+ *
+ * @param frame Frame to initialize
+ * @param fd File descriptor flushed frames are written to
+ */
+void output_frame_init(output_frame_t *frame, int fd);
+
+/**
+ * Release the frame's buffer. Pending output is discarded.
+ *
+ * @param frame Frame to clean up
+ */
+void output_frame_cleanup(output_frame_t *frame);
+
+/**
+ * Enable or disable synchronized-update wrapping of flushed frames.
+ *
+ * @param frame Frame to configure
+ * @param enabled true to wrap frames in DEC mode 2026 sequences
+ */
+void output_frame_set_synchronized(output_frame_t *frame, bool enabled);
+
+/**
+ * Start a new frame, discarding any output not yet flushed.
+ *
+ * @param frame Frame to reset
+ */
+void output_frame_begin(output_frame_t *frame);
+
+/**
+ * Append bytes to the frame.
+ *
+ * If the buffer cannot grow, pending output is flushed and the bytes are
+ * written directly so nothing is lost.
+ *
+ * @param frame Frame to append to
+ * @param data Bytes to append
+ * @param length Number of bytes
+ */
+void output_frame_append(output_frame_t *frame, const char *data,
+                         size_t length);
+
+/**
+ * Append a NUL-terminated string to the frame.
+ *
+ * @param frame Frame to append to
+ * @param str String to append
+ */
+void output_frame_append_str(output_frame_t *frame, const char *str);
+
+/**
+ * Append formatted text (cursor movement sequences and the like).
+ *
+ * @param frame Frame to append to
+ * @param format printf-style format
+ */
+void output_frame_appendf(output_frame_t *frame, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * Write the pending output with a single writev() and start a new frame.
+ *
+ * Partial writes are continued and interrupted writes retried; each call
+ * is counted in the statistics. An empty frame writes nothing.
+ *
+ * @param frame Frame to flush
+ * @return 0 on success, -1 on write error
+ */
+int output_frame_flush(output_frame_t *frame);
+
+/**
+ * Get output statistics.
+ *
+ * @param frame Frame to query
+ * @param stats Output: statistics
+ */
+void output_frame_get_stats(const output_frame_t *frame,
+                            output_frame_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OUTPUT_FRAME_H */
@@ -14,6 +14,8 @@
 #ifndef SCREEN_BUFFER_H
 #define SCREEN_BUFFER_H
 
+#include "display/output_frame.h"
+
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -29,10 +31,39 @@ extern "C" {
 #define SCREEN_BUFFER_MAX_ROWS 100
 #define SCREEN_BUFFER_MAX_COLS 512
 
+/* Color encoding for screen_style_t: kind in the top byte, value below */
+#define SCREEN_COLOR_DEFAULT 0x00000000u
+#define SCREEN_COLOR_BASIC 0x01000000u   // 16-color palette (30-37, 90-97)
+#define SCREEN_COLOR_INDEXED 0x02000000u // 256-color palette (38;5;n)
+#define SCREEN_COLOR_RGB 0x03000000u     // Truecolor (38;2;r;g;b)
+#define SCREEN_COLOR_KIND_MASK 0xFF000000u
+#define SCREEN_COLOR_VALUE_MASK 0x00FFFFFFu
+
+/* Text attributes for screen_style_t */
+#define SCREEN_ATTR_BOLD 0x01
+#define SCREEN_ATTR_DIM 0x02
+#define SCREEN_ATTR_ITALIC 0x04
+#define SCREEN_ATTR_UNDERLINE 0x08
+#define SCREEN_ATTR_BLINK 0x10
+#define SCREEN_ATTR_REVERSE 0x20
+#define SCREEN_ATTR_HIDDEN 0x40
+#define SCREEN_ATTR_STRIKE 0x80
+
 // ============================================================================
 // TYPE DEFINITIONS
 // ============================================================================
 
+/**
+ * Graphic rendition (SGR) state of a cell
+ *
+ * A zeroed style is the terminal default.
+ */
+typedef struct {
+    uint32_t fg;   // Foreground color (SCREEN_COLOR_*)
+    uint32_t bg;   // Background color (SCREEN_COLOR_*)
+    uint8_t attrs; // SCREEN_ATTR_* bits
+} screen_style_t;
+
 /**
  * Represents a single character cell in the virtual screen
  *
@@ -52,6 +83,7 @@ typedef struct {
     uint8_t byte_len;     // Actual bytes used (1-4)
     uint8_t visual_width; // Display width in columns (0, 1, or 2)
     bool is_prompt;       // True if this cell is part of the prompt
+    screen_style_t style; // Colors and attributes the cell is drawn with
 } screen_cell_t;
 
 /**
@@ -106,6 +138,11 @@ typedef struct {
                             // menu_lines
     int command_end_row;    // Row where command text ends (before ghost/menu)
     int command_end_col;    // Column where command text ends
+
+    // Set when the cells may not match what the terminal shows (escape
+    // sequences other than SGR, wide characters split at the margin).
+    // Such a buffer cannot be diffed; the display must be redrawn.
+    bool inexact;
 } screen_buffer_t;
 
 // ============================================================================
@@ -208,11 +245,64 @@ size_t screen_buffer_visual_width(const char *text, size_t byte_length);
 /**
  * Copy screen buffer (for saving old state)
  *
+ * Line prefixes are duplicated, so the copy stays valid after the source
+ * is re-rendered. Any prefixes the destination held are freed.
+ *
  * @param dest Destination buffer
  * @param src Source buffer
  */
 void screen_buffer_copy(screen_buffer_t *dest, const screen_buffer_t *src);
 
+// ============================================================================
+// DIFFERENTIAL RENDERING
+// ============================================================================
+
+/**
+ * Apply the parameters of an SGR sequence (ESC [ params m) to a style
+ *
+ * @param style Style to update
+ * @param params Parameter bytes between "ESC [" and "m"
+ * @param length Number of parameter bytes
+ * @return true if every parameter was understood, false otherwise
+ */
+bool screen_style_apply_sgr(screen_style_t *style, const char *params,
+                            size_t length);
+
+/**
+ * Add autosuggestion ghost text after the command text
+ *
+ * The text is laid out from command_end_row/command_end_col in dim gray,
+ * wrapping at the terminal width. ghost_text_lines is set to the number of
+ * rows it adds below the command.
+ *
+ * @param buffer Screen buffer (command already rendered)
+ * @param text Suggestion text (plain, single line)
+ * @return Number of rows added below the command, or -1 on error
+ */
+int screen_buffer_add_ghost_text(screen_buffer_t *buffer, const char *text);
+
+/**
+ * Generate the minimal terminal update from one screen to another
+ *
+ * Compares new_screen against old_screen (what the terminal currently shows,
+ * with the cursor at old_screen's cursor position) and appends to the frame
+ * only the cursor motion, SGR changes and cell runs needed to turn one into
+ * the other, clearing rows and line tails that are no longer used. The
+ * cursor is left at new_screen's cursor position with default attributes.
+ *
+ * Nothing is appended when false is returned: either screen is inexact, the
+ * widths or command start differ, or prompt cells changed. The caller must
+ * then redraw in full.
+ *
+ * @param old_screen Screen currently displayed
+ * @param new_screen Screen to display
+ * @param frame Output frame to append the update to
+ * @return true if the update was generated, false if a full redraw is needed
+ */
+bool screen_buffer_render_diff(const screen_buffer_t *old_screen,
+                               const screen_buffer_t *new_screen,
+                               output_frame_t *frame);
+
 // ============================================================================
 // PREFIX SUPPORT FUNCTIONS (Phase 2: Continuation Prompts)
 // ============================================================================
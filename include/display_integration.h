@@ -152,6 +152,11 @@ typedef struct {
     double cache_hit_rate;                // Current cache hit rate (0.0-1.0)
     size_t memory_usage_bytes; // Current memory usage of integration system
 
+    // Terminal output
+    uint64_t output_frames;   // Redraw frames written to the terminal
+    uint64_t output_bytes;    // Bytes written by those frames
+    uint64_t output_syscalls; // write calls made by those frames
+
     // Error tracking
     uint64_t layered_display_errors; // Number of errors in layered display
     uint64_t fallback_triggers;      // Number of times fallback was triggered
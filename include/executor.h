@@ -12,7 +12,9 @@
 #ifndef EXECUTOR_H
 #define EXECUTOR_H
 
+#include "libhashtable/ht.h"
 #include "node.h"
+#include "script_cache.h"
 #include "shell_error.h"
 #include "symtable.h"
 
@@ -22,6 +24,9 @@
 /** Maximum depth of error context stack */
 #define EXECUTOR_CONTEXT_STACK_MAX 16
 
+/** Number of call sites remembered per executor (power of two) */
+#define EXECUTOR_CALL_SITES 64
+
 // Function parameter definition
 typedef struct function_param {
     char *name;                  // Parameter name
@@ -30,15 +35,23 @@ typedef struct function_param {
     struct function_param *next; // Next parameter in list
 } function_param_t;
 
-// Function definition storage
+// Function definition storage; immutable once stored and shared by the
+// function tables of every executor that has it, without copying
 typedef struct function_def {
     char *name;                // Function name
     node_t *body;              // Function body AST
     function_param_t *params;  // Parameter list (NULL for no params)
     int param_count;           // Number of parameters
-    struct function_def *next; // Next function in list
+    unsigned int refs;         // Function tables and running calls
 } function_def_t;
 
+// Function a command node last resolved to
+typedef struct function_call_site {
+    const node_t *site;        // Command node making the call
+    unsigned long generation;  // Function table generation when resolved
+    function_def_t *func;      // Function it resolved to
+} function_call_site_t;
+
 // Job states
 typedef enum { JOB_RUNNING, JOB_STOPPED, JOB_DONE } job_state_t;
 
@@ -77,12 +90,16 @@ typedef struct executor {
     const char *error_message;    // Last error message
     bool has_error;               // Error flag
     symtable_manager_t *symtable; // Symbol table manager
-    function_def_t *functions;    // Function definition table
+    ht_t *functions;              // Function definitions by name
+    size_t function_count;        // Number of defined functions
+    unsigned long function_generation; // Bumped on every definition
+    function_call_site_t call_sites[EXECUTOR_CALL_SITES];
     job_t *jobs;                  // Job control list
     int next_job_id;              // Next job ID to assign
     pid_t shell_pgid;             // Shell process group ID
     loop_control_t loop_control;  // Loop control state
     int loop_depth;               // Current loop nesting depth
+    bool errexit_ignored;         // Last status is exempt from set -e
 
     // Script execution context for debugging
     char *current_script_file; // Current script file being executed
@@ -107,6 +124,17 @@ typedef struct executor {
     pid_t procsub_pids[32];    // Child PIDs from process substitutions
     int procsub_fd_count;      // Number of tracked fds/pids
 
+    // Pipeline stage execution
+    bool exec_in_place;        // Stage child: exec external command directly
+
+    // External command launch paths (reported by "debug exec")
+    unsigned long spawn_count; // Commands started with posix_spawn
+    unsigned long fork_count;  // Commands started with fork + exec
+
+    // Tokens and AST of the command lines being executed; each
+    // executor_execute_command_line() call releases its own in one step
+    lle_arena_t *parse_arena;
+
 } executor_t;
 
 /** Global executor instance */
@@ -160,6 +188,46 @@ int executor_execute(executor_t *executor, node_t *ast);
  */
 int executor_execute_command_line(executor_t *executor, const char *input);
 
+/**
+ * @brief Load a script file parsed as a whole, if enabled
+ *
+ * Returns NULL when scripts.parse_whole is off, under set -v (which echoes
+ * each line as it is read), or when the file cannot be parsed whole; the
+ * caller then reads the file construct by construct. Parsed scripts are
+ * shared through the script cache when scripts.ast_cache is on, and
+ * persistent ones are also kept on disk when scripts.parse_cache is on
+ * and lush was not started with --no-parse-cache.
+ *
+ * @param path Script path
+ * @param persistent Startup file or sourced library worth keeping on disk
+ * @return Parsed script (release with script_ast_release), or NULL
+ */
+script_ast_t *executor_load_script(const char *path, bool persistent);
+
+/**
+ * @brief Execute the top-level commands of a parsed script in order
+ *
+ * Behaves like running each command as its own command line: the script
+ * line of the executor follows the commands, errors are reported after
+ * each one, and a return from a sourced file (status 200-455) ends the
+ * script and sets source_return. exit also ends the script, leaving
+ * exit_flag set for the caller. Execution also stops at the first
+ * failing command under set -e.
+ *
+ * A command that changes the shell mode so that the rest of the file
+ * would parse differently also stops execution; the caller then reads
+ * the file construct by construct from the offset stored in resume.
+ *
+ * @param executor Executor context
+ * @param script Parsed script (see executor_load_script())
+ * @param resume Output file offset to continue reading at, or -1 if the
+ *               script has ended
+ * @return Status of the return or exit that ended the script, or else the
+ *         status of the last command executed
+ */
+int executor_execute_script(executor_t *executor, const script_ast_t *script,
+                            off_t *resume);
+
 /* ============================================================================
  * Configuration
  * ============================================================================ */
@@ -384,6 +452,41 @@ function_param_t *create_function_param(const char *name,
  */
 void free_function_params(function_param_t *params);
 
+/* ============================================================================
+ * Function Table
+ * ============================================================================ */
+
+/**
+ * @brief Look up a defined function
+ *
+ * The definition is shared with other executors and must not be modified.
+ *
+ * @param executor Executor context
+ * @param name Function name
+ * @return Function definition, or NULL if not defined
+ */
+function_def_t *executor_find_function(executor_t *executor, const char *name);
+
+/**
+ * @brief Check whether a function is defined
+ *
+ * @param executor Executor context
+ * @param name Function name
+ * @return true if a function with this name is defined
+ */
+bool executor_function_exists(executor_t *executor, const char *name);
+
+/**
+ * @brief List the defined functions sorted by name
+ *
+ * @param executor Executor context
+ * @param count Output number of functions
+ * @return Allocated array of definitions (free the array only), or NULL
+ *         if no functions are defined
+ */
+function_def_t **executor_list_functions(executor_t *executor,
+                                         size_t *count);
+
 /* ============================================================================
  * Script Context (Debugging)
  * ============================================================================ */
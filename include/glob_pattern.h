@@ -0,0 +1,145 @@
+/**
+ * @file glob_pattern.h
+ * @brief Compiled shell pattern matching
+ *
+ * Compiles POSIX glob patterns, bash extglob groups and zsh extended glob
+ * quantifiers into a reusable matcher. Compiled patterns are cached by
+ * text so a pattern used in a loop, a case statement or a directory scan
+ * is only parsed once.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#ifndef GLOB_PATTERN_H
+#define GLOB_PATTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/** @brief Recognize bash extglob groups ?() *() +() @() !() */
+#define GLOB_PATTERN_EXTGLOB 0x01
+
+/** @brief Recognize zsh (a|b) groups and X# / X## repetition */
+#define GLOB_PATTERN_ZSH 0x02
+
+/** @brief Treat backslash as an ordinary character */
+#define GLOB_PATTERN_NOESCAPE 0x04
+
+/** @brief Compiled pattern (opaque) */
+typedef struct glob_pattern glob_pattern_t;
+
+/**
+ * @brief Compiled pattern cache statistics
+ */
+typedef struct glob_pattern_cache_stats {
+    unsigned long hits;    /**< Lookups answered from the cache */
+    unsigned long misses;  /**< Lookups that compiled the pattern */
+    unsigned long flushes; /**< Times the full cache was emptied */
+    size_t entries;        /**< Patterns currently cached */
+} glob_pattern_cache_stats_t;
+
+/**
+ * @brief Compile a pattern
+ *
+ * Supports *, ? and bracket expressions (ranges, negation with ! or ^,
+ * and [:class:] names); ? and bracket expressions match whole UTF-8
+ * characters. Malformed constructs such as an unterminated '[' or '('
+ * match literally.
+ *
+ * @param pattern Pattern text
+ * @param flags GLOB_PATTERN_* flags
+ * @return Compiled pattern (free with glob_pattern_free), or NULL on
+ *         allocation failure
+ */
+glob_pattern_t *glob_pattern_compile(const char *pattern, int flags);
+
+/**
+ * @brief Free a compiled pattern
+ *
+ * @param pattern Pattern to free (NULL is safely ignored)
+ */
+void glob_pattern_free(glob_pattern_t *pattern);
+
+/**
+ * @brief Get a compiled pattern from the cache, compiling it if needed
+ *
+ * The returned pattern is owned by the cache and stays valid until the
+ * next call to glob_pattern_cached() or glob_pattern_cache_clear().
+ *
+ * @param pattern Pattern text
+ * @param flags GLOB_PATTERN_* flags
+ * @return Compiled pattern, or NULL on allocation failure
+ */
+const glob_pattern_t *glob_pattern_cached(const char *pattern, int flags);
+
+/**
+ * @brief Test whether a whole string matches
+ *
+ * @param pattern Compiled pattern
+ * @param str String to test
+ * @return true if the entire string matches
+ */
+bool glob_pattern_match(const glob_pattern_t *pattern, const char *str);
+
+/**
+ * @brief Test whether the first len bytes of a string match
+ *
+ * @param pattern Compiled pattern
+ * @param str String to test (need not be NUL-terminated)
+ * @param len Number of bytes to match
+ * @return true if str[0..len) matches entirely
+ */
+bool glob_pattern_match_n(const glob_pattern_t *pattern, const char *str,
+                          size_t len);
+
+/**
+ * @brief Find the shortest or longest prefix that matches
+ *
+ * All matching prefixes are found in a single pass over the string.
+ *
+ * @param pattern Compiled pattern
+ * @param str String to search
+ * @param len Length of str in bytes
+ * @param longest true for the longest match, false for the shortest
+ * @return Length of the matching prefix, or -1 if no prefix matches
+ */
+ssize_t glob_pattern_match_prefix(const glob_pattern_t *pattern,
+                                  const char *str, size_t len, bool longest);
+
+/**
+ * @brief Find the shortest or longest suffix that matches
+ *
+ * Only suffixes starting on a UTF-8 character boundary are considered.
+ *
+ * @param pattern Compiled pattern
+ * @param str String to search
+ * @param len Length of str in bytes
+ * @param longest true for the longest match, false for the shortest
+ * @return Length of the matching suffix, or -1 if no suffix matches
+ */
+ssize_t glob_pattern_match_suffix(const glob_pattern_t *pattern,
+                                  const char *str, size_t len, bool longest);
+
+/**
+ * @brief Match a string against pattern text using the cache
+ *
+ * @param pattern Pattern text
+ * @param str String to test
+ * @param flags GLOB_PATTERN_* flags
+ * @return true if the entire string matches
+ */
+bool glob_match(const char *pattern, const char *str, int flags);
+
+/** @brief Free every cached pattern */
+void glob_pattern_cache_clear(void);
+
+/**
+ * @brief Get compiled pattern cache statistics
+ *
+ * @param stats Output statistics
+ */
+void glob_pattern_get_cache_stats(glob_pattern_cache_stats_t *stats);
+
+#endif /* GLOB_PATTERN_H */
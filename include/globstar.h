@@ -0,0 +1,74 @@
+/**
+ * @file globstar.h
+ * @brief Recursive ** pathname expansion
+ *
+ * Walks the directory tree for patterns containing a ** component, one
+ * path component at a time. Directories are opened relative to their
+ * parent, d_type is trusted so most entries are never stat'ed, literal
+ * components are looked up directly instead of read from the directory,
+ * and large trees are read by a small pool of worker threads.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#ifndef GLOBSTAR_H
+#define GLOBSTAR_H
+
+#include <stdbool.h>
+
+/** @brief Upper bound on worker threads used for one walk */
+#define GLOBSTAR_MAX_WORKERS 4
+
+/**
+ * @brief Receives each matching path
+ *
+ * Calls are serialized even when the walk runs on several threads, but
+ * arrive in no particular order.
+ *
+ * @param path Matching path (only valid during the call)
+ * @param ctx Caller context
+ * @return 0 to continue, -1 to abort the walk
+ */
+typedef int (*globstar_emit_fn)(const char *path, void *ctx);
+
+/**
+ * @brief Walk options
+ */
+typedef struct globstar_options {
+    int pattern_flags; /**< GLOB_PATTERN_* flags for path components */
+    bool dotglob;      /**< Wildcards and ** also match hidden names */
+    int max_workers;   /**< 0 chooses automatically, 1 walks serially */
+} globstar_options_t;
+
+/**
+ * @brief Walk statistics
+ */
+typedef struct globstar_stats {
+    unsigned long dirs_read;  /**< Directories read with readdir */
+    unsigned long entries;    /**< Directory entries examined */
+    unsigned long stat_calls; /**< stat/lookup calls made */
+    unsigned long matches;    /**< Paths emitted */
+    unsigned int workers;     /**< Threads that took part in the walk */
+} globstar_stats_t;
+
+/**
+ * @brief Expand a pattern containing ** components
+ *
+ * A ** component matches zero or more directories; it does not follow
+ * symbolic links to directories, and it skips hidden directories unless
+ * dotglob is set. A trailing ** matches every file and directory below
+ * its parent. A trailing '/' restricts matches to directories. Other
+ * components are shell patterns matched against one name.
+ *
+ * @param pattern Pattern to expand
+ * @param options Walk options (NULL for defaults)
+ * @param emit Callback receiving each match
+ * @param ctx Context passed to emit
+ * @param stats Output statistics (may be NULL)
+ * @return 0 on success, -1 on allocation failure or if emit aborted
+ */
+int globstar_walk(const char *pattern, const globstar_options_t *options,
+                  globstar_emit_fn emit, void *ctx, globstar_stats_t *stats);
+
+#endif /* GLOBSTAR_H */
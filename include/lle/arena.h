@@ -81,7 +81,9 @@ typedef struct lle_arena_chunk_t {
     struct lle_arena_chunk_t *next; /**< Next chunk in chain (NULL if last) */
     size_t size;                    /**< Usable size of this chunk (bytes) */
     size_t used;                    /**< Bytes allocated from this chunk */
-    char data[];                    /**< Flexible array - actual memory */
+    /** Flexible array - actual memory. Aligned so that offsets rounded to
+     *  the default alignment are aligned addresses too. */
+    _Alignas(LLE_ARENA_DEFAULT_ALIGNMENT) char data[];
 } lle_arena_chunk_t;
 
 /**
@@ -223,6 +223,8 @@ struct lle_selection_range_t {
  *
  * Fast position mapping for UTF-8 buffers providing O(1) lookups.
  * Maps between byte offsets, codepoint indices, and grapheme cluster indices.
+ * Each array has one extra entry mapping the end of the text to the end of
+ * the other coordinate space.
  */
 struct lle_utf8_index_t {
     /* Fast position mapping arrays */
@@ -246,6 +248,7 @@ struct lle_utf8_index_t {
 
     /* Performance tracking */
     size_t rebuild_count; /* Number of index rebuilds */
+    size_t splice_count;  /* Number of incremental index updates */
     uint64_t
         total_rebuild_time_ns; /* Total time spent rebuilding (nanoseconds) */
 };
@@ -319,17 +322,22 @@ struct lle_buffer_t {
     uint64_t last_modified_time;    /* Last modification timestamp */
     uint32_t modification_count;    /* Total modifications counter */
 
-    /* Buffer content storage */
-    char *data;      /* UTF-8 encoded buffer data */
-    size_t capacity; /* Allocated buffer capacity */
-    size_t length;   /* Current buffer length (bytes) */
-    size_t used;     /* Actually used buffer space */
+    /* Buffer content storage (gap buffer, see lle_buffer_get_text) */
+    char *data;       /* UTF-8 encoded buffer data */
+    size_t capacity;  /* Allocated buffer capacity */
+    size_t length;    /* Current buffer length (bytes) */
+    size_t used;      /* Actually used buffer space */
+    size_t gap_start; /* Text offset of the gap while it is open */
+    bool gap_open;    /* Gap inside the text: data is not contiguous */
 
     /* UTF-8 and Unicode metadata */
     size_t codepoint_count;       /* Number of Unicode codepoints */
     size_t grapheme_count;        /* Number of grapheme clusters */
     lle_utf8_index_t *utf8_index; /* Fast UTF-8 position index */
     bool utf8_index_valid;        /* UTF-8 index validity flag */
+    size_t utf8_edit_start;       /* Edited range not yet spliced into */
+    size_t utf8_edit_deleted;     /*   the index: offset, bytes replaced */
+    size_t utf8_edit_inserted;    /*   and bytes now in their place */
 
     /* Line structure information */
     lle_line_info_t *lines;                 /* Line structure array */
@@ -853,6 +861,45 @@ lle_result_t lle_buffer_replace_text(lle_buffer_t *buffer,
                                      const char *insert_text,
                                      size_t insert_length);
 
+/**
+ * @brief Get the buffer text as one contiguous string
+ *
+ * Edits leave a gap at the edit position so that further local edits do
+ * not shift the rest of the text. This closes the gap, which costs one move
+ * of the text after it, and NUL-terminates the result. Code that reads
+ * buffer->data directly must call this first.
+ *
+ * The pointer is valid until the next modification of the buffer.
+ *
+ * @param buffer Buffer to read
+ * @return NUL-terminated buffer text, or NULL if buffer is NULL
+ */
+const char *lle_buffer_get_text(lle_buffer_t *buffer);
+
+/**
+ * @brief Copy a range of buffer text without closing the gap
+ *
+ * @param buffer Buffer to read
+ * @param start Start byte offset
+ * @param length Number of bytes to copy
+ * @param out Destination, at least length + 1 bytes; NUL-terminated
+ * @return LLE_SUCCESS or error code
+ */
+lle_result_t lle_buffer_copy_text(const lle_buffer_t *buffer, size_t start,
+                                  size_t length, char *out);
+
+/**
+ * @brief Bring the buffer's UTF-8 index up to date
+ *
+ * Creates the index on first use. After that, edits are recorded as one
+ * merged byte range and spliced into the index here, so a run of
+ * keystrokes costs one local update instead of a rebuild per edit.
+ *
+ * @param buffer Buffer whose index to update
+ * @return LLE_SUCCESS or error code
+ */
+lle_result_t lle_buffer_update_utf8_index(lle_buffer_t *buffer);
+
 /* ============================================================================
  * FUNCTION DECLARATIONS - UTF-8 INDEX
  * ============================================================================
@@ -888,6 +935,26 @@ void lle_utf8_index_cleanup(lle_utf8_index_t *index);
 lle_result_t lle_utf8_index_rebuild(lle_utf8_index_t *index, const char *text,
                                     size_t text_length);
 
+/**
+ * @brief Update UTF-8 index for an edit
+ *
+ * Recomputes only the grapheme clusters around the edited range and shifts
+ * the rest of the mapping arrays. Falls back to a full rebuild when the
+ * index is not valid for the text before the edit.
+ *
+ * @param index UTF-8 index, valid for the text before the edit
+ * @param text Text after the edit
+ * @param text_length Length of text in bytes
+ * @param start Byte offset of the edit
+ * @param deleted_length Bytes removed at start
+ * @param inserted_length Bytes inserted at start
+ * @return LLE_SUCCESS or error code
+ */
+lle_result_t lle_utf8_index_splice(lle_utf8_index_t *index, const char *text,
+                                   size_t text_length, size_t start,
+                                   size_t deleted_length,
+                                   size_t inserted_length);
+
 /**
  * @brief Get codepoint index from byte offset
  *
@@ -47,6 +47,8 @@ typedef struct lle_history_entry lle_history_entry_t;
 typedef struct lle_history_core lle_history_core_t;
 typedef struct lle_history_config lle_history_config_t;
 typedef struct lle_history_stats lle_history_stats_t;
+typedef struct lle_history_prefix_index lle_history_prefix_index_t;
+typedef struct lle_history_lazy lle_history_lazy_t;
 
 /* Advanced types (Phase 2+) */
 typedef struct lle_history_search_engine lle_history_search_engine_t;
@@ -87,6 +89,8 @@ typedef enum lle_history_dedup_scope {
 #define LLE_HISTORY_INITIAL_CAPACITY 1000  /* Initial allocation */
 #define LLE_HISTORY_MAX_CAPACITY 100000    /* Absolute maximum */
 #define LLE_HISTORY_MIN_CAPACITY 100       /* Minimum entries */
+#define LLE_HISTORY_LAZY_CACHE_SIZE 256    /* Default decoded entries kept */
+#define LLE_HISTORY_LAZY_CACHE_MIN 16      /* Fewest decoded entries kept */
 
 /* Command size limits */
 #define LLE_HISTORY_MAX_COMMAND_LENGTH 32768 /* 32KB max command */
@@ -232,6 +236,9 @@ struct lle_history_config {
     /* Performance settings */
     size_t initial_capacity; /* Initial array capacity */
     bool use_indexing;       /* Use hashtable indexing */
+    bool use_index_file;     /* Keep a binary index beside the file */
+    bool lazy_load;          /* Decode loaded entries on first access */
+    size_t lazy_cache_size;  /* Decoded entries kept when loading lazily */
 };
 
 /**
@@ -250,6 +257,10 @@ struct lle_history_core {
 
     /* Indexing - Phase 2 */
     lle_hashtable_t *entry_lookup; /* ID -> entry hashtable (Phase 2) */
+    lle_history_prefix_index_t *prefix_index; /* Prefix -> newest entry */
+
+    /* Lazily loaded entries: entries[0, n) while the file is mapped */
+    lle_history_lazy_t *lazy;
 
     /* Advanced engines - Phase 4 */
     lle_history_dedup_engine_t
@@ -449,6 +460,54 @@ lle_result_t lle_history_index_get_size(lle_hashtable_t *index, size_t *size);
  */
 lle_result_t lle_history_rebuild_index(lle_history_core_t *core);
 
+/* ============================================================================
+ * PREFIX INDEX FOR AUTOSUGGESTIONS
+ * ============================================================================
+ */
+
+/**
+ * Create empty prefix index
+ */
+lle_result_t lle_history_prefix_index_create(lle_history_prefix_index_t **index);
+
+/**
+ * Destroy prefix index
+ */
+void lle_history_prefix_index_destroy(lle_history_prefix_index_t *index);
+
+/**
+ * Add entry to prefix index (entry must outlive the index contents)
+ */
+lle_result_t lle_history_prefix_index_insert(lle_history_prefix_index_t *index,
+                                             lle_history_entry_t *entry);
+
+/**
+ * Remove all entries from prefix index
+ */
+lle_result_t lle_history_prefix_index_clear(lle_history_prefix_index_t *index);
+
+/**
+ * Find newest entry extending prefix (no locking; NULL if none)
+ */
+lle_history_entry_t *
+lle_history_prefix_index_find(const lle_history_prefix_index_t *index,
+                              const char *prefix, size_t prefix_len);
+
+/**
+ * Get number of indexed entries and tree nodes
+ */
+lle_result_t
+lle_history_prefix_index_get_size(const lle_history_prefix_index_t *index,
+                                  size_t *entries, size_t *nodes);
+
+/**
+ * Find most recent command extending prefix (for autosuggestions)
+ */
+lle_result_t lle_history_find_prefix_match(lle_history_core_t *core,
+                                           const char *prefix,
+                                           size_t prefix_len,
+                                           lle_history_entry_t **entry);
+
 /**
  * Get last N entries (most recent)
  */
@@ -880,6 +939,107 @@ lle_result_t lle_history_events_print_stats(void);
  */
 lle_result_t lle_history_expand_capacity(lle_history_core_t *core);
 
+/**
+ * Get the entry at an array index, decoding it if it was loaded lazily
+ * (internal use only)
+ *
+ * Caller holds core->lock and checks index against entry_count. An entry
+ * decoded here may be freed once the cache has decoded
+ * lazy_cache_size newer ones; hold on to it no longer than that.
+ *
+ * @param core History core
+ * @param index Array index (0 = oldest)
+ * @return Entry, or NULL if a lazily loaded entry could not be decoded
+ */
+lle_history_entry_t *lle_history_entry_at(lle_history_core_t *core,
+                                          size_t index);
+
+/* ============================================================================
+ * LAZY LOADING (internal use only)
+ * ============================================================================
+ *
+ * With lazy_load set, loading a file into an empty history records only
+ * where each entry line lies in the mapped file. entries[i] stays NULL
+ * until the entry is first used; decoded entries are kept in an LRU
+ * cache of lazy_cache_size entries and freed again when evicted. Lazily
+ * loaded entries are not in entry_lookup or the prefix index.
+ */
+
+/**
+ * Number of entries at the start of the array that were loaded lazily
+ *
+ * @param core History core (caller holds core->lock)
+ * @return Lazily loaded entries, 0 if none
+ */
+size_t lle_history_lazy_count(const lle_history_core_t *core);
+
+/**
+ * Find the array index of a lazily loaded entry by ID
+ *
+ * @param core History core (caller holds core->lock)
+ * @param entry_id Entry ID
+ * @param index Output for the array index
+ * @return true if the ID belongs to a lazily loaded entry
+ */
+bool lle_history_lazy_find_id(const lle_history_core_t *core,
+                              uint64_t entry_id, size_t *index);
+
+/**
+ * Decode a lazily loaded entry, or touch it in the cache
+ *
+ * @param core History core (caller holds core->lock)
+ * @param index Array index below lle_history_lazy_count()
+ * @return Entry, or NULL if it could not be decoded
+ */
+lle_history_entry_t *lle_history_lazy_get(lle_history_core_t *core,
+                                          size_t index);
+
+/**
+ * Check whether the lazily loaded entries in [start, end) can all be
+ * decoded at once without evicting one another
+ *
+ * @param core History core (caller holds core->lock)
+ * @param start First array index
+ * @param end One past the last array index
+ * @return true if they fit in the cache, or if none are lazy
+ */
+bool lle_history_lazy_cache_fits(const lle_history_core_t *core,
+                                 size_t start, size_t end);
+
+/**
+ * Find the newest lazily loaded command extending a prefix
+ *
+ * Scans the mapped lines from newest to oldest and decodes only the
+ * match. Follows the rules of lle_history_find_prefix_match().
+ *
+ * @param core History core (caller holds core->lock)
+ * @param prefix Typed prefix
+ * @param prefix_len Prefix length in bytes
+ * @return Matching entry, or NULL if none
+ */
+lle_history_entry_t *lle_history_lazy_find_prefix(lle_history_core_t *core,
+                                                  const char *prefix,
+                                                  size_t prefix_len);
+
+/**
+ * Decode every lazily loaded entry and index it like a loaded one
+ *
+ * Takes the write lock. Afterwards the history holds no lazy entries.
+ *
+ * @param core History core
+ * @return LLE_SUCCESS or error code
+ */
+lle_result_t lle_history_lazy_materialize(lle_history_core_t *core);
+
+/**
+ * Release the lazy loading state
+ *
+ * The caller has already destroyed the decoded entries in the array.
+ *
+ * @param core History core (caller holds the write lock)
+ */
+void lle_history_lazy_release(lle_history_core_t *core);
+
 /**
  * Validate entry (internal use only)
  *
@@ -918,7 +1078,7 @@ typedef enum {
 typedef struct {
     uint64_t entry_id;            /* History entry ID */
     size_t entry_index;           /* Index in history */
-    const char *command;          /* Command string (reference) */
+    const char *command;          /* Command string (owned copy) */
     uint64_t timestamp;           /* Command timestamp */
     int score;                    /* Relevance score (higher = better) */
     size_t match_position;        /* Position of match in command */
@@ -1405,6 +1565,8 @@ typedef struct lle_history_dedup_stats {
     uint64_t duplicates_detected; /* Total duplicates found */
     uint64_t duplicates_merged;   /* Total duplicates merged */
     uint64_t duplicates_ignored;  /* Total duplicates rejected */
+    uint64_t index_hits;          /* Duplicates found through the index */
+    uint64_t index_fallbacks;     /* Checks that needed a backward scan */
     lle_history_dedup_strategy_t current_strategy; /* Active strategy */
 } lle_history_dedup_stats_t;
 
@@ -1437,8 +1599,9 @@ lle_result_t lle_history_dedup_destroy(lle_history_dedup_engine_t *dedup);
 /**
  * Check if entry is duplicate of existing entry
  *
- * Scans recent history for duplicate command. If found, returns the
- * existing entry via duplicate_entry parameter.
+ * Looks up the most recent entry with the same command in the engine's
+ * hash index and accepts it if it lies within the dedup scope. If found,
+ * returns the existing entry via duplicate_entry parameter.
  *
  * @param dedup Dedup engine
  * @param new_entry Entry to check for duplicates
@@ -818,6 +818,12 @@ lle_sequence_parser_process_data(lle_sequence_parser_t *parser,
                                  const char *data, size_t data_len,
                                  lle_parsed_input_t **parsed_input);
 
+lle_result_t
+lle_sequence_parser_process_prefix(lle_sequence_parser_t *parser,
+                                   const char *data, size_t data_len,
+                                   size_t *consumed,
+                                   lle_parsed_input_t **parsed_input);
+
 lle_result_t lle_sequence_parser_reset_state(lle_sequence_parser_t *parser);
 
 lle_parser_state_t
@@ -201,6 +201,9 @@ typedef struct lle_syntax_token {
     size_t end;                   /**< End position (exclusive) */
     uint32_t color;               /**< Resolved color for this token */
     uint8_t attributes;           /**< Text attributes (bold, underline, dim) */
+    uint8_t lex_state;            /**< Lexer state before this token */
+    size_t reach;                 /**< End of input examined to lex it */
+    size_t render_offset;         /**< Start in the rendered output */
 } lle_syntax_token_t;
 
 /* Text attribute flags */
@@ -239,6 +242,34 @@ typedef struct lle_syntax_highlighter {
 
     /* Cache for command existence checks */
     void *command_cache; /**< Opaque pointer to cache */
+
+    /* Incremental highlighting: input the tokens describe */
+    char *input_copy;         /**< Copy of the last highlighted input */
+    size_t input_copy_len;    /**< Length of input_copy */
+    size_t input_copy_cap;    /**< Allocated size of input_copy */
+    bool tokens_valid;        /**< Tokens describe input_copy */
+    bool lexed_commands;      /**< validate_commands when tokens were lexed */
+    bool lexed_paths;         /**< validate_paths when tokens were lexed */
+    uint8_t end_state;        /**< Lexer state after the last token */
+    size_t tokens_relexed;    /**< Tokens lexed by the last highlight call */
+
+    /* Old tokens after the edit, kept while re-lexing for resync */
+    lle_syntax_token_t *tail;
+    size_t tail_capacity;
+
+    /* Damage from the last highlight call, consumed by rendering */
+    size_t damage_first;         /**< First re-lexed token */
+    size_t damage_end;           /**< One past the last re-lexed token */
+    size_t damage_render_start;  /**< Old rendered offset of damage_first */
+    size_t damage_render_resume; /**< Old rendered offset of damage_end */
+    bool render_pending;         /**< Highlighted since the last render */
+
+    /* Rendered output of the last render call */
+    char *rendered;          /**< ANSI output, valid if rendered_valid */
+    size_t rendered_len;     /**< Length of rendered */
+    size_t rendered_cap;     /**< Allocated size of rendered */
+    bool rendered_valid;     /**< rendered matches tokens before damage */
+    int rendered_depth;      /**< color_depth used for rendered */
 } lle_syntax_highlighter_t;
 
 /* ========================================================================== */
@@ -274,6 +305,11 @@ void lle_syntax_colors_get_default(lle_syntax_colors_t *colors);
 
 /**
  * @brief Tokenize and highlight a command line
+ *
+ * Tokens are kept between calls. When the previous tokens are still
+ * valid, the edit is found by comparing @p input with the previous
+ * input and only the damaged range is re-lexed.
+ *
  * @param highlighter Highlighter context
  * @param input Command line to tokenize
  * @param input_len Length of input
@@ -282,6 +318,32 @@ void lle_syntax_colors_get_default(lle_syntax_colors_t *colors);
 int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
                          const char *input, size_t input_len);
 
+/**
+ * @brief Re-highlight a command line after a known edit
+ *
+ * Bytes [edit_start, old_end) of the previously highlighted input were
+ * replaced by bytes [edit_start, new_end) of @p input; everything before
+ * and after is unchanged. Only tokens from the last restart point before
+ * the edit up to the point where tokens resynchronize are re-lexed, and
+ * only their span is re-rendered by the next lle_syntax_render_ansi().
+ * An inconsistent range falls back to a full highlight.
+ *
+ * lle_syntax_highlight() derives the range itself by comparing @p input
+ * with the previous input; use this when the caller already knows it.
+ *
+ * @param highlighter Highlighter context
+ * @param input Complete command line after the edit
+ * @param input_len Length of input
+ * @param edit_start First changed byte
+ * @param old_end End of the replaced bytes in the previous input
+ * @param new_end End of the inserted bytes in @p input
+ * @return Number of tokens, or -1 on error
+ */
+int lle_syntax_highlight_edit(lle_syntax_highlighter_t *highlighter,
+                              const char *input, size_t input_len,
+                              size_t edit_start, size_t old_end,
+                              size_t new_end);
+
 /**
  * @brief Get tokens from last highlight operation
  * @param highlighter Highlighter context
@@ -108,7 +108,8 @@ typedef enum {
     LLE_INPUT_TYPE_SIGNAL,
     LLE_INPUT_TYPE_TIMEOUT,
     LLE_INPUT_TYPE_ERROR,
-    LLE_INPUT_TYPE_EOF
+    LLE_INPUT_TYPE_EOF,
+    LLE_INPUT_TYPE_TEXT /* Run of plain text (typed burst or paste) */
 } lle_input_type_t;
 
 /**
@@ -427,6 +428,14 @@ typedef struct lle_input_event_t {
             lle_result_t error_code;
             char error_message[256];
         } error;
+
+        /* Text run - bytes owned by the Unix interface, valid until the
+         * next read */
+        struct {
+            const char *bytes; /* UTF-8 text, no partial sequences */
+            size_t length;     /* Length in bytes */
+            bool pasted;       /* Inside a bracketed paste */
+        } text;
     } data;
 } lle_input_event_t;
 
@@ -451,6 +460,12 @@ typedef struct lle_input_processor {
     lle_arena_t *event_arena;
 } lle_input_processor_t;
 
+/** Terminal input ring buffer size (power of two) */
+#define LLE_UNIX_INPUT_BUFFER_SIZE 8192
+
+/** Longest text run returned in a single LLE_INPUT_TYPE_TEXT event */
+#define LLE_UNIX_TEXT_RUN_MAX 4096
+
 /**
  * @brief Unix terminal interface - minimal abstraction
  *
@@ -477,6 +492,18 @@ typedef struct lle_unix_interface {
         *capabilities;              /* Terminal capabilities for parser */
     lle_memory_pool_t *memory_pool; /* Memory pool for parser */
 
+    /* Buffered input - each read() drains as much as the terminal has */
+    unsigned char input_buffer[LLE_UNIX_INPUT_BUFFER_SIZE];
+    size_t input_head;    /* Ring index of next unconsumed byte */
+    size_t input_count;   /* Bytes buffered */
+    uint64_t input_reads; /* read() calls issued */
+
+    /* Text run coalescing */
+    bool coalesce_text;                       /* Merge typed bursts */
+    bool bracketed_paste_enabled;             /* Mode 2004 set on terminal */
+    bool paste_active;                        /* Between paste markers */
+    char text_run[LLE_UNIX_TEXT_RUN_MAX + 1]; /* Last TEXT event bytes */
+
     /* Error state */
     lle_result_t last_error;
 } lle_unix_interface_t;
@@ -607,6 +634,8 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
                                            uint32_t timeout_ms);
 lle_result_t lle_unix_interface_get_window_size(lle_unix_interface_t *interface,
                                                 size_t *width, size_t *height);
+void lle_unix_interface_set_text_coalescing(lle_unix_interface_t *interface,
+                                            bool enabled);
 
 /* Utility Functions */
 uint64_t lle_get_current_time_microseconds(void);
@@ -0,0 +1,63 @@
+/**
+ * @file unicode_tables.h
+ * @brief Table-driven Unicode property lookup
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ *
+ * Display width and Grapheme_Cluster_Break property of every codepoint,
+ * packed into one byte and stored in a two-stage table. The tables are
+ * generated at build time by scripts/gen_unicode_tables.py from the
+ * property files in src/lle/unicode/data.
+ */
+
+#ifndef LLE_UNICODE_TABLES_H
+#define LLE_UNICODE_TABLES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Codepoints per stage 2 block, as a shift */
+#define LLE_UNICODE_BLOCK_SHIFT 8
+#define LLE_UNICODE_BLOCK_MASK ((1u << LLE_UNICODE_BLOCK_SHIFT) - 1)
+
+/** Low bits: Grapheme_Cluster_Break value (grapheme_cluster_break_t) */
+#define LLE_UNICODE_GCB_MASK 0x0F
+
+/** Next bits: display width in columns (0, 1 or 2) */
+#define LLE_UNICODE_WIDTH_SHIFT 4
+#define LLE_UNICODE_WIDTH_MASK 0x03
+
+/** Properties of codepoints beyond U+10FFFF: width 1, break value Other */
+#define LLE_UNICODE_DEFAULT_PROPERTIES (1 << LLE_UNICODE_WIDTH_SHIFT)
+
+/** Stage 1: block number for each 256-codepoint range */
+extern const uint8_t lle_unicode_stage1[];
+
+/** Stage 2: property bytes of the unique blocks */
+extern const uint8_t lle_unicode_stage2[];
+
+/**
+ * @brief Get the packed property byte of a codepoint
+ * @param codepoint Unicode codepoint
+ * @return Property byte; see LLE_UNICODE_GCB_MASK and LLE_UNICODE_WIDTH_SHIFT
+ */
+static inline uint8_t lle_unicode_properties(uint32_t codepoint) {
+    if (codepoint > 0x10FFFF) {
+        return LLE_UNICODE_DEFAULT_PROPERTIES;
+    }
+    size_t block = lle_unicode_stage1[codepoint >> LLE_UNICODE_BLOCK_SHIFT];
+    return lle_unicode_stage2[(block << LLE_UNICODE_BLOCK_SHIFT) |
+                              (codepoint & LLE_UNICODE_BLOCK_MASK)];
+}
+
+/**
+ * @brief Get the display width of a codepoint from the table
+ * @param codepoint Unicode codepoint
+ * @return Width in columns (0, 1 or 2)
+ */
+static inline int lle_unicode_table_width(uint32_t codepoint) {
+    return (lle_unicode_properties(codepoint) >> LLE_UNICODE_WIDTH_SHIFT) &
+           LLE_UNICODE_WIDTH_MASK;
+}
+
+#endif // LLE_UNICODE_TABLES_H
@@ -56,6 +56,26 @@ void lle_utf8_index_cleanup(lle_utf8_index_t *index);
 lle_result_t lle_utf8_index_rebuild(lle_utf8_index_t *index, const char *text,
                                     size_t text_length);
 
+/**
+ * @brief Update UTF-8 index for an edit without a full rebuild
+ *
+ * Recomputes the grapheme clusters the edit can affect, up to the nearest
+ * boundary that depends only on unchanged text, and shifts the remainder
+ * of each mapping array.
+ *
+ * @param index Index valid for the text before the edit
+ * @param text Text after the edit (UTF-8 encoded)
+ * @param text_length Length of text in bytes
+ * @param start Byte offset of the edit
+ * @param deleted_length Bytes removed at start
+ * @param inserted_length Bytes inserted at start
+ * @return LLE_SUCCESS or error code
+ */
+lle_result_t lle_utf8_index_splice(lle_utf8_index_t *index, const char *text,
+                                   size_t text_length, size_t start,
+                                   size_t deleted_length,
+                                   size_t inserted_length);
+
 /**
  * @brief Convert byte offset to codepoint index
  * @param index UTF-8 index
@@ -151,6 +151,16 @@ struct executor;
  */
 struct executor *get_global_executor(void);
 
+/**
+ * @brief Get the global executor, creating it on first use
+ *
+ * When running a script, the new executor's script context is set from
+ * $0, which holds the script name.
+ *
+ * @return Global executor, or NULL if it could not be created
+ */
+struct executor *ensure_global_executor(void);
+
 /* ============================================================================
  * Symbol Table Variable Functions
  * ============================================================================ */
@@ -219,6 +229,8 @@ typedef struct shell_options {
     bool fix_mode;        /**< --fix: apply safe automatic fixes */
     bool unsafe_fixes;    /**< --unsafe-fixes: also apply unsafe fixes */
     bool dry_run;         /**< --dry-run: preview fixes without applying */
+    bool no_parse_cache;  /**< --no-parse-cache: skip on-disk parse cache */
+    bool startup_timing;  /**< --startup-timing: report startup phases */
     char *analyze_file;   /**< --analyze/--lint argument: file to analyze */
     char *output_format;  /**< --format: output format (text, json, gcc) */
 
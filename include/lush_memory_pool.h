@@ -13,6 +13,8 @@
 #ifndef LUSH_MEMORY_POOL_H
 #define LUSH_MEMORY_POOL_H
 
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -41,17 +43,6 @@ typedef enum {
     LUSH_POOL_COUNT = 4
 } lush_pool_size_t;
 
-// Pool block structure for memory management
-typedef struct lush_pool_block {
-    void *memory;                   // Allocated memory block
-    size_t size;                    // Block size
-    bool in_use;                    // Allocation status
-    uint64_t allocation_time_us;    // Allocation timestamp for debugging
-    uint32_t allocation_id;         // Unique allocation ID for tracking
-    struct lush_pool_block *next; // Next block in free list
-    struct lush_pool_block *prev; // Previous block for efficient removal
-} lush_pool_block_t;
-
 // Memory pool statistics for performance monitoring
 typedef struct {
     uint64_t total_allocations;      // Total allocation requests
@@ -67,27 +58,37 @@ typedef struct {
 } lush_pool_stats_t;
 
 // Individual pool configuration and state
+//
+// Each size class owns one slab: a contiguous address range reserved when
+// the pool is initialized. A pointer belongs to a class exactly when it lies
+// inside that range, so freeing a block needs no search. Free blocks are
+// linked through their own first word.
 typedef struct {
-    size_t block_size;               // Size of each block in this pool
-    size_t initial_blocks;           // Initial number of blocks to pre-allocate
-    size_t max_blocks;               // Maximum blocks allowed (0 = unlimited)
-    size_t current_blocks;           // Current number of allocated blocks
-    size_t free_blocks;              // Number of available blocks
-    lush_pool_block_t *free_list;  // Linked list of free blocks
-    lush_pool_block_t *all_blocks; // Array of all blocks for cleanup
-    uint64_t pool_allocations;       // Allocations from this specific pool
-    uint64_t pool_deallocations;     // Deallocations to this specific pool
+    size_t block_size;     // Size of each block in this pool
+    size_t initial_blocks; // Initial number of blocks requested
+    size_t max_blocks;     // Blocks reserved in the slab
+    size_t current_blocks; // Blocks carved from the slab so far
+    size_t free_blocks;    // Blocks on the shared free list
+    char *slab_start;      // First byte of the slab
+    char *slab_end;        // One past the last block of the slab
+    unsigned block_shift;  // log2(block_size)
+    size_t cache_batch;    // Blocks moved per thread cache refill/flush
+    void *free_list;       // Shared free list (blocks not held by threads)
+    _Atomic uint8_t *block_state; // Per-block in-use flag (double free check)
+    pthread_mutex_t lock;         // Guards free_list and slab carving
+    _Atomic uint64_t pool_allocations;   // Allocations from this pool
+    _Atomic uint64_t pool_deallocations; // Deallocations to this pool
 } lush_pool_t;
 
 // Main memory pool system
 typedef struct {
     lush_pool_t pools[LUSH_POOL_COUNT]; // Individual size pools
-    lush_pool_stats_t stats;              // Performance statistics
-    bool initialized;                       // Initialization status
-    bool enable_statistics;                 // Statistics collection toggle
-    bool enable_malloc_fallback;            // Automatic malloc fallback
-    uint32_t next_allocation_id;            // Unique ID counter
-    struct timespec init_time;              // Pool system initialization time
+    bool initialized;                   // Initialization status
+    bool enable_statistics;             // Statistics collection toggle
+    bool enable_malloc_fallback;        // Automatic malloc fallback
+    char *arena;                        // Reservation holding every slab
+    size_t arena_size;                  // Size of the reservation in bytes
+    struct timespec init_time;          // Pool system initialization time
 } lush_memory_pool_system_t;
 
 // Error codes for memory pool operations
@@ -147,7 +148,12 @@ void *lush_pool_alloc(size_t size);
 void lush_pool_free(void *ptr);
 
 /**
- * @brief Reallocate memory (may use malloc for complex resizing)
+ * @brief Reallocate memory, keeping it in place when the block still fits
+ *
+ * Copies min(old size, new_size) bytes when the memory has to move; the old
+ * size is the block size for pool memory and the tracked size for malloc
+ * fallbacks.
+ *
  * @param ptr Pointer to existing memory allocation (NULL allocates new memory)
  * @param new_size New size in bytes (0 frees the memory)
  * @return Pointer to reallocated memory, or NULL on failure
@@ -196,7 +202,7 @@ void lush_pool_analyze_fallback_patterns(void);
 bool lush_pool_is_healthy(void);
 
 /**
- * @brief Perform pool maintenance (defragmentation, cleanup)
+ * @brief Perform pool maintenance (sort shared free lists by address)
  */
 void lush_pool_maintenance(void);
 
@@ -307,7 +313,7 @@ const char *lush_pool_error_string(lush_pool_error_t error);
 void lush_pool_set_debug_mode(bool enabled);
 
 /**
- * @brief Get last error that occurred in pool operations
+ * @brief Get last error that occurred in pool operations on this thread
  * @return Last error code from pool operations
  */
 lush_pool_error_t lush_pool_get_last_error(void);
@@ -315,9 +321,11 @@ lush_pool_error_t lush_pool_get_last_error(void);
 /**
  * Thread Safety Note:
  *
- * The memory pool system is designed to be thread-safe for future expansion.
- * All public API functions use appropriate synchronization mechanisms to
- * ensure safe concurrent access from multiple threads.
+ * Allocation and free are safe from any thread. Each thread keeps a small
+ * cache of free blocks per size class, so the common path takes no lock;
+ * refills and flushes move blocks in batches under the class lock. A thread
+ * that exits returns its cached blocks. lush_pool_init() and
+ * lush_pool_shutdown() must not race with other threads using the pool.
  */
 
 /**
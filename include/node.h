@@ -13,10 +13,12 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <sys/types.h>
 
+#include "lle/arena.h"
 #include "shell_error.h"  /* For source_location_t */
 
 typedef enum {
@@ -124,6 +126,9 @@ typedef struct node {
 
     /* Source location tracking for error reporting */
     source_location_t loc;
+
+    /* Allocated from a parse arena; the arena owns the node and its string */
+    bool in_arena;
 } node_t;
 
 /**
@@ -165,6 +170,8 @@ void add_child_node(node_t *parent, node_t *child);
  *
  * Recursively frees all nodes in the AST starting from the given root.
  * Frees all children, siblings, and any allocated string values.
+ * Trees built in a parse arena are left alone; they are released all at
+ * once when the arena is reset.
  *
  * @param node Root node of tree to free (NULL is safely ignored)
  */
@@ -181,4 +188,68 @@ void free_node_tree(node_t *node);
  */
 void set_node_val_str(node_t *node, char *str);
 
+/* ============================================================================
+ * Parse Arena Allocation
+ * ============================================================================ */
+
+/**
+ * @brief Route node allocations on this thread into an arena
+ *
+ * While an arena is set, new_node() and the node_* string helpers below
+ * allocate from it instead of the heap. The parser sets its arena for the
+ * duration of a parse, so a whole command line's AST is released in one
+ * step when the arena is reset rather than node by node.
+ *
+ * @param arena Arena to allocate from, or NULL for the heap
+ * @return The previously set arena, to be restored by the caller
+ */
+lle_arena_t *node_set_arena(lle_arena_t *arena);
+
+/**
+ * @brief Allocate bytes with the same owner as new nodes
+ *
+ * @param size Number of bytes to allocate
+ * @return Uninitialized memory, or NULL on allocation failure
+ */
+void *node_alloc_bytes(size_t size);
+
+/**
+ * @brief Release memory from node_alloc_bytes() or the string helpers
+ *
+ * A no-op while an arena is set, since the arena owns the memory.
+ *
+ * @param ptr Memory to release (NULL is safely ignored)
+ */
+void node_free_bytes(void *ptr);
+
+/**
+ * @brief Duplicate a string for storage in a node
+ *
+ * @param str String to copy
+ * @return Copy owned like new nodes, or NULL on allocation failure
+ */
+char *node_strdup(const char *str);
+
+/**
+ * @brief Duplicate at most len bytes of a string for storage in a node
+ *
+ * @param str String to copy
+ * @param len Maximum number of bytes to copy
+ * @return NUL-terminated copy owned like new nodes, or NULL on failure
+ */
+char *node_strndup(const char *str, size_t len);
+
+/**
+ * @brief Hand a heap string over to node storage
+ *
+ * For strings built with malloc/realloc before being stored in a node.
+ * With an arena set the string is copied into it and the heap copy freed;
+ * otherwise it is returned unchanged.
+ *
+ * @param str Heap string (ownership transferred, may be NULL)
+ * @return String owned like new nodes, or NULL if str was NULL or the
+ *         copy failed
+ */
+char *node_adopt_str(char *str);
+
 #endif
@@ -50,6 +50,9 @@ typedef struct parser {
 
     /* Recursion depth tracking for stack overflow protection */
     size_t recursion_depth;
+
+    /* Arena holding the tokens and AST of this parse (NULL = heap) */
+    lle_arena_t *arena;
 } parser_t;
 
 /* ============================================================================
@@ -73,6 +76,23 @@ parser_t *parser_new(const char *input);
  */
 parser_t *parser_new_with_source(const char *input, const char *source_name);
 
+/**
+ * @brief Create a parser that builds its tokens and AST in an arena
+ *
+ * Every node and string of the returned AST is allocated from the arena,
+ * so the tree stays valid until the arena is reset (not merely until
+ * parser_free()) and free_node_tree() on it is a no-op. Anything that
+ * must outlive the arena, such as a function body, has to be copied out.
+ *
+ * @param input Shell command string to parse
+ * @param source_name Source filename (e.g., "script.sh" or "<stdin>")
+ * @param arena Arena to allocate from (NULL behaves like
+ *              parser_new_with_source)
+ * @return New parser instance or NULL on failure
+ */
+parser_t *parser_new_in_arena(const char *input, const char *source_name,
+                              lle_arena_t *arena);
+
 /**
  * @brief Set the source name for error reporting
  *
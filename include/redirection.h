@@ -15,6 +15,7 @@
 
 #include "node.h"
 
+#include <spawn.h>
 #include <stdbool.h>
 #include "executor.h"
 #include "node.h"
@@ -31,6 +32,24 @@
  */
 int setup_redirections(executor_t *executor, node_t *command);
 
+/**
+ * @brief Translate a command's redirections into posix_spawn file actions
+ *
+ * Only plain file redirections and literal fd duplications/closes are
+ * translated. Anything that needs shell code in the child (here-documents,
+ * here-strings, process substitution, {var}> allocation, a target that
+ * needs parameter, arithmetic or command expansion, noclobber, computed
+ * fd numbers) makes the command ineligible and it must take the fork path
+ * instead.
+ *
+ * @param executor Executor context for target expansion
+ * @param command Command node with redirection children
+ * @param actions Initialized file actions object to append to
+ * @return 0 if every redirection was translated, 1 if ineligible
+ */
+int build_spawn_file_actions(executor_t *executor, node_t *command,
+                             posix_spawn_file_actions_t *actions);
+
 /**
  * @brief Check if a node is a redirection type
  *
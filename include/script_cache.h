@@ -0,0 +1,153 @@
+/**
+ * @file script_cache.h
+ * @brief Whole-file script parsing with a cache of parsed ASTs
+ *
+ * Sourced files and scripts are mapped and parsed in one pass into the
+ * list of their top-level commands, which the executor then runs in
+ * order. Parsed scripts are cached by path and revalidated against the
+ * file's device, inode, size and modification time, so a library sourced
+ * again and again is only parsed once while it is unchanged.
+ *
+ * Parsed scripts can also be kept on disk, as a compact binary encoding of
+ * the AST under the user's cache directory, so startup files are not
+ * tokenized or parsed again by the next shell while they are unchanged.
+ * A cache file is only used when it was written by the same lush version
+ * for the same path, device, inode, size and modification time.
+ *
+ * Aliases are expanded by the executor when a command runs, not by the
+ * parser, so an alias defined early in a file still applies to the
+ * commands after it. A file that does not parse as a whole is not loaded
+ * at all; callers then read it construct by construct as before, so the
+ * commands ahead of a syntax error still run and the error is reported
+ * where it occurs.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#ifndef SCRIPT_CACHE_H
+#define SCRIPT_CACHE_H
+
+#include "node.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/** @brief Maximum number of parsed scripts kept before the cache is flushed */
+#define SCRIPT_CACHE_MAX 64
+
+/** @brief Look the script up in, and add it to, the in-memory cache */
+#define SCRIPT_CACHE_MEMORY 0x01
+
+/** @brief Look the script up in, and add it to, the on-disk cache */
+#define SCRIPT_CACHE_DISK 0x02
+
+/** @brief Parsed script (opaque, reference counted) */
+typedef struct script_ast script_ast_t;
+
+/**
+ * @brief Script cache statistics
+ */
+typedef struct script_cache_stats {
+    unsigned long hits;    /**< Loads answered from the cache */
+    unsigned long misses;  /**< Loads not answered from the cache */
+    unsigned long flushes; /**< Times the full cache was emptied */
+    size_t entries;        /**< Scripts currently cached */
+    unsigned long disk_hits;   /**< Parses skipped by loading a cache file */
+    unsigned long disk_writes; /**< Cache files written after a parse */
+} script_cache_stats_t;
+
+/**
+ * @brief Load and parse a whole script file
+ *
+ * Only regular files are loaded. The file is mapped, parsed with the
+ * heap parser and unmapped again; the AST does not point into it.
+ * Backslash-newline pairs are removed before parsing, as they are when a
+ * file is read construct by construct. With SCRIPT_CACHE_DISK, a valid
+ * cache file is decoded instead of parsing, and a parsed script is written
+ * to the on-disk cache.
+ *
+ * @param path Script path, as given to source or on the command line
+ * @param flags SCRIPT_CACHE_* flags selecting the caches to use
+ * @return Parsed script (release with script_ast_release), or NULL if the
+ *         file is not a readable regular file or does not parse
+ */
+script_ast_t *script_ast_load(const char *path, int flags);
+
+/**
+ * @brief Get the first top-level command of a parsed script
+ *
+ * The remaining top-level commands follow through next_sibling. The tree
+ * is shared with the cache and other users and must not be modified.
+ *
+ * @param script Parsed script
+ * @return First command, or NULL for a script with no commands
+ */
+node_t *script_ast_commands(const script_ast_t *script);
+
+/**
+ * @brief Check whether a script was parsed under the current shell mode
+ *
+ * A command that changes the shell mode or the parser-visible options
+ * can change how the commands after it parse, so a script that no longer
+ * matches should not be run any further from its AST.
+ *
+ * @param script Parsed script
+ * @return true if the script would parse the same way now
+ */
+bool script_ast_mode_current(const script_ast_t *script);
+
+/**
+ * @brief Find where a top-level command of a parsed script starts
+ *
+ * Lets a caller stop running a script's AST and read the rest of the file
+ * construct by construct from that command on.
+ *
+ * @param script Parsed script
+ * @param command One of the script's top-level commands
+ * @return Byte offset of the command in the file, or -1 if the file
+ *         changed since it was parsed or cannot be read
+ */
+off_t script_ast_command_offset(const script_ast_t *script,
+                                const node_t *command);
+
+/**
+ * @brief Release a parsed script returned by script_ast_load()
+ *
+ * @param script Parsed script (NULL is ignored)
+ */
+void script_ast_release(script_ast_t *script);
+
+/**
+ * @brief Set the directory of the on-disk cache
+ *
+ * The directory is created on first write. Until this is called, and
+ * after it is called with NULL, SCRIPT_CACHE_DISK has no effect.
+ *
+ * @param dir Cache directory, or NULL to disable the on-disk cache
+ * @return true on success, false on allocation failure
+ */
+bool script_cache_set_disk_dir(const char *dir);
+
+/**
+ * @brief Get the default on-disk cache directory
+ *
+ * $XDG_CACHE_HOME/lush/ast, or ~/.cache/lush/ast when XDG_CACHE_HOME is
+ * not set.
+ *
+ * @return Allocated path, or NULL if no home directory is known
+ */
+char *script_cache_default_dir(void);
+
+/** @brief Release every cached script */
+void script_cache_clear(void);
+
+/**
+ * @brief Get script cache statistics
+ *
+ * @param stats Output statistics
+ */
+void script_cache_get_stats(script_cache_stats_t *stats);
+
+#endif /* SCRIPT_CACHE_H */
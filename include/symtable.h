@@ -17,7 +17,8 @@
 #include <stddef.h>
 #include <sys/types.h>
 
-// Forward declaration for libhashtable
+// Forward declarations for libhashtable
+typedef struct ht ht_t;
 typedef struct ht_strstr ht_strstr_t;
 
 // Forward declarations
@@ -77,21 +78,25 @@ typedef enum {
     SCOPE_CONDITIONAL // Conditional execution scope (if/case)
 } scope_type_t;
 
-// Variable entry structure
+// Variable entry structure (stored directly in each scope's hash table)
 struct symvar {
-    char *name;           // Variable name
+    char *name;           // Variable name (also the hash table key)
     char *value;          // Variable value (string representation)
     symvar_type_t type;   // Variable type
     symvar_flags_t flags; // Variable flags
     size_t scope_level;   // Scope level where defined
     symvar_t *next;       // Next variable in hash chain
+    size_t value_len;     // Length of value, excluding terminator
+    size_t value_cap;     // Allocated size of value buffer
+    long long int_value;  // Cached integer conversion of value
+    bool int_valid;       // True when int_value matches value
 };
 
 // Enhanced symbol table scope structure using libhashtable
 struct symtable_scope_enhanced {
     scope_type_t scope_type;  // Type of scope
     size_t level;             // Scope nesting level
-    ht_strstr_t *vars_ht;     // libhashtable ht_strstr_t for variables
+    ht_t *vars_ht;            // libhashtable ht_t of name -> symvar_t records
     symtable_scope_t *parent; // Parent scope
     char *scope_name;         // Name of scope (for debugging)
 };
@@ -247,6 +252,50 @@ int symtable_set_global_var(symtable_manager_t *manager, const char *name,
  */
 char *symtable_get_var(symtable_manager_t *manager, const char *name);
 
+/**
+ * @brief Get a borrowed reference to a variable value
+ *
+ * Zero-copy variant of symtable_get_var(). The returned string is owned
+ * by the symbol table and remains valid until the variable is next
+ * assigned, its scope is popped, or another dynamic variable ($RANDOM,
+ * $SECONDS, $LINENO, $-) is read through the same manager.
+ *
+ * @param manager Manager instance
+ * @param name Variable name
+ * @return Borrowed variable value or NULL if not found (do not free)
+ */
+const char *symtable_get_var_ref(symtable_manager_t *manager,
+                                 const char *name);
+
+/**
+ * @brief Get a variable value as an integer
+ *
+ * Uses the integer cache stored with the variable, so repeated reads of
+ * an unchanged variable (loop counters, arithmetic operands) convert the
+ * string only once. Conversion follows strtoll(value, NULL, 10).
+ *
+ * @param manager Manager instance
+ * @param name Variable name
+ * @param out Receives the integer value when found
+ * @return True if the variable exists, false otherwise
+ */
+bool symtable_get_var_integer(symtable_manager_t *manager, const char *name,
+                              long long *out);
+
+/**
+ * @brief Look up a variable record in the scope chain
+ *
+ * Returns the stored record so callers can inspect value and flags with
+ * a single lookup. Namerefs are not followed and unset variables are
+ * skipped. The record is borrowed and must not be modified or freed.
+ *
+ * @param manager Manager instance
+ * @param name Variable name
+ * @return Borrowed variable record or NULL if not found
+ */
+const symvar_t *symtable_lookup_var(symtable_manager_t *manager,
+                                    const char *name);
+
 /**
  * @brief Unset a variable
  *
@@ -284,7 +333,8 @@ int symtable_set_nameref(symtable_manager_t *manager, const char *name,
  * @param manager Manager instance
  * @param name Variable name (may be a nameref)
  * @param max_depth Maximum chain depth to follow (prevents infinite loops)
- * @return Resolved variable name or NULL if circular/not found
+ * @return Resolved variable name or NULL if circular. The result is either
+ *         @p name or a name borrowed from the symbol table (do not free).
  */
 const char *symtable_resolve_nameref(symtable_manager_t *manager,
                                      const char *name, int max_depth);
@@ -522,8 +572,8 @@ void symtable_debug_dump_all_scopes(void);
 /**
  * @brief Enumerate global variables with callback (debug - raw values)
  *
- * Note: This function returns raw encoded values with internal metadata.
- * For clean values, use symtable_enumerate_global_vars() instead.
+ * Note: This function also reports variables marked as unset.
+ * For visible variables only, use symtable_enumerate_global_vars() instead.
  *
  * @param callback Function called for each variable
  * @param userdata User data passed to callback
@@ -537,8 +587,8 @@ void symtable_debug_enumerate_global_vars(void (*callback)(const char *key,
  * @brief Enumerate global variables with callback (clean values)
  *
  * Enumerates all global shell variables and calls the callback for each one.
- * Unlike symtable_debug_enumerate_global_vars, this function returns the
- * actual variable values without internal metadata encoding.
+ * Unlike symtable_debug_enumerate_global_vars, this function skips
+ * variables that have been unset.
  *
  * @param callback Function called for each variable (key, value, userdata)
  * @param userdata User data passed to callback
@@ -15,6 +15,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "lle/arena.h"
+
 // Simple, clean token classification for parser
 typedef enum {
     // Basic token types
@@ -132,6 +134,7 @@ typedef struct tokenizer {
     token_t *lookahead;   // Next token (for lookahead)
     bool enable_keywords; // Whether to recognize keywords (context-sensitive)
     int arith_cmd_depth;  // Nesting depth of (( )) arithmetic commands
+    lle_arena_t *arena;   // Owns the tokenizer and its tokens (NULL = heap)
 } tokenizer_t;
 
 /* ============================================================================
@@ -146,6 +149,19 @@ typedef struct tokenizer {
  */
 tokenizer_t *tokenizer_new(const char *input);
 
+/**
+ * @brief Create a tokenizer whose tokens are allocated from an arena
+ *
+ * The tokenizer and every token it produces live in the arena; advancing
+ * past a token does not free it, and tokenizer_free() releases nothing.
+ * All of it goes away when the arena is reset or destroyed.
+ *
+ * @param input Shell command string to tokenize
+ * @param arena Arena to allocate from (NULL behaves like tokenizer_new)
+ * @return New tokenizer instance or NULL on failure
+ */
+tokenizer_t *tokenizer_new_in_arena(const char *input, lle_arena_t *arena);
+
 /**
  * @brief Free a tokenizer and associated resources
  *
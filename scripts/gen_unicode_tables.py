@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Generate the LLE Unicode property lookup table.
+
+Reads codepoint property files in Unicode Character Database layout
+(src/lle/unicode/data/width.txt and grapheme_break.txt) and writes a C
+source file holding a two-stage lookup table. Each codepoint maps to one
+byte: the Grapheme_Cluster_Break value in the low four bits and the
+display width in the next two (see include/lle/unicode_tables.h).
+
+Stage 1 is indexed by codepoint >> 8 and names a 256-entry block in
+stage 2. Identical blocks are stored once, so most of the codepoint
+space shares a handful of blocks and a lookup is two memory loads.
+
+Usage:
+    gen_unicode_tables.py WIDTH_FILE GRAPHEME_BREAK_FILE OUTPUT_FILE
+
+The build runs this from src/lle/meson.build; the output is not checked in.
+"""
+
+import os
+import re
+import sys
+
+MAX_CODEPOINT = 0x10FFFF
+BLOCK_SHIFT = 8
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+
+DEFAULT_WIDTH = 1
+WIDTH_SHIFT = 4
+
+# Order must match grapheme_cluster_break_t in unicode_grapheme.c
+GRAPHEME_BREAK_VALUES = [
+    "Other",
+    "CR",
+    "LF",
+    "Control",
+    "Extend",
+    "ZWJ",
+    "Regional_Indicator",
+    "Prepend",
+    "SpacingMark",
+    "L",
+    "V",
+    "T",
+    "LV",
+    "LVT",
+    "Extended_Pictographic",
+]
+
+LINE_RE = re.compile(
+    r"^([0-9A-Fa-f]{4,6})(?:\.\.([0-9A-Fa-f]{4,6}))?\s*;\s*(\S+)\s*$")
+
+
+def read_property_file(path, parse_value):
+    """Yield (first, last, value) for every entry in a UCD-style file."""
+    with open(path, encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            match = LINE_RE.match(line)
+            if not match:
+                sys.exit(f"{path}:{number}: malformed line")
+            first = int(match.group(1), 16)
+            last = int(match.group(2), 16) if match.group(2) else first
+            if last < first or last > MAX_CODEPOINT:
+                sys.exit(f"{path}:{number}: invalid range")
+            try:
+                value = parse_value(match.group(3))
+            except ValueError:
+                sys.exit(f"{path}:{number}: unknown value "
+                         f"'{match.group(3)}'")
+            yield first, last, value
+
+
+def parse_width(text):
+    width = int(text)
+    if width not in (0, 1, 2):
+        raise ValueError(text)
+    return width
+
+
+def build_properties(width_path, grapheme_break_path):
+    """Return one property byte per codepoint."""
+    widths = bytearray([DEFAULT_WIDTH]) * (MAX_CODEPOINT + 1)
+    for first, last, width in read_property_file(width_path, parse_width):
+        widths[first:last + 1] = bytes([width]) * (last - first + 1)
+
+    breaks = bytearray(MAX_CODEPOINT + 1)
+    for first, last, value in read_property_file(
+            grapheme_break_path, GRAPHEME_BREAK_VALUES.index):
+        breaks[first:last + 1] = bytes([value]) * (last - first + 1)
+
+    return bytes(b | (w << WIDTH_SHIFT) for b, w in zip(breaks, widths))
+
+
+def build_stages(properties):
+    """Split the property bytes into a block index and unique blocks."""
+    stage1 = []
+    stage2 = []
+    block_numbers = {}
+    for start in range(0, len(properties), BLOCK_SIZE):
+        block = properties[start:start + BLOCK_SIZE]
+        if block not in block_numbers:
+            block_numbers[block] = len(block_numbers)
+            stage2.append(block)
+        stage1.append(block_numbers[block])
+    return stage1, stage2
+
+
+def format_array(values, per_line, width):
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + " ".join(f"{v:#0{width}x}," for v in chunk))
+    return "\n".join(lines)
+
+
+def write_source(path, stage1, stage2, inputs):
+    flat = [value for block in stage2 for value in block]
+    sources = ", ".join(os.path.basename(p) for p in inputs)
+    with open(path, "w", encoding="utf-8") as out:
+        out.write(f"""\
+/*
+ * Generated by scripts/gen_unicode_tables.py from
+ * {sources}. Do not edit.
+ *
+ * {len(stage1)} stage 1 entries, {len(stage2)} unique blocks of {BLOCK_SIZE}.
+ */
+
+#include "lle/unicode_tables.h"
+
+#if LLE_UNICODE_BLOCK_SHIFT != {BLOCK_SHIFT} || \\
+    LLE_UNICODE_WIDTH_SHIFT != {WIDTH_SHIFT}
+#error "unicode_tables.h does not match scripts/gen_unicode_tables.py"
+#endif
+
+const uint8_t lle_unicode_stage1[{len(stage1)}] = {{
+{format_array(stage1, 12, 4)}
+}};
+
+const uint8_t lle_unicode_stage2[{len(flat)}] = {{
+{format_array(flat, 12, 4)}
+}};
+""")
+
+
+def main(argv):
+    if len(argv) != 4:
+        sys.exit(f"usage: {argv[0]} WIDTH_FILE GRAPHEME_BREAK_FILE "
+                 "OUTPUT_FILE")
+
+    width_path, grapheme_break_path, output_path = argv[1:]
+    properties = build_properties(width_path, grapheme_break_path)
+    stage1, stage2 = build_stages(properties)
+    if len(stage2) > 0x100:
+        sys.exit("too many unique blocks for an 8-bit stage 1")
+    write_source(output_path, stage1, stage2,
+                 [width_path, grapheme_break_path])
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -14,6 +14,12 @@
  * - Variable references and command substitution
  * - Hexadecimal and octal number formats
  *
+ * Expression text is compiled once into a postfix program: the shunting
+ * yard pass records the order in which it would push operands and apply
+ * operators, and evaluation replays that program with variables resolved
+ * through the symbol table at run time. Programs are cached by text, so a
+ * loop condition or repeated $((...)) is only tokenized the first time.
+ *
  * Based on the shunting yard algorithm implementation from:
  * - Original: http://en.literateprograms.org/Shunting_yard_algorithm_(C)
  * - Modified by Mohammed Isam for Layla shell
@@ -26,6 +32,7 @@
 #include "arithmetic.h"
 
 #include "executor.h"
+#include "ht.h"
 #include "lush.h"
 #include "symtable.h"
 
@@ -40,13 +47,16 @@
 #define MAXNUMSTACK 64
 #define MAXBASE 36
 
+/** Maximum number of compiled programs kept in the cache */
+#define ARITHM_CACHE_MAX 256
+
 // Stack item for arithmetic evaluation
 typedef struct {
     enum { ITEM_LONG_INT = 1, ITEM_VAR_PTR = 2 } type;
 
     union {
         ssize_t val;
-        char *var_name; // Store variable name instead of pointer
+        const char *var_name; // Variable name, owned by the program
     };
     void *executor_context; // Store executor context for scoped variable
                             // resolution
@@ -65,62 +75,48 @@ typedef struct {
     ssize_t (*eval)(stack_item_t *a1, stack_item_t *a2);
 } op_t;
 
-// Arithmetic evaluation context
+// Compiled program opcodes
+typedef enum {
+    AOP_PUSH_NUM,     // Push a literal value
+    AOP_PUSH_VAR,     // Push a variable, creating it as "0" if unset
+    AOP_PUSH_VAR_REF, // Push a ${name} variable reference
+    AOP_UNARY,        // Apply a unary operator to the top item
+    AOP_BINARY,       // Apply a binary operator to the top two items
+    AOP_TERNARY,      // Replace condition, true and false items by the pick
+    AOP_ERROR,        // Fail with an error found while compiling
+} arithm_opcode_t;
+
+// Compiled program instruction
 typedef struct {
+    arithm_opcode_t opcode;
+    union {
+        ssize_t num;         // AOP_PUSH_NUM
+        char *var_name;      // AOP_PUSH_VAR, AOP_PUSH_VAR_REF
+        op_t *op;            // AOP_UNARY, AOP_BINARY
+        const char *message; // AOP_ERROR
+    };
+} arithm_insn_t;
+
+// Compiled arithmetic expression
+struct arithm_program {
+    char *text;          // Source text (also the cache key)
+    arithm_insn_t *code; // Instructions in evaluation order
+    size_t count;
+    size_t capacity;
+};
+
+// Compilation context: the shunting yard stacks, with each operand reduced
+// to whether it is a variable reference
+typedef struct {
+    arithm_program_t *program;
     op_t *opstack[MAXOPSTACK];
     int nopstack;
-    stack_item_t numstack[MAXNUMSTACK];
+    bool numstack[MAXNUMSTACK]; // true if the slot holds a variable
     int nnumstack;
-    bool errflag;
-    char *error_message;
-    void *executor; // Store executor context for scoped variable resolution
-} arithm_context_t;
-
-/**
- * @brief Clean up an arithmetic evaluation context
- *
- * Frees any dynamically allocated memory in the context, including
- * variable names stored in the number stack and error messages.
- *
- * @param ctx The arithmetic context to clean up
- */
-static void arithm_context_cleanup(arithm_context_t *ctx) {
-    if (!ctx) {
-        return;
-    }
-
-    // Free any variable names stored in the number stack
-    // IMPORTANT: Only free var_name if type is ITEM_VAR_PTR, since
-    // val and var_name share the same memory (union) and we must not
-    // free numeric values as pointers
-    for (int i = 0; i < ctx->nnumstack; i++) {
-        if (ctx->numstack[i].type == ITEM_VAR_PTR &&
-            ctx->numstack[i].var_name) {
-            free(ctx->numstack[i].var_name);
-            ctx->numstack[i].var_name = NULL;
-        }
-    }
-
-    if (ctx->error_message) {
-        free(ctx->error_message);
-        ctx->error_message = NULL;
-    }
-}
-
-/**
- * @brief Free any allocated memory in a stack item
- *
- * This should be called after a popped stack item has been consumed
- * to prevent memory leaks from strdup'd var_name fields.
- *
- * @param item The stack item to clean up
- */
-static void stack_item_cleanup(stack_item_t *item) {
-    if (item && item->type == ITEM_VAR_PTR && item->var_name) {
-        free(item->var_name);
-        item->var_name = NULL;
-    }
-}
+    bool errflag;      // Stop compiling
+    const char *error; // Error to raise when the program reaches this point
+    bool oom;          // Allocation failed, program is unusable
+} arithm_compiler_t;
 
 // Global error state
 bool arithm_error_flag = false;
@@ -128,16 +124,6 @@ char *arithm_error_message = NULL;
 
 // Forward declarations for internal functions
 static ssize_t long_value(stack_item_t *item);
-static void push_opstack(arithm_context_t *ctx, op_t *op);
-static op_t *pop_opstack(arithm_context_t *ctx);
-static void push_numstackl(arithm_context_t *ctx, ssize_t val);
-static void push_numstackv(arithm_context_t *ctx, const char *var_name);
-static stack_item_t pop_numstack(arithm_context_t *ctx);
-static void shunt_op(arithm_context_t *ctx, op_t *op);
-static op_t *get_op(const char *expr);
-static ssize_t get_num(const char *expr, int *nchars);
-static char *get_var_name(const char *expr, int *nchars);
-static bool valid_name_char(char c);
 
 // ============================================================================
 // OPERATOR EVALUATION FUNCTIONS
@@ -312,23 +298,21 @@ static ssize_t get_var_value_scoped(stack_item_t *item) {
         return 0;
     }
     
+    long long value;
+
     // Use executor context if available for scoped variable resolution
     if (item->executor_context) {
         executor_t *exec = (executor_t *)item->executor_context;
-        if (exec && exec->symtable) {
-            char *value = symtable_get_var(exec->symtable, item->var_name);
-            if (value) {
-                ssize_t result = strtol(value, NULL, 10);
-                free(value);
-                return result;
-            }
+        if (exec && exec->symtable &&
+            symtable_get_var_integer(exec->symtable, item->var_name, &value)) {
+            return (ssize_t)value;
         }
     }
     
     // Fallback to global
-    char *value = symtable_get_global(item->var_name);
-    if (value) {
-        return strtol(value, NULL, 10);
+    if (symtable_get_var_integer(symtable_get_global_manager(), item->var_name,
+                                 &value)) {
+        return (ssize_t)value;
     }
     return 0;
 }
@@ -619,7 +603,7 @@ static op_t op_postdec = {CH_POSTDEC, 1, ASSOC_LEFT, 1, 2, eval_postdec};
 #define OP_POSTDEC (&op_postdec)
 
 // ============================================================================
-// STACK MANAGEMENT AND VALUE CONVERSION
+// VALUE CONVERSION
 // ============================================================================
 
 /**
@@ -638,31 +622,25 @@ static ssize_t long_value(stack_item_t *item) {
         return item->val;
     case ITEM_VAR_PTR: {
         if (item->var_name) {
+            // Integer conversions are cached in the variable record
+            long long value;
+
             // Use executor context if available for scoped variable resolution
             if (item->executor_context) {
                 // Use proper executor structure from executor.h
                 executor_t *exec = (executor_t *)item->executor_context;
 
-                if (exec && exec->symtable) {
-                    char *value =
-                        symtable_get_var(exec->symtable, item->var_name);
-                    if (value) {
-                        long result = atol(value);
-                        free(value);
-                        return result;
-                    }
+                if (exec && exec->symtable &&
+                    symtable_get_var_integer(exec->symtable, item->var_name,
+                                             &value)) {
+                    return (ssize_t)value;
                 }
             }
 
             // Fallback to global manager
-            symtable_manager_t *manager = symtable_get_global_manager();
-            if (manager) {
-                char *value = symtable_get_var(manager, item->var_name);
-                if (value) {
-                    long result = atol(value);
-                    free(value);
-                    return result;
-                }
+            if (symtable_get_var_integer(symtable_get_global_manager(),
+                                         item->var_name, &value)) {
+                return (ssize_t)value;
             }
         }
         return 0;
@@ -672,15 +650,62 @@ static ssize_t long_value(stack_item_t *item) {
     }
 }
 
+/**
+ * @brief Check if a character is valid in a variable name
+ * @param c Character to check
+ * @return true if character is alphanumeric or underscore
+ */
+static bool valid_name_char(char c) { return isalnum(c) || c == '_'; }
+
+// ============================================================================
+// PROGRAM EMISSION AND COMPILE-TIME STACKS
+// ============================================================================
+
+/**
+ * @brief Record an error to be raised when the program reaches this point
+ *
+ * Compile-time counterpart of arithm_set_error(): the latest error wins.
+ *
+ * @param ctx Compilation context
+ * @param message Static error message
+ */
+static void compile_error(arithm_compiler_t *ctx, const char *message) {
+    ctx->error = message;
+}
+
+/**
+ * @brief Append an instruction to the program being compiled
+ * @param ctx Compilation context
+ * @param insn Instruction to append
+ * @return true on success, false on allocation failure
+ */
+static bool emit(arithm_compiler_t *ctx, arithm_insn_t insn) {
+    arithm_program_t *program = ctx->program;
+    if (program->count == program->capacity) {
+        size_t capacity = program->capacity ? program->capacity * 2 : 16;
+        arithm_insn_t *code =
+            realloc(program->code, capacity * sizeof(arithm_insn_t));
+        if (!code) {
+            ctx->oom = true;
+            ctx->errflag = true;
+            return false;
+        }
+        program->code = code;
+        program->capacity = capacity;
+    }
+    program->code[program->count++] = insn;
+    return true;
+}
+
 /**
  * @brief Push an operator onto the operator stack
- * @param ctx Arithmetic evaluation context
+ * @param ctx Compilation context
  * @param op Operator to push
  */
-static void push_opstack(arithm_context_t *ctx, op_t *op) {
+static void push_opstack(arithm_compiler_t *ctx, op_t *op) {
     if (ctx->nopstack >= MAXOPSTACK) {
         ctx->errflag = true;
-        arithm_set_error("operator stack overflow");
+        compile_error(ctx, "operator stack overflow");
         return;
     }
     ctx->opstack[ctx->nopstack++] = op;
@@ -688,78 +713,164 @@ static void push_opstack(arithm_context_t *ctx, op_t *op) {
 
 /**
  * @brief Pop an operator from the operator stack
- * @param ctx Arithmetic evaluation context
+ * @param ctx Compilation context
  * @return Popped operator, or NULL on underflow
  */
-static op_t *pop_opstack(arithm_context_t *ctx) {
+static op_t *pop_opstack(arithm_compiler_t *ctx) {
     if (ctx->nopstack <= 0) {
         ctx->errflag = true;
-        arithm_set_error("operator stack underflow");
+        compile_error(ctx, "operator stack underflow");
         return NULL;
     }
     return ctx->opstack[--ctx->nopstack];
 }
 
 /**
- * @brief Push a literal integer value onto the number stack
- * @param ctx Arithmetic evaluation context
- * @param val Integer value to push
+ * @brief Reserve a number stack slot
+ * @param ctx Compilation context
+ * @param is_var Whether the slot will hold a variable reference
+ * @return true on success, false on overflow
  */
-static void push_numstackl(arithm_context_t *ctx, ssize_t val) {
+static bool push_operand(arithm_compiler_t *ctx, bool is_var) {
     if (ctx->nnumstack >= MAXNUMSTACK) {
         ctx->errflag = true;
-        arithm_set_error("number stack overflow");
-        return;
+        compile_error(ctx, "number stack overflow");
+        return false;
     }
-    ctx->numstack[ctx->nnumstack].type = ITEM_LONG_INT;
-    ctx->numstack[ctx->nnumstack].val = val;
-    ctx->nnumstack++;
+    ctx->numstack[ctx->nnumstack++] = is_var;
+    return true;
 }
 
 /**
- * @brief Push a variable reference onto the number stack with executor context
- * @param ctx Arithmetic evaluation context
- * @param var_name Name of the variable to reference
+ * @brief Emit a literal integer push
+ * @param ctx Compilation context
+ * @param val Integer value to push
  */
-static void push_numstackv_with_context(arithm_context_t *ctx,
-                                        const char *var_name) {
-    if (ctx->nnumstack >= MAXNUMSTACK) {
-        ctx->errflag = true;
-        arithm_set_error("number stack overflow");
+static void push_numstackl(arithm_compiler_t *ctx, ssize_t val) {
+    if (!push_operand(ctx, false)) {
         return;
     }
-    ctx->numstack[ctx->nnumstack].type = ITEM_VAR_PTR;
-    ctx->numstack[ctx->nnumstack].var_name = strdup(var_name);
-    ctx->numstack[ctx->nnumstack].executor_context = ctx->executor;
-    ctx->nnumstack++;
+    emit(ctx, (arithm_insn_t){.opcode = AOP_PUSH_NUM, .num = val});
 }
 
-MAYBE_UNUSED
-static void push_numstackv(arithm_context_t *ctx, const char *var_name) {
-    push_numstackv_with_context(ctx, var_name);
+/**
+ * @brief Emit a variable reference push
+ * @param ctx Compilation context
+ * @param opcode AOP_PUSH_VAR or AOP_PUSH_VAR_REF
+ * @param var_name Variable name (ownership passes to the program)
+ */
+static void push_numstackv(arithm_compiler_t *ctx, arithm_opcode_t opcode,
+                           char *var_name) {
+    if (!push_operand(ctx, true) ||
+        !emit(ctx, (arithm_insn_t){.opcode = opcode, .var_name = var_name})) {
+        free(var_name);
+    }
 }
 
 /**
- * @brief Pop a value from the number stack
- * @param ctx Arithmetic evaluation context
- * @return Popped stack item, or empty item on underflow
+ * @brief Pop a number stack slot
+ * @param ctx Compilation context
+ * @return true if the slot held a variable reference
  */
-static stack_item_t pop_numstack(arithm_context_t *ctx) {
-    stack_item_t empty = {ITEM_LONG_INT, {0}, NULL};
+static bool pop_numstack(arithm_compiler_t *ctx) {
     if (ctx->nnumstack <= 0) {
         ctx->errflag = true;
-        arithm_set_error("number stack underflow");
-        return empty;
+        compile_error(ctx, "number stack underflow");
+        return false;
     }
     return ctx->numstack[--ctx->nnumstack];
 }
 
 /**
- * @brief Check if a character is valid in a variable name
- * @param c Character to check
- * @return true if character is alphanumeric or underscore
+ * @brief Emit the application of an operator popped from the stack
+ *
+ * Consumes the operator's operands and leaves a plain value in their
+ * place, exactly as evaluating the operator does.
+ *
+ * @param ctx Compilation context
+ * @param op Popped operator
  */
-static bool valid_name_char(char c) { return isalnum(c) || c == '_'; }
+static void reduce_op(arithm_compiler_t *ctx, op_t *op) {
+    pop_numstack(ctx);
+    if (ctx->errflag) {
+        return;
+    }
+    if (!op->unary) {
+        pop_numstack(ctx);
+        if (ctx->errflag) {
+            return;
+        }
+    }
+
+    if (!op->eval) {
+        // Unclosed '(' reached evaluation
+        ctx->errflag = true;
+        compile_error(ctx, "mismatched parentheses");
+        return;
+    }
+
+    arithm_opcode_t opcode = op->unary ? AOP_UNARY : AOP_BINARY;
+    if (!emit(ctx, (arithm_insn_t){.opcode = opcode, .op = op})) {
+        return;
+    }
+    push_operand(ctx, false);
+    if (ctx->error) {
+        ctx->errflag = true;
+    }
+}
+
+/**
+ * @brief Emit a ternary selection for a popped ':' operator
+ *
+ * The matching '?' must be on top of the operator stack; the condition,
+ * true and false values are the top three operands.
+ *
+ * @param ctx Compilation context
+ */
+static void reduce_ternary(arithm_compiler_t *ctx) {
+    pop_numstack(ctx); // False value
+    if (ctx->errflag) {
+        return;
+    }
+
+    if (ctx->nopstack == 0 ||
+        ctx->opstack[ctx->nopstack - 1]->op != CH_TERNARY_Q) {
+        compile_error(ctx, "mismatched ternary operator");
+        ctx->errflag = true;
+        return;
+    }
+    pop_opstack(ctx); // Remove the '?'
+
+    pop_numstack(ctx); // True value
+    if (ctx->errflag) {
+        return;
+    }
+    pop_numstack(ctx); // Condition
+    if (ctx->errflag) {
+        return;
+    }
+
+    if (emit(ctx, (arithm_insn_t){.opcode = AOP_TERNARY})) {
+        push_operand(ctx, false);
+    }
+}
+
+/**
+ * @brief Pop and reduce one operator, handling ternary pairs
+ * @param ctx Compilation context
+ */
+static void reduce_top(arithm_compiler_t *ctx) {
+    op_t *pop_op = pop_opstack(ctx);
+    if (ctx->errflag) {
+        return;
+    }
+
+    if (pop_op->op == CH_TERNARY_C) {
+        reduce_ternary(ctx);
+    } else {
+        reduce_op(ctx, pop_op);
+    }
+}
 
 // ============================================================================
 // EXPRESSION PARSING
@@ -871,16 +982,15 @@ static ssize_t get_num(const char *expr, int *nchars) {
  *
  * Parses a variable name starting at the current position. Variable names
  * can start with a letter, underscore, or digit (for positional parameters).
- * Ensures the variable exists in the symbol table with a default value of "0".
+ * The variable itself is only touched when the program runs.
  *
- * @param ctx Arithmetic evaluation context (for executor access)
+ * @param ctx Compilation context (for error reporting)
  * @param expr Pointer to current position in expression
  * @param nchars Output: number of characters consumed
  * @return Allocated variable name string, or NULL on error
  */
-static char *get_var_name_with_context(arithm_context_t *ctx
-                                       __attribute__((unused)),
-                                       const char *expr, int *nchars) {
+static char *get_var_name(arithm_compiler_t *ctx, const char *expr,
+                          int *nchars) {
     const char *start = expr;
     *nchars = 0;
 
@@ -902,43 +1012,25 @@ static char *get_var_name_with_context(arithm_context_t *ctx
         }
     }
 
-    // Extract variable name
-    char *name = malloc(*nchars + 1);
+    char *name = strndup(start, *nchars);
     if (!name) {
-        arithm_set_error("memory allocation failed");
-        return NULL;
-    }
-
-    strncpy(name, start, *nchars);
-    name[*nchars] = '\0';
-
-    // Always ensure variable exists in global symbol table with default value
-    // "0" The actual value resolution will happen during evaluation using
-    // executor context
-    symtable_manager_t *manager = symtable_get_global_manager();
-    if (manager && !symtable_var_exists(manager, name)) {
-        symtable_set_var(manager, name, "0", SYMVAR_NONE);
+        compile_error(ctx, "memory allocation failed");
     }
-
     return name;
 }
 
-MAYBE_UNUSED
-static char *get_var_name(const char *expr, int *nchars) {
-    return get_var_name_with_context(NULL, expr, nchars);
-}
-
 /**
  * @brief Process an operator using the shunting yard algorithm
  *
  * Implements the core shunting yard logic for operator precedence parsing.
- * Handles parentheses matching, operator precedence, and associativity
- * to convert infix notation to evaluation order.
+ * Handles parentheses matching, operator precedence, and associativity;
+ * every operator the algorithm pops is emitted into the program, giving
+ * the postfix evaluation order.
  *
- * @param ctx Arithmetic evaluation context with operator and number stacks
+ * @param ctx Compilation context with operator and number stacks
  * @param op Operator to process
  */
-static void shunt_op(arithm_context_t *ctx, op_t *op) {
+static void shunt_op(arithm_compiler_t *ctx, op_t *op) {
     if (op->op == '(') {
         push_opstack(ctx, op);
     } else if (op->op == CH_TERNARY_C) {
@@ -950,107 +1042,17 @@ static void shunt_op(arithm_context_t *ctx, op_t *op) {
             if (ctx->errflag) {
                 return;
             }
-
-            stack_item_t a1 = pop_numstack(ctx);
+            reduce_op(ctx, pop_op);
             if (ctx->errflag) {
                 return;
             }
-
-            if (pop_op->unary) {
-                push_numstackl(ctx, pop_op->eval(&a1, NULL));
-                stack_item_cleanup(&a1);
-            } else {
-                stack_item_t a2 = pop_numstack(ctx);
-                if (ctx->errflag) {
-                    stack_item_cleanup(&a1);
-                    return;
-                }
-                push_numstackl(ctx, pop_op->eval(&a2, &a1));
-                stack_item_cleanup(&a1);
-                stack_item_cleanup(&a2);
-            }
-            if (arithm_error_flag) {
-                ctx->errflag = true;
-                return;
-            }
         }
         // Push the colon operator to mark the separation
         push_opstack(ctx, op);
     } else if (op->op == ')') {
         while (ctx->nopstack > 0 &&
                ctx->opstack[ctx->nopstack - 1]->op != '(') {
-            op_t *pop_op = pop_opstack(ctx);
-            if (ctx->errflag) {
-                return;
-            }
-
-            // Handle ternary operator specially
-            if (pop_op->op == CH_TERNARY_C) {
-                // We have the false value on the stack
-                stack_item_t false_val = pop_numstack(ctx);
-                if (ctx->errflag) {
-                    return;
-                }
-                
-                // Next operator should be '?'
-                if (ctx->nopstack > 0 && ctx->opstack[ctx->nopstack - 1]->op == CH_TERNARY_Q) {
-                    pop_opstack(ctx); // Remove the '?'
-                    
-                    // Get true value and condition
-                    stack_item_t true_val = pop_numstack(ctx);
-                    if (ctx->errflag) {
-                        stack_item_cleanup(&false_val);
-                        return;
-                    }
-                    stack_item_t condition = pop_numstack(ctx);
-                    if (ctx->errflag) {
-                        stack_item_cleanup(&false_val);
-                        stack_item_cleanup(&true_val);
-                        return;
-                    }
-                    
-                    // Evaluate: condition ? true_val : false_val
-                    ssize_t result = long_value(&condition) ? long_value(&true_val) : long_value(&false_val);
-                    push_numstackl(ctx, result);
-                    
-                    stack_item_cleanup(&condition);
-                    stack_item_cleanup(&true_val);
-                    stack_item_cleanup(&false_val);
-                } else {
-                    arithm_set_error("mismatched ternary operator");
-                    stack_item_cleanup(&false_val);
-                    ctx->errflag = true;
-                    return;
-                }
-                continue;
-            }
-
-            stack_item_t a1 = pop_numstack(ctx);
-            if (ctx->errflag) {
-                return;
-            }
-
-            if (pop_op->unary) {
-                push_numstackl(ctx, pop_op->eval(&a1, NULL));
-                stack_item_cleanup(&a1);
-                if (arithm_error_flag) {
-                    ctx->errflag = true;
-                    return;
-                }
-            } else {
-                stack_item_t a2 = pop_numstack(ctx);
-                if (ctx->errflag) {
-                    stack_item_cleanup(&a1);
-                    return;
-                }
-                push_numstackl(ctx, pop_op->eval(&a2, &a1));
-                stack_item_cleanup(&a1);
-                stack_item_cleanup(&a2);
-                if (arithm_error_flag) {
-                    ctx->errflag = true;
-                    return;
-                }
-            }
+            reduce_top(ctx);
             if (ctx->errflag) {
                 return;
             }
@@ -1060,7 +1062,7 @@ static void shunt_op(arithm_context_t *ctx, op_t *op) {
             pop_opstack(ctx); // Remove the '('
         } else {
             ctx->errflag = true;
-            arithm_set_error("mismatched parentheses");
+            compile_error(ctx, "mismatched parentheses");
         }
     } else {
         while (ctx->nopstack > 0 &&
@@ -1070,79 +1072,7 @@ static void shunt_op(arithm_context_t *ctx, op_t *op) {
                  op->prec >= ctx->opstack[ctx->nopstack - 1]->prec) ||
                 (op->assoc == ASSOC_RIGHT &&
                  op->prec > ctx->opstack[ctx->nopstack - 1]->prec))) {
-
-            op_t *pop_op = pop_opstack(ctx);
-            if (ctx->errflag) {
-                return;
-            }
-
-            // Handle ternary operator specially
-            if (pop_op->op == CH_TERNARY_C) {
-                // We have the false value on the stack
-                stack_item_t false_val = pop_numstack(ctx);
-                if (ctx->errflag) {
-                    return;
-                }
-                
-                // Next operator should be '?'
-                if (ctx->nopstack > 0 && ctx->opstack[ctx->nopstack - 1]->op == CH_TERNARY_Q) {
-                    pop_opstack(ctx); // Remove the '?'
-                    
-                    // Get true value and condition
-                    stack_item_t true_val = pop_numstack(ctx);
-                    if (ctx->errflag) {
-                        stack_item_cleanup(&false_val);
-                        return;
-                    }
-                    stack_item_t condition = pop_numstack(ctx);
-                    if (ctx->errflag) {
-                        stack_item_cleanup(&false_val);
-                        stack_item_cleanup(&true_val);
-                        return;
-                    }
-                    
-                    // Evaluate: condition ? true_val : false_val
-                    ssize_t result = long_value(&condition) ? long_value(&true_val) : long_value(&false_val);
-                    push_numstackl(ctx, result);
-                    
-                    stack_item_cleanup(&condition);
-                    stack_item_cleanup(&true_val);
-                    stack_item_cleanup(&false_val);
-                } else {
-                    arithm_set_error("mismatched ternary operator");
-                    stack_item_cleanup(&false_val);
-                    ctx->errflag = true;
-                    return;
-                }
-                continue;
-            }
-
-            stack_item_t a1 = pop_numstack(ctx);
-            if (ctx->errflag) {
-                return;
-            }
-
-            if (pop_op->unary) {
-                push_numstackl(ctx, pop_op->eval(&a1, NULL));
-                stack_item_cleanup(&a1);
-                if (arithm_error_flag) {
-                    ctx->errflag = true;
-                    return;
-                }
-            } else {
-                stack_item_t a2 = pop_numstack(ctx);
-                if (ctx->errflag) {
-                    stack_item_cleanup(&a1);
-                    return;
-                }
-                push_numstackl(ctx, pop_op->eval(&a2, &a1));
-                stack_item_cleanup(&a1);
-                stack_item_cleanup(&a2);
-                if (arithm_error_flag) {
-                    ctx->errflag = true;
-                    return;
-                }
-            }
+            reduce_top(ctx);
             if (ctx->errflag) {
                 return;
             }
@@ -1152,84 +1082,60 @@ static void shunt_op(arithm_context_t *ctx, op_t *op) {
     }
 }
 
-// Error handling functions
-void arithm_init(void) { arithm_clear_error(); }
-
-void arithm_cleanup(void) { arithm_clear_error(); }
-
-const char *arithm_get_last_error(void) { return arithm_error_message; }
-
-void arithm_set_error(const char *message) {
-    arithm_clear_error();
-    arithm_error_flag = true;
-    if (message) {
-        arithm_error_message = strdup(message);
-    }
-}
-
-void arithm_clear_error(void) {
-    arithm_error_flag = false;
-    if (arithm_error_message) {
-        free(arithm_error_message);
-        arithm_error_message = NULL;
+/**
+ * @brief Emit the value of an arithmetic command substitution
+ *
+ * Only "echo NUMBER" is understood; any other command yields 0.
+ *
+ * @param ctx Compilation context
+ * @param start Command text (after "$(")
+ * @param len Command text length
+ */
+static void compile_command_subst(arithm_compiler_t *ctx, const char *start,
+                                  size_t len) {
+    char *command = strndup(start, len);
+    if (!command) {
+        push_numstackl(ctx, 0);
+        return;
     }
-}
-
-// Main arithmetic expansion function
-// Forward declaration for the executor-aware version
-static char *arithm_expand_internal(void *executor, const char *orig_expr);
 
-char *arithm_expand(const char *orig_expr) {
-    return arithm_expand_internal(NULL, orig_expr);
-}
-
-char *arithm_expand_with_executor(executor_t *executor, const char *orig_expr) {
-    return arithm_expand_internal(executor, orig_expr);
-}
-
-static char *arithm_expand_internal(void *executor, const char *orig_expr) {
-    if (!orig_expr) {
-        return strdup("0");
+    // Simple implementation: handle basic echo commands
+    char *trimmed = command;
+    while (*trimmed && isspace(*trimmed)) {
+        trimmed++;
     }
 
-    // Initialize context
-    arithm_context_t ctx = {0};
-    ctx.executor = executor; // Store executor context in arithmetic context
-    arithm_clear_error();
-
-    // Parse expression and remove $(( )) wrapper if present
-    const char *expr;
-    char *cleaned_expr = NULL;
-
-    if (strncmp(orig_expr, "$((", 3) == 0) {
-        size_t len = strlen(orig_expr);
-        if (len >= 5 && orig_expr[len - 2] == ')' &&
-            orig_expr[len - 1] == ')') {
-            // Extract expression between $(( and ))
-            size_t expr_len = len - 5;
-            cleaned_expr = malloc(expr_len + 1);
-            if (!cleaned_expr) {
-                arithm_set_error("memory allocation failed");
-                return NULL;
-            }
-            strncpy(cleaned_expr, orig_expr + 3, expr_len);
-            cleaned_expr[expr_len] = '\0';
-            expr = cleaned_expr;
+    // Check if it's a simple echo number command
+    if (strncmp(trimmed, "echo ", 5) == 0) {
+        char *num_str = trimmed + 5;
+        while (*num_str && isspace(*num_str)) {
+            num_str++;
+        }
+        if (isdigit(*num_str) ||
+            (*num_str == '-' && isdigit(*(num_str + 1)))) {
+            push_numstackl(ctx, strtol(num_str, NULL, 10));
         } else {
-            arithm_set_error(
-                "malformed arithmetic expression: missing closing ))");
-            return NULL;
+            push_numstackl(ctx, 0);
         }
     } else {
-        expr = orig_expr;
+        // For other commands, default to 0 for now
+        push_numstackl(ctx, 0);
     }
 
-    // Tokenize and evaluate expression using clearer state management
+    free(command);
+}
+
+/**
+ * @brief Tokenize an expression and emit its program
+ * @param ctx Compilation context
+ * @param expr Expression text without the $(( )) wrapper
+ */
+static void compile_expression(arithm_compiler_t *ctx, const char *expr) {
     const char *current = expr;
     op_t start_op = {'X', 0, ASSOC_NONE, 0, 0, NULL};
     op_t *last_op = &start_op;
 
-    while (*current && !ctx.errflag) {
+    while (*current && !ctx->errflag) {
         // Skip whitespace
         while (*current && isspace(*current)) {
             current++;
@@ -1247,8 +1153,8 @@ static char *arithm_expand_internal(void *executor, const char *orig_expr) {
                 // Check if this should be post-increment/decrement
                 // If the last token was a variable or closing paren, it's
                 // post-increment
-                if (ctx.nnumstack > 0 &&
-                    (ctx.numstack[ctx.nnumstack - 1].type == ITEM_VAR_PTR ||
+                if (ctx->nnumstack > 0 &&
+                    (ctx->numstack[ctx->nnumstack - 1] ||
                      (last_op && last_op->op == ')'))) {
                     // Convert to post-increment/decrement
                     if (op == OP_PREINC) {
@@ -1266,13 +1172,13 @@ static char *arithm_expand_internal(void *executor, const char *orig_expr) {
                 } else if (op->op == '+') {
                     op = OP_UPLUS;
                 } else if (op->op != '(' && !op->unary) {
-                    arithm_set_error("illegal use of binary operator");
+                    compile_error(ctx, "illegal use of binary operator");
                     break;
                 }
             }
 
-            shunt_op(&ctx, op);
-            if (ctx.errflag) {
+            shunt_op(ctx, op);
+            if (ctx->errflag) {
                 break;
             }
             last_op = op;
@@ -1281,8 +1187,8 @@ static char *arithm_expand_internal(void *executor, const char *orig_expr) {
             // Parse number
             int nchars;
             ssize_t num = get_num(current, &nchars);
-            push_numstackl(&ctx, num);
-            if (ctx.errflag) {
+            push_numstackl(ctx, num);
+            if (ctx->errflag) {
                 break;
             }
             last_op = NULL;
@@ -1306,51 +1212,16 @@ static char *arithm_expand_internal(void *executor, const char *orig_expr) {
             }
 
             if (paren_count == 0 && *end == ')') {
-                // Extract command and execute it
-                size_t cmd_len = end - start;
-                char *command = malloc(cmd_len + 1);
-                if (command) {
-                    strncpy(command, start, cmd_len);
-                    command[cmd_len] = '\0';
-
-                    // Simple implementation: handle basic echo commands
-                    char *trimmed = command;
-                    while (*trimmed && isspace(*trimmed)) {
-                        trimmed++;
-                    }
-
-                    // Check if it's a simple echo number command
-                    if (strncmp(trimmed, "echo ", 5) == 0) {
-                        char *num_str = trimmed + 5;
-                        while (*num_str && isspace(*num_str)) {
-                            num_str++;
-                        }
-                        if (isdigit(*num_str) ||
-                            (*num_str == '-' && isdigit(*(num_str + 1)))) {
-                            long val = strtol(num_str, NULL, 10);
-                            push_numstackl(&ctx, val);
-                        } else {
-                            push_numstackl(&ctx, 0);
-                        }
-                    } else {
-                        // For other commands, default to 0 for now
-                        push_numstackl(&ctx, 0);
-                    }
-
-                    free(command);
-                } else {
-                    push_numstackl(&ctx, 0);
-                }
-
+                compile_command_subst(ctx, start, end - start);
                 current = end + 1; // Skip past the closing )
             } else {
                 // Malformed command substitution
-                arithm_set_error(
-                    "malformed command substitution in arithmetic");
+                compile_error(ctx,
+                              "malformed command substitution in arithmetic");
                 break;
             }
 
-            if (ctx.errflag) {
+            if (ctx->errflag) {
                 break;
             }
             last_op = NULL;
@@ -1358,193 +1229,388 @@ static char *arithm_expand_internal(void *executor, const char *orig_expr) {
             // Handle ${variable} syntax in arithmetic expressions
             const char *start = current + 2; // Skip ${
             const char *end = strchr(start, '}');
-            
+
             if (end) {
                 // Extract variable name (handle simple ${var} for now)
                 // More complex forms like ${var:-default} would need executor
-                
+
                 // Find the end of the variable name (before any operator)
                 const char *name_end = start;
-                while (name_end < end && (isalnum(*name_end) || *name_end == '_')) {
+                while (name_end < end &&
+                       (isalnum(*name_end) || *name_end == '_')) {
                     name_end++;
                 }
-                
+
+                char *var_name = NULL;
                 if (name_end > start) {
-                    size_t var_len = name_end - start;
-                    char *var_name = malloc(var_len + 1);
-                    if (var_name) {
-                        strncpy(var_name, start, var_len);
-                        var_name[var_len] = '\0';
-                        push_numstackv_with_context(&ctx, var_name);
-                        free(var_name);
-                    } else {
-                        push_numstackl(&ctx, 0);
-                    }
+                    var_name = strndup(start, name_end - start);
+                }
+                if (var_name) {
+                    push_numstackv(ctx, AOP_PUSH_VAR_REF, var_name);
                 } else {
-                    push_numstackl(&ctx, 0);
+                    push_numstackl(ctx, 0);
                 }
-                
+
                 current = end + 1; // Skip past }
             } else {
-                arithm_set_error("unmatched ${ in arithmetic expression");
+                compile_error(ctx, "unmatched ${ in arithmetic expression");
                 break;
             }
-            
-            if (ctx.errflag) {
+
+            if (ctx->errflag) {
                 break;
             }
             last_op = NULL;
-        } else if (*current == '$' && valid_name_char(*(current + 1))) {
-            // Handle $variable syntax in arithmetic expressions
-            current++; // Skip the '$'
-            int nchars;
-            char *var_name = get_var_name_with_context(&ctx, current, &nchars);
-            if (var_name) {
-                push_numstackv_with_context(&ctx, var_name);
-                free(var_name);
-            } else {
-                push_numstackl(&ctx, 0); // Undefined variable = 0
+        } else if (valid_name_char(*current) ||
+                   (*current == '$' && valid_name_char(*(current + 1)))) {
+            // Parse variable name, with or without a leading '$'
+            if (*current == '$') {
+                current++;
             }
-            if (ctx.errflag) {
-                break;
-            }
-            last_op = NULL;
-            current += nchars;
-        } else if (valid_name_char(*current)) {
-            // Parse variable name
             int nchars;
-            char *var_name = get_var_name_with_context(&ctx, current, &nchars);
+            char *var_name = get_var_name(ctx, current, &nchars);
             if (var_name) {
-                push_numstackv_with_context(&ctx, var_name);
-                free(var_name);
+                push_numstackv(ctx, AOP_PUSH_VAR, var_name);
             } else {
-                push_numstackl(&ctx, 0); // Undefined variable = 0
+                push_numstackl(ctx, 0); // Undefined variable = 0
             }
-            if (ctx.errflag) {
+            if (ctx->errflag) {
                 break;
             }
             last_op = NULL;
             current += nchars;
         } else {
-            arithm_set_error("syntax error in arithmetic expression");
+            compile_error(ctx, "syntax error in arithmetic expression");
             break;
         }
     }
 
     // Process remaining operators
-    while (ctx.nopstack > 0 && !ctx.errflag) {
-        op_t *op = pop_opstack(&ctx);
-        if (ctx.errflag) {
-            break;
-        }
-
-        // Handle ternary operator specially
-        if (op->op == CH_TERNARY_C) {
-            // We have the false value on the stack
-            stack_item_t false_val = pop_numstack(&ctx);
-            if (ctx.errflag) {
-                break;
-            }
-            
-            // Next operator should be '?'
-            if (ctx.nopstack > 0 && ctx.opstack[ctx.nopstack - 1]->op == CH_TERNARY_Q) {
-                pop_opstack(&ctx); // Remove the '?'
-                
-                // Get true value and condition
-                stack_item_t true_val = pop_numstack(&ctx);
-                if (ctx.errflag) {
-                    stack_item_cleanup(&false_val);
-                    break;
-                }
-                stack_item_t condition = pop_numstack(&ctx);
-                if (ctx.errflag) {
-                    stack_item_cleanup(&false_val);
-                    stack_item_cleanup(&true_val);
-                    break;
-                }
-                
-                // Evaluate: condition ? true_val : false_val
-                ssize_t result = long_value(&condition) ? long_value(&true_val) : long_value(&false_val);
-                push_numstackl(&ctx, result);
-                
-                stack_item_cleanup(&condition);
-                stack_item_cleanup(&true_val);
-                stack_item_cleanup(&false_val);
-            } else {
-                arithm_set_error("mismatched ternary operator");
-                stack_item_cleanup(&false_val);
-                ctx.errflag = true;
-                break;
-            }
-            continue;
-        }
-        
+    while (ctx->nopstack > 0 && !ctx->errflag) {
         // Skip '?' - it's handled with ':'
-        if (op->op == CH_TERNARY_Q) {
-            arithm_set_error("mismatched ternary operator");
-            ctx.errflag = true;
+        if (ctx->opstack[ctx->nopstack - 1]->op == CH_TERNARY_Q) {
+            pop_opstack(ctx);
+            compile_error(ctx, "mismatched ternary operator");
+            ctx->errflag = true;
             break;
         }
+        reduce_top(ctx);
+    }
 
-        stack_item_t a1 = pop_numstack(&ctx);
-        if (ctx.errflag) {
-            break;
-        }
+    // Should have exactly one result
+    if (!ctx->error && ctx->nnumstack != 1) {
+        compile_error(ctx, "invalid arithmetic expression");
+    }
+}
 
-        if (op->unary) {
-            push_numstackl(&ctx, op->eval(&a1, NULL));
-            stack_item_cleanup(&a1);
-            if (arithm_error_flag) {
-                ctx.errflag = true;
-                break;
+// ============================================================================
+// COMPILED PROGRAMS
+// ============================================================================
+
+arithm_program_t *arithm_compile(const char *orig_expr) {
+    if (!orig_expr) {
+        return NULL;
+    }
+
+    arithm_program_t *program = calloc(1, sizeof(arithm_program_t));
+    if (!program) {
+        return NULL;
+    }
+    program->text = strdup(orig_expr);
+    if (!program->text) {
+        free(program);
+        return NULL;
+    }
+
+    arithm_compiler_t ctx = {0};
+    ctx.program = program;
+
+    // Remove $(( )) wrapper if present
+    if (strncmp(orig_expr, "$((", 3) == 0) {
+        size_t len = strlen(orig_expr);
+        if (len >= 5 && orig_expr[len - 2] == ')' &&
+            orig_expr[len - 1] == ')') {
+            char *cleaned_expr = strndup(orig_expr + 3, len - 5);
+            if (!cleaned_expr) {
+                arithm_program_free(program);
+                return NULL;
             }
+            compile_expression(&ctx, cleaned_expr);
+            free(cleaned_expr);
         } else {
-            stack_item_t a2 = pop_numstack(&ctx);
-            if (ctx.errflag) {
-                stack_item_cleanup(&a1);
-                break;
-            }
-            push_numstackl(&ctx, op->eval(&a2, &a1));
-            stack_item_cleanup(&a1);
-            stack_item_cleanup(&a2);
-            if (arithm_error_flag) {
-                ctx.errflag = true;
-                break;
-            }
+            compile_error(&ctx,
+                          "malformed arithmetic expression: missing closing ))");
         }
-        if (ctx.errflag) {
-            break;
+    } else {
+        compile_expression(&ctx, orig_expr);
+    }
+
+    if (ctx.error && !ctx.oom) {
+        emit(&ctx, (arithm_insn_t){.opcode = AOP_ERROR, .message = ctx.error});
+    }
+    if (ctx.oom) {
+        arithm_program_free(program);
+        return NULL;
+    }
+    return program;
+}
+
+void arithm_program_free(arithm_program_t *program) {
+    if (!program) {
+        return;
+    }
+    for (size_t i = 0; i < program->count; i++) {
+        arithm_opcode_t opcode = program->code[i].opcode;
+        if (opcode == AOP_PUSH_VAR || opcode == AOP_PUSH_VAR_REF) {
+            free(program->code[i].var_name);
         }
     }
+    free(program->code);
+    free(program->text);
+    free(program);
+}
 
-    // Clean up
-    if (cleaned_expr) {
-        free(cleaned_expr);
+/**
+ * @brief Create a variable in the global scope with value "0" if unset
+ *
+ * Preserves the long-standing behavior that naming a variable in an
+ * arithmetic expression defines it.
+ *
+ * @param name Variable name
+ */
+static void define_default_var(const char *name) {
+    symtable_manager_t *manager = symtable_get_global_manager();
+    if (manager && !symtable_var_exists(manager, name)) {
+        symtable_set_var(manager, name, "0", SYMVAR_NONE);
     }
+}
 
-    // Check for errors
-    if (ctx.errflag || arithm_error_flag) {
-        arithm_context_cleanup(&ctx);
+char *arithm_program_eval(executor_t *executor,
+                          const arithm_program_t *program) {
+    arithm_clear_error();
+    if (!program) {
+        arithm_set_error("invalid arithmetic expression");
         return NULL;
     }
 
-    // Should have exactly one result
-    if (ctx.nnumstack != 1) {
+    // The compiler guarantees the stack stays within bounds and that every
+    // operator finds its operands
+    stack_item_t stack[MAXNUMSTACK];
+    int depth = 0;
+
+    for (size_t i = 0; i < program->count; i++) {
+        const arithm_insn_t *insn = &program->code[i];
+        stack_item_t *top = stack + depth - 1; // Valid for operators only
+
+        switch (insn->opcode) {
+        case AOP_PUSH_NUM:
+            stack[depth].type = ITEM_LONG_INT;
+            stack[depth].val = insn->num;
+            stack[depth].executor_context = executor;
+            depth++;
+            break;
+        case AOP_PUSH_VAR:
+            define_default_var(insn->var_name);
+            stack[depth].type = ITEM_VAR_PTR;
+            stack[depth].var_name = insn->var_name;
+            stack[depth].executor_context = executor;
+            depth++;
+            break;
+        case AOP_PUSH_VAR_REF:
+            stack[depth].type = ITEM_VAR_PTR;
+            stack[depth].var_name = insn->var_name;
+            stack[depth].executor_context = executor;
+            depth++;
+            break;
+        case AOP_UNARY:
+            top->val = insn->op->eval(top, NULL);
+            top->type = ITEM_LONG_INT;
+            break;
+        case AOP_BINARY:
+            top[-1].val = insn->op->eval(&top[-1], top);
+            top[-1].type = ITEM_LONG_INT;
+            depth--;
+            break;
+        case AOP_TERNARY:
+            top[-2].val = long_value(&top[-2]) ? long_value(&top[-1])
+                                               : long_value(top);
+            top[-2].type = ITEM_LONG_INT;
+            depth -= 2;
+            break;
+        case AOP_ERROR:
+            arithm_set_error(insn->message);
+            return NULL;
+        }
+
+        if (arithm_error_flag) {
+            return NULL;
+        }
+    }
+
+    if (depth != 1) {
         arithm_set_error("invalid arithmetic expression");
-        arithm_context_cleanup(&ctx);
         return NULL;
     }
 
     // Format result
-    ssize_t result = long_value(&ctx.numstack[0]);
+    ssize_t result = long_value(&stack[0]);
     char *result_str = malloc(32);
     if (!result_str) {
         arithm_set_error("memory allocation failed");
-        arithm_context_cleanup(&ctx);
         return NULL;
     }
 
     snprintf(result_str, 32, "%ld", result);
-    arithm_context_cleanup(&ctx);
     return result_str;
 }
+
+// ============================================================================
+// PROGRAM CACHE
+// ============================================================================
+
+/** Compiled programs, keyed by expression text */
+static ht_t *program_cache = NULL;
+
+static arithm_cache_stats_t cache_stats;
+
+/** Evaluations in progress; the cache is not modified while nonzero */
+static int eval_depth = 0;
+
+/**
+ * @brief Free a cached program (value free callback)
+ */
+static void cached_program_free(const void *val) {
+    arithm_program_free((arithm_program_t *)val);
+}
+
+/**
+ * @brief Drop every cached program
+ */
+static void program_cache_flush(void) {
+    if (program_cache) {
+        ht_destroy(program_cache);
+        program_cache = NULL;
+    }
+    cache_stats.entries = 0;
+}
+
+/**
+ * @brief Get the compiled program for an expression
+ *
+ * Returns the cached program when there is one. Otherwise compiles the
+ * text and caches it; the cache is flushed when it reaches
+ * ARITHM_CACHE_MAX entries. A program compiled while another evaluation
+ * is running is not cached, so a running program is never freed.
+ *
+ * @param expr Expression text
+ * @param temporary Output: true if the caller must free the program
+ * @return Compiled program, or NULL on allocation failure
+ */
+static arithm_program_t *get_program(const char *expr, bool *temporary) {
+    *temporary = false;
+
+    if (program_cache) {
+        arithm_program_t *program = ht_get(program_cache, expr);
+        if (program) {
+            cache_stats.hits++;
+            return program;
+        }
+    }
+
+    cache_stats.misses++;
+    arithm_program_t *program = arithm_compile(expr);
+    if (!program || eval_depth > 0) {
+        *temporary = true;
+        return program;
+    }
+
+    if (cache_stats.entries >= ARITHM_CACHE_MAX) {
+        program_cache_flush();
+        cache_stats.flushes++;
+    }
+    if (!program_cache) {
+        ht_callbacks_t callbacks = {NULL, NULL, NULL, cached_program_free};
+        program_cache = ht_create(fnv1a_hash_str, str_eq, &callbacks,
+                                  HT_STR_NONE | HT_SEED_RANDOM);
+    }
+    if (!program_cache) {
+        *temporary = true;
+        return program;
+    }
+
+    ht_insert(program_cache, program->text, program);
+    cache_stats.entries++;
+    return program;
+}
+
+void arithm_get_cache_stats(arithm_cache_stats_t *stats) {
+    if (stats) {
+        *stats = cache_stats;
+    }
+}
+
+// Error handling functions
+void arithm_init(void) { arithm_clear_error(); }
+
+void arithm_cleanup(void) {
+    arithm_clear_error();
+    if (eval_depth == 0) {
+        program_cache_flush();
+    }
+}
+
+const char *arithm_get_last_error(void) { return arithm_error_message; }
+
+void arithm_set_error(const char *message) {
+    arithm_clear_error();
+    arithm_error_flag = true;
+    if (message) {
+        arithm_error_message = strdup(message);
+    }
+}
+
+void arithm_clear_error(void) {
+    arithm_error_flag = false;
+    if (arithm_error_message) {
+        free(arithm_error_message);
+        arithm_error_message = NULL;
+    }
+}
+
+// Main arithmetic expansion function
+// Forward declaration for the executor-aware version
+static char *arithm_expand_internal(executor_t *executor,
+                                    const char *orig_expr);
+
+char *arithm_expand(const char *orig_expr) {
+    return arithm_expand_internal(NULL, orig_expr);
+}
+
+char *arithm_expand_with_executor(executor_t *executor, const char *orig_expr) {
+    return arithm_expand_internal(executor, orig_expr);
+}
+
+static char *arithm_expand_internal(executor_t *executor,
+                                    const char *orig_expr) {
+    if (!orig_expr) {
+        return strdup("0");
+    }
+
+    arithm_clear_error();
+
+    bool temporary;
+    arithm_program_t *program = get_program(orig_expr, &temporary);
+    if (!program) {
+        arithm_set_error("memory allocation failed");
+        return NULL;
+    }
+
+    eval_depth++;
+    char *result = arithm_program_eval(executor, program);
+    eval_depth--;
+
+    if (temporary) {
+        arithm_program_free(program);
+    }
+    return result;
+}
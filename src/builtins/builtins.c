@@ -14,6 +14,7 @@
 
 #include "alias.h"
 #include "arithmetic.h"
+#include "command_hash.h"
 #include "compat.h"
 #include "dirstack.h"
 #include "config.h"
@@ -93,9 +94,6 @@ bool is_posix_mode_enabled(void);
 #include <sys/wait.h>
 #include <unistd.h>
 
-// Hash table for remembered command paths
-ht_strstr_t *command_hash = NULL;
-
 /**
  * @brief Report a structured builtin error
  *
@@ -1518,7 +1516,7 @@ int bin_export(int argc, char **argv) {
  *
  * @param argc Argument count
  * @param argv Argument vector (argv[1] is the filename)
- * @return 0 on success, 1 on error, or last command's exit status
+ * @return 1 on error, otherwise the status of the last command executed
  */
 int bin_source(int argc, char **argv) {
     if (argc < 2) {
@@ -1526,16 +1524,25 @@ int bin_source(int argc, char **argv) {
         return 1;
     }
 
-    FILE *file = fopen(argv[1], "r");
-    if (!file) {
-        error_message("source: cannot open '%s'", argv[1]);
-        return 1;
+    // Parse the whole file up front when possible; otherwise read it
+    // construct by construct below
+    script_ast_t *script = executor_load_script(argv[1], true);
+    FILE *file = NULL;
+    if (!script) {
+        file = fopen(argv[1], "r");
+        if (!file) {
+            error_message("source: cannot open '%s'", argv[1]);
+            return 1;
+        }
     }
 
     // Get global executor for script context tracking
     executor_t *executor = get_global_executor();
     if (!executor) {
-        fclose(file);
+        script_ast_release(script);
+        if (file) {
+            fclose(file);
+        }
         error_message("source: no execution context available");
         return 1;
     }
@@ -1553,8 +1560,21 @@ int bin_source(int argc, char **argv) {
     int result = 0;
     int construct_number = 1;
 
+    if (script) {
+        off_t resume;
+        result = executor_execute_script(executor, script, &resume);
+        script_ast_release(script);
+
+        // The shell mode changed; read the rest construct by construct
+        if (resume >= 0 && (file = fopen(argv[1], "r")) != NULL &&
+            fseek(file, resume, SEEK_SET) != 0) {
+            fclose(file);
+            file = NULL;
+        }
+    }
+
     // Read complete multi-line constructs instead of line by line
-    while ((complete_input = get_input_complete(file)) != NULL) {
+    while (file && (complete_input = get_input_complete(file)) != NULL) {
         // Check if return was called in sourced script
         if (executor->source_return) {
             free(complete_input);
@@ -1577,6 +1597,13 @@ int bin_source(int argc, char **argv) {
         // Parse and execute the complete construct
         int construct_result = parse_and_execute(complete_input);
         
+        // exit in the sourced file ends it with its own status
+        if (exit_flag) {
+            result = last_exit_status;
+            free(complete_input);
+            break;
+        }
+        
         // Check for return from sourced script (exit code 200+)
         if (construct_result >= 200 && construct_result <= 455) {
             result = construct_result - 200;
@@ -1585,9 +1612,7 @@ int bin_source(int argc, char **argv) {
             break;
         }
         
-        if (construct_result != 0) {
-            result = construct_result;
-        }
+        result = construct_result;
 
         free(complete_input);
         construct_number++;
@@ -1600,7 +1625,9 @@ int bin_source(int argc, char **argv) {
     // Clear script execution context
     executor_clear_script_context(executor);
 
-    fclose(file);
+    if (file) {
+        fclose(file);
+    }
     return result;
 }
 
@@ -4992,36 +5019,12 @@ int bin_shopt(int argc, char **argv)
     return result;
 }
 
-/**
- * @brief Initialize the command hash table
- *
- * Creates the hash table used by the hash builtin for remembering
- * utility locations in PATH.
- */
-void init_command_hash(void) {
-    if (command_hash == NULL) {
-        command_hash = ht_strstr_create(HT_STR_CASECMP | HT_SEED_RANDOM);
-    }
-}
-
-/**
- * @brief Free the command hash table
- *
- * Destroys the hash table used for remembering utility locations.
- */
-void free_command_hash(void) {
-    if (command_hash != NULL) {
-        ht_strstr_destroy(command_hash);
-        command_hash = NULL;
-    }
-}
-
 /**
  * @brief Search for a command in PATH
  *
- * Searches each directory in PATH for an executable matching
- * the command name. If command contains a slash, checks if
- * it exists as-is.
+ * Searches each directory in the shell's PATH for an executable matching
+ * the command name. If command contains a slash, checks if it exists
+ * as-is. The search is not cached.
  *
  * @param command The command name to find
  * @return Newly allocated full path string (caller must free),
@@ -5040,44 +5043,7 @@ char *find_command_in_path(const char *command) {
         return NULL;
     }
 
-    // Search in PATH
-    const char *path_env = getenv("PATH");
-    if (!path_env) {
-        return NULL;
-    }
-
-    char *path_copy = strdup(path_env);
-    if (!path_copy) {
-        return NULL;
-    }
-
-    char *path_dir = strtok(path_copy, ":");
-    char *result = NULL;
-
-    while (path_dir) {
-        // Construct full path
-        size_t dir_len = strlen(path_dir);
-        size_t cmd_len = strlen(command);
-        char *full_path = malloc(dir_len + cmd_len + 2); // +2 for '/' and '\0'
-
-        if (full_path) {
-            snprintf(full_path, dir_len + cmd_len + 2, "%s/%s", path_dir,
-                     command);
-
-            // Check if file exists and is executable
-            if (access(full_path, X_OK) == 0) {
-                result = full_path;
-                break;
-            }
-
-            free(full_path);
-        }
-
-        path_dir = strtok(NULL, ":");
-    }
-
-    free(path_copy);
-    return result;
+    return command_path_search(command, command_search_path());
 }
 
 /**
@@ -5087,6 +5053,7 @@ char *find_command_in_path(const char *command) {
  * With utility names, finds and remembers their PATH locations.
  * With -r, forgets all remembered locations.
  * With -t name, prints the remembered pathname of name.
+ * With -s, prints lookup statistics.
  *
  * @param argc Argument count
  * @param argv Argument vector with options and utility names
@@ -5097,10 +5064,24 @@ int bin_hash(int argc, char **argv) {
 
     // Handle -r option (forget all remembered locations)
     if (argc == 2 && strcmp(argv[1], "-r") == 0) {
-        if (command_hash) {
-            ht_strstr_destroy(command_hash);
-            command_hash = ht_strstr_create(HT_STR_CASECMP | HT_SEED_RANDOM);
-        }
+        command_hash_clear();
+        return 0;
+    }
+
+    // Handle -s option (lookup statistics)
+    if (argc == 2 && strcmp(argv[1], "-s") == 0) {
+        command_hash_stats_t stats;
+        command_hash_get_stats(&stats);
+        unsigned long lookups = stats.hits + stats.misses;
+        printf("Command hash statistics:\n");
+        printf("  Remembered commands: %lu\n", stats.entries);
+        printf("  Hits: %lu\n", stats.hits);
+        printf("  Misses: %lu\n", stats.misses);
+        if (lookups > 0) {
+            printf("  Hit rate: %.1f%%\n", 100.0 * stats.hits / lookups);
+        }
+        printf("  Invalidations: %lu\n", stats.invalidations);
+        printf("  PATH generation: %lu\n", stats.path_generation);
         return 0;
     }
 
@@ -5113,7 +5094,7 @@ int bin_hash(int argc, char **argv) {
         int ret = 0;
         for (int i = 2; i < argc; i++) {
             const char *utility = argv[i];
-            const char *path = command_hash ? ht_strstr_get(command_hash, utility) : NULL;
+            const char *path = command_hash_get(utility);
             if (path) {
                 printf("%s\n", path);
             } else {
@@ -5132,20 +5113,7 @@ int bin_hash(int argc, char **argv) {
 
     // No arguments - display all remembered locations
     if (argc == 1) {
-        if (!command_hash) {
-            return 0;
-        }
-
-        ht_enum_t *enumerator = ht_strstr_enum_create(command_hash);
-        if (enumerator) {
-            const char *key, *value;
-            while (ht_strstr_enum_next(enumerator, &key, &value)) {
-                if (key && value) {
-                    printf("%s\t%s\n", key, value);
-                }
-            }
-            ht_strstr_enum_destroy(enumerator);
-        }
+        command_hash_print(stdout);
         return 0;
     }
 
@@ -5158,13 +5126,8 @@ int bin_hash(int argc, char **argv) {
             continue;
         }
 
-        // Find the utility in PATH
-        char *path = find_command_in_path(utility);
-        if (path) {
-            // Remember this location
-            ht_strstr_insert(command_hash, utility, path);
-            free(path);
-        } else {
+        // Find the utility in PATH and remember its location
+        if (command_hash_remember(utility) != 0) {
             error_message("hash: %s: not found", utility);
             return 1;
         }
@@ -5516,6 +5479,26 @@ int bin_debug(int argc __attribute__((unused)), char **argv) {
         return 0;
     }
 
+    if (strcmp(subcmd, "exec") == 0) {
+        executor_t *executor = current_executor;
+        if (!executor) {
+            fprintf(stderr, "debug: no executor available\n");
+            return 1;
+        }
+
+        if (argc_real > 2 && strcmp(argv[2], "reset") == 0) {
+            executor->spawn_count = 0;
+            executor->fork_count = 0;
+            printf("Exec statistics reset\n");
+            return 0;
+        }
+
+        printf("External command launches:\n");
+        printf("  posix_spawn: %lu\n", executor->spawn_count);
+        printf("  fork:        %lu\n", executor->fork_count);
+        return 0;
+    }
+
     if (strcmp(subcmd, "help") == 0) {
         printf("Debug command usage:\n");
         printf("  debug                    - Show debug status\n");
@@ -5540,6 +5523,8 @@ int bin_debug(int argc __attribute__((unused)), char **argv) {
         printf("  debug analyze <script>   - Analyze script for issues\n");
         printf("  debug functions          - List all defined functions\n");
         printf("  debug function <name>    - Show function definition\n");
+        printf("  debug exec [reset]       - Show external command launch "
+               "paths\n");
         printf("  debug help               - Show this help\n");
         printf("\nDebug levels:\n");
         printf("  0 - None (disabled)\n");
@@ -5701,6 +5686,13 @@ int bin_display(int argc, char **argv) {
                    stats.avg_layered_display_time_ns / 1000000.0);
             printf("  Cache hit rate: %.1f%%\n", stats.cache_hit_rate * 100.0);
             printf("  Memory usage: %zu bytes\n", stats.memory_usage_bytes);
+            if (stats.output_frames > 0) {
+                printf("  Output frames: %llu (avg %.0f bytes, %.2f writes "
+                       "per frame)\n",
+                       (unsigned long long)stats.output_frames,
+                       (double)stats.output_bytes / stats.output_frames,
+                       (double)stats.output_syscalls / stats.output_frames);
+            }
 
             printf("\nHealth:\n");
             printf("  Performance within threshold: %s\n",
@@ -7414,21 +7406,10 @@ int bin_command(int argc, char **argv) {
 
     if (opt_p) {
         /* Use default POSIX PATH */
-        const char *saved_path = getenv("PATH");
-        char *saved_path_copy = saved_path ? strdup(saved_path) : NULL;
-
-        /* Set default POSIX PATH */
-        setenv("PATH", "/usr/bin:/bin:/usr/sbin:/sbin", 1);
-
-        cmd_path = find_command_in_path(cmd_name);
-
-        /* Restore original PATH */
-        if (saved_path_copy) {
-            setenv("PATH", saved_path_copy, 1);
-            free(saved_path_copy);
-        } else {
-            unsetenv("PATH");
-        }
+        cmd_path = strchr(cmd_name, '/')
+                       ? find_command_in_path(cmd_name)
+                       : command_path_search(cmd_name,
+                                             "/usr/bin:/bin:/usr/sbin:/sbin");
     } else {
         /* If command contains a slash, use it directly */
         if (strchr(cmd_name, '/')) {
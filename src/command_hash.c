@@ -0,0 +1,460 @@
+/**
+ * @file command_hash.c
+ * @brief Remembered command locations used for exec resolution
+ *
+ * The table is tied to one PATH value. A snapshot of PATH and of every
+ * PATH directory's mtime is kept alongside it; when PATH no longer matches
+ * the snapshot (any assignment, local or exported) a new PATH generation
+ * starts and every remembered location is forgotten. Directory mtimes are
+ * compared at most once per COMMAND_HASH_RECHECK_MS so a command installed
+ * earlier in PATH shadows a remembered one, and a remembered path is
+ * checked with access() before reuse so a removed binary is searched again.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "command_hash.h"
+
+#include "ht.h"
+#include "lush.h"
+#include "symtable.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/** Minimum interval between PATH directory mtime checks */
+#define COMMAND_HASH_RECHECK_MS 1000
+
+/**
+ * @brief A remembered command location
+ */
+typedef struct command_hash_entry {
+    char *name; // Command name (also the table key)
+    char *path; // Absolute path of the command
+} command_hash_entry_t;
+
+/**
+ * @brief Snapshot of one PATH directory
+ */
+typedef struct path_dir {
+    char *dir;             // Directory path
+    size_t len;            // Length of dir
+    bool exists;           // Whether stat() succeeded
+    struct timespec mtime; // Modification time when snapshotted
+} path_dir_t;
+
+/** Remembered locations, keyed by command name */
+static ht_t *command_table = NULL;
+
+/** PATH value the table and directory snapshot belong to */
+static char *hashed_path = NULL;
+
+/** Directories of hashed_path, in search order */
+static path_dir_t *path_dirs = NULL;
+static size_t path_dir_count = 0;
+
+/** When directory mtimes were last compared */
+static struct timespec dirs_checked_at;
+
+static command_hash_stats_t stats;
+
+/**
+ * @brief Free a table entry (value free callback)
+ */
+static void command_hash_entry_free(const void *val) {
+    command_hash_entry_t *entry = (command_hash_entry_t *)val;
+    if (entry) {
+        free(entry->path);
+        free(entry->name);
+        free(entry);
+    }
+}
+
+/**
+ * @brief Create an empty table
+ */
+static ht_t *command_table_create(void) {
+    ht_callbacks_t callbacks = {NULL, NULL, NULL, command_hash_entry_free};
+    return ht_create(fnv1a_hash_str, str_eq, &callbacks,
+                     HT_STR_NONE | HT_SEED_RANDOM);
+}
+
+const char *command_search_path(void) {
+    symtable_manager_t *manager = symtable_get_global_manager();
+    const char *path = manager ? symtable_get_var_ref(manager, "PATH") : NULL;
+    return path ? path : getenv("PATH");
+}
+
+/**
+ * @brief Milliseconds elapsed from one monotonic timestamp to another
+ */
+static long elapsed_ms(const struct timespec *from, const struct timespec *to) {
+    return (long)(to->tv_sec - from->tv_sec) * 1000 +
+           (to->tv_nsec - from->tv_nsec) / 1000000;
+}
+
+/**
+ * @brief Stat a snapshot directory, recording its mtime
+ */
+static void path_dir_stat(path_dir_t *pd) {
+    struct stat st;
+    pd->exists = stat(pd->dir, &st) == 0;
+    if (pd->exists) {
+        pd->mtime = st.st_mtim;
+    } else {
+        pd->mtime.tv_sec = 0;
+        pd->mtime.tv_nsec = 0;
+    }
+}
+
+/**
+ * @brief Release the directory snapshot
+ */
+static void free_path_dirs(void) {
+    for (size_t i = 0; i < path_dir_count; i++) {
+        free(path_dirs[i].dir);
+    }
+    free(path_dirs);
+    path_dirs = NULL;
+    path_dir_count = 0;
+}
+
+/**
+ * @brief Split a PATH value into the directory snapshot
+ */
+static void build_path_dirs(const char *search_path) {
+    free_path_dirs();
+    if (!search_path) {
+        return;
+    }
+
+    size_t capacity = 1;
+    for (const char *p = search_path; *p; p++) {
+        if (*p == ':') {
+            capacity++;
+        }
+    }
+
+    path_dirs = calloc(capacity, sizeof(path_dir_t));
+    if (!path_dirs) {
+        return;
+    }
+
+    const char *start = search_path;
+    while (*start) {
+        const char *end = strchr(start, ':');
+        size_t len = end ? (size_t)(end - start) : strlen(start);
+        if (len > 0) {
+            path_dir_t *pd = &path_dirs[path_dir_count];
+            pd->dir = strndup(start, len);
+            if (pd->dir) {
+                pd->len = len;
+                path_dir_stat(pd);
+                path_dir_count++;
+            }
+        }
+        if (!end) {
+            break;
+        }
+        start = end + 1;
+    }
+}
+
+/**
+ * @brief Forget every remembered location
+ */
+static void flush_table(void) {
+    if (command_table) {
+        ht_destroy(command_table);
+    }
+    command_table = command_table_create();
+    stats.entries = 0;
+}
+
+/**
+ * @brief Bring the table in line with the current PATH and directories
+ *
+ * Starts a new PATH generation if PATH changed, and periodically compares
+ * directory mtimes against the snapshot.
+ */
+static void sync_search_path(void) {
+    const char *search_path = command_search_path();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    bool path_changed =
+        (search_path == NULL) != (hashed_path == NULL) ||
+        (search_path && strcmp(search_path, hashed_path) != 0);
+
+    if (path_changed || !command_table) {
+        free(hashed_path);
+        hashed_path = search_path ? strdup(search_path) : NULL;
+        build_path_dirs(search_path);
+        stats.path_generation++;
+        if (command_table && stats.entries > 0) {
+            stats.invalidations++;
+        }
+        flush_table();
+        dirs_checked_at = now;
+        return;
+    }
+
+    if (elapsed_ms(&dirs_checked_at, &now) < COMMAND_HASH_RECHECK_MS) {
+        return;
+    }
+    dirs_checked_at = now;
+
+    bool dirs_changed = false;
+    for (size_t i = 0; i < path_dir_count; i++) {
+        path_dir_t *pd = &path_dirs[i];
+        bool existed = pd->exists;
+        struct timespec old = pd->mtime;
+        path_dir_stat(pd);
+        if (pd->exists != existed || pd->mtime.tv_sec != old.tv_sec ||
+            pd->mtime.tv_nsec != old.tv_nsec) {
+            dirs_changed = true;
+        }
+    }
+
+    if (dirs_changed) {
+        if (stats.entries > 0) {
+            stats.invalidations++;
+        }
+        flush_table();
+    }
+}
+
+/**
+ * @brief Check whether a path names an executable regular file
+ *
+ * access(X_OK) alone also accepts directories, which execvp() skips.
+ *
+ * @param path Path to check
+ * @return true if path is a regular file the shell may execute
+ */
+static bool is_executable_file(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISREG(st.st_mode) &&
+           access(path, X_OK) == 0;
+}
+
+/**
+ * @brief Check one directory for an executable command
+ *
+ * @param dir Directory (not necessarily NUL-terminated)
+ * @param dir_len Length of dir
+ * @param command Command name
+ * @param cmd_len Length of command
+ * @return Newly allocated path, or NULL if not an executable there
+ */
+static char *try_directory(const char *dir, size_t dir_len,
+                           const char *command, size_t cmd_len) {
+    char buf[PATH_MAX];
+    if (dir_len + cmd_len + 2 > sizeof(buf)) {
+        return NULL;
+    }
+
+    memcpy(buf, dir, dir_len);
+    buf[dir_len] = '/';
+    memcpy(buf + dir_len + 1, command, cmd_len + 1);
+
+    if (is_executable_file(buf)) {
+        return strdup(buf);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Search a colon-separated directory list for an executable
+ */
+char *command_path_search(const char *command, const char *search_path) {
+    if (!command || !*command || !search_path) {
+        return NULL;
+    }
+
+    size_t cmd_len = strlen(command);
+    const char *start = search_path;
+    while (*start) {
+        const char *end = strchr(start, ':');
+        size_t len = end ? (size_t)(end - start) : strlen(start);
+        if (len > 0) {
+            char *result = try_directory(start, len, command, cmd_len);
+            if (result) {
+                return result;
+            }
+        }
+        if (!end) {
+            break;
+        }
+        start = end + 1;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Search the directory snapshot for a command
+ */
+static char *search_path_dirs(const char *command) {
+    size_t cmd_len = strlen(command);
+    for (size_t i = 0; i < path_dir_count; i++) {
+        if (!path_dirs[i].exists) {
+            continue;
+        }
+        char *result =
+            try_directory(path_dirs[i].dir, path_dirs[i].len, command, cmd_len);
+        if (result) {
+            return result;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Remember a command location, replacing any previous one
+ */
+static void remember(const char *command, const char *path) {
+    if (!command_table) {
+        return;
+    }
+
+    command_hash_entry_t *entry = ht_get(command_table, command);
+    if (entry) {
+        char *copy = strdup(path);
+        if (copy) {
+            free(entry->path);
+            entry->path = copy;
+        }
+        return;
+    }
+
+    entry = calloc(1, sizeof(command_hash_entry_t));
+    if (!entry) {
+        return;
+    }
+    entry->name = strdup(command);
+    entry->path = strdup(path);
+    if (!entry->name || !entry->path) {
+        command_hash_entry_free(entry);
+        return;
+    }
+    ht_insert(command_table, entry->name, entry);
+    stats.entries++;
+}
+
+void init_command_hash(void) {
+    if (!command_table) {
+        sync_search_path();
+    }
+}
+
+void free_command_hash(void) {
+    if (command_table) {
+        ht_destroy(command_table);
+        command_table = NULL;
+    }
+    free_path_dirs();
+    free(hashed_path);
+    hashed_path = NULL;
+    stats.entries = 0;
+}
+
+char *command_hash_lookup(const char *command) {
+    if (!command || command[0] == '\0') {
+        return NULL;
+    }
+
+    if (strchr(command, '/')) {
+        if (access(command, F_OK) == 0) {
+            return strdup(command);
+        }
+        return NULL;
+    }
+
+    sync_search_path();
+
+    if (shell_opts.hash_commands && command_table) {
+        command_hash_entry_t *entry = ht_get(command_table, command);
+        if (entry && is_executable_file(entry->path)) {
+            stats.hits++;
+            return strdup(entry->path);
+        }
+    }
+
+    stats.misses++;
+    char *path = search_path_dirs(command);
+    if (path && shell_opts.hash_commands) {
+        remember(command, path);
+    }
+    return path;
+}
+
+int command_hash_remember(const char *command) {
+    if (!command || strchr(command, '/')) {
+        return -1;
+    }
+
+    sync_search_path();
+
+    char *path = search_path_dirs(command);
+    if (!path) {
+        return -1;
+    }
+    remember(command, path);
+    free(path);
+    return 0;
+}
+
+const char *command_hash_get(const char *command) {
+    if (!command) {
+        return NULL;
+    }
+
+    sync_search_path();
+
+    command_hash_entry_t *entry =
+        command_table ? ht_get(command_table, command) : NULL;
+    return entry ? entry->path : NULL;
+}
+
+void command_hash_clear(void) {
+    sync_search_path();
+    flush_table();
+}
+
+void command_hash_print(FILE *out) {
+    if (!out) {
+        return;
+    }
+
+    sync_search_path();
+    if (!command_table) {
+        return;
+    }
+
+    ht_enum_t *e = ht_enum_create(command_table);
+    if (!e) {
+        return;
+    }
+
+    const void *key;
+    const void *val;
+    while (ht_enum_next(e, &key, &val)) {
+        const command_hash_entry_t *entry = val;
+        if (entry) {
+            fprintf(out, "%s\t%s\n", entry->name, entry->path);
+        }
+    }
+    ht_enum_destroy(e);
+}
+
+void command_hash_get_stats(command_hash_stats_t *out) {
+    if (out) {
+        *out = stats;
+    }
+}
@@ -240,6 +240,10 @@ static config_option_t config_options[] = {
      config_validate_bool, NULL},
     {"lle.cache_size", CONFIG_TYPE_INT, CONFIG_SECTION_HISTORY,
      &config.lle_cache_size, "History cache size", config_validate_int, NULL},
+    {"lle.lazy_history", CONFIG_TYPE_BOOL, CONFIG_SECTION_HISTORY,
+     &config.lle_lazy_history,
+     "Decode history entries from the file when first used",
+     config_validate_bool, NULL},
     {"lle.readline_compatible_mode", CONFIG_TYPE_BOOL, CONFIG_SECTION_HISTORY,
      &config.lle_readline_compatible_mode, "GNU Readline compatibility mode",
      config_validate_bool, NULL},
@@ -426,6 +430,18 @@ static config_option_t config_options[] = {
     {"scripts.execution", CONFIG_TYPE_BOOL, CONFIG_SECTION_SCRIPTS,
      &config.script_execution, "Enable script execution", config_validate_bool,
      NULL},
+    {"scripts.parse_whole", CONFIG_TYPE_BOOL, CONFIG_SECTION_SCRIPTS,
+     &config.script_parse_whole,
+     "Parse sourced files and scripts in one pass", config_validate_bool,
+     NULL},
+    {"scripts.ast_cache", CONFIG_TYPE_BOOL, CONFIG_SECTION_SCRIPTS,
+     &config.script_ast_cache,
+     "Reuse the parsed commands of unchanged sourced files",
+     config_validate_bool, NULL},
+    {"scripts.parse_cache", CONFIG_TYPE_BOOL, CONFIG_SECTION_SCRIPTS,
+     &config.script_parse_cache,
+     "Keep parsed startup files and sourced libraries on disk",
+     config_validate_bool, NULL},
 
     // Shell options integration - all 24 POSIX options with shell.* namespace
     // These map directly to existing shell_opts flags for perfect compatibility
@@ -1294,16 +1310,21 @@ int config_execute_script_file(const char *path) {
         return -1;
     }
 
-    // Use the same approach as bin_source builtin - read complete multi-line
-    // constructs instead of line by line to handle if/then/fi, while/do/done, etc.
-    FILE *file = fopen(path, "r");
-    if (!file) {
-        return -1;
+    // Track source depth so 'return' builtin works correctly in sourced scripts
+    // Use the global executor since parse_and_execute uses it too
+    executor_t *executor = ensure_global_executor();
+
+    // Like bin_source: run the file parsed whole when possible, otherwise
+    // read complete multi-line constructs to handle if/then/fi, etc.
+    script_ast_t *script = executor ? executor_load_script(path, true) : NULL;
+    FILE *file = NULL;
+    if (!script) {
+        file = fopen(path, "r");
+        if (!file) {
+            return -1;
+        }
     }
 
-    // Track source depth so 'return' builtin works correctly in sourced scripts
-    // Use get_global_executor() since parse_and_execute uses global_executor
-    executor_t *executor = get_global_executor();
     bool saved_source_return = false;
     const char *saved_script_file = NULL;
     if (executor) {
@@ -1322,8 +1343,21 @@ int config_execute_script_file(const char *path) {
     int result = 0;
     int construct_number = 1;
 
+    if (script) {
+        off_t resume;
+        result = executor_execute_script(executor, script, &resume);
+        script_ast_release(script);
+
+        // The shell mode changed; read the rest construct by construct
+        if (resume >= 0 && (file = fopen(path, "r")) != NULL &&
+            fseek(file, resume, SEEK_SET) != 0) {
+            fclose(file);
+            file = NULL;
+        }
+    }
+
     // Read complete multi-line constructs (same as bin_source)
-    while ((complete_input = get_input_complete(file)) != NULL) {
+    while (file && (complete_input = get_input_complete(file)) != NULL) {
         // Skip empty constructs
         char *trimmed = complete_input;
         while (*trimmed == ' ' || *trimmed == '\t' || *trimmed == '\n')
@@ -1342,6 +1376,13 @@ int config_execute_script_file(const char *path) {
         // Parse and execute the complete construct
         int construct_result = parse_and_execute(complete_input);
 
+        // exit in the script ends it with its own status
+        if (exit_flag) {
+            result = last_exit_status;
+            free(complete_input);
+            break;
+        }
+
         // Check for return from sourced script (exit code 200+)
         // This matches how bin_source handles the special return code
         if (construct_result >= 200 && construct_result <= 455) {
@@ -1353,9 +1394,7 @@ int config_execute_script_file(const char *path) {
             break;
         }
 
-        if (construct_result != 0) {
-            result = construct_result;
-        }
+        result = construct_result;
 
         free(complete_input);
         construct_number++;
@@ -1374,7 +1413,9 @@ int config_execute_script_file(const char *path) {
         free((char *)saved_script_file);
     }
 
-    fclose(file);
+    if (file) {
+        fclose(file);
+    }
     return result;
 }
 
@@ -2035,6 +2076,7 @@ void config_set_defaults(void) {
         true; // Use Unicode NFC normalization for comparison
     config.lle_enable_history_cache = true;
     config.lle_cache_size = 100;
+    config.lle_lazy_history = false;
     config.lle_readline_compatible_mode = false;
 
     // Completion defaults
@@ -2117,6 +2159,9 @@ void config_set_defaults(void) {
 
     // Script execution defaults
     config.script_execution = true;
+    config.script_parse_whole = true;
+    config.script_ast_cache = true;
+    config.script_parse_cache = true;
 
     // Shell mode defaults (Phase 0: Extended Language Support)
     config.shell_mode = SHELL_MODE_LUSH;  // Curated best of Bash/Zsh
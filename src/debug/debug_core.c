@@ -621,28 +621,22 @@ void debug_list_functions(debug_context_t *ctx) {
     }
 
     // Access the current executor to get function definitions
-    if (!current_executor || !current_executor->functions) {
+    size_t count = 0;
+    function_def_t **funcs = executor_list_functions(current_executor, &count);
+    if (!funcs) {
         printf("No functions defined.\n");
         return;
     }
 
     printf("Defined functions:\n");
 
-    function_def_t *func = current_executor->functions;
-    int count = 0;
-
-    while (func) {
-        count++;
-        printf("  %d. %s\n", count, func->name);
-        func = func->next;
+    for (size_t i = 0; i < count; i++) {
+        printf("  %zu. %s\n", i + 1, funcs[i]->name);
     }
+    free(funcs);
 
-    if (count == 0) {
-        printf("  (none)\n");
-    } else {
-        printf("\nTotal: %d function%s\n", count, count == 1 ? "" : "s");
-        printf("Use 'debug function <name>' to see function details.\n");
-    }
+    printf("\nTotal: %zu function%s\n", count, count == 1 ? "" : "s");
+    printf("Use 'debug function <name>' to see function details.\n");
 }
 
 /**
@@ -661,14 +655,9 @@ void debug_show_function(debug_context_t *ctx, const char *function_name) {
         return;
     }
 
-    // Find the function in the executor's function list
-    function_def_t *func = current_executor->functions;
-    while (func) {
-        if (strcmp(func->name, function_name) == 0) {
-            break;
-        }
-        func = func->next;
-    }
+    // Find the function in the executor's function table
+    function_def_t *func =
+        executor_find_function(current_executor, function_name);
 
     if (!func) {
         printf("Function '%s' not found.\n", function_name);
@@ -430,22 +430,7 @@ static void debug_var_enum_callback(const char *key, const char *value,
     }
 
     data->found_any = true;
-
-    // Parse the serialized value to extract just the actual value
-    // Format: value|type|flags|scope_level
-    char *clean_value = strdup(value);
-    if (clean_value) {
-        char *separator = strstr(clean_value, "|");
-        if (separator) {
-            *separator =
-                '\0'; // Terminate at first separator to get clean value
-        }
-
-        debug_printf(data->ctx, "  %-12s = '%s'\n", key, clean_value);
-        free(clean_value);
-    } else {
-        debug_printf(data->ctx, "  %-12s = '%s'\n", key, value);
-    }
+    debug_printf(data->ctx, "  %-12s = '%s'\n", key, value);
 }
 
 /**
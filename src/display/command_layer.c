@@ -577,7 +577,8 @@ perform_syntax_highlighting(command_layer_t *layer) {
     if (layer->spec_highlighter) {
         size_t command_len = strlen(layer->command_text);
 
-        // Tokenize using spec highlighter
+        // Tokenize using spec highlighter; it keeps its tokens and output
+        // from the previous call and only re-lexes the edited range
         int token_count = lle_syntax_highlight(
             layer->spec_highlighter, layer->command_text, command_len);
 
@@ -591,7 +592,8 @@ perform_syntax_highlighting(command_layer_t *layer) {
             if (rendered >= 0) {
                 uint64_t highlighting_time = get_current_time_ns() - start_time;
                 g_highlighting_stats.highlighting_time_ns += highlighting_time;
-                g_highlighting_stats.tokens_parsed += (uint64_t)token_count;
+                g_highlighting_stats.tokens_parsed +=
+                    (uint64_t)layer->spec_highlighter->tokens_relexed;
                 return COMMAND_LAYER_SUCCESS;
             }
         }
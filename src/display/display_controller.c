@@ -151,9 +151,20 @@ static bool screen_buffer_initialized = false;
 static bool prompt_rendered = false;
 static int last_terminal_end_row =
     0; /* Actual terminal row after ghost text/menu */
+/* Frame used for redraws when no controller is available */
+static output_frame_t fallback_frame = {.fd = STDOUT_FILENO};
 /* Note: Notification is now tracked in screen_buffer like menu, so no separate
  * tracking variable needed */
 
+/**
+ * @brief Get the output frame redraws are composed in
+ * @param controller Display controller (may be NULL)
+ * @return The controller's frame, or a fallback frame on stdout
+ */
+static output_frame_t *dc_output_frame(display_controller_t *controller) {
+    return controller ? &controller->output_frame : &fallback_frame;
+}
+
 /**
  * @brief Reset display state - called when starting new input session
  *
@@ -222,64 +233,55 @@ bool dc_apply_transient_prompt(const char *transient_prompt,
      */
 
     int total_rows = current_screen.cursor_row + 1;
-    char seq_buf[32];
-    int seq_len;
+    display_controller_t *dc = display_integration_get_controller();
+
+    /* Highlight the command first: updating the command layer may trigger
+     * a redraw, which must not interleave with this frame */
+    char highlighted_buffer[COMMAND_LAYER_MAX_HIGHLIGHTED_SIZE];
+    highlighted_buffer[0] = '\0';
+    if (command_text && command_text[0] != '\0' && dc && dc->compositor &&
+        dc->compositor->command_layer) {
+        command_layer_t *cmd_layer = dc->compositor->command_layer;
+
+        /* Temporarily set the command text for highlighting */
+        command_layer_error_t set_result = command_layer_set_command(
+            cmd_layer, command_text, strlen(command_text));
+
+        if (set_result == COMMAND_LAYER_SUCCESS &&
+            command_layer_get_highlighted_text(
+                cmd_layer, highlighted_buffer, sizeof(highlighted_buffer)) !=
+                COMMAND_LAYER_SUCCESS) {
+            highlighted_buffer[0] = '\0';
+        }
+    }
+
+    output_frame_t *frame = dc_output_frame(dc);
+    output_frame_begin(frame);
 
     /* Step 1: Move cursor up to the first row (where prompt started) */
     if (current_screen.cursor_row > 0) {
-        seq_len = snprintf(seq_buf, sizeof(seq_buf), "\033[%dA",
-                           current_screen.cursor_row);
-        if (seq_len > 0) {
-            write(STDOUT_FILENO, seq_buf, (size_t)seq_len);
-        }
+        output_frame_appendf(frame, "\033[%dA", current_screen.cursor_row);
     }
 
     /* Step 2: Move to column 1 */
-    write(STDOUT_FILENO, "\033[1G", 4);
+    output_frame_append_str(frame, "\033[1G");
 
     /* Step 3: Clear from cursor to end of screen */
-    write(STDOUT_FILENO, "\033[J", 3);
+    output_frame_append_str(frame, "\033[J");
 
     /* Step 4: Write transient prompt */
-    if (transient_prompt[0] != '\0') {
-        write(STDOUT_FILENO, transient_prompt, strlen(transient_prompt));
-    }
+    output_frame_append_str(frame, transient_prompt);
 
-    /* Step 5: Write command text (with syntax highlighting if available) */
+    /* Step 5: Write command text (with syntax highlighting if available,
+     * falling back to plain text) */
     if (command_text && command_text[0] != '\0') {
-        bool wrote_highlighted = false;
-
-        /* Try to get syntax-highlighted version from display controller */
-        display_controller_t *dc = display_integration_get_controller();
-        if (dc && dc->compositor && dc->compositor->command_layer) {
-            command_layer_t *cmd_layer = dc->compositor->command_layer;
-
-            /* Temporarily set the command text for highlighting */
-            command_layer_error_t set_result = command_layer_set_command(
-                cmd_layer, command_text, strlen(command_text));
-
-            if (set_result == COMMAND_LAYER_SUCCESS) {
-                char highlighted_buffer[COMMAND_LAYER_MAX_HIGHLIGHTED_SIZE];
-                command_layer_error_t highlight_result =
-                    command_layer_get_highlighted_text(
-                        cmd_layer, highlighted_buffer,
-                        sizeof(highlighted_buffer));
-
-                if (highlight_result == COMMAND_LAYER_SUCCESS &&
-                    highlighted_buffer[0] != '\0') {
-                    write(STDOUT_FILENO, highlighted_buffer,
-                          strlen(highlighted_buffer));
-                    wrote_highlighted = true;
-                }
-            }
-        }
-
-        /* Fallback to plain text if highlighting failed */
-        if (!wrote_highlighted) {
-            write(STDOUT_FILENO, command_text, strlen(command_text));
-        }
+        output_frame_append_str(frame, highlighted_buffer[0]
+                                           ? highlighted_buffer
+                                           : command_text);
     }
 
+    output_frame_flush(frame);
+
     /* Step 6: Update screen buffer to reflect new state
      * Re-render with transient prompt so current_screen is accurate */
     size_t cursor_offset = command_text ? strlen(command_text) : 0;
@@ -381,170 +383,29 @@ static const char *dc_continuation_prompt_callback(const char *line_text,
 }
 
 /**
- * @brief Handle redraw needed event from command layer
- * @param event Layer event that triggered this callback
- * @param user_data User data (display_controller_t pointer)
- * @return LAYER_EVENTS_SUCCESS on success, error code otherwise
+ * @brief Compose a full redraw of the command area into the frame
+ *
+ * Writes the prompt on the first render of a line, then clears from the
+ * command start to the end of the screen and writes the command, ghost
+ * text, menu and notification before moving the cursor into place. Used
+ * for the first frame and whenever the screens cannot be diffed.
+ *
+ * @param frame Frame to compose into
+ * @param prompt_buffer Rendered prompt
+ * @param command_buffer Highlighted command text
+ * @param is_multiline True if the command contains newlines
+ * @param suggestion Autosuggestion to show, or NULL
+ * @param menu_text Rendered completion menu, or NULL
+ * @param notification_text Styled notification, or NULL
+ * @param term_width Terminal width in columns
  */
-static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
-                                                    void *user_data) {
-
-    (void)event;
-    display_controller_t *controller = (display_controller_t *)user_data;
-
-    if (!controller || !controller->is_initialized) {
-        return LAYER_EVENTS_ERROR_INVALID_PARAM;
-    }
-
-    command_layer_t *cmd_layer = controller->compositor->command_layer;
-    if (!cmd_layer) {
-        return LAYER_EVENTS_ERROR_INVALID_PARAM;
-    }
-
-    int term_width = 80;
-    if (controller->terminal_ctrl &&
-        controller->terminal_ctrl->capabilities.terminal_width > 0) {
-        term_width = controller->terminal_ctrl->capabilities.terminal_width;
-    }
-
-    if (!screen_buffer_initialized) {
-        screen_buffer_init(&current_screen, term_width);
-        screen_buffer_init(&desired_screen, term_width);
-        screen_buffer_initialized = true;
-    } else {
-        current_screen.terminal_width = term_width;
-        desired_screen.terminal_width = term_width;
-    }
-
-    prompt_layer_t *prompt_layer = controller->compositor->prompt_layer;
-    char prompt_buffer[PROMPT_LAYER_MAX_CONTENT_SIZE] = {0};
-    if (prompt_layer) {
-        prompt_layer_get_rendered_content(prompt_layer, prompt_buffer,
-                                          sizeof(prompt_buffer));
-    }
-
-    char command_buffer[COMMAND_LAYER_MAX_HIGHLIGHTED_SIZE];
-    command_layer_error_t cmd_result = command_layer_get_highlighted_text(
-        cmd_layer, command_buffer, sizeof(command_buffer));
-
-    if (cmd_result != COMMAND_LAYER_SUCCESS) {
-        return LAYER_EVENTS_ERROR_INVALID_PARAM;
-    }
-
-    /* Render completion menu if active (Proper Architecture - Spec 12)
-     * Menu is now composed at display time, not baked into command text */
-    char menu_buffer[8192] = {0};
-    char *menu_text = NULL;
-
-    if (controller->completion_menu_visible &&
-        controller->active_completion_menu) {
-        lle_menu_render_options_t options =
-            lle_menu_renderer_default_options(term_width);
-        options.max_rows = 20; /* Limit menu to 20 rows */
-
-        lle_menu_render_stats_t stats;
-        lle_result_t result = lle_completion_menu_render(
-            controller->active_completion_menu, &options, menu_buffer,
-            sizeof(menu_buffer), &stats);
-
-        if (result == LLE_SUCCESS && menu_buffer[0]) {
-            menu_text = menu_buffer;
-        }
-    }
-
-    /* CONTINUATION PROMPT SUPPORT:
-     *
-     * Use screen_buffer_render_with_continuation() which calls back on each
-     * newline to get the context-aware continuation prompt. This is the
-     * architecturally correct approach: prompts are set at the exact visual row
-     * where each newline lands during character-by-character rendering, not
-     * pre-calculated.
-     *
-     * The callback receives the plain text of each line (ANSI stripped) and
-     * updates the continuation state to determine the appropriate prompt.
-     */
-    int newline_count = count_newlines(command_buffer);
-    bool is_multiline = (newline_count > 0);
-
-    size_t cursor_byte_offset = cmd_layer->cursor_position;
-
-    if (is_multiline) {
-        /* Use callback-based rendering for proper visual row tracking */
-        continuation_state_t cont_state;
-        continuation_state_init(&cont_state);
-
-        screen_buffer_render_with_continuation(
-            &desired_screen, prompt_buffer, command_buffer, cursor_byte_offset,
-            dc_continuation_prompt_callback, &cont_state);
-
-        continuation_state_cleanup(&cont_state);
-    } else {
-        /* No newlines - use simple render */
-        screen_buffer_render(&desired_screen, prompt_buffer, command_buffer,
-                             cursor_byte_offset);
-    }
-
-    /* DEBUG: Log what screen_buffer_render produced */
-    DC_DEBUG("After render: num_rows=%d, command_start_row=%d, cursor=(%d,%d), "
-             "term_width=%d",
-             desired_screen.num_rows, desired_screen.command_start_row,
-             desired_screen.cursor_row, desired_screen.cursor_col, term_width);
-
-    /* DEBUG: Log prefixes set on each row */
-    for (int r = 0; r < desired_screen.num_rows && r < 10; r++) {
-        const char *prefix = screen_buffer_get_line_prefix(&desired_screen, r);
-        if (prefix) {
-            DC_DEBUG("  Row %d has prefix: '%s'", r, prefix);
-        }
-    }
-
-    /* Add menu rows to screen_buffer per SCREEN_BUFFER_MENU_INTEGRATION_PLAN.md
-     *
-     * This is the key fix: by adding menu rows to screen_buffer AFTER rendering
-     * command text, the buffer knows the total display height. This allows
-     * screen_buffer_get_rows_below_cursor() to return the correct value for
-     * cursor positioning, fixing the "upward row consumption" bug.
-     *
-     * Cursor position (cursor_row, cursor_col) stays in the command area -
-     * menu rows are added AFTER and don't affect cursor tracking.
-     */
-    int menu_rows_added = 0;
-    if (menu_text && *menu_text) {
-        /* Add menu starting at row after command ends.
-         * Note: We add a newline before menu, so start at num_rows (which is
-         * one past the last command row). */
-        int menu_start_row = desired_screen.num_rows;
-        menu_rows_added = screen_buffer_add_text_rows(
-            &desired_screen, menu_start_row, menu_text);
-
-        DC_DEBUG("Added menu to screen_buffer: start_row=%d, rows_added=%d, "
-                 "new_num_rows=%d",
-                 menu_start_row, menu_rows_added, desired_screen.num_rows);
-    }
-
-    /* Get notification text if visible and add to screen_buffer for proper tracking
-     * Following the same pattern as menu to ensure correct cursor positioning */
-    char notification_buffer[LLE_NOTIFICATION_MAX_STYLED];
-    const char *notification_text = NULL;
-    int notification_rows_added = 0;
-
-    if (controller->notification_visible && controller->notification_copy.visible) {
-        notification_text = lle_notification_get_styled_text(
-            &controller->notification_copy, notification_buffer,
-            sizeof(notification_buffer));
-
-        /* Add notification to screen_buffer like we do for menu */
-        if (notification_text && *notification_text) {
-            int notif_start_row = desired_screen.num_rows;
-            notification_rows_added = screen_buffer_add_text_rows(
-                &desired_screen, notif_start_row, notification_text);
-
-            DC_DEBUG("Added notification to screen_buffer: start_row=%d, rows_added=%d, "
-                     "new_num_rows=%d",
-                     notif_start_row, notification_rows_added, desired_screen.num_rows);
-        }
-    }
-
+static void dc_compose_full_redraw(output_frame_t *frame,
+                                   const char *prompt_buffer,
+                                   const char *command_buffer,
+                                   bool is_multiline, const char *suggestion,
+                                   const char *menu_text,
+                                   const char *notification_text,
+                                   int term_width) {
     /* PROMPT-ONCE ARCHITECTURE per MODERN_EDITOR_WRAPPING_RESEARCH.md
      *
      * This implements the proven approach used by Replxx, Fish, and ZLE:
@@ -558,9 +419,7 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
 
     /* First render only: Draw prompt once */
     if (!prompt_rendered) {
-        if (prompt_buffer[0]) {
-            write(STDOUT_FILENO, prompt_buffer, strlen(prompt_buffer));
-        }
+        output_frame_append_str(frame, prompt_buffer);
         prompt_rendered = true;
     }
 
@@ -571,12 +430,7 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
      * For multi-line prompts, use command_start_col from screen buffer
      * Use \033[{n}G for absolute positioning (1-based indexing) */
     int command_start_col = desired_screen.command_start_col;
-    char move_to_col[32];
-    int col_len = snprintf(move_to_col, sizeof(move_to_col), "\033[%dG",
-                           command_start_col + 1);
-    if (col_len > 0) {
-        write(STDOUT_FILENO, move_to_col, col_len);
-    }
+    output_frame_appendf(frame, "\033[%dG", command_start_col + 1);
 
     /* Step 2: Handle ghost text/menu cleanup from previous render
      *
@@ -594,42 +448,28 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
          * Move DOWN to that row to clear from there. */
         int rows_down = last_terminal_end_row - current_screen.cursor_row;
         DC_DEBUG("Step2: Moving DOWN %d rows to clear ghost text", rows_down);
-        char move_down[32];
-        int down_len =
-            snprintf(move_down, sizeof(move_down), "\033[%dB", rows_down);
-        if (down_len > 0) {
-            write(STDOUT_FILENO, move_down, down_len);
-        }
+        output_frame_appendf(frame, "\033[%dB", rows_down);
 
         /* Clear from here to end of screen (clears ghost text) */
-        write(STDOUT_FILENO, "\033[J", 3);
+        output_frame_append_str(frame, "\033[J");
 
         /* Move back up to command start row */
         int rows_up = last_terminal_end_row - command_row;
         if (rows_up > 0) {
             DC_DEBUG("Step2: Moving UP %d rows to command start", rows_up);
-            char move_up[32];
-            int up_len =
-                snprintf(move_up, sizeof(move_up), "\033[%dA", rows_up);
-            if (up_len > 0) {
-                write(STDOUT_FILENO, move_up, up_len);
-            }
+            output_frame_appendf(frame, "\033[%dA", rows_up);
         }
     } else if (current_screen.cursor_row > command_row) {
         /* No ghost text overflow, but cursor is below command start - move up
          */
         int rows_up = current_screen.cursor_row - command_row;
         DC_DEBUG("Step2: Moving up %d rows", rows_up);
-        char move_up[32];
-        int up_len = snprintf(move_up, sizeof(move_up), "\033[%dA", rows_up);
-        if (up_len > 0) {
-            write(STDOUT_FILENO, move_up, up_len);
-        }
+        output_frame_appendf(frame, "\033[%dA", rows_up);
     }
 
     /* Step 3: Clear from current position to end of screen
      * This clears only the command area, never touches the prompt */
-    write(STDOUT_FILENO, "\033[J", 3);
+    output_frame_append_str(frame, "\033[J");
 
     /* Step 4: Write command text with continuation prompts
      *
@@ -672,15 +512,15 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
                         }
                     }
                     /* Write the ANSI sequence */
-                    write(STDOUT_FILENO, command_buffer + seq_start,
-                          i - seq_start);
+                    output_frame_append(frame, command_buffer + seq_start,
+                                        i - seq_start);
                     continue;
                 }
 
                 /* Handle newlines - move to next visual row and output
                  * continuation prompt */
                 if (ch == '\n') {
-                    write(STDOUT_FILENO, "\n", 1);
+                    output_frame_append(frame, "\n", 1);
                     visual_row++;
 
                     /* Get continuation prompt for this visual row */
@@ -689,8 +529,8 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
                     if (cont_prompt) {
                         /* Reset ANSI state before writing continuation prompt
                          */
-                        write(STDOUT_FILENO, "\033[0m", 4);
-                        write(STDOUT_FILENO, cont_prompt, strlen(cont_prompt));
+                        output_frame_append_str(frame, "\033[0m");
+                        output_frame_append_str(frame, cont_prompt);
                         visual_col =
                             (int)screen_buffer_get_line_prefix_visual_width(
                                 &desired_screen, visual_row);
@@ -712,7 +552,8 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
                     int char_width = lle_utf8_codepoint_width(codepoint);
 
                     /* Write the character */
-                    write(STDOUT_FILENO, command_buffer + i, char_bytes);
+                    output_frame_append(frame, command_buffer + i,
+                                        (size_t)char_bytes);
 
                     /* Update visual position */
                     visual_col += char_width;
@@ -728,7 +569,7 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
                     i += char_bytes;
                 } else {
                     /* Invalid UTF-8, write single byte */
-                    write(STDOUT_FILENO, command_buffer + i, 1);
+                    output_frame_append(frame, command_buffer + i, 1);
                     visual_col++;
                     if (visual_col >= term_width) {
                         visual_row++;
@@ -739,48 +580,32 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
             }
         } else {
             /* Single-line input - write directly */
-            write(STDOUT_FILENO, command_buffer, strlen(command_buffer));
+            output_frame_append_str(frame, command_buffer);
         }
     }
 
     /* Step 4a: Write autosuggestion ghost text (Fish-style)
-     *
-     * Conditions for showing ghost text:
-     * 1. Autosuggestions enabled and layer available
-     * 2. No completion menu visible (menu takes precedence)
-     * 3. Not multiline input (simplifies initial implementation)
-     * 4. Cursor is at end of command (checked by autosuggestions_layer)
      *
      * The ghost text appears in BRIGHT_BLACK (gray/dimmed) after the command.
      * Cursor positioning (Step 5) will move cursor back to correct position.
      */
-    if (controller->autosuggestions_enabled &&
-        controller->autosuggestions_layer &&
-        !controller->completion_menu_visible && !is_multiline) {
-
-        const char *suggestion = autosuggestions_layer_get_current_suggestion(
-            controller->autosuggestions_layer);
-
-        if (suggestion && *suggestion) {
-            /* Write ghost text in BRIGHT_BLACK (dimmed gray) */
-            write(STDOUT_FILENO, "\033[90m",
-                  5); /* Set bright black foreground */
-            write(STDOUT_FILENO, suggestion, strlen(suggestion));
-            write(STDOUT_FILENO, "\033[0m", 4); /* Reset all attributes */
-        }
+    if (suggestion) {
+        output_frame_append_str(frame, "\033[90m"); /* Bright black */
+        output_frame_append_str(frame, suggestion);
+        output_frame_append_str(frame, "\033[0m"); /* Reset attributes */
     }
 
     /* Step 4b: Write completion menu WITHOUT continuation prompts */
     if (menu_text && *menu_text) {
-        write(STDOUT_FILENO, "\n", 1);
-        write(STDOUT_FILENO, menu_text, strlen(menu_text));
+        output_frame_append(frame, "\n", 1);
+        output_frame_append_str(frame, menu_text);
     }
 
     /* Step 4c: Write notification below menu (if any)
      * Notification is now tracked in screen_buffer like menu */
     if (notification_text && *notification_text) {
-        write(STDOUT_FILENO, "\n", 1);
-        write(STDOUT_FILENO, notification_text, strlen(notification_text));
+        output_frame_append(frame, "\n", 1);
+        output_frame_append_str(frame, notification_text);
     }
 
     /* Step 5: Position cursor at the correct location
@@ -795,88 +620,262 @@ static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
      * - desired_screen.num_rows now includes menu rows
      * - desired_screen.cursor_row is still in the command area (unaffected by
      * menu)
+     * - Ghost text rows were added via screen_buffer_add_ghost_text()
      * - screen_buffer_get_rows_below_cursor() gives us the exact count
-     *
-     * Ghost text is not yet tracked in screen_buffer, so we still calculate it
-     * separately.
      */
     int cursor_row = desired_screen.cursor_row;
     int cursor_col = desired_screen.cursor_col;
 
-    /* Calculate extra rows added by ghost text (autosuggestion)
-     * Ghost text may wrap to additional lines beyond the command text.
-     * TODO: Add ghost text to screen_buffer for unified tracking. */
-    int ghost_text_extra_rows = 0;
+    /* Calculate rows to move up using screen_buffer's tracked state.
+     *
+     * screen_buffer_get_rows_below_cursor() returns: (num_rows - 1) -
+     * cursor_row This accounts for ghost text, menu AND notification rows.
+     */
+    int rows_to_move_up = screen_buffer_get_rows_below_cursor(&desired_screen);
+
+    DC_DEBUG("Step5: cursor=(%d,%d), num_rows=%d, ghost=%d, total_up=%d",
+             cursor_row, cursor_col, desired_screen.num_rows,
+             desired_screen.ghost_text_lines, rows_to_move_up);
+
+    if (rows_to_move_up > 0) {
+        output_frame_appendf(frame, "\033[%dA", rows_to_move_up);
+    }
+
+    /* Move to absolute column (never use \r - it goes to column 0!)
+     * Use \033[{n}G for absolute column positioning (1-based indexing) */
+    output_frame_appendf(frame, "\033[%dG", cursor_col + 1);
+}
+
+/**
+ * @brief Handle redraw needed event from command layer
+ * @param event Layer event that triggered this callback
+ * @param user_data User data (display_controller_t pointer)
+ * @return LAYER_EVENTS_SUCCESS on success, error code otherwise
+ */
+static layer_events_error_t dc_handle_redraw_needed(const layer_event_t *event,
+                                                    void *user_data) {
+
+    (void)event;
+    display_controller_t *controller = (display_controller_t *)user_data;
+
+    if (!controller || !controller->is_initialized) {
+        return LAYER_EVENTS_ERROR_INVALID_PARAM;
+    }
+
+    command_layer_t *cmd_layer = controller->compositor->command_layer;
+    if (!cmd_layer) {
+        return LAYER_EVENTS_ERROR_INVALID_PARAM;
+    }
+
+    int term_width = 80;
+    if (controller->terminal_ctrl &&
+        controller->terminal_ctrl->capabilities.terminal_width > 0) {
+        term_width = controller->terminal_ctrl->capabilities.terminal_width;
+    }
+
+    if (!screen_buffer_initialized) {
+        screen_buffer_init(&current_screen, term_width);
+        screen_buffer_init(&desired_screen, term_width);
+        screen_buffer_initialized = true;
+    } else {
+        /* current_screen keeps the width it was drawn at, so a resize is
+         * seen as a change that cannot be diffed */
+        desired_screen.terminal_width = term_width;
+    }
+
+    prompt_layer_t *prompt_layer = controller->compositor->prompt_layer;
+    char prompt_buffer[PROMPT_LAYER_MAX_CONTENT_SIZE] = {0};
+    if (prompt_layer) {
+        prompt_layer_get_rendered_content(prompt_layer, prompt_buffer,
+                                          sizeof(prompt_buffer));
+    }
+
+    char command_buffer[COMMAND_LAYER_MAX_HIGHLIGHTED_SIZE];
+    command_layer_error_t cmd_result = command_layer_get_highlighted_text(
+        cmd_layer, command_buffer, sizeof(command_buffer));
+
+    if (cmd_result != COMMAND_LAYER_SUCCESS) {
+        return LAYER_EVENTS_ERROR_INVALID_PARAM;
+    }
+
+    /* Render completion menu if active (Proper Architecture - Spec 12)
+     * Menu is now composed at display time, not baked into command text */
+    char menu_buffer[8192] = {0};
+    char *menu_text = NULL;
+
+    if (controller->completion_menu_visible &&
+        controller->active_completion_menu) {
+        lle_menu_render_options_t options =
+            lle_menu_renderer_default_options(term_width);
+        options.max_rows = 20; /* Limit menu to 20 rows */
+
+        lle_menu_render_stats_t stats;
+        lle_result_t result = lle_completion_menu_render(
+            controller->active_completion_menu, &options, menu_buffer,
+            sizeof(menu_buffer), &stats);
+
+        if (result == LLE_SUCCESS && menu_buffer[0]) {
+            menu_text = menu_buffer;
+        }
+    }
+
+    /* CONTINUATION PROMPT SUPPORT:
+     *
+     * Use screen_buffer_render_with_continuation() which calls back on each
+     * newline to get the context-aware continuation prompt. This is the
+     * architecturally correct approach: prompts are set at the exact visual row
+     * where each newline lands during character-by-character rendering, not
+     * pre-calculated.
+     *
+     * The callback receives the plain text of each line (ANSI stripped) and
+     * updates the continuation state to determine the appropriate prompt.
+     */
+    int newline_count = count_newlines(command_buffer);
+    bool is_multiline = (newline_count > 0);
+
+    size_t cursor_byte_offset = cmd_layer->cursor_position;
+
+    if (is_multiline) {
+        /* Use callback-based rendering for proper visual row tracking */
+        continuation_state_t cont_state;
+        continuation_state_init(&cont_state);
+
+        screen_buffer_render_with_continuation(
+            &desired_screen, prompt_buffer, command_buffer, cursor_byte_offset,
+            dc_continuation_prompt_callback, &cont_state);
+
+        continuation_state_cleanup(&cont_state);
+    } else {
+        /* No newlines - use simple render, dropping continuation prompts
+         * left from an earlier multiline render */
+        for (int r = 0; r < SCREEN_BUFFER_MAX_ROWS; r++) {
+            screen_buffer_clear_line_prefix(&desired_screen, r);
+        }
+        screen_buffer_render(&desired_screen, prompt_buffer, command_buffer,
+                             cursor_byte_offset);
+    }
+
+    /* DEBUG: Log what screen_buffer_render produced */
+    DC_DEBUG("After render: num_rows=%d, command_start_row=%d, cursor=(%d,%d), "
+             "term_width=%d",
+             desired_screen.num_rows, desired_screen.command_start_row,
+             desired_screen.cursor_row, desired_screen.cursor_col, term_width);
+
+    /* DEBUG: Log prefixes set on each row */
+    for (int r = 0; r < desired_screen.num_rows && r < 10; r++) {
+        const char *prefix = screen_buffer_get_line_prefix(&desired_screen, r);
+        if (prefix) {
+            DC_DEBUG("  Row %d has prefix: '%s'", r, prefix);
+        }
+    }
+
+    /* Add autosuggestion ghost text (Fish-style) to screen_buffer
+     *
+     * Conditions for showing ghost text:
+     * 1. Autosuggestions enabled and layer available
+     * 2. No completion menu visible (menu takes precedence)
+     * 3. Not multiline input (simplifies initial implementation)
+     * 4. Cursor is at end of command (checked by autosuggestions_layer)
+     *
+     * Ghost text may wrap past the command; tracking it in the buffer keeps
+     * the rows below it (notification) and cursor positioning exact.
+     */
+    const char *suggestion = NULL;
     if (controller->autosuggestions_enabled &&
         controller->autosuggestions_layer &&
         !controller->completion_menu_visible && !is_multiline) {
-
-        const char *suggestion = autosuggestions_layer_get_current_suggestion(
+        suggestion = autosuggestions_layer_get_current_suggestion(
             controller->autosuggestions_layer);
-
         if (suggestion && *suggestion) {
-            size_t suggestion_width =
-                lle_utf8_string_width(suggestion, strlen(suggestion));
-            int command_end_col = desired_screen.command_end_col;
-            int total_cols_needed = command_end_col + (int)suggestion_width;
-
-            if (total_cols_needed > term_width) {
-                ghost_text_extra_rows = (total_cols_needed - 1) / term_width;
-            }
+            screen_buffer_add_ghost_text(&desired_screen, suggestion);
+        } else {
+            suggestion = NULL;
         }
     }
 
-    /* Calculate rows to move up using screen_buffer's tracked state.
+    /* Add menu rows to screen_buffer per SCREEN_BUFFER_MENU_INTEGRATION_PLAN.md
      *
-     * screen_buffer_get_rows_below_cursor() returns: (num_rows - 1) -
-     * cursor_row This accounts for menu rows AND notification rows that were
-     * added via screen_buffer_add_text_rows(). We still need to add
-     * ghost_text_extra_rows since those aren't in screen_buffer yet.
+     * This is the key fix: by adding menu rows to screen_buffer AFTER rendering
+     * command text, the buffer knows the total display height. This allows
+     * screen_buffer_get_rows_below_cursor() to return the correct value for
+     * cursor positioning, fixing the "upward row consumption" bug.
+     *
+     * Cursor position (cursor_row, cursor_col) stays in the command area -
+     * menu rows are added AFTER and don't affect cursor tracking.
      */
-    int rows_to_move_up = screen_buffer_get_rows_below_cursor(&desired_screen) +
-                          ghost_text_extra_rows;
+    int menu_rows_added = 0;
+    if (menu_text && *menu_text) {
+        /* Add menu starting at row after command ends.
+         * Note: We add a newline before menu, so start at num_rows (which is
+         * one past the last command row). */
+        int menu_start_row = desired_screen.num_rows;
+        menu_rows_added = screen_buffer_add_text_rows(
+            &desired_screen, menu_start_row, menu_text);
 
-    DC_DEBUG("Step5: cursor=(%d,%d), num_rows=%d, rows_below=%d, ghost=%d, "
-             "total_up=%d",
-             cursor_row, cursor_col, desired_screen.num_rows,
-             screen_buffer_get_rows_below_cursor(&desired_screen),
-             ghost_text_extra_rows, rows_to_move_up);
+        DC_DEBUG("Added menu to screen_buffer: start_row=%d, rows_added=%d, "
+                 "new_num_rows=%d",
+                 menu_start_row, menu_rows_added, desired_screen.num_rows);
+    }
 
-    if (rows_to_move_up > 0) {
-        char up_seq[16];
-        int up_len =
-            snprintf(up_seq, sizeof(up_seq), "\033[%dA", rows_to_move_up);
-        if (up_len > 0) {
-            write(STDOUT_FILENO, up_seq, up_len);
+    /* Get notification text if visible and add to screen_buffer for proper tracking
+     * Following the same pattern as menu to ensure correct cursor positioning */
+    char notification_buffer[LLE_NOTIFICATION_MAX_STYLED];
+    const char *notification_text = NULL;
+    int notification_rows_added = 0;
+
+    if (controller->notification_visible && controller->notification_copy.visible) {
+        notification_text = lle_notification_get_styled_text(
+            &controller->notification_copy, notification_buffer,
+            sizeof(notification_buffer));
+
+        /* Add notification to screen_buffer like we do for menu */
+        if (notification_text && *notification_text) {
+            int notif_start_row = desired_screen.num_rows;
+            notification_rows_added = screen_buffer_add_text_rows(
+                &desired_screen, notif_start_row, notification_text);
+
+            DC_DEBUG("Added notification to screen_buffer: start_row=%d, rows_added=%d, "
+                     "new_num_rows=%d",
+                     notif_start_row, notification_rows_added, desired_screen.num_rows);
         }
     }
 
-    /* Move to absolute column (never use \r - it goes to column 0!)
-     * Use \033[{n}G for absolute column positioning (1-based indexing) */
-    char col_seq[16];
-    int col_seq_len =
-        snprintf(col_seq, sizeof(col_seq), "\033[%dG", cursor_col + 1);
-    if (col_seq_len > 0) {
-        write(STDOUT_FILENO, col_seq, col_seq_len);
+    /* Compose the redraw into one frame: after the first render of a line,
+     * only the cells that changed since the last frame are written */
+    output_frame_t *frame = dc_output_frame(controller);
+    output_frame_begin(frame);
+
+    int term_height = 0;
+    if (controller->terminal_ctrl) {
+        term_height = controller->terminal_ctrl->capabilities.terminal_height;
+    }
+    bool fits_screen = term_height <= 0 ||
+                       (desired_screen.num_rows <= term_height &&
+                        current_screen.num_rows <= term_height);
+
+    if (!prompt_rendered || !fits_screen ||
+        !screen_buffer_render_diff(&current_screen, &desired_screen, frame)) {
+        dc_compose_full_redraw(frame, prompt_buffer, command_buffer,
+                               is_multiline, suggestion, menu_text,
+                               notification_text, term_width);
     }
 
+    /* Write the whole frame with a single system call */
+    output_frame_flush(frame);
+
     DC_DEBUG(
-        "Step5 done: copying desired_screen to current_screen (cursor_row=%d)",
+        "Frame done: copying desired_screen to current_screen (cursor_row=%d)",
         desired_screen.cursor_row);
     screen_buffer_copy(&current_screen, &desired_screen);
     prompt_rendered = true;
 
     /* Track where the terminal display actually ends (including ghost
-     * text/menu/notification) This is needed by Step 2 on the next render to
-     * move up the correct amount.
-     *
-     * With menu AND notification rows now tracked in screen_buffer:
-     * - (num_rows - 1) gives the last row index in the buffer (includes menu
-     *   and notification)
-     * - ghost_text_extra_rows adds any additional wrapping from autosuggestions
+     * text/menu/notification) This is needed by Step 2 on the next full
+     * redraw to move up the correct amount. Ghost text, menu and
+     * notification rows are all tracked in screen_buffer, so (num_rows - 1)
+     * is the last row on screen.
      */
-    last_terminal_end_row =
-        (desired_screen.num_rows - 1) + ghost_text_extra_rows;
+    last_terminal_end_row = desired_screen.num_rows - 1;
 
     /* NOTE: fsync() was causing input timeouts after cursor positioning -
      * removed stdout is line-buffered by default and terminal I/O doesn't need
@@ -1446,6 +1445,9 @@ display_controller_t *display_controller_create(void) {
     // Initialize configuration with defaults
     dc_init_default_config(&controller->config);
 
+    // Redraws are composed here and written with one system call
+    output_frame_init(&controller->output_frame, STDOUT_FILENO);
+
     DC_DEBUG("Display controller created successfully");
     return controller;
 }
@@ -2515,6 +2517,9 @@ display_controller_cleanup(display_controller_t *controller) {
     }
     controller->autosuggestions_enabled = false;
 
+    // Release the output frame buffer
+    output_frame_cleanup(&controller->output_frame);
+
     // Clean up event system (we own it - passed to us during init)
     if (controller->event_system) {
         layer_events_destroy(controller->event_system);
@@ -2843,6 +2848,32 @@ bool display_controller_check_and_clear_notification_changed(
     return changed;
 }
 
+// ============================================================================
+// TERMINAL OUTPUT
+// ============================================================================
+
+void display_controller_set_synchronized_output(
+    display_controller_t *controller, bool enabled) {
+
+    if (!controller) {
+        return;
+    }
+
+    output_frame_set_synchronized(&controller->output_frame, enabled);
+}
+
+display_controller_error_t
+display_controller_get_output_stats(const display_controller_t *controller,
+                                    output_frame_stats_t *stats) {
+
+    if (!controller || !stats) {
+        return DISPLAY_CONTROLLER_ERROR_NULL_POINTER;
+    }
+
+    output_frame_get_stats(&controller->output_frame, stats);
+    return DISPLAY_CONTROLLER_SUCCESS;
+}
+
 // ============================================================================
 // PERFORMANCE AND MONITORING FUNCTIONS
 // ============================================================================
@@ -0,0 +1,216 @@
+/**
+ * @file output_frame.c
+ * @brief Output Frame Implementation
+ *
+ * Collects the output of a whole redraw in memory and writes it with one
+ * writev(). When the terminal supports synchronized output (DEC mode 2026)
+ * the frame is bracketed by begin/end sequences in the same call, so the
+ * terminal never presents a half-drawn line.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "display/output_frame.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ============================================================================
+// INITIALIZATION AND CLEANUP
+// ============================================================================
+
+void output_frame_init(output_frame_t *frame, int fd) {
+    if (!frame)
+        return;
+
+    memset(frame, 0, sizeof(output_frame_t));
+    frame->fd = fd;
+}
+
+void output_frame_cleanup(output_frame_t *frame) {
+    if (!frame)
+        return;
+
+    free(frame->data);
+    frame->data = NULL;
+    frame->length = 0;
+    frame->capacity = 0;
+}
+
+void output_frame_set_synchronized(output_frame_t *frame, bool enabled) {
+    if (!frame)
+        return;
+
+    frame->synchronized = enabled;
+}
+
+// ============================================================================
+// COMPOSITION
+// ============================================================================
+
+void output_frame_begin(output_frame_t *frame) {
+    if (!frame)
+        return;
+
+    frame->length = 0;
+}
+
+/**
+ * @brief Grow the frame buffer to hold at least @p needed bytes
+ * @param frame Frame to grow
+ * @param needed Required capacity
+ * @return true on success, false on allocation failure
+ */
+static bool frame_reserve(output_frame_t *frame, size_t needed) {
+    if (needed <= frame->capacity)
+        return true;
+
+    size_t new_capacity =
+        frame->capacity ? frame->capacity : OUTPUT_FRAME_INITIAL_CAPACITY;
+    while (new_capacity < needed)
+        new_capacity *= 2;
+
+    char *new_data = realloc(frame->data, new_capacity);
+    if (!new_data)
+        return false;
+
+    frame->data = new_data;
+    frame->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Write an iovec array completely, continuing partial writes
+ * @param frame Frame whose descriptor and statistics are used
+ * @param iov Buffers to write (modified as they are consumed)
+ * @param count Number of buffers
+ * @return 0 on success, -1 on write error
+ */
+static int frame_writev(output_frame_t *frame, struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t n = writev(frame->fd, iov, count);
+        frame->frame_calls++;
+        frame->stats.syscalls++;
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        frame->frame_bytes += (size_t)n;
+        frame->stats.bytes += (size_t)n;
+
+        /* Skip fully written buffers, then trim a partially written one */
+        size_t remaining = (size_t)n;
+        while (count > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return 0;
+}
+
+void output_frame_append(output_frame_t *frame, const char *data,
+                         size_t length) {
+    if (!frame || !data || length == 0)
+        return;
+
+    if (!frame_reserve(frame, frame->length + length)) {
+        /* Out of memory: fall back to writing through */
+        output_frame_flush(frame);
+        struct iovec iov = {(void *)data, length};
+        frame_writev(frame, &iov, 1);
+        return;
+    }
+
+    memcpy(frame->data + frame->length, data, length);
+    frame->length += length;
+}
+
+void output_frame_append_str(output_frame_t *frame, const char *str) {
+    if (!str)
+        return;
+
+    output_frame_append(frame, str, strlen(str));
+}
+
+void output_frame_appendf(output_frame_t *frame, const char *format, ...) {
+    if (!frame || !format)
+        return;
+
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (len > 0) {
+        size_t n = (size_t)len < sizeof(buffer) ? (size_t)len
+                                                : sizeof(buffer) - 1;
+        output_frame_append(frame, buffer, n);
+    }
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+int output_frame_flush(output_frame_t *frame) {
+    if (!frame)
+        return -1;
+
+    if (frame->length == 0)
+        return 0;
+
+    struct iovec iov[3];
+    int count = 0;
+    if (frame->synchronized) {
+        iov[count].iov_base = (void *)OUTPUT_FRAME_SYNC_BEGIN;
+        iov[count].iov_len = sizeof(OUTPUT_FRAME_SYNC_BEGIN) - 1;
+        count++;
+    }
+    iov[count].iov_base = frame->data;
+    iov[count].iov_len = frame->length;
+    count++;
+    if (frame->synchronized) {
+        iov[count].iov_base = (void *)OUTPUT_FRAME_SYNC_END;
+        iov[count].iov_len = sizeof(OUTPUT_FRAME_SYNC_END) - 1;
+        count++;
+    }
+
+    int result = frame_writev(frame, iov, count);
+
+    frame->stats.frames++;
+    frame->stats.last_frame_bytes = frame->frame_bytes;
+    frame->stats.last_frame_syscalls = frame->frame_calls;
+    if (frame->frame_bytes > frame->stats.max_frame_bytes)
+        frame->stats.max_frame_bytes = frame->frame_bytes;
+
+    frame->frame_bytes = 0;
+    frame->frame_calls = 0;
+    frame->length = 0;
+    return result;
+}
+
+void output_frame_get_stats(const output_frame_t *frame,
+                            output_frame_stats_t *stats) {
+    if (!stats)
+        return;
+
+    if (!frame) {
+        memset(stats, 0, sizeof(output_frame_stats_t));
+        return;
+    }
+
+    *stats = frame->stats;
+}
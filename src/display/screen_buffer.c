@@ -57,11 +57,23 @@ void screen_buffer_init(screen_buffer_t *buffer, int terminal_width) {
     }
 }
 
+/**
+ * @brief Number of rows in use, clamped to the buffer size
+ * @param buffer Screen buffer to query
+ * @return Rows that may hold content
+ */
+static int used_rows(const screen_buffer_t *buffer) {
+    if (buffer->num_rows < 0)
+        return 0;
+    return buffer->num_rows < SCREEN_BUFFER_MAX_ROWS ? buffer->num_rows
+                                                     : SCREEN_BUFFER_MAX_ROWS;
+}
+
 void screen_buffer_clear(screen_buffer_t *buffer) {
     if (!buffer)
         return;
 
-    for (int i = 0; i < buffer->num_rows; i++) {
+    for (int i = 0; i < used_rows(buffer); i++) {
         buffer->lines[i].length = 0;
         buffer->lines[i].dirty = false;
 
@@ -81,6 +93,7 @@ void screen_buffer_clear(screen_buffer_t *buffer) {
     buffer->total_display_rows = 0;
     buffer->command_end_row = 0;
     buffer->command_end_col = 0;
+    buffer->inexact = false;
 }
 
 void screen_buffer_cleanup(screen_buffer_t *buffer) {
@@ -97,9 +110,46 @@ void screen_buffer_cleanup(screen_buffer_t *buffer) {
 }
 
 void screen_buffer_copy(screen_buffer_t *dest, const screen_buffer_t *src) {
-    if (!dest || !src)
+    if (!dest || !src || dest == src)
         return;
-    memcpy(dest, src, sizeof(screen_buffer_t));
+
+    for (int i = 0; i < SCREEN_BUFFER_MAX_ROWS; i++) {
+        screen_buffer_clear_line_prefix(dest, i);
+    }
+
+    /* Rows past num_rows are always zeroed, so only rows in use on either
+     * side need copying or clearing */
+    int src_rows = used_rows(src);
+    int dest_rows = used_rows(dest);
+    for (int i = 0; i < src_rows; i++) {
+        dest->lines[i] = src->lines[i];
+        dest->lines[i].prefix = NULL;
+    }
+    for (int i = src_rows; i < dest_rows; i++) {
+        memset(&dest->lines[i], 0, sizeof(screen_line_t));
+    }
+
+    for (int i = 0; i < SCREEN_BUFFER_MAX_ROWS; i++) {
+        const screen_line_prefix_t *prefix = src->lines[i].prefix;
+        if (prefix && prefix->text) {
+            screen_buffer_set_line_prefix(dest, i, prefix->text);
+            dest->lines[i].prefix->dirty = prefix->dirty;
+        }
+        dest->lines[i].prefix_dirty = src->lines[i].prefix_dirty;
+    }
+
+    dest->num_rows = src->num_rows;
+    dest->terminal_width = src->terminal_width;
+    dest->cursor_row = src->cursor_row;
+    dest->cursor_col = src->cursor_col;
+    dest->command_start_row = src->command_start_row;
+    dest->command_start_col = src->command_start_col;
+    dest->menu_lines = src->menu_lines;
+    dest->ghost_text_lines = src->ghost_text_lines;
+    dest->total_display_rows = src->total_display_rows;
+    dest->command_end_row = src->command_end_row;
+    dest->command_end_col = src->command_end_col;
+    dest->inexact = src->inexact;
 }
 
 // ============================================================================
@@ -166,6 +216,185 @@ size_t screen_buffer_visual_width(const char *text, size_t byte_length) {
     return visual_width;
 }
 
+// ============================================================================
+// STYLE TRACKING
+// ============================================================================
+
+/**
+ * @brief Parse an extended color (38/48 ;5;n or ;2;r;g;b)
+ * @param values SGR parameter values
+ * @param count Number of values
+ * @param index Index of the 38/48 parameter; advanced past the color
+ * @param color Output: encoded color
+ * @return true if a complete color was parsed
+ */
+static bool parse_extended_color(const int *values, int count, int *index,
+                                 uint32_t *color) {
+    int i = *index;
+    if (i + 2 < count && values[i + 1] == 5) {
+        *color = SCREEN_COLOR_INDEXED | (uint32_t)(values[i + 2] & 0xFF);
+        *index = i + 2;
+        return values[i + 2] <= 255;
+    }
+    if (i + 4 < count && values[i + 1] == 2) {
+        *color = SCREEN_COLOR_RGB | ((uint32_t)(values[i + 2] & 0xFF) << 16) |
+                 ((uint32_t)(values[i + 3] & 0xFF) << 8) |
+                 (uint32_t)(values[i + 4] & 0xFF);
+        *index = i + 4;
+        return values[i + 2] <= 255 && values[i + 3] <= 255 &&
+               values[i + 4] <= 255;
+    }
+    *index = count;
+    return false;
+}
+
+bool screen_style_apply_sgr(screen_style_t *style, const char *params,
+                            size_t length) {
+    if (!style || (!params && length > 0))
+        return false;
+
+    /* Split into numeric values; an empty parameter means 0 */
+    int values[32];
+    int count = 0;
+    int value = 0;
+    for (size_t i = 0; i <= length; i++) {
+        if (i == length || params[i] == ';') {
+            if (count == (int)(sizeof(values) / sizeof(values[0])))
+                return false;
+            values[count++] = value;
+            value = 0;
+        } else if (params[i] >= '0' && params[i] <= '9') {
+            if (value < 100000)
+                value = value * 10 + (params[i] - '0');
+        } else {
+            /* Colon sub-parameters and private forms are not tracked */
+            return false;
+        }
+    }
+
+    bool understood = true;
+    for (int i = 0; i < count; i++) {
+        int v = values[i];
+        switch (v) {
+        case 0:
+            memset(style, 0, sizeof(screen_style_t));
+            break;
+        case 1:
+            style->attrs |= SCREEN_ATTR_BOLD;
+            break;
+        case 2:
+            style->attrs |= SCREEN_ATTR_DIM;
+            break;
+        case 3:
+            style->attrs |= SCREEN_ATTR_ITALIC;
+            break;
+        case 4:
+            style->attrs |= SCREEN_ATTR_UNDERLINE;
+            break;
+        case 5:
+            style->attrs |= SCREEN_ATTR_BLINK;
+            break;
+        case 7:
+            style->attrs |= SCREEN_ATTR_REVERSE;
+            break;
+        case 8:
+            style->attrs |= SCREEN_ATTR_HIDDEN;
+            break;
+        case 9:
+            style->attrs |= SCREEN_ATTR_STRIKE;
+            break;
+        case 22:
+            style->attrs &= (uint8_t) ~(SCREEN_ATTR_BOLD | SCREEN_ATTR_DIM);
+            break;
+        case 23:
+            style->attrs &= (uint8_t)~SCREEN_ATTR_ITALIC;
+            break;
+        case 24:
+            style->attrs &= (uint8_t)~SCREEN_ATTR_UNDERLINE;
+            break;
+        case 25:
+            style->attrs &= (uint8_t)~SCREEN_ATTR_BLINK;
+            break;
+        case 27:
+            style->attrs &= (uint8_t)~SCREEN_ATTR_REVERSE;
+            break;
+        case 28:
+            style->attrs &= (uint8_t)~SCREEN_ATTR_HIDDEN;
+            break;
+        case 29:
+            style->attrs &= (uint8_t)~SCREEN_ATTR_STRIKE;
+            break;
+        case 38:
+            if (!parse_extended_color(values, count, &i, &style->fg))
+                understood = false;
+            break;
+        case 39:
+            style->fg = SCREEN_COLOR_DEFAULT;
+            break;
+        case 48:
+            if (!parse_extended_color(values, count, &i, &style->bg))
+                understood = false;
+            break;
+        case 49:
+            style->bg = SCREEN_COLOR_DEFAULT;
+            break;
+        default:
+            if (v >= 30 && v <= 37) {
+                style->fg = SCREEN_COLOR_BASIC | (uint32_t)(v - 30);
+            } else if (v >= 90 && v <= 97) {
+                style->fg = SCREEN_COLOR_BASIC | (uint32_t)(v - 90 + 8);
+            } else if (v >= 40 && v <= 47) {
+                style->bg = SCREEN_COLOR_BASIC | (uint32_t)(v - 40);
+            } else if (v >= 100 && v <= 107) {
+                style->bg = SCREEN_COLOR_BASIC | (uint32_t)(v - 100 + 8);
+            } else {
+                understood = false;
+            }
+            break;
+        }
+    }
+    return understood;
+}
+
+/**
+ * @brief Skip an escape sequence, applying it to the style if it is SGR
+ *
+ * Sequences are skipped the way the layout code always has: ESC, then for
+ * CSI everything up to and including the first letter.
+ *
+ * @param text Text containing the sequence
+ * @param text_len Length of text
+ * @param pos Position of the ESC byte; advanced past the sequence
+ * @param style Style updated by SGR sequences
+ * @param tracked Output: true if the sequence was SGR and fully understood
+ * @return true if a CSI sequence was terminated by a letter
+ */
+static bool consume_escape(const char *text, size_t text_len, size_t *pos,
+                           screen_style_t *style, bool *tracked) {
+    size_t i = *pos + 1;
+    bool terminated = false;
+    *tracked = false;
+
+    if (i < text_len && text[i] == '[') {
+        i++;
+        size_t params_start = i;
+        while (i < text_len) {
+            char c = text[i++];
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+                terminated = true;
+                if (c == 'm') {
+                    *tracked = screen_style_apply_sgr(
+                        style, text + params_start, i - 1 - params_start);
+                }
+                break;
+            }
+        }
+    }
+
+    *pos = i;
+    return terminated;
+}
+
 // ============================================================================
 // RENDERING
 // ============================================================================
@@ -181,12 +410,14 @@ size_t screen_buffer_visual_width(const char *text, size_t byte_length) {
  * @param byte_len Number of bytes in the UTF-8 sequence (1-4)
  * @param visual_width Display width in columns (0, 1, or 2)
  * @param is_prompt True if this is part of the prompt
+ * @param style Colors and attributes in effect
  * @param row Pointer to current row (may be incremented for wrapping)
  * @param col Pointer to current column (may be incremented for wrapping)
  */
 static void write_char_to_buffer(screen_buffer_t *buffer,
                                  const char *utf8_bytes, int byte_len,
-                                 int visual_width, bool is_prompt, int *row,
+                                 int visual_width, bool is_prompt,
+                                 const screen_style_t *style, int *row,
                                  int *col) {
     if (!buffer || !utf8_bytes || !row || !col)
         return;
@@ -214,6 +445,12 @@ static void write_char_to_buffer(screen_buffer_t *buffer,
     cell->byte_len = (uint8_t)byte_len;
     cell->visual_width = (uint8_t)visual_width;
     cell->is_prompt = is_prompt;
+    cell->style = *style;
+
+    // A wide character in the last column wraps on a real terminal
+    if (visual_width == 2 && *col == buffer->terminal_width - 1) {
+        buffer->inexact = true;
+    }
 
     // Zero out unused bytes for cleanliness and deterministic comparison
     for (int i = byte_len; i < 4; i++) {
@@ -238,6 +475,7 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
     int row = 0;
     int col = 0;
     bool cursor_set = false;
+    screen_style_t style = {0};
 
     // Render prompt - calculate visual width (excluding ANSI codes)
     if (prompt_text) {
@@ -266,18 +504,8 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
 
             // Handle ANSI escape sequences (skip without advancing position)
             if (ch == '\033' || ch == '\x1b') {
-                i++;
-                if (i < text_len && prompt_text[i] == '[') {
-                    i++;
-                    while (i < text_len) {
-                        char c = prompt_text[i++];
-                        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-                            c == 'm' || c == 'H' || c == 'J' || c == 'K' ||
-                            c == 'G') {
-                            break;
-                        }
-                    }
-                }
+                bool tracked;
+                consume_escape(prompt_text, text_len, &i, &style, &tracked);
                 continue;
             }
 
@@ -325,7 +553,8 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
                 if (visual_width > 0) {
                     // Store full UTF-8 sequence
                     write_char_to_buffer(buffer, prompt_text + i, bytes,
-                                         visual_width, true, &row, &col);
+                                         visual_width, true, &style, &row,
+                                         &col);
 
                     // For wide characters (width=2), we store the character in
                     // one cell but it occupies 2 columns visually, so advance
@@ -373,17 +602,10 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
             // Handle ANSI escape sequences (skip without advancing
             // bytes_processed or position)
             if (ch == '\033' || ch == '\x1b') {
-                i++;
-                if (i < text_len && command_text[i] == '[') {
-                    i++;
-                    while (i < text_len) {
-                        char c = command_text[i++];
-                        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-                            c == 'm' || c == 'H' || c == 'J' || c == 'K' ||
-                            c == 'G' || c == 'f' || c == 's' || c == 'u') {
-                            break;
-                        }
-                    }
+                bool tracked;
+                consume_escape(command_text, text_len, &i, &style, &tracked);
+                if (!tracked) {
+                    buffer->inexact = true;
                 }
                 // Don't increment bytes_processed - ANSI codes don't count
                 continue;
@@ -412,6 +634,8 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
 
             // Handle tabs
             if (ch == '\t') {
+                // Terminal tab stops may differ from tab_width
+                buffer->inexact = true;
                 int tw = config.tab_width > 0 ? config.tab_width : 4;
                 size_t tab_width = tw - (col % tw);
                 col += tab_width;
@@ -438,7 +662,8 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
                 if (visual_width > 0) {
                     // Store full UTF-8 sequence
                     write_char_to_buffer(buffer, command_text + i, char_bytes,
-                                         visual_width, false, &row, &col);
+                                         visual_width, false, &style, &row,
+                                         &col);
 
                     // For wide characters (width=2), we store the character in
                     // one cell but it occupies 2 columns visually, so advance
@@ -454,11 +679,16 @@ void screen_buffer_render(screen_buffer_t *buffer, const char *prompt_text,
                             }
                         }
                     }
+                } else {
+                    // Zero-width marks have no cell of their own
+                    buffer->inexact = true;
                 }
 
                 i += char_bytes;
                 bytes_processed += char_bytes;
             } else {
+                // Control bytes and invalid UTF-8 are not stored
+                buffer->inexact = true;
                 i++;
                 bytes_processed++;
             }
@@ -504,6 +734,7 @@ void screen_buffer_render_with_continuation(
     int row = 0;
     int col = 0;
     bool cursor_set = false;
+    screen_style_t style = {0};
 
     // Render prompt - same as screen_buffer_render
     if (prompt_text) {
@@ -530,18 +761,8 @@ void screen_buffer_render_with_continuation(
             }
 
             if (ch == '\033' || ch == '\x1b') {
-                i++;
-                if (i < text_len && prompt_text[i] == '[') {
-                    i++;
-                    while (i < text_len) {
-                        char c = prompt_text[i++];
-                        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-                            c == 'm' || c == 'H' || c == 'J' || c == 'K' ||
-                            c == 'G') {
-                            break;
-                        }
-                    }
-                }
+                bool tracked;
+                consume_escape(prompt_text, text_len, &i, &style, &tracked);
                 continue;
             }
 
@@ -584,7 +805,8 @@ void screen_buffer_render_with_continuation(
                 int visual_width = lle_utf8_codepoint_width(codepoint);
                 if (visual_width > 0) {
                     write_char_to_buffer(buffer, prompt_text + i, bytes,
-                                         visual_width, true, &row, &col);
+                                         visual_width, true, &style, &row,
+                                         &col);
                     if (visual_width == 2) {
                         col++;
                         if (col >= buffer->terminal_width) {
@@ -634,19 +856,11 @@ void screen_buffer_render_with_continuation(
 
             // Handle ANSI escape sequences
             if (ch == '\033' || ch == '\x1b') {
-                in_ansi = true;
-                i++;
-                if (i < text_len && command_text[i] == '[') {
-                    i++;
-                    while (i < text_len) {
-                        char c = command_text[i++];
-                        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-                            c == 'm' || c == 'H' || c == 'J' || c == 'K' ||
-                            c == 'G' || c == 'f' || c == 's' || c == 'u') {
-                            in_ansi = false;
-                            break;
-                        }
-                    }
+                bool tracked;
+                in_ansi = !consume_escape(command_text, text_len, &i, &style,
+                                          &tracked);
+                if (!tracked) {
+                    buffer->inexact = true;
                 }
                 continue;
             }
@@ -704,6 +918,8 @@ void screen_buffer_render_with_continuation(
 
             // Handle tabs
             if (ch == '\t') {
+                // Terminal tab stops may differ from tab_width
+                buffer->inexact = true;
                 int tw = config.tab_width > 0 ? config.tab_width : 4;
                 size_t tab_width = tw - (col % tw);
                 col += tab_width;
@@ -729,7 +945,8 @@ void screen_buffer_render_with_continuation(
 
                 if (visual_width > 0) {
                     write_char_to_buffer(buffer, command_text + i, char_bytes,
-                                         visual_width, false, &row, &col);
+                                         visual_width, false, &style, &row,
+                                         &col);
 
                     if (visual_width == 2) {
                         col++;
@@ -741,11 +958,14 @@ void screen_buffer_render_with_continuation(
                             }
                         }
                     }
+                } else {
+                    buffer->inexact = true;
                 }
 
                 i += char_bytes;
                 bytes_processed += char_bytes;
             } else {
+                buffer->inexact = true;
                 i++;
                 bytes_processed++;
             }
@@ -1113,3 +1333,411 @@ size_t screen_buffer_calculate_visual_width(const char *text,
 
     return visual_width;
 }
+
+// ============================================================================
+// DIFFERENTIAL RENDERING
+// ============================================================================
+
+/* Unchanged cells a run may bridge before a cursor jump is cheaper */
+#define DIFF_MIN_GAP 8
+
+int screen_buffer_add_ghost_text(screen_buffer_t *buffer, const char *text) {
+    if (!buffer || !text)
+        return -1;
+
+    /* Matches the ESC[90m ... ESC[0m the display writes suggestions with */
+    screen_style_t style = {.fg = SCREEN_COLOR_BASIC | 8};
+    int row = buffer->command_end_row;
+    int col = buffer->command_end_col;
+    size_t i = 0;
+    size_t text_len = strlen(text);
+
+    while (i < text_len && row < SCREEN_BUFFER_MAX_ROWS) {
+        uint32_t codepoint;
+        int char_bytes =
+            lle_utf8_decode_codepoint(text + i, text_len - i, &codepoint);
+        if (char_bytes <= 0 || codepoint < 32) {
+            buffer->inexact = true;
+            i++;
+            continue;
+        }
+
+        int visual_width = lle_utf8_codepoint_width(codepoint);
+        if (visual_width > 0) {
+            write_char_to_buffer(buffer, text + i, char_bytes, visual_width,
+                                 false, &style, &row, &col);
+            if (visual_width == 2)
+                col++;
+        } else {
+            buffer->inexact = true;
+        }
+        i += char_bytes;
+    }
+
+    buffer->ghost_text_lines = row - buffer->command_end_row;
+    buffer->total_display_rows = buffer->num_rows;
+    return buffer->ghost_text_lines;
+}
+
+/**
+ * Terminal state tracked while generating a differential update
+ */
+typedef struct {
+    output_frame_t *frame;
+    int width;            // Terminal width
+    int row;              // Cursor row
+    int col;              // Cursor column, -1 if unknown (pending wrap)
+    int last_row;         // Last row known to exist on the terminal
+    screen_style_t style; // SGR state last emitted
+    bool style_known;     // False until the first SGR is emitted
+} diff_state_t;
+
+static const screen_cell_t blank_cell = {{0}, 0, 0, false, {0, 0, 0}};
+static const screen_style_t default_style = {0, 0, 0};
+
+static bool style_equal(const screen_style_t *a, const screen_style_t *b) {
+    return a->fg == b->fg && a->bg == b->bg && a->attrs == b->attrs;
+}
+
+/**
+ * @brief Check whether a cell shows nothing (empty, or a plain space)
+ */
+static bool cell_is_blank(const screen_cell_t *cell) {
+    if (cell->byte_len == 0)
+        return true;
+    return cell->byte_len == 1 && cell->utf8_bytes[0] == ' ' &&
+           style_equal(&cell->style, &default_style);
+}
+
+static bool cell_is_wide(const screen_cell_t *cell) {
+    return cell->byte_len > 0 && cell->visual_width == 2;
+}
+
+static bool cells_equal(const screen_cell_t *a, const screen_cell_t *b) {
+    bool a_blank = cell_is_blank(a);
+    bool b_blank = cell_is_blank(b);
+    if (a_blank || b_blank)
+        return a_blank && b_blank;
+    return a->byte_len == b->byte_len && a->visual_width == b->visual_width &&
+           memcmp(a->utf8_bytes, b->utf8_bytes, a->byte_len) == 0 &&
+           style_equal(&a->style, &b->style);
+}
+
+/**
+ * @brief Get a cell of a line, treating a missing line as blank
+ */
+static const screen_cell_t *line_cell(const screen_line_t *line, int col) {
+    if (!line || col < 0 || col >= SCREEN_BUFFER_MAX_COLS)
+        return &blank_cell;
+    return &line->cells[col];
+}
+
+/**
+ * @brief Column just past the last visible cell of a line
+ */
+static int line_extent(const screen_line_t *line) {
+    if (!line)
+        return 0;
+
+    int length =
+        line->length < SCREEN_BUFFER_MAX_COLS ? line->length
+                                              : SCREEN_BUFFER_MAX_COLS;
+    for (int col = length - 1; col >= 0; col--) {
+        const screen_cell_t *cell = &line->cells[col];
+        if (!cell_is_blank(cell))
+            return col + (cell->visual_width == 2 ? 2 : 1);
+    }
+    return 0;
+}
+
+static const screen_line_prefix_t *line_prefix(const screen_line_t *line) {
+    return line && line->prefix && line->prefix->text ? line->prefix : NULL;
+}
+
+/**
+ * @brief Append the SGR parameters selecting a color
+ * @param out Output buffer
+ * @param size Size of out
+ * @param color Encoded color (not default)
+ * @param base 30 for foreground, 40 for background
+ * @return Number of characters written
+ */
+static int format_color(char *out, size_t size, uint32_t color, int base) {
+    uint32_t value = color & SCREEN_COLOR_VALUE_MASK;
+    switch (color & SCREEN_COLOR_KIND_MASK) {
+    case SCREEN_COLOR_BASIC:
+        return snprintf(out, size, ";%d",
+                        value < 8 ? base + (int)value
+                                  : base + 60 + (int)value - 8);
+    case SCREEN_COLOR_INDEXED:
+        return snprintf(out, size, ";%d;5;%u", base + 8, value);
+    case SCREEN_COLOR_RGB:
+        return snprintf(out, size, ";%d;2;%u;%u;%u", base + 8,
+                        (value >> 16) & 0xFF, (value >> 8) & 0xFF,
+                        value & 0xFF);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Emit SGR to switch to a style, unless it is already in effect
+ */
+static void diff_set_style(diff_state_t *s, const screen_style_t *style) {
+    if (s->style_known && style_equal(&s->style, style))
+        return;
+
+    static const struct {
+        uint8_t attr;
+        char code;
+    } attr_codes[] = {
+        {SCREEN_ATTR_BOLD, '1'},    {SCREEN_ATTR_DIM, '2'},
+        {SCREEN_ATTR_ITALIC, '3'},  {SCREEN_ATTR_UNDERLINE, '4'},
+        {SCREEN_ATTR_BLINK, '5'},   {SCREEN_ATTR_REVERSE, '7'},
+        {SCREEN_ATTR_HIDDEN, '8'},  {SCREEN_ATTR_STRIKE, '9'},
+    };
+
+    /* Always start from a reset so no attribute can leak through */
+    char sgr[80] = "\033[0";
+    size_t len = 3;
+    for (size_t i = 0; i < sizeof(attr_codes) / sizeof(attr_codes[0]); i++) {
+        if (style->attrs & attr_codes[i].attr) {
+            sgr[len++] = ';';
+            sgr[len++] = attr_codes[i].code;
+        }
+    }
+    len += (size_t)format_color(sgr + len, sizeof(sgr) - len, style->fg, 30);
+    len += (size_t)format_color(sgr + len, sizeof(sgr) - len, style->bg, 40);
+    sgr[len++] = 'm';
+
+    output_frame_append(s->frame, sgr, len);
+    s->style = *style;
+    s->style_known = true;
+}
+
+/**
+ * @brief Move the cursor with relative motion and absolute columns
+ *
+ * Rows below the last one known to exist are reached with newlines, which
+ * scroll the terminal when the display grows past the bottom.
+ */
+static void diff_move_to(diff_state_t *s, int row, int col) {
+    if (row < s->row) {
+        output_frame_appendf(s->frame, "\033[%dA", s->row - row);
+        s->row = row;
+    } else if (row > s->row) {
+        int existing = (row < s->last_row ? row : s->last_row) - s->row;
+        if (existing > 0) {
+            output_frame_appendf(s->frame, "\033[%dB", existing);
+            s->row += existing;
+        }
+        if (s->row < row) {
+            /* New lines take the current background; scroll with none */
+            diff_set_style(s, &default_style);
+            while (s->row < row) {
+                output_frame_append(s->frame, "\n", 1);
+                s->row++;
+            }
+            s->col = -1;
+            s->last_row = row;
+        }
+    }
+
+    if (s->col != col) {
+        output_frame_appendf(s->frame, "\033[%dG", col + 1);
+        s->col = col;
+    }
+}
+
+/**
+ * @brief Paint cells [from, to) of a line
+ */
+static void diff_paint(diff_state_t *s, const screen_line_t *line, int row,
+                       int from, int to) {
+    diff_move_to(s, row, from);
+
+    for (int col = from; col < to; col++) {
+        const screen_cell_t *cell = line_cell(line, col);
+
+        /* The right half of a wide character was drawn with it */
+        if (col > from && cell->byte_len == 0 &&
+            cell_is_wide(line_cell(line, col - 1))) {
+            continue;
+        }
+
+        if (cell->byte_len == 0) {
+            diff_set_style(s, &default_style);
+            output_frame_append(s->frame, " ", 1);
+            s->col++;
+        } else {
+            diff_set_style(s, &cell->style);
+            output_frame_append(s->frame, cell->utf8_bytes, cell->byte_len);
+            s->col += cell->visual_width;
+        }
+
+        /* Writing the last column leaves the cursor pending a wrap */
+        if (s->col >= s->width)
+            s->col = -1;
+    }
+}
+
+/**
+ * @brief Erase a row from a column to its end
+ */
+static void diff_clear_tail(diff_state_t *s, int row, int col) {
+    if (col >= s->width)
+        return;
+    diff_move_to(s, row, col);
+    diff_set_style(s, &default_style);
+    output_frame_append_str(s->frame, "\033[K");
+}
+
+/**
+ * @brief Update one row from its old contents to its new contents
+ */
+static void diff_row(diff_state_t *s, const screen_line_t *old_line,
+                     const screen_line_t *new_line, int row) {
+    const screen_line_prefix_t *old_prefix = line_prefix(old_line);
+    const screen_line_prefix_t *new_prefix = line_prefix(new_line);
+    int old_extent = line_extent(old_line);
+    int new_extent = line_extent(new_line);
+
+    bool prefix_changed =
+        (old_prefix == NULL) != (new_prefix == NULL) ||
+        (old_prefix && strcmp(old_prefix->text, new_prefix->text) != 0);
+
+    if (prefix_changed) {
+        /* Continuation prompt changed: repaint the whole row */
+        int old_end = old_prefix && (int)old_prefix->visual_width > old_extent
+                          ? (int)old_prefix->visual_width
+                          : old_extent;
+        int from = 0;
+
+        diff_move_to(s, row, 0);
+        if (new_prefix) {
+            diff_set_style(s, &default_style);
+            output_frame_append(s->frame, new_prefix->text,
+                                new_prefix->length);
+            if (new_prefix->contains_ansi)
+                s->style_known = false;
+            from = (int)new_prefix->visual_width;
+            s->col = from < s->width ? from : -1;
+        }
+
+        int end = new_extent > from ? new_extent : from;
+        if (end > from)
+            diff_paint(s, new_line, row, from, end);
+        if (old_end > end)
+            diff_clear_tail(s, row, end);
+        return;
+    }
+
+    int span = old_extent > new_extent ? old_extent : new_extent;
+    int col = 0;
+    while (col < span) {
+        if (cells_equal(line_cell(old_line, col), line_cell(new_line, col))) {
+            col++;
+            continue;
+        }
+
+        /* Extend the run over short stretches of unchanged cells */
+        int start = col;
+        int end = col + 1;
+        int gap = 0;
+        for (col++; col < span; col++) {
+            if (!cells_equal(line_cell(old_line, col),
+                             line_cell(new_line, col))) {
+                end = col + 1;
+                gap = 0;
+            } else if (++gap >= DIFF_MIN_GAP) {
+                break;
+            }
+        }
+
+        /* Never start on the right half of a wide character */
+        if (start > 0 && (cell_is_wide(line_cell(old_line, start - 1)) ||
+                          cell_is_wide(line_cell(new_line, start - 1)))) {
+            start--;
+        }
+
+        if (end > new_extent) {
+            /* The rest of the row is blank now: paint up to it and erase */
+            if (new_extent > start)
+                diff_paint(s, new_line, row, start, new_extent);
+            diff_clear_tail(s, row, new_extent > start ? new_extent : start);
+            return;
+        }
+        diff_paint(s, new_line, row, start, end);
+    }
+}
+
+bool screen_buffer_render_diff(const screen_buffer_t *old_screen,
+                               const screen_buffer_t *new_screen,
+                               output_frame_t *frame) {
+    if (!old_screen || !new_screen || !frame)
+        return false;
+
+    if (old_screen->inexact || new_screen->inexact ||
+        old_screen->terminal_width != new_screen->terminal_width ||
+        old_screen->terminal_width > SCREEN_BUFFER_MAX_COLS ||
+        old_screen->command_start_row != new_screen->command_start_row ||
+        old_screen->command_start_col != new_screen->command_start_col) {
+        return false;
+    }
+
+    /* Rows past the buffer were never stored */
+    if (old_screen->num_rows < 1 ||
+        old_screen->num_rows > SCREEN_BUFFER_MAX_ROWS ||
+        new_screen->num_rows < 1 ||
+        new_screen->num_rows > SCREEN_BUFFER_MAX_ROWS) {
+        return false;
+    }
+
+    /* The prompt is written once and never repainted from cells */
+    for (int row = 0; row <= new_screen->command_start_row; row++) {
+        const screen_line_t *old_line = &old_screen->lines[row];
+        const screen_line_t *new_line = &new_screen->lines[row];
+        for (int col = 0; col < SCREEN_BUFFER_MAX_COLS; col++) {
+            const screen_cell_t *a = &old_line->cells[col];
+            const screen_cell_t *b = &new_line->cells[col];
+            if ((a->is_prompt || b->is_prompt) &&
+                (a->is_prompt != b->is_prompt || !cells_equal(a, b))) {
+                return false;
+            }
+            if (col >= old_line->length && col >= new_line->length)
+                break;
+        }
+    }
+
+    int width = new_screen->terminal_width;
+    diff_state_t s = {
+        .frame = frame,
+        .width = width,
+        .row = old_screen->cursor_row,
+        .col = old_screen->cursor_col < width ? old_screen->cursor_col : -1,
+        .last_row = old_screen->num_rows - 1,
+        .style_known = false,
+    };
+
+    for (int row = 0; row < new_screen->num_rows; row++) {
+        const screen_line_t *old_line =
+            row < old_screen->num_rows ? &old_screen->lines[row] : NULL;
+        diff_row(&s, old_line, &new_screen->lines[row], row);
+    }
+
+    /* Rows no longer used */
+    if (new_screen->num_rows < old_screen->num_rows) {
+        diff_move_to(&s, new_screen->num_rows, 0);
+        diff_set_style(&s, &default_style);
+        output_frame_append_str(frame, "\033[J");
+    }
+
+    int cursor_col =
+        new_screen->cursor_col < width ? new_screen->cursor_col : width - 1;
+    diff_move_to(&s, new_screen->cursor_row, cursor_col);
+
+    if (s.style_known && !style_equal(&s.style, &default_style))
+        output_frame_append_str(frame, "\033[0m");
+
+    return true;
+}
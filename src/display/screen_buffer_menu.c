@@ -16,6 +16,7 @@
  */
 
 #include "display/screen_buffer.h"
+#include "lle/utf8_support.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -207,6 +208,7 @@ int screen_buffer_add_text_rows(screen_buffer_t *buffer, int start_row,
     size_t i = 0;
     size_t text_len = strlen(text);
     int rows_added = 0;
+    screen_style_t style = {0};
 
     /* Ensure we have at least the starting row */
     if (current_row >= buffer->num_rows) {
@@ -216,20 +218,28 @@ int screen_buffer_add_text_rows(screen_buffer_t *buffer, int start_row,
     while (i < text_len && current_row < SCREEN_BUFFER_MAX_ROWS) {
         unsigned char ch = (unsigned char)text[i];
 
-        /* Handle ANSI escape sequences (skip, take 0 columns) */
+        /* Handle ANSI escape sequences (take 0 columns, SGR is tracked) */
         if (ch == '\033' || ch == '\x1b') {
             i++;
+            bool tracked = false;
             if (i < text_len && text[i] == '[') {
                 i++;
+                size_t params_start = i;
                 while (i < text_len) {
                     char c = text[i++];
-                    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-                        c == 'm' || c == 'H' || c == 'J' || c == 'K' ||
-                        c == 'G') {
+                    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+                        if (c == 'm') {
+                            tracked = screen_style_apply_sgr(
+                                &style, text + params_start,
+                                i - 1 - params_start);
+                        }
                         break;
                     }
                 }
             }
+            if (!tracked) {
+                buffer->inexact = true;
+            }
             continue;
         }
 
@@ -252,25 +262,21 @@ int screen_buffer_add_text_rows(screen_buffer_t *buffer, int start_row,
         }
 
         /* Handle regular characters - calculate visual width */
-        int char_bytes = 1;
-        int visual_width = 1;
-
-        if ((ch & 0x80) == 0) {
-            /* ASCII - 1 byte, 1 column */
-            char_bytes = 1;
-            visual_width = 1;
-        } else if ((ch & 0xE0) == 0xC0) {
-            /* 2-byte UTF-8 */
-            char_bytes = 2;
-            visual_width = 1;
-        } else if ((ch & 0xF0) == 0xE0) {
-            /* 3-byte UTF-8 (often CJK - 2 columns) */
-            char_bytes = 3;
-            visual_width = 2;
-        } else if ((ch & 0xF8) == 0xF0) {
-            /* 4-byte UTF-8 (emoji - usually 2 columns) */
-            char_bytes = 4;
-            visual_width = 2;
+        uint32_t codepoint;
+        int char_bytes =
+            lle_utf8_decode_codepoint(text + i, text_len - i, &codepoint);
+        if (char_bytes <= 0 || codepoint < 32) {
+            /* Control bytes and invalid UTF-8 are not stored */
+            buffer->inexact = true;
+            i++;
+            continue;
+        }
+        int visual_width = lle_utf8_codepoint_width(codepoint);
+        if (visual_width <= 0) {
+            /* Zero-width marks have no cell of their own */
+            buffer->inexact = true;
+            i += char_bytes;
+            continue;
         }
 
         /* Check for line wrapping before writing */
@@ -305,6 +311,7 @@ int screen_buffer_add_text_rows(screen_buffer_t *buffer, int start_row,
             cell->byte_len = (uint8_t)char_bytes;
             cell->visual_width = (uint8_t)visual_width;
             cell->is_prompt = false;
+            cell->style = style;
 
             if (col >= buffer->lines[current_row].length) {
                 buffer->lines[current_row].length = col + 1;
@@ -1065,6 +1065,15 @@ bool display_integration_get_stats(display_integration_stats_t *stats) {
             stats->memory_usage_bytes =
                 controller_perf.cache_memory_usage_bytes;
         }
+
+        output_frame_stats_t output;
+        if (display_controller_get_output_stats(global_display_controller,
+                                                &output) ==
+            DISPLAY_CONTROLLER_SUCCESS) {
+            stats->output_frames = output.frames;
+            stats->output_bytes = output.bytes;
+            stats->output_syscalls = output.syscalls;
+        }
     }
 
     // Calculate health indicators
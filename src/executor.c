@@ -17,8 +17,11 @@
 #include "arithmetic.h"
 #include "autocorrect.h"
 #include "builtins.h"
+#include "command_hash.h"
 #include "config.h"
 #include "debug.h"
+#include "glob_pattern.h"
+#include "globstar.h"
 #include "ht.h"
 #include "init.h"
 #include "lle/lle_shell_event_hub.h"
@@ -35,10 +38,10 @@
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <fnmatch.h>
 #include <glob.h>
 #include <pwd.h>
 #include <regex.h>
+#include <spawn.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -58,12 +61,17 @@ executor_t *current_executor = NULL;
 static int execute_node(executor_t *executor, node_t *node);
 static int execute_command(executor_t *executor, node_t *command);
 static int execute_pipeline(executor_t *executor, node_t *pipeline);
+static int dispatch_node(executor_t *executor, node_t *node);
+static bool sets_pipestatus(node_type_t type);
+static bool errexit_applies(const executor_t *executor, int status);
+static void set_pipestatus_single(int status);
 static int execute_function_definition(executor_t *executor, node_t *function);
-static int execute_function_call(executor_t *executor,
-                                 const char *function_name, char **argv,
-                                 int argc);
-static bool is_function_defined(executor_t *executor,
-                                const char *function_name);
+static int execute_function_call(executor_t *executor, function_def_t *func,
+                                 char **argv, int argc);
+static int call_function(executor_t *executor, function_def_t *func,
+                         char **argv, int argc);
+static function_def_t *resolve_function(executor_t *executor,
+                                        const node_t *site, const char *name);
 static function_def_t *find_function(executor_t *executor,
                                      const char *function_name);
 static int store_function(executor_t *executor, const char *function_name,
@@ -137,8 +145,7 @@ static void initialize_job_control(executor_t *executor);
 static char *expand_arithmetic(executor_t *executor, const char *arith_text);
 static char *expand_command_substitution(executor_t *executor,
                                          const char *cmd_text);
-static node_t *copy_node_simple(node_t *original);
-static void copy_function_definitions(executor_t *dest, executor_t *src);
+static void share_function_definitions(executor_t *dest, executor_t *src);
 char *expand_if_needed(executor_t *executor, const char *text);
 static char *expand_quoted_string(executor_t *executor, const char *str);
 static char *expand_ansi_c_string(const char *str, size_t len);
@@ -270,6 +277,9 @@ executor_t *executor_new(void) {
     executor->error_message = NULL;
     executor->has_error = false;
     executor->functions = NULL;
+    executor->function_count = 0;
+    executor->function_generation = 1;
+    memset(executor->call_sites, 0, sizeof(executor->call_sites));
     executor->current_script_file = NULL;
     executor->current_script_line = 0;
     executor->in_script_execution = false;
@@ -278,6 +288,8 @@ executor_t *executor_new(void) {
     executor->loop_control = LOOP_NORMAL;
     executor->loop_depth = 0;
     executor->source_depth = 0;
+    executor->source_return = false;
+    executor->errexit_ignored = false;
 
     /* Initialize error context stack (Phase 3) */
     executor->context_depth = 0;
@@ -291,6 +303,11 @@ executor_t *executor_new(void) {
     memset(executor->procsub_fds, -1, sizeof(executor->procsub_fds));
     memset(executor->procsub_pids, 0, sizeof(executor->procsub_pids));
 
+    executor->exec_in_place = false;
+    executor->spawn_count = 0;
+    executor->fork_count = 0;
+    executor->parse_arena = NULL;
+
     initialize_job_control(executor);
 
     return executor;
@@ -317,6 +334,9 @@ executor_t *executor_new_with_symtable(symtable_manager_t *symtable) {
     executor->error_message = NULL;
     executor->has_error = false;
     executor->functions = NULL;
+    executor->function_count = 0;
+    executor->function_generation = 1;
+    memset(executor->call_sites, 0, sizeof(executor->call_sites));
     executor->current_script_file = NULL;
     executor->current_script_line = 0;
     executor->in_script_execution = false;
@@ -325,6 +345,8 @@ executor_t *executor_new_with_symtable(symtable_manager_t *symtable) {
     executor->loop_control = LOOP_NORMAL;
     executor->loop_depth = 0;
     executor->source_depth = 0;
+    executor->source_return = false;
+    executor->errexit_ignored = false;
 
     /* Initialize error context stack (Phase 3) */
     executor->context_depth = 0;
@@ -338,6 +360,11 @@ executor_t *executor_new_with_symtable(symtable_manager_t *symtable) {
     memset(executor->procsub_fds, -1, sizeof(executor->procsub_fds));
     memset(executor->procsub_pids, 0, sizeof(executor->procsub_pids));
 
+    executor->exec_in_place = false;
+    executor->spawn_count = 0;
+    executor->fork_count = 0;
+    executor->parse_arena = NULL;
+
     initialize_job_control(executor);
 
     return executor;
@@ -355,15 +382,9 @@ void executor_free(executor_t *executor) {
     if (executor) {
         // Don't free global symtable - it's managed globally
 
-        // Free function table
-        function_def_t *func = executor->functions;
-        while (func) {
-            function_def_t *next = func->next;
-            free(func->name);
-            free_node_tree(func->body);
-            free_function_params(func->params);
-            free(func);
-            func = next;
+        // Release this executor's references to its functions
+        if (executor->functions) {
+            ht_destroy(executor->functions);
         }
 
         // Free script context
@@ -372,6 +393,8 @@ void executor_free(executor_t *executor) {
         /* Free error context stack (Phase 3) */
         executor_clear_context(executor);
 
+        lle_arena_destroy(executor->parse_arena);
+
         free(executor);
     }
 }
@@ -758,12 +781,34 @@ int executor_execute(executor_t *executor, node_t *ast) {
     }
 }
 
+/**
+ * @brief Get the executor's parse arena, creating it on first use
+ *
+ * Chunks are sized to fill exactly one XLARGE memory pool block.
+ *
+ * @param executor Executor context
+ * @return Parse arena, or NULL if it could not be created (parsing then
+ *         falls back to the heap)
+ */
+static lle_arena_t *get_parse_arena(executor_t *executor) {
+    if (!executor->parse_arena) {
+        executor->parse_arena = lle_arena_create(
+            NULL, "parse", 16384 - sizeof(lle_arena_chunk_t));
+    }
+    return executor->parse_arena;
+}
+
 /**
  * @brief Parse and execute a command line string
  *
  * Parses the input string into an AST and executes it. Handles syntax
  * check mode (set -n) where commands are parsed but not executed.
  *
+ * Tokens and AST nodes come from the executor's parse arena. Each call
+ * opens a scratch scope on it and closes the scope once the command has
+ * run, so nested calls (eval, source, traps) stack on top of the caller's
+ * tree and the outermost call leaves the arena empty again.
+ *
  * @param executor Executor context
  * @param input Shell command string to parse and execute
  * @return Exit status of executed command, or error code
@@ -802,9 +847,12 @@ int executor_execute_command_line(executor_t *executor, const char *input) {
     const char *source_name = executor->current_script_file 
                               ? executor->current_script_file 
                               : "<stdin>";
-    parser_t *parser = parser_new_with_source(parse_input, source_name);
+    lle_arena_t *arena = get_parse_arena(executor);
+    lle_arena_scratch_t parse_scope = lle_arena_scratch_begin(arena);
+    parser_t *parser = parser_new_in_arena(parse_input, source_name, arena);
     if (!parser) {
         set_executor_error(executor, "Failed to create parser");
+        lle_arena_scratch_end(&parse_scope);
         free(processed_input);
         return 1;
     }
@@ -822,10 +870,12 @@ int executor_execute_command_line(executor_t *executor, const char *input) {
                 set_executor_error(executor, legacy_err);
             }
             parser_free(parser);
+            lle_arena_scratch_end(&parse_scope);
             free(processed_input);
             return 2; // Syntax error
         }
         parser_free(parser);
+        lle_arena_scratch_end(&parse_scope);
         free(processed_input);
         return 0; // Syntax check successful
     }
@@ -839,12 +889,14 @@ int executor_execute_command_line(executor_t *executor, const char *input) {
             set_executor_error(executor, legacy_err);
         }
         parser_free(parser);
+        lle_arena_scratch_end(&parse_scope);
         free(processed_input);
         return 1;
     }
 
     if (!ast) {
         parser_free(parser);
+        lle_arena_scratch_end(&parse_scope);
         free(processed_input);
         return 0; // Empty command
     }
@@ -853,11 +905,87 @@ int executor_execute_command_line(executor_t *executor, const char *input) {
 
     free_node_tree(ast);
     parser_free(parser);
+    lle_arena_scratch_end(&parse_scope);
     free(processed_input);
 
     return result;
 }
 
+script_ast_t *executor_load_script(const char *path, bool persistent) {
+    if (!config.script_parse_whole || shell_opts.verbose) {
+        return NULL;
+    }
+    int flags = config.script_ast_cache ? SCRIPT_CACHE_MEMORY : 0;
+    if (persistent && config.script_parse_cache && !shell_opts.no_parse_cache) {
+        flags |= SCRIPT_CACHE_DISK;
+    }
+    return script_ast_load(path, flags);
+}
+
+int executor_execute_script(executor_t *executor, const script_ast_t *script,
+                            off_t *resume) {
+    *resume = -1;
+    if (!executor) {
+        return 1;
+    }
+
+    int result = 0;
+    bool check_mode = true;
+    for (node_t *command = script_ast_commands(script); command;
+         command = command->next_sibling) {
+        if (executor->source_return) {
+            break;
+        }
+        if (command->loc.line > 0) {
+            executor->current_script_line = (int)command->loc.line;
+        }
+
+        executor->has_error = false;
+        executor->error_message = NULL;
+        int status = execute_node(executor, command);
+        executor->exit_status = status;
+
+        fflush(stdout);
+        fflush(stderr);
+        if (executor->has_error && executor->error_message) {
+            fprintf(stderr, "lush: %s\n", executor->error_message);
+            fflush(stderr);
+        }
+
+        // exit ends the script with its own status
+        if (exit_flag) {
+            result = last_exit_status;
+            break;
+        }
+
+        // Return from a sourced script (exit code 200+)
+        if (status >= 200 && status <= 455) {
+            result = status - 200;
+            executor->source_return = true;
+            break;
+        }
+
+        set_exit_status(status);
+        result = status;
+        if (errexit_applies(executor, status)) {
+            break;
+        }
+
+        // A shell mode change can make the rest of the file parse
+        // differently; hand it back to the construct reader
+        if (check_mode && command->next_sibling &&
+            !script_ast_mode_current(script)) {
+            *resume = script_ast_command_offset(script, command->next_sibling);
+            if (*resume >= 0) {
+                break;
+            }
+            check_mode = false;
+        }
+    }
+
+    return result;
+}
+
 /**
  * @brief Core node execution dispatcher
  *
@@ -913,6 +1041,72 @@ static int execute_node(executor_t *executor, node_t *node) {
         }
     }
 
+    executor->errexit_ignored = false;
+    int result = dispatch_node(executor, node);
+    if (node->type == NODE_COMMAND) {
+        // A function call fails on its own account, however its body ended
+        executor->errexit_ignored = false;
+    }
+    if (sets_pipestatus(node->type)) {
+        set_pipestatus_single(result);
+    }
+    return result;
+}
+
+/**
+ * @brief Check whether set -e stops execution after a command
+ *
+ * Failures of AND-OR list members other than the last one and of negated
+ * pipelines are exempt, as are compound commands whose status comes from
+ * such a failure.
+ *
+ * @param executor Executor context
+ * @param status Exit status of the command just executed
+ * @return true if execution should stop
+ */
+static bool errexit_applies(const executor_t *executor, int status) {
+    return shell_opts.exit_on_error && status != 0 &&
+           !executor->errexit_ignored;
+}
+
+/**
+ * @brief Check whether a node type is a single pipeline element
+ *
+ * Simple and compound commands are one-stage pipelines and record their own
+ * status in PIPESTATUS. Pipelines record all of their stages themselves, and
+ * lists, negation, time and background jobs leave it to the pipelines they
+ * contain.
+ *
+ * @param type Node type
+ * @return true if PIPESTATUS should hold the node's status afterwards
+ */
+static bool sets_pipestatus(node_type_t type) {
+    switch (type) {
+    case NODE_PIPE:
+    case NODE_NEGATE:
+    case NODE_TIME:
+    case NODE_BACKGROUND:
+    case NODE_COPROC:
+    case NODE_LOGICAL_AND:
+    case NODE_LOGICAL_OR:
+    case NODE_COMMAND_LIST:
+    case NODE_VAR:
+    case NODE_ARRAY_LITERAL:
+    case NODE_ARRAY_ACCESS:
+        return false;
+    default:
+        return true;
+    }
+}
+
+/**
+ * @brief Run the handler for a node's type
+ *
+ * @param executor Executor context
+ * @param node Node to execute
+ * @return Exit status of the node
+ */
+static int dispatch_node(executor_t *executor, node_t *node) {
     switch (node->type) {
     case NODE_COMMAND: {
         int result = execute_command(executor, node);
@@ -1017,8 +1211,9 @@ static int execute_command_list(executor_t *executor, node_t *list) {
 
         last_result = execute_node(executor, current);
 
-        // Check for loop control (break/continue) - stop executing list
-        if (executor->loop_control != LOOP_NORMAL) {
+        // Check for loop control (break/continue) or exit - stop executing
+        // list
+        if (executor->loop_control != LOOP_NORMAL || exit_flag) {
             return last_result;
         }
 
@@ -1033,7 +1228,7 @@ static int execute_command_list(executor_t *executor, node_t *list) {
         }
 
         // Handle set -e (exit_on_error): exit if command failed
-        if (shell_opts.exit_on_error && last_result != 0) {
+        if (errexit_applies(executor, last_result)) {
             executor->exit_status = last_result;
             return last_result;
         }
@@ -1070,6 +1265,12 @@ static int execute_command(executor_t *executor, node_t *command) {
     executor->expansion_error = false;
     executor->expansion_exit_status = 0;
 
+    // A pipeline stage may exec this command in place, but only if it turns
+    // out to be a plain external command; functions and builtins run their
+    // own commands and must never inherit the request.
+    bool exec_in_place = executor->exec_in_place;
+    executor->exec_in_place = false;
+
     // Check for assignment
     if (command->val.str && is_assignment(command->val.str)) {
         return execute_assignment(executor, command->val.str);
@@ -1290,9 +1491,11 @@ static int execute_command(executor_t *executor, node_t *command) {
         }
     }
 
-    if (is_function_defined(executor, filtered_argv[0])) {
-        result = execute_function_call(executor, filtered_argv[0],
-                                       filtered_argv, filtered_argc);
+    function_def_t *func =
+        resolve_function(executor, command, filtered_argv[0]);
+    if (func) {
+        result = execute_function_call(executor, func, filtered_argv,
+                                       filtered_argc);
     } else if (is_builtin_command(filtered_argv[0])) {
         // For builtin commands with stdout redirections, check if stdout is
         // captured. Only fork for "pure" builtins that don't modify shell state.
@@ -1431,10 +1634,10 @@ static int execute_command(executor_t *executor, node_t *command) {
                                                                  filtered_argv);
                                 fflush(stdout);
                                 fflush(stderr);
-                            } else if (is_function_defined(executor,
-                                                           filtered_argv[0])) {
+                            } else if ((func = find_function(
+                                            executor, filtered_argv[0]))) {
                                 result = execute_function_call(
-                                    executor, filtered_argv[0], filtered_argv,
+                                    executor, func, filtered_argv,
                                     filtered_argc);
                             } else {
                                 // Execute the corrected external command
@@ -1461,6 +1664,7 @@ static int execute_command(executor_t *executor, node_t *command) {
                 }
             } else {
                 // Auto-correction disabled, execute normally
+                executor->exec_in_place = exec_in_place;
                 result = execute_external_command_with_setup(
                     executor, filtered_argv, redirect_stderr, command);
             }
@@ -1498,12 +1702,61 @@ static int execute_command(executor_t *executor, node_t *command) {
     return result;
 }
 
+/**
+ * @brief One stage of a flattened pipeline
+ */
+typedef struct pipeline_stage {
+    node_t *node;     // Stage command node
+    bool pipe_stderr; // |& - stderr joins the stage's output pipe
+    pid_t pid;        // Child PID (0 if never forked)
+    int status;       // Exit status once reaped
+} pipeline_stage_t;
+
+/**
+ * @brief Record the stage statuses of the last pipeline in PIPESTATUS
+ *
+ * @param stages Pipeline stages
+ * @param nstages Number of stages
+ */
+static void set_pipestatus(const pipeline_stage_t *stages, size_t nstages) {
+    array_value_t *array = symtable_array_create(false);
+    if (!array) {
+        return;
+    }
+
+    char buf[16];
+    for (size_t i = 0; i < nstages; i++) {
+        snprintf(buf, sizeof(buf), "%d", stages[i].status);
+        symtable_array_set_index(array, (int)i, buf);
+    }
+
+    if (symtable_set_array("PIPESTATUS", array) != 0) {
+        symtable_array_free(array);
+    }
+}
+
+/**
+ * @brief Record the status of a one-stage pipeline in PIPESTATUS
+ *
+ * @param status Exit status of the command
+ */
+static void set_pipestatus_single(int status) {
+    pipeline_stage_t stage = {.status = status};
+    set_pipestatus(&stage, 1);
+}
+
 /**
  * @brief Execute a pipeline of commands
  *
- * Implements a two-command pipeline with proper pipe setup.
- * Supports pipefail mode where failure in any command causes
- * pipeline failure.
+ * Flattens the parser's right-nested NODE_PIPE chain into N stages, creates
+ * all N-1 pipes up front and forks every stage directly from the shell, so
+ * no intermediate shell stays alive waiting on the rest of the chain. A
+ * stage that is a simple external command execs in place in its child.
+ *
+ * When the shell has job control over the terminal, all stages join one
+ * process group (led by the first stage) that owns the terminal while the
+ * pipeline runs; otherwise they stay in the shell's group. All stages are
+ * reaped by a single wait loop and their statuses stored in PIPESTATUS.
  *
  * @param executor Executor context
  * @param pipeline Pipeline node containing commands
@@ -1517,116 +1770,188 @@ static int execute_pipeline(executor_t *executor, node_t *pipeline) {
     // Push error context for structured error reporting
     executor_push_context(executor, pipeline->loc, "in pipeline");
 
-    // For now, implement simple two-command pipeline
-    // A more complete implementation would handle N-command pipelines
-
-    node_t *left = pipeline->first_child;
-    node_t *right = left ? left->next_sibling : NULL;
-
-    if (!left || !right) {
-        executor_error_add(executor, SHELL_ERR_MALFORMED_CONSTRUCT,
-                           pipeline->loc, "malformed pipeline");
-        executor_pop_context(executor);
-        return 1;
+    // Count stages: the parser nests a | b | c as PIPE(a, PIPE(b, c))
+    size_t nstages = 1;
+    for (node_t *node = pipeline; node->type == NODE_PIPE;) {
+        node_t *left = node->first_child;
+        node_t *right = left ? left->next_sibling : NULL;
+        if (!left || !right) {
+            executor_error_add(executor, SHELL_ERR_MALFORMED_CONSTRUCT,
+                               pipeline->loc, "malformed pipeline");
+            executor_pop_context(executor);
+            return 1;
+        }
+        nstages++;
+        node = right;
     }
 
-    int pipe_fd[2];
-    if (pipe(pipe_fd) == -1) {
-        executor_error_add(executor, SHELL_ERR_PIPE_FAILED,
-                           pipeline->loc, "failed to create pipe: %s", strerror(errno));
+    pipeline_stage_t *stages = calloc(nstages, sizeof(pipeline_stage_t));
+    int (*pipes)[2] = malloc((nstages - 1) * sizeof(*pipes));
+    if (!stages || !pipes) {
+        free(stages);
+        free(pipes);
+        executor_error_add(executor, SHELL_ERR_OUT_OF_MEMORY, pipeline->loc,
+                           "failed to allocate pipeline");
         executor_pop_context(executor);
         return 1;
     }
 
-    pid_t left_pid = fork();
-    if (left_pid == -1) {
-        executor_error_add(executor, SHELL_ERR_FORK_FAILED,
-                           pipeline->loc, "failed to fork for pipeline: %s", strerror(errno));
-        close(pipe_fd[0]);
-        close(pipe_fd[1]);
-        executor_pop_context(executor);
-        return 1;
+    size_t count = 0;
+    node_t *node = pipeline;
+    while (node->type == NODE_PIPE) {
+        stages[count].node = node->first_child;
+        stages[count].pipe_stderr =
+            node->val_type == VAL_SINT && node->val.sint == 1;
+        count++;
+        node = node->first_child->next_sibling;
+    }
+    stages[count].node = node;
+
+    size_t npipes = 0;
+    for (; npipes < nstages - 1; npipes++) {
+        if (pipe(pipes[npipes]) == -1) {
+            executor_error_add(executor, SHELL_ERR_PIPE_FAILED, pipeline->loc,
+                               "failed to create pipe: %s", strerror(errno));
+            for (size_t k = 0; k < npipes; k++) {
+                close(pipes[k][0]);
+                close(pipes[k][1]);
+            }
+            free(stages);
+            free(pipes);
+            executor_pop_context(executor);
+            return 1;
+        }
     }
 
-    if (left_pid == 0) {
-        // Left command: write to pipe
-        close(pipe_fd[0]);
-        dup2(pipe_fd[1], STDOUT_FILENO);
-        // Check if |& was used - also redirect stderr to the pipe
-        if (pipeline->val_type == VAL_SINT && pipeline->val.sint == 1) {
-            dup2(pipe_fd[1], STDERR_FILENO);
+    // Only the job-control shell itself, in the foreground, gives the
+    // pipeline its own process group and the terminal
+    bool own_group = shell_opts.job_control && isatty(STDIN_FILENO) &&
+                     getpid() == executor->shell_pgid &&
+                     tcgetpgrp(STDIN_FILENO) == executor->shell_pgid;
+    pid_t pgid = 0;
+
+    // Don't let children inherit (and later re-flush) buffered output
+    fflush(stdout);
+    fflush(stderr);
+
+    size_t forked = 0;
+    for (; forked < nstages; forked++) {
+        pid_t pid = fork();
+        if (pid == -1) {
+            executor_error_add(executor, SHELL_ERR_FORK_FAILED, pipeline->loc,
+                               "failed to fork for pipeline: %s",
+                               strerror(errno));
+            break;
+        }
+
+        if (pid == 0) {
+            size_t i = forked;
+            if (own_group) {
+                setpgid(0, pgid);
+                if (i == 0) {
+                    tcsetpgrp(STDIN_FILENO, getpgrp());
+                }
+            }
+
+            if (i > 0) {
+                dup2(pipes[i - 1][0], STDIN_FILENO);
+            }
+            if (i < nstages - 1) {
+                dup2(pipes[i][1], STDOUT_FILENO);
+                if (stages[i].pipe_stderr) {
+                    dup2(pipes[i][1], STDERR_FILENO);
+                }
+            }
+            for (size_t k = 0; k < npipes; k++) {
+                close(pipes[k][0]);
+                close(pipes[k][1]);
+            }
+
+            executor->exec_in_place = stages[i].node->type == NODE_COMMAND;
+            int result = execute_node(executor, stages[i].node);
+            fflush(stdout);
+            fflush(stderr);
+            subshell_cleanup();
+            _exit(result);
         }
-        close(pipe_fd[1]);
 
-        int result = execute_node(executor, left);
-        fflush(stdout);
-        fflush(stderr);
-        subshell_cleanup();
-        _exit(result);
+        stages[forked].pid = pid;
+        if (own_group) {
+            // Set the group from both sides to avoid racing the child
+            if (pgid == 0) {
+                pgid = pid;
+                setpgid(pid, pgid);
+                tcsetpgrp(STDIN_FILENO, pgid);
+            } else {
+                setpgid(pid, pgid);
+            }
+        }
     }
 
-    pid_t right_pid = fork();
-    if (right_pid == -1) {
-        executor_error_add(executor, SHELL_ERR_FORK_FAILED,
-                           pipeline->loc, "failed to fork for pipeline: %s", strerror(errno));
-        close(pipe_fd[0]);
-        close(pipe_fd[1]);
-        while (waitpid(left_pid, NULL, 0) == -1 && errno == EINTR)
-            ;
-        executor_pop_context(executor);
-        return 1;
+    // Parent: close every pipe end so readers see EOF
+    for (size_t k = 0; k < npipes; k++) {
+        close(pipes[k][0]);
+        close(pipes[k][1]);
     }
+    free(pipes);
 
-    if (right_pid == 0) {
-        // Right command: read from pipe
-        close(pipe_fd[1]);
-        dup2(pipe_fd[0], STDIN_FILENO);
-        close(pipe_fd[0]);
+    // Single wait loop over all stages, retrying on EINTR. With a private
+    // group any stage may be reaped first; otherwise wait on each PID in
+    // turn so unrelated children (background jobs) are left alone.
+    for (size_t reaped = 0; reaped < forked;) {
+        int status;
+        pid_t pid = waitpid(own_group ? -pgid : stages[reaped].pid, &status, 0);
+        if (pid == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
 
-        int result = execute_node(executor, right);
-        fflush(stdout);
-        fflush(stderr);
-        subshell_cleanup();
-        _exit(result);
+        for (size_t i = 0; i < forked; i++) {
+            if (stages[i].pid == pid) {
+                // Extract exit codes - handle signal termination
+                stages[i].status =
+                    WIFEXITED(status)
+                        ? WEXITSTATUS(status)
+                        : (WIFSIGNALED(status) ? 128 + WTERMSIG(status) : 1);
+                reaped++;
+                break;
+            }
+        }
     }
 
-    // Parent: close pipes and wait
-    close(pipe_fd[0]);
-    close(pipe_fd[1]);
-
-    int left_status, right_status;
-    // Wait for children, retrying on EINTR (signal interruption)
-    while (waitpid(left_pid, &left_status, 0) == -1 && errno == EINTR)
-        ;
-    while (waitpid(right_pid, &right_status, 0) == -1 && errno == EINTR)
-        ;
-
-    // Extract exit codes - handle signal termination
-    int left_exit =
-        WIFEXITED(left_status)
-            ? WEXITSTATUS(left_status)
-            : (WIFSIGNALED(left_status) ? 128 + WTERMSIG(left_status) : 1);
-    int right_exit =
-        WIFEXITED(right_status)
-            ? WEXITSTATUS(right_status)
-            : (WIFSIGNALED(right_status) ? 128 + WTERMSIG(right_status) : 1);
+    if (own_group) {
+        // Reclaim terminal control for the shell
+        tcsetpgrp(STDIN_FILENO, executor->shell_pgid);
+    }
 
     // Pop error context before returning
     executor_pop_context(executor);
 
-    // Pipefail behavior: return failure if ANY command in pipeline fails
-    if (is_pipefail_enabled()) {
-        if (left_exit != 0) {
-            return left_exit;
-        }
-        if (right_exit != 0) {
-            return right_exit;
+    int result;
+    if (forked < nstages) {
+        result = 1;
+    } else {
+        set_pipestatus(stages, nstages);
+
+        // Standard behavior: exit status of the last command
+        result = stages[nstages - 1].status;
+
+        // Pipefail behavior: first command (left to right) that failed
+        if (is_pipefail_enabled()) {
+            result = 0;
+            for (size_t i = 0; i < nstages; i++) {
+                if (stages[i].status != 0) {
+                    result = stages[i].status;
+                    break;
+                }
+            }
         }
-        return 0;
     }
 
-    // Standard behavior: return exit status of right (last) command
-    return right_exit;
+    free(stages);
+    return result;
 }
 
 /**
@@ -1650,16 +1975,15 @@ static int execute_command_chain(executor_t *executor, node_t *first_command) {
     while (current) {
         last_result = execute_node(executor, current);
 
-        // Check for loop control (break/continue) - stop executing chain
-        if (executor->loop_control != LOOP_NORMAL) {
+        // Check for loop control (break/continue) or exit - stop executing
+        // chain
+        if (executor->loop_control != LOOP_NORMAL || exit_flag) {
             return last_result;
         }
 
         // Handle set -e (exit_on_error): exit if command failed and not part of
         // conditional
-        if (shell_opts.exit_on_error && last_result != 0) {
-            // Don't exit on error for certain contexts (conditionals,
-            // pipelines, etc.) For now, implement basic exit-on-error behavior
+        if (errexit_applies(executor, last_result)) {
             executor->exit_status = last_result;
             return last_result;
         }
@@ -1860,8 +2184,8 @@ static int execute_while(executor_t *executor, node_t *while_node) {
         // Execute body
         last_result = execute_command_chain(executor, body);
 
-        // Check for break/continue
-        if (executor->loop_control == LOOP_BREAK) {
+        // Check for break/continue or exit
+        if (executor->loop_control == LOOP_BREAK || exit_flag) {
             executor->loop_control = LOOP_NORMAL;
             break;
         } else if (executor->loop_control == LOOP_CONTINUE) {
@@ -1955,8 +2279,8 @@ static int execute_until(executor_t *executor, node_t *until_node) {
         // Execute body
         last_result = execute_command_chain(executor, body);
 
-        // Check for break/continue
-        if (executor->loop_control == LOOP_BREAK) {
+        // Check for break/continue or exit
+        if (executor->loop_control == LOOP_BREAK || exit_flag) {
             executor->loop_control = LOOP_NORMAL;
             break;
         } else if (executor->loop_control == LOOP_CONTINUE) {
@@ -2252,8 +2576,8 @@ static int execute_for(executor_t *executor, node_t *for_node) {
             // Execute body
             last_result = execute_command_chain(executor, body);
 
-            // Check for break/continue
-            if (executor->loop_control == LOOP_BREAK) {
+            // Check for break/continue or exit
+            if (executor->loop_control == LOOP_BREAK || exit_flag) {
                 executor->loop_control = LOOP_NORMAL;
                 break;
             } else if (executor->loop_control == LOOP_CONTINUE) {
@@ -2402,8 +2726,8 @@ static int execute_for_arith(executor_t *executor, node_t *for_arith_node) {
         // Execute body
         last_result = execute_command_chain(executor, body);
 
-        // Check for break/continue
-        if (executor->loop_control == LOOP_BREAK) {
+        // Check for break/continue or exit
+        if (executor->loop_control == LOOP_BREAK || exit_flag) {
             executor->loop_control = LOOP_NORMAL;
             break;
         } else if (executor->loop_control == LOOP_CONTINUE) {
@@ -2626,16 +2950,16 @@ static int execute_select(executor_t *executor, node_t *select_node) {
         while (cmd) {
             last_result = execute_node(executor, cmd);
 
-            // Check for break/continue
-            if (executor->loop_control != LOOP_NORMAL) {
+            // Check for break/continue or exit
+            if (executor->loop_control != LOOP_NORMAL || exit_flag) {
                 break;
             }
 
             cmd = cmd->next_sibling;
         }
 
-        // Handle break from body
-        if (executor->loop_control == LOOP_BREAK) {
+        // Handle break or exit from body
+        if (executor->loop_control == LOOP_BREAK || exit_flag) {
             executor->loop_control = LOOP_NORMAL;
             break;
         } else if (executor->loop_control == LOOP_CONTINUE) {
@@ -2913,7 +3237,9 @@ static int execute_logical_and(executor_t *executor, node_t *and_node) {
         return execute_node(executor, right);
     }
 
-    // Left failed, return its exit code without executing right
+    // Left failed, return its exit code without executing right; set -e
+    // ignores it since it is not the last command of the list
+    executor->errexit_ignored = true;
     return left_result;
 }
 
@@ -3851,22 +4177,13 @@ static int execute_external_command_with_redirection(executor_t *executor,
 
     // Check if command exists before forking (for better error messages)
     // Skip this check for path-based commands (containing '/')
-    char *full_path = NULL;
     if (!strchr(argv[0], '/')) {
-        full_path = find_command_in_path(argv[0]);
+        char *full_path = command_hash_lookup(argv[0]);
         if (!full_path) {
             // Command not found - report with suggestions from parent process
             report_command_not_found(executor, argv[0], SOURCE_LOC_UNKNOWN);
             return 127;
         }
-
-        // If hashall is enabled, remember this command's location
-        if (shell_opts.hash_commands) {
-            init_command_hash();
-            if (command_hash) {
-                ht_strstr_insert(command_hash, argv[0], full_path);
-            }
-        }
         free(full_path);
     }
 
@@ -3986,6 +4303,7 @@ static int execute_negate(executor_t *executor, node_t *negate_node) {
     // Invert the exit status: 0 -> 1, non-zero -> 0
     int inverted = (result == 0) ? 1 : 0;
     executor->exit_status = inverted;
+    executor->errexit_ignored = true;
     
     return inverted;
 }
@@ -4047,8 +4365,8 @@ static int execute_brace_group(executor_t *executor, node_t *group) {
             return last_result;
         }
 
-        // Check for loop control (break/continue)
-        if (executor->loop_control != LOOP_NORMAL) {
+        // Check for loop control (break/continue) or exit
+        if (executor->loop_control != LOOP_NORMAL || exit_flag) {
             break;
         }
 
@@ -4355,172 +4673,6 @@ static bool has_zsh_extglob_pattern(const char *pattern) {
     return false;
 }
 
-/**
- * @brief Convert zsh extglob pattern to POSIX extended regex
- * 
- * Converts zsh extended glob syntax to regex:
- *   X#   -> X* (zero or more)
- *   X##  -> X+ (one or more)
- *   (a|b) -> (a|b) (alternation)
- *   [...]# -> [...]* (char class zero or more)
- *   *    -> .* (any chars)
- *   ?    -> . (any single char)
- *   .    -> \. (literal dot)
- * 
- * @param pattern Zsh extglob pattern (without leading ^ if negation)
- * @return Regex pattern (caller must free), or NULL on error
- */
-static char *zsh_extglob_to_regex(const char *pattern) {
-    if (!pattern) return NULL;
-    
-    // Allocate generous buffer
-    size_t max_len = strlen(pattern) * 4 + 10;
-    char *regex = malloc(max_len);
-    if (!regex) return NULL;
-    
-    char *out = regex;
-    *out++ = '^';  // Anchor at start
-    
-    const char *p = pattern;
-    while (*p) {
-        if (*p == '[') {
-            // Character class - copy until ]
-            *out++ = *p++;
-            // Handle negation [^ or [!
-            if (*p == '^' || *p == '!') {
-                *out++ = '^';
-                p++;
-            }
-            // Handle ] as first char (literal)
-            if (*p == ']') {
-                *out++ = *p++;
-            }
-            while (*p && *p != ']') {
-                *out++ = *p++;
-            }
-            if (*p == ']') {
-                *out++ = *p++;
-            }
-            // Check for # or ## after char class
-            if (*p == '#') {
-                if (*(p + 1) == '#') {
-                    *out++ = '+';  // ## = one or more
-                    p += 2;
-                } else {
-                    *out++ = '*';  // # = zero or more
-                    p++;
-                }
-            }
-        } else if (*p == '(') {
-            // Alternation group - copy as-is, handling nested parens
-            *out++ = *p++;
-            int depth = 1;
-            while (*p && depth > 0) {
-                if (*p == '(') {
-                    depth++;
-                    *out++ = *p++;
-                } else if (*p == ')') {
-                    depth--;
-                    *out++ = *p++;
-                } else if (*p == '*') {
-                    // Glob * inside alternation
-                    *out++ = '.';
-                    *out++ = '*';
-                    p++;
-                } else if (*p == '?') {
-                    *out++ = '.';
-                    p++;
-                } else if (*p == '.') {
-                    *out++ = '\\';
-                    *out++ = '.';
-                    p++;
-                } else {
-                    *out++ = *p++;
-                }
-            }
-        } else if (*p == '*') {
-            // Glob * -> regex .*
-            *out++ = '.';
-            *out++ = '*';
-            p++;
-        } else if (*p == '?') {
-            // Glob ? -> regex .
-            *out++ = '.';
-            p++;
-        } else if (*p == '.') {
-            // Escape literal dot
-            *out++ = '\\';
-            *out++ = '.';
-            p++;
-        } else if (*p == '#') {
-            // Standalone # - should not happen if preceded by nothing
-            // Skip it (treat as literal)
-            *out++ = '#';
-            p++;
-        } else {
-            // Regular character
-            char c = *p++;
-            // Check for # or ## quantifier after this char
-            if (*p == '#') {
-                // Need to wrap single char in group for regex
-                // But first, escape regex metacharacters
-                if (strchr("^$+{}\\|()", c)) {
-                    *out++ = '\\';
-                }
-                *out++ = c;
-                if (*(p + 1) == '#') {
-                    *out++ = '+';  // ## = one or more
-                    p += 2;
-                } else {
-                    *out++ = '*';  // # = zero or more
-                    p++;
-                }
-            } else {
-                // No quantifier - regular char, might need escaping
-                if (strchr("^$+{}\\|", c)) {
-                    *out++ = '\\';
-                }
-                *out++ = c;
-            }
-        }
-    }
-    
-    *out++ = '$';  // Anchor at end
-    *out = '\0';
-    
-    return regex;
-}
-
-/**
- * @brief Match filename against zsh extglob pattern
- */
-static bool match_zsh_extglob(const char *filename, const char *pattern, bool is_negated) {
-    char *regex_pattern = zsh_extglob_to_regex(pattern);
-    if (!regex_pattern) {
-        return false;
-    }
-    
-    regex_t regex;
-    int ret = regcomp(&regex, regex_pattern, REG_EXTENDED | REG_NOSUB);
-    free(regex_pattern);
-    
-    if (ret != 0) {
-        return false;
-    }
-    
-    ret = regexec(&regex, filename, 0, NULL, 0);
-    regfree(&regex);
-    
-    bool matches = (ret == 0);
-    
-    // For ^pattern, invert the result
-    if (is_negated) {
-        matches = !matches;
-    }
-    
-    return matches;
-}
-
 /**
  * @brief Expand zsh extglob pattern by reading directory and matching
  */
@@ -4552,8 +4704,16 @@ static char **expand_zsh_extglob_pattern(const char *pattern, int *expanded_coun
         file_pattern = pattern_copy;
     }
     
+    // Compile once for the whole directory scan
+    glob_pattern_t *compiled = glob_pattern_compile(file_pattern, GLOB_PATTERN_ZSH);
+    if (!compiled) {
+        free(pattern_copy);
+        return NULL;
+    }
+    
     DIR *dir = opendir(dir_path);
     if (!dir) {
+        glob_pattern_free(compiled);
         free(pattern_copy);
         return NULL;
     }
@@ -4575,7 +4735,8 @@ static char **expand_zsh_extglob_pattern(const char *pattern, int *expanded_coun
             continue;
         }
         
-        if (match_zsh_extglob(entry->d_name, file_pattern, is_negated)) {
+        // For ^pattern, invert the result
+        if (glob_pattern_match(compiled, entry->d_name) != is_negated) {
             // Grow array if needed
             if (result_count >= result_capacity) {
                 size_t new_capacity = result_capacity == 0 ? 16 : result_capacity * 2;
@@ -4587,6 +4748,7 @@ static char **expand_zsh_extglob_pattern(const char *pattern, int *expanded_coun
                     }
                     free(results);
                     closedir(dir);
+                    glob_pattern_free(compiled);
                     free(pattern_copy);
                     return NULL;
                 }
@@ -4616,6 +4778,7 @@ static char **expand_zsh_extglob_pattern(const char *pattern, int *expanded_coun
     }
     
     closedir(dir);
+    glob_pattern_free(compiled);
     free(pattern_copy);
     
     if (result_count == 0) {
@@ -4654,177 +4817,18 @@ static bool has_extglob_pattern(const char *pattern) {
 }
 
 /**
- * @brief Convert extglob pattern to regex pattern
- * 
- * Converts bash extglob syntax to POSIX extended regex:
- *   ?(pat)  -> (pat)?
- *   *(pat)  -> (pat)*
- *   +(pat)  -> (pat)+
- *   @(pat)  -> (pat)
- *   !(pat)  -> handled specially (negative match)
- *   *       -> .*
- *   ?       -> .
- *   .       -> \.
+ * @brief Expand extglob pattern by reading directory and matching
  * 
- * @param pattern Extglob pattern
- * @param is_negated Output: true if pattern uses !(...)
- * @return Regex pattern (caller must free), or NULL on error
+ * @param pattern Pattern with extglob syntax
+ * @param expanded_count Output: number of matches
+ * @return Array of matching filenames, or NULL
  */
-static char *extglob_to_regex(const char *pattern, bool *is_negated) {
-    if (!pattern) return NULL;
-    
-    *is_negated = false;
-    
-    // Allocate generous buffer (pattern can expand significantly)
-    size_t max_len = strlen(pattern) * 4 + 10;
-    char *regex = malloc(max_len);
-    if (!regex) return NULL;
+static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
+    *expanded_count = 0;
     
-    char *out = regex;
-    *out++ = '^';  // Anchor at start
-    
-    const char *p = pattern;
-    while (*p) {
-        // Check for extglob operators
-        if ((*p == '?' || *p == '*' || *p == '+' || *p == '@' || *p == '!') 
-            && *(p + 1) == '(') {
-            char op = *p;
-            p += 2;  // Skip operator and (
-            
-            // Find matching closing paren
-            int depth = 1;
-            const char *start = p;
-            while (*p && depth > 0) {
-                if (*p == '(') depth++;
-                else if (*p == ')') depth--;
-                if (depth > 0) p++;
-            }
-            
-            if (depth != 0) {
-                // Unmatched paren - treat literally
-                free(regex);
-                return NULL;
-            }
-            
-            // Copy the inner pattern
-            *out++ = '(';
-            size_t inner_len = p - start;
-            
-            // Convert inner pattern (replace | with |, escape regex chars)
-            for (size_t i = 0; i < inner_len; i++) {
-                char c = start[i];
-                if (c == '*') {
-                    *out++ = '.';
-                    *out++ = '*';
-                } else if (c == '?') {
-                    *out++ = '.';
-                } else if (c == '.') {
-                    *out++ = '\\';
-                    *out++ = '.';
-                } else if (c == '|') {
-                    *out++ = '|';
-                } else {
-                    *out++ = c;
-                }
-            }
-            *out++ = ')';
-            
-            // Add quantifier based on operator
-            switch (op) {
-                case '?': *out++ = '?'; break;
-                case '*': *out++ = '*'; break;
-                case '+': *out++ = '+'; break;
-                case '@': /* exactly one, no quantifier */ break;
-                case '!': *is_negated = true; break;
-            }
-            
-            p++;  // Skip closing paren
-        } else if (*p == '*') {
-            // Glob * -> regex .*
-            *out++ = '.';
-            *out++ = '*';
-            p++;
-        } else if (*p == '?') {
-            // Glob ? -> regex .
-            *out++ = '.';
-            p++;
-        } else if (*p == '.') {
-            // Escape literal dot
-            *out++ = '\\';
-            *out++ = '.';
-            p++;
-        } else if (*p == '[') {
-            // Character class - copy as-is until ]
-            *out++ = *p++;
-            while (*p && *p != ']') {
-                *out++ = *p++;
-            }
-            if (*p == ']') {
-                *out++ = *p++;
-            }
-        } else {
-            // Regular character - might need escaping
-            if (strchr("^$+{}\\", *p)) {
-                *out++ = '\\';
-            }
-            *out++ = *p++;
-        }
-    }
-    
-    *out++ = '$';  // Anchor at end
-    *out = '\0';
-    
-    return regex;
-}
-
-/**
- * @brief Match filename against extglob pattern
- * 
- * @param filename Filename to match
- * @param pattern Extglob pattern
- * @return true if matches
- */
-static bool match_extglob(const char *filename, const char *pattern) {
-    bool is_negated = false;
-    char *regex_pattern = extglob_to_regex(pattern, &is_negated);
-    if (!regex_pattern) {
-        return false;
-    }
-    
-    regex_t regex;
-    int ret = regcomp(&regex, regex_pattern, REG_EXTENDED | REG_NOSUB);
-    free(regex_pattern);
-    
-    if (ret != 0) {
-        return false;
-    }
-    
-    ret = regexec(&regex, filename, 0, NULL, 0);
-    regfree(&regex);
-    
-    bool matches = (ret == 0);
-    
-    // For !(pattern), invert the result
-    if (is_negated) {
-        matches = !matches;
-    }
-    
-    return matches;
-}
-
-/**
- * @brief Expand extglob pattern by reading directory and matching
- * 
- * @param pattern Pattern with extglob syntax
- * @param expanded_count Output: number of matches
- * @return Array of matching filenames, or NULL
- */
-static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
-    *expanded_count = 0;
-    
-    if (!pattern || !has_extglob_pattern(pattern)) {
-        return NULL;
-    }
+    if (!pattern || !has_extglob_pattern(pattern)) {
+        return NULL;
+    }
     
     // Split pattern into directory and filename parts
     char *pattern_copy = strdup(pattern);
@@ -4843,9 +4847,17 @@ static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
         file_pattern = pattern_copy;
     }
     
+    // Compile once for the whole directory scan
+    glob_pattern_t *compiled = glob_pattern_compile(file_pattern, GLOB_PATTERN_EXTGLOB);
+    if (!compiled) {
+        free(pattern_copy);
+        return NULL;
+    }
+    
     // Open directory
     DIR *dir = opendir(dir_path);
     if (!dir) {
+        glob_pattern_free(compiled);
         free(pattern_copy);
         return NULL;
     }
@@ -4864,7 +4876,7 @@ static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
             }
         }
         
-        if (match_extglob(entry->d_name, file_pattern)) {
+        if (glob_pattern_match(compiled, entry->d_name)) {
             // Resize array if needed
             if (count >= capacity) {
                 capacity = capacity ? capacity * 2 : 16;
@@ -4873,6 +4885,7 @@ static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
                     for (int i = 0; i < count; i++) free(results[i]);
                     free(results);
                     closedir(dir);
+                    glob_pattern_free(compiled);
                     free(pattern_copy);
                     return NULL;
                 }
@@ -4895,6 +4908,7 @@ static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
                 for (int i = 0; i < count; i++) free(results[i]);
                 free(results);
                 closedir(dir);
+                glob_pattern_free(compiled);
                 free(pattern_copy);
                 return NULL;
             }
@@ -4904,6 +4918,7 @@ static char **expand_extglob_pattern(const char *pattern, int *expanded_count) {
     }
     
     closedir(dir);
+    glob_pattern_free(compiled);
     free(pattern_copy);
     
     if (count == 0) {
@@ -4934,105 +4949,49 @@ static bool has_globstar_pattern(const char *pattern) {
 }
 
 /**
- * @brief Recursive helper to expand ** patterns
- *
- * @param base_dir Directory to search in
- * @param remaining_pattern Pattern after the ** segment
- * @param results Pointer to results array
- * @param count Pointer to current count
- * @param capacity Pointer to current capacity
- * @return 0 on success, -1 on error
+ * @brief Growing list of globstar matches
  */
-static int expand_globstar_recursive(const char *base_dir,
-                                     const char *remaining_pattern,
-                                     char ***results, int *count, int *capacity) {
-    DIR *dir = opendir(base_dir[0] ? base_dir : ".");
-    if (!dir) {
-        return 0; /* Not an error - directory might not be readable */
-    }
+typedef struct globstar_results {
+    char **paths;
+    int count;
+    int capacity;
+} globstar_results_t;
 
-    struct dirent *entry;
-    while ((entry = readdir(dir)) != NULL) {
-        /* Skip . and .. */
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-
-        /* Skip hidden files unless dotglob is enabled */
-        if (entry->d_name[0] == '.' && !shell_mode_allows(FEATURE_DOT_GLOB)) {
-            continue;
-        }
-
-        /* Build full path */
-        char full_path[PATH_MAX];
-        if (base_dir[0]) {
-            snprintf(full_path, sizeof(full_path), "%s/%s", base_dir, entry->d_name);
-        } else {
-            snprintf(full_path, sizeof(full_path), "%s", entry->d_name);
-        }
-
-        /* Check if this path matches the remaining pattern */
-        if (remaining_pattern && remaining_pattern[0]) {
-            /* Build candidate path with remaining pattern */
-            char candidate[PATH_MAX];
-            int written = snprintf(candidate, sizeof(candidate), "%s/%s", full_path, remaining_pattern);
-            if (written < 0 || (size_t)written >= sizeof(candidate)) {
-                continue;  /* Path too long, skip this entry */
-            }
-
-            /* Use glob to match the remaining pattern */
-            glob_t globbuf;
-            if (glob(candidate, GLOB_NOSORT, NULL, &globbuf) == 0) {
-                for (size_t i = 0; i < globbuf.gl_pathc; i++) {
-                    /* Resize array if needed */
-                    if (*count >= *capacity) {
-                        *capacity = *capacity ? *capacity * 2 : 32;
-                        char **new_results = realloc(*results, *capacity * sizeof(char *));
-                        if (!new_results) {
-                            globfree(&globbuf);
-                            closedir(dir);
-                            return -1;
-                        }
-                        *results = new_results;
-                    }
-                    (*results)[(*count)++] = strdup(globbuf.gl_pathv[i]);
-                }
-                globfree(&globbuf);
-            }
-        } else {
-            /* No remaining pattern - match the path itself */
-            if (*count >= *capacity) {
-                *capacity = *capacity ? *capacity * 2 : 32;
-                char **new_results = realloc(*results, *capacity * sizeof(char *));
-                if (!new_results) {
-                    closedir(dir);
-                    return -1;
-                }
-                *results = new_results;
-            }
-            (*results)[(*count)++] = strdup(full_path);
-        }
-
-        /* Recurse into directories */
-        struct stat st;
-        if (stat(full_path, &st) == 0 && S_ISDIR(st.st_mode)) {
-            if (expand_globstar_recursive(full_path, remaining_pattern,
-                                          results, count, capacity) < 0) {
-                closedir(dir);
-                return -1;
-            }
+/**
+ * @brief Append one globstar match (globstar_walk callback)
+ */
+static int collect_globstar_match(const char *path, void *ctx) {
+    globstar_results_t *results = ctx;
+    if (results->count + 1 >= results->capacity) {
+        int capacity = results->capacity ? results->capacity * 2 : 32;
+        char **new_paths = realloc(results->paths, capacity * sizeof(char *));
+        if (!new_paths) {
+            return -1;
         }
+        results->paths = new_paths;
+        results->capacity = capacity;
     }
-
-    closedir(dir);
+    char *copy = strdup(path);
+    if (!copy) {
+        return -1;
+    }
+    results->paths[results->count++] = copy;
     return 0;
 }
 
+/**
+ * @brief Compare two paths for sorting glob results
+ */
+static int compare_glob_paths(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
 /**
  * @brief Expand globstar (**) pattern
  *
  * When globstar is enabled, ** matches zero or more directories recursively.
  * For example: src/ ** / *.c matches all .c files under src/ at any depth.
+ * Matches are collected as the walk finds them and returned sorted.
  *
  * @param pattern Pattern containing **
  * @param expanded_count Output: number of matches
@@ -5045,92 +5004,32 @@ static char **expand_globstar_pattern(const char *pattern, int *expanded_count)
         return NULL;
     }
 
-    /* Find the ** in the pattern */
-    const char *starstar = strstr(pattern, "**");
-    if (!starstar) {
-        return NULL;
-    }
-
-    /* Split into prefix (before **) and suffix (after **) */
-    size_t prefix_len = starstar - pattern;
-    char *prefix = malloc(prefix_len + 1);
-    if (!prefix) return NULL;
-    
-    strncpy(prefix, pattern, prefix_len);
-    prefix[prefix_len] = '\0';
-
-    /* Remove trailing slash from prefix if present */
-    if (prefix_len > 0 && prefix[prefix_len - 1] == '/') {
-        prefix[prefix_len - 1] = '\0';
-    }
-
-    /* Get suffix (after **) */
-    const char *suffix = starstar + 2;
-    if (*suffix == '/') suffix++; /* Skip leading slash after ** */
-
-    /* Initialize results */
-    char **results = NULL;
-    int count = 0;
-    int capacity = 0;
-
-    /* Start directory */
-    const char *start_dir = prefix[0] ? prefix : ".";
-
-    /* First, match the start directory itself with the suffix pattern */
-    if (suffix[0]) {
-        char candidate[PATH_MAX];
-        if (prefix[0]) {
-            snprintf(candidate, sizeof(candidate), "%s/%s", prefix, suffix);
-        } else {
-            snprintf(candidate, sizeof(candidate), "%s", suffix);
-        }
-
-        glob_t globbuf;
-        if (glob(candidate, GLOB_NOSORT, NULL, &globbuf) == 0) {
-            for (size_t i = 0; i < globbuf.gl_pathc; i++) {
-                if (count >= capacity) {
-                    capacity = capacity ? capacity * 2 : 32;
-                    char **new_results = realloc(results, capacity * sizeof(char *));
-                    if (!new_results) {
-                        globfree(&globbuf);
-                        free(prefix);
-                        for (int j = 0; j < count; j++) free(results[j]);
-                        free(results);
-                        return NULL;
-                    }
-                    results = new_results;
-                }
-                results[count++] = strdup(globbuf.gl_pathv[i]);
-            }
-            globfree(&globbuf);
-        }
-    }
+    globstar_options_t options = {
+        .pattern_flags = shell_mode_allows(FEATURE_EXTENDED_GLOB)
+                             ? GLOB_PATTERN_EXTGLOB
+                             : 0,
+        .dotglob = shell_mode_allows(FEATURE_DOT_GLOB),
+        .max_workers = 0,
+    };
 
-    /* Recursively expand through directories */
-    if (expand_globstar_recursive(start_dir, suffix[0] ? suffix : NULL,
-                                  &results, &count, &capacity) < 0) {
-        free(prefix);
-        for (int i = 0; i < count; i++) free(results[i]);
-        free(results);
+    globstar_results_t results = {NULL, 0, 0};
+    if (globstar_walk(pattern, &options, collect_globstar_match, &results,
+                      NULL) < 0) {
+        for (int i = 0; i < results.count; i++) free(results.paths[i]);
+        free(results.paths);
         return NULL;
     }
 
-    free(prefix);
-
-    if (count == 0) {
-        free(results);
+    if (results.count == 0) {
+        free(results.paths);
         return NULL;
     }
 
-    /* Add NULL terminator */
-    char **final = realloc(results, (count + 1) * sizeof(char *));
-    if (final) {
-        final[count] = NULL;
-        results = final;
-    }
+    qsort(results.paths, results.count, sizeof(char *), compare_glob_paths);
+    results.paths[results.count] = NULL;
 
-    *expanded_count = count;
-    return results;
+    *expanded_count = results.count;
+    return results.paths;
 }
 
 static char **expand_glob_pattern(const char *pattern, int *expanded_count) {
@@ -5960,12 +5859,147 @@ static char **expand_brace_pattern(const char *pattern, int *expanded_count) {
     return result;
 }
 
+/**
+ * @brief Print the set -x trace line for an external command
+ *
+ * @param argv NULL-terminated argument vector
+ */
+static void trace_external_command(char **argv) {
+    if (!should_trace_execution()) {
+        return;
+    }
+
+    // Build command string from argv for tracing
+    size_t cmd_len = 1; // for null terminator
+    for (int j = 0; argv[j]; j++) {
+        cmd_len += strlen(argv[j]) + (j > 0 ? 1 : 0); // +1 for space
+    }
+
+    char *cmd_str = malloc(cmd_len);
+    if (cmd_str) {
+        strcpy(cmd_str, argv[0]);
+        for (int j = 1; argv[j]; j++) {
+            strcat(cmd_str, " ");
+            strcat(cmd_str, argv[j]);
+        }
+        print_command_trace(cmd_str);
+        free(cmd_str);
+    }
+}
+
+/**
+ * @brief Replace the current process with an external command
+ *
+ * Runs in a child process: applies the command's redirections and execs
+ * the already-resolved path. Like execvp, a file without a #! line is run
+ * with /bin/sh. Never returns; on failure exits with 126 (not executable)
+ * or 127 (not found).
+ *
+ * @param executor Executor context
+ * @param path Resolved command path
+ * @param argv NULL-terminated argument vector
+ * @param redirect_stderr If true, redirect stderr to /dev/null
+ * @param command Command node for redirection setup
+ */
+static void exec_external_command(executor_t *executor, const char *path,
+                                  char **argv, bool redirect_stderr,
+                                  node_t *command) {
+    int redir_result = setup_redirections(executor, command);
+    if (redir_result != 0) {
+        exit(1);
+    }
+
+    if (redirect_stderr) {
+        // Redirect stderr to /dev/null
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd != -1) {
+            dup2(null_fd, STDERR_FILENO);
+            close(null_fd);
+        }
+    }
+
+    execv(path, argv);
+    if (errno == ENOEXEC) {
+        int argc = 0;
+        while (argv[argc]) {
+            argc++;
+        }
+        char **sh_argv = malloc((argc + 2) * sizeof(char *));
+        if (sh_argv) {
+            sh_argv[0] = "/bin/sh";
+            sh_argv[1] = (char *)path;
+            memcpy(sh_argv + 2, argv + 1, argc * sizeof(char *));
+            execv("/bin/sh", sh_argv);
+            free(sh_argv);
+        }
+        errno = ENOEXEC;
+    }
+    // Check errno to determine appropriate exit code
+    int exit_code = 127; // Default: command not found
+    if (errno == EACCES) {
+        exit_code = 126; // Permission denied
+    } else if (errno == ENOENT) {
+        exit_code = 127; // Command not found
+    }
+    if (!redirect_stderr) {
+        fprintf(stderr, "lush: %s: %s\n", argv[0], strerror(errno));
+    }
+    exit(exit_code);
+}
+
+/**
+ * @brief Start an external command with posix_spawn
+ *
+ * posix_spawn avoids copying the shell's page tables (glibc uses a
+ * CLONE_VM|CLONE_VFORK child), which fork() pays for on every command.
+ * Only commands whose redirections translate into spawn file actions are
+ * eligible; any spawn failure (missing redirection source, ENOEXEC
+ * script, ...) also defers to the fork path, which reports errors exactly
+ * as before.
+ *
+ * @param executor Executor context
+ * @param path Resolved command path
+ * @param argv NULL-terminated argument vector
+ * @param redirect_stderr If true, redirect stderr to /dev/null
+ * @param command Command node with redirections
+ * @return Child PID, or 0 if the command must take the fork path
+ */
+static pid_t spawn_external_command(executor_t *executor, const char *path,
+                                    char **argv, bool redirect_stderr,
+                                    node_t *command) {
+    extern char **environ;
+    posix_spawn_file_actions_t actions;
+
+    if (posix_spawn_file_actions_init(&actions) != 0) {
+        return 0;
+    }
+
+    pid_t pid = 0;
+    bool eligible = build_spawn_file_actions(executor, command, &actions) == 0;
+    if (eligible && redirect_stderr) {
+        eligible = posix_spawn_file_actions_addopen(&actions, STDERR_FILENO,
+                                                    "/dev/null", O_WRONLY,
+                                                    0) == 0;
+    }
+    if (eligible &&
+        posix_spawn(&pid, path, &actions, NULL, argv, environ) != 0) {
+        pid = 0;
+    }
+
+    posix_spawn_file_actions_destroy(&actions);
+    return pid;
+}
+
 /**
  * @brief Execute external command with full redirection setup
  *
  * Forks and sets up redirections in the child process before exec.
  * Handles command hashing, tracing (set -x), and debug profiling.
  *
+ * When executor->exec_in_place is set (a pipeline stage child whose whole
+ * job is this command), the current process execs the command directly
+ * instead of forking a grandchild and waiting for it.
+ *
  * @param executor Executor context
  * @param argv NULL-terminated argument vector
  * @param redirect_stderr If true, redirect stderr to /dev/null
@@ -5976,30 +6010,34 @@ static int execute_external_command_with_setup(executor_t *executor,
                                                char **argv,
                                                bool redirect_stderr,
                                                node_t *command) {
+    bool exec_in_place = executor->exec_in_place;
+    executor->exec_in_place = false;
+
     if (!argv || !argv[0]) {
         return 1;
     }
 
-    // Check if command exists before forking (for better error messages)
-    // Skip this check for path-based commands (containing '/')
+    // Resolve the command once, through the command hash; the resolved
+    // path is what gets executed. Path-based commands (containing '/') are
+    // executed as given.
     char *full_path = NULL;
     if (!strchr(argv[0], '/')) {
-        full_path = find_command_in_path(argv[0]);
+        full_path = command_hash_lookup(argv[0]);
         if (!full_path) {
             // Command not found - report with suggestions from parent process
             source_location_t loc = command ? command->loc : SOURCE_LOC_UNKNOWN;
             report_command_not_found(executor, argv[0], loc);
             return 127;
         }
+    }
+    const char *exec_path = full_path ? full_path : argv[0];
 
-        // If hashall is enabled, remember this command's location
-        if (shell_opts.hash_commands) {
-            init_command_hash();
-            if (command_hash) {
-                ht_strstr_insert(command_hash, argv[0], full_path);
-            }
-        }
-        free(full_path);
+    if (exec_in_place) {
+        trace_external_command(argv);
+        fflush(stdout);
+        fflush(stderr);
+        exec_external_command(executor, exec_path, argv, redirect_stderr,
+                              command);
     }
 
     // Reset terminal state before forking for external commands
@@ -6009,92 +6047,60 @@ static int execute_external_command_with_setup(executor_t *executor,
         fflush(stderr);
     }
 
-    pid_t pid = fork();
-    if (pid == -1) {
-        set_executor_error(executor, "Failed to fork");
-        return 1;
-    }
-
-    if (pid == 0) {
-        // Child process - setup redirections here
-        int redir_result = setup_redirections(executor, command);
-        if (redir_result != 0) {
-            exit(1);
-        }
-
-        if (redirect_stderr) {
-            // Redirect stderr to /dev/null
-            int null_fd = open("/dev/null", O_WRONLY);
-            if (null_fd != -1) {
-                dup2(null_fd, STDERR_FILENO);
-                close(null_fd);
-            }
+    pid_t pid = spawn_external_command(executor, exec_path, argv,
+                                       redirect_stderr, command);
+    if (pid > 0) {
+        executor->spawn_count++;
+    } else {
+        pid = fork();
+        if (pid == -1) {
+            free(full_path);
+            set_executor_error(executor, "Failed to fork");
+            return 1;
         }
 
-        execvp(argv[0], argv);
-        // Check errno to determine appropriate exit code
-        int exit_code = 127; // Default: command not found
-        if (errno == EACCES) {
-            exit_code = 126; // Permission denied
-        } else if (errno == ENOENT) {
-            exit_code = 127; // Command not found
-        }
-        if (!redirect_stderr) {
-            fprintf(stderr, "lush: %s: %s\n", argv[0], strerror(errno));
+        if (pid == 0) {
+            // Child process - setup redirections and exec
+            exec_external_command(executor, exec_path, argv, redirect_stderr,
+                                  command);
         }
-        exit(exit_code);
-    } else {
-        // Parent process
-        set_current_child_pid(pid);
+        executor->fork_count++;
+    }
+    free(full_path);
 
-        // Print trace for external command if -x is enabled
-        if (should_trace_execution()) {
-            // Build command string from argv for tracing
-            size_t cmd_len = 1; // for null terminator
-            for (int j = 0; argv[j]; j++) {
-                cmd_len += strlen(argv[j]) + (j > 0 ? 1 : 0); // +1 for space
-            }
+    // Parent process
+    set_current_child_pid(pid);
 
-            char *cmd_str = malloc(cmd_len);
-            if (cmd_str) {
-                strcpy(cmd_str, argv[0]);
-                for (int j = 1; argv[j]; j++) {
-                    strcat(cmd_str, " ");
-                    strcat(cmd_str, argv[j]);
-                }
-                print_command_trace(cmd_str);
-                free(cmd_str);
-            }
-        }
+    // Print trace for external command if -x is enabled
+    trace_external_command(argv);
 
-        // Enhanced debug tracing for external commands with setup
-        DEBUG_TRACE_COMMAND(argv[0], argv, 0);
-        DEBUG_PROFILE_ENTER(argv[0]);
+    // Enhanced debug tracing for external commands with setup
+    DEBUG_TRACE_COMMAND(argv[0], argv, 0);
+    DEBUG_PROFILE_ENTER(argv[0]);
 
-        int status;
-        // Wait for child, retrying on EINTR (signal interruption)
-        while (waitpid(pid, &status, 0) == -1) {
-            if (errno != EINTR) {
-                // Real error - child may have already been reaped
-                clear_current_child_pid();
-                return 1;
-            }
-            // EINTR - signal interrupted wait, continue waiting
+    int status;
+    // Wait for child, retrying on EINTR (signal interruption)
+    while (waitpid(pid, &status, 0) == -1) {
+        if (errno != EINTR) {
+            // Real error - child may have already been reaped
+            clear_current_child_pid();
+            return 1;
         }
-        clear_current_child_pid();
+        // EINTR - signal interrupted wait, continue waiting
+    }
+    clear_current_child_pid();
 
-        DEBUG_PROFILE_EXIT(argv[0]);
+    DEBUG_PROFILE_EXIT(argv[0]);
 
-        // Handle exit status properly - child may have exited or been signaled
-        if (WIFEXITED(status)) {
-            return WEXITSTATUS(status);
-        } else if (WIFSIGNALED(status)) {
-            // Child was killed by signal - return 128 + signal number (bash
-            // convention)
-            return 128 + WTERMSIG(status);
-        }
-        return 1;
+    // Handle exit status properly - child may have exited or been signaled
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        // Child was killed by signal - return 128 + signal number (bash
+        // convention)
+        return 128 + WTERMSIG(status);
     }
+    return 1;
 }
 
 /* Forward declaration for test builtin */
@@ -6382,18 +6388,18 @@ static int execute_assignment(executor_t *executor, const char *assignment) {
     // Expand the value using modern expansion
     // Save exit status set by command substitution (POSIX: assignment-only
     // commands should return the exit status of the last command substitution)
+    executor->exit_status = 0;
     char *value = expand_if_needed(executor, eq + 1);
     int cmd_sub_exit_status = executor->exit_status;
 
     // Resolve nameref if the variable is a nameref (max depth 10)
+    // The resolved name is borrowed from the nameref's own record
     const char *target_name = var_name;
-    char *resolved_to_free = NULL;  // Track if we need to free resolved name
     if (symtable_is_nameref(executor->symtable, var_name)) {
         const char *resolved = symtable_resolve_nameref(executor->symtable,
                                                         var_name, 10);
-        if (resolved && resolved != var_name) {
+        if (resolved) {
             target_name = resolved;
-            resolved_to_free = (char *)resolved;  // May need to free this
         }
     }
 
@@ -6410,7 +6416,8 @@ static int execute_assignment(executor_t *executor, const char *assignment) {
             result = 0;
         } else {
             // String append - concatenate to existing value
-            char *existing = symtable_get_var(executor->symtable, target_name);
+            const char *existing =
+                symtable_get_var_ref(executor->symtable, target_name);
             if (existing && existing[0]) {
                 size_t existing_len = strlen(existing);
                 size_t value_len = value ? strlen(value) : 0;
@@ -6436,11 +6443,6 @@ static int execute_assignment(executor_t *executor, const char *assignment) {
                                          value ? value : "");
     }
     
-    // Free resolved nameref if it was allocated
-    if (resolved_to_free) {
-        free(resolved_to_free);
-    }
-
     // POSIX -a (allexport): automatically export assigned variables
     if (result == 0 && should_auto_export()) {
         symtable_export_global(var_name);
@@ -6707,15 +6709,113 @@ static int execute_function_definition(executor_t *executor, node_t *node) {
 }
 
 /**
- * @brief Check if a function is defined
+ * @brief Release a reference to a function definition
+ *
+ * Frees the definition when no function table or running call holds it.
+ *
+ * @param func Function definition (NULL is ignored)
+ */
+static void function_def_unref(function_def_t *func) {
+    if (!func || --func->refs > 0) {
+        return;
+    }
+    free(func->name);
+    free_node_tree(func->body);
+    free_function_params(func->params);
+    free(func);
+}
+
+/**
+ * @brief Drop a function table's reference (value free callback)
+ */
+static void function_table_free_def(const void *val) {
+    function_def_unref((function_def_t *)val);
+}
+
+/**
+ * @brief Get the function table of an executor, creating it if needed
+ *
+ * Keys are the definitions' own names, so they live as long as the entry.
  *
  * @param executor Executor context
- * @param function_name Name of function to check
- * @return true if function exists in function table
+ * @return Function table, or NULL on allocation failure
  */
-static bool is_function_defined(executor_t *executor,
-                                const char *function_name) {
-    return find_function(executor, function_name) != NULL;
+static ht_t *function_table(executor_t *executor) {
+    if (!executor->functions) {
+        ht_callbacks_t callbacks = {NULL, NULL, NULL,
+                                    function_table_free_def};
+        executor->functions = ht_create(fnv1a_hash_str, str_eq, &callbacks,
+                                        HT_STR_NONE | HT_SEED_RANDOM);
+    }
+    return executor->functions;
+}
+
+/**
+ * @brief Add a function definition to an executor, replacing any other
+ *
+ * Takes a new reference to the definition.
+ *
+ * @param executor Executor context
+ * @param func Function definition
+ * @return 0 on success, 1 on failure
+ */
+static int function_table_put(executor_t *executor, function_def_t *func) {
+    ht_t *table = function_table(executor);
+    if (!table) {
+        return 1;
+    }
+
+    /* Remove first: an insert over an existing entry would keep the old
+     * definition's name as the key */
+    if (ht_get(table, func->name)) {
+        ht_remove(table, func->name);
+        executor->function_count--;
+    }
+    func->refs++;
+    ht_insert(table, func->name, func);
+    executor->function_count++;
+    executor->function_generation++;
+    return 0;
+}
+
+/**
+ * @brief Resolve the function a command calls, if any
+ *
+ * Each executor remembers, per command node, the function the node last
+ * resolved to and the function table generation at the time. A command
+ * run again, such as one in a loop or a function body, skips the table
+ * lookup while no function has been defined since.
+ *
+ * @param executor Executor context
+ * @param site Command node making the call (NULL to skip the cache)
+ * @param name Command name after expansion
+ * @return Function definition, or NULL if name is not a function
+ */
+static function_def_t *resolve_function(executor_t *executor,
+                                        const node_t *site, const char *name) {
+    if (!executor || !name || executor->function_count == 0) {
+        return NULL;
+    }
+
+    function_call_site_t *entry = NULL;
+    if (site) {
+        entry = &executor->call_sites[((uintptr_t)site / sizeof(node_t)) &
+                                      (EXECUTOR_CALL_SITES - 1)];
+        /* The name is checked too, as it may come from an expansion */
+        if (entry->site == site &&
+            entry->generation == executor->function_generation &&
+            strcmp(entry->func->name, name) == 0) {
+            return entry->func;
+        }
+    }
+
+    function_def_t *func = find_function(executor, name);
+    if (entry && func) {
+        entry->site = site;
+        entry->generation = executor->function_generation;
+        entry->func = func;
+    }
+    return func;
 }
 
 /**
@@ -6723,25 +6823,39 @@ static bool is_function_defined(executor_t *executor,
  *
  * Creates a function scope, sets up positional parameters,
  * executes the function body, and handles return values.
+ * The caller holds a reference to the definition for the duration of the
+ * call, so a function that redefines itself keeps running its old body.
  *
  * @param executor Executor context
- * @param function_name Name of function to call
+ * @param func Function definition to call
  * @param argv Argument vector (argv[0] is function name)
  * @param argc Argument count
  * @return Exit status of function body
  */
-static int execute_function_call(executor_t *executor,
-                                 const char *function_name, char **argv,
-                                 int argc) {
-    if (!executor || !function_name) {
+static int execute_function_call(executor_t *executor, function_def_t *func,
+                                 char **argv, int argc) {
+    if (!executor || !func) {
         return 1;
     }
 
-    function_def_t *func = find_function(executor, function_name);
-    if (!func) {
-        set_executor_error(executor, "Function not found");
-        return 1;
-    }
+    func->refs++;
+    int result = call_function(executor, func, argv, argc);
+    function_def_unref(func);
+    return result;
+}
+
+/**
+ * @brief Run a function body in a new function scope
+ *
+ * @param executor Executor context
+ * @param func Function definition to call
+ * @param argv Argument vector (argv[0] is function name)
+ * @param argc Argument count
+ * @return Exit status of function body
+ */
+static int call_function(executor_t *executor, function_def_t *func,
+                         char **argv, int argc) {
+    const char *function_name = func->name;
 
     // Validate function parameters
     if (validate_function_parameters(func, argv, argc) != 0) {
@@ -6962,35 +7076,72 @@ static int validate_function_parameters(function_def_t *func, char **argv,
 /**
  * @brief Find function in function table
  *
- * Searches the executor's function linked list for a function
- * with the specified name.
- *
  * @param executor Executor context
  * @param function_name Name to search for
  * @return Function definition, or NULL if not found
  */
 static function_def_t *find_function(executor_t *executor,
                                      const char *function_name) {
-    if (!executor || !function_name) {
+    if (!executor || !function_name || !executor->functions) {
         return NULL;
     }
+    return ht_get(executor->functions, function_name);
+}
 
-    function_def_t *func = executor->functions;
-    while (func) {
-        if (strcmp(func->name, function_name) == 0) {
-            return func;
-        }
-        func = func->next;
+function_def_t *executor_find_function(executor_t *executor,
+                                       const char *name) {
+    return find_function(executor, name);
+}
+
+bool executor_function_exists(executor_t *executor, const char *name) {
+    return find_function(executor, name) != NULL;
+}
+
+/**
+ * @brief Order function definitions by name (qsort callback)
+ */
+static int compare_function_names(const void *a, const void *b) {
+    const function_def_t *fa = *(function_def_t *const *)a;
+    const function_def_t *fb = *(function_def_t *const *)b;
+    return strcmp(fa->name, fb->name);
+}
+
+function_def_t **executor_list_functions(executor_t *executor,
+                                         size_t *count) {
+    if (count) {
+        *count = 0;
     }
-    return NULL;
+    if (!executor || !count || executor->function_count == 0) {
+        return NULL;
+    }
+
+    function_def_t **list =
+        malloc(executor->function_count * sizeof(function_def_t *));
+    ht_enum_t *it = list ? ht_enum_create(executor->functions) : NULL;
+    if (!it) {
+        free(list);
+        return NULL;
+    }
+    const void *val;
+    size_t n = 0;
+    while (n < executor->function_count && ht_enum_next(it, NULL, &val)) {
+        list[n++] = (function_def_t *)val;
+    }
+    ht_enum_destroy(it);
+
+    qsort(list, n, sizeof(function_def_t *), compare_function_names);
+    *count = n;
+    return list;
 }
 
 /**
  * @brief Store function in function table
  *
  * Stores or replaces a function definition. Creates a deep copy
- * of the function body AST. If a function with the same name exists,
- * it is replaced.
+ * of the function body AST, which is then shared, never copied again,
+ * by every executor the function is handed to. If a function with the
+ * same name exists, it is replaced; calls already running it keep the
+ * old definition until they return.
  *
  * @param executor Executor context
  * @param function_name Function name
@@ -7006,21 +7157,6 @@ static int store_function(executor_t *executor, const char *function_name,
         return 1;
     }
 
-    // Check if function already exists and remove it
-    function_def_t **current = &executor->functions;
-    while (*current) {
-        if (strcmp((*current)->name, function_name) == 0) {
-            function_def_t *to_remove = *current;
-            *current = (*current)->next;
-            free(to_remove->name);
-            free_node_tree(to_remove->body);
-            free_function_params(to_remove->params);
-            free(to_remove);
-            break;
-        }
-        current = &(*current)->next;
-    }
-
     // Create new function definition
     function_def_t *new_func = malloc(sizeof(function_def_t));
     if (!new_func) {
@@ -7046,10 +7182,14 @@ static int store_function(executor_t *executor, const char *function_name,
     // Store parameter information
     new_func->params = params;
     new_func->param_count = param_count;
+    new_func->refs = 0;
 
-    // Add to front of function list
-    new_func->next = executor->functions;
-    executor->functions = new_func;
+    // Replace any previous definition; the table holds the only reference
+    if (function_table_put(executor, new_func) != 0) {
+        new_func->refs = 1;
+        function_def_unref(new_func);
+        return 1;
+    }
 
     return 0;
 }
@@ -7198,9 +7338,10 @@ static char *extract_substring(const char *str, int offset, int length) {
 /**
  * @brief Match string against glob pattern
  *
- * Supports *, ?, and [...] character classes including ranges
- * and negation [!...] or [^...]. Used for case patterns and
- * parameter expansion pattern matching.
+ * Supports *, ?, and [...] character classes including ranges,
+ * negation [!...] or [^...] and [:class:] names. Used for case patterns
+ * and parameter expansion pattern matching. The compiled pattern comes
+ * from the glob pattern cache, so a pattern is only parsed once.
  *
  * @param str String to match
  * @param pattern Glob pattern
@@ -7210,97 +7351,7 @@ static bool match_pattern(const char *str, const char *pattern) {
     if (!str || !pattern) {
         return false;
     }
-
-    const char *s = str;
-    const char *p = pattern;
-
-    while (*p) {
-        if (*p == '*') {
-            // Handle wildcard
-            p++; // Skip the *
-
-            // If * is at the end, it matches everything remaining
-            if (*p == '\0') {
-                return true;
-            }
-
-            // Try to match the rest of the pattern at each position in the
-            // string
-            while (*s) {
-                if (match_pattern(s, p)) {
-                    return true;
-                }
-                s++;
-            }
-
-            // Try matching the pattern with empty string (for cases like
-            // "*suffix")
-            return match_pattern(s, p);
-        } else if (*p == '?') {
-            // Wildcard matches any single character
-            if (*s == '\0') {
-                return false; // ? can't match empty
-            }
-            s++;
-            p++;
-        } else if (*p == '[') {
-            // Character class pattern [abc] or [a-z]
-            if (*s == '\0') {
-                return false; // Character class can't match empty
-            }
-
-            p++; // Skip opening [
-            bool matched = false;
-            bool negated = false;
-
-            // Check for negation [!abc] or [^abc]
-            if (*p == '!' || *p == '^') {
-                negated = true;
-                p++;
-            }
-
-            while (*p && *p != ']') {
-                if (p[1] == '-' && p[2] != ']' && p[2] != '\0') {
-                    // Range pattern like a-z
-                    if (*s >= *p && *s <= p[2]) {
-                        matched = true;
-                    }
-                    p += 3; // Skip a-z
-                } else {
-                    // Single character
-                    if (*s == *p) {
-                        matched = true;
-                    }
-                    p++;
-                }
-            }
-
-            if (*p == ']') {
-                p++; // Skip closing ]
-            }
-
-            // Apply negation if needed
-            if (negated) {
-                matched = !matched;
-            }
-
-            if (!matched) {
-                return false;
-            }
-
-            s++;
-        } else {
-            // Literal character match (including special chars like : @ / etc.)
-            if (*s != *p) {
-                return false;
-            }
-            s++;
-            p++;
-        }
-    }
-
-    // Pattern is exhausted, string should be too for a complete match
-    return *s == '\0';
+    return glob_match(pattern, str, GLOB_PATTERN_NOESCAPE);
 }
 
 /**
@@ -7320,29 +7371,15 @@ static int find_prefix_match(const char *str, const char *pattern,
         return 0;
     }
 
-    int str_len = strlen(str);
-    int match_len = 0;
-
-    for (int i = 0; i <= str_len; i++) {
-        char *substr = malloc(i + 1);
-        if (!substr) {
-            break;
-        }
-
-        strncpy(substr, str, i);
-        substr[i] = '\0';
-
-        if (match_pattern(substr, pattern)) {
-            match_len = i;
-            if (!longest) {
-                free(substr);
-                break; // Return first (shortest) match
-            }
-        }
-        free(substr);
+    const glob_pattern_t *compiled =
+        glob_pattern_cached(pattern, GLOB_PATTERN_NOESCAPE);
+    if (!compiled) {
+        return 0;
     }
 
-    return match_len;
+    ssize_t match_len =
+        glob_pattern_match_prefix(compiled, str, strlen(str), longest);
+    return match_len > 0 ? (int)match_len : 0;
 }
 
 /**
@@ -7362,20 +7399,15 @@ static int find_suffix_match(const char *str, const char *pattern,
         return 0;
     }
 
-    int str_len = strlen(str);
-    int match_len = 0;
-
-    for (int i = 0; i <= str_len; i++) {
-        const char *suffix = str + str_len - i;
-        if (match_pattern(suffix, pattern)) {
-            match_len = i;
-            if (!longest) {
-                break; // Return first (shortest) match
-            }
-        }
+    const glob_pattern_t *compiled =
+        glob_pattern_cached(pattern, GLOB_PATTERN_NOESCAPE);
+    if (!compiled) {
+        return 0;
     }
 
-    return match_len;
+    ssize_t match_len =
+        glob_pattern_match_suffix(compiled, str, strlen(str), longest);
+    return match_len > 0 ? (int)match_len : 0;
 }
 
 /**
@@ -7603,10 +7635,10 @@ static char *convert_case_capitalize_words(const char *str) {
  * @brief Pattern substitution for ${var/pattern/replacement}
  *
  * Replaces pattern matches in str with replacement.
- * Supports glob patterns (* and ?).
+ * Supports glob patterns (*, ? and [...]).
  *
  * @param str Source string
- * @param pattern Pattern to match (supports * and ?)
+ * @param pattern Pattern to match (supports *, ? and [...])
  * @param replacement Replacement string
  * @param global If true, replace all occurrences; if false, only first
  * @return New string with substitutions (caller must free)
@@ -7636,6 +7668,17 @@ static char *pattern_substitute(const char *str, const char *pattern,
     result[0] = '\0';
     size_t result_pos = 0;
 
+    // Glob patterns are compiled once for every position
+    const glob_pattern_t *compiled = NULL;
+    bool greedy = strchr(pattern, '*') != NULL;
+    if (greedy || strpbrk(pattern, "?[")) {
+        compiled = glob_pattern_cached(pattern, 0);
+        if (!compiled) {
+            free(result);
+            return strdup(str);
+        }
+    }
+
     size_t i = 0;
     bool replaced = false;
 
@@ -7645,36 +7688,13 @@ static char *pattern_substitute(const char *str, const char *pattern,
         size_t match_len = 0;
 
         // Simple pattern matching - check for exact match or glob
-        if (strchr(pattern, '*') || strchr(pattern, '?')) {
-            // Use fnmatch for glob patterns
-            // Try increasing lengths to find the match
-            for (size_t try_len = 1; try_len <= str_len - i; try_len++) {
-                char *substr = malloc(try_len + 1);
-                if (substr) {
-                    strncpy(substr, str + i, try_len);
-                    substr[try_len] = '\0';
-                    if (fnmatch(pattern, substr, 0) == 0) {
-                        matched = true;
-                        match_len = try_len;
-                        // For greedy matching with *, keep trying longer
-                        if (strchr(pattern, '*')) {
-                            for (size_t longer = try_len + 1; longer <= str_len - i; longer++) {
-                                char *longer_substr = malloc(longer + 1);
-                                if (longer_substr) {
-                                    strncpy(longer_substr, str + i, longer);
-                                    longer_substr[longer] = '\0';
-                                    if (fnmatch(pattern, longer_substr, 0) == 0) {
-                                        match_len = longer;
-                                    }
-                                    free(longer_substr);
-                                }
-                            }
-                        }
-                        free(substr);
-                        break;
-                    }
-                    free(substr);
-                }
+        if (compiled) {
+            // Longest match when the pattern has *, otherwise shortest
+            ssize_t len = glob_pattern_match_prefix(compiled, str + i,
+                                                    str_len - i, greedy);
+            if (len > 0) {
+                matched = true;
+                match_len = (size_t)len;
             }
         } else {
             // Exact substring match
@@ -8939,10 +8959,9 @@ static char *parse_parameter_expansion(executor_t *executor,
         }
 
         // Regular variable length: ${#var}
-        char *value = symtable_get_var(executor->symtable, var_name);
+        const char *value = symtable_get_var_ref(executor->symtable, var_name);
         if (value) {
             int len = strlen(value);
-            free(value);  // Free the strdup'd value after getting length
             char *result = malloc(16);
             if (result) {
                 snprintf(result, 16, "%d", len);
@@ -9674,26 +9693,9 @@ static char *expand_variable(executor_t *executor, const char *var_text) {
                 strncpy(name, var_name, name_len);
                 name[name_len] = '\0';
 
-                // Resolve nameref if applicable (max depth 10 to prevent loops)
-                const char *resolved_name = name;
-                char *resolved_to_free = NULL;  // Track if we need to free
-                if (symtable_is_nameref(executor->symtable, name)) {
-                    const char *target = symtable_resolve_nameref(
-                        executor->symtable, name, 10);
-                    if (target && target != name) {
-                        resolved_name = target;
-                        resolved_to_free = (char *)target;
-                    }
-                }
-
-                // Look up in modern symbol table using resolved name
-                char *value = symtable_get_var(executor->symtable,
-                                               resolved_name);
-                
-                // Free resolved nameref if it was allocated
-                if (resolved_to_free) {
-                    free(resolved_to_free);
-                }
+                // Look up in modern symbol table; namerefs are resolved
+                // by the symbol table itself (max depth 10)
+                char *value = symtable_get_var(executor->symtable, name);
 
                 // Check for unset variable error (set -u)
                 if (!value && shell_opts.unset_error && name_len > 0) {
@@ -10090,12 +10092,207 @@ static char *expand_arithmetic(executor_t *executor, const char *arith_text) {
     return strdup("");
 }
 
+/**
+ * @brief Read a file descriptor to EOF into a growing buffer
+ *
+ * Reads directly into the tail of the buffer, doubling it as needed, so
+ * large outputs take few read() calls and no intermediate copies. The
+ * result is always NUL-terminated.
+ *
+ * @param fd Descriptor to read
+ * @param len_out Output: number of bytes read
+ * @return Buffer (caller must free), or NULL on allocation failure
+ */
+static char *read_fd_to_end(int fd, size_t *len_out) {
+    size_t capacity = 4096;
+    size_t len = 0;
+    char *buffer = malloc(capacity);
+    if (!buffer) {
+        return NULL;
+    }
+
+    for (;;) {
+        if (capacity - len < 2) {
+            char *grown = realloc(buffer, capacity * 2);
+            if (!grown) {
+                free(buffer);
+                return NULL;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+
+        ssize_t n = read(fd, buffer + len, capacity - len - 1);
+        if (n > 0) {
+            len += (size_t)n;
+        } else if (n == -1 && errno == EINTR) {
+            continue;
+        } else {
+            break;
+        }
+    }
+
+    buffer[len] = '\0';
+    *len_out = len;
+    return buffer;
+}
+
+/**
+ * @brief Apply the final command substitution rules to captured output
+ *
+ * Extracts a function return value marker if present, otherwise strips
+ * trailing newlines in place.
+ *
+ * @param output NUL-terminated captured output (ownership taken)
+ * @param output_len Length of output
+ * @return Substitution result (caller must free)
+ */
+static char *finish_substitution_output(char *output, size_t output_len) {
+    // Check for return value marker in output
+    const char *return_marker = "__LUSH_RETURN__:";
+    const char *end_marker = ":__END__";
+    char *marker_pos = strstr(output, return_marker);
+
+    if (marker_pos) {
+        // Found return value marker, extract the return value
+        char *value_start = marker_pos + strlen(return_marker);
+        char *value_end = strstr(value_start, end_marker);
+
+        if (value_end) {
+            size_t value_len = value_end - value_start;
+            memmove(output, value_start, value_len);
+            output[value_len] = '\0';
+            return output;
+        }
+    }
+
+    // Remove trailing newlines
+    while (output_len > 0 && (output[output_len - 1] == '\n' ||
+                              output[output_len - 1] == '\r')) {
+        output[--output_len] = '\0';
+    }
+
+    return output;
+}
+
+/**
+ * @brief Check if a command substitution can run without forking
+ *
+ * Only a single simple command naming an output-only builtin qualifies,
+ * and only when expanding its words cannot change shell state: no
+ * redirections, nested substitutions, arithmetic or ${...} expansions
+ * (which may assign), and no function or alias shadowing the builtin.
+ *
+ * @param executor Executor context
+ * @param ast Parsed substitution body
+ * @param text Substitution body text
+ * @return true if the body can run in the current process
+ */
+static bool substitution_runs_in_process(executor_t *executor, node_t *ast,
+                                         const char *text) {
+    static const char *const inprocess_builtins[] = {
+        "echo", "printf", "pwd", "true", "false", NULL};
+
+    if (ast->type != NODE_COMMAND || ast->next_sibling || !ast->val.str) {
+        return false;
+    }
+
+    bool listed = false;
+    for (const char *const *name = inprocess_builtins; *name; name++) {
+        if (strcmp(ast->val.str, *name) == 0) {
+            listed = true;
+            break;
+        }
+    }
+    if (!listed || executor_function_exists(executor, ast->val.str) ||
+        lookup_alias(ast->val.str)) {
+        return false;
+    }
+
+    for (node_t *child = ast->first_child; child;
+         child = child->next_sibling) {
+        if (child->type != NODE_VAR && child->type != NODE_STRING_LITERAL &&
+            child->type != NODE_STRING_EXPANDABLE) {
+            return false;
+        }
+    }
+
+    return !strchr(text, '`') && !strstr(text, "$(") && !strstr(text, "${");
+}
+
+/**
+ * @brief Run a builtin command substitution in the current process
+ *
+ * Points stdout at an anonymous temporary file while the builtin runs,
+ * then reads the captured output back. Unlike a pipe, the file cannot
+ * fill up and block the builtin.
+ *
+ * @param executor Executor context
+ * @param ast Command node accepted by substitution_runs_in_process()
+ * @param len_out Output: length of the captured output
+ * @return Captured output (caller must free), or NULL if the builtin was
+ *         not run and the caller should fork instead
+ */
+static char *run_substitution_builtin(executor_t *executor, node_t *ast,
+                                      size_t *len_out) {
+    int argc = 0;
+    char **argv = build_argv_from_ast(executor, ast, &argc);
+    if (!argv) {
+        return NULL;
+    }
+
+    // printf -v assigns a variable, which must not leak out of $(...)
+    bool runnable = argc > 0 && !executor->expansion_error &&
+                    !(strcmp(argv[0], "printf") == 0 && argc > 1 &&
+                      strncmp(argv[1], "-v", 2) == 0);
+
+    FILE *capture = runnable ? tmpfile() : NULL;
+    int saved_stdout = -1;
+    if (capture) {
+        fflush(stdout);
+        saved_stdout = dup(STDOUT_FILENO);
+        if (saved_stdout == -1 ||
+            dup2(fileno(capture), STDOUT_FILENO) == -1) {
+            if (saved_stdout != -1) {
+                close(saved_stdout);
+            }
+            fclose(capture);
+            capture = NULL;
+        }
+    }
+
+    char *output = NULL;
+    if (capture) {
+        executor->exit_status = execute_builtin_command(executor, argv);
+        fflush(stdout);
+        clearerr(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+
+        lseek(fileno(capture), 0, SEEK_SET);
+        output = read_fd_to_end(fileno(capture), len_out);
+        fclose(capture);
+        if (!output) {
+            output = strdup("");
+            *len_out = 0;
+        }
+    }
+
+    for (int i = 0; i < argc; i++) {
+        free(argv[i]);
+    }
+    free(argv);
+    return output;
+}
+
 /**
  * @brief Expand command substitution $(...) or `...`
  *
- * Forks a child process to execute the command and captures its stdout.
- * Trailing newlines are stripped from the output. Uses the shell's own
- * parser/executor to preserve function definitions.
+ * Forks a child process to execute the command and captures its stdout,
+ * reading concurrently so large outputs cannot fill the pipe and stall.
+ * Bodies that are a single output-only builtin run in-process without a
+ * fork. Trailing newlines are stripped from the output. Uses the shell's
+ * own parser/executor to preserve function definitions.
  *
  * @param executor Executor context
  * @param cmd_text Command text in $(...) or `...` format
@@ -10144,9 +10341,53 @@ static char *expand_command_substitution(executor_t *executor,
     }
     command = expanded_command;
 
+    // Parse once in the parent: the child inherits the AST through fork,
+    // and simple builtin substitutions can skip the fork entirely
+    const char *src_name = executor->current_script_file
+                               ? executor->current_script_file
+                               : "<command substitution>";
+    lle_arena_t *arena = get_parse_arena(executor);
+    lle_arena_scratch_t parse_scope = lle_arena_scratch_begin(arena);
+    parser_t *parser = parser_new_in_arena(command, src_name, arena);
+    node_t *ast = NULL;
+    if (parser) {
+        ast = parser_parse(parser);
+        if (parser_has_error(parser) && ast) {
+            free_node_tree(ast);
+            ast = NULL;
+        }
+    }
+
+    if (!ast) {
+        if (parser) {
+            parser_free(parser);
+        }
+        lle_arena_scratch_end(&parse_scope);
+        free(command);
+        executor->exit_status = 127;
+        return strdup("");
+    }
+
+    size_t output_len = 0;
+    char *output = NULL;
+
+    if (substitution_runs_in_process(executor, ast, command)) {
+        output = run_substitution_builtin(executor, ast, &output_len);
+        if (output) {
+            free_node_tree(ast);
+            parser_free(parser);
+            lle_arena_scratch_end(&parse_scope);
+            free(command);
+            return finish_substitution_output(output, output_len);
+        }
+    }
+
     // Create a pipe to capture command output
     int pipefd[2];
     if (pipe(pipefd) == -1) {
+        free_node_tree(ast);
+        parser_free(parser);
+        lle_arena_scratch_end(&parse_scope);
         free(command);
         return strdup("");
     }
@@ -10155,223 +10396,84 @@ static char *expand_command_substitution(executor_t *executor,
     if (pid == -1) {
         close(pipefd[0]);
         close(pipefd[1]);
+        free_node_tree(ast);
+        parser_free(parser);
+        lle_arena_scratch_end(&parse_scope);
         free(command);
         return strdup("");
     }
 
     if (pid == 0) {
-        // Child process - execute command using lush's own parser/executor
+        // Child process - execute command using lush's own executor
         close(pipefd[0]);               // Close read end
         dup2(pipefd[1], STDOUT_FILENO); // Redirect stdout to pipe
         close(pipefd[1]);
 
-        // Parse and execute command using lush's own parser/executor
-        // This preserves all function definitions and variables in the child
-        const char *src_name = executor->current_script_file 
-                               ? executor->current_script_file 
-                               : "<command substitution>";
-        parser_t *parser = parser_new_with_source(command, src_name);
-        int result = 127;
-
-        if (parser) {
-            node_t *ast = parser_parse(parser);
-            if (!parser_has_error(parser) && ast) {
-                // Execute in current context (functions are inherited via fork)
-                // Use executor_execute to handle command sequences (next_sibling)
-                result = executor_execute(executor, ast);
-                free_node_tree(ast);
-            }
-            parser_free(parser);
-        }
+        // Execute in current context (functions are inherited via fork)
+        // Use executor_execute to handle command sequences (next_sibling)
+        int result = executor_execute(executor, ast);
+        free_node_tree(ast);
+        parser_free(parser);
 
         // Ensure all output is flushed before exit
         fflush(stdout);
         free(command);
         subshell_cleanup();
         _exit(result);
-    } else {
-        // Parent process - read output
-        close(pipefd[1]); // Close write end
-        free(command);
-
-        char *output = malloc(1024);
-        size_t output_size = 1024;
-        size_t output_len = 0;
-
-        if (!output) {
-            close(pipefd[0]);
-            while (waitpid(pid, NULL, 0) == -1 && errno == EINTR)
-                ;
-            return strdup("");
-        }
-
-        ssize_t bytes_read;
-        char buffer[256];
-
-        // Wait for child process to complete first, retrying on EINTR
-        int status;
-        while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
-            ;
-
-        // Propagate child's exit status to executor for $? access
-        if (WIFEXITED(status)) {
-            executor->exit_status = WEXITSTATUS(status);
-        } else if (WIFSIGNALED(status)) {
-            executor->exit_status = 128 + WTERMSIG(status);
-        }
-
-        // Then read all available output
-        while ((bytes_read = read(pipefd[0], buffer, sizeof(buffer))) > 0) {
-            if (output_len + bytes_read >= output_size) {
-                output_size *= 2;
-                char *new_output = realloc(output, output_size);
-                if (!new_output) {
-                    free(output);
-                    close(pipefd[0]);
-                    return strdup("");
-                }
-                output = new_output;
-            }
-            memcpy(output + output_len, buffer, bytes_read);
-            output_len += bytes_read;
-        }
-
-        close(pipefd[0]);
-
-        // Null-terminate the output buffer before string operations
-        if (output_len >= output_size) {
-            char *new_output = realloc(output, output_size + 1);
-            if (new_output) {
-                output = new_output;
-            }
-        }
-        output[output_len] = '\0';
-
-        // Check for return value marker in output
-        const char *return_marker = "__LUSH_RETURN__:";
-        const char *end_marker = ":__END__";
-        char *marker_pos = strstr(output, return_marker);
+    }
 
-        if (marker_pos) {
-            // Found return value marker, extract the return value
-            char *value_start = marker_pos + strlen(return_marker);
-            char *value_end = strstr(value_start, end_marker);
+    // Parent process - read while the child runs so output larger than the
+    // pipe buffer cannot stall it, then reap it once the pipe reaches EOF
+    close(pipefd[1]); // Close write end
+    free_node_tree(ast);
+    parser_free(parser);
+    lle_arena_scratch_end(&parse_scope);
+    free(command);
 
-            if (value_end) {
-                // Extract the return value
-                size_t value_len = value_end - value_start;
-                char *return_value = malloc(value_len + 1);
-                if (return_value) {
-                    strncpy(return_value, value_start, value_len);
-                    return_value[value_len] = '\0';
+    output = read_fd_to_end(pipefd[0], &output_len);
+    close(pipefd[0]);
 
-                    // Clean up the original output
-                    free(output);
-                    return return_value;
-                }
-            }
-        }
+    // Retry on EINTR
+    int status = 0;
+    while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+        ;
 
-        // Null terminate and remove trailing newlines
-        output[output_len] = '\0';
-        while (output_len > 0 && (output[output_len - 1] == '\n' ||
-                                  output[output_len - 1] == '\r')) {
-            output[--output_len] = '\0';
-        }
+    // Propagate child's exit status to executor for $? access
+    if (WIFEXITED(status)) {
+        executor->exit_status = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        executor->exit_status = 128 + WTERMSIG(status);
+    }
 
-        return output;
+    if (!output) {
+        return strdup("");
     }
+    return finish_substitution_output(output, output_len);
 }
 
 /**
- * @brief Copy function definitions between executors
+ * @brief Share function definitions between executors
  *
- * Copies all function definitions from source to destination executor.
- * Used when creating child executors that need access to parent functions.
+ * Gives the destination executor a reference to every function definition
+ * of the source executor. Used when creating child executors that need
+ * access to parent functions; bodies are shared, not copied.
  *
  * @param dest Destination executor
  * @param src Source executor
  */
-MAYBE_UNUSED
-static void copy_function_definitions(executor_t *dest, executor_t *src) {
-    if (!dest || !src) {
+static void share_function_definitions(executor_t *dest, executor_t *src) {
+    if (!dest || !src || !src->functions) {
         return;
     }
 
-    function_def_t *src_func = src->functions;
-    while (src_func) {
-        // Create a copy of the function definition
-        function_def_t *new_func = malloc(sizeof(function_def_t));
-        if (!new_func) {
-            break;
-        }
-
-        new_func->name = strdup(src_func->name);
-        if (!new_func->name) {
-            free(new_func);
-            break;
-        }
-
-        // Create a simple copy of the function body AST
-        new_func->body = copy_node_simple(src_func->body);
-        if (!new_func->body) {
-            free(new_func->name);
-            free(new_func);
+    ht_enum_t *it = ht_enum_create(src->functions);
+    const void *val;
+    while (it && ht_enum_next(it, NULL, &val)) {
+        if (function_table_put(dest, (function_def_t *)val) != 0) {
             break;
         }
-
-        // Add to destination's function list
-        new_func->next = dest->functions;
-        dest->functions = new_func;
-
-        src_func = src_func->next;
-    }
-}
-
-/**
- * @brief Simple recursive node copy
- *
- * Creates a copy of an AST node and its children. Simpler than
- * copy_ast_node, used for function definition copying.
- *
- * @param original Node to copy
- * @return Copy of node tree, or NULL on failure
- */
-static node_t *copy_node_simple(node_t *original) {
-    if (!original) {
-        return NULL;
-    }
-
-    node_t *copy = new_node(original->type);
-    if (!copy) {
-        return NULL;
-    }
-
-    copy->val_type = original->val_type;
-    copy->val = original->val;
-
-    // If the node has a string value, copy it
-    if (original->val_type == VAL_STR && original->val.str) {
-        copy->val.str = strdup(original->val.str);
-        if (!copy->val.str) {
-            free_node_tree(copy);
-            return NULL;
-        }
-    }
-
-    // Copy children recursively
-    node_t *child = original->first_child;
-    while (child) {
-        node_t *child_copy = copy_node_simple(child);
-        if (!child_copy) {
-            free_node_tree(copy);
-            return NULL;
-        }
-        add_child_node(copy, child_copy);
-        child = child->next_sibling;
     }
-
-    return copy;
+    ht_enum_destroy(it);
 }
 
 /**
@@ -11750,7 +11852,8 @@ static int execute_arithmetic_command(executor_t *executor,
 /**
  * @brief Match a string against a glob pattern
  *
- * Uses fnmatch for shell-style pattern matching.
+ * Uses the cached pattern matcher; extglob groups are recognized when
+ * the shell mode enables them.
  *
  * @param str String to match
  * @param pattern Glob pattern
@@ -11760,8 +11863,8 @@ static bool extended_test_pattern_match(const char *str, const char *pattern) {
     if (!str || !pattern) {
         return false;
     }
-    // FNM_EXTMATCH would enable extended patterns, but isn't portable
-    return fnmatch(pattern, str, 0) == 0;
+    int flags = shell_mode_allows(FEATURE_EXTENDED_GLOB) ? GLOB_PATTERN_EXTGLOB : 0;
+    return glob_match(pattern, str, flags);
 }
 
 /**
@@ -12755,8 +12858,8 @@ char *expand_process_substitution(executor_t *executor, node_t *proc_sub) {
             _exit(1);
         }
 
-        // Copy function definitions to child
-        copy_function_definitions(child_executor, executor);
+        // Share function definitions with child
+        share_function_definitions(child_executor, executor);
 
         // Execute each command in the process substitution
         int result = 0;
@@ -12874,7 +12977,7 @@ int executor_call_hook(executor_t *executor, const char *hook_name,
     }
 
     // Call the function
-    int result = execute_function_call(executor, hook_name, argv, argc);
+    int result = execute_function_call(executor, func, argv, argc);
 
     // Handle return code translation (200-455 range is internal return signal)
     if (result >= 200 && result <= 455) {
@@ -0,0 +1,1152 @@
+/**
+ * @file glob_pattern.c
+ * @brief Compiled shell pattern matching
+ *
+ * A pattern is compiled once into a small program:
+ *
+ *   GP_CHAR c     match one byte
+ *   GP_ANY        match one character
+ *   GP_CLASS n    match one character against bracket expression n
+ *   GP_STAR       match any run of characters
+ *   GP_SPLIT x,y  try x, then y
+ *   GP_JMP x      continue at x
+ *   GP_NOT x      the sub-program [pc+1, x) is a !(...) body; continue at x
+ *                 from every end position whose substring it does not match
+ *   GP_MATCH      end of the (sub-)program
+ *
+ * Programs made only of characters, classes and stars are matched with the
+ * linear two-pointer wildcard algorithm. Anything with groups runs on a
+ * backtracker that remembers visited (instruction, position) states, so
+ * each state is explored once and matching is O(program * string) even
+ * for patterns like *(a|aa)b that explode with naive backtracking.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "glob_pattern.h"
+
+#include "ht.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wctype.h>
+
+/** Compiled patterns kept before the cache is flushed */
+#define GLOB_PATTERN_CACHE_MAX 256
+
+/** Visited-state bitmap size that fits on the stack */
+#define VISITED_STACK_BYTES 512
+
+/** Backtrack stack entries that fit on the stack */
+#define BACKTRACK_STACK_SIZE 64
+
+/** Codepoint assigned to bytes that are not valid UTF-8 */
+#define INVALID_BYTE_BASE 0x110000u
+
+typedef enum {
+    GP_CHAR,
+    GP_ANY,
+    GP_CLASS,
+    GP_STAR,
+    GP_SPLIT,
+    GP_JMP,
+    GP_NOT,
+    GP_MATCH
+} gp_opcode_t;
+
+/**
+ * @brief One program instruction
+ */
+typedef struct gp_insn {
+    gp_opcode_t op;
+    size_t x; // Byte, class index or first target
+    size_t y; // Second target (GP_SPLIT)
+} gp_insn_t;
+
+/**
+ * @brief Codepoint range in a bracket expression
+ */
+typedef struct gp_range {
+    uint32_t lo;
+    uint32_t hi;
+} gp_range_t;
+
+/**
+ * @brief Compiled bracket expression
+ */
+typedef struct gp_class {
+    uint32_t ascii[4];  // Bitmap of matching ASCII characters
+    gp_range_t *ranges; // Non-ASCII members
+    size_t range_count;
+    wctype_t *types;    // [:name:] classes for non-ASCII characters
+    size_t type_count;
+    bool negated;
+} gp_class_t;
+
+struct glob_pattern {
+    gp_insn_t *code;
+    size_t code_len;
+    gp_class_t *classes;
+    size_t class_count;
+    bool simple; // Only GP_CHAR, GP_ANY, GP_CLASS and GP_STAR
+    char *key;   // Cache key, or NULL if not cached
+};
+
+/**
+ * @brief Pattern compiler state
+ */
+typedef struct gp_compiler {
+    glob_pattern_t *pat;
+    size_t code_cap;
+    size_t class_cap;
+    int flags;
+    bool failed; // Allocation failure
+} gp_compiler_t;
+
+/**
+ * @brief Backtracking matcher state
+ */
+typedef struct gp_run {
+    const glob_pattern_t *pat;
+    const char *str;
+    size_t start; // First position of the run
+    size_t len;   // End of the subject string
+    bool *accept; // Prefix mode: positions where GP_MATCH was reached
+} gp_run_t;
+
+static ht_t *pattern_cache = NULL;
+static glob_pattern_cache_stats_t cache_stats;
+
+/* ============================================================================
+ * UTF-8 HELPERS
+ * ============================================================================
+ */
+
+/**
+ * @brief Decode one character
+ *
+ * Bytes that do not start a complete, valid UTF-8 sequence decode to a
+ * codepoint above the Unicode range so they only match ?, * and negated
+ * bracket expressions.
+ *
+ * @param s String
+ * @param len Bytes available at s (at least 1)
+ * @param cp Output codepoint
+ * @return Length of the character in bytes
+ */
+static size_t decode_char(const char *s, size_t len, uint32_t *cp) {
+    const unsigned char *u = (const unsigned char *)s;
+    size_t n;
+    uint32_t c;
+
+    if (u[0] < 0x80) {
+        *cp = u[0];
+        return 1;
+    } else if ((u[0] & 0xE0) == 0xC0) {
+        n = 2;
+        c = u[0] & 0x1F;
+    } else if ((u[0] & 0xF0) == 0xE0) {
+        n = 3;
+        c = u[0] & 0x0F;
+    } else if ((u[0] & 0xF8) == 0xF0) {
+        n = 4;
+        c = u[0] & 0x07;
+    } else {
+        *cp = INVALID_BYTE_BASE + u[0];
+        return 1;
+    }
+
+    if (n > len) {
+        *cp = INVALID_BYTE_BASE + u[0];
+        return 1;
+    }
+    for (size_t i = 1; i < n; i++) {
+        if ((u[i] & 0xC0) != 0x80) {
+            *cp = INVALID_BYTE_BASE + u[0];
+            return 1;
+        }
+        c = (c << 6) | (u[i] & 0x3F);
+    }
+    *cp = c;
+    return n;
+}
+
+/**
+ * @brief Length of the character at s[pos], for stepping over it
+ */
+static inline size_t char_step(const char *s, size_t pos, size_t len) {
+    if ((unsigned char)s[pos] < 0x80) {
+        return 1;
+    }
+    uint32_t cp;
+    return decode_char(s + pos, len - pos, &cp);
+}
+
+/* ============================================================================
+ * BRACKET EXPRESSIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Find the end of a bracket expression
+ *
+ * A ']' directly after the '[' (or after the negation character) is a
+ * member, and [:name:], [=c=] and [.c.] are skipped as units.
+ *
+ * @param p Pointer to the opening '['
+ * @param end End of the pattern text
+ * @param flags Compile flags
+ * @return Pointer past the closing ']', or NULL if unterminated
+ */
+static const char *bracket_end(const char *p, const char *end, int flags) {
+    p++;
+    if (p < end && (*p == '!' || *p == '^')) {
+        p++;
+    }
+    if (p < end && *p == ']') {
+        p++;
+    }
+    while (p < end) {
+        if (*p == ']') {
+            return p + 1;
+        }
+        if (*p == '[' && p + 1 < end &&
+            (p[1] == ':' || p[1] == '=' || p[1] == '.')) {
+            char delim = p[1];
+            const char *q = p + 2;
+            while (q + 1 < end && !(q[0] == delim && q[1] == ']')) {
+                q++;
+            }
+            if (q + 1 < end) {
+                p = q + 2;
+                continue;
+            }
+        }
+        if (*p == '\\' && !(flags & GLOB_PATTERN_NOESCAPE) && p + 1 < end) {
+            p++;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Add a codepoint range to a class
+ */
+static void class_add_range(gp_compiler_t *c, gp_class_t *cls, uint32_t lo,
+                            uint32_t hi) {
+    if (hi < lo) {
+        return;
+    }
+    for (; lo <= hi && lo < 0x80; lo++) {
+        cls->ascii[lo >> 5] |= 1u << (lo & 31);
+    }
+    if (lo > hi) {
+        return;
+    }
+
+    gp_range_t *ranges =
+        realloc(cls->ranges, (cls->range_count + 1) * sizeof(gp_range_t));
+    if (!ranges) {
+        c->failed = true;
+        return;
+    }
+    cls->ranges = ranges;
+    cls->ranges[cls->range_count].lo = lo;
+    cls->ranges[cls->range_count].hi = hi;
+    cls->range_count++;
+}
+
+/**
+ * @brief Add a [:name:] character class to a class
+ *
+ * ASCII members are resolved into the bitmap now; the class type is kept
+ * for testing other characters. Unknown names match nothing.
+ */
+static void class_add_type(gp_compiler_t *c, gp_class_t *cls, const char *name,
+                           size_t name_len) {
+    char buf[32];
+    if (name_len >= sizeof(buf)) {
+        return;
+    }
+    memcpy(buf, name, name_len);
+    buf[name_len] = '\0';
+
+    wctype_t type = wctype(buf);
+    if (type == 0) {
+        return;
+    }
+
+    for (uint32_t ch = 0; ch < 0x80; ch++) {
+        if (iswctype((wint_t)ch, type)) {
+            cls->ascii[ch >> 5] |= 1u << (ch & 31);
+        }
+    }
+
+    wctype_t *types =
+        realloc(cls->types, (cls->type_count + 1) * sizeof(wctype_t));
+    if (!types) {
+        c->failed = true;
+        return;
+    }
+    cls->types = types;
+    cls->types[cls->type_count++] = type;
+}
+
+/**
+ * @brief Read one bracket member character, honoring escapes
+ *
+ * @return Pointer past the character
+ */
+static const char *class_read_char(const char *p, const char *end, int flags,
+                                   uint32_t *cp) {
+    if (*p == '\\' && !(flags & GLOB_PATTERN_NOESCAPE) && p + 1 < end) {
+        p++;
+    }
+    return p + decode_char(p, (size_t)(end - p), cp);
+}
+
+/**
+ * @brief Compile the bracket expression [p, close) into a new class
+ *
+ * @param c Compiler
+ * @param p Pointer to the opening '['
+ * @param close Pointer past the closing ']' (from bracket_end)
+ * @return Class index
+ */
+static size_t compile_class(gp_compiler_t *c, const char *p,
+                            const char *close) {
+    glob_pattern_t *pat = c->pat;
+    if (pat->class_count == c->class_cap) {
+        size_t cap = c->class_cap ? c->class_cap * 2 : 4;
+        gp_class_t *classes = realloc(pat->classes, cap * sizeof(gp_class_t));
+        if (!classes) {
+            c->failed = true;
+            return 0;
+        }
+        pat->classes = classes;
+        c->class_cap = cap;
+    }
+
+    size_t index = pat->class_count++;
+    gp_class_t *cls = &pat->classes[index];
+    memset(cls, 0, sizeof(*cls));
+
+    const char *end = close - 1; // The closing ']'
+    p++;
+    if (*p == '!' || *p == '^') {
+        cls->negated = true;
+        p++;
+    }
+
+    bool first = true;
+    while (p < end) {
+        if (*p == '[' && p + 1 < end &&
+            (p[1] == ':' || p[1] == '=' || p[1] == '.')) {
+            char delim = p[1];
+            const char *name = p + 2;
+            const char *q = name;
+            while (q + 1 < end && !(q[0] == delim && q[1] == ']')) {
+                q++;
+            }
+            if (q + 1 < end) {
+                if (delim == ':') {
+                    class_add_type(c, cls, name, (size_t)(q - name));
+                } else if (q > name) {
+                    uint32_t cp;
+                    decode_char(name, (size_t)(q - name), &cp);
+                    class_add_range(c, cls, cp, cp);
+                }
+                p = q + 2;
+                first = false;
+                continue;
+            }
+        }
+
+        uint32_t lo;
+        const char *next;
+        if (first && *p == ']') {
+            lo = ']';
+            next = p + 1;
+        } else {
+            next = class_read_char(p, end, c->flags, &lo);
+        }
+        first = false;
+
+        if (next + 1 < end && *next == '-') {
+            uint32_t hi;
+            p = class_read_char(next + 1, end, c->flags, &hi);
+            class_add_range(c, cls, lo, hi);
+        } else {
+            class_add_range(c, cls, lo, lo);
+            p = next;
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Test a character against a class
+ */
+static bool class_match(const gp_class_t *cls, uint32_t cp) {
+    bool found = false;
+    if (cp < 0x80) {
+        found = (cls->ascii[cp >> 5] >> (cp & 31)) & 1u;
+    } else if (cp < INVALID_BYTE_BASE) {
+        for (size_t i = 0; i < cls->range_count && !found; i++) {
+            found = cp >= cls->ranges[i].lo && cp <= cls->ranges[i].hi;
+        }
+        for (size_t i = 0; i < cls->type_count && !found; i++) {
+            found = iswctype((wint_t)cp, cls->types[i]) != 0;
+        }
+    }
+    return found != cls->negated;
+}
+
+/* ============================================================================
+ * COMPILER
+ * ============================================================================
+ */
+
+/**
+ * @brief Append an instruction
+ */
+static void emit(gp_compiler_t *c, gp_opcode_t op, size_t x, size_t y) {
+    glob_pattern_t *pat = c->pat;
+    if (pat->code_len == c->code_cap) {
+        size_t cap = c->code_cap ? c->code_cap * 2 : 16;
+        gp_insn_t *code = realloc(pat->code, cap * sizeof(gp_insn_t));
+        if (!code) {
+            c->failed = true;
+            return;
+        }
+        pat->code = code;
+        c->code_cap = cap;
+    }
+    pat->code[pat->code_len].op = op;
+    pat->code[pat->code_len].x = x;
+    pat->code[pat->code_len].y = y;
+    pat->code_len++;
+}
+
+/**
+ * @brief Insert an instruction at position at, shifting what follows
+ *
+ * Jump targets inside the shifted instructions that point at or past the
+ * insertion point move with them. Instructions before the insertion point
+ * keep their targets, so a jump to at now reaches the new instruction.
+ */
+static void insert_insn(gp_compiler_t *c, size_t at, gp_opcode_t op, size_t x,
+                        size_t y) {
+    emit(c, GP_MATCH, 0, 0); // Make room
+    if (c->failed) {
+        return;
+    }
+
+    glob_pattern_t *pat = c->pat;
+    memmove(&pat->code[at + 1], &pat->code[at],
+            (pat->code_len - 1 - at) * sizeof(gp_insn_t));
+    for (size_t i = at + 1; i < pat->code_len; i++) {
+        gp_insn_t *insn = &pat->code[i];
+        if (insn->op == GP_SPLIT || insn->op == GP_JMP || insn->op == GP_NOT) {
+            if (insn->x >= at) {
+                insn->x++;
+            }
+        }
+        if (insn->op == GP_SPLIT && insn->y >= at) {
+            insn->y++;
+        }
+    }
+    pat->code[at].op = op;
+    pat->code[at].x = x;
+    pat->code[at].y = y;
+}
+
+/**
+ * @brief Apply a group or repetition operator to the code [a, end)
+ *
+ * @param op One of ? * + @ ! (as in the extglob syntax)
+ */
+static void wrap_atom(gp_compiler_t *c, size_t a, char op) {
+    size_t b = c->pat->code_len;
+    switch (op) {
+    case '*':
+        insert_insn(c, a, GP_SPLIT, a + 1, b + 2);
+        emit(c, GP_JMP, a, 0);
+        break;
+    case '+':
+        emit(c, GP_SPLIT, a, b + 1);
+        break;
+    case '?':
+        insert_insn(c, a, GP_SPLIT, a + 1, b + 1);
+        break;
+    case '!':
+        insert_insn(c, a, GP_NOT, b + 2, 0);
+        emit(c, GP_MATCH, 0, 0);
+        break;
+    default:
+        break;
+    }
+}
+
+static const char *group_end(const char *p, const char *end, int flags);
+
+/**
+ * @brief Check for a group opener at p
+ *
+ * @return Length of the opener (2 for "op(", 1 for a zsh "("), or 0
+ */
+static size_t group_opener(const char *p, const char *end, int flags) {
+    if ((flags & GLOB_PATTERN_EXTGLOB) && p + 1 < end && p[1] == '(' &&
+        strchr("?*+@!", *p)) {
+        return 2;
+    }
+    if ((flags & GLOB_PATTERN_ZSH) && *p == '(') {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Skip one pattern token
+ *
+ * @return Pointer past the token
+ */
+static const char *skip_token(const char *p, const char *end, int flags) {
+    if (*p == '\\' && !(flags & GLOB_PATTERN_NOESCAPE) && p + 1 < end) {
+        return p + 2;
+    }
+    if (*p == '[') {
+        const char *close = bracket_end(p, end, flags);
+        if (close) {
+            return close;
+        }
+    }
+    size_t open = group_opener(p, end, flags);
+    if (open) {
+        const char *close = group_end(p + open, end, flags);
+        if (close) {
+            return close + 1;
+        }
+    }
+    return p + 1;
+}
+
+/**
+ * @brief Find the ')' closing a group whose body starts at p
+ *
+ * @return Pointer to the ')', or NULL if unterminated
+ */
+static const char *group_end(const char *p, const char *end, int flags) {
+    while (p < end) {
+        if (*p == ')') {
+            return p;
+        }
+        p = skip_token(p, end, flags);
+    }
+    return NULL;
+}
+
+static void compile_alternatives(gp_compiler_t *c, const char *p,
+                                 const char *end);
+
+/**
+ * @brief Emit a literal character (all of its bytes)
+ *
+ * @return Pointer past the character
+ */
+static const char *compile_literal(gp_compiler_t *c, const char *p,
+                                   const char *end) {
+    uint32_t cp;
+    size_t n = decode_char(p, (size_t)(end - p), &cp);
+    for (size_t i = 0; i < n; i++) {
+        emit(c, GP_CHAR, (unsigned char)p[i], 0);
+    }
+    return p + n;
+}
+
+/**
+ * @brief Compile a sequence of atoms (no top-level alternation)
+ */
+static void compile_sequence(gp_compiler_t *c, const char *p,
+                             const char *end) {
+    bool have_atom = false; // A previous atom that zsh # may repeat
+    bool after_star = false;
+    size_t atom = 0; // Start of the previous atom's code
+
+    while (p < end && !c->failed) {
+        size_t start = c->pat->code_len;
+        size_t open = group_opener(p, end, c->flags);
+        const char *close = open ? group_end(p + open, end, c->flags) : NULL;
+        const char *bend = NULL;
+
+        if (close) {
+            char op = open == 2 ? *p : '@';
+            compile_alternatives(c, p + open, close);
+            wrap_atom(c, start, op);
+            p = close + 1;
+        } else if ((c->flags & GLOB_PATTERN_ZSH) && *p == '#' && have_atom) {
+            bool plus = p + 1 < end && p[1] == '#';
+            wrap_atom(c, atom, plus ? '+' : '*');
+            p += plus ? 2 : 1;
+            have_atom = false;
+            continue;
+        } else if (*p == '*') {
+            if (!after_star) {
+                emit(c, GP_STAR, 0, 0);
+            }
+            p++;
+            have_atom = false;
+            after_star = true;
+            continue;
+        } else if (*p == '?') {
+            emit(c, GP_ANY, 0, 0);
+            p++;
+        } else if (*p == '[' && (bend = bracket_end(p, end, c->flags))) {
+            size_t index = compile_class(c, p, bend);
+            emit(c, GP_CLASS, index, 0);
+            p = bend;
+        } else if (*p == '\\' && !(c->flags & GLOB_PATTERN_NOESCAPE) &&
+                   p + 1 < end) {
+            p = compile_literal(c, p + 1, end);
+        } else {
+            p = compile_literal(c, p, end);
+        }
+        have_atom = true;
+        after_star = false;
+        atom = start;
+    }
+}
+
+/**
+ * @brief Compile '|'-separated alternatives
+ */
+static void compile_alternatives(gp_compiler_t *c, const char *p,
+                                 const char *end) {
+    size_t *jumps = NULL;
+    size_t jump_count = 0;
+
+    for (;;) {
+        const char *bar = p;
+        while (bar < end && *bar != '|') {
+            bar = skip_token(bar, end, c->flags);
+        }
+        if (bar >= end) {
+            compile_sequence(c, p, end);
+            break;
+        }
+
+        size_t split = c->pat->code_len;
+        emit(c, GP_SPLIT, split + 1, 0);
+        compile_sequence(c, p, bar);
+
+        size_t *grown = realloc(jumps, (jump_count + 1) * sizeof(size_t));
+        if (!grown) {
+            c->failed = true;
+            break;
+        }
+        jumps = grown;
+        jumps[jump_count++] = c->pat->code_len;
+        emit(c, GP_JMP, 0, 0);
+        if (c->failed) {
+            break;
+        }
+        c->pat->code[split].y = c->pat->code_len;
+        p = bar + 1;
+    }
+
+    if (!c->failed) {
+        for (size_t i = 0; i < jump_count; i++) {
+            c->pat->code[jumps[i]].x = c->pat->code_len;
+        }
+    }
+    free(jumps);
+}
+
+glob_pattern_t *glob_pattern_compile(const char *pattern, int flags) {
+    if (!pattern) {
+        return NULL;
+    }
+
+    glob_pattern_t *pat = calloc(1, sizeof(glob_pattern_t));
+    if (!pat) {
+        return NULL;
+    }
+
+    gp_compiler_t c = {.pat = pat, .flags = flags};
+    const char *end = pattern + strlen(pattern);
+
+    /* Top-level '|' is literal; only groups introduce alternation */
+    compile_sequence(&c, pattern, end);
+    emit(&c, GP_MATCH, 0, 0);
+
+    if (c.failed) {
+        glob_pattern_free(pat);
+        return NULL;
+    }
+
+    pat->simple = true;
+    for (size_t i = 0; i < pat->code_len; i++) {
+        gp_opcode_t op = pat->code[i].op;
+        if (op == GP_SPLIT || op == GP_JMP || op == GP_NOT) {
+            pat->simple = false;
+            break;
+        }
+    }
+    return pat;
+}
+
+void glob_pattern_free(glob_pattern_t *pattern) {
+    if (!pattern) {
+        return;
+    }
+    for (size_t i = 0; i < pattern->class_count; i++) {
+        free(pattern->classes[i].ranges);
+        free(pattern->classes[i].types);
+    }
+    free(pattern->classes);
+    free(pattern->code);
+    free(pattern->key);
+    free(pattern);
+}
+
+/* ============================================================================
+ * MATCHING
+ * ============================================================================
+ */
+
+/**
+ * @brief Try to consume one character with a GP_CHAR/GP_ANY/GP_CLASS
+ *
+ * @return Bytes consumed, or 0 if the instruction does not match
+ */
+static inline size_t match_one(const glob_pattern_t *pat, const gp_insn_t *insn,
+                               const char *s, size_t pos, size_t len) {
+    if (pos >= len) {
+        return 0;
+    }
+    switch (insn->op) {
+    case GP_CHAR:
+        return (unsigned char)s[pos] == insn->x ? 1 : 0;
+    case GP_ANY:
+        return char_step(s, pos, len);
+    case GP_CLASS: {
+        uint32_t cp;
+        size_t n = decode_char(s + pos, len - pos, &cp);
+        return class_match(&pat->classes[insn->x], cp) ? n : 0;
+    }
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Match a program without groups
+ *
+ * Classic wildcard matching: on mismatch, resume just after the most
+ * recent star with one more character consumed by it. Earlier stars never
+ * need revisiting, so this is O(pattern * string) in the worst case.
+ */
+static bool match_simple(const glob_pattern_t *pat, const char *s,
+                         size_t len) {
+    const gp_insn_t *code = pat->code;
+    size_t pc = 0;
+    size_t pos = 0;
+    bool have_star = false;
+    size_t star_pc = 0;
+    size_t star_pos = 0;
+
+    for (;;) {
+        const gp_insn_t *insn = &code[pc];
+        if (insn->op == GP_STAR) {
+            if (code[pc + 1].op == GP_MATCH) {
+                return true;
+            }
+            have_star = true;
+            star_pc = ++pc;
+            star_pos = pos;
+            continue;
+        }
+        if (insn->op == GP_MATCH) {
+            if (pos == len) {
+                return true;
+            }
+        } else {
+            size_t n = match_one(pat, insn, s, pos, len);
+            if (n) {
+                pos += n;
+                pc++;
+                continue;
+            }
+        }
+
+        if (!have_star || star_pos >= len) {
+            return false;
+        }
+        star_pos += char_step(s, star_pos, len);
+        pos = star_pos;
+        pc = star_pc;
+    }
+}
+
+/**
+ * @brief Backtrack stack entry
+ */
+typedef struct gp_state {
+    size_t pc;
+    size_t pos;
+} gp_state_t;
+
+static bool run_program(const gp_run_t *run, size_t start_pc);
+
+/**
+ * @brief Handle GP_NOT: push continuations for unmatched substrings
+ *
+ * Runs the negated body once in prefix mode to learn every end position
+ * it can match from pos; every other character boundary continues at the
+ * instruction after the body.
+ *
+ * @return false on allocation failure
+ */
+static bool expand_not(const gp_run_t *run, size_t pc, size_t pos,
+                       gp_state_t **stack, size_t *count, size_t *cap,
+                       gp_state_t *stack_buf) {
+    size_t span = run->len - pos + 1;
+    bool accept_buf[256];
+    bool *accept = span <= sizeof(accept_buf) ? accept_buf
+                                               : calloc(span, sizeof(bool));
+    if (!accept) {
+        return false;
+    }
+    memset(accept, 0, span * sizeof(bool));
+
+    gp_run_t sub = *run;
+    sub.start = pos;
+    sub.accept = accept;
+    run_program(&sub, pc + 1);
+
+    size_t next = run->pat->code[pc].x;
+    bool ok = true;
+    for (size_t j = pos;; j += char_step(run->str, j, run->len)) {
+        if (!accept[j - pos]) {
+            if (*count == *cap) {
+                size_t new_cap = *cap * 2;
+                gp_state_t *grown;
+                if (*stack == stack_buf) {
+                    grown = malloc(new_cap * sizeof(gp_state_t));
+                    if (grown) {
+                        memcpy(grown, stack_buf, *count * sizeof(gp_state_t));
+                    }
+                } else {
+                    grown = realloc(*stack, new_cap * sizeof(gp_state_t));
+                }
+                if (!grown) {
+                    ok = false;
+                    break;
+                }
+                *stack = grown;
+                *cap = new_cap;
+            }
+            (*stack)[*count].pc = next;
+            (*stack)[*count].pos = j;
+            (*count)++;
+        }
+        if (j >= run->len) {
+            break;
+        }
+    }
+
+    if (accept != accept_buf) {
+        free(accept);
+    }
+    return ok;
+}
+
+/**
+ * @brief Run a program with memoized backtracking
+ *
+ * Without an accept array, returns true as soon as GP_MATCH is reached at
+ * the end of the string. With one, explores every path and records each
+ * position where GP_MATCH is reached (positions relative to run->start).
+ *
+ * @return true if any match was found
+ */
+static bool run_program(const gp_run_t *run, size_t start_pc) {
+    const glob_pattern_t *pat = run->pat;
+    size_t span = run->len - run->start + 1;
+    size_t bits = pat->code_len * span;
+    size_t bytes = (bits + 7) / 8;
+
+    unsigned char visited_buf[VISITED_STACK_BYTES];
+    unsigned char *visited =
+        bytes <= sizeof(visited_buf) ? visited_buf : calloc(bytes, 1);
+    if (!visited) {
+        return false;
+    }
+    if (visited == visited_buf) {
+        memset(visited_buf, 0, bytes);
+    }
+
+    gp_state_t stack_buf[BACKTRACK_STACK_SIZE];
+    gp_state_t *stack = stack_buf;
+    size_t cap = BACKTRACK_STACK_SIZE;
+    size_t count = 0;
+    bool found = false;
+    bool failed = false;
+
+    stack[count].pc = start_pc;
+    stack[count].pos = run->start;
+    count++;
+
+    while (count > 0 && !failed) {
+        count--;
+        size_t pc = stack[count].pc;
+        size_t pos = stack[count].pos;
+
+        for (;;) {
+            size_t bit = pc * span + (pos - run->start);
+            if (visited[bit >> 3] & (1u << (bit & 7))) {
+                break;
+            }
+            visited[bit >> 3] |= (unsigned char)(1u << (bit & 7));
+
+            const gp_insn_t *insn = &pat->code[pc];
+            size_t push_pc = 0;
+            size_t push_pos = 0;
+            bool push = false;
+
+            if (insn->op == GP_MATCH) {
+                if (run->accept) {
+                    run->accept[pos - run->start] = true;
+                    found = true;
+                    break;
+                }
+                if (pos == run->len) {
+                    found = true;
+                }
+                break;
+            } else if (insn->op == GP_STAR) {
+                if (pos < run->len) {
+                    push = true;
+                    push_pc = pc;
+                    push_pos = pos + char_step(run->str, pos, run->len);
+                }
+                pc++;
+            } else if (insn->op == GP_SPLIT) {
+                push = true;
+                push_pc = insn->y;
+                push_pos = pos;
+                pc = insn->x;
+            } else if (insn->op == GP_JMP) {
+                pc = insn->x;
+            } else if (insn->op == GP_NOT) {
+                if (!expand_not(run, pc, pos, &stack, &count, &cap,
+                                stack_buf)) {
+                    failed = true;
+                }
+                break;
+            } else {
+                size_t n = match_one(pat, insn, run->str, pos, run->len);
+                if (!n) {
+                    break;
+                }
+                pos += n;
+                pc++;
+            }
+
+            if (push) {
+                if (count == cap) {
+                    size_t new_cap = cap * 2;
+                    gp_state_t *grown;
+                    if (stack == stack_buf) {
+                        grown = malloc(new_cap * sizeof(gp_state_t));
+                        if (grown) {
+                            memcpy(grown, stack_buf, count * sizeof(gp_state_t));
+                        }
+                    } else {
+                        grown = realloc(stack, new_cap * sizeof(gp_state_t));
+                    }
+                    if (!grown) {
+                        failed = true;
+                        break;
+                    }
+                    stack = grown;
+                    cap = new_cap;
+                }
+                stack[count].pc = push_pc;
+                stack[count].pos = push_pos;
+                count++;
+            }
+        }
+
+        if (found && !run->accept) {
+            break;
+        }
+    }
+
+    if (stack != stack_buf) {
+        free(stack);
+    }
+    if (visited != visited_buf) {
+        free(visited);
+    }
+    return found && !failed;
+}
+
+bool glob_pattern_match_n(const glob_pattern_t *pattern, const char *str,
+                          size_t len) {
+    if (!pattern || !str) {
+        return false;
+    }
+    if (pattern->simple) {
+        return match_simple(pattern, str, len);
+    }
+    gp_run_t run = {pattern, str, 0, len, NULL};
+    return run_program(&run, 0);
+}
+
+bool glob_pattern_match(const glob_pattern_t *pattern, const char *str) {
+    if (!str) {
+        return false;
+    }
+    return glob_pattern_match_n(pattern, str, strlen(str));
+}
+
+ssize_t glob_pattern_match_prefix(const glob_pattern_t *pattern,
+                                  const char *str, size_t len, bool longest) {
+    if (!pattern || !str) {
+        return -1;
+    }
+
+    bool *accept = calloc(len + 1, sizeof(bool));
+    if (!accept) {
+        return -1;
+    }
+
+    gp_run_t run = {pattern, str, 0, len, accept};
+    ssize_t result = -1;
+    if (run_program(&run, 0)) {
+        for (size_t i = 0; i <= len; i++) {
+            size_t at = longest ? len - i : i;
+            if (accept[at]) {
+                result = (ssize_t)at;
+                break;
+            }
+        }
+    }
+    free(accept);
+    return result;
+}
+
+ssize_t glob_pattern_match_suffix(const glob_pattern_t *pattern,
+                                  const char *str, size_t len, bool longest) {
+    if (!pattern || !str) {
+        return -1;
+    }
+
+    for (size_t i = 0; i <= len; i++) {
+        size_t start = longest ? i : len - i;
+        if (start < len && ((unsigned char)str[start] & 0xC0) == 0x80) {
+            continue; // Not a character boundary
+        }
+        if (glob_pattern_match_n(pattern, str + start, len - start)) {
+            return (ssize_t)(len - start);
+        }
+    }
+    return -1;
+}
+
+/* ============================================================================
+ * CACHE
+ * ============================================================================
+ */
+
+/**
+ * @brief Free a cached pattern (value free callback)
+ */
+static void cached_pattern_free(const void *val) {
+    glob_pattern_free((glob_pattern_t *)val);
+}
+
+/**
+ * @brief Create an empty cache
+ */
+static ht_t *pattern_cache_create(void) {
+    ht_callbacks_t callbacks = {NULL, NULL, NULL, cached_pattern_free};
+    return ht_create(fnv1a_hash_str, str_eq, &callbacks,
+                     HT_STR_NONE | HT_SEED_RANDOM);
+}
+
+const glob_pattern_t *glob_pattern_cached(const char *pattern, int flags) {
+    if (!pattern) {
+        return NULL;
+    }
+
+    /* Key is the flags as one character followed by the pattern text */
+    size_t len = strlen(pattern);
+    char key_buf[128];
+    char *key = len + 2 <= sizeof(key_buf) ? key_buf : malloc(len + 2);
+    if (!key) {
+        return NULL;
+    }
+    key[0] = (char)('A' + (flags & 0x0F));
+    memcpy(key + 1, pattern, len + 1);
+
+    glob_pattern_t *pat = pattern_cache ? ht_get(pattern_cache, key) : NULL;
+    if (pat) {
+        cache_stats.hits++;
+        if (key != key_buf) {
+            free(key);
+        }
+        return pat;
+    }
+
+    cache_stats.misses++;
+    pat = glob_pattern_compile(pattern, flags);
+    if (!pat) {
+        if (key != key_buf) {
+            free(key);
+        }
+        return NULL;
+    }
+
+    if (cache_stats.entries >= GLOB_PATTERN_CACHE_MAX) {
+        ht_destroy(pattern_cache);
+        pattern_cache = NULL;
+        cache_stats.entries = 0;
+        cache_stats.flushes++;
+    }
+    if (!pattern_cache) {
+        pattern_cache = pattern_cache_create();
+    }
+
+    pat->key = key == key_buf ? strdup(key_buf) : key;
+    if (!pat->key || !pattern_cache) {
+        glob_pattern_free(pat);
+        return NULL;
+    }
+    ht_insert(pattern_cache, pat->key, pat);
+    cache_stats.entries++;
+    return pat;
+}
+
+bool glob_match(const char *pattern, const char *str, int flags) {
+    const glob_pattern_t *pat = glob_pattern_cached(pattern, flags);
+    return pat && glob_pattern_match(pat, str);
+}
+
+void glob_pattern_cache_clear(void) {
+    if (pattern_cache) {
+        ht_destroy(pattern_cache);
+        pattern_cache = NULL;
+    }
+    cache_stats.entries = 0;
+}
+
+void glob_pattern_get_cache_stats(glob_pattern_cache_stats_t *stats) {
+    if (stats) {
+        *stats = cache_stats;
+    }
+}
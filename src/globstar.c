@@ -0,0 +1,655 @@
+/**
+ * @file globstar.c
+ * @brief Recursive ** pathname expansion
+ *
+ * The pattern is split into components up front; wildcard components are
+ * compiled once with the glob pattern compiler. Each directory is read at
+ * most once per walk: when a ** is followed by a wildcard component, the
+ * same readdir pass both matches that component against the entries and
+ * finds the subdirectories to descend into.
+ *
+ * Directories are opened with openat() relative to their parent, so no
+ * full path is resolved by the kernel more than once. Entry types come
+ * from d_type; stat is only needed when the filesystem reports
+ * DT_UNKNOWN, or a symlink must be classified.
+ *
+ * The walk starts on the calling thread. Once it has read
+ * GLOBSTAR_PARALLEL_THRESHOLD directories it starts worker threads.
+ * From then on, a directory is handed to the shared queue instead of
+ * being descended into locally whenever the queue runs short. Small
+ * trees therefore never pay for thread creation.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "globstar.h"
+
+#include "glob_pattern.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Directories read serially before worker threads are started */
+#define GLOBSTAR_PARALLEL_THRESHOLD 32
+
+/**
+ * @brief One pattern component
+ */
+typedef struct gs_component {
+    char *text;          // Component text (literal name when literal)
+    glob_pattern_t *pat; // Compiled pattern for wildcard components
+    bool globstar;       // The component is exactly **
+    bool literal;        // No wildcards; matched by lookup
+    bool dot;            // Pattern starts with '.', so matches hidden names
+} gs_component_t;
+
+/**
+ * @brief Directory waiting in the shared queue
+ */
+typedef struct gs_item {
+    char *path;  // Directory path including trailing '/'
+    size_t comp; // Component to match inside it
+} gs_item_t;
+
+struct gs_walk;
+
+/**
+ * @brief Per-thread walker state
+ */
+typedef struct gs_walker {
+    struct gs_walk *walk;
+    char *path; // Current path; only [0, len) of each frame is valid
+    size_t cap;
+    globstar_stats_t stats;
+    bool is_main;
+} gs_walker_t;
+
+/**
+ * @brief Shared walk state
+ */
+typedef struct gs_walk {
+    gs_component_t *comps;
+    size_t comp_count;
+    bool only_dirs;
+    bool dotglob;
+    globstar_emit_fn emit;
+    void *emit_ctx;
+
+    int max_workers;
+    bool parallel; // Set by the main walker before threads start
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    gs_item_t *queue;
+    size_t queue_len;
+    size_t queue_cap;
+    int active; // Walkers currently processing a directory
+    atomic_bool failed; // Read without the lock to stop early
+
+    pthread_t threads[GLOBSTAR_MAX_WORKERS];
+    gs_walker_t walkers[GLOBSTAR_MAX_WORKERS];
+    int thread_count;
+} gs_walk_t;
+
+static void process_dir(gs_walker_t *w, int fd, size_t len, size_t comp);
+
+/* ============================================================================
+ * PATTERN COMPONENTS
+ * ============================================================================
+ */
+
+/**
+ * @brief Check whether a component contains pattern syntax
+ */
+static bool component_has_wildcard(const char *text, int flags) {
+    for (const char *p = text; *p; p++) {
+        if (*p == '\\' && !(flags & GLOB_PATTERN_NOESCAPE) && p[1]) {
+            p++;
+        } else if (*p == '*' || *p == '?' || *p == '[') {
+            return true;
+        } else if ((flags & GLOB_PATTERN_EXTGLOB) && p[1] == '(' &&
+                   strchr("+@!", *p)) {
+            return true;
+        } else if ((flags & GLOB_PATTERN_ZSH) && (*p == '(' || *p == '#')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Remove backslash escapes from a literal component in place
+ */
+static void component_unescape(char *text) {
+    char *out = text;
+    for (const char *p = text; *p; p++) {
+        if (*p == '\\' && p[1]) {
+            p++;
+        }
+        *out++ = *p;
+    }
+    *out = '\0';
+}
+
+/**
+ * @brief Free parsed components
+ */
+static void free_components(gs_component_t *comps, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free(comps[i].text);
+        glob_pattern_free(comps[i].pat);
+    }
+    free(comps);
+}
+
+/**
+ * @brief Split a pattern into components
+ *
+ * Empty components (repeated slashes) are dropped and consecutive **
+ * components are merged, since they match the same paths.
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+static int parse_components(gs_walk_t *walk, const char *pattern, int flags) {
+    size_t max = 1;
+    for (const char *p = pattern; *p; p++) {
+        if (*p == '/') {
+            max++;
+        }
+    }
+
+    walk->comps = calloc(max, sizeof(gs_component_t));
+    if (!walk->comps) {
+        return -1;
+    }
+
+    const char *start = pattern;
+    while (*start) {
+        const char *end = strchr(start, '/');
+        size_t len = end ? (size_t)(end - start) : strlen(start);
+        if (!end) {
+            end = start + len;
+        } else if (end[1] == '\0') {
+            walk->only_dirs = true;
+        }
+
+        bool globstar = len == 2 && start[0] == '*' && start[1] == '*';
+        if (len > 0 && !(globstar && walk->comp_count > 0 &&
+                         walk->comps[walk->comp_count - 1].globstar)) {
+            gs_component_t *comp = &walk->comps[walk->comp_count];
+            comp->text = strndup(start, len);
+            if (!comp->text) {
+                return -1;
+            }
+            walk->comp_count++;
+            comp->globstar = globstar;
+            comp->dot = start[0] == '.' ||
+                        (start[0] == '\\' && len > 1 && start[1] == '.');
+            if (!globstar) {
+                if (component_has_wildcard(comp->text, flags)) {
+                    comp->pat = glob_pattern_compile(comp->text, flags);
+                    if (!comp->pat) {
+                        return -1;
+                    }
+                } else {
+                    comp->literal = true;
+                    if (!(flags & GLOB_PATTERN_NOESCAPE)) {
+                        component_unescape(comp->text);
+                    }
+                }
+            }
+        }
+
+        if (*end == '\0') {
+            break;
+        }
+        start = end + 1;
+    }
+    return 0;
+}
+
+/* ============================================================================
+ * WALKER
+ * ============================================================================
+ */
+
+/**
+ * @brief Append a name (and optional '/') to the walker path
+ *
+ * @return New path length, or 0 on allocation failure
+ */
+static size_t path_append(gs_walker_t *w, size_t len, const char *name,
+                          bool slash) {
+    size_t name_len = strlen(name);
+    size_t need = len + name_len + 2;
+    if (need > w->cap) {
+        size_t cap = w->cap ? w->cap : 256;
+        while (cap < need) {
+            cap *= 2;
+        }
+        char *grown = realloc(w->path, cap);
+        if (!grown) {
+            w->walk->failed = true;
+            return 0;
+        }
+        w->path = grown;
+        w->cap = cap;
+    }
+    memcpy(w->path + len, name, name_len);
+    len += name_len;
+    if (slash) {
+        w->path[len++] = '/';
+    }
+    w->path[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Report a match to the caller
+ */
+static void emit_path(gs_walker_t *w, size_t len) {
+    gs_walk_t *walk = w->walk;
+    w->path[len] = '\0';
+    w->stats.matches++;
+
+    bool locked = walk->parallel;
+    if (locked) {
+        pthread_mutex_lock(&walk->lock);
+    }
+    if (!walk->failed && walk->emit(w->path, walk->emit_ctx) != 0) {
+        walk->failed = true;
+    }
+    if (locked) {
+        pthread_mutex_unlock(&walk->lock);
+    }
+}
+
+/**
+ * @brief Whether an entry is a directory, following symlinks
+ */
+static bool entry_is_dir(gs_walker_t *w, int dfd, const char *name,
+                         unsigned char type) {
+    if (type == DT_DIR) {
+        return true;
+    }
+    if (type != DT_LNK && type != DT_UNKNOWN) {
+        return false;
+    }
+    struct stat st;
+    w->stats.stat_calls++;
+    return fstatat(dfd, name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+}
+
+/**
+ * @brief Emit parent/name if it satisfies a trailing '/'
+ */
+static void emit_entry(gs_walker_t *w, int dfd, size_t len, const char *name,
+                       unsigned char type) {
+    bool dir = w->walk->only_dirs;
+    if (dir && !entry_is_dir(w, dfd, name, type)) {
+        return;
+    }
+    size_t new_len = path_append(w, len, name, dir);
+    if (new_len) {
+        emit_path(w, new_len);
+    }
+}
+
+/**
+ * @brief Queue a directory for another walker if the queue is short
+ *
+ * @return true if the directory was queued
+ */
+static bool offer_dir(gs_walker_t *w, size_t len, size_t comp) {
+    gs_walk_t *walk = w->walk;
+    bool queued = false;
+
+    pthread_mutex_lock(&walk->lock);
+    if (walk->queue_len < (size_t)walk->thread_count + 1) {
+        if (walk->queue_len == walk->queue_cap) {
+            size_t cap = walk->queue_cap ? walk->queue_cap * 2 : 16;
+            gs_item_t *grown = realloc(walk->queue, cap * sizeof(gs_item_t));
+            if (grown) {
+                walk->queue = grown;
+                walk->queue_cap = cap;
+            }
+        }
+        char *path = walk->queue_len < walk->queue_cap ? strndup(w->path, len)
+                                                       : NULL;
+        if (path) {
+            walk->queue[walk->queue_len].path = path;
+            walk->queue[walk->queue_len].comp = comp;
+            walk->queue_len++;
+            pthread_cond_signal(&walk->cond);
+            queued = true;
+        }
+    }
+    pthread_mutex_unlock(&walk->lock);
+    return queued;
+}
+
+/**
+ * @brief Continue the walk inside a subdirectory
+ *
+ * @param type d_type of the entry (DT_UNKNOWN if not known)
+ * @param nofollow Do not descend through a symbolic link
+ */
+static void descend(gs_walker_t *w, int dfd, size_t len, const char *name,
+                    unsigned char type, size_t comp, bool nofollow) {
+    if (type != DT_DIR && type != DT_UNKNOWN && (type != DT_LNK || nofollow)) {
+        return;
+    }
+
+    size_t new_len = path_append(w, len, name, true);
+    if (!new_len) {
+        return;
+    }
+
+    /* Only hand off entries known to be real directories */
+    if (w->walk->parallel && type == DT_DIR && offer_dir(w, new_len, comp)) {
+        return;
+    }
+
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+    if (nofollow) {
+        flags |= O_NOFOLLOW;
+    }
+    int fd = openat(dfd, name, flags);
+    if (fd >= 0) {
+        process_dir(w, fd, new_len, comp);
+    }
+}
+
+/**
+ * @brief Match a literal component by lookup
+ */
+static void literal_step(gs_walker_t *w, int fd, size_t len, size_t comp) {
+    gs_walk_t *walk = w->walk;
+    const char *name = walk->comps[comp].text;
+
+    if (comp + 1 == walk->comp_count) {
+        struct stat st;
+        w->stats.stat_calls++;
+        int flags = walk->only_dirs ? 0 : AT_SYMLINK_NOFOLLOW;
+        if (fstatat(fd, name, &st, flags) == 0 &&
+            (!walk->only_dirs || S_ISDIR(st.st_mode))) {
+            size_t new_len = path_append(w, len, name, walk->only_dirs);
+            if (new_len) {
+                emit_path(w, new_len);
+            }
+        }
+        return;
+    }
+
+    w->stats.stat_calls++;
+    descend(w, fd, len, name, DT_UNKNOWN, comp + 1, false);
+}
+
+/**
+ * @brief Match a wildcard component against one directory entry
+ */
+static void match_entry(gs_walker_t *w, int dfd, size_t len, const char *name,
+                        unsigned char type, size_t comp) {
+    gs_walk_t *walk = w->walk;
+    const gs_component_t *c = &walk->comps[comp];
+
+    if (name[0] == '.' && !walk->dotglob && !c->dot) {
+        return;
+    }
+    if (!glob_pattern_match(c->pat, name)) {
+        return;
+    }
+
+    if (comp + 1 == walk->comp_count) {
+        emit_entry(w, dfd, len, name, type);
+    } else {
+        descend(w, dfd, len, name, type, comp + 1, false);
+    }
+}
+
+/**
+ * @brief Start worker threads once the walk has proven large
+ */
+static void maybe_go_parallel(gs_walker_t *w);
+
+/**
+ * @brief Walk one directory for component comp
+ *
+ * Takes ownership of fd. w->path[0, len) is the directory's path.
+ */
+static void process_dir(gs_walker_t *w, int fd, size_t len, size_t comp) {
+    gs_walk_t *walk = w->walk;
+    const gs_component_t *c = &walk->comps[comp];
+
+    if (c->literal) {
+        literal_step(w, fd, len, comp);
+        close(fd);
+        return;
+    }
+
+    bool trailing = comp + 1 == walk->comp_count;
+    const gs_component_t *next = trailing ? NULL : &walk->comps[comp + 1];
+
+    /* ** matching zero directories, when the next name is a lookup */
+    if (c->globstar && next && next->literal) {
+        literal_step(w, fd, len, comp + 1);
+    }
+
+    DIR *dir = fdopendir(fd);
+    if (!dir) {
+        close(fd);
+        return;
+    }
+    w->stats.dirs_read++;
+    if (w->is_main && !walk->parallel) {
+        maybe_go_parallel(w);
+    }
+
+    int dfd = dirfd(dir);
+    struct dirent *entry;
+    while (!walk->failed && (entry = readdir(dir)) != NULL) {
+        const char *name = entry->d_name;
+        if (name[0] == '.' &&
+            (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        w->stats.entries++;
+
+        if (!c->globstar) {
+            match_entry(w, dfd, len, name, entry->d_type, comp);
+            continue;
+        }
+
+        bool visible = name[0] != '.' || walk->dotglob;
+        if (trailing) {
+            if (visible) {
+                emit_entry(w, dfd, len, name, entry->d_type);
+            }
+        } else if (!next->literal) {
+            match_entry(w, dfd, len, name, entry->d_type, comp + 1);
+        }
+        if (visible) {
+            descend(w, dfd, len, name, entry->d_type, comp, true);
+        }
+    }
+    closedir(dir);
+}
+
+/* ============================================================================
+ * WORKER POOL
+ * ============================================================================
+ */
+
+/**
+ * @brief Process queued directories until the walk is finished
+ */
+static void drain_queue(gs_walker_t *w) {
+    gs_walk_t *walk = w->walk;
+
+    pthread_mutex_lock(&walk->lock);
+    for (;;) {
+        while (walk->queue_len == 0 && walk->active > 0 && !walk->failed) {
+            pthread_cond_wait(&walk->cond, &walk->lock);
+        }
+        if (walk->queue_len == 0 || walk->failed) {
+            break;
+        }
+
+        gs_item_t item = walk->queue[--walk->queue_len];
+        walk->active++;
+        pthread_mutex_unlock(&walk->lock);
+
+        /* Queued paths always end in '/', so len is only 0 on failure */
+        size_t len = path_append(w, 0, item.path, false);
+        int fd = len ? open(item.path, O_RDONLY | O_DIRECTORY | O_CLOEXEC) : -1;
+        free(item.path);
+        if (fd >= 0) {
+            process_dir(w, fd, len, item.comp);
+        }
+
+        pthread_mutex_lock(&walk->lock);
+        walk->active--;
+    }
+    pthread_cond_broadcast(&walk->cond);
+    pthread_mutex_unlock(&walk->lock);
+}
+
+/**
+ * @brief Worker thread entry point
+ */
+static void *worker_main(void *arg) {
+    drain_queue(arg);
+    return NULL;
+}
+
+/**
+ * @brief Pick the number of walkers when the caller did not
+ */
+static int auto_workers(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) {
+        return 1;
+    }
+    return cpus < GLOBSTAR_MAX_WORKERS ? (int)cpus : GLOBSTAR_MAX_WORKERS;
+}
+
+static void maybe_go_parallel(gs_walker_t *w) {
+    gs_walk_t *walk = w->walk;
+    if (walk->max_workers <= 1 ||
+        w->stats.dirs_read < GLOBSTAR_PARALLEL_THRESHOLD) {
+        return;
+    }
+
+    /* Signals are handled by the shell's main thread only */
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+
+    walk->active = 1; // The main walker is busy with its own subtree
+    walk->parallel = true;
+    for (int i = 0; i < walk->max_workers - 1; i++) {
+        gs_walker_t *worker = &walk->walkers[walk->thread_count];
+        worker->walk = walk;
+        if (pthread_create(&walk->threads[walk->thread_count], NULL,
+                           worker_main, worker) != 0) {
+            break;
+        }
+        walk->thread_count++;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+/**
+ * @brief Add one walker's statistics to a total
+ */
+static void add_stats(globstar_stats_t *total, const globstar_stats_t *s) {
+    total->dirs_read += s->dirs_read;
+    total->entries += s->entries;
+    total->stat_calls += s->stat_calls;
+    total->matches += s->matches;
+}
+
+int globstar_walk(const char *pattern, const globstar_options_t *options,
+                  globstar_emit_fn emit, void *ctx, globstar_stats_t *stats) {
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+    }
+    if (!pattern || !emit) {
+        return -1;
+    }
+
+    gs_walk_t *walk = calloc(1, sizeof(gs_walk_t));
+    if (!walk) {
+        return -1;
+    }
+
+    int flags = options ? options->pattern_flags : 0;
+    walk->dotglob = options && options->dotglob;
+    walk->max_workers = options ? options->max_workers : 0;
+    if (walk->max_workers <= 0) {
+        walk->max_workers = auto_workers();
+    } else if (walk->max_workers > GLOBSTAR_MAX_WORKERS) {
+        walk->max_workers = GLOBSTAR_MAX_WORKERS;
+    }
+    walk->emit = emit;
+    walk->emit_ctx = ctx;
+    pthread_mutex_init(&walk->lock, NULL);
+    pthread_cond_init(&walk->cond, NULL);
+
+    int result = -1;
+    gs_walker_t main_walker = {.walk = walk, .is_main = true};
+
+    if (parse_components(walk, pattern, flags) == 0 && walk->comp_count > 0) {
+        bool absolute = pattern[0] == '/';
+        int fd = open(absolute ? "/" : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        size_t len = absolute ? path_append(&main_walker, 0, "/", false) : 0;
+        if (fd >= 0 && (len || !absolute)) {
+            process_dir(&main_walker, fd, len, 0);
+        } else if (fd >= 0) {
+            close(fd);
+        }
+
+        if (walk->parallel) {
+            pthread_mutex_lock(&walk->lock);
+            walk->active--;
+            pthread_cond_broadcast(&walk->cond);
+            pthread_mutex_unlock(&walk->lock);
+
+            drain_queue(&main_walker);
+            for (int i = 0; i < walk->thread_count; i++) {
+                pthread_join(walk->threads[i], NULL);
+            }
+        }
+        result = walk->failed ? -1 : 0;
+    }
+
+    if (stats) {
+        add_stats(stats, &main_walker.stats);
+        for (int i = 0; i < walk->thread_count; i++) {
+            add_stats(stats, &walk->walkers[i].stats);
+        }
+        stats->workers = (unsigned int)walk->thread_count + 1;
+    }
+
+    free(main_walker.path);
+    for (int i = 0; i < walk->thread_count; i++) {
+        free(walk->walkers[i].path);
+    }
+    for (size_t i = 0; i < walk->queue_len; i++) {
+        free(walk->queue[i].path);
+    }
+    free(walk->queue);
+    free_components(walk->comps, walk->comp_count);
+    pthread_cond_destroy(&walk->cond);
+    pthread_mutex_destroy(&walk->lock);
+    free(walk);
+    return result;
+}
@@ -19,6 +19,7 @@
 #include "alias.h"
 #include "autocorrect.h"
 #include "builtins.h"
+#include "command_hash.h"
 #include "compat.h"
 #include "config.h"
 #include "dirstack.h"
@@ -26,6 +27,7 @@
 #include "history.h"
 #include "input.h"
 #include "posix_history.h"
+#include "script_cache.h"
 #include "shell_mode.h"
 
 #include "lle/completion/ssh_hosts.h"
@@ -53,6 +55,7 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 #ifdef __linux__
 #include <sys/sysmacros.h>
@@ -292,6 +295,35 @@ static void posix_history_cleanup(void) {
     }
 }
 
+/**
+ * @brief Milliseconds elapsed since a monotonic time stamp
+ *
+ * @param since Start time from CLOCK_MONOTONIC
+ * @return Elapsed time in milliseconds
+ */
+static double elapsed_ms(const struct timespec *since) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - since->tv_sec) * 1000.0 +
+           (double)(now.tv_nsec - since->tv_nsec) / 1000000.0;
+}
+
+/**
+ * @brief Enable the on-disk parse cache for startup files
+ *
+ * Skipped under --no-parse-cache and when scripts.parse_cache is off.
+ */
+static void init_parse_cache(void) {
+    if (shell_opts.no_parse_cache || !config.script_parse_cache) {
+        return;
+    }
+    char *dir = script_cache_default_dir();
+    if (dir) {
+        script_cache_set_disk_dir(dir);
+        free(dir);
+    }
+}
+
 /**
  * @brief Initialize the shell
  *
@@ -311,6 +343,9 @@ static void posix_history_cleanup(void) {
  */
 int init(int argc, char **argv, FILE **in) {
     struct stat st; // stat buffer
+    struct timespec start, phase;
+    double config_ms = 0, profile_ms = 0, rc_ms = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
 
     if (argv == NULL) {
         exit(EXIT_FAILURE);
@@ -375,7 +410,10 @@ int init(int argc, char **argv, FILE **in) {
                                    (isatty(STDIN_FILENO) && isatty(STDOUT_FILENO));
 
     // Initialize configuration system
+    clock_gettime(CLOCK_MONOTONIC, &phase);
     config_init();
+    init_parse_cache();
+    config_ms = elapsed_ms(&phase);
 
     // Initialize critical environment variables for login shells
     // This must happen before profile scripts which may depend on them
@@ -385,16 +423,20 @@ int init(int argc, char **argv, FILE **in) {
 
     // Execute login scripts for login shells
     if (IS_LOGIN_SHELL) {
+        clock_gettime(CLOCK_MONOTONIC, &phase);
         // First source system-wide profiles (/etc/profile, /etc/profile.d/*.sh)
         config_execute_system_profile();
         // Then source user profiles (~/.profile, ~/.lush_login)
         config_execute_login_scripts();
+        profile_ms = elapsed_ms(&phase);
     }
 
     // Execute startup scripts for interactive shells (preliminary check)
     // Note: This uses a preliminary check; full interactive detection happens below
     if (preliminary_interactive && !shell_opts.command_mode) {
+        clock_gettime(CLOCK_MONOTONIC, &phase);
         config_execute_startup_scripts();
+        rc_ms = elapsed_ms(&phase);
     }
 
     // Initialize auto-correction system
@@ -708,8 +750,10 @@ int init(int argc, char **argv, FILE **in) {
     // Initialize history for interactive shells
     if (IS_INTERACTIVE_SHELL) {
         // LLE history is initialized via lle_shell_integration_init()
-        // Initialize enhanced POSIX history system
-        if (!global_posix_history) {
+        // and already holds ~/.lush_history; the POSIX manager is only a
+        // fallback for when LLE failed to start, so don't parse the file
+        // twice
+        if (!global_posix_history && !lle_is_active()) {
             global_posix_history = posix_history_create(0);
             if (global_posix_history) {
                 // Set default filename and load existing history
@@ -772,6 +816,21 @@ int init(int argc, char **argv, FILE **in) {
      * (before LLE init) so it runs LAST in atexit order (LIFO).
      * This ensures LLE can safely use pool memory during shutdown. */
 
+    if (shell_opts.startup_timing) {
+        script_cache_stats_t stats;
+        script_cache_get_stats(&stats);
+        fprintf(stderr,
+                "lush: startup: config %.3f ms, profile %.3f ms, rc %.3f ms, "
+                "total %.3f ms\n",
+                config_ms, profile_ms, rc_ms, elapsed_ms(&start));
+        fprintf(stderr,
+                "lush: startup: parse cache %lu loaded, %lu written%s\n",
+                stats.disk_hits, stats.disk_writes,
+                shell_opts.no_parse_cache || !config.script_parse_cache
+                    ? " (disabled)"
+                    : "");
+    }
+
     return 0;
 }
 
@@ -865,6 +924,12 @@ static int parse_opts(int argc, char **argv) {
             } else if (strcmp(arg, "--dry-run") == 0) {
                 // Preview fixes without applying
                 shell_opts.dry_run = true;
+            } else if (strcmp(arg, "--no-parse-cache") == 0) {
+                // Parse startup files instead of loading cached ASTs
+                shell_opts.no_parse_cache = true;
+            } else if (strcmp(arg, "--startup-timing") == 0) {
+                // Report time spent in startup phases
+                shell_opts.startup_timing = true;
             } else if (strcmp(arg, "--format") == 0) {
                 // --format <fmt> (space-separated)
                 if (arg_index + 1 < argc) {
@@ -1007,6 +1072,10 @@ static void usage(int err) {
     printf("      --strict            Treat compatibility warnings as errors\n");
     printf("      --target=<shell>    Check compatibility against shell "
            "(posix, bash, zsh)\n");
+    printf("      --no-parse-cache    Parse startup files without the on-disk "
+           "cache\n");
+    printf("      --startup-timing    Report startup time by phase on "
+           "stderr\n");
     printf("  -c command       Execute command string and exit\n");
     printf("  -s               Read commands from standard input\n");
     printf("  -i               Force interactive mode\n");
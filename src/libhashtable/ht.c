@@ -14,36 +14,49 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/types.h>
 #include <time.h>
 
-#define INITIAL_BUCKETS (16) // Initial table size
-#define MAX_LOAD_FACTOR                                                        \
-    (0.75) // Capacity point at which a table needs to grow and rehash
+#define INITIAL_CAPACITY (16) // Initial number of slots, a power of two
 #define MAX_CAPACITY                                                           \
-    (1 << 31) // Maximum capacity of table when it should not grow and rehash
-              // (2147483648)
+    ((size_t)1 << 31) // Capacity at which a table stops growing (2147483648)
 #define GROWTH_FACTOR (2) // Factor by which a table's capacity should grow
 
-typedef struct ht_bucket {
-    const void *key;
+/*
+ * The table is open addressed with Robin Hood probing. Every entry lives
+ * directly in the slot array together with the full 64-bit hash of its
+ * key, so a probe only calls keyeq when the stored hash matches and a
+ * resize never re-hashes a key. An entry's home slot is taken from the
+ * high bits of the hash scaled by the golden ratio, which spreads weak
+ * low bits over a power-of-two table.
+ *
+ * Robin Hood insertion keeps entries ordered by probe distance, so a
+ * lookup stops as soon as it meets an entry closer to its home than the
+ * key being searched for would be. Removal shifts the following entries
+ * of the run back by one slot, so no tombstones are ever left behind.
+ */
+
+#define FIBONACCI_MULTIPLIER (0x9E3779B97F4A7C15ULL) // 2^64 / golden ratio
+
+typedef struct ht_slot {
+    uint64_t hash;
+    const void *key; // NULL marks an empty slot
     const void *val;
-    struct ht_bucket *next;
-} ht_bucket_t;
+} ht_slot_t;
 
 struct ht { // typedefed to ht_t in ht.h for external scope
     ht_hash hfunc;
     ht_keyeq keyeq;
     ht_callbacks_t callbacks;
-    ht_bucket_t *buckets;
+    ht_slot_t *slots;
     size_t capacity;
-    size_t used_buckets;
+    size_t mask;
+    unsigned int shift; // 64 - log2(capacity)
+    size_t count;
     uint64_t seed;
 };
 
 struct ht_enum { // typedefed to ht_enum_t in ht.h for external scope
     ht_t *ht;
-    ht_bucket_t *cur;
     size_t idx;
 };
 
@@ -80,148 +93,144 @@ static void __ht_passthrough_destroy(const void *v __attribute__((unused))) {
 }
 
 /**
- * @brief Return the table index of a bucket given its key
+ * @brief Allocate an empty slot array and set the capacity fields
  * @param ht Pointer to the hash table
- * @param key Pointer to the key
- * @return The bucket index for the given key
+ * @param capacity Number of slots, a power of two
+ * @return true on success, false if allocation failed (table unchanged)
  */
-static size_t __ht_bucket_index(const ht_t *ht, const void *key) {
-    return ht->hfunc(key, ht->seed) % ht->capacity;
+static bool __ht_alloc_slots(ht_t *ht, size_t capacity) {
+    ht_slot_t *slots = calloc(capacity, sizeof(*slots));
+    if (!slots) {
+        return false;
+    }
+
+    unsigned int bits = 0;
+    while (((size_t)1 << bits) < capacity) {
+        bits++;
+    }
+
+    ht->slots = slots;
+    ht->capacity = capacity;
+    ht->mask = capacity - 1;
+    ht->shift = 64 - bits;
+    return true;
 }
 
 /**
- * @brief Fill a bucket with a key and value
- *
- * If part of a rehash operation do not make copies of the key value pair.
- * - Case 1: Check if the index of the bucket has something already.
- *           If not then we add the key and value to the bucket.
- * - Case 2: If that index already has a key value pair,
- *           check if the key is a match and if so replace the value.
- * - Case 3: We've determined the key isn't in a bucket,
- *           but there is something already at that index.
- *           Traverse the chain checking each node if we have the key already.
- *           If yes, replace the value. If not, create a new node for the chain.
- *
+ * @brief Return the home slot of a hash
+ * @param ht Pointer to the hash table
+ * @param hash Full hash of the key
+ * @return Index of the slot the key would occupy without collisions
+ */
+static inline size_t __ht_home(const ht_t *ht, uint64_t hash) {
+    return (size_t)((hash * FIBONACCI_MULTIPLIER) >> ht->shift) & ht->mask;
+}
+
+/**
+ * @brief Return how far the entry in a slot is from its home slot
+ * @param ht Pointer to the hash table
+ * @param idx Index of an occupied slot
+ * @return Probe distance of the entry
+ */
+static inline size_t __ht_distance(const ht_t *ht, size_t idx) {
+    return (idx - __ht_home(ht, ht->slots[idx].hash)) & ht->mask;
+}
+
+/**
+ * @brief Find the slot holding a key
  * @param ht Pointer to the hash table
  * @param key Pointer to the key
- * @param val Pointer to the value
- * @param rehash True if this is part of a rehash operation
+ * @param hash Hash of the key
+ * @return Pointer to the slot, or NULL if the key is not in the table
  */
-static void __ht_add_to_bucket(ht_t *ht, const void *key, const void *val,
-                               bool rehash) {
-    ht_bucket_t *cur = NULL, *prev = NULL;
-    const size_t idx = __ht_bucket_index(ht, key);
-
-    if (!ht->buckets[idx].key) {
-        if (!rehash) {
-            key = ht->callbacks.key_copy(key);
-
-            if (val) {
-                val = ht->callbacks.val_copy(val);
-            }
-        }
+static ht_slot_t *__ht_find(const ht_t *ht, const void *key, uint64_t hash) {
+    size_t idx = __ht_home(ht, hash);
 
-        ht->buckets[idx].key = key;
-        ht->buckets[idx].val = val;
+    for (size_t dist = 0;; dist++) {
+        ht_slot_t *slot = ht->slots + idx;
 
-        if (!rehash) {
-            ht->used_buckets++;
+        if (!slot->key || __ht_distance(ht, idx) < dist) {
+            return NULL;
         }
-    } else {
-        cur = ht->buckets + idx;
-
-        do {
-            if (ht->keyeq(key, cur->key)) {
-                if (cur->val) {
-                    ht->callbacks.val_free(cur->val);
-                }
-
-                if (!rehash && val) {
-                    val = ht->callbacks.val_copy(val);
-                }
-
-                cur->val = val;
-                prev = NULL;
-                break;
-            }
-
-            prev = cur;
-            cur = cur->next;
-        } while (cur);
-
-        if (prev) {
-            cur = calloc(1, sizeof(*cur->next));
-            if (!cur) {
-                perror("__ht_add_to_bucket");
-                return;
-            }
-
-            if (!rehash) {
-                key = ht->callbacks.key_copy(key);
-
-                if (val) {
-                    val = ht->callbacks.val_copy(val);
-                }
-            }
-
-            cur->key = key;
-            cur->val = val;
-            prev->next = cur;
-
-            if (!rehash) {
-                ht->used_buckets++;
-            }
+        if (slot->hash == hash && ht->keyeq(key, slot->key)) {
+            return slot;
         }
+
+        idx = (idx + 1) & ht->mask;
     }
 }
 
 /**
- * @brief Rehash a table growing its capacity by GROWTH_FACTOR
+ * @brief Place an entry known not to be in the table
  *
- * Rehashes the table if it has reached MAX_LOAD_FACTOR, but does not
- * grow the table if its capacity has reached MAX_CAPACITY.
+ * Walks the probe sequence from the entry's home slot. Whenever the
+ * entry being placed is further from home than the resident entry, the
+ * two swap and placement continues with the displaced one. The table
+ * must have at least one empty slot.
  *
  * @param ht Pointer to the hash table
+ * @param hash Hash of the key
+ * @param key Pointer to the key (already copied)
+ * @param val Pointer to the value (already copied)
  */
-static void __ht_rehash(ht_t *ht) {
-    ht_bucket_t *buckets = NULL, *cur = NULL, *next = NULL;
-    size_t capacity;
+static void __ht_place(ht_t *ht, uint64_t hash, const void *key,
+                       const void *val) {
+    ht_slot_t entry = {hash, key, val};
+    size_t idx = __ht_home(ht, hash);
 
-    if (ht->used_buckets + 1 < (size_t)(ht->capacity * MAX_LOAD_FACTOR) ||
-        (ssize_t)ht->capacity >= MAX_CAPACITY) {
-        return;
-    }
+    for (size_t dist = 0;; dist++) {
+        ht_slot_t *slot = ht->slots + idx;
 
-    capacity = ht->capacity;
-    buckets = ht->buckets;
-    ht->capacity *= GROWTH_FACTOR;
-    ht->buckets = calloc(ht->capacity, sizeof(*buckets));
-    if (!ht->buckets) {
-        perror("__ht_rehash");
-        return;
-    }
+        if (!slot->key) {
+            *slot = entry;
+            return;
+        }
 
-    for (size_t i = 0; i < capacity; i++) {
-        if (!buckets[i].key) {
-            continue;
+        size_t resident = __ht_distance(ht, idx);
+        if (resident < dist) {
+            ht_slot_t displaced = *slot;
+            *slot = entry;
+            entry = displaced;
+            dist = resident;
         }
 
-        __ht_add_to_bucket(ht, buckets[i].key, buckets[i].val, true);
+        idx = (idx + 1) & ht->mask;
+    }
+}
 
-        if (buckets[i].next) {
-            cur = buckets[i].next;
+/**
+ * @brief Make room for one more entry, growing the table if needed
+ *
+ * Grows by GROWTH_FACTOR once the table would pass a 3/4 load factor.
+ * Entries move to the new slot array in a single pass using their stored
+ * hashes. If the table cannot grow it keeps working until it is full.
+ *
+ * @param ht Pointer to the hash table
+ * @return true if there is room for another entry
+ */
+static bool __ht_reserve(ht_t *ht) {
+    if ((ht->count + 1) * 4 <= ht->capacity * 3 ||
+        ht->capacity >= MAX_CAPACITY) {
+        return ht->count + 1 < ht->capacity;
+    }
+
+    ht_slot_t *old_slots = ht->slots;
+    size_t old_capacity = ht->capacity;
+
+    if (!__ht_alloc_slots(ht, old_capacity * GROWTH_FACTOR)) {
+        perror("__ht_reserve");
+        return ht->count + 1 < ht->capacity;
+    }
 
-            do {
-                __ht_add_to_bucket(ht, cur->key, cur->val, true);
-                next = cur->next;
-                free(cur);
-                cur = next;
-            } while (cur);
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key) {
+            __ht_place(ht, old_slots[i].hash, old_slots[i].key,
+                       old_slots[i].val);
         }
     }
 
-    free(buckets);
-    buckets = NULL;
+    free(old_slots);
+    return true;
 }
 
 /**
@@ -274,10 +283,9 @@ ht_t *ht_create(const ht_hash hfunc, const ht_keyeq keyeq,
         }
     }
 
-    ht->capacity = INITIAL_BUCKETS;
-    ht->buckets = calloc(ht->capacity, sizeof(*ht->buckets));
-    if (!ht->buckets) {
+    if (!__ht_alloc_slots(ht, INITIAL_CAPACITY)) {
         perror("ht_create");
+        free(ht);
         return NULL;
     }
 
@@ -293,48 +301,39 @@ ht_t *ht_create(const ht_hash hfunc, const ht_keyeq keyeq,
 /**
  * @brief Destroy a hash table
  *
- * Destroys a hash table by first freeing all buckets then the table itself.
+ * Destroys a hash table by first freeing all entries then the table itself.
  *
  * @param ht Pointer to the hash table to destroy
  */
 void ht_destroy(ht_t *ht) {
-    ht_bucket_t *next = NULL, *cur = NULL;
-
     if (!ht) {
         return;
     }
 
     for (size_t idx = 0; idx < ht->capacity; idx++) {
-        if (!ht->buckets[idx].key) {
+        if (!ht->slots[idx].key) {
             continue;
         }
 
-        ht->callbacks.key_free(ht->buckets[idx].key);
-        if (ht->buckets[idx].val) {
-            ht->callbacks.val_free(ht->buckets[idx].val);
-        }
-
-        next = ht->buckets[idx].next;
-        while (next) {
-            cur = next;
-            ht->callbacks.key_free(cur->key);
-            if (cur->val) {
-                ht->callbacks.val_free(cur->val);
-            }
-            next = cur->next;
-            free(cur);
-            cur = NULL;
+        ht->callbacks.key_free(ht->slots[idx].key);
+        if (ht->slots[idx].val) {
+            ht->callbacks.val_free(ht->slots[idx].val);
         }
     }
 
-    free(ht->buckets);
-    ht->buckets = NULL;
+    free(ht->slots);
+    ht->slots = NULL;
     free(ht);
     ht = NULL;
 }
 
 /**
- * @brief Insert a key value pair into a table bucket
+ * @brief Insert a key value pair into the table
+ *
+ * If the key is already present only its value is replaced. The new value
+ * is copied before the old one is freed, so re-inserting the stored value
+ * is safe.
+ *
  * @param ht Pointer to the hash table
  * @param key Pointer to the key
  * @param val Pointer to the value
@@ -344,136 +343,92 @@ void ht_insert(ht_t *ht, const void *key, const void *val) {
         return;
     }
 
-    __ht_rehash(ht);
-    __ht_add_to_bucket(ht, key, val, false);
-}
+    const uint64_t hash = ht->hfunc(key, ht->seed);
+    ht_slot_t *slot = __ht_find(ht, key, hash);
 
-/**
- * @brief Remove a bucket from the table
- *
- * Removes a bucket from the table by:
- * 1. Getting the bucket index using its hash
- * 2. Checking the bucket and chains for a key match
- * 3. Removing the entry if match is made
- * 4. Relinking the chain if necessary
- *
- * @param ht Pointer to the hash table
- * @param key Pointer to the key to remove
- */
-void ht_remove(ht_t *ht, const void *key) {
-    if (!ht || !key) {
+    if (slot) {
+        const void *old = slot->val;
+        slot->val = val ? ht->callbacks.val_copy(val) : NULL;
+        if (old) {
+            ht->callbacks.val_free(old);
+        }
         return;
     }
 
-    ht_bucket_t *cur = NULL, *prev = NULL;
-    const size_t idx = __ht_bucket_index(ht, key);
-    ;
-
-    if (!ht->buckets[idx].key) {
+    if (!__ht_reserve(ht)) {
         return;
     }
 
-    if (ht->keyeq(ht->buckets[idx].key, key)) {
-        ht->callbacks.key_free(ht->buckets[idx].key);
-        if (ht->buckets[idx].val) {
-            ht->callbacks.val_free(ht->buckets[idx].val);
-        }
-        ht->buckets[idx].key = NULL;
-        ht->buckets[idx].val = NULL;
-
-        cur = ht->buckets[idx].next;
-        if (cur) {
-            ht->buckets[idx].key = ht->callbacks.key_copy(cur->key);
-            if (cur->val) {
-                ht->buckets[idx].val = ht->callbacks.val_copy(cur->val);
-            }
-            ht->buckets[idx].next = cur->next;
-            ht->callbacks.key_free(cur->key);
-            if (cur->val) {
-                ht->callbacks.val_free(cur->val);
-            }
-            cur->key = NULL;
-            cur->val = NULL;
-            free(cur);
-            cur = NULL;
-        }
-
-        ht->used_buckets--;
-
-        return;
+    key = ht->callbacks.key_copy(key);
+    if (val) {
+        val = ht->callbacks.val_copy(val);
     }
 
-    prev = ht->buckets + idx;
-    cur = prev->next;
-
-    while (cur) {
-        if (ht->keyeq(key, cur->key)) {
-            prev->next = cur->next;
-            ht->callbacks.key_free(cur->key);
-            if (cur->val) {
-                ht->callbacks.val_free(cur->val);
-            }
-            cur->key = NULL;
-            cur->val = NULL;
-            free(cur);
-            cur = NULL;
-            ht->used_buckets--;
-            break;
-        }
-
-        prev = cur;
-        cur = cur->next;
-    }
+    __ht_place(ht, hash, key, val);
+    ht->count++;
 }
 
 /**
- * @brief Get a table bucket value given its key
+ * @brief Remove an entry from the table
+ *
+ * Frees the entry, then shifts each following entry of the probe run
+ * back by one slot until reaching an empty slot or an entry already in
+ * its home slot.
+ *
  * @param ht Pointer to the hash table
- * @param key Pointer to the key
- * @param val Pointer to store the retrieved value
- * @return true if the key was found, false otherwise
+ * @param key Pointer to the key to remove
  */
-static bool __ht_get(const ht_t *ht, const void *key, void **val) {
+void ht_remove(ht_t *ht, const void *key) {
     if (!ht || !key) {
-        return false;
+        return;
     }
 
-    const ht_bucket_t *cur = NULL;
-    const size_t idx = __ht_bucket_index(ht, key);
+    ht_slot_t *slot = __ht_find(ht, key, ht->hfunc(key, ht->seed));
+    if (!slot) {
+        return;
+    }
 
-    if (!ht->buckets[idx].key) {
-        return false;
+    ht->callbacks.key_free(slot->key);
+    if (slot->val) {
+        ht->callbacks.val_free(slot->val);
     }
 
-    cur = ht->buckets + idx;
-    while (cur) {
-        if (ht->keyeq(key, cur->key)) {
-            *val = (void *)cur->val;
-            return true;
+    size_t idx = (size_t)(slot - ht->slots);
+    for (;;) {
+        size_t next = (idx + 1) & ht->mask;
+        if (!ht->slots[next].key || __ht_distance(ht, next) == 0) {
+            break;
         }
-        cur = cur->next;
+        ht->slots[idx] = ht->slots[next];
+        idx = next;
     }
 
-    return false;
+    ht->slots[idx].hash = 0;
+    ht->slots[idx].key = NULL;
+    ht->slots[idx].val = NULL;
+    ht->count--;
 }
 
 /**
- * @brief Get a table bucket value given its key
- *
- * Wrapper around __ht_get for external use.
- *
+ * @brief Get a table value given its key
  * @param ht Pointer to the hash table
  * @param key Pointer to the key
  * @return Pointer to the value, or NULL if not found
  */
 void *ht_get(const ht_t *ht, const void *key) {
-    void *val = NULL;
-    __ht_get(ht, key, &val);
-    return val;
+    if (!ht || !key) {
+        return NULL;
+    }
+
+    const ht_slot_t *slot = __ht_find(ht, key, ht->hfunc(key, ht->seed));
+    return slot ? (void *)slot->val : NULL;
 }
 
 /**
  * @brief Create a table enumeration object
+ *
+ * The table must not be modified while it is being enumerated.
+ *
  * @param ht Pointer to the hash table
  * @return Pointer to the enumeration object, or NULL on failure
  */
@@ -495,48 +450,36 @@ ht_enum_t *ht_enum_create(ht_t *ht) {
 }
 
 /**
- * @brief Get the key value information of the next bucket in a table
+ * @brief Get the key value information of the next entry in a table
  *
- * Iterates through each bucket and returns the bucket data. Handles
- * chained buckets by traversing the chain until done, then moving
- * to the next bucket.
+ * Scans the slot array in order, skipping empty slots.
  *
  * @param he Pointer to the enumeration object
  * @param key Pointer to store the key (can be NULL)
  * @param val Pointer to store the value (can be NULL)
- * @return true if a next bucket was found, false if enumeration is complete
+ * @return true if a next entry was found, false if enumeration is complete
  */
 bool ht_enum_next(ht_enum_t *he, const void **key, const void **val) {
-    const void *mykey = NULL, *myval = NULL;
-
-    if (!he || he->idx >= he->ht->capacity) {
+    if (!he) {
         return false;
     }
 
-    if (!key) {
-        key = &mykey;
+    const ht_t *ht = he->ht;
+    while (he->idx < ht->capacity && !ht->slots[he->idx].key) {
+        he->idx++;
     }
 
-    if (!val) {
-        val = &myval;
+    if (he->idx >= ht->capacity) {
+        return false;
     }
 
-    if (!he->cur) {
-        while (he->idx < he->ht->capacity && !he->ht->buckets[he->idx].key) {
-            he->idx++;
-        }
-
-        if (he->idx >= he->ht->capacity) {
-            return false;
-        }
-
-        he->cur = he->ht->buckets + he->idx;
-        he->idx++;
+    if (key) {
+        *key = ht->slots[he->idx].key;
     }
-
-    *key = he->cur->key;
-    *val = he->cur->val;
-    he->cur = he->cur->next;
+    if (val) {
+        *val = ht->slots[he->idx].val;
+    }
+    he->idx++;
 
     return true;
 }
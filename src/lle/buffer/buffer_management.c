@@ -64,6 +64,186 @@ static uint64_t get_timestamp_us(void) {
     return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
 }
 
+/* ============================================================================
+ * GAP BUFFER STORAGE
+ * ============================================================================
+ *
+ * The text is data[0, gap_start) followed by the last (length - gap_start)
+ * bytes of the allocation; the free space between them is the gap. A
+ * closed gap sits after the text, which is then contiguous with data[length]
+ * NUL - the layout readers of buffer->data expect. Edits move the gap to
+ * the edit position, so a run of edits in one place costs only the size of
+ * each edit instead of shifting the rest of the text every time.
+ */
+
+/**
+ * @brief Offset in data of the first byte after the gap
+ *
+ * @param buffer Buffer with an open gap
+ * @return Offset of the text following the gap
+ */
+static size_t gap_end(const lle_buffer_t *buffer) {
+    return buffer->gap_start + (buffer->capacity - buffer->length);
+}
+
+/**
+ * @brief Move the gap to a text offset
+ *
+ * Moving it to the end of the text closes it and restores the NUL.
+ *
+ * @param buffer Buffer to rearrange
+ * @param position Text offset the gap should start at
+ */
+static void move_gap(lle_buffer_t *buffer, size_t position) {
+    size_t gap_start = buffer->gap_open ? buffer->gap_start : buffer->length;
+    size_t gap_size = buffer->capacity - buffer->length;
+
+    if (position < gap_start) {
+        memmove(buffer->data + position + gap_size, buffer->data + position,
+                gap_start - position);
+    } else if (position > gap_start) {
+        memmove(buffer->data + gap_start, buffer->data + gap_start + gap_size,
+                position - gap_start);
+    }
+
+    buffer->gap_start = position;
+    buffer->gap_open = position < buffer->length;
+    if (!buffer->gap_open) {
+        buffer->data[buffer->length] = '\0';
+    }
+}
+
+/**
+ * @brief Grow the allocation so the gap can take @p needed more bytes
+ *
+ * One byte beyond the text is always kept free for the NUL of a closed gap.
+ * The text after the gap moves to the end of the new allocation.
+ *
+ * @param buffer Buffer to grow
+ * @param needed Bytes about to be added to the text
+ * @return LLE_SUCCESS or error code
+ */
+static lle_result_t reserve_gap(lle_buffer_t *buffer, size_t needed) {
+    if (buffer->length + needed < buffer->capacity) {
+        return LLE_SUCCESS;
+    }
+
+    size_t new_capacity = buffer->capacity;
+    while (new_capacity < buffer->length + needed + 1) {
+        new_capacity *= LLE_BUFFER_GROWTH_FACTOR;
+        if (new_capacity > LLE_BUFFER_MAX_CAPACITY) {
+            return LLE_ERROR_BUFFER_OVERFLOW;
+        }
+    }
+
+    char *new_data = (char *)lle_pool_alloc(new_capacity);
+    if (!new_data) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t before = buffer->gap_open ? buffer->gap_start : buffer->length;
+    size_t after = buffer->length - before;
+    memcpy(new_data, buffer->data, before);
+    memcpy(new_data + new_capacity - after,
+           buffer->data + buffer->capacity - after, after);
+    if (!buffer->gap_open) {
+        new_data[buffer->length] = '\0';
+    }
+
+    lle_pool_free(buffer->data);
+    buffer->data = new_data;
+    buffer->capacity = new_capacity;
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Text following the gap, where text deleted at the gap starts
+ *
+ * @param buffer Buffer to inspect
+ * @return Pointer to the text after the gap (end of text if closed)
+ */
+static const char *text_after_gap(const lle_buffer_t *buffer) {
+    return buffer->gap_open ? buffer->data + gap_end(buffer)
+                            : buffer->data + buffer->length;
+}
+
+/**
+ * @brief Fill the start of the gap with text
+ *
+ * The gap must already be at the insertion point with room for the text.
+ *
+ * @param buffer Buffer to modify
+ * @param text Text to insert
+ * @param text_length Length of text
+ */
+static void fill_gap(lle_buffer_t *buffer, const char *text,
+                     size_t text_length) {
+    size_t position = buffer->gap_open ? buffer->gap_start : buffer->length;
+
+    memcpy(buffer->data + position, text, text_length);
+    buffer->length += text_length;
+    buffer->gap_start = position + text_length;
+    buffer->gap_open = buffer->gap_start < buffer->length;
+    if (!buffer->gap_open) {
+        buffer->data[buffer->length] = '\0'; /* Ensure null termination */
+    }
+}
+
+/**
+ * @brief Remove text directly after the gap by widening it
+ *
+ * @param buffer Buffer to modify (gap at the deletion point)
+ * @param delete_length Number of bytes to remove
+ */
+static void widen_gap(lle_buffer_t *buffer, size_t delete_length) {
+    buffer->length -= delete_length;
+    buffer->gap_open = buffer->gap_start < buffer->length;
+    if (!buffer->gap_open) {
+        buffer->data[buffer->length] = '\0'; /* Ensure null termination */
+    }
+}
+
+/**
+ * @brief Record an edit for the next UTF-8 index update
+ *
+ * While the index is valid for the text before the pending edit, a new
+ * edit is merged with it into one range covering both, so the index can
+ * be spliced once when it is next needed.
+ *
+ * @param buffer Buffer that was edited
+ * @param start Byte offset of the edit
+ * @param deleted Bytes removed at start
+ * @param inserted Bytes inserted at start
+ */
+static void note_utf8_edit(lle_buffer_t *buffer, size_t start, size_t deleted,
+                           size_t inserted) {
+    if (!buffer->utf8_index || !lle_utf8_index_is_valid(buffer->utf8_index)) {
+        buffer->utf8_index_valid = false;
+        return;
+    }
+
+    if (buffer->utf8_index_valid) {
+        buffer->utf8_edit_start = start;
+        buffer->utf8_edit_deleted = deleted;
+        buffer->utf8_edit_inserted = inserted;
+    } else {
+        /* The pending edit now spans [edit_start, edit_start + inserted) */
+        size_t pending_end =
+            buffer->utf8_edit_start + buffer->utf8_edit_inserted;
+        size_t merged_start =
+            start < buffer->utf8_edit_start ? start : buffer->utf8_edit_start;
+        size_t merged_end =
+            start + deleted > pending_end ? start + deleted : pending_end;
+        size_t span = merged_end - merged_start;
+
+        buffer->utf8_edit_deleted =
+            span - buffer->utf8_edit_inserted + buffer->utf8_edit_deleted;
+        buffer->utf8_edit_inserted = span - deleted + inserted;
+        buffer->utf8_edit_start = merged_start;
+    }
+    buffer->utf8_index_valid = false;
+}
+
 /* ============================================================================
  * CORE BUFFER LIFECYCLE FUNCTIONS
  * ============================================================================
@@ -222,6 +402,7 @@ lle_result_t lle_buffer_destroy(lle_buffer_t *buffer) {
 
     /* Free UTF-8 index if allocated */
     if (buffer->utf8_index) {
+        lle_utf8_index_cleanup(buffer->utf8_index);
         lle_pool_free(buffer->utf8_index);
         buffer->utf8_index = NULL;
     }
@@ -287,12 +468,17 @@ lle_result_t lle_buffer_clear(lle_buffer_t *buffer) {
     /* Reset content metadata */
     buffer->length = 0;
     buffer->used = 0;
+    buffer->gap_start = 0;
+    buffer->gap_open = false;
     buffer->last_modified_time = get_timestamp_us();
     buffer->modification_count++;
 
     /* Reset UTF-8 and Unicode metadata */
     buffer->codepoint_count = 0;
     buffer->grapheme_count = 0;
+    if (buffer->utf8_index) {
+        lle_utf8_index_invalidate(buffer->utf8_index);
+    }
     buffer->utf8_index_valid = false;
 
     /* Reset line structure */
@@ -387,12 +573,17 @@ lle_result_t lle_buffer_secure_clear(lle_buffer_t *buffer) {
     /* Reset all buffer metadata (same as lle_buffer_clear) */
     buffer->length = 0;
     buffer->used = 0;
+    buffer->gap_start = 0;
+    buffer->gap_open = false;
     buffer->last_modified_time = get_timestamp_us();
     buffer->modification_count++;
 
     /* Reset UTF-8 and Unicode metadata */
     buffer->codepoint_count = 0;
     buffer->grapheme_count = 0;
+    if (buffer->utf8_index) {
+        lle_utf8_index_invalidate(buffer->utf8_index);
+    }
     buffer->utf8_index_valid = false;
 
     /* Reset line structure */
@@ -548,28 +739,10 @@ lle_result_t lle_buffer_insert_text(lle_buffer_t *buffer, size_t position,
         return LLE_ERROR_INVALID_ENCODING;
     }
 
-    lle_result_t result = LLE_SUCCESS;
-
-    /* Step 2: Check if buffer needs expansion */
-    if (buffer->length + text_length >= buffer->capacity) {
-        size_t new_capacity = buffer->capacity;
-        while (new_capacity < buffer->length + text_length + 1) {
-            new_capacity *= LLE_BUFFER_GROWTH_FACTOR;
-            if (new_capacity > LLE_BUFFER_MAX_CAPACITY) {
-                return LLE_ERROR_BUFFER_OVERFLOW;
-            }
-        }
-
-        /* Reallocate buffer */
-        char *new_data = (char *)lle_pool_alloc(new_capacity);
-        if (!new_data) {
-            return LLE_ERROR_OUT_OF_MEMORY;
-        }
-
-        memcpy(new_data, buffer->data, buffer->length);
-        lle_pool_free(buffer->data);
-        buffer->data = new_data;
-        buffer->capacity = new_capacity;
+    /* Step 2: Make sure the gap can hold the text */
+    lle_result_t result = reserve_gap(buffer, text_length);
+    if (result != LLE_SUCCESS) {
+        return result;
     }
 
     /* Step 3: Start change tracking sequence */
@@ -595,32 +768,24 @@ lle_result_t lle_buffer_insert_text(lle_buffer_t *buffer, size_t position,
         }
     }
 
-    /* Step 4: Make space for new text */
-    if (position < buffer->length) {
-        memmove(buffer->data + position + text_length, buffer->data + position,
-                buffer->length - position);
-    }
+    /* Step 4: Move the gap to the insertion point */
+    move_gap(buffer, position);
 
-    /* Step 5: Insert new text */
-    memcpy(buffer->data + position, text, text_length);
-    buffer->length += text_length;
-    buffer->used = buffer->length;       /* Update used space */
-    buffer->data[buffer->length] = '\0'; /* Ensure null termination */
+    /* Step 5: Insert new text into the gap */
+    fill_gap(buffer, text, text_length);
+    buffer->used = buffer->length; /* Update used space */
 
     /* Step 6: Update buffer metadata */
     buffer->modification_count++;
     buffer->last_modified_time = get_timestamp_us();
     buffer->flags |= LLE_BUFFER_FLAG_MODIFIED;
 
-    /* Step 7: Update UTF-8 counts and invalidate position index */
+    /* Step 7: Update UTF-8 counts and record the edit for the index */
     buffer->codepoint_count += lle_utf8_count_codepoints(text, text_length);
     buffer->grapheme_count += lle_utf8_count_graphemes(text, text_length);
 
-    /* Invalidate UTF-8 position index - position mappings need rebuild */
-    if (buffer->utf8_index) {
-        lle_utf8_index_invalidate(buffer->utf8_index);
-    }
-    buffer->utf8_index_valid = false;
+    /* Record the edit for the next UTF-8 position index update */
+    note_utf8_edit(buffer, position, 0, text_length);
 
     /* Invalidate line structure - line boundaries need rebuild */
     buffer->line_count = 0;
@@ -669,6 +834,10 @@ lle_result_t lle_buffer_delete_text(lle_buffer_t *buffer, size_t start_position,
 
     lle_result_t result = LLE_SUCCESS;
 
+    /* The deleted text follows the gap once it is moved there */
+    move_gap(buffer, start_position);
+    const char *deleted = text_after_gap(buffer);
+
     /* Step 1: Start change tracking sequence */
     lle_change_operation_t *change_op = NULL;
     if (buffer->change_tracking_enabled && buffer->current_sequence) {
@@ -685,8 +854,8 @@ lle_result_t lle_buffer_delete_text(lle_buffer_t *buffer, size_t start_position,
         }
 
         /* Save deleted text for undo */
-        result = lle_change_tracker_save_deleted_text(
-            change_op, buffer->data + start_position, delete_length);
+        result = lle_change_tracker_save_deleted_text(change_op, deleted,
+                                                      delete_length);
         if (result != LLE_SUCCESS) {
             return result;
         }
@@ -694,35 +863,24 @@ lle_result_t lle_buffer_delete_text(lle_buffer_t *buffer, size_t start_position,
 
     /* Step 2: Calculate UTF-8 statistics of deleted text */
     size_t deleted_codepoints =
-        lle_utf8_count_codepoints(buffer->data + start_position, delete_length);
-    size_t deleted_graphemes =
-        lle_utf8_count_graphemes(buffer->data + start_position, delete_length);
+        lle_utf8_count_codepoints(deleted, delete_length);
+    size_t deleted_graphemes = lle_utf8_count_graphemes(deleted, delete_length);
 
-    /* Step 3: Remove text by shifting remaining data */
-    if (start_position + delete_length < buffer->length) {
-        memmove(buffer->data + start_position,
-                buffer->data + start_position + delete_length,
-                buffer->length - (start_position + delete_length));
-    }
-
-    buffer->length -= delete_length;
-    buffer->used = buffer->length;       /* Update used space */
-    buffer->data[buffer->length] = '\0'; /* Ensure null termination */
+    /* Step 3: Remove text by widening the gap over it */
+    widen_gap(buffer, delete_length);
+    buffer->used = buffer->length; /* Update used space */
 
     /* Step 4: Update buffer metadata */
     buffer->modification_count++;
     buffer->last_modified_time = get_timestamp_us();
     buffer->flags |= LLE_BUFFER_FLAG_MODIFIED;
 
-    /* Step 5: Update UTF-8 counts and invalidate position index */
+    /* Step 5: Update UTF-8 counts and record the edit for the index */
     buffer->codepoint_count -= deleted_codepoints;
     buffer->grapheme_count -= deleted_graphemes;
 
-    /* Invalidate UTF-8 position index - position mappings need rebuild */
-    if (buffer->utf8_index) {
-        lle_utf8_index_invalidate(buffer->utf8_index);
-    }
-    buffer->utf8_index_valid = false;
+    /* Record the edit for the next UTF-8 position index update */
+    note_utf8_edit(buffer, start_position, delete_length, 0);
 
     /* Invalidate line structure - line boundaries need rebuild */
     buffer->line_count = 0;
@@ -779,33 +937,18 @@ lle_result_t lle_buffer_replace_text(lle_buffer_t *buffer,
         return LLE_ERROR_INVALID_ENCODING;
     }
 
-    lle_result_t result = LLE_SUCCESS;
-
-    /* Step 1: Check if buffer needs expansion */
+    /* Step 1: Make sure the gap can hold the growth */
     ssize_t size_delta = (ssize_t)insert_length - (ssize_t)delete_length;
-    size_t new_length = buffer->length + size_delta;
-
-    if (new_length >= buffer->capacity) {
-        size_t new_capacity = buffer->capacity;
-        while (new_capacity < new_length + 1) {
-            new_capacity *= LLE_BUFFER_GROWTH_FACTOR;
-            if (new_capacity > LLE_BUFFER_MAX_CAPACITY) {
-                return LLE_ERROR_BUFFER_OVERFLOW;
-            }
-        }
-
-        /* Reallocate buffer */
-        char *new_data = (char *)lle_pool_alloc(new_capacity);
-        if (!new_data) {
-            return LLE_ERROR_OUT_OF_MEMORY;
-        }
-
-        memcpy(new_data, buffer->data, buffer->length);
-        lle_pool_free(buffer->data);
-        buffer->data = new_data;
-        buffer->capacity = new_capacity;
+    lle_result_t result =
+        reserve_gap(buffer, size_delta > 0 ? (size_t)size_delta : 0);
+    if (result != LLE_SUCCESS) {
+        return result;
     }
 
+    /* The replaced text follows the gap once it is moved there */
+    move_gap(buffer, start_position);
+    const char *deleted = text_after_gap(buffer);
+
     /* Step 2: Start change tracking sequence */
     lle_change_operation_t *change_op = NULL;
     if (buffer->change_tracking_enabled && buffer->current_sequence) {
@@ -822,8 +965,8 @@ lle_result_t lle_buffer_replace_text(lle_buffer_t *buffer,
         }
 
         /* Save deleted text for undo */
-        result = lle_change_tracker_save_deleted_text(
-            change_op, buffer->data + start_position, delete_length);
+        result = lle_change_tracker_save_deleted_text(change_op, deleted,
+                                                      delete_length);
         if (result != LLE_SUCCESS) {
             return result;
         }
@@ -838,46 +981,31 @@ lle_result_t lle_buffer_replace_text(lle_buffer_t *buffer,
 
     /* Step 3: Calculate UTF-8 statistics */
     size_t deleted_codepoints =
-        lle_utf8_count_codepoints(buffer->data + start_position, delete_length);
-    size_t deleted_graphemes =
-        lle_utf8_count_graphemes(buffer->data + start_position, delete_length);
+        lle_utf8_count_codepoints(deleted, delete_length);
+    size_t deleted_graphemes = lle_utf8_count_graphemes(deleted, delete_length);
     size_t inserted_codepoints =
         lle_utf8_count_codepoints(insert_text, insert_length);
     size_t inserted_graphemes =
         lle_utf8_count_graphemes(insert_text, insert_length);
 
-    /* Step 4: Perform replacement */
-    if (delete_length != insert_length) {
-        /* Need to shift data */
-        if (start_position + delete_length < buffer->length) {
-            memmove(buffer->data + start_position + insert_length,
-                    buffer->data + start_position + delete_length,
-                    buffer->length - (start_position + delete_length));
-        }
-    }
-
-    /* Copy new text */
-    memcpy(buffer->data + start_position, insert_text, insert_length);
-    buffer->length = new_length;
+    /* Step 4: Perform replacement inside the gap */
+    widen_gap(buffer, delete_length);
+    fill_gap(buffer, insert_text, insert_length);
     buffer->used = buffer->length; /* Update used space */
-    buffer->data[buffer->length] = '\0';
 
     /* Step 5: Update buffer metadata */
     buffer->modification_count++;
     buffer->last_modified_time = get_timestamp_us();
     buffer->flags |= LLE_BUFFER_FLAG_MODIFIED;
 
-    /* Step 6: Update UTF-8 counts and invalidate position index */
+    /* Step 6: Update UTF-8 counts and record the edit for the index */
     buffer->codepoint_count =
         buffer->codepoint_count - deleted_codepoints + inserted_codepoints;
     buffer->grapheme_count =
         buffer->grapheme_count - deleted_graphemes + inserted_graphemes;
 
-    /* Invalidate UTF-8 position index - position mappings need rebuild */
-    if (buffer->utf8_index) {
-        lle_utf8_index_invalidate(buffer->utf8_index);
-    }
-    buffer->utf8_index_valid = false;
+    /* Record the edit for the next UTF-8 position index update */
+    note_utf8_edit(buffer, start_position, delete_length, insert_length);
 
     /* Invalidate line structure - line boundaries need rebuild */
     buffer->line_count = 0;
@@ -904,3 +1032,94 @@ lle_result_t lle_buffer_replace_text(lle_buffer_t *buffer,
 
     return LLE_SUCCESS;
 }
+
+/* ============================================================================
+ * TEXT ACCESS
+ * ============================================================================
+ */
+
+/**
+ * @brief Get the buffer text as one contiguous string
+ *
+ * Closes the gap if an edit left it open.
+ */
+const char *lle_buffer_get_text(lle_buffer_t *buffer) {
+    if (!buffer || !buffer->data) {
+        return NULL;
+    }
+
+    if (buffer->gap_open) {
+        move_gap(buffer, buffer->length);
+    }
+    return buffer->data;
+}
+
+/**
+ * @brief Copy a range of buffer text without closing the gap
+ */
+lle_result_t lle_buffer_copy_text(const lle_buffer_t *buffer, size_t start,
+                                  size_t length, char *out) {
+    if (!buffer || !buffer->data || !out) {
+        return LLE_ERROR_NULL_POINTER;
+    }
+    if (start > buffer->length || length > buffer->length - start) {
+        return LLE_ERROR_INVALID_RANGE;
+    }
+
+    if (!buffer->gap_open || start + length <= buffer->gap_start) {
+        memcpy(out, buffer->data + start, length);
+    } else if (start >= buffer->gap_start) {
+        memcpy(out, buffer->data + start + (gap_end(buffer) - buffer->gap_start),
+               length);
+    } else {
+        size_t head = buffer->gap_start - start;
+        memcpy(out, buffer->data + start, head);
+        memcpy(out + head, buffer->data + gap_end(buffer), length - head);
+    }
+    out[length] = '\0';
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Bring the buffer's UTF-8 index up to date
+ *
+ * Splices the pending edit into a valid index, otherwise rebuilds it.
+ */
+lle_result_t lle_buffer_update_utf8_index(lle_buffer_t *buffer) {
+    if (!buffer || !buffer->data) {
+        return LLE_ERROR_NULL_POINTER;
+    }
+
+    if (!buffer->utf8_index) {
+        buffer->utf8_index =
+            (lle_utf8_index_t *)lle_pool_alloc(sizeof(lle_utf8_index_t));
+        if (!buffer->utf8_index) {
+            return LLE_ERROR_OUT_OF_MEMORY;
+        }
+        lle_utf8_index_init(buffer->utf8_index);
+        buffer->utf8_index_valid = false;
+    }
+
+    if (buffer->utf8_index_valid) {
+        return LLE_SUCCESS;
+    }
+
+    const char *text = lle_buffer_get_text(buffer);
+    lle_result_t result;
+    if (lle_utf8_index_is_valid(buffer->utf8_index)) {
+        result = lle_utf8_index_splice(
+            buffer->utf8_index, text, buffer->length, buffer->utf8_edit_start,
+            buffer->utf8_edit_deleted, buffer->utf8_edit_inserted);
+    } else {
+        result =
+            lle_utf8_index_rebuild(buffer->utf8_index, text, buffer->length);
+    }
+
+    if (result != LLE_SUCCESS) {
+        lle_utf8_index_invalidate(buffer->utf8_index);
+        return result;
+    }
+
+    buffer->utf8_index_valid = true;
+    return LLE_SUCCESS;
+}
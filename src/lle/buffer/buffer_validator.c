@@ -107,7 +107,7 @@ lle_result_t lle_buffer_validate_utf8(lle_buffer_t *buffer,
     }
 
     /* Validate UTF-8 encoding */
-    if (!lle_utf8_is_valid(buffer->data, buffer->length)) {
+    if (!lle_utf8_is_valid(lle_buffer_get_text(buffer), buffer->length)) {
         validator->validation_failures++;
         validator->corruption_detections++;
         return LLE_ERROR_INVALID_ENCODING;
@@ -325,7 +325,8 @@ lle_result_t lle_buffer_validate_complete(lle_buffer_t *buffer,
     }
 
     /* Step 3: Validate null termination */
-    if (buffer->data && buffer->data[buffer->length] != '\0') {
+    const char *text = lle_buffer_get_text(buffer);
+    if (text && text[buffer->length] != '\0') {
         validator->validation_failures++;
         validator->corruption_detections++;
         validator->last_validation_result = LLE_ERROR_MEMORY_CORRUPTION;
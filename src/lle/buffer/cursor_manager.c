@@ -40,6 +40,7 @@ static lle_result_t calculate_line_column(lle_cursor_manager_t *manager) {
     }
 
     lle_buffer_t *buffer = manager->buffer;
+    const char *data = lle_buffer_get_text(buffer);
     size_t byte_offset = manager->position.byte_offset;
 
     /* Scan through buffer to find line containing byte_offset */
@@ -47,7 +48,7 @@ static lle_result_t calculate_line_column(lle_cursor_manager_t *manager) {
     size_t line_start = 0;
 
     for (size_t i = 0; i < byte_offset && i < buffer->length; i++) {
-        if (buffer->data[i] == '\n') {
+        if (data[i] == '\n') {
             line_number++;
             line_start = i + 1;
         }
@@ -71,12 +72,12 @@ static lle_result_t calculate_line_column(lle_cursor_manager_t *manager) {
                 column_codepoint = total_codepoints - line_start_codepoints;
             } else {
                 /* Fallback to O(n) counting */
-                column_codepoint = lle_utf8_count_codepoints(
-                    buffer->data + line_start, column_offset);
+                column_codepoint = lle_utf8_count_codepoints(data + line_start,
+                                                             column_offset);
             }
         } else {
-            column_codepoint = lle_utf8_count_codepoints(
-                buffer->data + line_start, column_offset);
+            column_codepoint =
+                lle_utf8_count_codepoints(data + line_start, column_offset);
         }
     }
 
@@ -102,12 +103,12 @@ static lle_result_t calculate_line_column(lle_cursor_manager_t *manager) {
                 column_grapheme = total_graphemes - line_start_graphemes;
             } else {
                 /* Fallback to O(n) counting */
-                column_grapheme = lle_utf8_count_graphemes(
-                    buffer->data + line_start, column_offset);
+                column_grapheme = lle_utf8_count_graphemes(data + line_start,
+                                                           column_offset);
             }
         } else {
-            column_grapheme = lle_utf8_count_graphemes(
-                buffer->data + line_start, column_offset);
+            column_grapheme =
+                lle_utf8_count_graphemes(data + line_start, column_offset);
         }
     }
 
@@ -157,7 +158,7 @@ static lle_result_t grapheme_index_to_byte_offset(lle_buffer_t *buffer,
     /* Scan through buffer counting graphemes */
     size_t current_grapheme = 0;
     size_t offset = 0;
-    const char *data = buffer->data;
+    const char *data = lle_buffer_get_text(buffer);
     const char *end = data + buffer->length;
 
     while (offset < buffer->length && current_grapheme < grapheme_index) {
@@ -209,12 +210,12 @@ static lle_result_t codepoint_index_to_byte_offset(lle_buffer_t *buffer,
     }
 
     /* Scan through buffer counting codepoints */
+    const char *data = lle_buffer_get_text(buffer);
     size_t current_codepoint = 0;
     size_t offset = 0;
 
     while (offset < buffer->length && current_codepoint < codepoint_index) {
-        int seq_len =
-            lle_utf8_sequence_length((unsigned char)buffer->data[offset]);
+        int seq_len = lle_utf8_sequence_length((unsigned char)data[offset]);
         if (seq_len <= 0) {
             return LLE_ERROR_INVALID_ENCODING;
         }
@@ -305,6 +306,12 @@ lle_cursor_manager_move_to_byte_offset(lle_cursor_manager_t *manager,
     lle_result_t result = LLE_SUCCESS;
     lle_buffer_t *buffer = manager->buffer;
 
+    /* Splice edits made since the last move into an attached UTF-8 index */
+    if (buffer->utf8_index && !buffer->utf8_index_valid) {
+        lle_buffer_update_utf8_index(buffer);
+    }
+    const char *data = lle_buffer_get_text(buffer);
+
     /* Step 1: Set byte offset */
     manager->position.byte_offset = byte_offset;
 
@@ -318,11 +325,11 @@ lle_cursor_manager_move_to_byte_offset(lle_cursor_manager_t *manager,
                 &manager->position.codepoint_index) != LLE_SUCCESS) {
             /* Fallback to O(n) counting */
             manager->position.codepoint_index =
-                lle_utf8_count_codepoints(buffer->data, byte_offset);
+                lle_utf8_count_codepoints(data, byte_offset);
         }
     } else {
         manager->position.codepoint_index =
-            lle_utf8_count_codepoints(buffer->data, byte_offset);
+            lle_utf8_count_codepoints(data, byte_offset);
     }
 
     /* Step 3: Calculate grapheme index - use UTF-8 index if available */
@@ -340,11 +347,11 @@ lle_cursor_manager_move_to_byte_offset(lle_cursor_manager_t *manager,
         } else {
             /* Fallback to O(n) counting */
             manager->position.grapheme_index =
-                lle_utf8_count_graphemes(buffer->data, byte_offset);
+                lle_utf8_count_graphemes(data, byte_offset);
         }
     } else {
         manager->position.grapheme_index =
-            lle_utf8_count_graphemes(buffer->data, byte_offset);
+            lle_utf8_count_graphemes(data, byte_offset);
     }
 
     /* Step 4: Calculate line and column positions */
@@ -442,7 +449,7 @@ lle_cursor_manager_move_to_line_start(lle_cursor_manager_t *manager) {
 
     /* Find start of current line */
     size_t byte_offset = manager->position.byte_offset;
-    const char *data = manager->buffer->data;
+    const char *data = lle_buffer_get_text(manager->buffer);
 
     /* Scan backwards to find newline or start of buffer */
     while (byte_offset > 0 && data[byte_offset - 1] != '\n') {
@@ -460,7 +467,7 @@ lle_cursor_manager_move_to_line_end(lle_cursor_manager_t *manager) {
 
     /* Find end of current line */
     size_t byte_offset = manager->position.byte_offset;
-    const char *data = manager->buffer->data;
+    const char *data = lle_buffer_get_text(manager->buffer);
     size_t length = manager->buffer->length;
 
     /* Scan forwards to find newline or end of buffer */
@@ -488,7 +495,7 @@ lle_result_t lle_cursor_manager_move_by_lines(lle_cursor_manager_t *manager,
     }
 
     /* Find start of target line */
-    const char *data = manager->buffer->data;
+    const char *data = lle_buffer_get_text(manager->buffer);
     size_t length = manager->buffer->length;
     size_t byte_offset = 0;
     int current_line = 0;
@@ -544,7 +551,7 @@ lle_cursor_manager_validate_and_correct(lle_cursor_manager_t *manager) {
     }
 
     /* Ensure cursor is on a valid UTF-8 boundary */
-    const char *data = manager->buffer->data;
+    const char *data = lle_buffer_get_text(manager->buffer);
     size_t offset = manager->position.byte_offset;
 
     /* Move back to valid UTF-8 start byte if needed */
@@ -1852,7 +1852,7 @@ lle_result_t lle_gc_mark_phase(lle_garbage_collector_t *gc,
         return LLE_ERROR_NULL_POINTER;
 
     /* Mark phase: Scan Lush memory pools and count allocated blocks.
-     * With Lush's pool metadata, we can see which blocks are in_use.
+     * Lush's pool keeps an in-use flag for every block it has handed out.
      * This is a conservative mark - we consider all in_use blocks as reachable.
      */
 
@@ -1861,16 +1861,11 @@ lle_result_t lle_gc_mark_phase(lle_garbage_collector_t *gc,
     if (global_memory_pool && global_memory_pool->initialized) {
         /* Scan each pool in Lush's memory system */
         for (int pool_idx = 0; pool_idx < LUSH_POOL_COUNT; pool_idx++) {
-            lush_pool_t *pool = &global_memory_pool->pools[pool_idx];
-
-            /* Scan all blocks in this pool */
-            for (size_t block_idx = 0; block_idx < pool->current_blocks;
-                 block_idx++) {
-                lush_pool_block_t *block = &pool->all_blocks[block_idx];
-                if (block->in_use) {
-                    total_marked++;
-                }
-            }
+            size_t free_blocks = 0;
+            size_t total_blocks = 0;
+            lush_pool_get_pool_info((lush_pool_size_t)pool_idx, NULL,
+                                    &free_blocks, &total_blocks);
+            total_marked += total_blocks - free_blocks;
         }
     }
 
@@ -1886,47 +1881,13 @@ lle_result_t lle_gc_sweep_phase(lle_garbage_collector_t *gc,
     if (!gc)
         return LLE_ERROR_NULL_POINTER;
 
-    /* Sweep phase: Scan for old allocations that may be leaks.
-     * Since we can't trace pointers without type info, we use a heuristic:
-     * Free blocks that have been allocated for longer than a threshold.
-     * This implements a generational GC approach where very old allocations
-     * that haven't been freed are likely leaked. */
-
-    size_t total_freed = 0;
-    uint64_t current_time =
-        lle_get_timestamp_ns() / 1000; // Convert to microseconds
-    uint64_t age_threshold_us =
-        60 * 1000000; // 60 seconds - very old allocations
-
-    if (global_memory_pool && global_memory_pool->initialized) {
-        for (int pool_idx = 0; pool_idx < LUSH_POOL_COUNT; pool_idx++) {
-            lush_pool_t *pool = &global_memory_pool->pools[pool_idx];
-
-            /* Scan all blocks looking for very old allocations */
-            for (size_t block_idx = 0; block_idx < pool->current_blocks;
-                 block_idx++) {
-                lush_pool_block_t *block = &pool->all_blocks[block_idx];
-
-                /* Check if block is old enough to be considered potentially
-                 * leaked */
-                if (block->in_use && block->allocation_time_us > 0) {
-                    uint64_t age = current_time - block->allocation_time_us;
-
-                    /* Only free extremely old allocations during GC sweep
-                     * This is conservative - real applications should manage
-                     * their memory */
-                    if (age > age_threshold_us) {
-                        /* Free this potentially leaked block */
-                        lush_pool_free(block->memory);
-                        total_freed += block->size;
-                    }
-                }
-            }
-        }
-    }
+    /* Sweep phase: Without type information we cannot trace pointers, and
+     * pool blocks record neither an owner nor an age. Freeing blocks by any
+     * heuristic would release memory that is still in use, so nothing is
+     * reclaimed here; owners free their own blocks. */
 
     if (memory_freed) {
-        *memory_freed = total_freed;
+        *memory_freed = 0;
     }
 
     return LLE_SUCCESS;
@@ -1938,36 +1899,10 @@ lle_result_t lle_gc_compact_phase(lle_garbage_collector_t *gc) {
 
     /* Compact phase: Reduce fragmentation in memory pools.
      * Lush's pool design already minimizes fragmentation through fixed-size
-     * blocks. However, we can optimize the free list organization to improve
-     * allocation speed. */
+     * blocks. However, we can optimize the free list organization so that
+     * allocations reuse the lowest addresses first. */
 
-    if (global_memory_pool && global_memory_pool->initialized) {
-        for (int pool_idx = 0; pool_idx < LUSH_POOL_COUNT; pool_idx++) {
-            lush_pool_t *pool = &global_memory_pool->pools[pool_idx];
-
-            /* Rebuild free list in optimal order (contiguous blocks together)
-             */
-            pool->free_list = NULL;
-            pool->free_blocks = 0;
-
-            /* Add all free blocks to the free list in address order */
-            for (size_t block_idx = 0; block_idx < pool->current_blocks;
-                 block_idx++) {
-                lush_pool_block_t *block = &pool->all_blocks[block_idx];
-
-                if (!block->in_use) {
-                    /* Add to front of free list */
-                    block->next = pool->free_list;
-                    block->prev = NULL;
-                    if (pool->free_list) {
-                        pool->free_list->prev = block;
-                    }
-                    pool->free_list = block;
-                    pool->free_blocks++;
-                }
-            }
-        }
-    }
+    lush_pool_maintenance();
 
     return LLE_SUCCESS;
 }
@@ -646,9 +646,8 @@ lle_result_t lle_render_buffer_content(lle_render_controller_t *controller,
 
     /* Step 6: Full render - copy buffer content */
     if (buffer->length > 0) {
-        memcpy(render_out->content, buffer->data, buffer->length);
-        render_out->content[buffer->length] =
-            '\0'; /* CRITICAL: Null-terminate for string functions */
+        /* Null-terminated for string functions */
+        lle_buffer_copy_text(buffer, 0, buffer->length, render_out->content);
         render_out->content_length = buffer->length;
     } else {
         render_out->content[0] = '\0';
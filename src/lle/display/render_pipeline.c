@@ -64,7 +64,8 @@ lle_pipeline_stage_preprocess(lle_render_context_t *context,
 
     /* Copy buffer content (preprocessing is simple copy for now) */
     if (context->buffer->length > 0) {
-        memcpy(out->content, context->buffer->data, context->buffer->length);
+        lle_buffer_copy_text(context->buffer, 0, context->buffer->length,
+                             out->content);
         out->content_length = context->buffer->length;
     } else {
         out->content[0] = '\0';
@@ -112,7 +113,8 @@ static lle_result_t lle_pipeline_stage_syntax(lle_render_context_t *context,
 
     /* Copy content (no syntax highlighting applied yet) */
     if (context->buffer->length > 0) {
-        memcpy(out->content, context->buffer->data, context->buffer->length);
+        lle_buffer_copy_text(context->buffer, 0, context->buffer->length,
+                             out->content);
         out->content_length = context->buffer->length;
     } else {
         out->content[0] = '\0';
@@ -158,7 +160,8 @@ static lle_result_t lle_pipeline_stage_format(lle_render_context_t *context,
 
     /* Copy content (no formatting applied yet in basic implementation) */
     if (context->buffer->length > 0) {
-        memcpy(out->content, context->buffer->data, context->buffer->length);
+        lle_buffer_copy_text(context->buffer, 0, context->buffer->length,
+                             out->content);
         out->content_length = context->buffer->length;
     } else {
         out->content[0] = '\0';
@@ -204,7 +207,8 @@ static lle_result_t lle_pipeline_stage_compose(lle_render_context_t *context,
 
     /* Copy final content */
     if (context->buffer->length > 0) {
-        memcpy(out->content, context->buffer->data, context->buffer->length);
+        lle_buffer_copy_text(context->buffer, 0, context->buffer->length,
+                             out->content);
         out->content_length = context->buffer->length;
     } else {
         out->content[0] = '\0';
@@ -549,6 +549,11 @@ static bool path_exists(const char *path) {
 /*                         TOKENIZER                                          */
 /* ========================================================================== */
 
+/* Lexer state recorded before each token so lexing can restart there */
+#define LEX_EXPECT_COMMAND 0x01 /* Next word is a command */
+#define LEX_AFTER_FUNCTION 0x02 /* Previous token was 'function' keyword */
+#define LEX_INITIAL_STATE LEX_EXPECT_COMMAND
+
 /**
  * @brief Ensure token array has sufficient capacity
  * @param h Highlighter instance
@@ -575,6 +580,12 @@ static int ensure_token_capacity(lle_syntax_highlighter_t *h, size_t needed) {
 
 /**
  * @brief Add a token to the highlighter's token list
+ *
+ * The token's lex_state is recorded by the lexer loop before the token is
+ * lexed. Its reach covers the byte after the token, which decided where
+ * it stopped, and the fixed lookahead of the operator checks (<<<, *(x))
+ * from its start; word lookahead for "name ()" is added by the caller.
+ *
  * @param h Highlighter instance
  * @param type Token type
  * @param start Start byte offset in input
@@ -592,52 +603,90 @@ static int add_token(lle_syntax_highlighter_t *h, lle_syntax_token_type_t type,
     tok->end = end;
     tok->color = 0;
     tok->attributes = LLE_ATTR_NONE;
+    tok->reach = end + 1 > start + 4 ? end + 1 : start + 4;
+    tok->render_offset = 0;
 
     return 0;
 }
 
 /**
- * @brief Tokenize and highlight shell input
+ * @brief Widen the reach of the token just added
+ * @param h Highlighter instance
+ * @param start Start of the token
+ * @param reach End of the input examined to lex it
+ */
+static void extend_token_reach(lle_syntax_highlighter_t *h, size_t start,
+                               size_t reach) {
+    if (h->token_count == 0)
+        return;
+    lle_syntax_token_t *tok = &h->tokens[h->token_count - 1];
+    if (tok->start == start && tok->reach < reach)
+        tok->reach = reach;
+}
+
+/**
+ * @brief Lex tokens from a restart point, appending to the token list
  *
- * Parses the input string and generates syntax tokens with appropriate
- * types and colors based on shell syntax rules.
+ * Lexing starts at @p pos in lexer state @p state. Old tokens that
+ * followed the edit are in highlighter->tail; once lexing reaches the
+ * shifted start of one that began at or after @p old_end, in the same
+ * state, the rest of the input lexes exactly as before and lexing stops.
  *
  * @param highlighter Highlighter instance
  * @param input Input string to highlight
  * @param input_len Length of input in bytes
- * @return Number of tokens generated, or -1 on error
+ * @param pos Byte offset to start lexing at
+ * @param state Lexer state at @p pos
+ * @param tail_count Number of old tokens in highlighter->tail
+ * @param old_end End of the edit in the old input
+ * @param new_end End of the edit in @p input
+ * @return Index in the tail to resume from, or tail_count if none
  */
-int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
-                         const char *input, size_t input_len) {
-    if (!highlighter || !input)
-        return -1;
+static size_t lex_tokens(lle_syntax_highlighter_t *highlighter,
+                         const char *input, size_t input_len, size_t pos,
+                         uint8_t state, size_t tail_count, size_t old_end,
+                         size_t new_end) {
+    const lle_syntax_token_t *tail = highlighter->tail;
+    size_t t = 0;
+    bool expect_command = (state & LEX_EXPECT_COMMAND) != 0;
+    bool after_function_keyword = (state & LEX_AFTER_FUNCTION) != 0;
 
-    highlighter->token_count = 0;
+    while (pos < input_len) {
+        state = (expect_command ? LEX_EXPECT_COMMAND : 0) |
+                (after_function_keyword ? LEX_AFTER_FUNCTION : 0);
 
-    size_t pos = 0;
-    bool expect_command = true;      /* Next word is a command */
-    bool after_function_keyword = false; /* Previous token was 'function' keyword */
+        /* Resynchronize with an unchanged old token boundary */
+        while (t < tail_count && (tail[t].start < old_end ||
+                                  tail[t].start - old_end + new_end < pos)) {
+            t++;
+        }
+        if (t < tail_count && tail[t].start - old_end + new_end == pos &&
+            tail[t].lex_state == state) {
+            return t;
+        }
 
-    while (pos < input_len) {
-        /* Skip whitespace */
-        size_t ws_start = pos;
+        if (ensure_token_capacity(highlighter, highlighter->token_count + 1) ==
+            0) {
+            highlighter->tokens[highlighter->token_count].lex_state = state;
+        }
+
+        char c = input[pos];
+        size_t token_start = pos;
+
+        /* Whitespace */
         pos = skip_whitespace(input, pos, input_len);
-        if (pos > ws_start) {
-            add_token(highlighter, LLE_TOKEN_WHITESPACE, ws_start, pos);
+        if (pos > token_start) {
+            add_token(highlighter, LLE_TOKEN_WHITESPACE, token_start, pos);
             /* Check if whitespace contained a newline - new line = new command
              */
-            for (size_t i = ws_start; i < pos; i++) {
+            for (size_t i = token_start; i < pos; i++) {
                 if (input[i] == '\n') {
                     expect_command = true;
                     break;
                 }
             }
+            continue;
         }
-        if (pos >= input_len)
-            break;
-
-        char c = input[pos];
-        size_t token_start = pos;
 
         /* Comment */
         if (c == '#') {
@@ -989,11 +1038,15 @@ int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
                     break;
                 pos++;
             }
+            /* A lone backslash at the end of input is still a word */
+            if (pos == token_start)
+                pos++;
 
             size_t word_len = pos - token_start;
 
             /* Determine token type */
             lle_syntax_token_type_t type;
+            size_t word_reach = 0;
 
             if (expect_command) {
                 /* Extract word for checking */
@@ -1019,6 +1072,7 @@ int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
                            isspace((unsigned char)input[lookahead])) {
                         lookahead++;
                     }
+                    word_reach = lookahead + 2;
                     /* Check for () */
                     bool is_posix_func_def = false;
                     if (lookahead + 1 < input_len &&
@@ -1121,6 +1175,7 @@ int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
             }
 
             add_token(highlighter, type, token_start, pos);
+            extend_token_reach(highlighter, token_start, word_reach);
             continue;
         }
 
@@ -1129,8 +1184,20 @@ int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
         add_token(highlighter, LLE_TOKEN_UNKNOWN, token_start, pos);
     }
 
-    /* Apply colors to tokens */
-    for (size_t i = 0; i < highlighter->token_count; i++) {
+    highlighter->end_state = (expect_command ? LEX_EXPECT_COMMAND : 0) |
+                             (after_function_keyword ? LEX_AFTER_FUNCTION : 0);
+    return tail_count;
+}
+
+/**
+ * @brief Apply colors to a range of tokens
+ * @param highlighter Highlighter instance
+ * @param first First token to color
+ * @param last One past the last token to color
+ */
+static void apply_token_colors(lle_syntax_highlighter_t *highlighter,
+                               size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) {
         lle_syntax_token_t *tok = &highlighter->tokens[i];
         const lle_syntax_colors_t *c = &highlighter->colors;
 
@@ -1258,8 +1325,223 @@ int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
             break;
         }
     }
+}
+
+/**
+ * @brief Keep a copy of the highlighted input for the next edit
+ * @param h Highlighter instance
+ * @param input Highlighted input
+ * @param input_len Length of input
+ * @return 0 on success, -1 on allocation failure
+ */
+static int save_input_copy(lle_syntax_highlighter_t *h, const char *input,
+                           size_t input_len) {
+    if (input_len + 1 > h->input_copy_cap) {
+        size_t new_cap = h->input_copy_cap ? h->input_copy_cap : 256;
+        while (new_cap < input_len + 1)
+            new_cap *= 2;
+        char *new_copy = realloc(h->input_copy, new_cap);
+        if (!new_copy)
+            return -1;
+        h->input_copy = new_copy;
+        h->input_copy_cap = new_cap;
+    }
+    memcpy(h->input_copy, input, input_len);
+    h->input_copy[input_len] = '\0';
+    h->input_copy_len = input_len;
+    return 0;
+}
+
+/**
+ * @brief Move the tokens from @p first on into the tail buffer
+ * @param h Highlighter instance
+ * @param first First token to move
+ * @return 0 on success, -1 on allocation failure
+ */
+static int save_tail(lle_syntax_highlighter_t *h, size_t first) {
+    size_t count = h->token_count - first;
+    if (count > h->tail_capacity) {
+        size_t new_cap = h->tail_capacity ? h->tail_capacity * 2 : 32;
+        while (new_cap < count)
+            new_cap *= 2;
+        lle_syntax_token_t *new_tail =
+            realloc(h->tail, new_cap * sizeof(lle_syntax_token_t));
+        if (!new_tail)
+            return -1;
+        h->tail = new_tail;
+        h->tail_capacity = new_cap;
+    }
+    if (count > 0)
+        memcpy(h->tail, h->tokens + first, count * sizeof(lle_syntax_token_t));
+    h->token_count = first;
+    return 0;
+}
+
+/**
+ * @brief Check whether the kept tokens can be updated incrementally
+ * @param h Highlighter instance
+ * @return true if the tokens describe input_copy under the current settings
+ */
+static bool tokens_reusable(const lle_syntax_highlighter_t *h) {
+    return h->tokens_valid && h->lexed_commands == h->validate_commands &&
+           h->lexed_paths == h->validate_paths;
+}
+
+/**
+ * @brief Re-highlight a command line after a known edit
+ *
+ * Re-lexing restarts at the first token whose reach extends into the edit,
+ * in the lexer state recorded before it, and stops as soon as it lands on
+ * an old token boundary after the edit in the same state. The remaining
+ * old tokens are shifted instead of re-lexed, so command and path lookups
+ * only happen for words in the damaged range.
+ *
+ * @param highlighter Highlighter instance
+ * @param input Complete input after the edit
+ * @param input_len Length of input in bytes
+ * @param edit_start First changed byte
+ * @param old_end End of the replaced bytes in the previous input
+ * @param new_end End of the inserted bytes in @p input
+ * @return Number of tokens, or -1 on error
+ */
+int lle_syntax_highlight_edit(lle_syntax_highlighter_t *highlighter,
+                              const char *input, size_t input_len,
+                              size_t edit_start, size_t old_end,
+                              size_t new_end) {
+    if (!highlighter || !input)
+        return -1;
+
+    lle_syntax_highlighter_t *h = highlighter;
+    bool incremental =
+        tokens_reusable(h) && edit_start <= old_end &&
+        old_end <= h->input_copy_len && edit_start <= new_end &&
+        new_end <= input_len &&
+        input_len - new_end == h->input_copy_len - old_end;
+
+    /* A second edit before rendering leaves the rendered output stale */
+    if (h->render_pending)
+        h->rendered_valid = false;
+
+    size_t first = 0;
+    size_t pos = 0;
+    uint8_t state = LEX_INITIAL_STATE;
+    size_t tail_count = 0;
+
+    /* Unchanged input: keep every token */
+    if (incremental && edit_start == old_end && old_end == new_end) {
+        h->damage_first = h->token_count;
+        h->damage_end = h->token_count;
+        h->damage_render_start = h->rendered_len;
+        h->damage_render_resume = h->rendered_len;
+        h->tokens_relexed = 0;
+        h->render_pending = true;
+        return (int)h->token_count;
+    }
+
+    if (incremental) {
+        /* Last safe restart point: tokens before it never examined the
+         * edited bytes */
+        while (first < h->token_count && h->tokens[first].reach <= edit_start)
+            first++;
+        if (first < h->token_count) {
+            pos = h->tokens[first].start;
+            state = h->tokens[first].lex_state;
+            h->damage_render_start = h->tokens[first].render_offset;
+        } else {
+            pos = first > 0 ? h->tokens[first - 1].end : 0;
+            state = first > 0 ? h->end_state : LEX_INITIAL_STATE;
+            h->damage_render_start = h->rendered_len;
+        }
+        tail_count = h->token_count - first;
+        if (save_tail(h, first) < 0)
+            incremental = false;
+    }
+    if (!incremental) {
+        first = 0;
+        pos = 0;
+        state = LEX_INITIAL_STATE;
+        tail_count = 0;
+        h->token_count = 0;
+        h->rendered_valid = false;
+    }
+
+    size_t resync = lex_tokens(h, input, input_len, pos, state, tail_count,
+                               old_end, new_end);
+
+    h->damage_first = first;
+    h->damage_end = h->token_count;
+    h->damage_render_resume = resync < tail_count
+                                  ? h->tail[resync].render_offset
+                                  : h->rendered_len;
+
+    /* Splice in the unchanged old tokens, shifted by the edit */
+    if (resync < tail_count) {
+        size_t remaining = tail_count - resync;
+        if (ensure_token_capacity(h, h->token_count + remaining) < 0) {
+            h->tokens_valid = false;
+            h->rendered_valid = false;
+            return -1;
+        }
+        for (size_t i = resync; i < tail_count; i++) {
+            lle_syntax_token_t *tok = &h->tokens[h->token_count++];
+            *tok = h->tail[i];
+            tok->start = tok->start - old_end + new_end;
+            tok->end = tok->end - old_end + new_end;
+            tok->reach = tok->reach - old_end + new_end;
+        }
+    }
+
+    apply_token_colors(h, h->damage_first, h->damage_end);
 
-    return (int)highlighter->token_count;
+    h->tokens_relexed = h->damage_end - h->damage_first;
+    h->tokens_valid = save_input_copy(h, input, input_len) == 0;
+    h->lexed_commands = h->validate_commands;
+    h->lexed_paths = h->validate_paths;
+    h->render_pending = true;
+
+    return (int)h->token_count;
+}
+
+/**
+ * @brief Tokenize and highlight shell input
+ *
+ * Parses the input string and generates syntax tokens with appropriate
+ * types and colors based on shell syntax rules. The edit since the
+ * previous call is found by trimming the common prefix and suffix of the
+ * old and new input, and only that range is re-lexed.
+ *
+ * @param highlighter Highlighter instance
+ * @param input Input string to highlight
+ * @param input_len Length of input in bytes
+ * @return Number of tokens generated, or -1 on error
+ */
+int lle_syntax_highlight(lle_syntax_highlighter_t *highlighter,
+                         const char *input, size_t input_len) {
+    if (!highlighter || !input)
+        return -1;
+
+    size_t edit_start = 0;
+    size_t old_end = 0;
+    size_t new_end = input_len;
+
+    if (tokens_reusable(highlighter)) {
+        const char *old = highlighter->input_copy;
+        size_t old_len = highlighter->input_copy_len;
+        size_t limit = old_len < input_len ? old_len : input_len;
+
+        while (edit_start < limit && old[edit_start] == input[edit_start])
+            edit_start++;
+        size_t suffix = 0;
+        while (suffix < limit - edit_start &&
+               old[old_len - 1 - suffix] == input[input_len - 1 - suffix]) {
+            suffix++;
+        }
+        old_end = old_len - suffix;
+        new_end = input_len - suffix;
+    }
+
+    return lle_syntax_highlight_edit(highlighter, input, input_len,
+                                     edit_start, old_end, new_end);
 }
 
 /* ========================================================================== */
@@ -1360,33 +1642,35 @@ int lle_syntax_color_to_ansi(uint32_t color, uint8_t attributes,
 }
 
 /**
- * @brief Render highlighted input as ANSI-colored string
+ * @brief Render a range of tokens as ANSI-colored text
  *
- * Converts the tokenized input into a string with ANSI escape sequences
- * for terminal display.
+ * Records each token's offset from @p output. Sets @p truncated if
+ * anything had to be dropped or cut short to stay before @p end.
  *
  * @param highlighter Highlighter instance with tokens
  * @param input Original input string
- * @param output Buffer to write ANSI-colored output
- * @param output_size Size of output buffer
- * @return Number of bytes written, or -1 on error
+ * @param first First token to render
+ * @param last One past the last token to render
+ * @param output Start of the output buffer
+ * @param p Position to render at
+ * @param end Last usable position (reserved for the terminator)
+ * @param truncated Set to true if the output was cut short
+ * @return Position after the rendered text
  */
-int lle_syntax_render_ansi(lle_syntax_highlighter_t *highlighter,
-                           const char *input, char *output,
-                           size_t output_size) {
-    if (!highlighter || !input || !output || output_size == 0)
-        return -1;
-
-    char *p = output;
-    char *end = output + output_size - 1;
-
-    for (size_t i = 0; i < highlighter->token_count && p < end; i++) {
+static char *render_tokens(lle_syntax_highlighter_t *highlighter,
+                           const char *input, size_t first, size_t last,
+                           char *output, char *p, char *end, bool *truncated) {
+    size_t i;
+    for (i = first; i < last && p < end; i++) {
         lle_syntax_token_t *tok = &highlighter->tokens[i];
+        tok->render_offset = (size_t)(p - output);
 
         /* Skip whitespace and unknown tokens - just copy them */
         if (tok->type == LLE_TOKEN_WHITESPACE ||
             tok->type == LLE_TOKEN_UNKNOWN) {
             size_t len = tok->end - tok->start;
+            if (p + len > end)
+                *truncated = true;
             if (p + len >= end)
                 len = end - p;
             memcpy(p, input + tok->start, len);
@@ -1403,11 +1687,15 @@ int lle_syntax_render_ansi(lle_syntax_highlighter_t *highlighter,
             if (seq_len > 0 && p + seq_len < end) {
                 memcpy(p, color_seq, seq_len);
                 p += seq_len;
+            } else if (seq_len > 0) {
+                *truncated = true;
             }
         }
 
         /* Copy token text */
         size_t len = tok->end - tok->start;
+        if (p + len > end)
+            *truncated = true;
         if (p + len >= end)
             len = end - p;
         memcpy(p, input + tok->start, len);
@@ -1420,12 +1708,111 @@ int lle_syntax_render_ansi(lle_syntax_highlighter_t *highlighter,
             if (p + reset_len < end) {
                 memcpy(p, reset, reset_len);
                 p += reset_len;
+            } else {
+                *truncated = true;
             }
         }
     }
+    if (i < last)
+        *truncated = true;
+    return p;
+}
+
+/**
+ * @brief Keep a copy of the rendered output for the next render
+ * @param h Highlighter instance
+ * @param output Rendered output
+ * @param len Length of output
+ */
+static void save_rendered(lle_syntax_highlighter_t *h, const char *output,
+                          size_t len) {
+    if (len + 1 > h->rendered_cap) {
+        size_t new_cap = h->rendered_cap ? h->rendered_cap : 1024;
+        while (new_cap < len + 1)
+            new_cap *= 2;
+        char *new_rendered = realloc(h->rendered, new_cap);
+        if (!new_rendered) {
+            h->rendered_valid = false;
+            return;
+        }
+        h->rendered = new_rendered;
+        h->rendered_cap = new_cap;
+    }
+    memcpy(h->rendered, output, len);
+    h->rendered[len] = '\0';
+    h->rendered_len = len;
+    h->rendered_valid = true;
+    h->rendered_depth = h->color_depth;
+}
+
+/**
+ * @brief Render highlighted input as ANSI-colored string
+ *
+ * Converts the tokenized input into a string with ANSI escape sequences
+ * for terminal display. When the previous output is still valid, only the
+ * tokens re-lexed by the last highlight call are rendered; the output
+ * before and after them is copied from the previous render.
+ *
+ * @param highlighter Highlighter instance with tokens
+ * @param input Original input string
+ * @param output Buffer to write ANSI-colored output
+ * @param output_size Size of output buffer
+ * @return Number of bytes written, or -1 on error
+ */
+int lle_syntax_render_ansi(lle_syntax_highlighter_t *highlighter,
+                           const char *input, char *output,
+                           size_t output_size) {
+    if (!highlighter || !input || !output || output_size == 0)
+        return -1;
+
+    lle_syntax_highlighter_t *h = highlighter;
+    char *end = output + output_size - 1;
+    char *p = NULL;
+    bool truncated = false;
+
+    if (h->rendered_valid && h->rendered_depth == h->color_depth) {
+        size_t prefix = h->damage_render_start;
+        size_t suffix = h->rendered_len - h->damage_render_resume;
+        if (prefix + suffix <= output_size - 1) {
+            memcpy(output, h->rendered, prefix);
+            p = render_tokens(h, input, h->damage_first, h->damage_end, output,
+                              output + prefix, end - suffix, &truncated);
+            if (!truncated) {
+                size_t middle_end = (size_t)(p - output);
+                memcpy(p, h->rendered + h->damage_render_resume, suffix);
+                p += suffix;
+                for (size_t i = h->damage_end; i < h->token_count; i++) {
+                    h->tokens[i].render_offset = h->tokens[i].render_offset -
+                                                 h->damage_render_resume +
+                                                 middle_end;
+                }
+            } else {
+                p = NULL;
+            }
+        }
+    }
+
+    if (!p) {
+        truncated = false;
+        p = render_tokens(h, input, 0, h->token_count, output, output, end,
+                          &truncated);
+    }
 
     *p = '\0';
-    return (int)(p - output);
+    size_t len = (size_t)(p - output);
+    if (truncated)
+        h->rendered_valid = false;
+    else
+        save_rendered(h, output, len);
+
+    /* Damage consumed */
+    h->damage_first = h->token_count;
+    h->damage_end = h->token_count;
+    h->damage_render_start = len;
+    h->damage_render_resume = len;
+    h->render_pending = false;
+
+    return (int)len;
 }
 
 /* ========================================================================== */
@@ -1478,6 +1865,9 @@ void lle_syntax_highlighter_destroy(lle_syntax_highlighter_t *highlighter) {
     }
 
     free(highlighter->tokens);
+    free(highlighter->tail);
+    free(highlighter->input_copy);
+    free(highlighter->rendered);
     free(highlighter);
 }
 
@@ -1538,6 +1928,10 @@ void lle_syntax_highlighter_set_colors(lle_syntax_highlighter_t *highlighter,
     highlighter->colors.error_underline = colors->error_underline;
     highlighter->colors.path_underline = colors->path_underline;
     highlighter->colors.comment_dim = colors->comment_dim;
+
+    /* Kept tokens and output carry the old colors */
+    highlighter->tokens_valid = false;
+    highlighter->rendered_valid = false;
 }
 
 /**
@@ -1587,4 +1981,8 @@ void lle_syntax_clear_cache(lle_syntax_highlighter_t *highlighter) {
         cache->entries[i].type = LLE_TOKEN_UNKNOWN;
         cache->entries[i].timestamp = 0;
     }
+
+    /* Kept tokens may name commands that changed */
+    highlighter->tokens_valid = false;
+    highlighter->rendered_valid = false;
 }
@@ -124,7 +124,7 @@ lle_history_buffer_bridge_get_buffer_text(lle_history_buffer_bridge_t *bridge,
     }
 
     /* Get buffer text directly from buffer structure */
-    const char *buffer_text = buffer->data;
+    const char *buffer_text = lle_buffer_get_text(buffer);
     if (!buffer_text) {
         *text = NULL;
         *length = 0;
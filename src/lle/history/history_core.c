@@ -77,6 +77,9 @@ lle_result_t lle_history_config_create_default(lle_history_config_t **config,
     cfg->save_working_dir = true;
     cfg->save_exit_codes = true;
     cfg->use_indexing = true; /* Phase 2 - hashtable indexing */
+    cfg->use_index_file = true;
+    cfg->lazy_load = false;
+    cfg->lazy_cache_size = LLE_HISTORY_LAZY_CACHE_SIZE;
 
     *config = cfg;
     return LLE_SUCCESS;
@@ -361,6 +364,18 @@ lle_result_t lle_history_core_create(lle_history_core_t **core,
         c->entry_lookup = NULL;
     }
 
+    /* Prefix index for autosuggestions, maintained alongside the ID index */
+    if (c->config->use_indexing) {
+        result = lle_history_prefix_index_create(&c->prefix_index);
+        if (result != LLE_SUCCESS) {
+            lle_history_index_destroy(c->entry_lookup);
+            lle_pool_free(c->entries);
+            lle_history_config_destroy(c->config, memory_pool);
+            lle_pool_free(c);
+            return result;
+        }
+    }
+
     /* Phase 4 Day 12: Create deduplication engine if configured */
     if (c->config->ignore_duplicates) {
         /* Use configured strategy and scope (defaults: KEEP_RECENT, SESSION) */
@@ -371,6 +386,7 @@ lle_result_t lle_history_core_create(lle_history_core_t **core,
             if (c->entry_lookup) {
                 lle_history_index_destroy(c->entry_lookup);
             }
+            lle_history_prefix_index_destroy(c->prefix_index);
             lle_pool_free(c->entries);
             lle_history_config_destroy(c->config, memory_pool);
             lle_pool_free(c);
@@ -423,6 +439,7 @@ lle_result_t lle_history_core_destroy(lle_history_core_t *core) {
             core->entries[i] = NULL;
         }
     }
+    lle_history_lazy_release(core);
 
     /* Free entries array */
     if (core->entries) {
@@ -435,6 +452,11 @@ lle_result_t lle_history_core_destroy(lle_history_core_t *core) {
         core->entry_lookup = NULL;
     }
 
+    if (core->prefix_index) {
+        lle_history_prefix_index_destroy(core->prefix_index);
+        core->prefix_index = NULL;
+    }
+
     /* Phase 4 Day 12: Destroy deduplication engine if present */
     if (core->dedup_engine) {
         lle_history_dedup_destroy(core->dedup_engine);
@@ -639,6 +661,11 @@ lle_result_t lle_history_add_entry(lle_history_core_t *core,
         }
     }
 
+    /* A failed prefix insert only costs suggestions, not the entry */
+    if (core->prefix_index) {
+        lle_history_prefix_index_insert(core->prefix_index, entry);
+    }
+
     /* Update statistics */
     core->stats.total_entries++;
     core->stats.active_entries++;
@@ -690,7 +717,10 @@ get_entry_by_index_unlocked(lle_history_core_t *core, size_t index,
     }
 
     /* Return entry directly - no locking */
-    *entry = core->entries[index];
+    *entry = lle_history_entry_at(core, index);
+    if (!*entry) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
 
     /* Update statistics */
     core->stats.retrieve_count++;
@@ -730,7 +760,7 @@ lle_result_t lle_history_get_entry_by_index(lle_history_core_t *core,
     gettimeofday(&start_time, NULL);
 
     /* Return entry */
-    *entry = core->entries[index];
+    *entry = lle_history_entry_at(core, index);
 
     /* Update statistics */
     core->stats.retrieve_count++;
@@ -744,9 +774,31 @@ lle_result_t lle_history_get_entry_by_index(lle_history_core_t *core,
 
     pthread_rwlock_unlock(&core->lock);
 
+    /* A lazily loaded entry that could not be decoded */
+    if (!*entry) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
     return LLE_SUCCESS;
 }
 
+/**
+ * @brief Get the entry at an array index, decoding it if loaded lazily
+ *
+ * Caller holds core->lock and has checked index against entry_count.
+ *
+ * @param core History core engine
+ * @param index Array index of the entry (0 = oldest)
+ * @return Entry, or NULL if a lazily loaded entry could not be decoded
+ */
+lle_history_entry_t *lle_history_entry_at(lle_history_core_t *core,
+                                          size_t index) {
+    if (core->lazy && index < lle_history_lazy_count(core)) {
+        return lle_history_lazy_get(core, index);
+    }
+    return core->entries[index];
+}
+
 /**
  * @brief Get a history entry by its unique ID
  *
@@ -780,7 +832,12 @@ lle_result_t lle_history_get_entry_by_id(lle_history_core_t *core,
     lle_history_entry_t *found = NULL;
     lle_result_t lookup_result;
 
-    if (core->entry_lookup) {
+    /* Lazily loaded entries are not indexed; their IDs are consecutive */
+    size_t lazy_index = 0;
+
+    if (lle_history_lazy_find_id(core, entry_id, &lazy_index)) {
+        found = lle_history_lazy_get(core, lazy_index);
+    } else if (core->entry_lookup) {
         /* O(1) hashtable lookup */
         lookup_result =
             lle_history_index_lookup(core->entry_lookup, entry_id, &found);
@@ -789,7 +846,7 @@ lle_result_t lle_history_get_entry_by_id(lle_history_core_t *core,
     } else {
         /* O(n) linear search fallback */
         for (size_t i = 0; i < core->entry_count; i++) {
-            if (core->entries[i]->entry_id == entry_id) {
+            if (core->entries[i] && core->entries[i]->entry_id == entry_id) {
                 found = core->entries[i];
                 break;
             }
@@ -888,6 +945,7 @@ lle_result_t lle_history_clear(lle_history_core_t *core) {
             core->entries[i] = NULL;
         }
     }
+    lle_history_lazy_release(core);
 
     /* Reset counts */
     core->entry_count = 0;
@@ -898,6 +956,9 @@ lle_result_t lle_history_clear(lle_history_core_t *core) {
     if (core->entry_lookup) {
         lle_history_index_clear(core->entry_lookup);
     }
+    if (core->prefix_index) {
+        lle_history_prefix_index_clear(core->prefix_index);
+    }
 
     /* Update statistics */
     core->stats.active_entries = 0;
@@ -16,8 +16,19 @@
  * - KEEP_FREQUENT: Keep entry with highest usage count
  * - MERGE_METADATA: Merge forensic metadata, keep recent command
  * - KEEP_ALL: No deduplication (track frequency only)
+ *
+ * DUPLICATE INDEX:
+ * Duplicate checks go through a hash index from a comparison key (the
+ * command with the configured trimming, case folding and NFC applied) to
+ * the newest active entry with that key, so a check is O(1) for every
+ * scope. The index catches up with entries added or loaded since the last
+ * check and rebuilds itself when the history is cleared or entries are
+ * retired by a full scan. Keys are never stricter than commands_equal(),
+ * which still confirms every hit; a key collision between unequal
+ * commands falls back to the old backward scan.
  */
 
+#include "ht.h"
 #include "lle/error_handling.h"
 #include "lle/history.h"
 #include "lle/memory_management.h"
@@ -32,6 +43,14 @@
  * ============================================================================
  */
 
+/**
+ * Duplicate index value: newest entry with a key and its array position
+ */
+typedef struct dedup_index_record {
+    lle_history_entry_t *entry; /* Entry in core->entries, NULL if lazy */
+    size_t position;            /* Index of entry in core->entries */
+} dedup_index_record_t;
+
 /**
  * Deduplication engine state
  */
@@ -44,6 +63,16 @@ struct lle_history_dedup_engine {
     uint64_t duplicates_detected; /* Total duplicates found */
     uint64_t duplicates_merged;   /* Total duplicates merged */
     uint64_t duplicates_ignored;  /* Total duplicates ignored */
+    uint64_t index_hits;          /* Duplicates found through the index */
+    uint64_t index_fallbacks;     /* Checks that needed a backward scan */
+
+    /* Duplicate index (comparison key -> dedup_index_record_t) */
+    ht_t *index;              /* NULL until the first check */
+    size_t indexed_count;     /* core->entries[0, indexed_count) indexed */
+    uint64_t last_indexed_id; /* entry_id of the last indexed entry */
+    size_t index_floor;       /* Lazily loaded entries below not indexed */
+    char *key_buffer;         /* Reused comparison key buffer */
+    size_t key_capacity;      /* Size of key_buffer in bytes */
 
     /* Performance tracking */
     lle_performance_monitor_t *perf_monitor; /* Performance monitor */
@@ -232,6 +261,217 @@ merge_forensic_metadata(lle_history_entry_t *new_entry,
     return LLE_SUCCESS;
 }
 
+/* ============================================================================
+ * DUPLICATE INDEX
+ * ============================================================================
+ */
+
+/* Output buffer size lle_unicode_strings_equal_n() normalizes into */
+#define DEDUP_NFC_BUFFER_SIZE 4096
+
+/**
+ * @brief Build the comparison key of a command
+ *
+ * Applies the same trimming, NFC normalization and case folding that
+ * commands_equal() compares with. With Unicode normalization and case
+ * folding both on, every non-ASCII codepoint becomes one placeholder
+ * byte, since the folding applied during comparison is not available
+ * here. Commands that compare equal therefore always share a key, and
+ * the few unequal commands that share one are told apart by
+ * commands_equal().
+ *
+ * @param dedup Dedup engine with configuration (must not be NULL)
+ * @param command Command to build the key for (may be NULL)
+ * @return Key in the engine's key buffer, or NULL if command is NULL or
+ *         the buffer could not grow
+ */
+static const char *dedup_key(lle_history_dedup_engine_t *dedup,
+                             const char *command) {
+    if (!command) {
+        return NULL;
+    }
+
+    const char *start = command;
+    const char *end = command + strlen(command);
+
+    if (dedup->trim_whitespace) {
+        while (start < end && (*start == ' ' || *start == '\t')) {
+            start++;
+        }
+        while (end > start && (end[-1] == ' ' || end[-1] == '\t')) {
+            end--;
+        }
+    }
+
+    bool ascii = true;
+    for (const char *p = start; p < end; p++) {
+        if ((unsigned char)*p >= 0x80) {
+            ascii = false;
+            break;
+        }
+    }
+
+    /* ASCII is already NFC; failed normalization compares raw bytes */
+    char normalized[DEDUP_NFC_BUFFER_SIZE];
+    size_t length = (size_t)(end - start);
+    if (dedup->unicode_normalize && !ascii) {
+        size_t normalized_length = 0;
+        if (lle_unicode_normalize_nfc(start, length, normalized,
+                                      sizeof(normalized),
+                                      &normalized_length) == 0) {
+            start = normalized;
+            length = normalized_length;
+        }
+    }
+
+    if (length + 1 > dedup->key_capacity) {
+        size_t capacity = dedup->key_capacity ? dedup->key_capacity : 256;
+        while (capacity < length + 1) {
+            capacity *= 2;
+        }
+        char *buffer = realloc(dedup->key_buffer, capacity);
+        if (!buffer) {
+            return NULL;
+        }
+        dedup->key_buffer = buffer;
+        dedup->key_capacity = capacity;
+    }
+
+    bool fold = !dedup->case_sensitive;
+    bool placeholders = fold && dedup->unicode_normalize;
+    char *out = dedup->key_buffer;
+
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)start[i];
+        if (c < 0x80) {
+            *out++ = (fold && c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a')
+                                                    : (char)c;
+        } else if (!placeholders) {
+            *out++ = (char)c;
+        } else if ((c & 0xC0) != 0x80) {
+            *out++ = (char)0x80; /* One placeholder per codepoint */
+        }
+    }
+    *out = '\0';
+
+    return dedup->key_buffer;
+}
+
+/**
+ * @brief Drop the duplicate index so the next check rebuilds it
+ * @param dedup Dedup engine (must not be NULL)
+ */
+static void dedup_index_reset(lle_history_dedup_engine_t *dedup) {
+    if (dedup->index) {
+        ht_destroy(dedup->index);
+        dedup->index = NULL;
+    }
+    dedup->indexed_count = 0;
+    dedup->last_indexed_id = 0;
+    dedup->index_floor = 0;
+}
+
+/**
+ * @brief Record an entry as the newest one with its key
+ *
+ * A lazily loaded entry may be freed by the history's cache, so only its
+ * position is kept and the entry is looked up again on a hit.
+ *
+ * @param dedup Dedup engine with an index (must not be NULL)
+ * @param entry Active entry (must not be NULL)
+ * @param position Index of entry in core->entries
+ * @param lazy true if the entry was loaded lazily
+ * @return LLE_SUCCESS on success, LLE_ERROR_OUT_OF_MEMORY on failure
+ */
+static lle_result_t dedup_index_add(lle_history_dedup_engine_t *dedup,
+                                    lle_history_entry_t *entry,
+                                    size_t position, bool lazy) {
+    const char *key = dedup_key(dedup, entry->command);
+    if (!key) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    dedup_index_record_t *record = ht_get(dedup->index, key);
+    if (!record) {
+        record = malloc(sizeof(*record));
+        if (!record) {
+            return LLE_ERROR_OUT_OF_MEMORY;
+        }
+        ht_insert(dedup->index, key, record);
+        if (ht_get(dedup->index, key) != record) {
+            free(record);
+            return LLE_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    record->entry = lazy ? NULL : entry;
+    record->position = position;
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Bring the duplicate index up to date with the history
+ *
+ * Indexes entries appended since the last call. If the entry last indexed
+ * is no longer at its position (the history was cleared), the index is
+ * rebuilt from the start. Lazily loaded entries before the scope are left
+ * out, so a lazy history is only decoded as far back as dedup looks; a
+ * wider scope later rebuilds the index. Caller holds the history write
+ * lock.
+ *
+ * @param dedup Dedup engine (must not be NULL, history_core set)
+ * @param scope_start Index of the oldest entry in the dedup scope
+ * @return LLE_SUCCESS on success, LLE_ERROR_OUT_OF_MEMORY on failure
+ */
+static lle_result_t dedup_index_sync(lle_history_dedup_engine_t *dedup,
+                                     size_t scope_start) {
+    lle_history_core_t *core = dedup->history_core;
+    size_t count = dedup->indexed_count;
+    lle_history_entry_t *last = count > 0 && count <= core->entry_count
+                                    ? lle_history_entry_at(core, count - 1)
+                                    : NULL;
+
+    if (count > core->entry_count ||
+        (count > 0 && (!last || last->entry_id != dedup->last_indexed_id)) ||
+        scope_start < dedup->index_floor) {
+        dedup_index_reset(dedup);
+    }
+
+    size_t lazy_count = lle_history_lazy_count(core);
+
+    if (!dedup->index) {
+        const ht_callbacks_t callbacks = {
+            (void *(*)(const void *))strdup, (void (*)(const void *))free,
+            NULL, (void (*)(const void *))free};
+        dedup->index = ht_create(fnv1a_hash_str, str_eq, &callbacks,
+                                 HT_STR_NONE);
+        if (!dedup->index) {
+            return LLE_ERROR_OUT_OF_MEMORY;
+        }
+        dedup->index_floor =
+            scope_start < lazy_count ? scope_start : lazy_count;
+    }
+
+    size_t start = dedup->indexed_count > dedup->index_floor
+                       ? dedup->indexed_count
+                       : dedup->index_floor;
+    for (size_t i = start; i < core->entry_count; i++) {
+        lle_history_entry_t *entry = lle_history_entry_at(core, i);
+        if (entry && entry->state == LLE_HISTORY_STATE_ACTIVE) {
+            lle_result_t result =
+                dedup_index_add(dedup, entry, i, i < lazy_count);
+            if (result != LLE_SUCCESS) {
+                dedup_index_reset(dedup);
+                return result;
+            }
+        }
+        dedup->indexed_count = i + 1;
+        dedup->last_indexed_id = entry ? entry->entry_id : 0;
+    }
+
+    return LLE_SUCCESS;
+}
+
 /* ============================================================================
  * PUBLIC API
  * ============================================================================
@@ -272,8 +512,16 @@ lle_result_t lle_history_dedup_create(lle_history_dedup_engine_t **dedup,
     engine->duplicates_detected = 0;
     engine->duplicates_merged = 0;
     engine->duplicates_ignored = 0;
+    engine->index_hits = 0;
+    engine->index_fallbacks = 0;
     engine->perf_monitor = NULL;
 
+    engine->index = NULL;
+    engine->indexed_count = 0;
+    engine->last_indexed_id = 0;
+    engine->key_buffer = NULL;
+    engine->key_capacity = 0;
+
     /* Default configuration */
     engine->case_sensitive = true;
     engine->trim_whitespace = true;
@@ -298,6 +546,8 @@ lle_result_t lle_history_dedup_destroy(lle_history_dedup_engine_t *dedup) {
         return LLE_ERROR_INVALID_PARAMETER;
     }
 
+    dedup_index_reset(dedup);
+    free(dedup->key_buffer);
     lle_pool_free(dedup);
     return LLE_SUCCESS;
 }
@@ -305,8 +555,10 @@ lle_result_t lle_history_dedup_destroy(lle_history_dedup_engine_t *dedup) {
 /**
  * @brief Check if entry is duplicate of existing entry
  *
- * Scans history entries for a matching command, respecting the configured
- * dedup scope from the dedup engine's configuration.
+ * Looks up the newest active entry with the same comparison key in the
+ * duplicate index and reports it if it lies within the configured dedup
+ * scope. Scans history backward only if the indexed entry is no longer
+ * active or does not compare equal.
  * Note: Must be called from within add_entry which holds the write lock.
  *
  * @param dedup Dedup engine (must not be NULL)
@@ -374,6 +626,41 @@ lle_result_t lle_history_dedup_check(lle_history_dedup_engine_t *dedup,
         break;
     }
 
+    /* Newest entry with the same key; nothing older can be in scope if it
+     * is not */
+    if (dedup_index_sync(dedup, entry_count - check_limit) == LLE_SUCCESS) {
+        const char *key = dedup_key(dedup, new_entry->command);
+        dedup_index_record_t *record =
+            key ? ht_get(dedup->index, key) : NULL;
+
+        if (key && !record) {
+            return LLE_ERROR_NOT_FOUND;
+        }
+
+        lle_history_entry_t *indexed = NULL;
+        if (record) {
+            indexed = record->entry
+                          ? record->entry
+                          : lle_history_entry_at(core, record->position);
+        }
+
+        if (indexed && indexed->state == LLE_HISTORY_STATE_ACTIVE &&
+            commands_equal(dedup, new_entry->command, indexed->command)) {
+            if (record->position < entry_count - check_limit) {
+                return LLE_ERROR_NOT_FOUND;
+            }
+
+            dedup->duplicates_detected++;
+            dedup->index_hits++;
+            if (duplicate_entry) {
+                *duplicate_entry = indexed;
+            }
+            return LLE_SUCCESS;
+        }
+    }
+
+    dedup->index_fallbacks++;
+
     for (size_t i = entry_count; i > entry_count - check_limit && i > 0; i--) {
         /* Direct array access - safe because caller holds lock */
         size_t index = i - 1;
@@ -381,7 +668,7 @@ lle_result_t lle_history_dedup_check(lle_history_dedup_engine_t *dedup,
             continue; /* Safety check */
         }
 
-        lle_history_entry_t *entry = core->entries[index];
+        lle_history_entry_t *entry = lle_history_entry_at(core, index);
         if (!entry) {
             continue;
         }
@@ -634,7 +921,9 @@ lle_history_dedup_set_strategy(lle_history_dedup_engine_t *dedup,
 /**
  * @brief Get deduplication statistics
  *
- * Returns counts of detected, merged, and ignored duplicates, plus current strategy.
+ * Returns counts of detected, merged, and ignored duplicates, how many
+ * duplicates the index found directly and how many checks fell back to a
+ * scan, plus current strategy.
  *
  * @param dedup Dedup engine (must not be NULL)
  * @param stats Output structure for statistics (must not be NULL)
@@ -650,6 +939,8 @@ lle_history_dedup_get_stats(const lle_history_dedup_engine_t *dedup,
     stats->duplicates_detected = dedup->duplicates_detected;
     stats->duplicates_merged = dedup->duplicates_merged;
     stats->duplicates_ignored = dedup->duplicates_ignored;
+    stats->index_hits = dedup->index_hits;
+    stats->index_fallbacks = dedup->index_fallbacks;
     stats->current_strategy = dedup->strategy;
 
     return LLE_SUCCESS;
@@ -678,6 +969,9 @@ lle_result_t lle_history_dedup_configure(lle_history_dedup_engine_t *dedup,
     dedup->trim_whitespace = trim_whitespace;
     dedup->merge_forensics = merge_forensics;
 
+    /* Comparison keys depend on the configuration */
+    dedup_index_reset(dedup);
+
     return LLE_SUCCESS;
 }
 
@@ -699,6 +993,7 @@ lle_history_dedup_set_unicode_normalize(lle_history_dedup_engine_t *dedup,
     }
 
     dedup->unicode_normalize = unicode_normalize;
+    dedup_index_reset(dedup);
 
     return LLE_SUCCESS;
 }
@@ -739,6 +1034,12 @@ lle_result_t lle_history_dedup_full_scan(lle_history_dedup_engine_t *dedup,
         return LLE_ERROR_INVALID_STATE;
     }
 
+    /* Every entry is compared with every other: decode them all */
+    lle_result_t result = lle_history_lazy_materialize(core);
+    if (result != LLE_SUCCESS) {
+        return result;
+    }
+
     size_t entry_count = core->entry_count;
     if (entry_count < 2) {
         return LLE_SUCCESS; /* Nothing to deduplicate */
@@ -814,6 +1115,11 @@ lle_result_t lle_history_dedup_full_scan(lle_history_dedup_engine_t *dedup,
         }
     }
 
+    /* Indexed entries may have been retired */
+    if (removed > 0) {
+        dedup_index_reset(dedup);
+    }
+
     if (duplicates_removed) {
         *duplicates_removed = removed;
     }
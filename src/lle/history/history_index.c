@@ -270,8 +270,9 @@ lle_result_t lle_history_index_get_size(lle_hashtable_t *index, size_t *size) {
 /**
  * @brief Rebuild index from history core entries
  *
- * This function rebuilds the entire index from the history core's
- * entry array. Useful after bulk operations or corruption recovery.
+ * This function rebuilds the entire index, and the prefix index if
+ * present, from the history core's entry array. Useful after bulk
+ * operations or corruption recovery.
  * Creates a new index if one doesn't exist.
  *
  * @param core History core (must not be NULL)
@@ -294,8 +295,13 @@ lle_result_t lle_history_rebuild_index(lle_history_core_t *core) {
         lle_history_index_clear(core->entry_lookup);
     }
 
-    /* Rebuild from entries array */
-    for (size_t i = 0; i < core->entry_count; i++) {
+    if (core->prefix_index) {
+        lle_history_prefix_index_clear(core->prefix_index);
+    }
+
+    /* Rebuild from entries array; lazily loaded entries are not indexed */
+    for (size_t i = lle_history_lazy_count(core); i < core->entry_count;
+         i++) {
         lle_history_entry_t *entry = core->entries[i];
         if (entry) {
             lle_result_t result = lle_history_index_insert(
@@ -303,6 +309,13 @@ lle_result_t lle_history_rebuild_index(lle_history_core_t *core) {
             if (result != LLE_SUCCESS) {
                 return result;
             }
+            if (core->prefix_index) {
+                result =
+                    lle_history_prefix_index_insert(core->prefix_index, entry);
+                if (result != LLE_SUCCESS) {
+                    return result;
+                }
+            }
         }
     }
 
@@ -341,6 +354,20 @@ lle_result_t lle_history_get_last_n_entries(lle_history_core_t *core, size_t n,
         return LLE_ERROR_INVALID_PARAMETER;
     }
 
+    /* The entries must all stay valid together: decode the whole history
+     * if the lazily loaded ones among them would not fit in the cache */
+    pthread_rwlock_rdlock(&core->lock);
+    size_t wanted = (n < core->entry_count) ? n : core->entry_count;
+    bool fits = lle_history_lazy_cache_fits(
+        core, core->entry_count - wanted, core->entry_count);
+    pthread_rwlock_unlock(&core->lock);
+    if (!fits) {
+        lle_result_t result = lle_history_lazy_materialize(core);
+        if (result != LLE_SUCCESS) {
+            return result;
+        }
+    }
+
     pthread_rwlock_rdlock(&core->lock);
 
     /* Calculate actual count to return */
@@ -348,9 +375,15 @@ lle_result_t lle_history_get_last_n_entries(lle_history_core_t *core, size_t n,
 
     /* Copy last N entries from the array */
     size_t start_index = core->entry_count - actual_n;
+    size_t copied = 0;
     for (size_t i = 0; i < actual_n; i++) {
-        entries[i] = core->entries[start_index + i];
+        lle_history_entry_t *entry =
+            lle_history_entry_at(core, start_index + i);
+        if (entry) {
+            entries[copied++] = entry;
+        }
     }
+    actual_n = copied;
 
     *count = actual_n;
 
@@ -389,8 +422,8 @@ lle_history_get_entry_by_reverse_index(lle_history_core_t *core,
 
     /* Calculate forward index */
     size_t forward_index = core->entry_count - 1 - reverse_index;
-    *entry = core->entries[forward_index];
+    *entry = lle_history_entry_at(core, forward_index);
 
     pthread_rwlock_unlock(&core->lock);
-    return LLE_SUCCESS;
+    return *entry ? LLE_SUCCESS : LLE_ERROR_OUT_OF_MEMORY;
 }
@@ -0,0 +1,588 @@
+/**
+ * @file history_prefix_index.c
+ * @brief LLE History System - Prefix Index for Autosuggestions
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ *
+ * Specification: Spec 09 - History System
+ *
+ * Compressed radix tree over NFC-normalized history commands. Every node
+ * records the most recent entry in its subtree, so finding the newest
+ * command that extends a typed prefix walks only the prefix itself,
+ * independent of history size.
+ *
+ * Edge labels point into the indexed keys rather than copying them. Keys
+ * are the entry's own command text when it is already in NFC (always the
+ * case for ASCII), otherwise a normalized copy owned by the index. Both
+ * live until the index is cleared, which only happens together with the
+ * entries themselves.
+ */
+
+#include "lle/error_handling.h"
+#include "lle/history.h"
+#include "lle/unicode_compare.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Nodes allocated per block */
+#define PREFIX_NODE_BLOCK_SIZE 1024
+
+/**
+ * @brief Longest run of non-ASCII bytes normalized in one call
+ *
+ * lle_unicode_normalize_nfc() works on a fixed buffer of 256 decomposed
+ * codepoints; 60 bytes decompose to at most 240.
+ */
+#define PREFIX_NORMALIZE_CHUNK 60
+
+/**
+ * @brief Radix tree node
+ */
+typedef struct prefix_node {
+    const char *label;                /**< Edge label (points into a key) */
+    size_t label_len;                 /**< Edge label length */
+    lle_history_entry_t *latest;      /**< Newest entry in this subtree */
+    struct prefix_node **children;    /**< Children sorted by first byte */
+    unsigned int child_count;         /**< Number of children */
+    unsigned int child_capacity;      /**< Allocated child slots */
+} prefix_node_t;
+
+/**
+ * @brief Block of nodes (freed together on clear)
+ */
+typedef struct prefix_node_block {
+    struct prefix_node_block *next;
+    size_t used;
+    prefix_node_t nodes[PREFIX_NODE_BLOCK_SIZE];
+} prefix_node_block_t;
+
+/**
+ * @brief Normalized key copy owned by the index
+ */
+typedef struct prefix_key {
+    struct prefix_key *next;
+    char text[];
+} prefix_key_t;
+
+struct lle_history_prefix_index {
+    prefix_node_t root;          /**< Root (empty label) */
+    prefix_node_block_t *blocks; /**< Node storage */
+    prefix_key_t *keys;          /**< Normalized key copies */
+    size_t entry_count;          /**< Entries indexed */
+    size_t node_count;           /**< Nodes allocated */
+};
+
+/* ============================================================================
+ * KEY NORMALIZATION
+ * ============================================================================
+ */
+
+/**
+ * @brief Normalize text to NFC for use as an index key
+ *
+ * ASCII-only text is already in NFC and is returned as-is. Otherwise each
+ * run of non-ASCII bytes is normalized together with the ASCII character
+ * before it (which combining marks may compose with). ASCII characters
+ * never compose with what precedes them, so the result equals normalizing
+ * the whole string. A run too long for one call is copied unnormalized.
+ *
+ * @param text Text to normalize
+ * @param len Length of text in bytes
+ * @param key_len Output: key length
+ * @param allocated Output: true if the key was allocated (caller frees)
+ * @return Key bytes (text itself or a malloc'd copy), NULL on failure
+ */
+static char *normalize_key(const char *text, size_t len, size_t *key_len,
+                           bool *allocated) {
+    *allocated = false;
+
+    size_t first = 0;
+    while (first < len && (unsigned char)text[first] < 0x80) {
+        first++;
+    }
+    if (first == len) {
+        *key_len = len;
+        return (char *)text;
+    }
+
+    /* NFC never grows a segment by more than 3x */
+    size_t capacity = len * 3 + 1;
+    char *out = malloc(capacity);
+    if (!out) {
+        return NULL;
+    }
+    size_t pos = first > 0 ? first - 1 : 0;
+    memcpy(out, text, pos);
+    size_t out_len = pos;
+
+    while (pos < len) {
+        size_t end = pos + 1;
+        while (end < len && (unsigned char)text[end] >= 0x80) {
+            end++;
+        }
+
+        size_t written = 0;
+        if (end - pos > PREFIX_NORMALIZE_CHUNK ||
+            lle_unicode_normalize_nfc(text + pos, end - pos, out + out_len,
+                                      capacity - out_len, &written) != 0) {
+            memcpy(out + out_len, text + pos, end - pos);
+            written = end - pos;
+        }
+        out_len += written;
+
+        /* Copy the ASCII run that follows, keeping its last character for
+         * the next segment */
+        pos = end;
+        while (pos + 1 < len && (unsigned char)text[pos] < 0x80 &&
+               (unsigned char)text[pos + 1] < 0x80) {
+            out[out_len++] = text[pos++];
+        }
+        if (pos + 1 == len && (unsigned char)text[pos] < 0x80) {
+            out[out_len++] = text[pos++];
+        }
+    }
+
+    out[out_len] = '\0';
+    *key_len = out_len;
+    *allocated = true;
+    return out;
+}
+
+/* ============================================================================
+ * NODE MANAGEMENT
+ * ============================================================================
+ */
+
+static prefix_node_t *node_alloc(lle_history_prefix_index_t *index) {
+    prefix_node_block_t *block = index->blocks;
+    if (!block || block->used == PREFIX_NODE_BLOCK_SIZE) {
+        block = malloc(sizeof(prefix_node_block_t));
+        if (!block) {
+            return NULL;
+        }
+        block->next = index->blocks;
+        block->used = 0;
+        index->blocks = block;
+    }
+
+    prefix_node_t *node = &block->nodes[block->used++];
+    memset(node, 0, sizeof(*node));
+    index->node_count++;
+    return node;
+}
+
+/**
+ * @brief Find the child slot for a first byte
+ *
+ * @param node Parent node
+ * @param byte First byte of the child's label
+ * @param found Output: true if a child with that byte exists
+ * @return Slot of the child, or where it would be inserted
+ */
+static unsigned int child_slot(const prefix_node_t *node, unsigned char byte,
+                               bool *found) {
+    unsigned int lo = 0;
+    unsigned int hi = node->child_count;
+    while (lo < hi) {
+        unsigned int mid = (lo + hi) / 2;
+        unsigned char mid_byte = (unsigned char)node->children[mid]->label[0];
+        if (mid_byte == byte) {
+            *found = true;
+            return mid;
+        }
+        if (mid_byte < byte) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *found = false;
+    return lo;
+}
+
+static bool child_insert(prefix_node_t *node, unsigned int slot,
+                         prefix_node_t *child) {
+    if (node->child_count == node->child_capacity) {
+        unsigned int capacity =
+            node->child_capacity ? node->child_capacity * 2 : 2;
+        prefix_node_t **children =
+            realloc(node->children, capacity * sizeof(prefix_node_t *));
+        if (!children) {
+            return false;
+        }
+        node->children = children;
+        node->child_capacity = capacity;
+    }
+
+    memmove(&node->children[slot + 1], &node->children[slot],
+            (node->child_count - slot) * sizeof(prefix_node_t *));
+    node->children[slot] = child;
+    node->child_count++;
+    return true;
+}
+
+static void set_latest(prefix_node_t *node, lle_history_entry_t *entry) {
+    if (!node->latest || node->latest->entry_id < entry->entry_id) {
+        node->latest = entry;
+    }
+}
+
+/* ============================================================================
+ * CREATION AND DESTRUCTION
+ * ============================================================================
+ */
+
+/**
+ * @brief Create an empty prefix index
+ *
+ * @param index Output pointer for created index (must not be NULL)
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if index is NULL,
+ *         LLE_ERROR_OUT_OF_MEMORY on allocation failure
+ */
+lle_result_t lle_history_prefix_index_create(lle_history_prefix_index_t **index) {
+    if (!index) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    lle_history_prefix_index_t *idx = calloc(1, sizeof(*idx));
+    if (!idx) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    *index = idx;
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Remove all entries from the prefix index
+ *
+ * @param index Prefix index (must not be NULL)
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if index is NULL
+ */
+lle_result_t lle_history_prefix_index_clear(lle_history_prefix_index_t *index) {
+    if (!index) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    prefix_node_block_t *block = index->blocks;
+    while (block) {
+        prefix_node_block_t *next = block->next;
+        for (size_t i = 0; i < block->used; i++) {
+            free(block->nodes[i].children);
+        }
+        free(block);
+        block = next;
+    }
+
+    prefix_key_t *key = index->keys;
+    while (key) {
+        prefix_key_t *next = key->next;
+        free(key);
+        key = next;
+    }
+
+    free(index->root.children);
+    memset(index, 0, sizeof(*index));
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Destroy a prefix index
+ *
+ * Safe to call with NULL.
+ *
+ * @param index Prefix index to destroy (may be NULL)
+ */
+void lle_history_prefix_index_destroy(lle_history_prefix_index_t *index) {
+    if (index) {
+        lle_history_prefix_index_clear(index);
+        free(index);
+    }
+}
+
+/* ============================================================================
+ * INSERT AND LOOKUP
+ * ============================================================================
+ */
+
+/**
+ * @brief Add an entry to the prefix index
+ *
+ * Multiline commands are never suggested and are not indexed. The entry
+ * must stay valid until the index is cleared or destroyed.
+ *
+ * @param index Prefix index (must not be NULL)
+ * @param entry Entry to index (must not be NULL)
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if index or
+ *         entry is NULL, LLE_ERROR_OUT_OF_MEMORY on allocation failure
+ */
+lle_result_t lle_history_prefix_index_insert(lle_history_prefix_index_t *index,
+                                             lle_history_entry_t *entry) {
+    if (!index || !entry || !entry->command) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    /* LLE history stores newlines either raw or escaped as "\n" */
+    const char *command = entry->command;
+    size_t command_len = strlen(command);
+    if (command_len == 0 || memchr(command, '\n', command_len) ||
+        strstr(command, "\\n")) {
+        return LLE_SUCCESS;
+    }
+
+    size_t key_len = 0;
+    bool allocated = false;
+    char *normalized = normalize_key(command, command_len, &key_len, &allocated);
+    if (!normalized) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    const char *key = normalized;
+    if (allocated) {
+        if (key_len == command_len &&
+            memcmp(normalized, command, command_len) == 0) {
+            /* Already in NFC - point into the entry instead */
+            key = command;
+        } else {
+            prefix_key_t *owned = malloc(sizeof(prefix_key_t) + key_len + 1);
+            if (!owned) {
+                free(normalized);
+                return LLE_ERROR_OUT_OF_MEMORY;
+            }
+            memcpy(owned->text, normalized, key_len + 1);
+            owned->next = index->keys;
+            index->keys = owned;
+            key = owned->text;
+        }
+        free(normalized);
+    }
+
+    prefix_node_t *node = &index->root;
+    size_t pos = 0;
+    set_latest(node, entry);
+
+    while (pos < key_len) {
+        bool found = false;
+        unsigned int slot = child_slot(node, (unsigned char)key[pos], &found);
+
+        if (!found) {
+            prefix_node_t *leaf = node_alloc(index);
+            if (!leaf) {
+                return LLE_ERROR_OUT_OF_MEMORY;
+            }
+            leaf->label = key + pos;
+            leaf->label_len = key_len - pos;
+            leaf->latest = entry;
+            if (!child_insert(node, slot, leaf)) {
+                return LLE_ERROR_OUT_OF_MEMORY;
+            }
+            break;
+        }
+
+        prefix_node_t *child = node->children[slot];
+        size_t common = 1;
+        while (common < child->label_len && pos + common < key_len &&
+               child->label[common] == key[pos + common]) {
+            common++;
+        }
+
+        if (common < child->label_len) {
+            /* Split the edge at the first differing byte */
+            prefix_node_t *mid = node_alloc(index);
+            if (!mid) {
+                return LLE_ERROR_OUT_OF_MEMORY;
+            }
+            mid->label = child->label;
+            mid->label_len = common;
+            mid->latest = child->latest;
+            child->label += common;
+            child->label_len -= common;
+            if (!child_insert(mid, 0, child)) {
+                return LLE_ERROR_OUT_OF_MEMORY;
+            }
+            node->children[slot] = mid;
+            child = mid;
+        }
+
+        set_latest(child, entry);
+        node = child;
+        pos += common;
+    }
+
+    index->entry_count++;
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Find the newest indexed entry that extends a prefix
+ *
+ * The prefix is normalized the same way as the keys. Entries whose
+ * command equals the prefix are skipped since there is nothing left to
+ * suggest. Does no locking; see lle_history_find_prefix_match().
+ *
+ * @param index Prefix index (must not be NULL)
+ * @param prefix Typed prefix
+ * @param prefix_len Prefix length in bytes
+ * @return Newest matching entry, or NULL if none
+ */
+lle_history_entry_t *
+lle_history_prefix_index_find(const lle_history_prefix_index_t *index,
+                              const char *prefix, size_t prefix_len) {
+    if (!index || !prefix) {
+        return NULL;
+    }
+
+    size_t key_len = 0;
+    bool allocated = false;
+    char *key = normalize_key(prefix, prefix_len, &key_len, &allocated);
+    if (!key) {
+        return NULL;
+    }
+
+    const prefix_node_t *node = &index->root;
+    lle_history_entry_t *match = NULL;
+    size_t pos = 0;
+
+    while (pos < key_len) {
+        bool found = false;
+        unsigned int slot = child_slot(node, (unsigned char)key[pos], &found);
+        if (!found) {
+            node = NULL;
+            break;
+        }
+
+        const prefix_node_t *child = node->children[slot];
+        size_t remaining = key_len - pos;
+        size_t compare =
+            remaining < child->label_len ? remaining : child->label_len;
+        if (memcmp(child->label, key + pos, compare) != 0) {
+            node = NULL;
+            break;
+        }
+
+        if (remaining < child->label_len) {
+            /* Prefix ends inside this edge: every key below is longer */
+            match = child->latest;
+            node = NULL;
+            break;
+        }
+
+        node = child;
+        pos += child->label_len;
+    }
+
+    if (node) {
+        /* Prefix ends on a node: the newest entry strictly below it */
+        for (unsigned int i = 0; i < node->child_count; i++) {
+            lle_history_entry_t *candidate = node->children[i]->latest;
+            if (!match || candidate->entry_id > match->entry_id) {
+                match = candidate;
+            }
+        }
+    }
+
+    if (allocated) {
+        free(key);
+    }
+    return match;
+}
+
+/**
+ * @brief Get prefix index size
+ *
+ * @param index Prefix index (must not be NULL)
+ * @param entries Output for number of indexed entries (may be NULL)
+ * @param nodes Output for number of tree nodes (may be NULL)
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if index is NULL
+ */
+lle_result_t
+lle_history_prefix_index_get_size(const lle_history_prefix_index_t *index,
+                                  size_t *entries, size_t *nodes) {
+    if (!index) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+    if (entries) {
+        *entries = index->entry_count;
+    }
+    if (nodes) {
+        *nodes = index->node_count;
+    }
+    return LLE_SUCCESS;
+}
+
+/* ============================================================================
+ * CORE INTEGRATION
+ * ============================================================================
+ */
+
+/**
+ * @brief Find the most recent history command extending a prefix
+ *
+ * Uses the prefix index when the core has one, otherwise scans history
+ * from newest to oldest. Lazily loaded entries, which the index does not
+ * hold, are scanned in the mapped file after that. Multiline entries and
+ * entries equal to the prefix are never returned.
+ *
+ * @param core History core (must not be NULL)
+ * @param prefix Typed prefix (must not be NULL)
+ * @param prefix_len Prefix length in bytes
+ * @param entry Output for the matching entry, NULL if none (must not be NULL)
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if any pointer
+ *         is NULL, LLE_ERROR_NOT_INITIALIZED if core is not initialized
+ */
+lle_result_t lle_history_find_prefix_match(lle_history_core_t *core,
+                                           const char *prefix,
+                                           size_t prefix_len,
+                                           lle_history_entry_t **entry) {
+    if (!core || !prefix || !entry) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    if (!core->initialized) {
+        return LLE_ERROR_NOT_INITIALIZED;
+    }
+
+    *entry = NULL;
+
+    pthread_rwlock_rdlock(&core->lock);
+
+    /* Lazily loaded entries are older than every resident one */
+    size_t lazy_count = lle_history_lazy_count(core);
+
+    if (core->prefix_index) {
+        *entry = lle_history_prefix_index_find(core->prefix_index, prefix,
+                                               prefix_len);
+        if (!*entry && lazy_count > 0) {
+            *entry = lle_history_lazy_find_prefix(core, prefix, prefix_len);
+        }
+        pthread_rwlock_unlock(&core->lock);
+        return LLE_SUCCESS;
+    }
+
+    for (size_t i = core->entry_count; i > lazy_count; i--) {
+        lle_history_entry_t *candidate = core->entries[i - 1];
+        if (!candidate || !candidate->command) {
+            continue;
+        }
+
+        const char *command = candidate->command;
+        size_t command_len = strlen(command);
+        if (command_len <= prefix_len || strchr(command, '\n') ||
+            strstr(command, "\\n")) {
+            continue;
+        }
+
+        if (lle_unicode_is_prefix(prefix, prefix_len, command, command_len,
+                                  NULL)) {
+            *entry = candidate;
+            break;
+        }
+    }
+
+    if (!*entry && lazy_count > 0) {
+        *entry = lle_history_lazy_find_prefix(core, prefix, prefix_len);
+    }
+
+    pthread_rwlock_unlock(&core->lock);
+    return LLE_SUCCESS;
+}
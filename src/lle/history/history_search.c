@@ -297,6 +297,9 @@ void lle_history_search_results_destroy(lle_history_search_results_t *results) {
     }
 
     if (results->results) {
+        for (size_t i = 0; i < results->count; i++) {
+            lle_pool_free((char *)results->results[i].command);
+        }
         lle_pool_free(results->results);
     }
 
@@ -307,17 +310,20 @@ void lle_history_search_results_destroy(lle_history_search_results_t *results) {
  * @brief Add result to search results (if not full)
  *
  * Appends a new search result to the container if capacity allows.
- * Marks the results as unsorted after adding.
+ * Marks the results as unsorted after adding. The command is copied: a
+ * lazily loaded history may free the entry it came from while the
+ * results are still in use.
  *
  * @param results Search results container (must not be NULL)
  * @param entry_id Unique ID of the history entry
  * @param entry_index Index of entry in history
- * @param command Command string (reference, not copied)
+ * @param command Command string (copied)
  * @param timestamp Entry timestamp
  * @param score Relevance score
  * @param match_position Position of match in command
  * @param match_type Type of match performed
- * @return true if result was added, false if container is NULL or full
+ * @return true if result was added, false if container is NULL or full, or
+ *         if the command could not be copied
  */
 static bool add_search_result(lle_history_search_results_t *results,
                               uint64_t entry_id, size_t entry_index,
@@ -328,10 +334,17 @@ static bool add_search_result(lle_history_search_results_t *results,
         return false;
     }
 
+    size_t command_size = strlen(command) + 1;
+    char *copy = lle_pool_alloc(command_size);
+    if (!copy) {
+        return false;
+    }
+    memcpy(copy, command, command_size);
+
     lle_search_result_t *result = &results->results[results->count];
     result->entry_id = entry_id;
     result->entry_index = entry_index;
-    result->command = command; /* Reference, not copy */
+    result->command = copy;
     result->timestamp = timestamp;
     result->score = score;
     result->match_position = match_position;
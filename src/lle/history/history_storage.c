@@ -12,17 +12,42 @@
  * - File locking for multi-process safety
  * - TSV format for simplicity and readability
  * - Corruption detection and recovery
+ *
+ * LOADING:
+ * The history file is mapped and parsed in a single pass. Fields are
+ * located in place and each command is unescaped straight into the
+ * allocation its entry keeps, so no line is copied on the way.
+ *
+ * A binary index ("<file>.idx") is written beside the file on every
+ * save. It records the size and mtime of the file it describes, and the
+ * offset, length and timestamp of every entry line. When it still
+ * matches the file, the loader sizes the entry array once and parses
+ * only the indexed lines; otherwise it is ignored.
+ *
+ * LAZY LOADING:
+ * With lazy_load set, a file loaded into an empty history is left mapped
+ * and only the position of each entry line is kept (taken from the index
+ * when it matches, found by a scan otherwise). An entry is decoded when
+ * first used and kept in an LRU cache of lazy_cache_size entries; an
+ * evicted entry is freed and its state kept with its line. Saves write
+ * entries that were never decoded straight from the mapped lines.
+ *
+ * Saves write a temporary file and rename it over the history file, so a
+ * file that is mapped, here or in another shell, is never truncated.
  */
 
 #include "lle/error_handling.h"
 #include "lle/history.h"
 #include "lle/memory_management.h"
+#include "lle/unicode_compare.h"
 #include <errno.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
@@ -36,6 +61,45 @@
 #define LLE_HISTORY_MAGIC_HEADER "# LLE History File v"
 #define LLE_HISTORY_MAX_LINE_LENGTH 65536 /* 64KB per line */
 
+#define LLE_HISTORY_INDEX_SUFFIX ".idx"
+#define LLE_HISTORY_INDEX_MAGIC "LLEHIDX1"
+#define LLE_HISTORY_INDEX_VERSION 1
+
+/**
+ * Header of the binary index file. Integers are in host byte order; an
+ * index written on another architecture fails the version check.
+ */
+typedef struct lle_history_index_header {
+    char magic[8];             /* LLE_HISTORY_INDEX_MAGIC, unterminated */
+    uint32_t version;          /* LLE_HISTORY_INDEX_VERSION */
+    uint32_t record_size;      /* sizeof(lle_history_index_record_t) */
+    uint64_t source_size;      /* Size of the history file */
+    int64_t source_mtime_sec;  /* Modification time of the history file */
+    int64_t source_mtime_nsec;
+    uint64_t record_count;     /* Records following the header */
+} lle_history_index_header_t;
+
+/**
+ * One entry line of the history file
+ */
+typedef struct lle_history_index_record {
+    uint64_t offset;    /* Offset of the line in the history file */
+    uint64_t length;    /* Line length, without the newline */
+    uint64_t timestamp; /* Entry timestamp */
+} lle_history_index_record_t;
+
+/**
+ * Fields of one history line, pointing into the mapped file
+ */
+typedef struct lle_history_line_fields {
+    uint64_t timestamp;
+    int exit_code;
+    const char *command;       /* Escaped command, not terminated */
+    size_t command_length;
+    const char *working_dir;   /* Escaped directory, NULL if absent */
+    size_t working_dir_length;
+} lle_history_line_fields_t;
+
 /* ============================================================================
  * FILE LOCKING
  * ============================================================================
@@ -150,42 +214,48 @@ static lle_result_t lle_escape_string(const char *str, char *output,
  * @brief Unescape special characters from TSV format
  *
  * Unescapes: \\\\t -> \\t, \\\\n -> \\n, \\\\\\\\ -> \\\\
+ * Any other backslash is kept. The result is never longer than the
+ * input, so the output buffer needs length + 1 bytes.
  *
- * @param str Input escaped string
- * @param output Output buffer for unescaped string
- * @param output_size Size of output buffer in bytes
- * @return LLE_SUCCESS on success, or LLE_ERROR_INVALID_PARAMETER if parameters are invalid
+ * @param str Input escaped string (need not be terminated)
+ * @param length Length of the input in bytes
+ * @param output Output buffer for the terminated, unescaped string
+ * @return Length of the unescaped string
  */
-static lle_result_t lle_unescape_string(const char *str, char *output,
-                                        size_t output_size) {
-    if (!str || !output || output_size == 0) {
-        return LLE_ERROR_INVALID_PARAMETER;
-    }
-
+static size_t lle_unescape_string(const char *str, size_t length,
+                                  char *output) {
     size_t out_idx = 0;
     size_t in_idx = 0;
 
-    while (str[in_idx] != '\0' && out_idx < output_size - 1) {
-        if (str[in_idx] == '\\' && str[in_idx + 1] != '\0') {
-            if (str[in_idx + 1] == 't') {
-                output[out_idx++] = '\t';
-                in_idx += 2;
-            } else if (str[in_idx + 1] == 'n') {
-                output[out_idx++] = '\n';
-                in_idx += 2;
-            } else if (str[in_idx + 1] == '\\') {
-                output[out_idx++] = '\\';
-                in_idx += 2;
-            } else {
-                output[out_idx++] = str[in_idx++];
-            }
+    while (in_idx < length) {
+        /* Copy the run up to the next backslash in one go */
+        const char *escape = memchr(str + in_idx, '\\', length - in_idx);
+        size_t run = escape ? (size_t)(escape - str) - in_idx
+                            : length - in_idx;
+        memcpy(output + out_idx, str + in_idx, run);
+        out_idx += run;
+        in_idx += run;
+        if (!escape) {
+            break;
+        }
+
+        char next = in_idx + 1 < length ? str[in_idx + 1] : '\0';
+        if (next == 't') {
+            output[out_idx++] = '\t';
+            in_idx += 2;
+        } else if (next == 'n') {
+            output[out_idx++] = '\n';
+            in_idx += 2;
+        } else if (next == '\\') {
+            output[out_idx++] = '\\';
+            in_idx += 2;
         } else {
             output[out_idx++] = str[in_idx++];
         }
     }
 
     output[out_idx] = '\0';
-    return LLE_SUCCESS;
+    return out_idx;
 }
 
 /**
@@ -240,354 +310,1523 @@ static lle_result_t lle_history_format_entry(const lle_history_entry_t *entry,
 }
 
 /**
- * @brief Parse TSV line into history entry
+ * @brief Parse an unsigned decimal number
  *
- * Parses a tab-separated line and creates a history entry.
- * Comments (lines starting with #) and empty lines are skipped.
- *
- * @param line Input TSV line to parse
- * @param entry Output pointer for created entry (NULL if line is comment/empty)
- * @param memory_pool Memory pool for allocation (currently uses global pool)
- * @return LLE_SUCCESS on success, or LLE_ERROR_INVALID_PARAMETER if parameters are invalid
+ * @param p Start of the number
+ * @param end End of the line
+ * @param value Output for the parsed value
+ * @return Pointer past the last digit, or NULL if p is not at a digit
  */
-static lle_result_t lle_history_parse_line(const char *line,
-                                           lle_history_entry_t **entry,
-                                           lle_memory_pool_t *memory_pool) {
-    if (!line || !entry) {
-        return LLE_ERROR_INVALID_PARAMETER;
+static const char *lle_parse_decimal(const char *p, const char *end,
+                                     uint64_t *value) {
+    if (p >= end || *p < '0' || *p > '9') {
+        return NULL;
     }
 
-    /* Skip comments and empty lines */
-    if (line[0] == '#' || line[0] == '\0' || line[0] == '\n') {
-        *entry = NULL;
-        return LLE_SUCCESS;
+    uint64_t v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (uint64_t)(*p++ - '0');
+    }
+    *value = v;
+    return p;
+}
+
+/**
+ * @brief Locate the fields that follow the timestamp of a TSV line
+ *
+ * Format: COMMAND[\\tEXIT_CODE[\\tWORKING_DIR]]. A missing exit code
+ * reads as 0; the working directory is only read after an exit code.
+ *
+ * @param p First byte after the timestamp and its tab
+ * @param end End of the line, excluding the newline
+ * @param fields Output fields; strings point into the line
+ * @return true if the line names a command, false if it is malformed
+ */
+static bool lle_history_parse_fields(const char *p, const char *end,
+                                     lle_history_line_fields_t *fields) {
+    const char *tab = memchr(p, '\t', (size_t)(end - p));
+    const char *command_end = tab ? tab : end;
+    if (command_end == p) {
+        return false;
     }
 
-    /* Parse fields */
-    uint64_t timestamp = 0;
-    char cmd_buffer[LLE_HISTORY_MAX_COMMAND_LENGTH * 2];
-    int exit_code = 0;
-    char wd_buffer[LLE_HISTORY_MAX_PATH_LENGTH * 2];
+    fields->command = p;
+    fields->command_length = (size_t)(command_end - p);
+    fields->exit_code = 0;
+    fields->working_dir = NULL;
+    fields->working_dir_length = 0;
+    if (!tab) {
+        return true;
+    }
 
-    int parsed =
-        sscanf(line, "%lu\t%[^\t]\t%d\t%[^\n]", (unsigned long *)&timestamp,
-               cmd_buffer, &exit_code, wd_buffer);
+    p = tab + 1;
+    bool negative = p < end && *p == '-';
+    uint64_t code = 0;
+    p = lle_parse_decimal(p + negative, end, &code);
+    if (!p) {
+        return true;
+    }
+    fields->exit_code = (int)(negative ? 0 - code : code);
 
-    if (parsed < 2) {
-        /* Malformed line - skip it */
-        *entry = NULL;
-        return LLE_SUCCESS;
+    if (p + 1 < end && *p == '\t') {
+        fields->working_dir = p + 1;
+        fields->working_dir_length = (size_t)(end - p - 1);
     }
+    return true;
+}
 
-    /* Unescape command */
-    char unescaped_cmd[LLE_HISTORY_MAX_COMMAND_LENGTH];
-    lle_unescape_string(cmd_buffer, unescaped_cmd, sizeof(unescaped_cmd));
+/**
+ * @brief Parse a TSV line in place
+ *
+ * Format: TIMESTAMP\\tCOMMAND\\tEXIT_CODE\\tWORKING_DIR. Comments
+ * (lines starting with #), empty and malformed lines are rejected.
+ *
+ * @param line Start of the line
+ * @param length Line length, excluding the newline
+ * @param fields Output fields; strings point into the line
+ * @return true if the line holds an entry
+ */
+static bool lle_history_parse_line(const char *line, size_t length,
+                                   lle_history_line_fields_t *fields) {
+    const char *end = line + length;
+    const char *p = lle_parse_decimal(line, end, &fields->timestamp);
+    if (!p || p == end || *p != '\t') {
+        return false;
+    }
+    return lle_history_parse_fields(p + 1, end, fields);
+}
 
-    /* Create entry */
-    lle_result_t result =
-        lle_history_entry_create(entry, unescaped_cmd, memory_pool);
-    if (result != LLE_SUCCESS) {
-        return result;
+/**
+ * @brief Create a history entry from parsed line fields
+ *
+ * The command and working directory are unescaped directly into the
+ * entry's own allocations. Entries without a working directory get the
+ * current one, as lle_history_entry_create() would give them.
+ *
+ * @param fields Parsed line fields
+ * @param cwd Current working directory, or NULL if unknown
+ * @param entry Output pointer for the created entry
+ * @return LLE_SUCCESS on success, LLE_ERROR_BUFFER_OVERFLOW if the command
+ *         is too long, or LLE_ERROR_OUT_OF_MEMORY on allocation failure
+ */
+static lle_result_t
+lle_history_entry_from_fields(const lle_history_line_fields_t *fields,
+                              const char *cwd, lle_history_entry_t **entry) {
+    /* Escaping at most doubles the length */
+    if (fields->command_length > LLE_HISTORY_MAX_COMMAND_LENGTH * 2) {
+        return LLE_ERROR_BUFFER_OVERFLOW;
     }
 
-    (*entry)->timestamp = timestamp;
-    (*entry)->exit_code = exit_code;
+    lle_history_entry_t *e = lle_pool_alloc(sizeof(lle_history_entry_t));
+    if (!e) {
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+    memset(e, 0, sizeof(lle_history_entry_t));
 
-    /* Set working directory if present */
-    if (parsed >= 4 && wd_buffer[0] != '\0') {
-        char unescaped_wd[LLE_HISTORY_MAX_PATH_LENGTH];
-        lle_unescape_string(wd_buffer, unescaped_wd, sizeof(unescaped_wd));
+    e->command = lle_pool_alloc(fields->command_length + 1);
+    if (!e->command) {
+        lle_pool_free(e);
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+    e->command_length = lle_unescape_string(
+        fields->command, fields->command_length, e->command);
+    if (e->command_length > LLE_HISTORY_MAX_COMMAND_LENGTH) {
+        lle_pool_free(e->command);
+        lle_pool_free(e);
+        return LLE_ERROR_BUFFER_OVERFLOW;
+    }
 
-        /* Free the working_directory allocated by lle_history_entry_create */
-        if ((*entry)->working_directory) {
-            lle_pool_free((*entry)->working_directory);
+    if (fields->working_dir) {
+        e->working_directory =
+            lle_pool_alloc(fields->working_dir_length + 1);
+        if (e->working_directory) {
+            lle_unescape_string(fields->working_dir,
+                                fields->working_dir_length,
+                                e->working_directory);
         }
-
-        size_t wd_len = strlen(unescaped_wd) + 1;
-        (*entry)->working_directory = lle_pool_alloc(wd_len);
-        if ((*entry)->working_directory) {
-            memcpy((*entry)->working_directory, unescaped_wd, wd_len);
+    } else if (cwd) {
+        size_t cwd_len = strlen(cwd) + 1;
+        e->working_directory = lle_pool_alloc(cwd_len);
+        if (e->working_directory) {
+            memcpy(e->working_directory, cwd, cwd_len);
         }
     }
 
+    e->timestamp = fields->timestamp;
+    e->exit_code = fields->exit_code;
+    e->state = LLE_HISTORY_STATE_ACTIVE;
+
+    *entry = e;
     return LLE_SUCCESS;
 }
 
 /* ============================================================================
- * SAVE OPERATIONS
+ * FILE MAPPING AND INDEX FILE
  * ============================================================================
  */
 
 /**
- * @brief Save all history entries to file
+ * Read-only view of a whole file
+ */
+typedef struct lle_history_file_map {
+    const char *data; /* File contents, NULL if empty */
+    size_t size;      /* Size in bytes */
+    bool mapped;      /* true if mmap()ed, false if read into the pool */
+} lle_history_file_map_t;
+
+/**
+ * @brief Map an open file for reading
  *
- * Writes all history entries to a TSV file with locking for multi-process safety.
+ * Falls back to reading the file into a pooled buffer if it cannot be
+ * mapped.
  *
- * @param core History core engine containing entries to save
- * @param file_path Path to history file to write
- * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if parameters are invalid,
- *         LLE_ERROR_IO_ERROR on file operations failure, or other error codes
+ * @param fd Open file descriptor
+ * @param size File size from fstat()
+ * @param map Output view of the file
+ * @return LLE_SUCCESS on success, LLE_ERROR_OUT_OF_MEMORY or
+ *         LLE_ERROR_IO_ERROR if the fallback read fails
  */
-lle_result_t lle_history_save_to_file(lle_history_core_t *core,
-                                      const char *file_path) {
-    if (!core || !file_path) {
-        return LLE_ERROR_INVALID_PARAMETER;
-    }
-
-    pthread_rwlock_rdlock(&core->lock);
-
-    /* Open file for writing */
-    int fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
-    if (fd < 0) {
-        pthread_rwlock_unlock(&core->lock);
-        return LLE_ERROR_IO_ERROR;
-    }
-
-    /* Acquire lock */
-    lle_result_t result = lle_history_file_lock(fd);
-    if (result != LLE_SUCCESS) {
-        close(fd);
-        pthread_rwlock_unlock(&core->lock);
-        return result;
+static lle_result_t lle_history_map_file(int fd, size_t size,
+                                         lle_history_file_map_t *map) {
+    map->data = NULL;
+    map->size = size;
+    map->mapped = false;
+    if (size == 0) {
+        return LLE_SUCCESS;
     }
 
-    /* Write header */
-    char header[256];
-    snprintf(header, sizeof(header), "%s%s\n# Generated: %lu\n# Entries: %zu\n",
-             LLE_HISTORY_MAGIC_HEADER, LLE_HISTORY_FILE_VERSION_STR,
-             (unsigned long)time(NULL), core->entry_count);
-
-    if (write(fd, header, strlen(header)) < 0) {
-        lle_history_file_unlock(fd);
-        close(fd);
-        pthread_rwlock_unlock(&core->lock);
-        return LLE_ERROR_IO_ERROR;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+        posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+        map->data = data;
+        map->mapped = true;
+        return LLE_SUCCESS;
     }
 
-    /* Write entries */
-    char *line_buffer = lle_pool_alloc(LLE_HISTORY_MAX_LINE_LENGTH);
-    if (!line_buffer) {
-        lle_history_file_unlock(fd);
-        close(fd);
-        pthread_rwlock_unlock(&core->lock);
+    char *buffer = lle_pool_alloc(size);
+    if (!buffer) {
         return LLE_ERROR_OUT_OF_MEMORY;
     }
-
-    for (size_t i = 0; i < core->entry_count; i++) {
-        lle_history_entry_t *entry = core->entries[i];
-        if (!entry)
-            continue;
-
-        /* Skip deleted entries - they were removed by deduplication */
-        if (entry->state == LLE_HISTORY_STATE_DELETED)
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(fd, buffer + done, size - done, (off_t)done);
+        if (n < 0 && errno == EINTR) {
             continue;
-
-        result = lle_history_format_entry(entry, line_buffer,
-                                          LLE_HISTORY_MAX_LINE_LENGTH);
-        if (result != LLE_SUCCESS) {
-            continue; /* Skip malformed entries */
         }
-
-        if (write(fd, line_buffer, strlen(line_buffer)) < 0) {
-            lle_pool_free(line_buffer);
-            lle_history_file_unlock(fd);
-            close(fd);
-            pthread_rwlock_unlock(&core->lock);
-            return LLE_ERROR_IO_ERROR;
+        if (n <= 0) {
+            break;
         }
+        done += (size_t)n;
     }
-
-    lle_pool_free(line_buffer);
-
-    /* Update statistics */
-    core->stats.save_count++;
-
-    /* Release lock and close */
-    lle_history_file_unlock(fd);
-    close(fd);
-
-    pthread_rwlock_unlock(&core->lock);
-
+    map->data = buffer;
+    map->size = done;
     return LLE_SUCCESS;
 }
 
 /**
- * @brief Append single entry to history file
- *
- * For incremental saves without rewriting entire file.
- * Uses file locking for multi-process safety.
+ * @brief Release a view created by lle_history_map_file()
  *
- * @param entry History entry to append
- * @param file_path Path to history file to append to
- * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if parameters are invalid,
- *         LLE_ERROR_IO_ERROR on file operations failure, or other error codes
+ * @param map View to release
  */
-lle_result_t lle_history_append_entry(const lle_history_entry_t *entry,
-                                      const char *file_path) {
-    if (!entry || !file_path) {
-        return LLE_ERROR_INVALID_PARAMETER;
+static void lle_history_unmap_file(lle_history_file_map_t *map) {
+    if (!map->data) {
+        return;
     }
-
-    /* Open file for appending */
-    int fd = open(file_path, O_WRONLY | O_CREAT | O_APPEND, 0600);
-    if (fd < 0) {
-        return LLE_ERROR_IO_ERROR;
+    if (map->mapped) {
+        munmap((void *)map->data, map->size);
+    } else {
+        lle_pool_free((void *)map->data);
     }
+    map->data = NULL;
+}
 
-    /* Acquire lock */
-    lle_result_t result = lle_history_file_lock(fd);
-    if (result != LLE_SUCCESS) {
-        close(fd);
-        return result;
+/**
+ * @brief Build the index file path for a history file
+ *
+ * @param file_path Path to the history file
+ * @return Pooled path string, or NULL on allocation failure
+ */
+static char *lle_history_index_path(const char *file_path) {
+    size_t len = strlen(file_path);
+    char *path = lle_pool_alloc(len + sizeof(LLE_HISTORY_INDEX_SUFFIX));
+    if (path) {
+        memcpy(path, file_path, len);
+        memcpy(path + len, LLE_HISTORY_INDEX_SUFFIX,
+               sizeof(LLE_HISTORY_INDEX_SUFFIX));
     }
+    return path;
+}
 
-    /* Format and write entry */
-    char *line_buffer = lle_pool_alloc(LLE_HISTORY_MAX_LINE_LENGTH);
-    if (!line_buffer) {
-        lle_history_file_unlock(fd);
-        close(fd);
-        return LLE_ERROR_OUT_OF_MEMORY;
+/**
+ * @brief Check whether an index header describes a history file
+ *
+ * @param header Index header
+ * @param st Status of the history file
+ * @param index_size Size of the index file
+ * @return true if the index matches the file and is complete
+ */
+static bool lle_history_index_matches(const lle_history_index_header_t *header,
+                                      const struct stat *st,
+                                      size_t index_size) {
+    if (memcmp(header->magic, LLE_HISTORY_INDEX_MAGIC,
+               sizeof(header->magic)) != 0 ||
+        header->version != LLE_HISTORY_INDEX_VERSION ||
+        header->record_size != sizeof(lle_history_index_record_t)) {
+        return false;
     }
-
-    result = lle_history_format_entry(entry, line_buffer,
-                                      LLE_HISTORY_MAX_LINE_LENGTH);
-    if (result != LLE_SUCCESS) {
-        lle_pool_free(line_buffer);
-        lle_history_file_unlock(fd);
-        close(fd);
-        return result;
+    if (header->source_size != (uint64_t)st->st_size ||
+        header->source_mtime_sec != (int64_t)st->st_mtim.tv_sec ||
+        header->source_mtime_nsec != (int64_t)st->st_mtim.tv_nsec) {
+        return false;
     }
+    size_t records = (index_size - sizeof(*header)) /
+                     sizeof(lle_history_index_record_t);
+    return header->record_count == records &&
+           index_size == sizeof(*header) +
+                             records * sizeof(lle_history_index_record_t);
+}
 
-    if (write(fd, line_buffer, strlen(line_buffer)) < 0) {
-        lle_pool_free(line_buffer);
-        lle_history_file_unlock(fd);
-        close(fd);
-        return LLE_ERROR_IO_ERROR;
+/**
+ * @brief Map the index of a history file if it is current
+ *
+ * @param file_path Path to the history file
+ * @param st Status of the history file
+ * @param map Output view of the index file
+ * @return true if the index exists and matches the history file
+ */
+static bool lle_history_index_open(const char *file_path,
+                                   const struct stat *st,
+                                   lle_history_file_map_t *map) {
+    map->data = NULL;
+    char *index_path = lle_history_index_path(file_path);
+    if (!index_path) {
+        return false;
+    }
+    int fd = open(index_path, O_RDONLY);
+    lle_pool_free(index_path);
+    if (fd < 0) {
+        return false;
     }
 
-    lle_pool_free(line_buffer);
-
-    /* Release lock and close */
-    lle_history_file_unlock(fd);
+    struct stat index_st;
+    bool ok = fstat(fd, &index_st) == 0 &&
+              (size_t)index_st.st_size >=
+                  sizeof(lle_history_index_header_t) &&
+              lle_history_map_file(fd, (size_t)index_st.st_size, map) ==
+                  LLE_SUCCESS &&
+              map->size == (size_t)index_st.st_size &&
+              lle_history_index_matches(
+                  (const lle_history_index_header_t *)map->data, st,
+                  map->size);
     close(fd);
 
-    return LLE_SUCCESS;
+    if (!ok) {
+        lle_history_unmap_file(map);
+    }
+    return ok;
 }
 
-/* ============================================================================
- * LOAD OPERATIONS
- * ============================================================================
+/**
+ * @brief Write all of a buffer to a file descriptor
+ *
+ * @param fd File descriptor to write
+ * @param data Bytes to write
+ * @param size Number of bytes
+ * @return true on success
  */
+static bool lle_write_all(int fd, const void *data, size_t size) {
+    const char *p = data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
 
 /**
- * @brief Load history entries from file
+ * @brief Write the index of a history file that was just saved
  *
- * Reads history entries from a TSV file and populates the history core.
- * If the file does not exist, returns success with empty history.
+ * The index is written to a temporary file and renamed into place, so a
+ * reader never sees a partial one. Failure only costs the next load its
+ * fast path.
  *
- * @param core History core engine to populate with loaded entries
- * @param file_path Path to history file to read
- * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if parameters are invalid,
- *         LLE_ERROR_IO_ERROR on file read failure, or other error codes
+ * @param file_path Path to the history file
+ * @param source_fd Open descriptor of the history file
+ * @param records Entry line records, in file order
+ * @param count Number of records
  */
-lle_result_t lle_history_load_from_file(lle_history_core_t *core,
-                                        const char *file_path) {
-    if (!core || !file_path) {
-        return LLE_ERROR_INVALID_PARAMETER;
-    }
-
-    /* Check if file exists */
+static void lle_history_index_write(const char *file_path, int source_fd,
+                                    const lle_history_index_record_t *records,
+                                    size_t count) {
     struct stat st;
-    if (stat(file_path, &st) != 0) {
-        /* File doesn't exist - not an error, just empty history */
-        return LLE_SUCCESS;
+    if (fstat(source_fd, &st) != 0) {
+        return;
     }
 
-    /* Open file for reading */
-    FILE *fp = fopen(file_path, "r");
-    if (!fp) {
-        return LLE_ERROR_IO_ERROR;
+    char *index_path = lle_history_index_path(file_path);
+    if (!index_path) {
+        return;
     }
-
-    pthread_rwlock_wrlock(&core->lock);
-
-    /* Read and parse lines */
-    char *line_buffer = lle_pool_alloc(LLE_HISTORY_MAX_LINE_LENGTH);
-    if (!line_buffer) {
-        fclose(fp);
-        pthread_rwlock_unlock(&core->lock);
-        return LLE_ERROR_OUT_OF_MEMORY;
+    size_t path_len = strlen(index_path);
+    char *temp_path = lle_pool_alloc(path_len + sizeof(".tmp"));
+    if (!temp_path) {
+        lle_pool_free(index_path);
+        return;
     }
-
-    size_t loaded_count = 0;
-    (void)loaded_count; /* Reserved for load statistics */
-    size_t skipped_count = 0;
-    (void)skipped_count; /* Reserved for skip statistics */
-
-    while (fgets(line_buffer, LLE_HISTORY_MAX_LINE_LENGTH, fp) != NULL) {
-        lle_history_entry_t *entry = NULL;
-        lle_result_t result =
-            lle_history_parse_line(line_buffer, &entry, core->memory_pool);
-
-        if (result != LLE_SUCCESS) {
-            skipped_count++;
-            continue;
+    memcpy(temp_path, index_path, path_len);
+    memcpy(temp_path + path_len, ".tmp", sizeof(".tmp"));
+
+    lle_history_index_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LLE_HISTORY_INDEX_MAGIC, sizeof(header.magic));
+    header.version = LLE_HISTORY_INDEX_VERSION;
+    header.record_size = sizeof(lle_history_index_record_t);
+    header.source_size = (uint64_t)st.st_size;
+    header.source_mtime_sec = (int64_t)st.st_mtim.tv_sec;
+    header.source_mtime_nsec = (int64_t)st.st_mtim.tv_nsec;
+    header.record_count = count;
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd >= 0) {
+        bool ok = lle_write_all(fd, &header, sizeof(header)) &&
+                  lle_write_all(fd, records,
+                                count * sizeof(lle_history_index_record_t));
+        ok = close(fd) == 0 && ok;
+        if (!ok || rename(temp_path, index_path) != 0) {
+            unlink(temp_path);
         }
+    }
 
-        if (!entry) {
-            /* Comment or empty line */
-            continue;
-        }
+    lle_pool_free(temp_path);
+    lle_pool_free(index_path);
+}
 
-        /* Manually add to history without calling lle_history_add_entry */
-        /* (to avoid deadlock - we already have write lock) */
+/* ============================================================================
+ * LAZY LOADING
+ * ============================================================================
+ */
 
-        /* Check capacity */
-        if (core->entry_count >= core->entry_capacity) {
-            result = lle_history_expand_capacity(core);
-            if (result != LLE_SUCCESS) {
-                lle_history_entry_destroy(entry, core->memory_pool);
-                break;
-            }
-        }
+#define LLE_HISTORY_LRU_NONE UINT32_MAX
 
-        /* Assign entry ID */
-        entry->entry_id = core->next_entry_id++;
+/**
+ * Entry line of a lazily loaded history file
+ */
+typedef struct lle_history_lazy_slot {
+    uint64_t offset;   /* Offset of the line in the history file */
+    uint32_t length;   /* Line length, without the newline */
+    uint32_t state;    /* Entry state while the entry is not decoded */
+    uint32_t lru_prev; /* More recently used slot, if decoded */
+    uint32_t lru_next; /* Less recently used slot, if decoded */
+} lle_history_lazy_slot_t;
 
-        /* Add to array */
-        core->entries[core->entry_count] = entry;
+/**
+ * Lazily loaded part of a history: entries[0, count) of the core
+ */
+struct lle_history_lazy {
+    lle_history_file_map_t file;    /* Mapped history file */
+    lle_history_lazy_slot_t *slots; /* One per lazily loaded entry */
+    size_t count;                   /* Number of slots */
+    uint64_t first_id;              /* entry_id of entries[0] */
+    char *cwd;                      /* Directory for lines without one */
+    size_t cache_capacity;          /* Most entries decoded at once */
+    size_t cached;                  /* Entries decoded now */
+    uint32_t lru_head;              /* Most recently used slot */
+    uint32_t lru_tail;              /* Least recently used slot */
+    pthread_mutex_t mutex;          /* Guards the cache under a read lock */
+};
 
-        /* Update linked list */
-        if (core->last_entry) {
-            core->last_entry->next = entry;
-            entry->prev = core->last_entry;
-        } else {
-            core->first_entry = entry;
-        }
-        core->last_entry = entry;
+/**
+ * @brief Decode the entry of a lazily loaded line
+ *
+ * @param lazy Lazy loading state
+ * @param index Slot index
+ * @param entry Output for the decoded entry
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_FORMAT if the line is
+ *         not an entry, or LLE_ERROR_OUT_OF_MEMORY on allocation failure
+ */
+static lle_result_t lle_history_lazy_decode(const lle_history_lazy_t *lazy,
+                                            size_t index,
+                                            lle_history_entry_t **entry) {
+    const lle_history_lazy_slot_t *slot = &lazy->slots[index];
+    lle_history_line_fields_t fields;
+    if (!lle_history_parse_line(lazy->file.data + slot->offset, slot->length,
+                                &fields)) {
+        return LLE_ERROR_INVALID_FORMAT;
+    }
 
-        core->entry_count++;
+    lle_result_t result =
+        lle_history_entry_from_fields(&fields, lazy->cwd, entry);
+    if (result == LLE_ERROR_BUFFER_OVERFLOW) {
+        return LLE_ERROR_INVALID_FORMAT;
+    }
+    if (result != LLE_SUCCESS) {
+        return result;
+    }
 
-        /* Add to index if enabled */
-        if (core->entry_lookup) {
+    (*entry)->entry_id = lazy->first_id + index;
+    (*entry)->state = (lle_history_entry_state_t)slot->state;
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Remove a slot from the cache's LRU list
+ *
+ * @param lazy Lazy loading state
+ * @param index Slot index, currently in the list
+ */
+static void lle_history_lru_unlink(lle_history_lazy_t *lazy, uint32_t index) {
+    lle_history_lazy_slot_t *slot = &lazy->slots[index];
+    if (slot->lru_prev != LLE_HISTORY_LRU_NONE) {
+        lazy->slots[slot->lru_prev].lru_next = slot->lru_next;
+    } else {
+        lazy->lru_head = slot->lru_next;
+    }
+    if (slot->lru_next != LLE_HISTORY_LRU_NONE) {
+        lazy->slots[slot->lru_next].lru_prev = slot->lru_prev;
+    } else {
+        lazy->lru_tail = slot->lru_prev;
+    }
+}
+
+/**
+ * @brief Make a slot the most recently used one
+ *
+ * @param lazy Lazy loading state
+ * @param index Slot index, not in the list
+ */
+static void lle_history_lru_push(lle_history_lazy_t *lazy, uint32_t index) {
+    lle_history_lazy_slot_t *slot = &lazy->slots[index];
+    slot->lru_prev = LLE_HISTORY_LRU_NONE;
+    slot->lru_next = lazy->lru_head;
+    if (lazy->lru_head != LLE_HISTORY_LRU_NONE) {
+        lazy->slots[lazy->lru_head].lru_prev = index;
+    } else {
+        lazy->lru_tail = index;
+    }
+    lazy->lru_head = index;
+}
+
+/**
+ * @brief Add a decoded entry to the cache, evicting the least recently
+ *        used ones while it is full
+ *
+ * An evicted entry's state is kept in its slot before it is freed.
+ *
+ * @param core History core holding the lazy state
+ * @param index Slot index of the decoded entry
+ * @param entry Decoded entry
+ */
+static void lle_history_lazy_cache_add(lle_history_core_t *core, size_t index,
+                                       lle_history_entry_t *entry) {
+    lle_history_lazy_t *lazy = core->lazy;
+    while (lazy->cached >= lazy->cache_capacity &&
+           lazy->lru_tail != LLE_HISTORY_LRU_NONE) {
+        uint32_t victim = lazy->lru_tail;
+        lle_history_entry_t *evicted = core->entries[victim];
+        lazy->slots[victim].state = (uint32_t)evicted->state;
+        lle_history_lru_unlink(lazy, victim);
+        lle_history_entry_destroy(evicted, core->memory_pool);
+        core->entries[victim] = NULL;
+        lazy->cached--;
+    }
+
+    core->entries[index] = entry;
+    lle_history_lru_push(lazy, (uint32_t)index);
+    lazy->cached++;
+}
+
+/**
+ * @brief Free the lazy loading state
+ *
+ * @param lazy Lazy loading state (may be NULL)
+ */
+static void lle_history_lazy_free(lle_history_lazy_t *lazy) {
+    if (!lazy) {
+        return;
+    }
+    lle_history_unmap_file(&lazy->file);
+    lle_pool_free(lazy->slots);
+    lle_pool_free(lazy->cwd);
+    pthread_mutex_destroy(&lazy->mutex);
+    lle_pool_free(lazy);
+}
+
+/**
+ * @brief Number of lazily loaded entries
+ *
+ * @param core History core (caller holds core->lock)
+ * @return Entries at the start of the array that were loaded lazily
+ */
+size_t lle_history_lazy_count(const lle_history_core_t *core) {
+    return core && core->lazy ? core->lazy->count : 0;
+}
+
+/**
+ * @brief Find the array index of a lazily loaded entry by ID
+ *
+ * @param core History core (caller holds core->lock)
+ * @param entry_id Entry ID
+ * @param index Output for the array index
+ * @return true if the ID belongs to a lazily loaded entry
+ */
+bool lle_history_lazy_find_id(const lle_history_core_t *core,
+                              uint64_t entry_id, size_t *index) {
+    const lle_history_lazy_t *lazy = core ? core->lazy : NULL;
+    if (!lazy || entry_id < lazy->first_id ||
+        entry_id - lazy->first_id >= lazy->count) {
+        return false;
+    }
+    *index = (size_t)(entry_id - lazy->first_id);
+    return true;
+}
+
+/**
+ * @brief Decode a lazily loaded entry, or touch it in the cache
+ *
+ * @param core History core (caller holds core->lock)
+ * @param index Array index below lle_history_lazy_count()
+ * @return Entry, or NULL if it could not be decoded
+ */
+lle_history_entry_t *lle_history_lazy_get(lle_history_core_t *core,
+                                          size_t index) {
+    lle_history_lazy_t *lazy = core ? core->lazy : NULL;
+    if (!lazy || index >= lazy->count) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&lazy->mutex);
+    lle_history_entry_t *entry = core->entries[index];
+    if (entry) {
+        if (lazy->lru_head != index) {
+            lle_history_lru_unlink(lazy, (uint32_t)index);
+            lle_history_lru_push(lazy, (uint32_t)index);
+        }
+    } else if (lle_history_lazy_decode(lazy, index, &entry) == LLE_SUCCESS) {
+        lle_history_lazy_cache_add(core, index, entry);
+    } else {
+        entry = NULL;
+    }
+    pthread_mutex_unlock(&lazy->mutex);
+
+    return entry;
+}
+
+/**
+ * @brief Check whether the lazily loaded entries in a range fit in the
+ *        cache together
+ *
+ * @param core History core (caller holds core->lock)
+ * @param start First array index
+ * @param end One past the last array index
+ * @return true if they fit, or if none of them are lazy
+ */
+bool lle_history_lazy_cache_fits(const lle_history_core_t *core,
+                                 size_t start, size_t end) {
+    const lle_history_lazy_t *lazy = core ? core->lazy : NULL;
+    if (!lazy || start >= lazy->count || start >= end) {
+        return true;
+    }
+    size_t lazy_end = end < lazy->count ? end : lazy->count;
+    return lazy_end - start <= lazy->cache_capacity;
+}
+
+/**
+ * @brief Check an escaped command for a backslash followed by 'n'
+ *
+ * That is how both a newline and a literal "\\n" are stored.
+ *
+ * @param str Escaped command
+ * @param length Length in bytes
+ * @return true if the unescaped command is multiline or holds "\\n"
+ */
+static bool lle_escaped_has_newline(const char *str, size_t length) {
+    const char *end = str + length;
+    for (const char *p = memchr(str, '\\', length); p && p + 1 < end;
+         p = memchr(p + 1, '\\', (size_t)(end - p - 1))) {
+        if (p[1] == 'n') {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Find the newest lazily loaded command extending a prefix
+ *
+ * Compares the mapped lines directly; only lines with escapes are
+ * unescaped first. Multiline commands are skipped, as in the resident
+ * scan.
+ *
+ * @param core History core (caller holds core->lock)
+ * @param prefix Typed prefix
+ * @param prefix_len Prefix length in bytes
+ * @return Matching entry, or NULL if none
+ */
+lle_history_entry_t *lle_history_lazy_find_prefix(lle_history_core_t *core,
+                                                  const char *prefix,
+                                                  size_t prefix_len) {
+    lle_history_lazy_t *lazy = core ? core->lazy : NULL;
+    if (!lazy || !prefix) {
+        return NULL;
+    }
+
+    /* An ASCII byte is its own normal form: differing ASCII lead bytes
+     * cannot match */
+    bool ascii_lead = prefix_len > 0 && (unsigned char)prefix[0] < 0x80;
+    size_t found = SIZE_MAX;
+
+    pthread_mutex_lock(&lazy->mutex);
+    for (size_t i = lazy->count; i > 0 && found == SIZE_MAX; i--) {
+        const lle_history_lazy_slot_t *slot = &lazy->slots[i - 1];
+        const lle_history_entry_t *cached = core->entries[i - 1];
+        uint32_t state = cached ? (uint32_t)cached->state : slot->state;
+        if (state != LLE_HISTORY_STATE_ACTIVE) {
+            continue;
+        }
+
+        lle_history_line_fields_t fields;
+        if (!lle_history_parse_line(lazy->file.data + slot->offset,
+                                    slot->length, &fields) ||
+            fields.command_length <= prefix_len) {
+            continue;
+        }
+        const char *command = fields.command;
+        size_t command_len = fields.command_length;
+        if (ascii_lead && (unsigned char)command[0] < 0x80 &&
+            command[0] != prefix[0]) {
+            continue;
+        }
+
+        char *decoded = NULL;
+        if (memchr(command, '\\', command_len)) {
+            if (lle_escaped_has_newline(command, command_len)) {
+                continue;
+            }
+            decoded = lle_pool_alloc(command_len + 1);
+            if (!decoded) {
+                continue;
+            }
+            command_len = lle_unescape_string(command, command_len, decoded);
+            command = decoded;
+        }
+
+        if (command_len > prefix_len &&
+            lle_unicode_is_prefix(prefix, prefix_len, command, command_len,
+                                  NULL)) {
+            found = i - 1;
+        }
+        lle_pool_free(decoded);
+    }
+    pthread_mutex_unlock(&lazy->mutex);
+
+    return found == SIZE_MAX ? NULL : lle_history_lazy_get(core, found);
+}
+
+/**
+ * @brief Decode every lazily loaded entry and index it like a loaded one
+ *
+ * Lines that no longer parse are dropped. On allocation failure the
+ * entries decoded so far stay in the cache and the history stays lazy.
+ *
+ * @param core History core
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if core is
+ *         NULL, or LLE_ERROR_OUT_OF_MEMORY on allocation failure
+ */
+lle_result_t lle_history_lazy_materialize(lle_history_core_t *core) {
+    if (!core) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_rwlock_wrlock(&core->lock);
+    lle_history_lazy_t *lazy = core->lazy;
+    if (!lazy) {
+        pthread_rwlock_unlock(&core->lock);
+        return LLE_SUCCESS;
+    }
+
+    for (size_t i = 0; i < lazy->count; i++) {
+        if (core->entries[i]) {
+            continue;
+        }
+        lle_history_entry_t *entry = NULL;
+        lle_result_t result = lle_history_lazy_decode(lazy, i, &entry);
+        if (result == LLE_ERROR_OUT_OF_MEMORY) {
+            pthread_rwlock_unlock(&core->lock);
+            return result;
+        }
+        if (result == LLE_SUCCESS) {
+            core->entries[i] = entry;
+            lle_history_lru_push(lazy, (uint32_t)i);
+            lazy->cached++;
+        }
+    }
+
+    /* Link the decoded entries in front of the resident ones */
+    lle_history_entry_t *first = NULL;
+    lle_history_entry_t *prev = NULL;
+    for (size_t i = 0; i < lazy->count; i++) {
+        lle_history_entry_t *entry = core->entries[i];
+        if (!entry) {
+            continue;
+        }
+        entry->prev = prev;
+        entry->next = NULL;
+        if (prev) {
+            prev->next = entry;
+        } else {
+            first = entry;
+        }
+        prev = entry;
+
+        if (core->entry_lookup) {
             lle_history_index_insert(core->entry_lookup, entry->entry_id,
                                      entry);
         }
+        if (core->prefix_index) {
+            lle_history_prefix_index_insert(core->prefix_index, entry);
+        }
+    }
+    if (prev) {
+        prev->next = core->first_entry;
+        if (core->first_entry) {
+            core->first_entry->prev = prev;
+        } else {
+            core->last_entry = prev;
+        }
+        core->first_entry = first;
+    }
+
+    core->lazy = NULL;
+    lle_history_lazy_free(lazy);
+
+    pthread_rwlock_unlock(&core->lock);
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Release the lazy loading state
+ *
+ * @param core History core (caller holds the write lock and has destroyed
+ *        the decoded entries)
+ */
+void lle_history_lazy_release(lle_history_core_t *core) {
+    if (!core || !core->lazy) {
+        return;
+    }
+    lle_history_lazy_free(core->lazy);
+    core->lazy = NULL;
+}
+
+/* ============================================================================
+ * SAVE OPERATIONS
+ * ============================================================================
+ */
+
+/**
+ * Buffered writer for a history file being saved
+ */
+typedef struct lle_history_writer {
+    int fd;       /* File being written */
+    char *buffer; /* LLE_HISTORY_MAX_LINE_LENGTH bytes */
+    size_t used;  /* Bytes buffered */
+    bool failed;  /* A write failed; later output is dropped */
+} lle_history_writer_t;
+
+/**
+ * @brief Write out the buffered bytes
+ *
+ * @param writer Writer
+ * @return true unless a write has failed
+ */
+static bool lle_history_writer_flush(lle_history_writer_t *writer) {
+    if (!writer->failed && writer->used > 0 &&
+        !lle_write_all(writer->fd, writer->buffer, writer->used)) {
+        writer->failed = true;
+    }
+    writer->used = 0;
+    return !writer->failed;
+}
+
+/**
+ * @brief Buffer bytes for writing
+ *
+ * @param writer Writer
+ * @param data Bytes to write
+ * @param size Number of bytes
+ */
+static void lle_history_writer_put(lle_history_writer_t *writer,
+                                   const char *data, size_t size) {
+    if (writer->used + size > LLE_HISTORY_MAX_LINE_LENGTH) {
+        lle_history_writer_flush(writer);
+    }
+    if (size > LLE_HISTORY_MAX_LINE_LENGTH) {
+        if (!writer->failed && !lle_write_all(writer->fd, data, size)) {
+            writer->failed = true;
+        }
+        return;
+    }
+    memcpy(writer->buffer + writer->used, data, size);
+    writer->used += size;
+}
+
+/**
+ * @brief Write the header and every live entry of a history
+ *
+ * Entries that were loaded lazily and never decoded are copied from
+ * their mapped lines. Also writes the index file when it is enabled.
+ *
+ * @param core History core
+ * @param fd File to write, empty
+ * @param file_path Path the file will be saved under
+ * @return LLE_SUCCESS on success, LLE_ERROR_OUT_OF_MEMORY on allocation
+ *         failure, or LLE_ERROR_IO_ERROR if a write fails
+ */
+static lle_result_t lle_history_write_entries(lle_history_core_t *core,
+                                              int fd, const char *file_path) {
+    lle_history_writer_t writer = {fd, NULL, 0, false};
+    char *line_buffer = lle_pool_alloc(LLE_HISTORY_MAX_LINE_LENGTH);
+    writer.buffer = lle_pool_alloc(LLE_HISTORY_MAX_LINE_LENGTH);
+    if (!line_buffer || !writer.buffer) {
+        lle_pool_free(line_buffer);
+        lle_pool_free(writer.buffer);
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    pthread_rwlock_rdlock(&core->lock);
+    lle_history_lazy_t *lazy = core->lazy;
+    if (lazy) {
+        pthread_mutex_lock(&lazy->mutex);
+    }
+
+    /* Write header */
+    char header[256];
+    snprintf(header, sizeof(header), "%s%s\n# Generated: %lu\n# Entries: %zu\n",
+             LLE_HISTORY_MAGIC_HEADER, LLE_HISTORY_FILE_VERSION_STR,
+             (unsigned long)time(NULL), core->entry_count);
+
+    size_t offset = strlen(header);
+    lle_history_writer_put(&writer, header, offset);
+
+    /* Index records; without them the save just skips the index */
+    lle_history_index_record_t *records = NULL;
+    size_t record_count = 0;
+    if (core->config->use_index_file && core->entry_count > 0) {
+        records = lle_pool_alloc(core->entry_count *
+                                 sizeof(lle_history_index_record_t));
+    }
+
+    size_t lazy_count = lazy ? lazy->count : 0;
+    for (size_t i = 0; i < core->entry_count && !writer.failed; i++) {
+        lle_history_entry_t *entry = core->entries[i];
+        const char *line = line_buffer;
+        size_t line_length = 0;
+        uint64_t timestamp = 0;
+
+        if (!entry && i < lazy_count) {
+            /* Never decoded: the mapped line is still current */
+            const lle_history_lazy_slot_t *slot = &lazy->slots[i];
+            if (slot->state == LLE_HISTORY_STATE_DELETED)
+                continue;
+            line = lazy->file.data + slot->offset;
+            line_length = slot->length;
+            lle_parse_decimal(line, line + line_length, &timestamp);
+            lle_history_writer_put(&writer, line, line_length);
+            lle_history_writer_put(&writer, "\n", 1);
+            line_length++;
+        } else {
+            if (!entry)
+                continue;
+
+            /* Skip deleted entries - they were removed by deduplication */
+            if (entry->state == LLE_HISTORY_STATE_DELETED)
+                continue;
+
+            if (lle_history_format_entry(entry, line_buffer,
+                                         LLE_HISTORY_MAX_LINE_LENGTH) !=
+                LLE_SUCCESS) {
+                continue; /* Skip malformed entries */
+            }
+            line_length = strlen(line_buffer);
+            timestamp = entry->timestamp;
+            lle_history_writer_put(&writer, line_buffer, line_length);
+        }
+
+        if (records) {
+            records[record_count].offset = offset;
+            records[record_count].length = line_length - 1;
+            records[record_count].timestamp = timestamp;
+            record_count++;
+        }
+        offset += line_length;
+    }
 
+    if (lazy) {
+        pthread_mutex_unlock(&lazy->mutex);
+    }
+
+    lle_result_t result =
+        lle_history_writer_flush(&writer) ? LLE_SUCCESS : LLE_ERROR_IO_ERROR;
+    lle_pool_free(writer.buffer);
+    lle_pool_free(line_buffer);
+
+    /* Index the file while it is still locked against other writers */
+    if (result == LLE_SUCCESS && core->config->use_index_file &&
+        (records || core->entry_count == 0)) {
+        lle_history_index_write(file_path, fd, records, record_count);
+    }
+    lle_pool_free(records);
+
+    if (result == LLE_SUCCESS) {
         /* Update statistics */
-        core->stats.total_entries++;
-        core->stats.active_entries++;
+        core->stats.save_count++;
+    }
+
+    pthread_rwlock_unlock(&core->lock);
+    return result;
+}
+
+/**
+ * @brief Save all history entries to file
+ *
+ * Writes all history entries to a TSV file with locking for multi-process
+ * safety. The entries go to a temporary file beside the history file,
+ * which is then renamed over it: a lazily loaded history keeps its file
+ * mapped, and truncating a mapped file would fault its readers. If no
+ * temporary file can be created there, the file is rewritten in place
+ * once any lazily loaded entries have been decoded.
+ *
+ * @param core History core engine containing entries to save
+ * @param file_path Path to history file to write
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if parameters are invalid,
+ *         LLE_ERROR_IO_ERROR on file operations failure, or other error codes
+ */
+lle_result_t lle_history_save_to_file(lle_history_core_t *core,
+                                      const char *file_path) {
+    if (!core || !file_path) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    /* Follow a symlinked history file so the link itself survives */
+    char *target = realpath(file_path, NULL);
+    const char *dest = target ? target : file_path;
+    size_t dest_len = strlen(dest);
+    char *temp_path = lle_pool_alloc(dest_len + sizeof(".XXXXXX"));
+    int fd = -1;
+    if (temp_path) {
+        memcpy(temp_path, dest, dest_len);
+        memcpy(temp_path + dest_len, ".XXXXXX", sizeof(".XXXXXX"));
+        fd = mkstemp(temp_path);
+    }
+
+    int lock_fd = -1;
+    if (fd >= 0) {
+        /* Keep the permissions of the file being replaced */
+        struct stat st;
+        if (target && stat(target, &st) == 0) {
+            fchmod(fd, st.st_mode & 07777);
+        }
+        lock_fd = open(dest, O_RDONLY | O_CREAT, 0600);
+    } else {
+        lle_pool_free(temp_path);
+        temp_path = NULL;
+
+        lle_result_t result = lle_history_lazy_materialize(core);
+        if (result != LLE_SUCCESS) {
+            free(target);
+            return result;
+        }
+        fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        lock_fd = fd;
+    }
+
+    if (fd < 0 || lock_fd < 0) {
+        if (temp_path) {
+            close(fd);
+            unlink(temp_path);
+            lle_pool_free(temp_path);
+        }
+        free(target);
+        return LLE_ERROR_IO_ERROR;
+    }
+
+    /* Acquire lock */
+    lle_result_t result = lle_history_file_lock(lock_fd);
+    if (result == LLE_SUCCESS) {
+        result = lle_history_write_entries(core, fd, file_path);
+        if (temp_path) {
+            /* Complete the new file before it replaces the old one */
+            if (close(fd) != 0 && result == LLE_SUCCESS) {
+                result = LLE_ERROR_IO_ERROR;
+            }
+            fd = -1;
+            if (result == LLE_SUCCESS && rename(temp_path, dest) != 0) {
+                result = LLE_ERROR_IO_ERROR;
+            }
+        }
+
+        /* Release lock */
+        lle_history_file_unlock(lock_fd);
+    }
+
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (temp_path) {
+        if (result != LLE_SUCCESS) {
+            unlink(temp_path);
+        }
+        close(lock_fd);
+        lle_pool_free(temp_path);
+    }
+    free(target);
+
+    return result;
+}
+
+/**
+ * @brief Append single entry to history file
+ *
+ * For incremental saves without rewriting entire file.
+ * Uses file locking for multi-process safety.
+ *
+ * @param entry History entry to append
+ * @param file_path Path to history file to append to
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if parameters are invalid,
+ *         LLE_ERROR_IO_ERROR on file operations failure, or other error codes
+ */
+lle_result_t lle_history_append_entry(const lle_history_entry_t *entry,
+                                      const char *file_path) {
+    if (!entry || !file_path) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    /* Open file for appending */
+    int fd = open(file_path, O_WRONLY | O_CREAT | O_APPEND, 0600);
+    if (fd < 0) {
+        return LLE_ERROR_IO_ERROR;
+    }
+
+    /* Acquire lock */
+    lle_result_t result = lle_history_file_lock(fd);
+    if (result != LLE_SUCCESS) {
+        close(fd);
+        return result;
+    }
 
-        loaded_count++;
+    /* Format and write entry */
+    char *line_buffer = lle_pool_alloc(LLE_HISTORY_MAX_LINE_LENGTH);
+    if (!line_buffer) {
+        lle_history_file_unlock(fd);
+        close(fd);
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    result = lle_history_format_entry(entry, line_buffer,
+                                      LLE_HISTORY_MAX_LINE_LENGTH);
+    if (result != LLE_SUCCESS) {
+        lle_pool_free(line_buffer);
+        lle_history_file_unlock(fd);
+        close(fd);
+        return result;
+    }
+
+    if (write(fd, line_buffer, strlen(line_buffer)) < 0) {
+        lle_pool_free(line_buffer);
+        lle_history_file_unlock(fd);
+        close(fd);
+        return LLE_ERROR_IO_ERROR;
     }
 
     lle_pool_free(line_buffer);
-    fclose(fp);
+
+    /* Release lock and close */
+    lle_history_file_unlock(fd);
+    close(fd);
+
+    return LLE_SUCCESS;
+}
+
+/* ============================================================================
+ * LOAD OPERATIONS
+ * ============================================================================
+ */
+
+/**
+ * @brief Append a loaded entry to the history
+ *
+ * Adds the entry without lle_history_add_entry(), which would take the
+ * lock the loader already holds and run deduplication on it.
+ *
+ * @param core History core, write-locked by the caller
+ * @param entry Entry to append
+ * @return LLE_SUCCESS on success, or the error from growing the array
+ */
+static lle_result_t lle_history_append_loaded(lle_history_core_t *core,
+                                              lle_history_entry_t *entry) {
+    if (core->entry_count >= core->entry_capacity) {
+        lle_result_t result = lle_history_expand_capacity(core);
+        if (result != LLE_SUCCESS) {
+            return result;
+        }
+    }
+
+    entry->entry_id = core->next_entry_id++;
+    core->entries[core->entry_count++] = entry;
+
+    if (core->last_entry) {
+        core->last_entry->next = entry;
+        entry->prev = core->last_entry;
+    } else {
+        core->first_entry = entry;
+    }
+    core->last_entry = entry;
+
+    if (core->entry_lookup) {
+        lle_history_index_insert(core->entry_lookup, entry->entry_id, entry);
+    }
+    if (core->prefix_index) {
+        lle_history_prefix_index_insert(core->prefix_index, entry);
+    }
+
+    core->stats.total_entries++;
+    core->stats.active_entries++;
+    return LLE_SUCCESS;
+}
+
+/**
+ * @brief Load one parsed line into the history
+ *
+ * @param core History core, write-locked by the caller
+ * @param fields Parsed line fields
+ * @param cwd Current working directory, or NULL if unknown
+ * @return false once the history is full and loading should stop
+ */
+static bool lle_history_load_fields(lle_history_core_t *core,
+                                    const lle_history_line_fields_t *fields,
+                                    const char *cwd) {
+    lle_history_entry_t *entry = NULL;
+    if (lle_history_entry_from_fields(fields, cwd, &entry) != LLE_SUCCESS) {
+        return true; /* Skip the line */
+    }
+    if (lle_history_append_loaded(core, entry) != LLE_SUCCESS) {
+        lle_history_entry_destroy(entry, core->memory_pool);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Load the entry lines listed by a current index file
+ *
+ * @param core History core, write-locked by the caller
+ * @param file Mapped history file
+ * @param index Mapped index file, already matched against the history
+ * @param cwd Current working directory, or NULL if unknown
+ */
+static void lle_history_load_indexed(lle_history_core_t *core,
+                                     const lle_history_file_map_t *file,
+                                     const lle_history_file_map_t *index,
+                                     const char *cwd) {
+    const lle_history_index_header_t *header =
+        (const lle_history_index_header_t *)index->data;
+    const lle_history_index_record_t *records =
+        (const lle_history_index_record_t *)(header + 1);
+
+    /* Size the entry array once */
+    size_t wanted = core->entry_count + header->record_count;
+    while (core->entry_capacity < wanted &&
+           lle_history_expand_capacity(core) == LLE_SUCCESS) {
+    }
+
+    for (uint64_t i = 0; i < header->record_count; i++) {
+        const lle_history_index_record_t *record = &records[i];
+        if (record->offset > file->size ||
+            record->length > file->size - record->offset) {
+            continue;
+        }
+
+        /* The timestamp is in the record; parse from the command on */
+        const char *line = file->data + record->offset;
+        const char *end = line + record->length;
+        const char *tab = memchr(line, '\t', record->length);
+        lle_history_line_fields_t fields;
+        if (!tab || !lle_history_parse_fields(tab + 1, end, &fields)) {
+            continue;
+        }
+        fields.timestamp = record->timestamp;
+
+        if (!lle_history_load_fields(core, &fields, cwd)) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Load every entry line of a history file
+ *
+ * @param core History core, write-locked by the caller
+ * @param file Mapped history file
+ * @param cwd Current working directory, or NULL if unknown
+ */
+static void lle_history_load_lines(lle_history_core_t *core,
+                                   const lle_history_file_map_t *file,
+                                   const char *cwd) {
+    const char *p = file->data;
+    const char *end = p + file->size;
+
+    while (p < end) {
+        const char *newline = memchr(p, '\n', (size_t)(end - p));
+        const char *line_end = newline ? newline : end;
+
+        lle_history_line_fields_t fields;
+        if (lle_history_parse_line(p, (size_t)(line_end - p), &fields) &&
+            !lle_history_load_fields(core, &fields, cwd)) {
+            break;
+        }
+        p = line_end + 1;
+    }
+}
+
+/**
+ * @brief Check that a lazily loaded line will decode
+ *
+ * Only commands long enough to overflow once unescaped are decoded here.
+ *
+ * @param core History core
+ * @param fields Parsed line fields
+ * @return true if the line will decode to an entry
+ */
+static bool lle_history_lazy_line_fits(lle_history_core_t *core,
+                                       const lle_history_line_fields_t *fields) {
+    if (fields->command_length <= LLE_HISTORY_MAX_COMMAND_LENGTH) {
+        return true;
+    }
+    lle_history_entry_t *entry = NULL;
+    if (lle_history_entry_from_fields(fields, NULL, &entry) != LLE_SUCCESS) {
+        return false;
+    }
+    lle_history_entry_destroy(entry, core->memory_pool);
+    return true;
+}
+
+/**
+ * @brief Record where the entry lines of a history file lie
+ *
+ * Takes over the mapping of the file when it holds entries; the entry
+ * array is sized for them and left NULL. Lines listed by a current index
+ * are trusted; otherwise every line is parsed, but nothing is decoded.
+ *
+ * @param core History core, empty and write-locked by the caller
+ * @param file Mapped history file; cleared if the history keeps it
+ * @param index Mapped index file if it is current, otherwise NULL
+ * @param cwd Current working directory, or NULL if unknown
+ * @return true on success, false if the lazy state could not be allocated
+ */
+static bool lle_history_load_lazy(lle_history_core_t *core,
+                                  lle_history_file_map_t *file,
+                                  const lle_history_file_map_t *index,
+                                  const char *cwd) {
+    const lle_history_index_header_t *header =
+        index ? (const lle_history_index_header_t *)index->data : NULL;
+    const char *end = file->data + file->size;
+
+    /* Upper bound on the number of entries */
+    size_t lines = 0;
+    if (header) {
+        lines = header->record_count;
+    } else {
+        for (const char *p = file->data; p < end; lines++) {
+            const char *newline = memchr(p, '\n', (size_t)(end - p));
+            p = newline ? newline + 1 : end;
+        }
+    }
+    if (lines == 0) {
+        return true;
+    }
+
+    lle_history_lazy_t *lazy = lle_pool_alloc(sizeof(lle_history_lazy_t));
+    if (!lazy) {
+        return false;
+    }
+    memset(lazy, 0, sizeof(lle_history_lazy_t));
+    lazy->slots = lle_pool_alloc(lines * sizeof(lle_history_lazy_slot_t));
+    if (cwd) {
+        size_t cwd_len = strlen(cwd) + 1;
+        lazy->cwd = lle_pool_alloc(cwd_len);
+        if (lazy->cwd) {
+            memcpy(lazy->cwd, cwd, cwd_len);
+        }
+    }
+    if (!lazy->slots || (cwd && !lazy->cwd)) {
+        lle_pool_free(lazy->slots);
+        lle_pool_free(lazy->cwd);
+        lle_pool_free(lazy);
+        return false;
+    }
+
+    /* Size the entry array once; entries past max_entries are dropped */
+    while (core->entry_capacity < lines &&
+           lle_history_expand_capacity(core) == LLE_SUCCESS) {
+    }
+    size_t limit = core->entry_capacity < LLE_HISTORY_LRU_NONE
+                       ? core->entry_capacity
+                       : LLE_HISTORY_LRU_NONE;
+
+    size_t count = 0;
+    if (header) {
+        const lle_history_index_record_t *records =
+            (const lle_history_index_record_t *)(header + 1);
+        for (uint64_t i = 0; i < header->record_count && count < limit;
+             i++) {
+            const lle_history_index_record_t *record = &records[i];
+            if (record->offset > file->size ||
+                record->length > file->size - record->offset ||
+                record->length > UINT32_MAX) {
+                continue;
+            }
+            lazy->slots[count].offset = record->offset;
+            lazy->slots[count].length = (uint32_t)record->length;
+            count++;
+        }
+    } else {
+        const char *p = file->data;
+        while (p < end && count < limit) {
+            const char *newline = memchr(p, '\n', (size_t)(end - p));
+            const char *line_end = newline ? newline : end;
+            size_t length = (size_t)(line_end - p);
+
+            lle_history_line_fields_t fields;
+            if (length <= UINT32_MAX &&
+                lle_history_parse_line(p, length, &fields) &&
+                lle_history_lazy_line_fits(core, &fields)) {
+                lazy->slots[count].offset = (uint64_t)(p - file->data);
+                lazy->slots[count].length = (uint32_t)length;
+                count++;
+            }
+            p = line_end + 1;
+        }
+    }
+
+    if (count == 0) {
+        lle_pool_free(lazy->slots);
+        lle_pool_free(lazy->cwd);
+        lle_pool_free(lazy);
+        return true;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        lazy->slots[i].state = LLE_HISTORY_STATE_ACTIVE;
+        lazy->slots[i].lru_prev = LLE_HISTORY_LRU_NONE;
+        lazy->slots[i].lru_next = LLE_HISTORY_LRU_NONE;
+    }
+    lazy->count = count;
+    lazy->first_id = core->next_entry_id;
+    lazy->cache_capacity = core->config->lazy_cache_size;
+    if (lazy->cache_capacity < LLE_HISTORY_LAZY_CACHE_MIN) {
+        lazy->cache_capacity = LLE_HISTORY_LAZY_CACHE_MIN;
+    }
+    lazy->lru_head = LLE_HISTORY_LRU_NONE;
+    lazy->lru_tail = LLE_HISTORY_LRU_NONE;
+    pthread_mutex_init(&lazy->mutex, NULL);
+
+    /* Entries are now read where they are used, not in file order */
+    lazy->file = *file;
+    if (lazy->file.mapped) {
+        posix_madvise((void *)lazy->file.data, lazy->file.size,
+                      POSIX_MADV_RANDOM);
+    }
+    file->data = NULL;
+
+    core->lazy = lazy;
+    core->entry_count = count;
+    core->next_entry_id += count;
+    core->stats.total_entries += count;
+    core->stats.active_entries += count;
+    return true;
+}
+
+/**
+ * @brief Load history entries from file
+ *
+ * Maps the TSV file and parses it in a single pass, or, if the file's
+ * index is current, parses just the lines the index lists. With
+ * lazy_load set and an empty history, the file stays mapped and entries
+ * are decoded on first use instead.
+ * If the file does not exist, returns success with empty history.
+ * Loading stops once the history holds max_entries entries.
+ *
+ * @param core History core engine to populate with loaded entries
+ * @param file_path Path to history file to read
+ * @return LLE_SUCCESS on success, LLE_ERROR_INVALID_PARAMETER if parameters are invalid,
+ *         LLE_ERROR_IO_ERROR on file read failure, or other error codes
+ */
+lle_result_t lle_history_load_from_file(lle_history_core_t *core,
+                                        const char *file_path) {
+    if (!core || !file_path) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    /* Check if file exists */
+    struct stat st;
+    if (stat(file_path, &st) != 0) {
+        /* File doesn't exist - not an error, just empty history */
+        return LLE_SUCCESS;
+    }
+
+    /* Open and map file */
+    int fd = open(file_path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return LLE_ERROR_IO_ERROR;
+    }
+
+    lle_history_file_map_t file;
+    lle_result_t result = lle_history_map_file(fd, (size_t)st.st_size, &file);
+    close(fd);
+    if (result != LLE_SUCCESS) {
+        return result;
+    }
+
+    lle_history_file_map_t index = {NULL, 0, false};
+    bool indexed = core->config->use_index_file && file.data &&
+                   file.size == (size_t)st.st_size &&
+                   lle_history_index_open(file_path, &st, &index);
+
+    /* Lines without a directory get the current one, looked up once */
+    char cwd[LLE_HISTORY_MAX_PATH_LENGTH];
+    bool have_cwd = lle_history_get_cwd(cwd, sizeof(cwd)) == LLE_SUCCESS;
+
+    pthread_rwlock_wrlock(&core->lock);
+
+    /* Loading lazily only into an empty history keeps the lazily loaded
+     * entries at the start of the array */
+    bool lazy = core->config->lazy_load && file.data &&
+                core->entry_count == 0 && !core->lazy &&
+                lle_history_load_lazy(core, &file, indexed ? &index : NULL,
+                                      have_cwd ? cwd : NULL);
+
+    if (!lazy && indexed) {
+        lle_history_load_indexed(core, &file, &index, have_cwd ? cwd : NULL);
+    } else if (!lazy && file.data) {
+        lle_history_load_lines(core, &file, have_cwd ? cwd : NULL);
+    }
 
     /* Update statistics */
     core->stats.load_count++;
 
     pthread_rwlock_unlock(&core->lock);
 
+    lle_history_unmap_file(&index);
+    lle_history_unmap_file(&file);
+
     return LLE_SUCCESS;
 }
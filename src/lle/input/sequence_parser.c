@@ -520,6 +520,55 @@ lle_sequence_parser_process_data(lle_sequence_parser_t *parser,
     return LLE_SUCCESS;
 }
 
+/**
+ * @brief Feed buffered bytes until one input is recognized
+ *
+ * Unlike lle_sequence_parser_process_data(), which consumes all of its
+ * input, this stops as soon as a sequence completes or the parser drops
+ * back to the normal state, and reports how many bytes it used. Callers
+ * that read terminal input in bursts use it to parse an escape sequence
+ * out of a buffer while leaving any text that follows it in place.
+ *
+ * Plain text in the normal state is not consumed.
+ *
+ * @param parser Parser instance
+ * @param data Buffered input bytes
+ * @param data_len Number of bytes available
+ * @param consumed Output: number of bytes used
+ * @param parsed_input Output: parsed input, or NULL if the sequence is
+ *                     still incomplete
+ * @return LLE_SUCCESS on success, error code on failure
+ */
+lle_result_t
+lle_sequence_parser_process_prefix(lle_sequence_parser_t *parser,
+                                   const char *data, size_t data_len,
+                                   size_t *consumed,
+                                   lle_parsed_input_t **parsed_input) {
+    if (!parser || !data || !consumed || !parsed_input) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    *consumed = 0;
+    *parsed_input = NULL;
+
+    for (size_t i = 0; i < data_len; i++) {
+        unsigned char c = data[i];
+        if (parser->state == LLE_PARSER_STATE_NORMAL &&
+            (i > 0 || (c != 0x1B && !IS_CONTROL_CHAR(c)))) {
+            break;
+        }
+
+        lle_result_t result =
+            lle_sequence_parser_process_data(parser, &data[i], 1, parsed_input);
+        *consumed = i + 1;
+        if (result != LLE_SUCCESS || *parsed_input) {
+            return result;
+        }
+    }
+
+    return LLE_SUCCESS;
+}
+
 /**
  * @brief Get current parser state
  *
@@ -403,7 +403,7 @@ static void update_inline_completion(lle_editor_t *editor,
     lle_completion_context_info_t current_context;
     memset(&current_context, 0, sizeof(current_context));
     lle_result_t ctx_result = lle_completion_analyze_context(
-        editor->buffer->data, editor->buffer->cursor.byte_offset,
+        lle_buffer_get_text(editor->buffer), editor->buffer->cursor.byte_offset,
         &current_context);
 
     if (ctx_result == LLE_SUCCESS) {
@@ -453,7 +453,7 @@ static void clear_completion_menu(lle_editor_t *editor) {
  */
 static void get_current_line_bounds(lle_buffer_t *buffer, size_t *start,
                                     size_t *end) {
-    const char *data = buffer->data;
+    const char *data = lle_buffer_get_text(buffer);
     size_t cursor = buffer->cursor.byte_offset;
     size_t len = buffer->length;
 
@@ -491,7 +491,8 @@ lle_result_t lle_beginning_of_line(lle_editor_t *editor) {
     }
 
     /* For multiline: move to beginning of current logical line */
-    if (editor->buffer->length > 0 && strchr(editor->buffer->data, '\n')) {
+    if (editor->buffer->length > 0 &&
+        strchr(lle_buffer_get_text(editor->buffer), '\n')) {
         size_t line_start, line_end;
         get_current_line_bounds(editor->buffer, &line_start, &line_end);
         editor->buffer->cursor.byte_offset = line_start;
@@ -530,7 +531,8 @@ lle_result_t lle_end_of_line(lle_editor_t *editor) {
     }
 
     /* For multiline: move to end of current logical line */
-    if (editor->buffer->length > 0 && strchr(editor->buffer->data, '\n')) {
+    if (editor->buffer->length > 0 &&
+        strchr(lle_buffer_get_text(editor->buffer), '\n')) {
         size_t line_start, line_end;
         get_current_line_bounds(editor->buffer, &line_start, &line_end);
         editor->buffer->cursor.byte_offset = line_end;
@@ -667,7 +669,8 @@ lle_result_t lle_forward_word(lle_editor_t *editor) {
     editor->cursor_manager->sticky_column = false;
 
     /* Find the end of the current word */
-    size_t new_pos = find_word_end(editor->buffer->data, editor->buffer->length,
+    size_t new_pos = find_word_end(lle_buffer_get_text(editor->buffer),
+                                   editor->buffer->length,
                                    editor->buffer->cursor.byte_offset);
 
     /* Use cursor_manager to move to the calculated position */
@@ -697,7 +700,7 @@ lle_result_t lle_backward_word(lle_editor_t *editor) {
     editor->cursor_manager->sticky_column = false;
 
     /* Find the start of the current/previous word */
-    size_t new_pos = find_word_start(editor->buffer->data,
+    size_t new_pos = find_word_start(lle_buffer_get_text(editor->buffer),
                                      editor->buffer->cursor.byte_offset);
 
     /* Use cursor_manager to move to the calculated position */
@@ -791,7 +794,7 @@ lle_result_t lle_previous_line(lle_editor_t *editor) {
         return LLE_ERROR_INVALID_PARAMETER;
     }
 
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t cursor = editor->buffer->cursor.byte_offset;
 
     debug_log("previous_line: cursor=%zu, buffer_len=%zu", cursor,
@@ -933,7 +936,7 @@ lle_result_t lle_next_line(lle_editor_t *editor) {
         return LLE_ERROR_INVALID_PARAMETER;
     }
 
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t cursor = editor->buffer->cursor.byte_offset;
     size_t len = editor->buffer->length;
 
@@ -1019,7 +1022,7 @@ lle_line_nav_result_t lle_next_line_ex(lle_editor_t *editor) {
         return nav_result;
     }
 
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     /* Get current line boundaries */
@@ -1087,7 +1090,8 @@ lle_result_t lle_smart_up_arrow(lle_editor_t *editor) {
     /* Check if buffer is multiline (contains newline) */
     bool is_multiline =
         (editor->buffer->length > 0 &&
-         memchr(editor->buffer->data, '\n', editor->buffer->length) != NULL);
+         memchr(lle_buffer_get_text(editor->buffer), '\n',
+                editor->buffer->length) != NULL);
 
     debug_log("smart_up_arrow: is_multiline=%d", is_multiline);
 
@@ -1149,7 +1153,8 @@ lle_result_t lle_smart_down_arrow(lle_editor_t *editor) {
     /* Check if buffer is multiline (contains newline) */
     bool is_multiline =
         (editor->buffer->length > 0 &&
-         memchr(editor->buffer->data, '\n', editor->buffer->length) != NULL);
+         memchr(lle_buffer_get_text(editor->buffer), '\n',
+                editor->buffer->length) != NULL);
 
     if (is_multiline) {
         /* Multi-line mode: navigate within buffer */
@@ -1303,7 +1308,8 @@ lle_result_t lle_kill_line(lle_editor_t *editor) {
     size_t kill_end;
 
     /* For multiline: kill to end of current logical line */
-    if (editor->buffer->length > 0 && strchr(editor->buffer->data, '\n')) {
+    if (editor->buffer->length > 0 &&
+        strchr(lle_buffer_get_text(editor->buffer), '\n')) {
         size_t line_start, line_end;
         get_current_line_bounds(editor->buffer, &line_start, &line_end);
         kill_end = line_end;
@@ -1315,7 +1321,7 @@ lle_result_t lle_kill_line(lle_editor_t *editor) {
     if (cursor_pos < kill_end) {
         size_t kill_len = kill_end - cursor_pos;
         char *killed_text =
-            strndup(editor->buffer->data + cursor_pos, kill_len);
+            strndup(lle_buffer_get_text(editor->buffer) + cursor_pos, kill_len);
 
         if (killed_text) {
             /* Add to kill ring */
@@ -1346,7 +1352,8 @@ lle_result_t lle_backward_kill_line(lle_editor_t *editor) {
     size_t kill_start;
 
     /* For multiline: kill from beginning of current logical line */
-    if (editor->buffer->length > 0 && strchr(editor->buffer->data, '\n')) {
+    if (editor->buffer->length > 0 &&
+        strchr(lle_buffer_get_text(editor->buffer), '\n')) {
         size_t line_start, line_end;
         get_current_line_bounds(editor->buffer, &line_start, &line_end);
         kill_start = line_start;
@@ -1358,7 +1365,7 @@ lle_result_t lle_backward_kill_line(lle_editor_t *editor) {
     if (cursor_pos > kill_start) {
         size_t kill_len = cursor_pos - kill_start;
         char *killed_text =
-            strndup(editor->buffer->data + kill_start, kill_len);
+            strndup(lle_buffer_get_text(editor->buffer) + kill_start, kill_len);
 
         if (killed_text) {
             /* Add to kill ring */
@@ -1399,13 +1406,13 @@ lle_result_t lle_kill_word(lle_editor_t *editor) {
     }
 
     size_t cursor_pos = editor->buffer->cursor.byte_offset;
-    size_t word_end =
-        find_word_end(editor->buffer->data, editor->buffer->length, cursor_pos);
+    size_t word_end = find_word_end(lle_buffer_get_text(editor->buffer),
+                                    editor->buffer->length, cursor_pos);
 
     if (word_end > cursor_pos) {
         size_t kill_len = word_end - cursor_pos;
         char *killed_text =
-            strndup(editor->buffer->data + cursor_pos, kill_len);
+            strndup(lle_buffer_get_text(editor->buffer) + cursor_pos, kill_len);
 
         if (killed_text) {
             /* Add to kill ring */
@@ -1433,12 +1440,13 @@ lle_result_t lle_backward_kill_word(lle_editor_t *editor) {
     }
 
     size_t cursor_pos = editor->buffer->cursor.byte_offset;
-    size_t word_start = find_word_start(editor->buffer->data, cursor_pos);
+    size_t word_start =
+        find_word_start(lle_buffer_get_text(editor->buffer), cursor_pos);
 
     if (cursor_pos > word_start) {
         size_t kill_len = cursor_pos - word_start;
         char *killed_text =
-            strndup(editor->buffer->data + word_start, kill_len);
+            strndup(lle_buffer_get_text(editor->buffer) + word_start, kill_len);
 
         if (killed_text) {
             /* Add to kill ring */
@@ -1540,7 +1548,7 @@ lle_result_t lle_transpose_chars(lle_editor_t *editor) {
         return LLE_ERROR_INVALID_PARAMETER;
     }
 
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
     size_t cursor = editor->buffer->cursor.byte_offset;
 
@@ -1624,7 +1632,7 @@ lle_result_t lle_transpose_words(lle_editor_t *editor) {
     }
 
     size_t cursor = editor->buffer->cursor.byte_offset;
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     if (len == 0) {
@@ -1778,7 +1786,7 @@ static lle_result_t transform_word_case(lle_editor_t *editor, size_t word_start,
         return LLE_SUCCESS;
     }
 
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     /* Build new word with transformed case */
@@ -1876,6 +1884,7 @@ lle_result_t lle_upcase_word(lle_editor_t *editor) {
     }
 
     size_t cursor = editor->buffer->cursor.byte_offset;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     /* Find word boundaries using grapheme-aware functions */
@@ -1883,17 +1892,15 @@ lle_result_t lle_upcase_word(lle_editor_t *editor) {
 
     /* Skip whitespace forward */
     while (word_start < len) {
-        uint32_t cp =
-            decode_codepoint_at(editor->buffer->data, len, word_start);
+        uint32_t cp = decode_codepoint_at(data, len, word_start);
         if (!is_whitespace_codepoint(cp)) {
             break;
         }
-        word_start =
-            find_next_grapheme_end(editor->buffer->data, len, word_start);
+        word_start = find_next_grapheme_end(data, len, word_start);
     }
 
     /* Find end of word */
-    size_t word_end = find_word_end(editor->buffer->data, len, word_start);
+    size_t word_end = find_word_end(data, len, word_start);
 
     if (word_start >= word_end) {
         return LLE_SUCCESS; /* No word found */
@@ -1914,6 +1921,7 @@ lle_result_t lle_downcase_word(lle_editor_t *editor) {
     }
 
     size_t cursor = editor->buffer->cursor.byte_offset;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     /* Find word boundaries using grapheme-aware functions */
@@ -1921,17 +1929,15 @@ lle_result_t lle_downcase_word(lle_editor_t *editor) {
 
     /* Skip whitespace forward */
     while (word_start < len) {
-        uint32_t cp =
-            decode_codepoint_at(editor->buffer->data, len, word_start);
+        uint32_t cp = decode_codepoint_at(data, len, word_start);
         if (!is_whitespace_codepoint(cp)) {
             break;
         }
-        word_start =
-            find_next_grapheme_end(editor->buffer->data, len, word_start);
+        word_start = find_next_grapheme_end(data, len, word_start);
     }
 
     /* Find end of word */
-    size_t word_end = find_word_end(editor->buffer->data, len, word_start);
+    size_t word_end = find_word_end(data, len, word_start);
 
     if (word_start >= word_end) {
         return LLE_SUCCESS; /* No word found */
@@ -1952,6 +1958,7 @@ lle_result_t lle_capitalize_word(lle_editor_t *editor) {
     }
 
     size_t cursor = editor->buffer->cursor.byte_offset;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     /* Find word boundaries using grapheme-aware functions */
@@ -1959,17 +1966,15 @@ lle_result_t lle_capitalize_word(lle_editor_t *editor) {
 
     /* Skip whitespace forward */
     while (word_start < len) {
-        uint32_t cp =
-            decode_codepoint_at(editor->buffer->data, len, word_start);
+        uint32_t cp = decode_codepoint_at(data, len, word_start);
         if (!is_whitespace_codepoint(cp)) {
             break;
         }
-        word_start =
-            find_next_grapheme_end(editor->buffer->data, len, word_start);
+        word_start = find_next_grapheme_end(data, len, word_start);
     }
 
     /* Find end of word */
-    size_t word_end = find_word_end(editor->buffer->data, len, word_start);
+    size_t word_end = find_word_end(data, len, word_start);
 
     if (word_start >= word_end) {
         return LLE_SUCCESS; /* No word found */
@@ -1993,7 +1998,7 @@ static const char *get_current_buffer_content(lle_editor_t *editor) {
     if (!editor || !editor->buffer || editor->buffer->length == 0) {
         return NULL;
     }
-    return editor->buffer->data;
+    return lle_buffer_get_text(editor->buffer);
 }
 
 /**
@@ -2391,8 +2396,10 @@ lle_result_t lle_history_search_backward(lle_editor_t *editor) {
     }
 
     /* Search backward for command starting with current buffer content */
-    const char *search_prefix =
-        editor->buffer->data ? editor->buffer->data : "";
+    const char *search_prefix = lle_buffer_get_text(editor->buffer);
+    if (!search_prefix) {
+        search_prefix = "";
+    }
 
     if (strlen(search_prefix) == 0) {
         return LLE_SUCCESS; /* Nothing to search for */
@@ -2502,7 +2509,7 @@ lle_result_t lle_complete(lle_editor_t *editor) {
     lle_cursor_position_t cursor_info;
     lle_cursor_manager_get_position(editor->cursor_manager, &cursor_info);
     size_t cursor_pos = cursor_info.byte_offset;
-    const char *buffer = editor->buffer->data;
+    const char *buffer = lle_buffer_get_text(editor->buffer);
 
     lle_completion_result_t *result = NULL;
 
@@ -2882,7 +2889,8 @@ lle_result_t lle_unix_line_discard(lle_editor_t *editor) {
     size_t cursor_pos = editor->buffer->cursor.byte_offset;
 
     if (cursor_pos > 0) {
-        char *killed_text = strndup(editor->buffer->data, cursor_pos);
+        char *killed_text =
+            strndup(lle_buffer_get_text(editor->buffer), cursor_pos);
 
         if (killed_text) {
             /* Add to kill ring */
@@ -2927,7 +2935,7 @@ lle_result_t lle_unix_word_rubout(lle_editor_t *editor) {
     lle_cursor_manager_move_to_byte_offset(editor->cursor_manager,
                                            editor->buffer->cursor.byte_offset);
 
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t cursor_pos = editor->buffer->cursor.byte_offset;
     size_t word_start = cursor_pos;
 
@@ -3015,7 +3023,7 @@ lle_result_t lle_delete_horizontal_space(lle_editor_t *editor) {
     }
 
     size_t cursor = editor->buffer->cursor.byte_offset;
-    const char *data = editor->buffer->data;
+    const char *data = lle_buffer_get_text(editor->buffer);
     size_t len = editor->buffer->length;
 
     /* Find start of whitespace */
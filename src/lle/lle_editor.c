@@ -359,7 +359,7 @@ const char *lle_editor_get_content(const lle_editor_t *editor) {
         return NULL;
     }
 
-    return editor->buffer->data;
+    return lle_buffer_get_text(editor->buffer);
 }
 
 /**
@@ -78,7 +78,7 @@
 #include "lle/lle_watchdog.h" /* Watchdog timer for deadlock detection */
 #include "lle/memory_management.h"
 #include "lle/terminal_abstraction.h"
-#include "lle/unicode_compare.h" /* TR#29 compliant Unicode prefix matching */
+#include "lle/utf8_support.h"
 #include "lle/widget_hooks.h"    /* Widget hooks for lifecycle events */
 #include "signals.h"             /* For SIGINT flag coordination with LLE */
 
@@ -209,6 +209,11 @@ populate_history_config_from_lush_config(lle_history_config_t *hist_config) {
     hist_config->use_indexing =
         config.lle_enable_history_cache; /* Enable fast lookups if cache enabled
                                           */
+    hist_config->use_index_file = true;
+    hist_config->lazy_load = config.lle_lazy_history;
+    hist_config->lazy_cache_size =
+        config.lle_cache_size > 0 ? (size_t)config.lle_cache_size
+                                  : LLE_HISTORY_LAZY_CACHE_SIZE;
 }
 
 /* Event handler context for Step 6 */
@@ -319,7 +324,7 @@ static void end_change_sequence(readline_context_t *ctx) {
  * - Only suggest for non-empty input (>= 2 chars)
  * - Don't suggest if input ends with space
  * - Don't suggest in multiline mode
- * - Search history most-recent-first for best prefix match
+ * - Suggest the most recent history entry extending the input
  *
  * @param ctx Readline context with buffer and editor
  */
@@ -350,7 +355,7 @@ static void update_autosuggestion(readline_context_t *ctx) {
         return;
     }
 
-    const char *input = ctx->buffer->data;
+    const char *input = lle_buffer_get_text(ctx->buffer);
     if (!input || !*input) {
         return;
     }
@@ -365,78 +370,32 @@ static void update_autosuggestion(readline_context_t *ctx) {
         return;
     }
 
-    /* Search LLE history for prefix match (most recent first) */
-    lle_history_core_t *history = ctx->editor->history_system;
-    size_t count = 0;
-    lle_history_get_entry_count(history, &count);
-
-    if (count == 0) {
+    /* Most recent history entry extending the input, via the prefix index
+     * (Unicode NFC-normalized, so equivalent encodings match) */
+    size_t input_len = ctx->buffer->length;
+    lle_history_entry_t *entry = NULL;
+    if (lle_history_find_prefix_match(ctx->editor->history_system, input,
+                                      input_len, &entry) != LLE_SUCCESS ||
+        !entry || entry->command_length <= input_len) {
         return;
     }
 
-    size_t input_len = ctx->buffer->length;
-
-    /* Limit history search to prevent hangs with very large histories */
-    #define MAX_SUGGESTION_SEARCH_ITERATIONS 5000
-    size_t iterations = 0;
-
-    /* Search backwards (most recent first) */
-    for (size_t i = count; i > 0 && iterations < MAX_SUGGESTION_SEARCH_ITERATIONS; i--, iterations++) {
-        /* Check watchdog every 500 iterations to allow abort on timeout */
-        if (iterations > 0 && (iterations % 500) == 0 && lle_watchdog_check()) {
-            return;  /* Watchdog fired - abort suggestion search */
-        }
-
-        lle_history_entry_t *entry = NULL;
-        lle_result_t result =
-            lle_history_get_entry_by_index(history, i - 1, &entry);
-
-        if (result != LLE_SUCCESS || !entry || !entry->command) {
-            continue;
-        }
-
-        /* Skip multiline history entries - don't suggest them for single-line
-         * input This prevents suggesting "echo \"\nhello\"" when user types
-         * "echo"
-         *
-         * Note: LLE history stores newlines as escaped "\n" (two chars:
-         * backslash + n) not as actual newline bytes. Check for both formats.
-         */
-        if (strchr(entry->command, '\n') != NULL ||
-            strstr(entry->command, "\\n") != NULL) {
-            continue;
-        }
-
-        /* Check for prefix match using Unicode-aware comparison (TR#29
-         * compliant) This handles NFC normalization to ensure equivalent
-         * Unicode sequences match regardless of encoding (e.g., precomposed vs
-         * decomposed) */
-        if (lle_unicode_is_prefix(input, input_len, entry->command,
-                                  strlen(entry->command), NULL)) {
-            /* Found a match - get the remaining text */
-            const char *remaining = entry->command + input_len;
-
-            /* Only suggest if there's something to add */
-            if (*remaining) {
-                size_t remaining_len = strlen(remaining);
-
-                /* Ensure buffer is large enough */
-                if (remaining_len + 1 > ctx->suggestion_alloc_size) {
-                    size_t new_size = remaining_len + 64;
-                    char *new_buf = realloc(ctx->current_suggestion, new_size);
-                    if (new_buf) {
-                        ctx->current_suggestion = new_buf;
-                        ctx->suggestion_alloc_size = new_size;
-                    } else {
-                        return; /* Allocation failed */
-                    }
-                }
+    /* Get the remaining text */
+    const char *remaining = entry->command + input_len;
+    size_t remaining_len = strlen(remaining);
 
-                strcpy(ctx->current_suggestion, remaining);
-                return; /* Found best match */
-            }
+    /* Ensure buffer is large enough */
+    if (remaining_len + 1 > ctx->suggestion_alloc_size) {
+        size_t new_size = remaining_len + 64;
+        char *new_buf = realloc(ctx->current_suggestion, new_size);
+        if (!new_buf) {
+            return; /* Allocation failed */
         }
+        ctx->current_suggestion = new_buf;
+        ctx->suggestion_alloc_size = new_size;
     }
+
+    strcpy(ctx->current_suggestion, remaining);
 }
 
 /**
@@ -908,17 +867,20 @@ static void refresh_display(readline_context_t *ctx) {
 }
 
 /**
- * @brief Event handler for character input
- * Step 4: Handler modifies buffer and refreshes display
+ * @brief Insert typed or pasted text at the cursor
+ *
+ * Shared by single-character input and coalesced text runs, so a whole
+ * paste is one buffer insert, one undo step and one display refresh.
+ *
+ * @param ctx Readline context
+ * @param text UTF-8 text to insert
+ * @param text_len Length of text in bytes
+ * @param description Change description for undo tracking
+ * @return LLE_SUCCESS on success, error code on failure
  */
-static lle_result_t handle_character_input(lle_event_t *event,
-                                           void *user_data) {
-    readline_context_t *ctx = (readline_context_t *)user_data;
-
-    /* Get UTF-8 character from event */
-    const char *utf8_char = event->event_data.key.utf8_char;
-    size_t char_len = strlen(utf8_char);
-
+static lle_result_t insert_input_text(readline_context_t *ctx,
+                                      const char *text, size_t text_len,
+                                      const char *description) {
     /* CRITICAL: Reset history navigation when user types a character */
     /* This follows bash/readline behavior: typing exits history mode */
     if (ctx->editor && ctx->editor->history_navigation_pos > 0) {
@@ -961,11 +923,11 @@ static lle_result_t handle_character_input(lle_event_t *event,
     }
 
     /* Begin change sequence for undo tracking */
-    begin_change_sequence(ctx, "insert char");
+    begin_change_sequence(ctx, description);
 
-    /* Insert character into buffer at cursor position */
+    /* Insert text into buffer at cursor position */
     lle_result_t result = lle_buffer_insert_text(
-        ctx->buffer, ctx->buffer->cursor.byte_offset, utf8_char, char_len);
+        ctx->buffer, ctx->buffer->cursor.byte_offset, text, text_len);
 
     /* End change sequence */
     end_change_sequence(ctx);
@@ -984,6 +946,19 @@ static lle_result_t handle_character_input(lle_event_t *event,
     return result;
 }
 
+/**
+ * @brief Event handler for character input
+ * Step 4: Handler modifies buffer and refreshes display
+ */
+static lle_result_t handle_character_input(lle_event_t *event,
+                                           void *user_data) {
+    readline_context_t *ctx = (readline_context_t *)user_data;
+
+    /* Get UTF-8 character from event */
+    const char *utf8_char = event->event_data.key.utf8_char;
+    return insert_input_text(ctx, utf8_char, strlen(utf8_char), "insert char");
+}
+
 /**
  * @brief Event handler for backspace
  * Step 4: Handler modifies buffer and refreshes display
@@ -1088,7 +1063,8 @@ static lle_result_t handle_enter(lle_event_t *event, void *user_data) {
 
     /* Check for incomplete input using shared continuation parser */
     bool incomplete =
-        is_input_incomplete(ctx->buffer->data, ctx->continuation_state);
+        is_input_incomplete(lle_buffer_get_text(ctx->buffer),
+                            ctx->continuation_state);
 
     if (incomplete) {
         /* SAFETY CHECK: Limit maximum line count to prevent infinite loops
@@ -1097,7 +1073,7 @@ static lle_result_t handle_enter(lle_event_t *event, void *user_data) {
          * for any legitimate shell command but prevents runaway input.
          */
         size_t line_count = 1;
-        for (const char *p = ctx->buffer->data; *p; p++) {
+        for (const char *p = lle_buffer_get_text(ctx->buffer); *p; p++) {
             if (*p == '\n') {
                 line_count++;
             }
@@ -1143,10 +1119,10 @@ static lle_result_t handle_enter(lle_event_t *event, void *user_data) {
     }
 
     /* Add to LLE history before completing */
-    if (ctx->editor && ctx->editor->history_system && ctx->buffer->data &&
-        ctx->buffer->data[0] != '\0') {
-        lle_history_add_entry(ctx->editor->history_system, ctx->buffer->data, 0,
-                              NULL);
+    const char *text = lle_buffer_get_text(ctx->buffer);
+    if (ctx->editor && ctx->editor->history_system && text &&
+        text[0] != '\0') {
+        lle_history_add_entry(ctx->editor->history_system, text, 0, NULL);
 
         /* Save to history file (auto-save enabled in config) */
         const char *home = getenv("HOME");
@@ -1159,8 +1135,7 @@ static lle_result_t handle_enter(lle_event_t *event, void *user_data) {
     }
 
     *ctx->done = true;
-    *ctx->final_line =
-        ctx->buffer->data ? strdup(ctx->buffer->data) : strdup("");
+    *ctx->final_line = text ? strdup(text) : strdup("");
 
     return LLE_SUCCESS;
 }
@@ -1229,7 +1204,8 @@ lle_result_t lle_accept_line_context(readline_context_t *ctx) {
 
     /* Check for incomplete input using shared continuation parser */
     bool incomplete =
-        is_input_incomplete(ctx->buffer->data, ctx->continuation_state);
+        is_input_incomplete(lle_buffer_get_text(ctx->buffer),
+                            ctx->continuation_state);
 
     if (incomplete) {
         /* Input incomplete - insert newline and continue editing */
@@ -1281,10 +1257,10 @@ lle_result_t lle_accept_line_context(readline_context_t *ctx) {
     }
 
     /* Add to LLE history before completing */
-    if (ctx->editor && ctx->editor->history_system && ctx->buffer->data &&
-        ctx->buffer->data[0] != '\0') {
-        lle_history_add_entry(ctx->editor->history_system, ctx->buffer->data, 0,
-                              NULL);
+    const char *text = lle_buffer_get_text(ctx->buffer);
+    if (ctx->editor && ctx->editor->history_system && text &&
+        text[0] != '\0') {
+        lle_history_add_entry(ctx->editor->history_system, text, 0, NULL);
 
         /* Save to history file (auto-save enabled in config) */
         const char *home = getenv("HOME");
@@ -1298,8 +1274,7 @@ lle_result_t lle_accept_line_context(readline_context_t *ctx) {
 
     /* Signal completion to readline loop */
     *ctx->done = true;
-    *ctx->final_line =
-        ctx->buffer->data ? strdup(ctx->buffer->data) : strdup("");
+    *ctx->final_line = text ? strdup(text) : strdup("");
 
     return LLE_SUCCESS;
 }
@@ -1684,7 +1659,7 @@ static lle_result_t handle_kill_word(lle_event_t *event, void *user_data) {
         return LLE_SUCCESS; /* At beginning, nothing to kill */
     }
 
-    const char *data = ctx->buffer->data;
+    const char *data = lle_buffer_get_text(ctx->buffer);
     size_t pos = ctx->buffer->cursor.byte_offset;
 
     /* Scan backwards past whitespace */
@@ -2060,10 +2035,8 @@ static lle_result_t handle_kill_to_end(lle_event_t *event, void *user_data) {
         }
 
         if (ctx->kill_buffer && ctx->kill_buffer_size >= delete_length + 1) {
-            memcpy(ctx->kill_buffer,
-                   ctx->buffer->data + ctx->buffer->cursor.byte_offset,
-                   delete_length);
-            ctx->kill_buffer[delete_length] = '\0';
+            lle_buffer_copy_text(ctx->buffer, ctx->buffer->cursor.byte_offset,
+                                 delete_length, ctx->kill_buffer);
         }
 
         /* Begin change sequence for undo tracking */
@@ -2108,8 +2081,8 @@ static lle_result_t handle_kill_line(lle_event_t *event, void *user_data) {
         }
 
         if (ctx->kill_buffer && ctx->kill_buffer_size >= kill_length + 1) {
-            memcpy(ctx->kill_buffer, ctx->buffer->data, kill_length);
-            ctx->kill_buffer[kill_length] = '\0';
+            lle_buffer_copy_text(ctx->buffer, 0, kill_length,
+                                 ctx->kill_buffer);
         }
 
         /* Begin change sequence for undo tracking */
@@ -2234,7 +2207,8 @@ lle_result_t lle_smart_up_arrow_context(readline_context_t *ctx) {
     /* Check if buffer is multiline */
     bool is_multiline =
         (editor->buffer->length > 0 &&
-         memchr(editor->buffer->data, '\n', editor->buffer->length) != NULL);
+         memchr(lle_buffer_get_text(editor->buffer), '\n',
+                editor->buffer->length) != NULL);
 
     if (is_multiline) {
         /* Multi-line mode: use extended function with boundary detection */
@@ -2293,7 +2267,8 @@ lle_result_t lle_smart_down_arrow_context(readline_context_t *ctx) {
     /* Check if buffer is multiline */
     bool is_multiline =
         (editor->buffer->length > 0 &&
-         memchr(editor->buffer->data, '\n', editor->buffer->length) != NULL);
+         memchr(lle_buffer_get_text(editor->buffer), '\n',
+                editor->buffer->length) != NULL);
 
     if (is_multiline) {
         /* Multi-line mode: use extended function with boundary detection */
@@ -2431,7 +2406,10 @@ static lle_result_t handle_interactive_search_start(lle_event_t *event,
     lle_history_core_t *history_core = ctx->editor->history_system;
 
     /* Save current buffer content and cursor for cancel operation */
-    const char *current_line = ctx->buffer->data ? ctx->buffer->data : "";
+    const char *current_line = lle_buffer_get_text(ctx->buffer);
+    if (!current_line) {
+        current_line = "";
+    }
     size_t cursor_pos = ctx->buffer->cursor.byte_offset;
 
     /* Initialize search session */
@@ -2742,6 +2720,15 @@ char *lle_readline(const char *prompt) {
         return NULL;
     }
 
+    /* Deliver typeahead and pastes as whole text runs */
+    lle_unix_interface_set_text_coalescing(unix_iface, true);
+
+    /* Wrap each redraw in a synchronized update where the terminal has one */
+    display_controller_set_synchronized_output(
+        (display_controller_t *)display_controller,
+        term->capabilities &&
+            term->capabilities->supports_synchronized_output);
+
     /* Notify signal handler that LLE readline is active
      * This allows SIGINT (Ctrl+C) to be handled properly by setting a flag
      * that we check in the input loop, rather than using the default behavior
@@ -3234,6 +3221,24 @@ char *lle_readline(const char *prompt) {
                 uint32_t special = event->data.special_key.key;
                 handled =
                     handle_search_mode_input(&ctx, keycode, is_ctrl, special);
+            } else if (event->type == LLE_INPUT_TYPE_TEXT) {
+                /* Search query grows one character at a time */
+                const char *text = event->data.text.bytes;
+                size_t remaining = event->data.text.length;
+                while (remaining > 0) {
+                    uint32_t codepoint = 0;
+                    int n = lle_utf8_decode_codepoint(text, remaining,
+                                                      &codepoint);
+                    if (n <= 0) {
+                        break;
+                    }
+                    if (codepoint >= 0x20) {
+                        handle_search_mode_input(&ctx, codepoint, false, 0);
+                    }
+                    text += n;
+                    remaining -= (size_t)n;
+                }
+                handled = true;
             }
 
             if (handled) {
@@ -3492,6 +3497,14 @@ char *lle_readline(const char *prompt) {
             break;
         }
 
+        case LLE_INPUT_TYPE_TEXT: {
+            /* Typed burst or bracketed paste - one insert for the whole run */
+            insert_input_text(&ctx, event->data.text.bytes,
+                              event->data.text.length,
+                              event->data.text.pasted ? "paste" : "insert text");
+            break;
+        }
+
         case LLE_INPUT_TYPE_EOF: {
             /* EOF received */
             handle_eof(NULL, &ctx);
@@ -68,14 +68,7 @@ bool lle_shell_function_exists(const char *name) {
     if (!name || !current_executor) {
         return false;
     }
-    function_def_t *func = current_executor->functions;
-    while (func) {
-        if (func->name && strcmp(func->name, name) == 0) {
-            return true;
-        }
-        func = func->next;
-    }
-    return false;
+    return executor_function_exists(current_executor, name);
 }
 
 /* ============================================================================
@@ -199,6 +192,11 @@ static void populate_history_config(lle_history_config_t *hist_config) {
             ? config.lle_cache_size
             : 1000;
     hist_config->use_indexing = config.lle_enable_history_cache;
+    hist_config->use_index_file = true;
+    hist_config->lazy_load = config.lle_lazy_history;
+    hist_config->lazy_cache_size =
+        config.lle_cache_size > 0 ? (size_t)config.lle_cache_size
+                                  : LLE_HISTORY_LAZY_CACHE_SIZE;
 }
 
 /* ============================================================================
@@ -516,7 +516,7 @@ lle_multiline_manager_analyze_buffer(lle_multiline_manager_t *manager,
             }
 
             const char *line_content =
-                (const char *)(buffer->data + line->start_offset);
+                lle_buffer_get_text(buffer) + line->start_offset;
             size_t line_length = line->length;
 
             /* Analyze line */
@@ -543,8 +543,9 @@ lle_multiline_manager_analyze_buffer(lle_multiline_manager_t *manager,
     } else if (buffer->length > 0) {
         /* Buffer has text but no line structure - treat entire buffer as one
          * line */
-        result = lle_multiline_analyze_line(
-            buffer->multiline_ctx, (const char *)buffer->data, buffer->length);
+        result = lle_multiline_analyze_line(buffer->multiline_ctx,
+                                            lle_buffer_get_text(buffer),
+                                            buffer->length);
         if (result != LLE_SUCCESS) {
             return result;
         }
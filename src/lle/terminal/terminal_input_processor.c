@@ -140,6 +140,13 @@ static bool validate_event(lle_input_event_t *event) {
         }
         break;
 
+    case LLE_INPUT_TYPE_TEXT:
+        /* Text runs carry at least one complete character */
+        if (!event->data.text.bytes || event->data.text.length == 0) {
+            return false;
+        }
+        break;
+
     case LLE_INPUT_TYPE_SIGNAL:
     case LLE_INPUT_TYPE_TIMEOUT:
     case LLE_INPUT_TYPE_ERROR:
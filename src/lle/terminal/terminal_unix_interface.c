@@ -9,6 +9,8 @@
  * - Terminal attribute saving and restoration
  * - Signal handling (SIGWINCH, SIGTSTP, SIGCONT, SIGINT, SIGTERM)
  * - Non-blocking input with timeout support
+ * - Buffered input: one read() per burst, not per byte
+ * - Bracketed paste and coalesced text runs
  * - UTF-8 character decoding
  * - Window resize event generation
  * - EOF and error detection
@@ -32,6 +34,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <termios.h>
 #include <time.h>
 #include <unistd.h>
@@ -46,6 +49,20 @@
 
 static lle_unix_interface_t *g_signal_interface = NULL;
 
+/** Terminal modes toggled alongside raw mode */
+#define BRACKETED_PASTE_ON "\x1b[?2004h"
+#define BRACKETED_PASTE_OFF "\x1b[?2004l"
+
+/**
+ * @brief Write a terminal mode sequence to stdout (async-signal-safe)
+ *
+ * @param seq NUL-terminated escape sequence
+ */
+static void write_ignoring_result(const char *seq) {
+    ssize_t written = write(STDOUT_FILENO, seq, strlen(seq));
+    (void)written;
+}
+
 /* ============================================================================
  * SIGNAL HANDLERS
  * ============================================================================
@@ -90,6 +107,9 @@ static void handle_sigtstp(int sig) {
         tcsetattr(g_signal_interface->terminal_fd, TCSAFLUSH,
                   &g_signal_interface->original_termios);
     }
+    if (g_signal_interface->bracketed_paste_enabled) {
+        write_ignoring_result(BRACKETED_PASTE_OFF);
+    }
 
     /* Re-raise signal with default handler to actually suspend */
     signal(sig, SIG_DFL);
@@ -115,6 +135,9 @@ static void handle_sigcont(int sig) {
         tcsetattr(g_signal_interface->terminal_fd, TCSAFLUSH,
                   &g_signal_interface->raw_termios);
     }
+    if (g_signal_interface->bracketed_paste_enabled) {
+        write_ignoring_result(BRACKETED_PASTE_ON);
+    }
 
     /* Re-install SIGTSTP handler (it was reset to default) */
     signal(SIGTSTP, handle_sigtstp);
@@ -143,6 +166,9 @@ static void cleanup_on_exit(void) {
         tcsetattr(g_signal_interface->terminal_fd, TCSAFLUSH,
                   &g_signal_interface->original_termios);
     }
+    if (g_signal_interface && g_signal_interface->bracketed_paste_enabled) {
+        write_ignoring_result(BRACKETED_PASTE_OFF);
+    }
 }
 
 /**
@@ -476,6 +502,13 @@ lle_unix_interface_enter_raw_mode(lle_unix_interface_t *interface) {
     }
 
     interface->raw_mode_active = true;
+
+    /* Ask the terminal to bracket pasted text so a multi-line paste is
+     * inserted as text instead of being run line by line */
+    if (isatty(STDOUT_FILENO)) {
+        write_ignoring_result(BRACKETED_PASTE_ON);
+        interface->bracketed_paste_enabled = true;
+    }
     return LLE_SUCCESS;
 }
 
@@ -495,6 +528,12 @@ lle_result_t lle_unix_interface_exit_raw_mode(lle_unix_interface_t *interface) {
         return LLE_SUCCESS;
     }
 
+    if (interface->bracketed_paste_enabled) {
+        write_ignoring_result(BRACKETED_PASTE_OFF);
+        interface->bracketed_paste_enabled = false;
+        interface->paste_active = false;
+    }
+
     /* Restore original settings */
     if (tcsetattr(interface->terminal_fd, TCSAFLUSH,
                   &interface->original_termios) != 0) {
@@ -549,6 +588,24 @@ lle_result_t lle_unix_interface_get_window_size(lle_unix_interface_t *interface,
     return LLE_SUCCESS;
 }
 
+/**
+ * @brief Enable or disable coalescing of typed text into TEXT events
+ *
+ * When enabled, a burst of plain text that arrives in one read (typeahead,
+ * or a paste in a terminal without bracketed paste) is returned as a single
+ * LLE_INPUT_TYPE_TEXT event instead of one CHARACTER event per codepoint.
+ * Bracketed pastes are always returned as TEXT events.
+ *
+ * @param interface Unix interface instance
+ * @param enabled Whether to coalesce typed text
+ */
+void lle_unix_interface_set_text_coalescing(lle_unix_interface_t *interface,
+                                            bool enabled) {
+    if (interface) {
+        interface->coalesce_text = enabled;
+    }
+}
+
 /* ============================================================================
  * CONVERSION HELPERS - PARSED INPUT TO INPUT EVENT
  * ============================================================================
@@ -828,6 +885,309 @@ static int get_utf8_length(unsigned char first_byte) {
     return -1;    /* Invalid first byte */
 }
 
+/* ============================================================================
+ * BUFFERED INPUT
+ * ============================================================================
+ *
+ * Terminal input is read into a ring buffer with one readv() per burst, so
+ * a pasted script costs a handful of syscalls rather than one per byte.
+ * Event decoding then works on buffered bytes.
+ */
+
+/** Ring index mask (buffer size is a power of two) */
+#define INPUT_MASK (LLE_UNIX_INPUT_BUFFER_SIZE - 1)
+
+/** Wait for the rest of a sequence that arrived split across reads */
+#define INPUT_SEQUENCE_TIMEOUT_MS 50
+
+/** Bracketed paste markers */
+#define PASTE_START "\x1b[200~"
+#define PASTE_END "\x1b[201~"
+#define PASTE_MARKER_LEN 6
+
+/**
+ * @brief Buffered byte at an offset from the read position
+ *
+ * @param interface Unix interface instance
+ * @param offset Offset from the next unconsumed byte (< input_count)
+ * @return The byte
+ */
+static unsigned char input_peek(const lle_unix_interface_t *interface,
+                                size_t offset) {
+    return interface
+        ->input_buffer[(interface->input_head + offset) & INPUT_MASK];
+}
+
+/**
+ * @brief Drop bytes from the front of the buffer
+ *
+ * @param interface Unix interface instance
+ * @param count Number of bytes to drop (<= input_count)
+ */
+static void input_consume(lle_unix_interface_t *interface, size_t count) {
+    interface->input_head = (interface->input_head + count) & INPUT_MASK;
+    interface->input_count -= count;
+}
+
+/**
+ * @brief Read everything the terminal has ready into the ring buffer
+ *
+ * Fills the free space, both segments when it wraps, with one readv().
+ *
+ * @param interface Unix interface instance
+ * @return Bytes read, 0 on EOF, -1 on error (errno set)
+ */
+static ssize_t input_fill(lle_unix_interface_t *interface) {
+    if (interface->input_count == LLE_UNIX_INPUT_BUFFER_SIZE) {
+        errno = EAGAIN;
+        return -1;
+    }
+    if (interface->input_count == 0) {
+        interface->input_head = 0;
+    }
+
+    size_t head = interface->input_head;
+    size_t tail = (head + interface->input_count) & INPUT_MASK;
+    struct iovec iov[2];
+    int iovcnt = 1;
+
+    iov[0].iov_base = &interface->input_buffer[tail];
+    if (tail >= head) {
+        iov[0].iov_len = LLE_UNIX_INPUT_BUFFER_SIZE - tail;
+        if (head > 0) {
+            iov[1].iov_base = interface->input_buffer;
+            iov[1].iov_len = head;
+            iovcnt = 2;
+        }
+    } else {
+        iov[0].iov_len = head - tail;
+    }
+
+    ssize_t n = readv(interface->terminal_fd, iov, iovcnt);
+    interface->input_reads++;
+    if (n > 0) {
+        interface->input_count += (size_t)n;
+    }
+    return n;
+}
+
+/**
+ * @brief Make at least count bytes available, waiting up to timeout_ms
+ *
+ * @param interface Unix interface instance
+ * @param count Number of bytes needed
+ * @param timeout_ms Longest wait for each read
+ * @return true if count bytes are buffered
+ */
+static bool input_require(lle_unix_interface_t *interface, size_t count,
+                          uint32_t timeout_ms) {
+    while (interface->input_count < count) {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(interface->terminal_fd, &readfds);
+        struct timeval tv = {(time_t)(timeout_ms / 1000),
+                             (suseconds_t)((timeout_ms % 1000) * 1000)};
+
+        if (select(interface->terminal_fd + 1, &readfds, NULL, NULL, &tv) <=
+                0 ||
+            input_fill(interface) <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Consume the next byte, waiting up to timeout_ms for it
+ *
+ * @param interface Unix interface instance
+ * @param byte Output for the byte
+ * @param timeout_ms Longest wait if nothing is buffered
+ * @return true if a byte was read
+ */
+static bool input_next_byte(lle_unix_interface_t *interface,
+                            unsigned char *byte, uint32_t timeout_ms) {
+    if (!input_require(interface, 1, timeout_ms)) {
+        return false;
+    }
+    *byte = input_peek(interface, 0);
+    input_consume(interface, 1);
+    return true;
+}
+
+/**
+ * @brief Check whether buffered input starts with an escape sequence
+ *
+ * Waits briefly for the rest of the sequence when only a prefix of it has
+ * arrived. Nothing is consumed.
+ *
+ * @param interface Unix interface instance
+ * @param seq Sequence to match
+ * @param len Length of seq
+ * @return true if the buffer starts with seq
+ */
+static bool input_starts_with(lle_unix_interface_t *interface, const char *seq,
+                              size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (!input_require(interface, i + 1, INPUT_SEQUENCE_TIMEOUT_MS) ||
+            input_peek(interface, i) != (unsigned char)seq[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Length of the buffered text character at an offset
+ *
+ * Plain text is printable ASCII or a well-formed multi-byte UTF-8
+ * sequence; pasted text may also contain newlines and tabs.
+ *
+ * @param interface Unix interface instance
+ * @param offset Offset of the character's first byte
+ * @param pasted Whether the text is inside a bracketed paste
+ * @return Byte length, 0 if not text, -1 if more bytes are needed
+ */
+static int input_text_char_length(const lle_unix_interface_t *interface,
+                                  size_t offset, bool pasted) {
+    unsigned char c = input_peek(interface, offset);
+    if (c < 0x80) {
+        if (c >= 0x20 && c != 0x7F) {
+            return 1;
+        }
+        return pasted && (c == '\n' || c == '\r' || c == '\t') ? 1 : 0;
+    }
+
+    int len = get_utf8_length(c);
+    if (len < 2) {
+        return 0;
+    }
+    for (int i = 1; i < len; i++) {
+        if (offset + (size_t)i >= interface->input_count) {
+            return -1;
+        }
+        if ((input_peek(interface, offset + (size_t)i) & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return len;
+}
+
+/**
+ * @brief Return buffered plain text as one TEXT event if it is a run
+ *
+ * Collects printable text from the front of the buffer. A single character
+ * is left for the regular CHARACTER path so ordinary typing is unchanged.
+ *
+ * @param interface Unix interface instance
+ * @param event Output event, populated only on success
+ * @return true if a TEXT event was produced
+ */
+static bool read_typed_text(lle_unix_interface_t *interface,
+                            lle_input_event_t *event) {
+    size_t length = 0;
+    size_t chars = 0;
+
+    while (length < interface->input_count) {
+        int n = input_text_char_length(interface, length, false);
+        if (n <= 0 || length + (size_t)n > LLE_UNIX_TEXT_RUN_MAX) {
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            interface->text_run[length + (size_t)i] =
+                (char)input_peek(interface, length + (size_t)i);
+        }
+        length += (size_t)n;
+        chars++;
+    }
+
+    if (chars < 2) {
+        return false;
+    }
+
+    input_consume(interface, length);
+    interface->text_run[length] = '\0';
+    event->type = LLE_INPUT_TYPE_TEXT;
+    event->timestamp = lle_get_current_time_microseconds();
+    event->data.text.bytes = interface->text_run;
+    event->data.text.length = length;
+    event->data.text.pasted = false;
+    return true;
+}
+
+/**
+ * @brief Read bracketed paste content as a TEXT event
+ *
+ * Returns buffered paste content up to the end marker or the run limit.
+ * Carriage returns become newlines and other control characters are
+ * dropped, so pasted text never triggers key bindings.
+ *
+ * @param interface Unix interface instance (paste_active set)
+ * @param event Output event: TEXT, or TIMEOUT if no content was ready
+ * @return LLE_SUCCESS
+ */
+static lle_result_t read_paste_text(lle_unix_interface_t *interface,
+                                    lle_input_event_t *event) {
+    size_t length = 0;
+    bool after_cr = false;
+
+    while (interface->input_count > 0 && length + 4 <= LLE_UNIX_TEXT_RUN_MAX) {
+        unsigned char c = input_peek(interface, 0);
+
+        if (c == 0x1B &&
+            input_starts_with(interface, PASTE_END, PASTE_MARKER_LEN)) {
+            input_consume(interface, PASTE_MARKER_LEN);
+            interface->paste_active = false;
+            break;
+        }
+
+        int n = input_text_char_length(interface, 0, true);
+        if (n < 0) {
+            /* Character split across reads - finish this run first */
+            if (length > 0) {
+                break;
+            }
+            if (input_require(interface, (size_t)get_utf8_length(c),
+                              INPUT_SEQUENCE_TIMEOUT_MS)) {
+                continue;
+            }
+            n = 0;
+        }
+        if (n == 0) {
+            input_consume(interface, 1);
+            continue;
+        }
+
+        if (c == '\n' && after_cr) {
+            input_consume(interface, 1);
+            after_cr = false;
+            continue;
+        }
+        after_cr = (c == '\r');
+
+        for (int i = 0; i < n; i++) {
+            interface->text_run[length++] = (char)input_peek(interface, 0);
+            input_consume(interface, 1);
+        }
+        if (after_cr) {
+            interface->text_run[length - 1] = '\n';
+        }
+    }
+
+    event->timestamp = lle_get_current_time_microseconds();
+    if (length == 0) {
+        event->type = LLE_INPUT_TYPE_TIMEOUT;
+        return LLE_SUCCESS;
+    }
+
+    interface->text_run[length] = '\0';
+    event->type = LLE_INPUT_TYPE_TEXT;
+    event->data.text.bytes = interface->text_run;
+    event->data.text.length = length;
+    event->data.text.pasted = true;
+    return LLE_SUCCESS;
+}
+
 /**
  * @brief Decode UTF-8 sequence to Unicode codepoint
  *
@@ -836,8 +1196,8 @@ static int get_utf8_length(unsigned char first_byte) {
  * - Returns replacement character (U+FFFD) for invalid sequences
  * - Does not detect overlong sequences (acceptable tradeoff)
  *
- * @param interface Unix interface for reading additional bytes from terminal
- * @param first_byte First byte already read from input
+ * @param interface Unix interface holding the rest of the sequence
+ * @param first_byte First byte, already consumed from the buffer
  * @param codepoint_out Output for decoded Unicode codepoint
  * @param utf8_bytes Output buffer for complete UTF-8 bytes (must be at least 8 bytes)
  * @param byte_count_out Output for number of bytes in sequence (1-4)
@@ -866,24 +1226,24 @@ static lle_result_t decode_utf8(lle_unix_interface_t *interface,
         return LLE_SUCCESS;
     }
 
-    /* Read additional bytes for multi-byte sequence */
+    /* Take additional bytes for multi-byte sequence from the buffer */
     for (int i = 1; i < expected_bytes; i++) {
-        unsigned char byte;
-        ssize_t n = read(interface->terminal_fd, &byte, 1);
-
-        if (n <= 0) {
+        if (!input_require(interface, 1, INPUT_SEQUENCE_TIMEOUT_MS)) {
             /* Incomplete sequence - use replacement character */
             *codepoint_out = 0xFFFD;
             return LLE_SUCCESS;
         }
 
-        /* Validate continuation byte (10xxxxxx) */
+        /* Validate continuation byte (10xxxxxx); an invalid one is left
+         * buffered to start the next event */
+        unsigned char byte = input_peek(interface, 0);
         if ((byte & 0xC0) != 0x80) {
             /* Invalid continuation - use replacement character */
             *codepoint_out = 0xFFFD;
             return LLE_SUCCESS;
         }
 
+        input_consume(interface, 1);
         utf8_bytes[i] = (char)byte;
     }
 
@@ -918,171 +1278,31 @@ static lle_result_t decode_utf8(lle_unix_interface_t *interface,
  */
 
 /**
- * @brief Read input event from terminal with timeout support
+ * @brief Decode the next event from buffered input
  *
- * This implementation provides:
- * - Non-blocking input with configurable timeout
- * - UTF-8 character decoding
- * - Window resize event generation (from SIGWINCH)
- * - EOF detection
- * - Timeout events
+ * Handles, in order: bracketed paste content and markers, escape sequences
+ * through the comprehensive parser, coalesced text runs, the fallback
+ * escape decoder and single UTF-8 characters. Only the bytes belonging to
+ * the returned event are consumed.
  *
- * Higher-level parsing (escape sequences, special keys) is handled by
- * Spec 06 Input Parsing, which wraps this primitive interface.
- *
- * @param interface Unix interface instance
- * @param event Output for read event
- * @param timeout_ms Timeout in milliseconds (UINT32_MAX for infinite)
+ * @param interface Unix interface instance (input_count > 0)
+ * @param event Output for decoded event
  * @return LLE_SUCCESS on success, error code on failure
  */
-lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
-                                           lle_input_event_t *event,
-                                           uint32_t timeout_ms) {
-    if (!interface || !event) {
-        return LLE_ERROR_INVALID_PARAMETER;
-    }
-
-    /* Clear event structure */
-    memset(event, 0, sizeof(lle_input_event_t));
-
-    /* Check for pending SIGWINCH (resize event has priority) */
-    if (interface->sigwinch_received) {
-        interface->sigwinch_received = false;
-
-        size_t width, height;
-        lle_result_t result =
-            lle_unix_interface_get_window_size(interface, &width, &height);
-        if (result != LLE_SUCCESS) {
-            event->type = LLE_INPUT_TYPE_ERROR;
-            event->timestamp = lle_get_current_time_microseconds();
-            event->data.error.error_code = result;
-            snprintf(event->data.error.error_message,
-                     sizeof(event->data.error.error_message),
-                     "Failed to get window size after SIGWINCH");
-            return result;
-        }
-
-        event->type = LLE_INPUT_TYPE_WINDOW_RESIZE;
-        event->timestamp = lle_get_current_time_microseconds();
-        event->data.resize.new_width = width;
-        event->data.resize.new_height = height;
-        interface->size_changed = true;
-
-        return LLE_SUCCESS;
-    }
-
-    /* Use select() for timeout support */
-    fd_set readfds;
-    FD_ZERO(&readfds);
-    FD_SET(interface->terminal_fd, &readfds);
-
-    struct timeval tv;
-    struct timeval *tv_ptr;
-
-    /* Determine effective timeout */
-    uint32_t effective_timeout_ms = timeout_ms;
-
-    /* If parser is accumulating an escape sequence, use a shorter timeout
-     * to detect standalone ESC key (50ms is typical escape sequence timeout) */
-    if (interface->sequence_parser) {
-        lle_parser_state_t parser_state =
-            lle_sequence_parser_get_state(interface->sequence_parser);
-        if (parser_state != LLE_PARSER_STATE_NORMAL) {
-            /* Parser is waiting for more sequence bytes - use 60ms timeout
-             * (slightly longer than the 50ms sequence timeout to ensure we
-             * detect it) */
-            if (effective_timeout_ms == UINT32_MAX ||
-                effective_timeout_ms > 60) {
-                effective_timeout_ms = 60;
-            }
-        }
-    }
-
-    if (effective_timeout_ms == UINT32_MAX) {
-        /* Infinite timeout - pass NULL to select() */
-        tv_ptr = NULL;
-    } else {
-        tv.tv_sec = (time_t)(effective_timeout_ms / 1000);
-        tv.tv_usec = (suseconds_t)((effective_timeout_ms % 1000) * 1000);
-        tv_ptr = &tv;
-    }
-
-    int ready =
-        select(interface->terminal_fd + 1, &readfds, NULL, NULL, tv_ptr);
-
-    if (ready == -1) {
-        if (errno == EINTR) {
-            /* Interrupted by signal - check for resize */
-            if (interface->sigwinch_received) {
-                /* Recursively handle resize event */
-                return lle_unix_interface_read_event(interface, event,
-                                                     timeout_ms);
-            }
-            /* Other signal - return timeout */
-            event->type = LLE_INPUT_TYPE_TIMEOUT;
-            event->timestamp = lle_get_current_time_microseconds();
-            return LLE_SUCCESS;
-        }
-        /* System call error */
-        event->type = LLE_INPUT_TYPE_ERROR;
-        event->timestamp = lle_get_current_time_microseconds();
-        event->data.error.error_code = LLE_ERROR_SYSTEM_CALL;
-        snprintf(event->data.error.error_message,
-                 sizeof(event->data.error.error_message), "select() failed: %s",
-                 strerror(errno));
-        return LLE_ERROR_SYSTEM_CALL;
+static lle_result_t read_buffered_event(lle_unix_interface_t *interface,
+                                        lle_input_event_t *event) {
+    if (interface->paste_active) {
+        return read_paste_text(interface, event);
     }
 
-    if (ready == 0) {
-        /* Timeout - no data available */
-        /* Check if parser is accumulating a sequence that has timed out */
-        if (interface->sequence_parser) {
-            lle_parsed_input_t *timeout_input = NULL;
-            lle_result_t timeout_result = lle_sequence_parser_check_timeout(
-                interface->sequence_parser,
-                300000, /* 300ms timeout for ESC+key (Meta) sequences */
-                &timeout_input);
-
-            if (timeout_result == LLE_SUCCESS && timeout_input) {
-                /* Timeout occurred - return the ESC key event */
-                lle_result_t convert_result =
-                    convert_parsed_input_to_event(timeout_input, event);
-                lle_pool_free(timeout_input);
-                return convert_result;
-            }
-        }
+    unsigned char first_byte = input_peek(interface, 0);
 
-        event->type = LLE_INPUT_TYPE_TIMEOUT;
-        event->timestamp = lle_get_current_time_microseconds();
-        return LLE_SUCCESS;
-    }
-
-    /* Data available - read first byte */
-    unsigned char first_byte = 0;
-    ssize_t bytes_read = read(interface->terminal_fd, &first_byte, 1);
-
-    if (bytes_read == -1) {
-        if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
-            /* Non-blocking read interrupted - treat as timeout */
-            event->type = LLE_INPUT_TYPE_TIMEOUT;
-            event->timestamp = lle_get_current_time_microseconds();
-            return LLE_SUCCESS;
-        }
-        /* Read error */
-        event->type = LLE_INPUT_TYPE_ERROR;
-        event->timestamp = lle_get_current_time_microseconds();
-        event->data.error.error_code = LLE_ERROR_SYSTEM_CALL;
-        snprintf(event->data.error.error_message,
-                 sizeof(event->data.error.error_message), "read() failed: %s",
-                 strerror(errno));
-        return LLE_ERROR_SYSTEM_CALL;
-    }
-
-    if (bytes_read == 0) {
-        /* EOF - stdin closed */
-        event->type = LLE_INPUT_TYPE_EOF;
-        event->timestamp = lle_get_current_time_microseconds();
-        return LLE_SUCCESS;
+    /* Start of a bracketed paste */
+    if (first_byte == 0x1B && interface->bracketed_paste_enabled &&
+        input_starts_with(interface, PASTE_START, PASTE_MARKER_LEN)) {
+        input_consume(interface, PASTE_MARKER_LEN);
+        interface->paste_active = true;
+        return read_paste_text(interface, event);
     }
 
     /* Use comprehensive sequence parser if available */
@@ -1097,9 +1317,16 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
         bool should_parse = parser_accumulating || (first_byte == 0x1B);
 
         if (should_parse) {
-            /* Feed byte to comprehensive parser */
+            /* Feed the buffered bytes to the comprehensive parser; it stops
+             * at the end of the sequence and leaves what follows */
             lle_parsed_input_t *parsed_input = NULL;
-            char byte_buffer[1] = {(char)first_byte};
+            char byte_buffer[64];
+            size_t byte_count = interface->input_count < sizeof(byte_buffer)
+                                    ? interface->input_count
+                                    : sizeof(byte_buffer);
+            for (size_t i = 0; i < byte_count; i++) {
+                byte_buffer[i] = (char)input_peek(interface, i);
+            }
 
             /* Save parser buffer BEFORE process_data (in case it needs to be
              * retrieved) */
@@ -1117,8 +1344,11 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
                 memcpy(saved_buffer, pre_buffer, saved_len);
             }
 
-            lle_result_t parse_result = lle_sequence_parser_process_data(
-                interface->sequence_parser, byte_buffer, 1, &parsed_input);
+            size_t consumed = 0;
+            lle_result_t parse_result = lle_sequence_parser_process_prefix(
+                interface->sequence_parser, byte_buffer, byte_count, &consumed,
+                &parsed_input);
+            input_consume(interface, consumed);
 
             if (parse_result != LLE_SUCCESS) {
                 event->type = LLE_INPUT_TYPE_ERROR;
@@ -1135,9 +1365,10 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
                 /* Note: Parser has already reset its buffer, but we saved it
                  * beforehand */
 
-                /* Add the last byte we just processed to the saved buffer */
-                if (saved_len < sizeof(saved_buffer)) {
-                    saved_buffer[saved_len++] = first_byte;
+                /* Add the bytes we just processed to the saved buffer */
+                for (size_t i = 0;
+                     i < consumed && saved_len < sizeof(saved_buffer); i++) {
+                    saved_buffer[saved_len++] = byte_buffer[i];
                 }
 
                 /* Try key_detector if:
@@ -1205,31 +1436,26 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
          * UTF-8 handling */
     }
 
+    /* A burst of plain text becomes one TEXT event */
+    if (interface->coalesce_text && read_typed_text(interface, event)) {
+        return LLE_SUCCESS;
+    }
+
+    input_consume(interface, 1);
+
     /* Check for escape sequences (ESC = 0x1B = 27) */
     if (first_byte == 0x1B) {
-        /* Read next byte with short timeout to detect escape sequences */
+        /* Next byte with short timeout to detect escape sequences
+         * (100ms timeout for ESC+key (Meta) sequences) */
         unsigned char second_byte;
-        fd_set read_fds;
-        struct timeval escape_timeout;
-
-        FD_ZERO(&read_fds);
-        FD_SET(interface->terminal_fd, &read_fds);
-        escape_timeout.tv_sec = 0;
-        escape_timeout.tv_usec =
-            100000; /* 100ms timeout for ESC+key (Meta) sequences */
 
-        int ready = select(interface->terminal_fd + 1, &read_fds, NULL, NULL,
-                           &escape_timeout);
-
-        if (ready > 0) {
-            ssize_t read2 = read(interface->terminal_fd, &second_byte, 1);
-
-            if (read2 == 1 && second_byte == '[') {
+        if (input_next_byte(interface, &second_byte, 100)) {
+            if (second_byte == '[') {
                 /* CSI sequence - read the final byte */
                 unsigned char final_byte;
-                ssize_t read3 = read(interface->terminal_fd, &final_byte, 1);
 
-                if (read3 == 1) {
+                if (input_next_byte(interface, &final_byte,
+                                    INPUT_SEQUENCE_TIMEOUT_MS)) {
                     /* Detect common arrow key sequences: ESC [ A/B/C/D */
                     event->type = LLE_INPUT_TYPE_SPECIAL_KEY;
                     event->timestamp = lle_get_current_time_microseconds();
@@ -1258,9 +1484,9 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
                         /* Delete key: ESC [ 3 ~ - need to read the ~ */
                         {
                             unsigned char tilde;
-                            ssize_t read4 =
-                                read(interface->terminal_fd, &tilde, 1);
-                            if (read4 == 1 && tilde == '~') {
+                            if (input_next_byte(interface, &tilde,
+                                                INPUT_SEQUENCE_TIMEOUT_MS) &&
+                                tilde == '~') {
                                 event->data.special_key.key = LLE_KEY_DELETE;
                                 return LLE_SUCCESS;
                             }
@@ -1272,12 +1498,12 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
                         break;
                     }
                 }
-            } else if (read2 == 1 && second_byte == 'O') {
+            } else if (second_byte == 'O') {
                 /* SS3 sequence - alternate function keys */
                 unsigned char final_byte;
-                ssize_t read3 = read(interface->terminal_fd, &final_byte, 1);
 
-                if (read3 == 1) {
+                if (input_next_byte(interface, &final_byte,
+                                    INPUT_SEQUENCE_TIMEOUT_MS)) {
                     event->type = LLE_INPUT_TYPE_SPECIAL_KEY;
                     event->timestamp = lle_get_current_time_microseconds();
                     event->data.special_key.modifiers = 0;
@@ -1294,8 +1520,7 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
                         break;
                     }
                 }
-            } else if (read2 == 1 && second_byte >= 0x20 &&
-                       second_byte < 0x7F) {
+            } else if (second_byte >= 0x20 && second_byte < 0x7F) {
                 /* ESC + printable ASCII character = Meta/Alt + character
                  * This is how macOS Terminal and other terminals send Alt+key
                  * when the Option key is configured as Meta, or when user
@@ -1367,6 +1592,182 @@ lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
     return LLE_SUCCESS;
 }
 
+/**
+ * @brief Read input event from terminal with timeout support
+ *
+ * This implementation provides:
+ * - Non-blocking input with configurable timeout
+ * - One read() per input burst; later events come from the buffer
+ * - UTF-8 character decoding
+ * - Window resize event generation (from SIGWINCH)
+ * - EOF detection
+ * - Timeout events
+ *
+ * Higher-level parsing (escape sequences, special keys) is handled by
+ * Spec 06 Input Parsing, which wraps this primitive interface.
+ *
+ * @param interface Unix interface instance
+ * @param event Output for read event
+ * @param timeout_ms Timeout in milliseconds (UINT32_MAX for infinite)
+ * @return LLE_SUCCESS on success, error code on failure
+ */
+lle_result_t lle_unix_interface_read_event(lle_unix_interface_t *interface,
+                                           lle_input_event_t *event,
+                                           uint32_t timeout_ms) {
+    if (!interface || !event) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    /* Clear event structure */
+    memset(event, 0, sizeof(lle_input_event_t));
+
+    /* Check for pending SIGWINCH (resize event has priority) */
+    if (interface->sigwinch_received) {
+        interface->sigwinch_received = false;
+
+        size_t width, height;
+        lle_result_t result =
+            lle_unix_interface_get_window_size(interface, &width, &height);
+        if (result != LLE_SUCCESS) {
+            event->type = LLE_INPUT_TYPE_ERROR;
+            event->timestamp = lle_get_current_time_microseconds();
+            event->data.error.error_code = result;
+            snprintf(event->data.error.error_message,
+                     sizeof(event->data.error.error_message),
+                     "Failed to get window size after SIGWINCH");
+            return result;
+        }
+
+        event->type = LLE_INPUT_TYPE_WINDOW_RESIZE;
+        event->timestamp = lle_get_current_time_microseconds();
+        event->data.resize.new_width = width;
+        event->data.resize.new_height = height;
+        interface->size_changed = true;
+
+        return LLE_SUCCESS;
+    }
+
+    /* Bytes left over from an earlier burst need no new read */
+    if (interface->input_count > 0) {
+        return read_buffered_event(interface, event);
+    }
+
+    /* Use select() for timeout support */
+    fd_set readfds;
+    FD_ZERO(&readfds);
+    FD_SET(interface->terminal_fd, &readfds);
+
+    struct timeval tv;
+    struct timeval *tv_ptr;
+
+    /* Determine effective timeout */
+    uint32_t effective_timeout_ms = timeout_ms;
+
+    /* If parser is accumulating an escape sequence, use a shorter timeout
+     * to detect standalone ESC key (50ms is typical escape sequence timeout) */
+    if (interface->sequence_parser) {
+        lle_parser_state_t parser_state =
+            lle_sequence_parser_get_state(interface->sequence_parser);
+        if (parser_state != LLE_PARSER_STATE_NORMAL) {
+            /* Parser is waiting for more sequence bytes - use 60ms timeout
+             * (slightly longer than the 50ms sequence timeout to ensure we
+             * detect it) */
+            if (effective_timeout_ms == UINT32_MAX ||
+                effective_timeout_ms > 60) {
+                effective_timeout_ms = 60;
+            }
+        }
+    }
+
+    if (effective_timeout_ms == UINT32_MAX) {
+        /* Infinite timeout - pass NULL to select() */
+        tv_ptr = NULL;
+    } else {
+        tv.tv_sec = (time_t)(effective_timeout_ms / 1000);
+        tv.tv_usec = (suseconds_t)((effective_timeout_ms % 1000) * 1000);
+        tv_ptr = &tv;
+    }
+
+    int ready =
+        select(interface->terminal_fd + 1, &readfds, NULL, NULL, tv_ptr);
+
+    if (ready == -1) {
+        if (errno == EINTR) {
+            /* Interrupted by signal - check for resize */
+            if (interface->sigwinch_received) {
+                /* Recursively handle resize event */
+                return lle_unix_interface_read_event(interface, event,
+                                                     timeout_ms);
+            }
+            /* Other signal - return timeout */
+            event->type = LLE_INPUT_TYPE_TIMEOUT;
+            event->timestamp = lle_get_current_time_microseconds();
+            return LLE_SUCCESS;
+        }
+        /* System call error */
+        event->type = LLE_INPUT_TYPE_ERROR;
+        event->timestamp = lle_get_current_time_microseconds();
+        event->data.error.error_code = LLE_ERROR_SYSTEM_CALL;
+        snprintf(event->data.error.error_message,
+                 sizeof(event->data.error.error_message), "select() failed: %s",
+                 strerror(errno));
+        return LLE_ERROR_SYSTEM_CALL;
+    }
+
+    if (ready == 0) {
+        /* Timeout - no data available */
+        /* Check if parser is accumulating a sequence that has timed out */
+        if (interface->sequence_parser) {
+            lle_parsed_input_t *timeout_input = NULL;
+            lle_result_t timeout_result = lle_sequence_parser_check_timeout(
+                interface->sequence_parser,
+                300000, /* 300ms timeout for ESC+key (Meta) sequences */
+                &timeout_input);
+
+            if (timeout_result == LLE_SUCCESS && timeout_input) {
+                /* Timeout occurred - return the ESC key event */
+                lle_result_t convert_result =
+                    convert_parsed_input_to_event(timeout_input, event);
+                lle_pool_free(timeout_input);
+                return convert_result;
+            }
+        }
+
+        event->type = LLE_INPUT_TYPE_TIMEOUT;
+        event->timestamp = lle_get_current_time_microseconds();
+        return LLE_SUCCESS;
+    }
+
+    /* Data available - drain it into the input buffer */
+    ssize_t bytes_read = input_fill(interface);
+
+    if (bytes_read == -1) {
+        if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+            /* Non-blocking read interrupted - treat as timeout */
+            event->type = LLE_INPUT_TYPE_TIMEOUT;
+            event->timestamp = lle_get_current_time_microseconds();
+            return LLE_SUCCESS;
+        }
+        /* Read error */
+        event->type = LLE_INPUT_TYPE_ERROR;
+        event->timestamp = lle_get_current_time_microseconds();
+        event->data.error.error_code = LLE_ERROR_SYSTEM_CALL;
+        snprintf(event->data.error.error_message,
+                 sizeof(event->data.error.error_message), "read() failed: %s",
+                 strerror(errno));
+        return LLE_ERROR_SYSTEM_CALL;
+    }
+
+    if (bytes_read == 0) {
+        /* EOF - stdin closed */
+        event->type = LLE_INPUT_TYPE_EOF;
+        event->timestamp = lle_get_current_time_microseconds();
+        return LLE_SUCCESS;
+    }
+
+    return read_buffered_event(interface, event);
+}
+
 /* ============================================================================
  * UTILITY FUNCTIONS
  * ============================================================================
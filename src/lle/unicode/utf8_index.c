@@ -266,6 +266,14 @@ lle_result_t lle_utf8_index_rebuild(lle_utf8_index_t *index, const char *text,
         }
     }
 
+    /* End sentinels: the end of the text maps to the end in every space */
+    new_byte_to_codepoint[text_length] = codepoint_count;
+    new_codepoint_to_byte[codepoint_count] = text_length;
+    new_codepoint_to_grapheme[codepoint_count] = grapheme_count;
+    new_grapheme_to_codepoint[grapheme_count] = codepoint_count;
+    new_grapheme_to_display[grapheme_count] = display_width_total;
+    new_display_to_grapheme[display_width_total] = grapheme_count;
+
     /* === PHASE 5: Replace old arrays with new ones === */
 
     free(index->byte_to_codepoint);
@@ -311,6 +319,245 @@ cleanup:
     return result;
 }
 
+/**
+ * @brief Move the unchanged tail of a mapping array to its new position
+ * @param array Array to update, reallocated to the new size
+ * @param old_count Entries before the edit, not counting the end sentinel
+ * @param old_tail Index of the first unchanged entry before the edit
+ * @param new_tail Index of that entry after the edit
+ * @param adjust Amount added to every moved entry
+ * @return true on success, false on allocation failure
+ */
+static bool splice_mapping(size_t **array, size_t old_count, size_t old_tail,
+                           size_t new_tail, ptrdiff_t adjust) {
+    size_t tail_length = old_count - old_tail + 1; /* Includes the sentinel */
+    size_t new_size = new_tail + tail_length;
+    size_t *data = *array;
+
+    if (new_tail > old_tail) {
+        data = realloc(data, new_size * sizeof(size_t));
+        if (!data) {
+            return false;
+        }
+        *array = data;
+    }
+
+    memmove(data + new_tail, data + old_tail, tail_length * sizeof(size_t));
+    if (adjust != 0) {
+        for (size_t i = new_tail; i < new_size; i++) {
+            data[i] += (size_t)adjust;
+        }
+    }
+
+    if (new_tail < old_tail) {
+        size_t *shrunk = realloc(data, new_size * sizeof(size_t));
+        if (shrunk) {
+            *array = shrunk;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Update the UTF-8 index for an edit without a full rebuild
+ * @param index The index to update, valid for the text before the edit
+ * @param text The UTF-8 text after the edit
+ * @param text_length Length of text in bytes
+ * @param start Byte offset where the edit began
+ * @param deleted_length Bytes removed at start
+ * @param inserted_length Bytes inserted at start
+ * @return LLE_SUCCESS on success, or error code on failure
+ *
+ * Only the grapheme clusters the edit can change are recomputed. The
+ * window starts at the cluster holding the codepoint before the edit,
+ * since inserted combining marks join it, and ends at the first cluster
+ * boundary at least two codepoints past the inserted text that is not
+ * inside a regional indicator run. Boundaries beyond that point depend
+ * only on unchanged text, so the rest of every mapping array is moved
+ * and offset by the change in counts. Falls back to a full rebuild when
+ * the index does not describe the text before the edit.
+ */
+lle_result_t lle_utf8_index_splice(lle_utf8_index_t *index, const char *text,
+                                   size_t text_length, size_t start,
+                                   size_t deleted_length,
+                                   size_t inserted_length) {
+    if (!index || !text) {
+        return LLE_ERROR_INVALID_PARAMETER;
+    }
+
+    if (start + inserted_length > text_length) {
+        return LLE_ERROR_INVALID_RANGE;
+    }
+
+    size_t old_length = text_length - inserted_length + deleted_length;
+    if (!index->index_valid || index->byte_count != old_length ||
+        start + deleted_length > old_length ||
+        index->codepoint_to_byte[index->byte_to_codepoint[start]] != start) {
+        return lle_utf8_index_rebuild(index, text, text_length);
+    }
+
+    struct timespec start_time, end_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    /* === PHASE 1: Find the window of clusters the edit can change === */
+
+    size_t first_codepoint = index->byte_to_codepoint[start];
+    size_t window_grapheme =
+        first_codepoint > 0
+            ? index->codepoint_to_grapheme[first_codepoint - 1]
+            : 0;
+    size_t window_codepoint = index->grapheme_to_codepoint[window_grapheme];
+    size_t window_byte = index->codepoint_to_byte[window_codepoint];
+    size_t window_column = index->grapheme_to_display[window_grapheme];
+
+    const char *end = text + text_length;
+    const char *ptr = text + start + inserted_length;
+    size_t scanned = 0;
+    bool prev_regional_indicator = false;
+
+    while (ptr < end) {
+        if (scanned >= 2 && !prev_regional_indicator &&
+            is_grapheme_boundary_at_position(ptr, text, end)) {
+            break;
+        }
+
+        int sequence_length = lle_utf8_sequence_length(*ptr);
+        if (sequence_length == 0 || ptr + sequence_length > end) {
+            index->index_valid = false;
+            return LLE_ERROR_INVALID_ENCODING;
+        }
+
+        uint32_t codepoint;
+        lle_utf8_decode_codepoint(ptr, sequence_length, &codepoint);
+        prev_regional_indicator = get_grapheme_break_property(codepoint) ==
+                                  GB_REGIONAL_INDICATOR;
+
+        scanned++;
+        ptr += sequence_length;
+    }
+
+    size_t window_end = (size_t)(ptr - text);
+    size_t old_window_end = window_end - inserted_length + deleted_length;
+
+    /* === PHASE 2: Count and validate the window === */
+
+    size_t codepoint_count = 0;
+    size_t grapheme_count = 0;
+    size_t display_width_total = 0;
+
+    for (ptr = text + window_byte; ptr < text + window_end;) {
+        int sequence_length = lle_utf8_sequence_length(*ptr);
+        if (sequence_length == 0 || ptr + sequence_length > end ||
+            !is_valid_utf8_sequence(ptr, sequence_length)) {
+            index->index_valid = false;
+            return LLE_ERROR_INVALID_ENCODING;
+        }
+
+        codepoint_count++;
+        if (is_grapheme_boundary_at_position(ptr, text, end)) {
+            grapheme_count++;
+
+            uint32_t codepoint;
+            lle_utf8_decode_codepoint(ptr, sequence_length, &codepoint);
+            int width = lle_codepoint_width(codepoint);
+            if (width < 0)
+                width = 1;
+            display_width_total += width;
+        }
+
+        ptr += sequence_length;
+    }
+
+    /* === PHASE 3: Shift the unchanged tail of every array === */
+
+    size_t old_tail_codepoint = index->byte_to_codepoint[old_window_end];
+    size_t old_tail_grapheme =
+        index->codepoint_to_grapheme[old_tail_codepoint];
+    size_t old_tail_column = index->grapheme_to_display[old_tail_grapheme];
+
+    size_t tail_codepoint = window_codepoint + codepoint_count;
+    size_t tail_grapheme = window_grapheme + grapheme_count;
+    size_t tail_column = window_column + display_width_total;
+
+    ptrdiff_t byte_delta = (ptrdiff_t)window_end - (ptrdiff_t)old_window_end;
+    ptrdiff_t codepoint_delta =
+        (ptrdiff_t)tail_codepoint - (ptrdiff_t)old_tail_codepoint;
+    ptrdiff_t grapheme_delta =
+        (ptrdiff_t)tail_grapheme - (ptrdiff_t)old_tail_grapheme;
+    ptrdiff_t column_delta =
+        (ptrdiff_t)tail_column - (ptrdiff_t)old_tail_column;
+
+    if (!splice_mapping(&index->byte_to_codepoint, index->byte_count,
+                        old_window_end, window_end, codepoint_delta) ||
+        !splice_mapping(&index->codepoint_to_byte, index->codepoint_count,
+                        old_tail_codepoint, tail_codepoint, byte_delta) ||
+        !splice_mapping(&index->codepoint_to_grapheme, index->codepoint_count,
+                        old_tail_codepoint, tail_codepoint, grapheme_delta) ||
+        !splice_mapping(&index->grapheme_to_codepoint, index->grapheme_count,
+                        old_tail_grapheme, tail_grapheme, codepoint_delta) ||
+        !splice_mapping(&index->grapheme_to_display, index->grapheme_count,
+                        old_tail_grapheme, tail_grapheme, column_delta) ||
+        !splice_mapping(&index->display_to_grapheme, index->display_width,
+                        old_tail_column, tail_column, grapheme_delta)) {
+        index->index_valid = false;
+        return LLE_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* === PHASE 4: Fill in the window === */
+
+    size_t byte_pos = window_byte;
+    size_t codepoint_pos = window_codepoint;
+    size_t grapheme_pos = window_grapheme;
+    size_t display_col = window_column;
+
+    for (ptr = text + window_byte; ptr < text + window_end;) {
+        int sequence_length = lle_utf8_sequence_length(*ptr);
+
+        for (int i = 0; i < sequence_length; i++) {
+            index->byte_to_codepoint[byte_pos + i] = codepoint_pos;
+        }
+        index->codepoint_to_byte[codepoint_pos] = byte_pos;
+
+        if (is_grapheme_boundary_at_position(ptr, text, end)) {
+            index->grapheme_to_codepoint[grapheme_pos] = codepoint_pos;
+            index->grapheme_to_display[grapheme_pos] = display_col;
+
+            uint32_t codepoint;
+            lle_utf8_decode_codepoint(ptr, sequence_length, &codepoint);
+            int width = lle_codepoint_width(codepoint);
+            if (width < 0)
+                width = 1;
+
+            for (int w = 0; w < width; w++) {
+                index->display_to_grapheme[display_col + w] = grapheme_pos;
+            }
+
+            display_col += width;
+            grapheme_pos++;
+        }
+        index->codepoint_to_grapheme[codepoint_pos] = grapheme_pos - 1;
+
+        codepoint_pos++;
+        byte_pos += sequence_length;
+        ptr += sequence_length;
+    }
+
+    /* === PHASE 5: Update metadata and timing === */
+
+    index->byte_count = text_length;
+    index->codepoint_count += codepoint_delta;
+    index->grapheme_count += grapheme_delta;
+    index->display_width += column_delta;
+    index->splice_count++;
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    index->last_update_time =
+        (end_time.tv_sec - start_time.tv_sec) * 1000000000ULL +
+        (end_time.tv_nsec - start_time.tv_nsec);
+
+    return LLE_SUCCESS;
+}
+
 /**
  * @brief Convert byte offset to codepoint index
  * @param index The UTF-8 index to query
@@ -329,7 +576,7 @@ lle_result_t lle_utf8_index_byte_to_codepoint(const lle_utf8_index_t *index,
         return LLE_ERROR_INVALID_STATE;
     }
 
-    if (byte_offset >= index->byte_count) {
+    if (byte_offset > index->byte_count) {
         return LLE_ERROR_INVALID_RANGE;
     }
 
@@ -355,7 +602,7 @@ lle_result_t lle_utf8_index_codepoint_to_byte(const lle_utf8_index_t *index,
         return LLE_ERROR_INVALID_STATE;
     }
 
-    if (codepoint_index >= index->codepoint_count) {
+    if (codepoint_index > index->codepoint_count) {
         return LLE_ERROR_INVALID_RANGE;
     }
 
@@ -381,7 +628,7 @@ lle_result_t lle_utf8_index_codepoint_to_grapheme(const lle_utf8_index_t *index,
         return LLE_ERROR_INVALID_STATE;
     }
 
-    if (codepoint_index >= index->codepoint_count) {
+    if (codepoint_index > index->codepoint_count) {
         return LLE_ERROR_INVALID_RANGE;
     }
 
@@ -407,7 +654,7 @@ lle_result_t lle_utf8_index_grapheme_to_codepoint(const lle_utf8_index_t *index,
         return LLE_ERROR_INVALID_STATE;
     }
 
-    if (grapheme_index >= index->grapheme_count) {
+    if (grapheme_index > index->grapheme_count) {
         return LLE_ERROR_INVALID_RANGE;
     }
 
@@ -433,7 +680,7 @@ lle_result_t lle_utf8_index_grapheme_to_display(const lle_utf8_index_t *index,
         return LLE_ERROR_INVALID_STATE;
     }
 
-    if (grapheme_index >= index->grapheme_count) {
+    if (grapheme_index > index->grapheme_count) {
         return LLE_ERROR_INVALID_RANGE;
     }
 
@@ -459,7 +706,7 @@ lle_result_t lle_utf8_index_display_to_grapheme(const lle_utf8_index_t *index,
         return LLE_ERROR_INVALID_STATE;
     }
 
-    if (display_column >= index->display_width) {
+    if (display_column > index->display_width) {
         return LLE_ERROR_INVALID_RANGE;
     }
 
@@ -431,8 +431,8 @@ static lle_result_t widget_transient_prompt(lle_editor_t *editor,
 
     /* Get command text from editor buffer */
     const char *command_text = NULL;
-    if (editor && editor->buffer && editor->buffer->data) {
-        command_text = editor->buffer->data;
+    if (editor && editor->buffer) {
+        command_text = lle_buffer_get_text(editor->buffer);
     }
 
     /* Apply transient prompt through display controller (screen buffer) */
@@ -32,6 +32,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 /**
  * @brief Detect if command line ends with background operator
@@ -82,6 +83,73 @@ void executor_update_job_status(executor_t *executor);
 // Global executor for persistent function definitions across commands
 static executor_t *global_executor = NULL;
 
+executor_t *ensure_global_executor(void) {
+    if (global_executor) {
+        return global_executor;
+    }
+
+    global_executor = executor_new();
+    if (!global_executor) {
+        return NULL;
+    }
+
+    // Set script context if running a script (not interactive)
+    // $0 contains the script name when running a script
+    if (!is_interactive_shell()) {
+        char *script_name = symtable_get_global("0");
+        if (script_name) {
+            executor_set_script_context(global_executor, script_name, 1);
+            free(script_name);
+        }
+    }
+    return global_executor;
+}
+
+/**
+ * @brief Run the script file being executed, parsed as a whole
+ *
+ * Only used when the stream opened by init() is the file named by $0 and
+ * the file parses as a whole; otherwise the main loop reads the script
+ * construct by construct. The script's status, or the status given to
+ * exit, is left in last_exit_status for the shell to exit with. When a
+ * command changes the shell mode, the stream is positioned at the next
+ * command so the main loop reads the rest of the file.
+ *
+ * @param in Script stream opened by init()
+ * @return true if the script was run, false if the main loop should run it
+ *         or the rest of it
+ */
+static bool execute_script_whole(FILE *in) {
+    char *path = symtable_get_global("0");
+    if (!path) {
+        return false;
+    }
+
+    struct stat in_st, path_st;
+    bool same_file = fstat(fileno(in), &in_st) == 0 &&
+                     stat(path, &path_st) == 0 &&
+                     in_st.st_dev == path_st.st_dev &&
+                     in_st.st_ino == path_st.st_ino;
+    script_ast_t *script = same_file ? executor_load_script(path, false) : NULL;
+    free(path);
+    if (!script) {
+        return false;
+    }
+
+    executor_t *executor = ensure_global_executor();
+    if (!executor) {
+        script_ast_release(script);
+        return false;
+    }
+
+    off_t resume;
+    last_exit_status = executor_execute_script(executor, script, &resume);
+    script_ast_release(script);
+
+    // The shell mode changed; the main loop reads the rest of the file
+    return resume < 0 || fseek(in, resume, SEEK_SET) != 0;
+}
+
 /**
  * @brief Main entry point for the Lush shell
  *
@@ -282,6 +350,12 @@ int main(int argc, char **argv) {
         exit(exit_status);
     }
 
+    // A script file is parsed and run in one pass when it can be
+    if (!is_interactive_shell() && in && in != stdin && !shell_opts.onecmd &&
+        execute_script_whole(in)) {
+        exit_flag = true;
+    }
+
     // Read input (buffering complete syntactic units) until user exits
     // or EOF is read from either stdin or input file
     while (!exit_flag) {
@@ -408,21 +482,8 @@ int main(int argc, char **argv) {
 int parse_and_execute(const char *command) {
     // Use global persistent executor for all commands to maintain function
     // definitions
-    if (!global_executor) {
-        global_executor = executor_new();
-        if (!global_executor) {
-            return 1;
-        }
-        
-        // Set script context if running a script (not interactive)
-        // $0 contains the script name when running a script
-        if (!is_interactive_shell()) {
-            char *script_name = symtable_get_global("0");
-            if (script_name) {
-                executor_set_script_context(global_executor, script_name, 1);
-                free(script_name);
-            }
-        }
+    if (!ensure_global_executor()) {
+        return 1;
     }
 
     int exit_status = executor_execute_command_line(global_executor, command);
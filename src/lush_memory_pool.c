@@ -3,9 +3,10 @@
  * @brief Memory pool system for display operations
  *
  * Enterprise-grade memory management optimized for display operations:
- * - Pre-allocated memory pools by size class (small, medium, large, xlarge)
- * - Thread-safe allocation and deallocation
- * - Automatic malloc fallback for oversized requests
+ * - One slab per size class (small, medium, large, xlarge), reserved as a
+ *   single address range so frees find their class by address
+ * - Per-thread free block caches; the shared lists are touched in batches
+ * - Automatic malloc fallback for oversized requests, tracked by address
  * - Performance statistics and debugging support
  * - Pool health monitoring
  *
@@ -15,103 +16,45 @@
  */
 
 #include "lush_memory_pool.h"
-#include <assert.h>
 #include <inttypes.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/time.h>
+#include <sys/mman.h>
 
 // Global memory pool system instance
 lush_memory_pool_system_t *global_memory_pool = NULL;
 
-// Thread safety mutex for pool operations
+// Serializes init, shutdown and the malloc fallback table
 static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// Bumped by init and by shutdown, so it is odd while the pool is live and
+// zero until the pool is first initialized. Thread caches remember the
+// generation they were filled under and drop their blocks when it changes.
+static _Atomic uint64_t pool_generation = 0;
+
 // Debug and error tracking
 static bool debug_mode = false;
-static lush_pool_error_t last_error = LUSH_POOL_SUCCESS;
+static __thread lush_pool_error_t last_error = LUSH_POOL_SUCCESS;
 
 // Fallback size tracking for analysis
 static size_t fallback_sizes[100];
 static int fallback_count = 0;
 
-// Malloc fallback pointer tracking for proper cleanup
-// Uses a simple dynamic array that grows as needed
-#define INITIAL_FALLBACK_CAPACITY 256
-static void **malloc_fallback_ptrs = NULL;
-static size_t malloc_fallback_count = 0;
-static size_t malloc_fallback_capacity = 0;
-
-/**
- * @brief Track a malloc fallback allocation for later cleanup
- * @param ptr Pointer to track
- * @return true on success, false on failure
- */
-static bool track_malloc_fallback(void *ptr) {
-    if (!ptr) return false;
-    
-    // Initialize array on first use
-    if (!malloc_fallback_ptrs) {
-        malloc_fallback_ptrs = malloc(INITIAL_FALLBACK_CAPACITY * sizeof(void *));
-        if (!malloc_fallback_ptrs) return false;
-        malloc_fallback_capacity = INITIAL_FALLBACK_CAPACITY;
-        malloc_fallback_count = 0;
-    }
-    
-    // Grow array if needed
-    if (malloc_fallback_count >= malloc_fallback_capacity) {
-        size_t new_capacity = malloc_fallback_capacity * 2;
-        void **new_ptrs = realloc(malloc_fallback_ptrs, new_capacity * sizeof(void *));
-        if (!new_ptrs) return false;
-        malloc_fallback_ptrs = new_ptrs;
-        malloc_fallback_capacity = new_capacity;
-    }
-    
-    malloc_fallback_ptrs[malloc_fallback_count++] = ptr;
-    return true;
-}
-
-/**
- * @brief Untrack a malloc fallback allocation (called when freed before shutdown)
- * @param ptr Pointer to untrack
- * @return true if found and removed, false if not found
- */
-static bool untrack_malloc_fallback(void *ptr) {
-    if (!ptr || !malloc_fallback_ptrs) return false;
-    
-    for (size_t i = 0; i < malloc_fallback_count; i++) {
-        if (malloc_fallback_ptrs[i] == ptr) {
-            // Move last element to this position (order doesn't matter)
-            malloc_fallback_ptrs[i] = malloc_fallback_ptrs[--malloc_fallback_count];
-            return true;
-        }
-    }
-    return false;
-}
-
-/**
- * @brief Free all tracked malloc fallback allocations during shutdown
- */
-static void free_all_malloc_fallbacks(void) {
-    if (!malloc_fallback_ptrs) return;
-    
-    for (size_t i = 0; i < malloc_fallback_count; i++) {
-        if (malloc_fallback_ptrs[i]) {
-            free(malloc_fallback_ptrs[i]);
-        }
-    }
-    
-    free(malloc_fallback_ptrs);
-    malloc_fallback_ptrs = NULL;
-    malloc_fallback_count = 0;
-    malloc_fallback_capacity = 0;
-}
-
-// Track whether pool was ever initialized (vs never used)
-// This distinguishes "pool shutdown" from "pool never started"
-static bool pool_was_ever_initialized = false;
+// Statistics counters, updated without taking a lock
+static struct {
+    _Atomic uint64_t total_allocations;
+    _Atomic uint64_t pool_hits;
+    _Atomic uint64_t pool_misses;
+    _Atomic uint64_t current_pool_usage;
+    _Atomic uint64_t peak_pool_usage;
+    _Atomic uint64_t total_bytes_allocated;
+    _Atomic uint64_t timed_allocations;
+    _Atomic uint64_t timed_allocation_ns;
+    _Atomic uint32_t active_allocations;
+} pool_stats;
 
 // Pool size definitions (optimized for display operations)
 static const size_t POOL_SIZES[LUSH_POOL_COUNT] = {
@@ -130,6 +73,18 @@ static const size_t DEFAULT_BLOCK_COUNTS[LUSH_POOL_COUNT] = {
     16   // XLARGE: Infrequent but critical (doubled from 8)
 };
 
+// Slabs reserve room to grow to this multiple of the initial block count
+#define POOL_GROWTH_FACTOR 4
+
+// Slabs start on page boundaries within the reservation
+#define POOL_SLAB_ALIGN 4096
+
+// Upper bound on blocks moved between a thread cache and its class at once
+#define POOL_CACHE_BATCH_MAX 16
+
+// One allocation in this many is timed for the average allocation time
+#define POOL_TIMING_SAMPLE 64
+
 // Performance monitoring macros
 #define POOL_DEBUG(fmt, ...)                                                   \
     do {                                                                       \
@@ -144,13 +99,175 @@ static const size_t DEFAULT_BLOCK_COUNTS[LUSH_POOL_COUNT] = {
     } while (0)
 
 /**
- * @brief Get current timestamp in microseconds
- * @return Current timestamp in microseconds since epoch
+ * Thread Caches
+ *
+ * A free block is linked through its first word. Each thread keeps one list
+ * per size class; allocation pops from it and free pushes onto it, so the
+ * common path takes no lock. An empty list refills a batch from the class
+ * (shared free list first, then fresh blocks carved from the slab), and a
+ * list holding more than two batches flushes one batch back.
+ */
+
+typedef struct pool_free_block {
+    struct pool_free_block *next;
+} pool_free_block_t;
+
+typedef struct {
+    pool_free_block_t *head;
+    size_t count;
+} pool_cache_list_t;
+
+typedef struct {
+    uint64_t generation;
+    pool_cache_list_t lists[LUSH_POOL_COUNT];
+    uint32_t timing_tick;
+    bool registered;
+} pool_thread_cache_t;
+
+static __thread pool_thread_cache_t thread_cache;
+static pthread_key_t thread_cache_key;
+static pthread_once_t pool_hooks_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Malloc Fallback Tracking
+ *
+ * Fallback allocations are recorded in an open-addressing table keyed by
+ * address, holding the requested size for realloc. Lookups and removals are
+ * O(1); linear probing with backward-shift deletion keeps probe runs short
+ * without tombstones. Guarded by pool_mutex.
+ */
+
+#define INITIAL_FALLBACK_CAPACITY 256
+
+typedef struct {
+    void *ptr;
+    size_t size;
+} fallback_slot_t;
+
+static fallback_slot_t *malloc_fallback_slots = NULL;
+static size_t malloc_fallback_count = 0;
+static size_t malloc_fallback_capacity = 0;
+
+/**
+ * @brief Home slot of a pointer in the fallback table
+ * @param ptr Pointer to hash
+ * @return Slot index (capacity must be a power of two)
+ */
+static size_t fallback_slot_index(const void *ptr) {
+    uint64_t key = (uint64_t)(uintptr_t)ptr >> 4;
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) &
+           (malloc_fallback_capacity - 1);
+}
+
+/**
+ * @brief Insert into the fallback table without growing it
+ * @param ptr Pointer to record
+ * @param size Requested size of the allocation
+ */
+static void fallback_insert(void *ptr, size_t size) {
+    size_t i = fallback_slot_index(ptr);
+    while (malloc_fallback_slots[i].ptr) {
+        i = (i + 1) & (malloc_fallback_capacity - 1);
+    }
+    malloc_fallback_slots[i].ptr = ptr;
+    malloc_fallback_slots[i].size = size;
+    malloc_fallback_count++;
+}
+
+/**
+ * @brief Track a malloc fallback allocation for later cleanup
+ * @param ptr Pointer to track
+ * @param size Requested size of the allocation
+ * @return true on success, false on failure
+ */
+static bool track_malloc_fallback(void *ptr, size_t size) {
+    if (!ptr) return false;
+
+    // Keep the table at most half full
+    if ((malloc_fallback_count + 1) * 2 > malloc_fallback_capacity) {
+        size_t new_capacity = malloc_fallback_capacity
+                                  ? malloc_fallback_capacity * 2
+                                  : INITIAL_FALLBACK_CAPACITY;
+        fallback_slot_t *new_slots = calloc(new_capacity, sizeof(*new_slots));
+        if (!new_slots) return false;
+
+        fallback_slot_t *old_slots = malloc_fallback_slots;
+        size_t old_capacity = malloc_fallback_capacity;
+        malloc_fallback_slots = new_slots;
+        malloc_fallback_capacity = new_capacity;
+        malloc_fallback_count = 0;
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old_slots[i].ptr) {
+                fallback_insert(old_slots[i].ptr, old_slots[i].size);
+            }
+        }
+        free(old_slots);
+    }
+
+    fallback_insert(ptr, size);
+    return true;
+}
+
+/**
+ * @brief Find the slot holding a malloc fallback allocation
+ * @param ptr Pointer to look up
+ * @return Slot index, or SIZE_MAX if the pointer is not tracked
+ */
+static size_t find_malloc_fallback(const void *ptr) {
+    if (!ptr || !malloc_fallback_slots) return SIZE_MAX;
+
+    size_t i = fallback_slot_index(ptr);
+    while (malloc_fallback_slots[i].ptr != ptr) {
+        if (!malloc_fallback_slots[i].ptr) return SIZE_MAX;
+        i = (i + 1) & (malloc_fallback_capacity - 1);
+    }
+    return i;
+}
+
+/**
+ * @brief Untrack a malloc fallback allocation (called when freed before shutdown)
+ * @param ptr Pointer to untrack
+ * @param size Receives the tracked size when found (may be NULL)
+ * @return true if found and removed, false if not found
+ */
+static bool untrack_malloc_fallback(void *ptr, size_t *size) {
+    size_t i = find_malloc_fallback(ptr);
+    if (i == SIZE_MAX) return false;
+    if (size) *size = malloc_fallback_slots[i].size;
+
+    // Shift later members of the probe run back into the hole
+    size_t mask = malloc_fallback_capacity - 1;
+    size_t hole = i;
+    for (size_t j = (i + 1) & mask; malloc_fallback_slots[j].ptr;
+         j = (j + 1) & mask) {
+        size_t home = fallback_slot_index(malloc_fallback_slots[j].ptr);
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            malloc_fallback_slots[hole] = malloc_fallback_slots[j];
+            hole = j;
+        }
+    }
+    malloc_fallback_slots[hole].ptr = NULL;
+    malloc_fallback_slots[hole].size = 0;
+    malloc_fallback_count--;
+    return true;
+}
+
+/**
+ * @brief Free all tracked malloc fallback allocations during shutdown
  */
-static uint64_t get_timestamp_us(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000 + (uint64_t)tv.tv_usec;
+static void free_all_malloc_fallbacks(void) {
+    if (!malloc_fallback_slots) return;
+
+    for (size_t i = 0; i < malloc_fallback_capacity; i++) {
+        if (malloc_fallback_slots[i].ptr) {
+            free(malloc_fallback_slots[i].ptr);
+        }
+    }
+
+    free(malloc_fallback_slots);
+    malloc_fallback_slots = NULL;
+    malloc_fallback_count = 0;
+    malloc_fallback_capacity = 0;
 }
 
 /**
@@ -174,16 +291,32 @@ static void set_last_error(lush_pool_error_t error) {
     }
 }
 
+/**
+ * @brief Blocks to move between a thread cache and a class at once
+ * @param max_blocks Blocks reserved in the class slab
+ * @return Batch size; small classes use smaller batches so that one thread
+ *         cannot strand most of a class in its cache
+ */
+static size_t cache_batch_for(size_t max_blocks) {
+    size_t batch = max_blocks / 16;
+    if (batch > POOL_CACHE_BATCH_MAX) {
+        batch = POOL_CACHE_BATCH_MAX;
+    }
+    return batch ? batch : 1;
+}
+
 /**
  * @brief Initialize a single memory pool
  * @param pool Pointer to the pool structure to initialize
  * @param block_size Size of each block in the pool
- * @param initial_blocks Number of blocks to pre-allocate
+ * @param initial_blocks Initial number of blocks requested
+ * @param slab Start of the address range reserved for this pool
  * @return LUSH_POOL_SUCCESS on success, error code on failure
  */
 static lush_pool_error_t init_single_pool(lush_pool_t *pool,
                                             size_t block_size,
-                                            size_t initial_blocks) {
+                                            size_t initial_blocks,
+                                            char *slab) {
     if (!pool || block_size == 0 || initial_blocks == 0) {
         return LUSH_POOL_ERROR_INVALID_SIZE;
     }
@@ -192,54 +325,25 @@ static lush_pool_error_t init_single_pool(lush_pool_t *pool,
     memset(pool, 0, sizeof(lush_pool_t));
     pool->block_size = block_size;
     pool->initial_blocks = initial_blocks;
-    pool->max_blocks = initial_blocks * 4; // Allow growth up to 4x initial
-
-    // Allocate block management array
-    pool->all_blocks = calloc(pool->max_blocks, sizeof(lush_pool_block_t));
-    if (!pool->all_blocks) {
-        POOL_ERROR(
-            "Failed to allocate block management array for pool (size=%zu)",
-            block_size);
-        return LUSH_POOL_ERROR_MALLOC_FAILED;
+    pool->max_blocks = initial_blocks * POOL_GROWTH_FACTOR;
+    pool->slab_start = slab;
+    pool->slab_end = slab + pool->max_blocks * block_size;
+    while (((size_t)1 << pool->block_shift) < block_size) {
+        pool->block_shift++;
     }
+    pool->cache_batch = cache_batch_for(pool->max_blocks);
 
-    // Pre-allocate initial blocks
-    for (size_t i = 0; i < initial_blocks; i++) {
-        lush_pool_block_t *block = &pool->all_blocks[i];
-
-        // Allocate memory for this block
-        block->memory = malloc(block_size);
-        if (!block->memory) {
-            POOL_ERROR("Failed to allocate memory block %zu (size=%zu)", i,
-                       block_size);
-            // Cleanup previously allocated blocks
-            for (size_t j = 0; j < i; j++) {
-                free(pool->all_blocks[j].memory);
-            }
-            free(pool->all_blocks);
-            return LUSH_POOL_ERROR_MALLOC_FAILED;
-        }
-
-        // Initialize block metadata
-        block->size = block_size;
-        block->in_use = false;
-        block->allocation_time_us = 0;
-        block->allocation_id = 0;
-
-        // Add to free list
-        block->next = pool->free_list;
-        block->prev = NULL;
-        if (pool->free_list) {
-            pool->free_list->prev = block;
-        }
-        pool->free_list = block;
+    // One in-use flag per block; blocks themselves are carved on demand
+    pool->block_state = calloc(pool->max_blocks, sizeof(*pool->block_state));
+    if (!pool->block_state) {
+        POOL_ERROR("Failed to allocate block state array for pool (size=%zu)",
+                   block_size);
+        return LUSH_POOL_ERROR_MALLOC_FAILED;
     }
+    pthread_mutex_init(&pool->lock, NULL);
 
-    pool->current_blocks = initial_blocks;
-    pool->free_blocks = initial_blocks;
-
-    POOL_DEBUG("Initialized pool: block_size=%zu, initial_blocks=%zu",
-               block_size, initial_blocks);
+    POOL_DEBUG("Initialized pool: block_size=%zu, max_blocks=%zu", block_size,
+               pool->max_blocks);
     return LUSH_POOL_SUCCESS;
 }
 
@@ -248,19 +352,13 @@ static lush_pool_error_t init_single_pool(lush_pool_t *pool,
  * @param pool Pointer to the pool structure to cleanup
  */
 static void cleanup_single_pool(lush_pool_t *pool) {
-    if (!pool || !pool->all_blocks) {
+    if (!pool || !pool->block_state) {
         return;
     }
 
-    // Free all allocated memory blocks
-    for (size_t i = 0; i < pool->current_blocks; i++) {
-        if (pool->all_blocks[i].memory) {
-            free(pool->all_blocks[i].memory);
-        }
-    }
-
-    // Free block management array
-    free(pool->all_blocks);
+    // Blocks live in the shared reservation, released by the caller
+    pthread_mutex_destroy(&pool->lock);
+    free((void *)pool->block_state);
 
     // Clear pool structure
     memset(pool, 0, sizeof(lush_pool_t));
@@ -284,126 +382,329 @@ static lush_pool_size_t find_pool_for_size(size_t size) {
 }
 
 /**
- * @brief Allocate a block from specific pool
- * @param pool Pointer to the pool to allocate from
- * @return Pointer to allocated memory, or NULL if pool is exhausted
+ * @brief Find the pool whose slab contains a pointer
+ * @param system Live pool system
+ * @param ptr Pointer to look up
+ * @return Owning pool, or NULL if the pointer is outside every slab
  */
-static void *allocate_from_pool(lush_pool_t *pool) {
-    if (!pool || !pool->free_list) {
+static lush_pool_t *find_owning_pool(lush_memory_pool_system_t *system,
+                                       const void *ptr) {
+    uintptr_t addr = (uintptr_t)ptr;
+    uintptr_t arena = (uintptr_t)system->arena;
+    if (addr < arena || addr - arena >= system->arena_size) {
         return NULL;
     }
 
-    // Take first block from free list
-    lush_pool_block_t *block = pool->free_list;
+    // Slabs are laid out in class order
+    for (int i = LUSH_POOL_COUNT - 1; i >= 0; i--) {
+        lush_pool_t *pool = &system->pools[i];
+        if (addr >= (uintptr_t)pool->slab_start) {
+            return addr < (uintptr_t)pool->slab_end ? pool : NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Index of a block within its pool
+ * @param pool Owning pool
+ * @param ptr Pointer inside the pool slab
+ * @param index Receives the block index
+ * @return true if ptr is the start of a block, false for interior pointers
+ */
+static bool block_index(const lush_pool_t *pool, const void *ptr,
+                        size_t *index) {
+    uintptr_t offset = (uintptr_t)ptr - (uintptr_t)pool->slab_start;
+    if (offset & (pool->block_size - 1)) {
+        return false;
+    }
+    *index = offset >> pool->block_shift;
+    return true;
+}
 
-    // Remove from free list
-    pool->free_list = block->next;
-    if (pool->free_list) {
-        pool->free_list->prev = NULL;
+/**
+ * @brief Get the calling thread's cache for the live pool generation
+ * @param generation Current (odd) pool generation
+ * @return The thread cache, emptied first if it belongs to an older pool
+ */
+static pool_thread_cache_t *get_thread_cache(uint64_t generation) {
+    pool_thread_cache_t *cache = &thread_cache;
+    if (cache->generation != generation) {
+        // Blocks from an older pool went away with its slabs
+        memset(cache->lists, 0, sizeof(cache->lists));
+        cache->generation = generation;
+        if (!cache->registered) {
+            // Non-NULL value so the key destructor runs at thread exit
+            pthread_setspecific(thread_cache_key, cache);
+            cache->registered = true;
+        }
     }
+    return cache;
+}
+
+/**
+ * @brief Move blocks from a pool to a thread cache list
+ * @param pool Pool to take blocks from
+ * @param list Thread cache list to fill
+ * @return true if at least one block was moved, false if the pool is exhausted
+ */
+static bool refill_thread_cache(lush_pool_t *pool, pool_cache_list_t *list) {
+    size_t moved = 0;
+
+    pthread_mutex_lock(&pool->lock);
 
-    // Mark as in use
-    block->in_use = true;
-    block->allocation_time_us = get_timestamp_us();
-    block->allocation_id = ++global_memory_pool->next_allocation_id;
+    while (moved < pool->cache_batch && pool->free_list) {
+        pool_free_block_t *block = pool->free_list;
+        pool->free_list = block->next;
+        block->next = list->head;
+        list->head = block;
+        moved++;
+    }
+    pool->free_blocks -= moved;
+
+    // Carve fresh blocks, pushed in reverse so the lowest comes out first
+    size_t carve = pool->cache_batch - moved;
+    if (carve > pool->max_blocks - pool->current_blocks) {
+        carve = pool->max_blocks - pool->current_blocks;
+    }
+    for (size_t i = carve; i > 0; i--) {
+        pool_free_block_t *block =
+            (pool_free_block_t *)(pool->slab_start +
+                                  ((pool->current_blocks + i - 1)
+                                   << pool->block_shift));
+        block->next = list->head;
+        list->head = block;
+    }
+    pool->current_blocks += carve;
+    moved += carve;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    list->count += moved;
+    if (moved == 0) {
+        POOL_DEBUG("Pool exhausted: block_size=%zu", pool->block_size);
+    }
+    return moved > 0;
+}
+
+/**
+ * @brief Return blocks from the head of a thread cache list to its pool
+ * @param pool Pool the blocks belong to
+ * @param list Thread cache list to drain
+ * @param count Number of blocks to move (at most list->count)
+ */
+static void flush_thread_cache(lush_pool_t *pool, pool_cache_list_t *list,
+                               size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    pool_free_block_t *first = list->head;
+    pool_free_block_t *last = first;
+    for (size_t i = 1; i < count; i++) {
+        last = last->next;
+    }
+    list->head = last->next;
+    list->count -= count;
+
+    pthread_mutex_lock(&pool->lock);
+    last->next = pool->free_list;
+    pool->free_list = first;
+    pool->free_blocks += count;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Return an exiting thread's cached blocks to their pools
+ * @param arg The thread's cache (registered with thread_cache_key)
+ */
+static void release_thread_cache(void *arg) {
+    pool_thread_cache_t *cache = arg;
+    uint64_t generation =
+        atomic_load_explicit(&pool_generation, memory_order_acquire);
+
+    if (cache->generation == generation && (generation & 1)) {
+        for (int i = 0; i < LUSH_POOL_COUNT; i++) {
+            flush_thread_cache(&global_memory_pool->pools[i],
+                               &cache->lists[i], cache->lists[i].count);
+        }
+    }
+    memset(cache, 0, sizeof(*cache));
+}
+
+/**
+ * @brief Hold every pool lock across fork() so the child starts unlocked
+ */
+static void pool_prepare_fork(void) {
+    pthread_mutex_lock(&pool_mutex);
+    if (global_memory_pool) {
+        for (int i = 0; i < LUSH_POOL_COUNT; i++) {
+            pthread_mutex_lock(&global_memory_pool->pools[i].lock);
+        }
+    }
+}
+
+/**
+ * @brief Release the locks taken by pool_prepare_fork()
+ */
+static void pool_finish_fork(void) {
+    if (global_memory_pool) {
+        for (int i = LUSH_POOL_COUNT - 1; i >= 0; i--) {
+            pthread_mutex_unlock(&global_memory_pool->pools[i].lock);
+        }
+    }
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+/**
+ * @brief Register the thread exit and fork hooks (once per process)
+ */
+static void register_pool_hooks(void) {
+    pthread_key_create(&thread_cache_key, release_thread_cache);
+    pthread_atfork(pool_prepare_fork, pool_finish_fork, pool_finish_fork);
+}
+
+/**
+ * @brief Allocate a block from specific pool
+ * @param pool Pointer to the pool to allocate from
+ * @param list The calling thread's cache list for this pool
+ * @return Pointer to allocated memory, or NULL if pool is exhausted
+ */
+static void *allocate_from_pool(lush_pool_t *pool, pool_cache_list_t *list) {
+    if (!list->head && !refill_thread_cache(pool, list)) {
+        return NULL;
+    }
 
-    // Update pool statistics
-    pool->free_blocks--;
-    pool->pool_allocations++;
+    // Take first block from the thread cache
+    pool_free_block_t *block = list->head;
+    list->head = block->next;
+    list->count--;
 
-    POOL_DEBUG("Allocated block: size=%zu, id=%u, ptr=%p", block->size,
-               block->allocation_id, block->memory);
+    size_t index;
+    block_index(pool, block, &index);
+    atomic_store_explicit(&pool->block_state[index], 1, memory_order_relaxed);
 
-    return block->memory;
+    if (global_memory_pool->enable_statistics) {
+        atomic_fetch_add_explicit(&pool->pool_allocations, 1,
+                                  memory_order_relaxed);
+    }
+    return block;
 }
 
 /**
  * @brief Return a block to specific pool
- * @param pool Pointer to the pool to return the block to
+ * @param pool Pointer to the pool that owns the block
+ * @param list The calling thread's cache list for this pool
  * @param ptr Pointer to the memory block to return
  * @return true if block was successfully returned, false otherwise
  */
-static bool return_to_pool(lush_pool_t *pool, void *ptr) {
-    if (!pool || !ptr) {
+static bool return_to_pool(lush_pool_t *pool, pool_cache_list_t *list,
+                           void *ptr) {
+    size_t index;
+    if (!block_index(pool, ptr, &index)) {
+        set_last_error(LUSH_POOL_ERROR_INVALID_POINTER);
         return false;
     }
 
-    // Find the block that contains this pointer
-    lush_pool_block_t *block = NULL;
-    for (size_t i = 0; i < pool->current_blocks; i++) {
-        if (pool->all_blocks[i].memory == ptr) {
-            block = &pool->all_blocks[i];
-            break;
-        }
+    // Mark as free; a block that was not in use is a double free (or was
+    // never carved, which no caller could have been handed)
+    if (atomic_exchange_explicit(&pool->block_state[index], 0,
+                                 memory_order_relaxed) != 1) {
+        set_last_error(LUSH_POOL_ERROR_DOUBLE_FREE);
+        return false;
     }
 
-    if (!block || !block->in_use) {
-        return false; // Not found or double free
+    pool_free_block_t *block = ptr;
+    block->next = list->head;
+    list->head = block;
+    list->count++;
+
+    // Keep at most two batches cached per class
+    if (list->count > 2 * pool->cache_batch) {
+        flush_thread_cache(pool, list, pool->cache_batch);
     }
 
-    // Mark as free
-    block->in_use = false;
-    block->allocation_time_us = 0;
-    block->allocation_id = 0;
+    if (global_memory_pool->enable_statistics) {
+        atomic_fetch_add_explicit(&pool->pool_deallocations, 1,
+                                  memory_order_relaxed);
+    }
+    return true;
+}
 
-    // Add back to free list
-    block->next = pool->free_list;
-    block->prev = NULL;
-    if (pool->free_list) {
-        pool->free_list->prev = block;
+/**
+ * @brief Allocate with malloc and track the result for shutdown and realloc
+ * @param size Size of memory to allocate in bytes
+ * @return Pointer to allocated memory, or NULL on failure
+ */
+static void *allocate_fallback(size_t size) {
+    void *result = malloc(size);
+
+    pthread_mutex_lock(&pool_mutex);
+
+    // Track fallback sizes for optimization analysis
+    if (fallback_count < 100) {
+        fallback_sizes[fallback_count++] = size;
     }
-    pool->free_list = block;
 
-    // Update statistics
-    pool->free_blocks++;
-    pool->pool_deallocations++;
+    // Track pointer for cleanup during shutdown
+    if (result) {
+        track_malloc_fallback(result, size);
+    }
 
-    POOL_DEBUG("Returned block to pool: size=%zu, ptr=%p", block->size, ptr);
-    return true;
+    pthread_mutex_unlock(&pool_mutex);
+
+    POOL_DEBUG("Malloc fallback: size=%zu (total fallbacks: %d)", size,
+               fallback_count);
+    return result;
 }
 
 /**
  * @brief Update global statistics after an allocation
  * @param pool_hit Whether the allocation came from a pool (true) or malloc (false)
  * @param size Size of the allocation in bytes
- * @param allocation_time_ns Time taken for the allocation in nanoseconds
+ * @param pool_bytes Bytes taken from a pool (the block size on a hit)
  */
-static void update_stats(bool pool_hit, size_t size,
-                         uint64_t allocation_time_ns) {
-    if (!global_memory_pool->enable_statistics) {
-        return;
-    }
-
-    lush_pool_stats_t *stats = &global_memory_pool->stats;
-
-    stats->total_allocations++;
-    stats->total_bytes_allocated += size;
-    stats->active_allocations++;
+static void update_stats(bool pool_hit, size_t size, size_t pool_bytes) {
+    atomic_fetch_add_explicit(&pool_stats.total_allocations, 1,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool_stats.total_bytes_allocated, size,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool_stats.active_allocations, 1,
+                              memory_order_relaxed);
 
     if (pool_hit) {
-        stats->pool_hits++;
-        stats->current_pool_usage += size;
-        if (stats->current_pool_usage > stats->peak_pool_usage) {
-            stats->peak_pool_usage = stats->current_pool_usage;
+        atomic_fetch_add_explicit(&pool_stats.pool_hits, 1,
+                                  memory_order_relaxed);
+        uint64_t usage = atomic_fetch_add_explicit(
+                             &pool_stats.current_pool_usage, pool_bytes,
+                             memory_order_relaxed) +
+                         pool_bytes;
+        uint64_t peak = atomic_load_explicit(&pool_stats.peak_pool_usage,
+                                             memory_order_relaxed);
+        while (usage > peak &&
+               !atomic_compare_exchange_weak_explicit(
+                   &pool_stats.peak_pool_usage, &peak, usage,
+                   memory_order_relaxed, memory_order_relaxed)) {
         }
     } else {
-        stats->pool_misses++;
-        stats->malloc_fallbacks++;
+        atomic_fetch_add_explicit(&pool_stats.pool_misses, 1,
+                                  memory_order_relaxed);
     }
+}
 
-    // Update hit rate
-    stats->pool_hit_rate =
-        (double)stats->pool_hits / stats->total_allocations * 100.0;
-
-    // Update average allocation time
-    if (stats->total_allocations == 1) {
-        stats->avg_allocation_time_ns = allocation_time_ns;
-    } else {
-        stats->avg_allocation_time_ns =
-            (stats->avg_allocation_time_ns * (stats->total_allocations - 1) +
-             allocation_time_ns) /
-            stats->total_allocations;
-    }
+/**
+ * @brief Zero the statistics counters
+ */
+static void clear_stats(void) {
+    atomic_store(&pool_stats.total_allocations, 0);
+    atomic_store(&pool_stats.pool_hits, 0);
+    atomic_store(&pool_stats.pool_misses, 0);
+    atomic_store(&pool_stats.current_pool_usage, 0);
+    atomic_store(&pool_stats.peak_pool_usage, 0);
+    atomic_store(&pool_stats.total_bytes_allocated, 0);
+    atomic_store(&pool_stats.timed_allocations, 0);
+    atomic_store(&pool_stats.timed_allocation_ns, 0);
+    atomic_store(&pool_stats.active_allocations, 0);
 }
 
 /**
@@ -416,6 +717,8 @@ static void update_stats(bool pool_hit, size_t size,
  * @return LUSH_POOL_SUCCESS on success, error code on failure
  */
 lush_pool_error_t lush_pool_init(const lush_pool_config_t *config) {
+    pthread_once(&pool_hooks_once, register_pool_hooks);
+
     pthread_mutex_lock(&pool_mutex);
 
     // Check if already initialized
@@ -425,53 +728,87 @@ lush_pool_error_t lush_pool_init(const lush_pool_config_t *config) {
         return LUSH_POOL_SUCCESS; // Allow multiple inits
     }
 
+    // Use provided config or defaults
+    lush_pool_config_t default_config = lush_pool_get_default_config();
+    if (!config) {
+        config = &default_config;
+    }
+
+    size_t block_counts[LUSH_POOL_COUNT] = {
+        config->small_pool_blocks, config->medium_pool_blocks,
+        config->large_pool_blocks, config->xlarge_pool_blocks};
+
+    // Lay the slabs out back to back in one reservation
+    size_t slab_offsets[LUSH_POOL_COUNT];
+    size_t arena_size = 0;
+    for (int i = 0; i < LUSH_POOL_COUNT; i++) {
+        if (block_counts[i] == 0 ||
+            block_counts[i] > SIZE_MAX / POOL_GROWTH_FACTOR / POOL_SIZES[i]) {
+            pthread_mutex_unlock(&pool_mutex);
+            set_last_error(LUSH_POOL_ERROR_INVALID_SIZE);
+            return LUSH_POOL_ERROR_INVALID_SIZE;
+        }
+        size_t slab_size =
+            block_counts[i] * POOL_GROWTH_FACTOR * POOL_SIZES[i];
+        slab_offsets[i] = arena_size;
+        arena_size += (slab_size + POOL_SLAB_ALIGN - 1) &
+                      ~(size_t)(POOL_SLAB_ALIGN - 1);
+    }
+
     // Allocate global pool system
-    global_memory_pool = calloc(1, sizeof(lush_memory_pool_system_t));
-    if (!global_memory_pool) {
+    lush_memory_pool_system_t *system =
+        calloc(1, sizeof(lush_memory_pool_system_t));
+    if (!system) {
         pthread_mutex_unlock(&pool_mutex);
         set_last_error(LUSH_POOL_ERROR_MALLOC_FAILED);
         return LUSH_POOL_ERROR_MALLOC_FAILED;
     }
 
-    // Use provided config or defaults
-    lush_pool_config_t default_config = lush_pool_get_default_config();
-    if (!config) {
-        config = &default_config;
+    // Pages are committed as blocks are first carved and touched
+    void *arena = mmap(NULL, arena_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (arena == MAP_FAILED) {
+        POOL_ERROR("Failed to reserve %zu bytes for pool slabs", arena_size);
+        free(system);
+        pthread_mutex_unlock(&pool_mutex);
+        set_last_error(LUSH_POOL_ERROR_MALLOC_FAILED);
+        return LUSH_POOL_ERROR_MALLOC_FAILED;
     }
+    system->arena = arena;
+    system->arena_size = arena_size;
 
     // Set system configuration
-    global_memory_pool->enable_statistics = config->enable_statistics;
-    global_memory_pool->enable_malloc_fallback = config->enable_malloc_fallback;
+    system->enable_statistics = config->enable_statistics;
+    system->enable_malloc_fallback = config->enable_malloc_fallback;
     debug_mode = config->enable_debugging;
 
     // Initialize timestamp
-    clock_gettime(CLOCK_MONOTONIC, &global_memory_pool->init_time);
+    clock_gettime(CLOCK_MONOTONIC, &system->init_time);
 
     // Initialize individual pools
-    size_t block_counts[LUSH_POOL_COUNT] = {
-        config->small_pool_blocks, config->medium_pool_blocks,
-        config->large_pool_blocks, config->xlarge_pool_blocks};
-
     for (int i = 0; i < LUSH_POOL_COUNT; i++) {
-        lush_pool_error_t result = init_single_pool(
-            &global_memory_pool->pools[i], POOL_SIZES[i], block_counts[i]);
+        lush_pool_error_t result =
+            init_single_pool(&system->pools[i], POOL_SIZES[i],
+                             block_counts[i], system->arena + slab_offsets[i]);
 
         if (result != LUSH_POOL_SUCCESS) {
             POOL_ERROR("Failed to initialize pool %d", i);
             // Cleanup already initialized pools
             for (int j = 0; j < i; j++) {
-                cleanup_single_pool(&global_memory_pool->pools[j]);
+                cleanup_single_pool(&system->pools[j]);
             }
-            free(global_memory_pool);
-            global_memory_pool = NULL;
+            munmap(system->arena, system->arena_size);
+            free(system);
             pthread_mutex_unlock(&pool_mutex);
             set_last_error(result);
             return result;
         }
     }
 
-    global_memory_pool->initialized = true;
-    pool_was_ever_initialized = true;
+    clear_stats();
+    system->initialized = true;
+    global_memory_pool = system;
+    atomic_fetch_add_explicit(&pool_generation, 1, memory_order_release);
 
     pthread_mutex_unlock(&pool_mutex);
 
@@ -502,6 +839,10 @@ void lush_pool_shutdown(void) {
         lush_pool_print_status_report();
     }
 
+    // Later frees of pool memory become no-ops; thread caches go stale
+    atomic_fetch_add_explicit(&pool_generation, 1, memory_order_release);
+    memset(thread_cache.lists, 0, sizeof(thread_cache.lists));
+
     // Free all tracked malloc fallback allocations first
     free_all_malloc_fallbacks();
 
@@ -509,6 +850,7 @@ void lush_pool_shutdown(void) {
     for (int i = 0; i < LUSH_POOL_COUNT; i++) {
         cleanup_single_pool(&global_memory_pool->pools[i]);
     }
+    munmap(global_memory_pool->arena, global_memory_pool->arena_size);
 
     // Free global pool system
     free(global_memory_pool);
@@ -530,61 +872,50 @@ void *lush_pool_alloc(size_t size) {
         return NULL;
     }
 
-    uint64_t start_time = get_timestamp_ns();
-    void *result = NULL;
-    bool pool_hit = false;
-
-    pthread_mutex_lock(&pool_mutex);
-
-    if (!global_memory_pool || !global_memory_pool->initialized) {
+    uint64_t generation =
+        atomic_load_explicit(&pool_generation, memory_order_acquire);
+    if (!(generation & 1)) {
         // Fallback to malloc if pool not initialized
-        pthread_mutex_unlock(&pool_mutex);
-        result = malloc(size);
-        if (result && global_memory_pool) {
-            update_stats(false, size, get_timestamp_ns() - start_time);
-        }
+        void *result = malloc(size);
         set_last_error(result ? LUSH_POOL_SUCCESS
                               : LUSH_POOL_ERROR_MALLOC_FAILED);
         return result;
     }
 
+    lush_memory_pool_system_t *system = global_memory_pool;
+    pool_thread_cache_t *cache = get_thread_cache(generation);
+    bool timed = system->enable_statistics &&
+                 ++cache->timing_tick % POOL_TIMING_SAMPLE == 0;
+    uint64_t start_time = timed ? get_timestamp_ns() : 0;
+    void *result = NULL;
+
     // Find appropriate pool
     lush_pool_size_t pool_type = find_pool_for_size(size);
 
     if (pool_type < LUSH_POOL_COUNT) {
         // Try to allocate from pool
-        result = allocate_from_pool(&global_memory_pool->pools[pool_type]);
-        if (result) {
-            pool_hit = true;
-            POOL_DEBUG("Pool allocation: size=%zu, pool=%d", size, pool_type);
-        }
+        result = allocate_from_pool(&system->pools[pool_type],
+                                    &cache->lists[pool_type]);
     }
+    bool pool_hit = result != NULL;
 
     // Fallback to malloc if pool allocation failed or size too large
-    if (!result && global_memory_pool->enable_malloc_fallback) {
-        result = malloc(size);
-
-        // Track fallback sizes for optimization analysis
-        if (fallback_count < 100) {
-            fallback_sizes[fallback_count++] = size;
-        }
-        
-        // Track pointer for cleanup during shutdown
-        if (result) {
-            track_malloc_fallback(result);
-        }
-
-        POOL_DEBUG("Malloc fallback: size=%zu (total fallbacks: %d)", size,
-                   fallback_count);
+    if (!result && system->enable_malloc_fallback) {
+        result = allocate_fallback(size);
     }
 
     // Update statistics
-    if (result) {
-        update_stats(pool_hit, size, get_timestamp_ns() - start_time);
+    if (result && system->enable_statistics) {
+        update_stats(pool_hit, size, pool_hit ? POOL_SIZES[pool_type] : 0);
+        if (timed) {
+            atomic_fetch_add_explicit(&pool_stats.timed_allocations, 1,
+                                      memory_order_relaxed);
+            atomic_fetch_add_explicit(&pool_stats.timed_allocation_ns,
+                                      get_timestamp_ns() - start_time,
+                                      memory_order_relaxed);
+        }
     }
 
-    pthread_mutex_unlock(&pool_mutex);
-
     set_last_error(result ? LUSH_POOL_SUCCESS
                           : LUSH_POOL_ERROR_MALLOC_FAILED);
     return result;
@@ -599,72 +930,60 @@ void lush_pool_free(void *ptr) {
         return;
     }
 
-    pthread_mutex_lock(&pool_mutex);
-
-    // Handle case where pool is NULL
-    if (!global_memory_pool) {
-        pthread_mutex_unlock(&pool_mutex);
-        if (pool_was_ever_initialized) {
-            // Pool was shut down - memory was already freed during shutdown.
-            // Do NOT call free() here as it would cause double-free.
-            return;
-        } else {
+    uint64_t generation =
+        atomic_load_explicit(&pool_generation, memory_order_acquire);
+    if (!(generation & 1)) {
+        if (generation == 0) {
             // Pool was never initialized - this memory came from malloc
             // fallback. We must free it to avoid leaking.
             free(ptr);
-            return;
         }
+        // Otherwise the pool was shut down and the memory already released.
+        // Do NOT call free() here as it would cause double-free.
+        return;
     }
 
-    bool returned_to_pool = false;
+    lush_memory_pool_system_t *system = global_memory_pool;
+    lush_pool_t *pool = find_owning_pool(system, ptr);
 
-    if (global_memory_pool->initialized) {
-        // Try to return to appropriate pool
-        for (int i = 0; i < LUSH_POOL_COUNT; i++) {
-            if (return_to_pool(&global_memory_pool->pools[i], ptr)) {
-                returned_to_pool = true;
-
-                // Update statistics
-                if (global_memory_pool->enable_statistics) {
-                    global_memory_pool->stats.active_allocations--;
-                    global_memory_pool->stats.current_pool_usage -=
-                        POOL_SIZES[i];
-                }
-
-                POOL_DEBUG("Freed to pool: size=%zu, pool=%d", POOL_SIZES[i],
-                           i);
-                break;
-            }
+    if (pool) {
+        pool_cache_list_t *list =
+            &get_thread_cache(generation)->lists[pool - system->pools];
+        if (!return_to_pool(pool, list, ptr)) {
+            POOL_DEBUG("Rejected free: ptr=%p (%s)", ptr,
+                       lush_pool_error_string(last_error));
+            return;
         }
+        if (system->enable_statistics) {
+            atomic_fetch_sub_explicit(&pool_stats.active_allocations, 1,
+                                      memory_order_relaxed);
+            atomic_fetch_sub_explicit(&pool_stats.current_pool_usage,
+                                      pool->block_size, memory_order_relaxed);
+        }
+        set_last_error(LUSH_POOL_SUCCESS);
+        return;
     }
 
+    // Not pool memory: a tracked fallback, or malloc memory from before init
+    pthread_mutex_lock(&pool_mutex);
+    bool tracked = untrack_malloc_fallback(ptr, NULL);
     pthread_mutex_unlock(&pool_mutex);
 
-    // If not returned to pool, use standard free
-    if (!returned_to_pool) {
-        // Untrack from malloc fallback list before freeing
-        pthread_mutex_lock(&pool_mutex);
-        untrack_malloc_fallback(ptr);
-        pthread_mutex_unlock(&pool_mutex);
-        
-        uintptr_t ptr_addr =
-            (uintptr_t)ptr; // Save address as integer before free
-        free(ptr);
-        POOL_DEBUG("Standard free: ptr=%#" PRIxPTR, ptr_addr);
-
-        // Update statistics for malloc fallback free
-        if (global_memory_pool && global_memory_pool->enable_statistics) {
-            pthread_mutex_lock(&pool_mutex);
-            global_memory_pool->stats.active_allocations--;
-            pthread_mutex_unlock(&pool_mutex);
-        }
+    uintptr_t ptr_addr = (uintptr_t)ptr; // Save address as integer before free
+    free(ptr);
+    POOL_DEBUG("Standard free: ptr=%#" PRIxPTR, ptr_addr);
+
+    // Update statistics for malloc fallback free
+    if (tracked && system->enable_statistics) {
+        atomic_fetch_sub_explicit(&pool_stats.active_allocations, 1,
+                                  memory_order_relaxed);
     }
 
     set_last_error(LUSH_POOL_SUCCESS);
 }
 
 /**
- * @brief Reallocate memory (may use malloc for complex resizing)
+ * @brief Reallocate memory, keeping it in place when the block still fits
  * @param ptr Pointer to existing memory allocation (NULL allocates new memory)
  * @param new_size New size in bytes (0 frees the memory)
  * @return Pointer to reallocated memory, or NULL on failure
@@ -679,15 +998,63 @@ void *lush_pool_realloc(void *ptr, size_t new_size) {
         return lush_pool_alloc(new_size);
     }
 
-    // For simplicity, we use malloc/free for realloc operations
-    // This could be optimized in the future to use pools when possible
+    uint64_t generation =
+        atomic_load_explicit(&pool_generation, memory_order_acquire);
+    if (!(generation & 1)) {
+        if (generation == 0) {
+            // Pool never initialized: the memory came from malloc
+            return realloc(ptr, new_size);
+        }
+        // Pool shut down: the old block no longer exists
+        set_last_error(LUSH_POOL_ERROR_NOT_INITIALIZED);
+        return NULL;
+    }
+
+    size_t old_size;
+    lush_pool_t *pool = find_owning_pool(global_memory_pool, ptr);
+
+    if (pool) {
+        // Shrinking, or growing within the block, keeps the block
+        if (new_size <= pool->block_size) {
+            set_last_error(LUSH_POOL_SUCCESS);
+            return ptr;
+        }
+        old_size = pool->block_size;
+    } else {
+        pthread_mutex_lock(&pool_mutex);
+        size_t slot = find_malloc_fallback(ptr);
+        old_size = slot != SIZE_MAX ? malloc_fallback_slots[slot].size : 0;
+        pthread_mutex_unlock(&pool_mutex);
+
+        if (slot == SIZE_MAX) {
+            // Malloc memory from before the pool was initialized
+            return realloc(ptr, new_size);
+        }
+
+        if (find_pool_for_size(new_size) == LUSH_POOL_COUNT) {
+            // Stays too large for any pool: let malloc resize it
+            pthread_mutex_lock(&pool_mutex);
+            untrack_malloc_fallback(ptr, NULL);
+            pthread_mutex_unlock(&pool_mutex);
+
+            void *result = realloc(ptr, new_size);
+
+            pthread_mutex_lock(&pool_mutex);
+            if (result) {
+                track_malloc_fallback(result, new_size);
+            } else {
+                track_malloc_fallback(ptr, old_size);
+            }
+            pthread_mutex_unlock(&pool_mutex);
+            set_last_error(result ? LUSH_POOL_SUCCESS
+                                  : LUSH_POOL_ERROR_MALLOC_FAILED);
+            return result;
+        }
+    }
+
     void *new_ptr = lush_pool_alloc(new_size);
-    if (new_ptr && ptr) {
-        // Copy data (we don't know the original size, so copy conservatively)
-        // This is a limitation - in practice, we might need to track allocation
-        // sizes
-        memcpy(new_ptr, ptr,
-               new_size); // Assumes new_size <= old_size or undefined behavior
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
         lush_pool_free(ptr);
     }
 
@@ -721,6 +1088,10 @@ char *lush_pool_strdup(const char *str) {
  * @return Pointer to zero-initialized memory, or NULL on failure
  */
 void *lush_pool_calloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        set_last_error(LUSH_POOL_ERROR_INVALID_SIZE);
+        return NULL;
+    }
     size_t total_size = count * size;
     void *ptr = lush_pool_alloc(total_size);
     if (ptr) {
@@ -740,9 +1111,37 @@ lush_pool_stats_t lush_pool_get_stats(void) {
         return stats;
     }
 
-    pthread_mutex_lock(&pool_mutex);
-    stats = global_memory_pool->stats;
-    pthread_mutex_unlock(&pool_mutex);
+    stats.total_allocations = atomic_load_explicit(
+        &pool_stats.total_allocations, memory_order_relaxed);
+    stats.pool_hits =
+        atomic_load_explicit(&pool_stats.pool_hits, memory_order_relaxed);
+    stats.pool_misses =
+        atomic_load_explicit(&pool_stats.pool_misses, memory_order_relaxed);
+    stats.malloc_fallbacks = stats.pool_misses;
+    stats.current_pool_usage = atomic_load_explicit(
+        &pool_stats.current_pool_usage, memory_order_relaxed);
+    stats.peak_pool_usage = atomic_load_explicit(&pool_stats.peak_pool_usage,
+                                                 memory_order_relaxed);
+    stats.total_bytes_allocated = atomic_load_explicit(
+        &pool_stats.total_bytes_allocated, memory_order_relaxed);
+    stats.active_allocations = atomic_load_explicit(
+        &pool_stats.active_allocations, memory_order_relaxed);
+
+    // Update hit rate
+    if (stats.total_allocations > 0) {
+        stats.pool_hit_rate =
+            (double)stats.pool_hits / stats.total_allocations * 100.0;
+    }
+
+    // Average over the sampled allocations
+    uint64_t timed = atomic_load_explicit(&pool_stats.timed_allocations,
+                                          memory_order_relaxed);
+    if (timed > 0) {
+        stats.avg_allocation_time_ns =
+            atomic_load_explicit(&pool_stats.timed_allocation_ns,
+                                 memory_order_relaxed) /
+            timed;
+    }
 
     return stats;
 }
@@ -755,9 +1154,7 @@ void lush_pool_reset_stats(void) {
         return;
     }
 
-    pthread_mutex_lock(&pool_mutex);
-    memset(&global_memory_pool->stats, 0, sizeof(lush_pool_stats_t));
-    pthread_mutex_unlock(&pool_mutex);
+    clear_stats();
 
     POOL_DEBUG("Pool statistics reset");
 }
@@ -771,23 +1168,76 @@ bool lush_pool_is_healthy(void) {
         return false;
     }
 
-    pthread_mutex_lock(&pool_mutex);
-
     // Check each pool has some free blocks available
     bool healthy = true;
-    for (int i = 0; i < LUSH_POOL_COUNT; i++) {
-        if (global_memory_pool->pools[i].free_blocks == 0 &&
-            global_memory_pool->pools[i].current_blocks >=
-                global_memory_pool->pools[i].max_blocks) {
+    for (int i = 0; i < LUSH_POOL_COUNT && healthy; i++) {
+        lush_pool_t *pool = &global_memory_pool->pools[i];
+        pthread_mutex_lock(&pool->lock);
+        if (pool->free_blocks == 0 &&
+            pool->current_blocks >= pool->max_blocks) {
             healthy = false;
-            break;
         }
+        pthread_mutex_unlock(&pool->lock);
     }
 
-    pthread_mutex_unlock(&pool_mutex);
     return healthy;
 }
 
+/**
+ * @brief Comparison for sorting free blocks by address
+ * @param a Pointer to the first block pointer
+ * @param b Pointer to the second block pointer
+ * @return Negative, zero or positive as a is below, at or above b
+ */
+static int compare_block_addresses(const void *a, const void *b) {
+    uintptr_t left = (uintptr_t) * (void *const *)a;
+    uintptr_t right = (uintptr_t) * (void *const *)b;
+    return (left > right) - (left < right);
+}
+
+/**
+ * @brief Perform pool maintenance (sort shared free lists by address)
+ *
+ * Blocks are handed out lowest address first afterwards, which keeps live
+ * blocks packed toward the start of each slab. Blocks held in thread caches
+ * are not touched.
+ */
+void lush_pool_maintenance(void) {
+    if (!global_memory_pool || !global_memory_pool->initialized) {
+        return;
+    }
+
+    for (int i = 0; i < LUSH_POOL_COUNT; i++) {
+        lush_pool_t *pool = &global_memory_pool->pools[i];
+        pthread_mutex_lock(&pool->lock);
+
+        void **blocks = pool->free_blocks > 1
+                            ? malloc(pool->free_blocks * sizeof(void *))
+                            : NULL;
+        if (blocks) {
+            size_t count = 0;
+            for (pool_free_block_t *block = pool->free_list; block;
+                 block = block->next) {
+                blocks[count++] = block;
+            }
+            qsort(blocks, count, sizeof(void *), compare_block_addresses);
+
+            pool_free_block_t *head = NULL;
+            for (size_t j = count; j > 0; j--) {
+                pool_free_block_t *block = blocks[j - 1];
+                block->next = head;
+                head = block;
+            }
+            pool->free_list = head;
+            free(blocks);
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    POOL_DEBUG("Pool maintenance complete");
+}
+
 /**
  * @brief Get recommended pool size for given allocation size
  * @param size The allocation size to find a pool for
@@ -838,9 +1288,12 @@ void lush_pool_analyze_fallback_patterns(void) {
     if (global_memory_pool && global_memory_pool->initialized) {
         printf("Pool Status:\n");
         for (int i = 0; i < LUSH_POOL_COUNT; i++) {
-            lush_pool_t *pool = &global_memory_pool->pools[i];
+            size_t free_blocks = 0;
+            size_t total_blocks = 0;
+            lush_pool_get_pool_info((lush_pool_size_t)i, NULL, &free_blocks,
+                                    &total_blocks);
             printf("  Pool %d (%zuB): %zu/%zu blocks free\n", i, POOL_SIZES[i],
-                   pool->free_blocks, pool->current_blocks);
+                   free_blocks, total_blocks);
         }
     }
 
@@ -856,29 +1309,60 @@ void lush_pool_analyze_fallback_patterns(void) {
 /**
  * @brief Check if pointer was allocated from pool system
  * @param ptr Pointer to check
- * @return true if pointer is from a pool, false otherwise
+ * @return true if pointer is a live block from a pool, false otherwise
  */
 bool lush_pool_is_pool_pointer(const void *ptr) {
-    if (!ptr || !global_memory_pool) {
+    uint64_t generation =
+        atomic_load_explicit(&pool_generation, memory_order_acquire);
+    if (!ptr || !(generation & 1)) {
         return false;
     }
 
-    pthread_mutex_lock(&pool_mutex);
+    lush_pool_t *pool = find_owning_pool(global_memory_pool, ptr);
+    size_t index;
+    return pool && block_index(pool, ptr, &index) &&
+           atomic_load_explicit(&pool->block_state[index],
+                                memory_order_relaxed) == 1;
+}
 
-    bool is_pool_ptr = false;
-    for (int i = 0; i < LUSH_POOL_COUNT; i++) {
-        lush_pool_t *pool = &global_memory_pool->pools[i];
-        for (size_t j = 0; j < pool->current_blocks; j++) {
-            if (pool->all_blocks[j].memory == ptr) {
-                is_pool_ptr = true;
-                goto cleanup;
-            }
+/**
+ * @brief Get detailed information about specific pool
+ * @param pool_type The pool type to query
+ * @param block_size Pointer to store block size (may be NULL)
+ * @param free_blocks Pointer to store free block count (may be NULL)
+ * @param total_blocks Pointer to store total block count (may be NULL)
+ *
+ * Counts blocks carved from the slab so far; free blocks include those held
+ * in thread caches.
+ */
+void lush_pool_get_pool_info(lush_pool_size_t pool_type, size_t *block_size,
+                               size_t *free_blocks, size_t *total_blocks) {
+    size_t size = 0;
+    size_t total = 0;
+    size_t in_use = 0;
+
+    if (global_memory_pool && global_memory_pool->initialized &&
+        pool_type < LUSH_POOL_COUNT) {
+        lush_pool_t *pool = &global_memory_pool->pools[pool_type];
+        pthread_mutex_lock(&pool->lock);
+        size = pool->block_size;
+        total = pool->current_blocks;
+        for (size_t i = 0; i < total; i++) {
+            in_use += atomic_load_explicit(&pool->block_state[i],
+                                           memory_order_relaxed);
         }
+        pthread_mutex_unlock(&pool->lock);
     }
 
-cleanup:
-    pthread_mutex_unlock(&pool_mutex);
-    return is_pool_ptr;
+    if (block_size) {
+        *block_size = size;
+    }
+    if (free_blocks) {
+        *free_blocks = total - in_use;
+    }
+    if (total_blocks) {
+        *total_blocks = total;
+    }
 }
 
 /**
@@ -890,36 +1374,39 @@ void lush_pool_print_status_report(void) {
         return;
     }
 
-    pthread_mutex_lock(&pool_mutex);
-
     printf("\n=== Lush Memory Pool Status Report ===\n");
 
-    lush_pool_stats_t *stats = &global_memory_pool->stats;
+    lush_pool_stats_t stats = lush_pool_get_stats();
     printf("Overall Statistics:\n");
-    printf("  Total allocations: %" PRIu64 "\n", stats->total_allocations);
-    printf("  Pool hits: %" PRIu64 " (%.2f%%)\n", stats->pool_hits,
-           stats->pool_hit_rate);
-    printf("  Malloc fallbacks: %" PRIu64 "\n", stats->malloc_fallbacks);
-    printf("  Active allocations: %u\n", stats->active_allocations);
+    printf("  Total allocations: %" PRIu64 "\n", stats.total_allocations);
+    printf("  Pool hits: %" PRIu64 " (%.2f%%)\n", stats.pool_hits,
+           stats.pool_hit_rate);
+    printf("  Malloc fallbacks: %" PRIu64 "\n", stats.malloc_fallbacks);
+    printf("  Active allocations: %u\n", stats.active_allocations);
     printf("  Pool memory usage: %" PRIu64 " bytes (peak: %" PRIu64 " bytes)\n",
-           stats->current_pool_usage, stats->peak_pool_usage);
+           stats.current_pool_usage, stats.peak_pool_usage);
     printf("  Average allocation time: %" PRIu64 " ns\n",
-           stats->avg_allocation_time_ns);
+           stats.avg_allocation_time_ns);
 
     printf("\nIndividual Pool Status:\n");
     const char *pool_names[] = {"Small", "Medium", "Large", "XLarge"};
     for (int i = 0; i < LUSH_POOL_COUNT; i++) {
         lush_pool_t *pool = &global_memory_pool->pools[i];
-        printf("  %s Pool (%zu bytes): %zu/%zu blocks free, %" PRIu64
-               " allocs, %" PRIu64 " deallocs\n",
-               pool_names[i], pool->block_size, pool->free_blocks,
-               pool->current_blocks, pool->pool_allocations,
-               pool->pool_deallocations);
+        size_t free_blocks = 0;
+        size_t total_blocks = 0;
+        lush_pool_get_pool_info((lush_pool_size_t)i, NULL, &free_blocks,
+                                &total_blocks);
+        printf("  %s Pool (%zu bytes): %zu/%zu blocks free (%zu reserved), "
+               "%" PRIu64 " allocs, %" PRIu64 " deallocs\n",
+               pool_names[i], pool->block_size, free_blocks, total_blocks,
+               pool->max_blocks,
+               atomic_load_explicit(&pool->pool_allocations,
+                                    memory_order_relaxed),
+               atomic_load_explicit(&pool->pool_deallocations,
+                                    memory_order_relaxed));
     }
 
     printf("========================================\n\n");
-
-    pthread_mutex_unlock(&pool_mutex);
 }
 
 /**
@@ -1008,32 +1495,22 @@ lush_pool_error_t lush_pool_get_last_error(void) { return last_error; }
  */
 void lush_pool_get_memory_usage(uint64_t *pool_bytes, uint64_t *malloc_bytes,
                                   double *pool_efficiency) {
-    if (!global_memory_pool) {
-        if (pool_bytes)
-            *pool_bytes = 0;
-        if (malloc_bytes)
-            *malloc_bytes = 0;
-        if (pool_efficiency)
-            *pool_efficiency = 0.0;
-        return;
-    }
-
-    pthread_mutex_lock(&pool_mutex);
+    lush_pool_stats_t stats = lush_pool_get_stats();
 
     if (pool_bytes) {
-        *pool_bytes = global_memory_pool->stats.current_pool_usage;
+        *pool_bytes = stats.current_pool_usage;
     }
 
     if (malloc_bytes) {
-        *malloc_bytes = global_memory_pool->stats.total_bytes_allocated -
-                        global_memory_pool->stats.current_pool_usage;
+        *malloc_bytes = stats.total_bytes_allocated > stats.current_pool_usage
+                            ? stats.total_bytes_allocated -
+                                  stats.current_pool_usage
+                            : 0;
     }
 
     if (pool_efficiency) {
-        *pool_efficiency = global_memory_pool->stats.pool_hit_rate;
+        *pool_efficiency = stats.pool_hit_rate;
     }
-
-    pthread_mutex_unlock(&pool_mutex);
 }
 
 /**
@@ -1045,18 +1522,12 @@ bool lush_pool_meets_performance_targets(void) {
         return false;
     }
 
-    pthread_mutex_lock(&pool_mutex);
-
     // Performance targets:
     // - Pool hit rate > 80%
     // - Average allocation time < 1000 ns
     // - System healthy (pools not exhausted)
 
-    bool meets_targets =
-        (global_memory_pool->stats.pool_hit_rate > 80.0) &&
-        (global_memory_pool->stats.avg_allocation_time_ns < 1000) &&
-        lush_pool_is_healthy();
-
-    pthread_mutex_unlock(&pool_mutex);
-    return meets_targets;
-}
\ No newline at end of file
+    lush_pool_stats_t stats = lush_pool_get_stats();
+    return stats.pool_hit_rate > 80.0 &&
+           stats.avg_allocation_time_ns < 1000 && lush_pool_is_healthy();
+}
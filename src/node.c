@@ -21,11 +21,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* Arena that new nodes and their strings come from (NULL = heap) */
+static __thread lle_arena_t *node_arena = NULL;
+
 /**
  * @brief Create a new AST node
  *
  * Allocates and initializes a new node of the specified type.
- * All fields are zero-initialized.
+ * All fields are zero-initialized. The node comes from the current
+ * parse arena when one is set.
  *
  * @param type Type of node to create
  * @return Pointer to new node (never NULL, aborts on allocation failure)
@@ -33,11 +37,17 @@
 node_t *new_node(node_type_t type) {
     node_t *node = NULL;
 
-    if ((node = calloc(1, sizeof(node_t))) == NULL) {
+    if (node_arena) {
+        node = lle_arena_calloc(node_arena, 1, sizeof(node_t));
+    } else {
+        node = calloc(1, sizeof(node_t));
+    }
+    if (node == NULL) {
         error_syscall("new_node");
     }
 
     node->type = type;
+    node->in_arena = node_arena != NULL;
     node->loc = SOURCE_LOC_UNKNOWN;
 
     return node;
@@ -106,7 +116,7 @@ void set_node_val_str(node_t *node, char *val) {
     if (!val) {
         node->val.str = NULL;
     } else {
-        char *val2 = strdup(val);
+        char *val2 = node_strdup(val);
         if (!val2) {
             error_return("set_node_val_str");
             return;
@@ -124,7 +134,7 @@ void set_node_val_str(node_t *node, char *val) {
  * @param node Root of the tree to free (may be NULL)
  */
 void free_node_tree(node_t *node) {
-    if (!node) {
+    if (!node || node->in_arena) {
         return;
     }
 
@@ -153,3 +163,81 @@ void free_node_tree(node_t *node) {
 
     free(node);
 }
+
+/**
+ * @brief Route node allocations on this thread into an arena
+ *
+ * @param arena Arena to allocate from, or NULL for the heap
+ * @return The previously set arena
+ */
+lle_arena_t *node_set_arena(lle_arena_t *arena) {
+    lle_arena_t *previous = node_arena;
+    node_arena = arena;
+    return previous;
+}
+
+/**
+ * @brief Allocate bytes with the same owner as new nodes
+ *
+ * @param size Number of bytes to allocate
+ * @return Uninitialized memory, or NULL on allocation failure
+ */
+void *node_alloc_bytes(size_t size) {
+    if (node_arena) {
+        return lle_arena_alloc(node_arena, size ? size : 1);
+    }
+    return malloc(size ? size : 1);
+}
+
+/**
+ * @brief Release memory from node_alloc_bytes() or the string helpers
+ *
+ * @param ptr Memory to release (NULL is safely ignored)
+ */
+void node_free_bytes(void *ptr) {
+    if (!node_arena) {
+        free(ptr);
+    }
+}
+
+/**
+ * @brief Duplicate a string for storage in a node
+ *
+ * @param str String to copy
+ * @return Copy owned like new nodes, or NULL on allocation failure
+ */
+char *node_strdup(const char *str) {
+    return node_strndup(str, strlen(str));
+}
+
+/**
+ * @brief Duplicate at most len bytes of a string for storage in a node
+ *
+ * @param str String to copy
+ * @param len Maximum number of bytes to copy
+ * @return NUL-terminated copy, or NULL on allocation failure
+ */
+char *node_strndup(const char *str, size_t len) {
+    len = strnlen(str, len);
+    char *copy = node_alloc_bytes(len + 1);
+    if (copy) {
+        memcpy(copy, str, len);
+        copy[len] = '\0';
+    }
+    return copy;
+}
+
+/**
+ * @brief Hand a heap string over to node storage
+ *
+ * @param str Heap string (ownership transferred, may be NULL)
+ * @return String owned like new nodes, or NULL on failure
+ */
+char *node_adopt_str(char *str) {
+    if (!str || !node_arena) {
+        return str;
+    }
+    char *copy = node_strdup(str);
+    free(str);
+    return copy;
+}
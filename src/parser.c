@@ -79,18 +79,35 @@ parser_t *parser_new(const char *input) {
 }
 
 parser_t *parser_new_with_source(const char *input, const char *source_name) {
+    return parser_new_in_arena(input, source_name, NULL);
+}
+
+/**
+ * @brief Create a parser that builds its tokens and AST in an arena
+ *
+ * @param input Shell command string to parse
+ * @param source_name Source filename for error messages
+ * @param arena Arena that owns the tokens and AST, or NULL for the heap
+ * @return New parser instance, or NULL on failure
+ */
+parser_t *parser_new_in_arena(const char *input, const char *source_name,
+                              lle_arena_t *arena) {
     if (!input) {
         return NULL;
     }
 
-    parser_t *parser = malloc(sizeof(parser_t));
+    parser_t *parser = arena ? lle_arena_alloc(arena, sizeof(parser_t))
+                             : malloc(sizeof(parser_t));
     if (!parser) {
         return NULL;
     }
 
-    parser->tokenizer = tokenizer_new(input);
+    parser->arena = arena;
+    parser->tokenizer = tokenizer_new_in_arena(input, arena);
     if (!parser->tokenizer) {
-        free(parser);
+        if (!arena) {
+            free(parser);
+        }
         return NULL;
     }
 
@@ -129,7 +146,8 @@ void parser_set_source_name(parser_t *parser, const char *source_name) {
 /**
  * @brief Free a parser instance
  *
- * Frees the parser and its associated tokenizer.
+ * Frees the parser and its associated tokenizer. An arena parser only
+ * releases its error collector; the rest belongs to the arena.
  *
  * @param parser Parser to free
  */
@@ -140,7 +158,9 @@ void parser_free(parser_t *parser) {
 
     tokenizer_free(parser->tokenizer);
     shell_error_collector_free(parser->error_collector);
-    free(parser);
+    if (!parser->arena) {
+        free(parser);
+    }
 }
 
 /**
@@ -509,7 +529,10 @@ node_t *parser_parse(parser_t *parser) {
         return NULL; // Empty input
     }
 
-    return parse_command_list(parser);
+    lle_arena_t *previous = node_set_arena(parser->arena);
+    node_t *ast = parse_command_list(parser);
+    node_set_arena(previous);
+    return ast;
 }
 
 /**
@@ -521,7 +544,10 @@ node_t *parser_parse(parser_t *parser) {
  * @return AST for the command line
  */
 node_t *parser_parse_command_line(parser_t *parser) {
-    return parse_command_list(parser);
+    lle_arena_t *previous = node_set_arena(parser->arena);
+    node_t *ast = parse_command_list(parser);
+    node_set_arena(previous);
+    return ast;
 }
 
 /**
@@ -719,6 +745,8 @@ static node_t *parse_command_list(parser_t *parser) {
             break;
         }
 
+        source_location_t start = token_to_source_location(
+            tokenizer_current(parser->tokenizer), parser->source_name);
         node_t *command = parse_logical_expression(parser);
         if (!command) {
             if (!parser->has_error) {
@@ -728,6 +756,12 @@ static node_t *parse_command_list(parser_t *parser) {
             return NULL;
         }
 
+        // Lists and some compound commands carry no location of their own;
+        // every command of the list starts where its first token does
+        if (command->loc.line == 0) {
+            command->loc = start;
+        }
+
         if (!first_command) {
             first_command = command;
             current = command;
@@ -975,22 +1009,18 @@ static node_t *parse_simple_command(parser_t *parser) {
 
                 // Extract variable name (part before [)
                 size_t var_len = bracket - current->text;
-                char *var_name = malloc(var_len + 1);
+                char *var_name = node_strndup(current->text, var_len);
                 if (!var_name) {
                     return NULL;
                 }
-                strncpy(var_name, current->text, var_len);
-                var_name[var_len] = '\0';
 
                 // Extract subscript (part between [ and ])
                 size_t sub_len = close_bracket - bracket - 1;
-                char *subscript = malloc(sub_len + 1);
+                char *subscript = node_strndup(bracket + 1, sub_len);
                 if (!subscript) {
-                    free(var_name);
+                    node_free_bytes(var_name);
                     return NULL;
                 }
-                strncpy(subscript, bracket + 1, sub_len);
-                subscript[sub_len] = '\0';
 
                 // Check if += or =
                 bool is_append = (next->type == TOK_PLUS_ASSIGN);
@@ -1005,18 +1035,18 @@ static node_t *parse_simple_command(parser_t *parser) {
                                    value_token->type == TOK_VARIABLE ||
                                    value_token->type == TOK_STRING ||
                                    value_token->type == TOK_EXPANDABLE_STRING)) {
-                    value_str = strdup(value_token->text);
+                    value_str = node_strdup(value_token->text);
                     tokenizer_advance(parser->tokenizer); // consume value
                 }
                 if (!value_str) {
-                    value_str = strdup("");
+                    value_str = node_strdup("");
                 }
 
                 // Create array assignment node
                 node_t *assign_node = new_node(NODE_ARRAY_ASSIGN);
                 if (!assign_node) {
-                    free(var_name);
-                    free(subscript);
+                    node_free_bytes(var_name);
+                    node_free_bytes(subscript);
                     return NULL;
                 }
 
@@ -1026,7 +1056,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                 // Create subscript child node
                 node_t *subscript_node = new_node(NODE_VAR);
                 if (!subscript_node) {
-                    free(subscript);
+                    node_free_bytes(subscript);
                     free_node_tree(assign_node);
                     return NULL;
                 }
@@ -1044,12 +1074,12 @@ static node_t *parse_simple_command(parser_t *parser) {
                 if (is_append) {
                     // Encode append with "+=" prefix
                     size_t vlen = strlen(value_str);
-                    char *append_val = malloc(vlen + 3);
+                    char *append_val = node_alloc_bytes(vlen + 3);
                     if (append_val) {
                         strcpy(append_val, "+=");
                         strcat(append_val, value_str);
                         value_node->val.str = append_val;
-                        free(value_str);
+                        node_free_bytes(value_str);
                     } else {
                         value_node->val.str = value_str; // Transfer ownership
                     }
@@ -1067,7 +1097,7 @@ static node_t *parse_simple_command(parser_t *parser) {
             bool is_append = (next->type == TOK_PLUS_ASSIGN);
 
             // Save variable name BEFORE advancing tokenizer
-            char *var_name = strdup(current->text);
+            char *var_name = node_strdup(current->text);
             if (!var_name) {
                 return NULL;
             }
@@ -1082,13 +1112,13 @@ static node_t *parse_simple_command(parser_t *parser) {
                 shell_mode_allows(FEATURE_INDEXED_ARRAYS)) {
                 node_t *array_node = parse_array_literal(parser);
                 if (!array_node) {
-                    free(var_name);
+                    node_free_bytes(var_name);
                     return NULL;
                 }
                 // Create array assignment or append node
                 node_t *assign_node = new_node(is_append ? NODE_ARRAY_APPEND : NODE_ARRAY_ASSIGN);
                 if (!assign_node) {
-                    free(var_name);
+                    node_free_bytes(var_name);
                     free_node_tree(array_node);
                     return NULL;
                 }
@@ -1101,7 +1131,7 @@ static node_t *parse_simple_command(parser_t *parser) {
             // Regular scalar assignment: variable=value
             node_t *command = new_node(NODE_COMMAND);
             if (!command) {
-                free(var_name);
+                node_free_bytes(var_name);
                 return NULL;
             }
 
@@ -1119,7 +1149,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                 size_t value_len = 0;
                 char *full_value = malloc(value_capacity);
                 if (!full_value) {
-                    free(var_name);
+                    node_free_bytes(var_name);
                     free_node_tree(command);
                     return NULL;
                 }
@@ -1152,7 +1182,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                         char *new_value = realloc(full_value, value_capacity);
                         if (!new_value) {
                             free(full_value);
-                            free(var_name);
+                            node_free_bytes(var_name);
                             free_node_tree(command);
                             return NULL;
                         }
@@ -1180,7 +1210,8 @@ static node_t *parse_simple_command(parser_t *parser) {
                 
                 // Build final assignment string: var=value or var+=value
                 size_t var_len = strlen(var_name);
-                char *assignment = malloc(var_len + (is_append ? 2 : 1) + value_len + 1);
+                char *assignment = node_alloc_bytes(
+                    var_len + (is_append ? 2 : 1) + value_len + 1);
                 if (assignment) {
                     strcpy(assignment, var_name);
                     strcat(assignment, is_append ? "+=" : "=");
@@ -1192,7 +1223,7 @@ static node_t *parse_simple_command(parser_t *parser) {
             } else {
                 // Assignment with empty value: variable=
                 size_t var_len = strlen(var_name);
-                char *assignment = malloc(var_len + 2);
+                char *assignment = node_alloc_bytes(var_len + 2);
                 if (assignment) {
                     strcpy(assignment, var_name);
                     strcat(assignment, "=");
@@ -1201,7 +1232,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                 }
             }
 
-            free(var_name);
+            node_free_bytes(var_name);
             return command;
         }
     }
@@ -1255,7 +1286,7 @@ static node_t *parse_simple_command(parser_t *parser) {
     }
 
     // Set command name
-    command->val.str = strdup(current->text);
+    command->val.str = node_strdup(current->text);
     command->val_type = VAL_STR;
     tokenizer_advance(parser->tokenizer);
 
@@ -1327,7 +1358,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                     if (assign_end < parser->tokenizer->input_length &&
                         parser->tokenizer->input[assign_end] == '(') {
                         // This is an array literal argument: name=(...) or name+=(...)
-                        char *var_name = strdup(arg_token->text);
+                        char *var_name = node_strdup(arg_token->text);
                         bool is_append = (peek1->type == TOK_PLUS_ASSIGN);
                         
                         tokenizer_advance(parser->tokenizer); // consume var name
@@ -1336,7 +1367,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                         // Now parse the array literal
                         node_t *array_node = parse_array_literal(parser);
                         if (!array_node) {
-                            free(var_name);
+                            node_free_bytes(var_name);
                             free_node_tree(command);
                             return NULL;
                         }
@@ -1354,7 +1385,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                             elem = elem->next_sibling;
                         }
                         
-                        char *arg_str = malloc(total_len + 1);
+                        char *arg_str = node_alloc_bytes(total_len + 1);
                         if (arg_str) {
                             strcpy(arg_str, var_name);
                             strcat(arg_str, is_append ? "+=(" : "=(");
@@ -1378,11 +1409,11 @@ static node_t *parse_simple_command(parser_t *parser) {
                                 arg_node->val_type = VAL_STR;
                                 add_child_node(command, arg_node);
                             } else {
-                                free(arg_str);
+                                node_free_bytes(arg_str);
                             }
                         }
                         
-                        free(var_name);
+                        node_free_bytes(var_name);
                         free_node_tree(array_node);
                         continue; // Skip to next argument
                     }
@@ -1410,7 +1441,11 @@ static node_t *parse_simple_command(parser_t *parser) {
                 char *text;
             } token_info_t;
 
-            token_info_t *collected_tokens = NULL;
+            // Most words are a single token; only long runs of adjacent
+            // tokens spill to the heap
+            token_info_t inline_tokens[8];
+            token_info_t *collected_tokens = inline_tokens;
+            int token_capacity = 8;
             int token_count = 0;
             size_t last_end_pos = arg_token->position + strlen(arg_token->text);
 
@@ -1430,21 +1465,32 @@ static node_t *parse_simple_command(parser_t *parser) {
                                  arg_token->type == TOK_NOT_EQUAL)) {
 
                 // Expand collected_tokens array
-                token_info_t *new_tokens = realloc(
-                    collected_tokens, (token_count + 1) * sizeof(token_info_t));
-                if (!new_tokens) {
-                    for (int i = 0; i < token_count; i++) {
-                        free(collected_tokens[i].text);
+                if (token_count == token_capacity) {
+                    token_info_t *new_tokens = malloc(
+                        2 * token_capacity * sizeof(token_info_t));
+                    if (!new_tokens) {
+                        for (int i = 0; i < token_count; i++) {
+                            node_free_bytes(collected_tokens[i].text);
+                        }
+                        if (collected_tokens != inline_tokens) {
+                            free(collected_tokens);
+                        }
+                        free_node_tree(command);
+                        return NULL;
                     }
-                    free(collected_tokens);
-                    free_node_tree(command);
-                    return NULL;
+                    memcpy(new_tokens, collected_tokens,
+                           token_count * sizeof(token_info_t));
+                    if (collected_tokens != inline_tokens) {
+                        free(collected_tokens);
+                    }
+                    collected_tokens = new_tokens;
+                    token_capacity *= 2;
                 }
-                collected_tokens = new_tokens;
 
                 // Store token information
                 collected_tokens[token_count].type = arg_token->type;
-                collected_tokens[token_count].text = strdup(arg_token->text);
+                collected_tokens[token_count].text =
+                    node_strdup(arg_token->text);
                 token_count++;
 
                 last_end_pos = arg_token->position + strlen(arg_token->text);
@@ -1483,9 +1529,11 @@ static node_t *parse_simple_command(parser_t *parser) {
                 }
 
                 if (arg_node) {
-                    arg_node->val.str = strdup(collected_tokens[0].text);
+                    // The node takes over the collected copy
+                    arg_node->val.str = collected_tokens[0].text;
                     arg_node->val_type = VAL_STR;
                     add_child_node(command, arg_node);
+                    collected_tokens[0].text = NULL;
                 }
             } else if (token_count > 1) {
                 // Multiple tokens - create concatenated string
@@ -1494,7 +1542,7 @@ static node_t *parse_simple_command(parser_t *parser) {
                     total_len += strlen(collected_tokens[i].text);
                 }
 
-                char *concatenated = malloc(total_len + 1);
+                char *concatenated = node_alloc_bytes(total_len + 1);
                 if (concatenated) {
                     concatenated[0] = '\0';
                     for (int i = 0; i < token_count; i++) {
@@ -1507,16 +1555,18 @@ static node_t *parse_simple_command(parser_t *parser) {
                         arg_node->val_type = VAL_STR;
                         add_child_node(command, arg_node);
                     } else {
-                        free(concatenated);
+                        node_free_bytes(concatenated);
                     }
                 }
             }
 
             // Clean up collected tokens
             for (int i = 0; i < token_count; i++) {
-                free(collected_tokens[i].text);
+                node_free_bytes(collected_tokens[i].text);
+            }
+            if (collected_tokens != inline_tokens) {
+                free(collected_tokens);
             }
-            free(collected_tokens);
         } else {
             break; // Stop parsing arguments
         }
@@ -1823,7 +1873,7 @@ static node_t *parse_redirection(parser_t *parser) {
     }
 
     // Store the redirection operator
-    redir_node->val.str = strdup(redir_token->text);
+    redir_node->val.str = node_strdup(redir_token->text);
     redir_node->val_type = VAL_STR;
 
     // Disable keyword recognition for redirection targets - filenames like
@@ -1901,7 +1951,7 @@ static node_t *parse_redirection(parser_t *parser) {
     if (node_type == NODE_REDIR_HEREDOC ||
         node_type == NODE_REDIR_HEREDOC_STRIP) {
         // Store delimiter before advancing tokenizer
-        char *delimiter = strdup(target_token->text);
+        char *delimiter = node_strdup(target_token->text);
         bool strip_tabs = (node_type == NODE_REDIR_HEREDOC_STRIP);
 
         // Check if delimiter is quoted (any quoted delimiter disables
@@ -1922,7 +1972,7 @@ static node_t *parse_redirection(parser_t *parser) {
         char *content = collect_heredoc_content(parser, delimiter, strip_tabs,
                                                 expand_variables);
         if (!content) {
-            free(delimiter);
+            node_free_bytes(delimiter);
             free_node_tree(redir_node);
             return NULL;
         }
@@ -1938,7 +1988,7 @@ static node_t *parse_redirection(parser_t *parser) {
             free_node_tree(redir_node);
             return NULL;
         }
-        content_node->val.str = content; // Transfer ownership
+        content_node->val.str = node_adopt_str(content); // Transfer ownership
         content_node->val_type = VAL_STR;
         add_child_node(redir_node, content_node);
 
@@ -1948,7 +1998,7 @@ static node_t *parse_redirection(parser_t *parser) {
             free_node_tree(redir_node);
             return NULL;
         }
-        expand_flag_node->val.str = strdup(expand_variables ? "1" : "0");
+        expand_flag_node->val.str = node_strdup(expand_variables ? "1" : "0");
         expand_flag_node->val_type = VAL_STR;
         add_child_node(redir_node, expand_flag_node);
 
@@ -2006,7 +2056,7 @@ static node_t *parse_redirection(parser_t *parser) {
             free_node_tree(redir_node);
             return NULL;
         }
-        target_node->val.str = concatenated_target;
+        target_node->val.str = node_adopt_str(concatenated_target);
         target_node->val_type = VAL_STR;
         add_child_node(redir_node, target_node);
 
@@ -2797,7 +2847,7 @@ static node_t *parse_for_statement(parser_t *parser) {
         // Child 0: init expression
         node_t *init_node = new_node(NODE_ARITH_EXP);
         if (init_node) {
-            init_node->val.str = init_expr;
+            init_node->val.str = node_adopt_str(init_expr);
             init_node->val_type = VAL_STR;
             add_child_node(for_arith_node, init_node);
         } else {
@@ -2807,7 +2857,7 @@ static node_t *parse_for_statement(parser_t *parser) {
         // Child 1: test expression
         node_t *test_node = new_node(NODE_ARITH_EXP);
         if (test_node) {
-            test_node->val.str = test_expr;
+            test_node->val.str = node_adopt_str(test_expr);
             test_node->val_type = VAL_STR;
             add_child_node(for_arith_node, test_node);
         } else {
@@ -2817,7 +2867,7 @@ static node_t *parse_for_statement(parser_t *parser) {
         // Child 2: update expression
         node_t *update_node = new_node(NODE_ARITH_EXP);
         if (update_node) {
-            update_node->val.str = update_expr;
+            update_node->val.str = node_adopt_str(update_expr);
             update_node->val_type = VAL_STR;
             add_child_node(for_arith_node, update_node);
         } else {
@@ -2885,7 +2935,7 @@ static node_t *parse_for_statement(parser_t *parser) {
     }
 
     token_t *var_token = tokenizer_current(parser->tokenizer);
-    for_node->val.str = strdup(var_token->text);
+    for_node->val.str = node_strdup(var_token->text);
     for_node->val_type = VAL_STR;
     tokenizer_advance(parser->tokenizer);
 
@@ -2908,7 +2958,7 @@ static node_t *parse_for_statement(parser_t *parser) {
         // Create a word list containing "$@"
         node_t *at_node = new_node(NODE_VAR);
         if (at_node) {
-            at_node->val.str = strdup("\"$@\"");
+            at_node->val.str = node_strdup("\"$@\"");
             at_node->val_type = VAL_STR;
             add_child_node(word_list, at_node);
         }
@@ -2944,7 +2994,7 @@ static node_t *parse_for_statement(parser_t *parser) {
                 free_node_tree(word_list);
                 return NULL;
             }
-            word_node->val.str = strdup("=");
+            word_node->val.str = node_strdup("=");
             word_node->val_type = VAL_STR;
             add_child_node(word_list, word_node);
             tokenizer_advance(parser->tokenizer);
@@ -3049,7 +3099,7 @@ static node_t *parse_for_statement(parser_t *parser) {
                 }
             }
 
-            word_node->val.str = combined;
+            word_node->val.str = node_adopt_str(combined);
             word_node->val_type = VAL_STR;
             add_child_node(word_list, word_node);
         } else {
@@ -3138,7 +3188,7 @@ static node_t *parse_select_statement(parser_t *parser) {
     }
 
     token_t *var_token = tokenizer_current(parser->tokenizer);
-    select_node->val.str = strdup(var_token->text);
+    select_node->val.str = node_strdup(var_token->text);
     select_node->val_type = VAL_STR;
     tokenizer_advance(parser->tokenizer);
 
@@ -3193,7 +3243,7 @@ static node_t *parse_select_statement(parser_t *parser) {
                     return NULL;
                 }
 
-                word_node->val.str = strdup(word_token->text);
+                word_node->val.str = node_strdup(word_token->text);
                 word_node->val_type = VAL_STR;
                 add_child_node(word_list, word_node);
                 tokenizer_advance(parser->tokenizer);
@@ -3357,7 +3407,7 @@ static node_t *parse_coproc(parser_t *parser) {
                      next->type == TOK_CASE ||
                      next->type == TOK_SELECT)) {
             // Current is the NAME
-            coproc_name = strdup(current->text);
+            coproc_name = node_strdup(current->text);
             tokenizer_advance(parser->tokenizer);
         }
     }
@@ -3481,7 +3531,7 @@ static node_t *parse_case_statement(parser_t *parser) {
     }
 
     // Store the test word
-    case_node->val.str = case_word;
+    case_node->val.str = node_adopt_str(case_word);
     case_node->val_type = VAL_STR;
 
     // Skip separators
@@ -3602,7 +3652,7 @@ static node_t *parse_case_statement(parser_t *parser) {
                  (tokenizer_advance(parser->tokenizer), true));
 
         // Store pattern in case item
-        case_item->val.str = pattern;
+        case_item->val.str = node_adopt_str(pattern);
         case_item->val_type = VAL_STR;
 
         // Expect )
@@ -3703,11 +3753,11 @@ static node_t *parse_case_statement(parser_t *parser) {
         // '2' = CASE_TERM_CONTINUE (;;&)
         if (case_item->val.str) {
             size_t old_len = strlen(case_item->val.str);
-            char *new_pattern = malloc(old_len + 2);
+            char *new_pattern = node_alloc_bytes(old_len + 2);
             if (new_pattern) {
                 new_pattern[0] = '0' + (char)terminator;
                 strcpy(new_pattern + 1, case_item->val.str);
-                free(case_item->val.str);
+                node_free_bytes(case_item->val.str);
                 case_item->val.str = new_pattern;
             }
         }
@@ -3839,7 +3889,7 @@ static node_t *parse_function_definition(parser_t *parser) {
     }
 
     // Store function name
-    function_node->val.str = strdup(current->text);
+    function_node->val.str = node_strdup(current->text);
     function_node->val_type = VAL_STR;
     if (!function_node->val.str) {
         free_node_tree(function_node);
@@ -4016,11 +4066,11 @@ static node_t *parse_function_definition(parser_t *parser) {
             if (function_node->val.str) {
                 char *old_name = function_node->val.str;
                 function_node->val.str =
-                    malloc(strlen(old_name) + strlen(param_info) + 2);
+                    node_alloc_bytes(strlen(old_name) + strlen(param_info) + 2);
                 strcpy(function_node->val.str, old_name);
                 strcat(function_node->val.str, "|");
                 strcat(function_node->val.str, param_info);
-                free(old_name);
+                node_free_bytes(old_name);
             }
             free(param_info);
         }
@@ -4218,7 +4268,7 @@ static node_t *parse_arithmetic_command(parser_t *parser) {
         memmove(expr, start, strlen(start) + 1);
     }
 
-    arith_node->val.str = expr;
+    arith_node->val.str = node_adopt_str(expr);
     arith_node->val_type = VAL_STR;
 
     return arith_node;
@@ -4342,7 +4392,7 @@ static node_t *parse_array_literal(parser_t *parser) {
             // Store as "[index]=value" for later processing
             size_t total_len = 1 + (index_str ? strlen(index_str) : 0) + 2 +
                               (value_str ? strlen(value_str) : 0) + 1;
-            char *combined = malloc(total_len);
+            char *combined = node_alloc_bytes(total_len);
             if (combined) {
                 snprintf(combined, total_len, "[%s]=%s",
                         index_str ? index_str : "0",
@@ -4389,7 +4439,7 @@ static node_t *parse_array_literal(parser_t *parser) {
                 return NULL;
             }
 
-            elem_node->val.str = strdup(current->text);
+            elem_node->val.str = node_strdup(current->text);
             elem_node->val_type = VAL_STR;
             add_child_node(array_node, elem_node);
 
@@ -4582,7 +4632,7 @@ static node_t *parse_extended_test(parser_t *parser) {
         memmove(expr, start, strlen(start) + 1);
     }
 
-    test_node->val.str = expr;
+    test_node->val.str = node_adopt_str(expr);
     test_node->val_type = VAL_STR;
 
     return test_node;
@@ -4669,7 +4719,7 @@ static node_t *parse_process_substitution(parser_t *parser) {
     }
 
     // Store the operator for debugging
-    proc_sub_node->val.str = strdup(op_name);
+    proc_sub_node->val.str = node_strdup(op_name);
     proc_sub_node->val_type = VAL_STR;
 
     return proc_sub_node;
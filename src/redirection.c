@@ -1112,6 +1112,214 @@ static int setup_fd_redirection(executor_t *executor, const char *redir_text) {
     return 0;
 }
 
+/** Access mode of an fd not yet touched by a spawn file action */
+#define SPAWN_FD_INHERITED (-2)
+/** Access mode of an fd closed by a spawn file action */
+#define SPAWN_FD_CLOSED (-1)
+
+/**
+ * @brief Translate a literal fd redirection into a spawn file action
+ *
+ * Mirrors setup_fd_redirection() for the forms N>&M, N<&M and N>&-,
+ * including its access-mode validation. fd_modes tracks what earlier
+ * actions left in fds 0-9 so the check sees the child's view.
+ *
+ * @param redir_text Redirection text (e.g., ">&2", "2>&1", "<&-")
+ * @param actions File actions to append to
+ * @param fd_modes Access modes of fds 0-9 as seen by the child
+ * @return 0 on success, 1 if ineligible
+ */
+static int add_spawn_fd_action(const char *redir_text,
+                               posix_spawn_file_actions_t *actions,
+                               int *fd_modes) {
+    if (!redir_text) {
+        return 1;
+    }
+
+    const char *p = redir_text;
+    int source_fd = -1;
+
+    if (isdigit(*p)) {
+        source_fd = *p - '0';
+        p++;
+    }
+
+    if (*p == '<') {
+        if (source_fd == -1) source_fd = STDIN_FILENO;
+    } else if (*p == '>') {
+        if (source_fd == -1) source_fd = STDOUT_FILENO;
+    } else {
+        return 1;
+    }
+    p++;
+
+    if (*p++ != '&') {
+        return 1;
+    }
+
+    if (p[0] == '-' && p[1] == '\0') {
+        fd_modes[source_fd] = SPAWN_FD_CLOSED;
+        return posix_spawn_file_actions_addclose(actions, source_fd) != 0;
+    }
+
+    if (!isdigit(p[0]) || p[1] != '\0') {
+        return 1; // Variable fd targets need expansion in the child
+    }
+    int target_fd = p[0] - '0';
+
+    // Same validation setup_fd_redirection() performs; on failure let the
+    // fork path report the error
+    int access_mode = fd_modes[target_fd];
+    if (access_mode == SPAWN_FD_INHERITED) {
+        int fd_flags = fcntl(target_fd, F_GETFL);
+        access_mode = fd_flags == -1 ? SPAWN_FD_CLOSED : fd_flags & O_ACCMODE;
+    }
+    if (access_mode == SPAWN_FD_CLOSED) {
+        return 1;
+    }
+    if (source_fd != STDIN_FILENO && access_mode == O_RDONLY) {
+        return 1;
+    }
+    if (source_fd == STDIN_FILENO && access_mode == O_WRONLY) {
+        return 1;
+    }
+
+    fd_modes[source_fd] = access_mode;
+    return posix_spawn_file_actions_adddup2(actions, target_fd, source_fd) != 0;
+}
+
+/**
+ * @brief Translate a command's redirections into posix_spawn file actions
+ *
+ * Walks the same redirection nodes as setup_redirections(), in order, and
+ * emits the equivalent open/dup2/close actions. Returns 1 as soon as one
+ * redirection needs shell code in the child; errors such as a missing
+ * input file surface as a posix_spawn failure, after which the caller
+ * takes the fork path and setup_redirections() reports them.
+ *
+ * @param executor Executor context for target expansion
+ * @param command Command node containing redirection children
+ * @param actions Initialized file actions object to append to
+ * @return 0 if every redirection was translated, 1 if ineligible
+ */
+int build_spawn_file_actions(executor_t *executor, node_t *command,
+                             posix_spawn_file_actions_t *actions) {
+    if (!command) {
+        return 0;
+    }
+
+    int fd_modes[10];
+    for (int i = 0; i < 10; i++) {
+        fd_modes[i] = SPAWN_FD_INHERITED;
+    }
+
+    for (node_t *child = command->first_child; child;
+         child = child->next_sibling) {
+        if (child->type < NODE_REDIR_IN || child->type > NODE_REDIR_FD_ALLOC) {
+            continue;
+        }
+
+        if (child->type == NODE_REDIR_FD) {
+            if (add_spawn_fd_action(child->val.str, actions, fd_modes) != 0) {
+                return 1;
+            }
+            continue;
+        }
+
+        // N< / N> / N>> carry their fd number as the node's leading digit
+        int explicit_fd = (child->val.str && isdigit(child->val.str[0]))
+                              ? child->val.str[0] - '0'
+                              : -1;
+        int dest_fd;
+        int flags;
+        bool both = false;
+        switch (child->type) {
+        case NODE_REDIR_IN:
+            dest_fd = STDIN_FILENO;
+            flags = O_RDONLY;
+            break;
+        case NODE_REDIR_IN_FD:
+            dest_fd = explicit_fd != -1 ? explicit_fd : STDIN_FILENO;
+            flags = O_RDONLY;
+            break;
+        case NODE_REDIR_OUT:
+            if (is_noclobber_enabled()) {
+                return 1;
+            }
+            dest_fd = STDOUT_FILENO;
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
+            break;
+        case NODE_REDIR_APPEND:
+            dest_fd = STDOUT_FILENO;
+            flags = O_WRONLY | O_CREAT | O_APPEND;
+            break;
+        case NODE_REDIR_ERR:
+            dest_fd = explicit_fd != -1 ? explicit_fd : STDERR_FILENO;
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
+            break;
+        case NODE_REDIR_ERR_APPEND:
+            dest_fd = explicit_fd != -1 ? explicit_fd : STDERR_FILENO;
+            flags = O_WRONLY | O_CREAT | O_APPEND;
+            break;
+        case NODE_REDIR_BOTH:
+            dest_fd = STDOUT_FILENO;
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
+            both = true;
+            break;
+        case NODE_REDIR_BOTH_APPEND:
+            dest_fd = STDOUT_FILENO;
+            flags = O_WRONLY | O_CREAT | O_APPEND;
+            both = true;
+            break;
+        default:
+            // Here-documents, here-strings and {var}> allocation
+            return 1;
+        }
+
+        node_t *target_node = child->first_child;
+        if (!target_node || !target_node->val.str ||
+            target_node->type == NODE_PROC_SUB_IN ||
+            target_node->type == NODE_PROC_SUB_OUT) {
+            return 1;
+        }
+
+        // Parameter, arithmetic and command expansion can have side
+        // effects (${v:=x}, set -u errors) that must happen in the child
+        if (strchr(target_node->val.str, '$') ||
+            strchr(target_node->val.str, '`')) {
+            return 1;
+        }
+
+        char *target = expand_redirection_target(executor,
+                                                 target_node->val.str);
+        if (!target) {
+            return 1;
+        }
+        if (!is_privileged_redirection_allowed(target)) {
+            free(target);
+            return 1;
+        }
+
+        int rc = posix_spawn_file_actions_addopen(actions, dest_fd, target,
+                                                  flags, 0644);
+        free(target);
+        if (rc != 0) {
+            return 1;
+        }
+        fd_modes[dest_fd] = flags & O_ACCMODE;
+
+        if (both) {
+            if (posix_spawn_file_actions_adddup2(actions, STDOUT_FILENO,
+                                                 STDERR_FILENO) != 0) {
+                return 1;
+            }
+            fd_modes[STDERR_FILENO] = flags & O_ACCMODE;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * @brief Save current file descriptors for later restoration
  *
@@ -0,0 +1,845 @@
+/**
+ * @file script_cache.c
+ * @brief Whole-file script parsing with a cache of parsed ASTs
+ *
+ * A script is mapped read-only and parsed straight from the mapping when
+ * the mapping already ends in a NUL byte (the file does not fill its last
+ * page) and contains no backslash-newline pairs; otherwise it is copied
+ * into a buffer with the pairs removed first.
+ *
+ * Cached scripts are keyed by path. Each entry remembers the file identity
+ * it was parsed from and a signature of the parser-visible shell mode
+ * features, and is parsed again when either no longer matches. Entries
+ * are reference counted so a script that is replaced or flushed while it
+ * is still running (a file that sources itself, or is rewritten by the
+ * commands it runs) stays valid until its last user releases it.
+ *
+ * The on-disk cache holds one file per script and parse signature, named
+ * after a hash of both. A cache file is a header naming the lush version,
+ * the script's real path and file identity, followed by fixed-size node
+ * records in preorder and the node strings. It is mapped, checked and
+ * decoded into a single block holding the nodes and their strings; the
+ * nodes are marked as arena nodes so free_node_tree() leaves them to the
+ * block. Cache files are written to a temporary name and renamed into
+ * place, so a reader never sees a partly written file.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "script_cache.h"
+
+#include "ht.h"
+#include "parser.h"
+#include "shell_mode.h"
+#include "version.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+bool is_posix_mode_enabled(void);
+
+/**
+ * @brief A parsed script
+ */
+struct script_ast {
+    char *path;            // Path as loaded (cache key, node filenames)
+    dev_t dev;             // Identity of the file that was parsed
+    ino_t ino;
+    off_t size;
+    struct timespec mtime;
+    uint64_t signature;    // Parser feature signature at parse time
+    node_t *commands;      // Top-level commands (sibling chain)
+    void *block;           // Decoded cache file owning the nodes, or NULL
+    unsigned int refs;     // Users, including the cache
+};
+
+/** @brief Cache file magic */
+#define DISK_MAGIC "LUSHAST"
+
+/**
+ * @brief Cache file format
+ *
+ * Folds in the number of node types, so a build that adds node types
+ * does not read cache files of an older build with the same version.
+ * Revision 2: every top-level command has a location.
+ */
+#define DISK_FORMAT (0x20000u + (uint32_t)NODE_ANON_FUNCTION)
+
+/** @brief Written as is, to reject files from a different byte order */
+#define DISK_BYTE_ORDER 0x01020304u
+
+/**
+ * @brief Cache file header
+ *
+ * Followed by path_len bytes of the script's real path, node_count node
+ * records and strings_size bytes of NUL-terminated node strings.
+ */
+typedef struct disk_header {
+    char magic[8];
+    uint32_t format;
+    uint32_t byte_order;
+    char version[16];        // LUSH_VERSION_STRING
+    uint64_t signature;      // Parser feature signature
+    uint64_t dev;            // Identity of the file that was parsed
+    uint64_t ino;
+    int64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    uint32_t node_count;
+    uint32_t path_len;
+    uint64_t strings_size;
+} disk_header_t;
+
+/**
+ * @brief Cache file node record
+ *
+ * Links are record indexes plus one (0 for none). Records are in preorder,
+ * so every link points to a later record.
+ */
+typedef struct disk_node {
+    uint32_t type;
+    uint32_t val_type;
+    uint64_t val;            // String offset plus one, or the value's bits
+    uint32_t children;
+    uint32_t first_child;
+    uint32_t next_sibling;
+    uint32_t has_filename;   // Location names the script file
+    uint32_t line;
+    uint32_t column;
+    uint32_t offset;
+    uint32_t length;
+} disk_node_t;
+
+static ht_t *script_cache = NULL;
+static script_cache_stats_t cache_stats;
+static char *disk_dir = NULL;
+
+/**
+ * @brief Fingerprint the shell options that change how scripts parse
+ *
+ * @return FNV-1a hash of the feature flags and POSIX mode
+ */
+static uint64_t parse_signature(void) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (int f = 0; f < FEATURE_COUNT; f++) {
+        hash = (hash ^ (shell_mode_allows((shell_feature_t)f) ? 1 : 0)) *
+               1099511628211ULL;
+    }
+    return (hash ^ (is_posix_mode_enabled() ? 1 : 0)) * 1099511628211ULL;
+}
+
+/**
+ * @brief Continue an FNV-1a hash over a byte range
+ */
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ p[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Check whether a parsed script was parsed from a file's contents
+ */
+static bool script_matches_file(const script_ast_t *script,
+                                const struct stat *st) {
+    return script->dev == st->st_dev && script->ino == st->st_ino &&
+           script->size == st->st_size &&
+           script->mtime.tv_sec == st->st_mtim.tv_sec &&
+           script->mtime.tv_nsec == st->st_mtim.tv_nsec;
+}
+
+/**
+ * @brief Check whether a parsed script still matches its file
+ */
+static bool script_is_current(const script_ast_t *script,
+                              const struct stat *st, uint64_t signature) {
+    return script_matches_file(script, st) && script->signature == signature;
+}
+
+/**
+ * @brief Check whether script text contains a backslash-newline pair
+ */
+static bool has_continuation(const char *text, size_t len) {
+    const char *end = text + len;
+    const char *p = text;
+    while ((p = memchr(p, '\\', (size_t)(end - p))) != NULL) {
+        if (p + 1 < end && p[1] == '\n') {
+            return true;
+        }
+        p++;
+    }
+    return false;
+}
+
+/**
+ * @brief Copy script text with backslash-newline pairs removed
+ *
+ * @param text Script text
+ * @param len Length of text
+ * @return NUL-terminated copy, or NULL on allocation failure
+ */
+static char *join_continuations(const char *text, size_t len) {
+    char *out = malloc(len + 1);
+    if (!out) {
+        return NULL;
+    }
+    size_t j = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] == '\\' && i + 1 < len && text[i + 1] == '\n') {
+            i++;
+            continue;
+        }
+        out[j++] = text[i];
+    }
+    out[j] = '\0';
+    return out;
+}
+
+/**
+ * @brief Parse script text into its top-level commands
+ *
+ * @param text NUL-terminated script text
+ * @param path Source name for node locations (must outlive the AST)
+ * @param commands Output first command (NULL for an empty script)
+ * @return true if the whole text parsed without errors
+ */
+static bool parse_script_text(const char *text, const char *path,
+                              node_t **commands) {
+    parser_t *parser = parser_new_with_source(text, path);
+    if (!parser) {
+        return false;
+    }
+    node_t *ast = parser_parse(parser);
+    /* The parser stops quietly at a token it cannot start a command with;
+     * the construct reader would report it and carry on after it */
+    bool ok = !parser_has_error(parser) &&
+              tokenizer_match(parser->tokenizer, TOK_EOF);
+    parser_free(parser);
+    if (!ok) {
+        free_node_tree(ast);
+        return false;
+    }
+    *commands = ast;
+    return true;
+}
+
+/**
+ * @brief Map a script file and parse it
+ *
+ * @param fd Open file descriptor
+ * @param st File status of fd
+ * @param script Script with path set; commands is filled in
+ * @return true on success
+ */
+static bool parse_script_file(int fd, const struct stat *st,
+                              script_ast_t *script) {
+    size_t len = (size_t)st->st_size;
+    if (len == 0) {
+        script->commands = NULL;
+        return true;
+    }
+
+    char *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    /* Embedded NUL bytes would silently cut the parse short */
+    bool ok = memchr(map, '\0', len) == NULL;
+    if (ok) {
+        long page = sysconf(_SC_PAGESIZE);
+        bool terminated = page > 0 && len % (size_t)page != 0;
+        if (terminated && !has_continuation(map, len)) {
+            /* The rest of the last page reads as zeroes */
+            ok = parse_script_text(map, script->path, &script->commands);
+        } else {
+            char *text = join_continuations(map, len);
+            ok = text && parse_script_text(text, script->path,
+                                           &script->commands);
+            free(text);
+        }
+    }
+
+    munmap(map, len);
+    return ok;
+}
+
+/**
+ * @brief Free a script once its last reference is gone
+ */
+static void script_ast_unref(script_ast_t *script) {
+    if (!script || --script->refs > 0) {
+        return;
+    }
+    free_node_tree(script->commands);
+    free(script->block);
+    free(script->path);
+    free(script);
+}
+
+/**
+ * @brief Drop the cache's reference to a script (value free callback)
+ */
+static void cached_script_free(const void *val) {
+    script_ast_unref((script_ast_t *)val);
+}
+
+/**
+ * @brief Create an empty cache
+ */
+static ht_t *script_cache_create(void) {
+    ht_callbacks_t callbacks = {NULL, NULL, NULL, cached_script_free};
+    return ht_create(fnv1a_hash_str, str_eq, &callbacks,
+                     HT_STR_NONE | HT_SEED_RANDOM);
+}
+
+/* ============================================================================
+ * On-disk cache
+ * ============================================================================
+ */
+
+/**
+ * @brief Build the cache file name of a script
+ *
+ * @param real_path Real path of the script
+ * @param signature Parser feature signature
+ * @return Allocated path, or NULL
+ */
+static char *disk_entry_path(const char *real_path, uint64_t signature) {
+    uint64_t hash = hash_bytes(14695981039346656037ULL, real_path,
+                               strlen(real_path));
+    hash = hash_bytes(hash, &signature, sizeof(signature));
+
+    size_t len = strlen(disk_dir) + 22;
+    char *entry = malloc(len);
+    if (entry) {
+        snprintf(entry, len, "%s/%016llx.ast", disk_dir,
+                 (unsigned long long)hash);
+    }
+    return entry;
+}
+
+/**
+ * @brief Count the nodes and string bytes of a command chain
+ *
+ * @return false if the tree holds a value that cannot be stored
+ */
+static bool disk_measure(const node_t *node, size_t *nodes,
+                         size_t *strings) {
+    for (; node; node = node->next_sibling) {
+        if (node->val_type == VAL_LDOUBLE || node->loc.line > UINT32_MAX ||
+            node->loc.column > UINT32_MAX || node->loc.offset > UINT32_MAX ||
+            node->loc.length > UINT32_MAX || node->children > UINT32_MAX) {
+            return false;
+        }
+        (*nodes)++;
+        if ((node->val_type == VAL_STR || node->val_type == 0) &&
+            node->val.str) {
+            *strings += strlen(node->val.str) + 1;
+        }
+        if (!disk_measure(node->first_child, nodes, strings)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Encode a command chain into node records and strings
+ *
+ * @param node First node of the chain
+ * @param records Record array
+ * @param count Records written so far (updated)
+ * @param strings String area
+ * @param used String bytes written so far (updated)
+ * @return Link to the first record of the chain (0 for an empty chain)
+ */
+static uint32_t disk_encode(const node_t *node, disk_node_t *records,
+                            uint32_t *count, char *strings, size_t *used) {
+    uint32_t first = 0;
+    disk_node_t *previous = NULL;
+    for (; node; node = node->next_sibling) {
+        uint32_t index = (*count)++;
+        disk_node_t *rec = &records[index];
+        rec->type = (uint32_t)node->type;
+        rec->val_type = (uint32_t)node->val_type;
+        if ((node->val_type == VAL_STR || node->val_type == 0) &&
+            node->val.str) {
+            size_t len = strlen(node->val.str) + 1;
+            memcpy(strings + *used, node->val.str, len);
+            rec->val = (uint64_t)*used + 1;
+            *used += len;
+        } else if (node->val_type != VAL_STR && node->val_type != 0) {
+            memcpy(&rec->val, &node->val, sizeof(rec->val));
+        }
+        rec->children = (uint32_t)node->children;
+        rec->has_filename = node->loc.filename != NULL;
+        rec->line = (uint32_t)node->loc.line;
+        rec->column = (uint32_t)node->loc.column;
+        rec->offset = (uint32_t)node->loc.offset;
+        rec->length = (uint32_t)node->loc.length;
+        rec->first_child =
+            disk_encode(node->first_child, records, count, strings, used);
+
+        if (previous) {
+            previous->next_sibling = index + 1;
+        } else {
+            first = index + 1;
+        }
+        previous = rec;
+    }
+    return first;
+}
+
+/**
+ * @brief Create the cache directory and its missing parents
+ */
+static bool disk_make_dir(void) {
+    char *dir = strdup(disk_dir);
+    if (!dir) {
+        return false;
+    }
+    for (char *p = dir + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            if (mkdir(dir, 0700) != 0 && errno != EEXIST) {
+                free(dir);
+                return false;
+            }
+            *p = '/';
+        }
+    }
+    bool ok = mkdir(dir, 0700) == 0 || errno == EEXIST;
+    free(dir);
+    return ok;
+}
+
+/**
+ * @brief Write all of a buffer to a file descriptor
+ */
+static bool write_all(int fd, const void *data, size_t len) {
+    const char *p = data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Write a parsed script to the on-disk cache
+ *
+ * Failures are silent; the script is simply parsed again next time.
+ *
+ * @param script Parsed script
+ * @param real_path Real path of the script
+ */
+static void disk_store(const script_ast_t *script, const char *real_path) {
+    size_t nodes = 0, strings_size = 0;
+    size_t path_len = strlen(real_path);
+    if (!disk_measure(script->commands, &nodes, &strings_size) ||
+        nodes > UINT32_MAX || path_len > UINT32_MAX) {
+        return;
+    }
+
+    disk_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DISK_MAGIC, sizeof(DISK_MAGIC));
+    header.format = DISK_FORMAT;
+    header.byte_order = DISK_BYTE_ORDER;
+    strncpy(header.version, LUSH_VERSION_STRING, sizeof(header.version) - 1);
+    header.signature = script->signature;
+    header.dev = (uint64_t)script->dev;
+    header.ino = (uint64_t)script->ino;
+    header.size = (int64_t)script->size;
+    header.mtime_sec = (int64_t)script->mtime.tv_sec;
+    header.mtime_nsec = (int64_t)script->mtime.tv_nsec;
+    header.node_count = (uint32_t)nodes;
+    header.path_len = (uint32_t)path_len;
+    header.strings_size = strings_size;
+
+    disk_node_t *records = calloc(nodes ? nodes : 1, sizeof(disk_node_t));
+    char *strings = malloc(strings_size ? strings_size : 1);
+    char *entry = disk_entry_path(real_path, script->signature);
+    char *temp = entry ? malloc(strlen(entry) + 32) : NULL;
+    if (!records || !strings || !temp || !disk_make_dir()) {
+        goto out;
+    }
+    uint32_t count = 0;
+    size_t used = 0;
+    disk_encode(script->commands, records, &count, strings, &used);
+
+    snprintf(temp, strlen(entry) + 32, "%s.%ld.tmp", entry, (long)getpid());
+    int fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        goto out;
+    }
+    bool ok = write_all(fd, &header, sizeof(header)) &&
+              write_all(fd, real_path, path_len) &&
+              write_all(fd, records, nodes * sizeof(disk_node_t)) &&
+              write_all(fd, strings, strings_size);
+    ok = close(fd) == 0 && ok;
+    if (ok && rename(temp, entry) == 0) {
+        cache_stats.disk_writes++;
+    } else {
+        unlink(temp);
+    }
+
+out:
+    free(temp);
+    free(entry);
+    free(strings);
+    free(records);
+}
+
+/**
+ * @brief Decode a mapped cache file into a script
+ *
+ * @param map Mapped cache file
+ * @param len Length of the file
+ * @param script Script with path and file identity set; commands and
+ *               block are filled in
+ * @param real_path Real path of the script
+ * @return true if the file is a valid cache entry for the script
+ */
+static bool disk_decode(const char *map, size_t len, script_ast_t *script,
+                        const char *real_path) {
+    disk_header_t header;
+    if (len < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, map, sizeof(header));
+
+    char version[sizeof(header.version)] = {0};
+    strncpy(version, LUSH_VERSION_STRING, sizeof(version) - 1);
+    size_t path_len = strlen(real_path);
+    if (memcmp(header.magic, DISK_MAGIC, sizeof(DISK_MAGIC)) != 0 ||
+        header.format != DISK_FORMAT ||
+        header.byte_order != DISK_BYTE_ORDER ||
+        memcmp(header.version, version, sizeof(version)) != 0 ||
+        header.signature != script->signature ||
+        header.dev != (uint64_t)script->dev ||
+        header.ino != (uint64_t)script->ino ||
+        header.size != (int64_t)script->size ||
+        header.mtime_sec != (int64_t)script->mtime.tv_sec ||
+        header.mtime_nsec != (int64_t)script->mtime.tv_nsec ||
+        header.path_len != path_len) {
+        return false;
+    }
+
+    /* The sizes must account for the file exactly */
+    size_t rest = len - sizeof(header);
+    size_t nodes = header.node_count;
+    if (rest < path_len || (rest - path_len) / sizeof(disk_node_t) < nodes ||
+        rest - path_len - nodes * sizeof(disk_node_t) !=
+            header.strings_size) {
+        return false;
+    }
+    const char *path = map + sizeof(header);
+    if (memcmp(path, real_path, path_len) != 0) {
+        return false;
+    }
+    const char *records = path + path_len;
+    const char *strings = records + nodes * sizeof(disk_node_t);
+    size_t strings_size = (size_t)header.strings_size;
+    if (strings_size > 0 && strings[strings_size - 1] != '\0') {
+        return false;
+    }
+
+    size_t node_bytes = nodes * sizeof(node_t);
+    char *block = malloc(node_bytes + strings_size + 1);
+    if (!block) {
+        return false;
+    }
+    node_t *out = (node_t *)block;
+    char *text = block + node_bytes;
+    memcpy(text, strings, strings_size);
+
+    for (size_t i = 0; i < nodes; i++) {
+        disk_node_t rec;
+        memcpy(&rec, records + i * sizeof(disk_node_t), sizeof(rec));
+        if (rec.type > (uint32_t)NODE_ANON_FUNCTION ||
+            rec.val_type > (uint32_t)VAL_STR ||
+            rec.val_type == (uint32_t)VAL_LDOUBLE ||
+            (rec.first_child && (rec.first_child <= i + 1 ||
+                                 rec.first_child > nodes)) ||
+            (rec.next_sibling && (rec.next_sibling <= i + 1 ||
+                                  rec.next_sibling > nodes))) {
+            free(block);
+            return false;
+        }
+
+        node_t *node = &out[i];
+        memset(node, 0, sizeof(*node));
+        node->type = (node_type_t)rec.type;
+        node->val_type = (val_type_t)rec.val_type;
+        if (rec.val_type == VAL_STR || rec.val_type == 0) {
+            if (rec.val > strings_size) {
+                free(block);
+                return false;
+            }
+            node->val.str = rec.val ? text + rec.val - 1 : NULL;
+        } else {
+            memcpy(&node->val, &rec.val, sizeof(rec.val));
+        }
+        node->children = rec.children;
+        node->loc.filename = rec.has_filename ? script->path : NULL;
+        node->loc.line = rec.line;
+        node->loc.column = rec.column;
+        node->loc.offset = rec.offset;
+        node->loc.length = rec.length;
+        node->in_arena = true;
+    }
+
+    /* Links point forward only, so the decoded tree has no cycles */
+    for (size_t i = 0; i < nodes; i++) {
+        disk_node_t rec;
+        memcpy(&rec, records + i * sizeof(disk_node_t), sizeof(rec));
+        if (rec.first_child) {
+            out[i].first_child = &out[rec.first_child - 1];
+        }
+        if (rec.next_sibling) {
+            out[i].next_sibling = &out[rec.next_sibling - 1];
+            out[rec.next_sibling - 1].prev_sibling = &out[i];
+        }
+    }
+
+    script->commands = nodes > 0 ? &out[0] : NULL;
+    script->block = block;
+    return true;
+}
+
+/**
+ * @brief Load a script from the on-disk cache
+ *
+ * @param script Script with path and file identity set
+ * @param real_path Real path of the script
+ * @return true if a valid cache file was loaded
+ */
+static bool disk_load(script_ast_t *script, const char *real_path) {
+    char *entry = disk_entry_path(real_path, script->signature);
+    if (!entry) {
+        return false;
+    }
+    int fd = open(entry, O_RDONLY | O_CLOEXEC);
+    free(entry);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool ok = false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+        (size_t)st.st_size >= sizeof(disk_header_t)) {
+        size_t len = (size_t)st.st_size;
+        char *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            ok = disk_decode(map, len, script, real_path);
+            munmap(map, len);
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+script_ast_t *script_ast_load(const char *path, int flags) {
+    if (!path) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return NULL;
+    }
+
+    bool use_cache = flags & SCRIPT_CACHE_MEMORY;
+    uint64_t signature = parse_signature();
+    if (use_cache && script_cache) {
+        script_ast_t *cached = ht_get(script_cache, path);
+        if (cached && script_is_current(cached, &st, signature)) {
+            cache_stats.hits++;
+            cached->refs++;
+            close(fd);
+            return cached;
+        }
+    }
+
+    script_ast_t *script = calloc(1, sizeof(script_ast_t));
+    if (!script || !(script->path = strdup(path))) {
+        free(script);
+        close(fd);
+        return NULL;
+    }
+    script->dev = st.st_dev;
+    script->ino = st.st_ino;
+    script->size = st.st_size;
+    script->mtime = st.st_mtim;
+    script->signature = signature;
+    script->refs = 1;
+
+    char *real_path = NULL;
+    if ((flags & SCRIPT_CACHE_DISK) && disk_dir) {
+        real_path = realpath(path, NULL);
+    }
+
+    bool parsed = false;
+    if (real_path && disk_load(script, real_path)) {
+        cache_stats.disk_hits++;
+        parsed = true;
+    } else {
+        parsed = parse_script_file(fd, &st, script);
+        if (parsed && real_path) {
+            disk_store(script, real_path);
+        }
+    }
+    free(real_path);
+    close(fd);
+    if (!parsed) {
+        script_ast_unref(script);
+        return NULL;
+    }
+
+    if (!use_cache) {
+        return script;
+    }
+
+    cache_stats.misses++;
+    if (script_cache && ht_get(script_cache, path)) {
+        ht_remove(script_cache, path);
+        cache_stats.entries--;
+    }
+    if (cache_stats.entries >= SCRIPT_CACHE_MAX) {
+        script_cache_clear();
+        cache_stats.flushes++;
+    }
+    if (!script_cache) {
+        script_cache = script_cache_create();
+    }
+    if (script_cache) {
+        script->refs++;
+        ht_insert(script_cache, script->path, script);
+        cache_stats.entries++;
+    }
+    return script;
+}
+
+node_t *script_ast_commands(const script_ast_t *script) {
+    return script ? script->commands : NULL;
+}
+
+bool script_ast_mode_current(const script_ast_t *script) {
+    return script && script->signature == parse_signature();
+}
+
+off_t script_ast_command_offset(const script_ast_t *script,
+                                const node_t *command) {
+    if (!script || !command) {
+        return -1;
+    }
+
+    int fd = open(script->path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !script_matches_file(script, &st) ||
+        st.st_size == 0) {
+        close(fd);
+        return -1;
+    }
+    size_t len = (size_t)st.st_size;
+    char *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    /* Locations count bytes of the text with backslash-newline pairs
+     * removed; walk the file to find the byte they point at */
+    off_t offset = -1;
+    size_t joined = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (map[i] == '\\' && i + 1 < len && map[i + 1] == '\n') {
+            i++;
+            continue;
+        }
+        if (joined++ == command->loc.offset) {
+            offset = (off_t)i;
+            break;
+        }
+    }
+
+    munmap(map, len);
+    return offset;
+}
+
+void script_ast_release(script_ast_t *script) { script_ast_unref(script); }
+
+bool script_cache_set_disk_dir(const char *dir) {
+    char *copy = NULL;
+    if (dir && !(copy = strdup(dir))) {
+        return false;
+    }
+    free(disk_dir);
+    disk_dir = copy;
+    return true;
+}
+
+char *script_cache_default_dir(void) {
+    const char *base = getenv("XDG_CACHE_HOME");
+    const char *suffix = "/lush/ast";
+    const char *home = NULL;
+    if (!base || !base[0]) {
+        home = getenv("HOME");
+        if (!home || !home[0]) {
+            return NULL;
+        }
+        base = home;
+        suffix = "/.cache/lush/ast";
+    }
+
+    size_t len = strlen(base) + strlen(suffix) + 1;
+    char *dir = malloc(len);
+    if (dir) {
+        snprintf(dir, len, "%s%s", base, suffix);
+    }
+    return dir;
+}
+
+void script_cache_clear(void) {
+    if (script_cache) {
+        ht_destroy(script_cache);
+        script_cache = NULL;
+    }
+    cache_stats.entries = 0;
+}
+
+void script_cache_get_stats(script_cache_stats_t *stats) {
+    if (stats) {
+        *stats = cache_stats;
+    }
+}
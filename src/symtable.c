@@ -3,13 +3,13 @@
  * @brief Optimized Symbol Table Implementation for Lush Shell
  *
  * This module provides a high-performance symbol table system that leverages
- * libhashtable's ht_strstr_t interface while maintaining full POSIX shell
+ * libhashtable's generic ht_t interface while maintaining full POSIX shell
  * scoping semantics and variable metadata.
  *
  * Key Features:
- * - Uses libhashtable ht_strstr_t interface for maximum performance
+ * - Uses libhashtable ht_t with symvar_t records stored in place
  * - FNV1A hash algorithm for superior distribution vs djb2
- * - Serialized variable metadata for optimal performance
+ * - Zero-copy borrowed reads and cached integer conversions
  * - Maintains existing scope chain logic for POSIX compliance
  * - Full API compatibility with legacy implementation
  * - Automated memory management via libhashtable
@@ -55,8 +55,8 @@ static int current_lineno = 0;           // For $LINENO
 // Constants
 #define DEFAULT_HT_FLAGS (HT_STR_NONE | HT_SEED_RANDOM)
 #define MAX_SCOPE_DEPTH 256
-#define METADATA_SEPARATOR "|"
-#define METADATA_BUFFER_SIZE 64
+#define SYMVAR_MIN_VALUE_CAP 16
+#define DYNAMIC_VALUE_SIZE 32
 
 // Forward declarations
 static void cleanup_array_storage(void);
@@ -71,138 +71,133 @@ struct symtable_manager {
     symtable_scope_t *global_scope;  // Global scope reference
     size_t max_scope_level;          // Maximum nesting depth
     bool debug_mode;                 // Debug output enabled
+    char dynamic_value[DYNAMIC_VALUE_SIZE]; // Backing store for $RANDOM etc.
 };
 
 // ============================================================================
-// METADATA SERIALIZATION UTILITIES
+// VARIABLE RECORD STORAGE
 // ============================================================================
 
 /**
- * @brief Serialize variable metadata into a string format
+ * @brief Free a variable record
  *
- * Creates a serialized representation of variable data in the format:
- * "value|type|flags|scope_level" for storage in the hash table.
+ * Frees all memory associated with a symvar_t structure including
+ * the name and value strings.
  *
- * @param value Variable value (NULL treated as empty string)
- * @param type Variable type (string, integer, array, etc.)
- * @param flags Variable flags (exported, readonly, local, etc.)
- * @param scope_level Scope level where variable is defined
- * @return Allocated serialized string, or NULL on allocation failure
+ * @param var Variable structure to free (NULL is safe)
  */
-static char *serialize_variable(const char *value, symvar_type_t type,
-                                symvar_flags_t flags, size_t scope_level) {
-    if (!value) {
-        value = "";
-    }
-
-    // Calculate needed size
-    size_t value_len = strlen(value);
-    size_t total_size = value_len + METADATA_BUFFER_SIZE;
-
-    char *serialized = malloc(total_size);
-    if (!serialized) {
-        return NULL;
+static void free_symvar(symvar_t *var) {
+    if (!var) {
+        return;
     }
-
-    snprintf(serialized, total_size, "%s%s%d%s%d%s%zu", value,
-             METADATA_SEPARATOR, (int)type, METADATA_SEPARATOR, (int)flags,
-             METADATA_SEPARATOR, scope_level);
-
-    return serialized;
+    free(var->name);
+    free(var->value);
+    free(var);
 }
 
 /**
- * @brief Deserialize variable metadata from string format
+ * @brief Hash table value destructor for variable records
  *
- * Parses a serialized variable string and creates a symvar_t structure.
- * Handles empty fields correctly by parsing separators manually.
+ * Keys are borrowed from the record itself, so freeing the record
+ * releases both key and value.
  *
- * @param name Variable name to associate with the result
- * @param serialized Serialized string in "value|type|flags|scope_level" format
- * @return Allocated symvar_t structure, or NULL on failure
+ * @param val Variable record owned by the hash table
  */
-static symvar_t *deserialize_variable(const char *name,
-                                      const char *serialized) {
-    if (!serialized || !name) {
-        return NULL;
-    }
+static void symvar_ht_free(const void *val) { free_symvar((symvar_t *)val); }
+
+/**
+ * @brief Create the variable table for a scope
+ *
+ * Values are symvar_t records owned by the table. The key of each entry
+ * is the record's own name, so no separate key copy is made.
+ *
+ * @return New hash table, or NULL on allocation failure
+ */
+static ht_t *scope_vars_create(void) {
+    ht_callbacks_t callbacks = {NULL, NULL, NULL, symvar_ht_free};
+    return ht_create(fnv1a_hash_str, str_eq, &callbacks, DEFAULT_HT_FLAGS);
+}
 
-    symvar_t *var = malloc(sizeof(symvar_t));
+/**
+ * @brief Allocate an empty variable record
+ *
+ * @param name Variable name (copied)
+ * @param scope_level Scope level the record belongs to
+ * @return New record with an empty value, or NULL on allocation failure
+ */
+static symvar_t *symvar_new(const char *name, size_t scope_level) {
+    symvar_t *var = calloc(1, sizeof(symvar_t));
     if (!var) {
         return NULL;
     }
 
-    // Initialize defaults
     var->name = strdup(name);
-    var->value = NULL;
-    var->type = SYMVAR_STRING;
-    var->flags = SYMVAR_NONE;
-    var->scope_level = 0;
-    var->next = NULL;
-
-    if (!var->name) {
-        free(var);
-        return NULL;
-    }
-
-    // Parse serialized string manually to handle empty values correctly
-    char *serialized_copy = strdup(serialized);
-    if (!serialized_copy) {
-        free(var->name);
-        free(var);
+    var->value = malloc(SYMVAR_MIN_VALUE_CAP);
+    if (!var->name || !var->value) {
+        free_symvar(var);
         return NULL;
     }
 
-    // Find the separators manually to handle empty fields
-    char *pos = serialized_copy;
-    char *sep1 = strstr(pos, METADATA_SEPARATOR);
-    if (sep1) {
-        *sep1 = '\0';
-        var->value = strdup(pos);
-
-        pos = sep1 + strlen(METADATA_SEPARATOR);
-        char *sep2 = strstr(pos, METADATA_SEPARATOR);
-        if (sep2) {
-            *sep2 = '\0';
-            var->type = (symvar_type_t)atoi(pos);
+    var->value[0] = '\0';
+    var->value_cap = SYMVAR_MIN_VALUE_CAP;
+    var->type = SYMVAR_STRING;
+    var->scope_level = scope_level;
+    return var;
+}
 
-            pos = sep2 + strlen(METADATA_SEPARATOR);
-            char *sep3 = strstr(pos, METADATA_SEPARATOR);
-            if (sep3) {
-                *sep3 = '\0';
-                var->flags = (symvar_flags_t)atoi(pos);
+/**
+ * @brief Store a new value in a variable record
+ *
+ * Reuses the existing value buffer when it is large enough, so repeated
+ * assignments (loop counters, accumulators) do not allocate. The source
+ * may alias the record's current value.
+ *
+ * @param var Variable record to update
+ * @param value New value (NULL treated as empty string)
+ * @return 0 on success, -1 on allocation failure
+ */
+static int symvar_assign(symvar_t *var, const char *value) {
+    if (!value) {
+        value = "";
+    }
 
-                pos = sep3 + strlen(METADATA_SEPARATOR);
-                var->scope_level = (size_t)atoi(pos);
+    size_t len = strlen(value);
+    if (value >= var->value && value < var->value + var->value_cap) {
+        // Source lies inside our own buffer; it can only shrink
+        memmove(var->value, value, len + 1);
+    } else {
+        if (len + 1 > var->value_cap) {
+            size_t cap = var->value_cap * 2;
+            if (cap < len + 1) {
+                cap = len + 1;
+            }
+            char *grown = realloc(var->value, cap);
+            if (!grown) {
+                return -1;
             }
+            var->value = grown;
+            var->value_cap = cap;
         }
+        memcpy(var->value, value, len + 1);
     }
 
-    free(serialized_copy);
-
-    // Ensure we have a value
-    if (!var->value) {
-        var->value = strdup("");
-    }
-
-    return var;
+    var->value_len = len;
+    var->int_valid = false;
+    return 0;
 }
 
 /**
- * @brief Free a deserialized variable structure
- *
- * Frees all memory associated with a symvar_t structure including
- * the name and value strings.
+ * @brief Get the integer conversion of a record, caching the result
  *
- * @param var Variable structure to free (NULL is safe)
+ * @param var Variable record
+ * @return strtoll() conversion of the record's value
  */
-static void free_symvar(symvar_t *var) {
-    if (!var) {
-        return;
+static long long symvar_integer(symvar_t *var) {
+    if (!var->int_valid) {
+        var->int_value = strtoll(var->value, NULL, 10);
+        var->int_valid = true;
     }
-    free(var->name);
-    free(var->value);
-    free(var);
+    return var->int_value;
 }
 
 // ============================================================================
@@ -232,13 +227,13 @@ symtable_manager_t *symtable_manager_new(void) {
 
     global->scope_type = SCOPE_GLOBAL;
     global->level = 0;
-    global->vars_ht = ht_strstr_create(DEFAULT_HT_FLAGS);
+    global->vars_ht = scope_vars_create();
     global->parent = NULL;
     global->scope_name = strdup("global");
 
     if (!global->vars_ht || !global->scope_name) {
         if (global->vars_ht) {
-            ht_strstr_destroy(global->vars_ht);
+            ht_destroy(global->vars_ht);
         }
         free(global->scope_name);
         free(global);
@@ -274,7 +269,7 @@ void symtable_manager_free(symtable_manager_t *manager) {
         manager->current_scope = old_scope->parent;
 
         if (old_scope->vars_ht) {
-            ht_strstr_destroy(old_scope->vars_ht);
+            ht_destroy(old_scope->vars_ht);
         }
         free(old_scope->scope_name);
         free(old_scope);
@@ -283,7 +278,7 @@ void symtable_manager_free(symtable_manager_t *manager) {
     // Free global scope
     if (manager->global_scope) {
         if (manager->global_scope->vars_ht) {
-            ht_strstr_destroy(manager->global_scope->vars_ht);
+            ht_destroy(manager->global_scope->vars_ht);
         }
         free(manager->global_scope->scope_name);
         free(manager->global_scope);
@@ -315,7 +310,7 @@ void symtable_manager_set_debug(symtable_manager_t *manager, bool debug) {
  *
  * @param scope Starting scope for the search
  * @param name Variable name to find
- * @return Allocated symvar_t if found, NULL otherwise
+ * @return Borrowed symvar_t owned by its scope if found, NULL otherwise
  */
 static symvar_t *find_var(symtable_scope_t *scope, const char *name) {
     if (!scope || !name) {
@@ -323,13 +318,9 @@ static symvar_t *find_var(symtable_scope_t *scope, const char *name) {
     }
 
     while (scope) {
-        const char *serialized = ht_strstr_get(scope->vars_ht, name);
-        if (serialized) {
-            symvar_t *var = deserialize_variable(name, serialized);
-            if (var && !(var->flags & SYMVAR_UNSET)) {
-                return var;
-            }
-            free_symvar(var);
+        symvar_t *var = ht_get(scope->vars_ht, name);
+        if (var && !(var->flags & SYMVAR_UNSET)) {
+            return var;
         }
         scope = scope->parent;
     }
@@ -337,6 +328,39 @@ static symvar_t *find_var(symtable_scope_t *scope, const char *name) {
     return NULL;
 }
 
+/**
+ * @brief Check whether a name refers to a dynamically computed variable
+ *
+ * @param name Variable name
+ * @return True for $RANDOM, $SECONDS, $LINENO and $-
+ */
+static bool is_dynamic_var(const char *name) {
+    return strcmp(name, "RANDOM") == 0 || strcmp(name, "SECONDS") == 0 ||
+           strcmp(name, "LINENO") == 0 || strcmp(name, "-") == 0;
+}
+
+/**
+ * @brief Follow a nameref chain starting at an already-found record
+ *
+ * @param manager Symbol table manager
+ * @param name Name of the starting variable
+ * @param var Record for @p name (may be NULL)
+ * @param max_depth Maximum chain depth to follow
+ * @return Final variable name, or NULL if the chain is too deep/circular
+ */
+static const char *follow_nameref(symtable_manager_t *manager,
+                                  const char *name, symvar_t *var,
+                                  int max_depth) {
+    for (int depth = 0; depth < max_depth; depth++) {
+        if (!var || !(var->flags & SYMVAR_NAMEREF_FLAG) || !var->value[0]) {
+            return name;
+        }
+        name = var->value;
+        var = find_var(manager->current_scope, name);
+    }
+    return NULL;
+}
+
 /**
  * @brief Push a new scope onto the scope stack
  *
@@ -369,13 +393,13 @@ int symtable_push_scope(symtable_manager_t *manager, scope_type_t type,
 
     new_scope->scope_type = type;
     new_scope->level = manager->current_scope->level + 1;
-    new_scope->vars_ht = ht_strstr_create(DEFAULT_HT_FLAGS);
+    new_scope->vars_ht = scope_vars_create();
     new_scope->parent = manager->current_scope;
     new_scope->scope_name = strdup(name);
 
     if (!new_scope->vars_ht || !new_scope->scope_name) {
         if (new_scope->vars_ht) {
-            ht_strstr_destroy(new_scope->vars_ht);
+            ht_destroy(new_scope->vars_ht);
         }
         free(new_scope->scope_name);
         free(new_scope);
@@ -418,7 +442,7 @@ int symtable_pop_scope(symtable_manager_t *manager) {
                old_scope->level);
     }
 
-    ht_strstr_destroy(old_scope->vars_ht);
+    ht_destroy(old_scope->vars_ht);
     free(old_scope->scope_name);
     free(old_scope);
 
@@ -485,8 +509,9 @@ bool symtable_in_function_scope(symtable_manager_t *manager) {
 /**
  * @brief Set a variable in the current scope
  *
- * Serializes the variable data and stores it in the current scope's
- * hash table. Overwrites any existing variable with the same name.
+ * Stores the value in the current scope's record for the variable,
+ * creating the record on first assignment. An existing record is updated
+ * in place, replacing its flags and reusing its value buffer.
  *
  * @param manager Symbol table manager
  * @param name Variable name
@@ -500,17 +525,23 @@ int symtable_set_var(symtable_manager_t *manager, const char *name,
         return -1;
     }
 
-    // Serialize variable data
-    char *serialized = serialize_variable(value, SYMVAR_STRING, flags,
-                                          manager->current_scope->level);
-    if (!serialized) {
-        return -1;
+    symtable_scope_t *scope = manager->current_scope;
+    symvar_t *var = ht_get(scope->vars_ht, name);
+    if (!var) {
+        var = symvar_new(name, scope->level);
+        if (!var) {
+            return -1;
+        }
+        // The record owns its name, which doubles as the table key
+        ht_insert(scope->vars_ht, var->name, var);
     }
 
-    // Insert into current scope's hash table
-    ht_strstr_insert(manager->current_scope->vars_ht, name, serialized);
-
-    free(serialized);
+    if (symvar_assign(var, value) != 0) {
+        return -1;
+    }
+    var->type = SYMVAR_STRING;
+    var->flags = flags;
+    var->scope_level = scope->level;
 
     if (manager->debug_mode) {
         printf("DEBUG: Set variable '%s'='%s'\n", name, value ? value : "");
@@ -564,16 +595,18 @@ int symtable_set_global_var(symtable_manager_t *manager, const char *name,
 }
 
 /**
- * @brief Get a variable's value from the scope chain
+ * @brief Get a borrowed reference to a variable's value
  *
  * Searches from the current scope up through parent scopes to find
- * the variable. Returns a copy of the value that must be freed.
+ * the variable, following namerefs. Dynamic variables are formatted
+ * into a per-manager buffer. Nothing is allocated.
  *
  * @param manager Symbol table manager
  * @param name Variable name to look up
- * @return Allocated copy of value, or NULL if not found
+ * @return Borrowed value, or NULL if not found
  */
-char *symtable_get_var(symtable_manager_t *manager, const char *name) {
+const char *symtable_get_var_ref(symtable_manager_t *manager,
+                                 const char *name) {
     if (!manager || !name) {
         return NULL;
     }
@@ -587,9 +620,9 @@ char *symtable_get_var(symtable_manager_t *manager, const char *name) {
         // Simple LCG random number generator (same as bash uses)
         random_seed = random_seed * 1103515245 + 12345;
         int value = (random_seed / 65536) % 32768;
-        char buffer[16];
-        snprintf(buffer, sizeof(buffer), "%d", value);
-        return strdup(buffer);
+        snprintf(manager->dynamic_value, sizeof(manager->dynamic_value), "%d",
+                 value);
+        return manager->dynamic_value;
     }
 
     if (strcmp(name, "SECONDS") == 0) {
@@ -598,20 +631,20 @@ char *symtable_get_var(symtable_manager_t *manager, const char *name) {
             shell_start_time = time(NULL);
         }
         time_t elapsed = time(NULL) - shell_start_time;
-        char buffer[32];
-        snprintf(buffer, sizeof(buffer), "%ld", (long)elapsed);
-        return strdup(buffer);
+        snprintf(manager->dynamic_value, sizeof(manager->dynamic_value), "%ld",
+                 (long)elapsed);
+        return manager->dynamic_value;
     }
 
     if (strcmp(name, "LINENO") == 0) {
-        char buffer[16];
-        snprintf(buffer, sizeof(buffer), "%d", current_lineno);
-        return strdup(buffer);
+        snprintf(manager->dynamic_value, sizeof(manager->dynamic_value), "%d",
+                 current_lineno);
+        return manager->dynamic_value;
     }
 
     // Handle $- (current shell option flags)
     if (strcmp(name, "-") == 0) {
-        char flags[32];
+        char *flags = manager->dynamic_value;
         int pos = 0;
         if (is_interactive_shell()) flags[pos++] = 'i';
         if (shell_opts.job_control) flags[pos++] = 'm';
@@ -629,27 +662,88 @@ char *symtable_get_var(symtable_manager_t *manager, const char *name) {
         if (shell_opts.history_mode) flags[pos++] = 'H';
         if (shell_opts.histexpand_mode) flags[pos++] = 'B';
         flags[pos] = '\0';
-        return strdup(flags);
+        return flags;
     }
 
+    symvar_t *var = find_var(manager->current_scope, name);
+
     // Resolve nameref if applicable
-    const char *resolved_name = name;
-    if (symtable_is_nameref(manager, name)) {
-        const char *target = symtable_resolve_nameref(manager, name, 10);
+    if (var && (var->flags & SYMVAR_NAMEREF_FLAG)) {
+        const char *target = follow_nameref(manager, name, var, 10);
         if (target && target != name) {
-            resolved_name = target;
+            var = find_var(manager->current_scope, target);
         }
     }
 
-    symvar_t *var = find_var(manager->current_scope, resolved_name);
-    if (!var) {
-        return NULL;
+    return var ? var->value : NULL;
+}
+
+/**
+ * @brief Get a variable's value from the scope chain
+ *
+ * Searches from the current scope up through parent scopes to find
+ * the variable. Returns a copy of the value that must be freed.
+ *
+ * @param manager Symbol table manager
+ * @param name Variable name to look up
+ * @return Allocated copy of value, or NULL if not found
+ */
+char *symtable_get_var(symtable_manager_t *manager, const char *name) {
+    const char *value = symtable_get_var_ref(manager, name);
+    return value ? strdup(value) : NULL;
+}
+
+/**
+ * @brief Get a variable's value as an integer
+ *
+ * Regular variables keep the conversion cached in their record until
+ * the next assignment; dynamic variables are converted on every call.
+ *
+ * @param manager Symbol table manager
+ * @param name Variable name to look up
+ * @param out Receives the integer value when found
+ * @return True if the variable exists, false otherwise
+ */
+bool symtable_get_var_integer(symtable_manager_t *manager, const char *name,
+                              long long *out) {
+    if (!manager || !name || !out) {
+        return false;
     }
 
-    char *result = var->value ? strdup(var->value) : NULL;
-    free_symvar(var);
+    if (is_dynamic_var(name)) {
+        const char *value = symtable_get_var_ref(manager, name);
+        *out = value ? strtoll(value, NULL, 10) : 0;
+        return value != NULL;
+    }
 
-    return result;
+    symvar_t *var = find_var(manager->current_scope, name);
+    if (var && (var->flags & SYMVAR_NAMEREF_FLAG)) {
+        const char *target = follow_nameref(manager, name, var, 10);
+        if (target && target != name) {
+            var = find_var(manager->current_scope, target);
+        }
+    }
+
+    if (!var) {
+        return false;
+    }
+    *out = symvar_integer(var);
+    return true;
+}
+
+/**
+ * @brief Look up a variable record in the scope chain
+ *
+ * @param manager Symbol table manager
+ * @param name Variable name to look up
+ * @return Borrowed record, or NULL if not found
+ */
+const symvar_t *symtable_lookup_var(symtable_manager_t *manager,
+                                    const char *name) {
+    if (!manager || !name) {
+        return NULL;
+    }
+    return find_var(manager->current_scope, name);
 }
 
 /**
@@ -720,47 +814,9 @@ const char *symtable_resolve_nameref(symtable_manager_t *manager,
         return NULL;
     }
 
-    symvar_t *var = find_var(manager->current_scope, name);
-    if (!var) {
-        return name; // Not found, return original name
-    }
-
-    // Check if this is a nameref
-    if (!(var->flags & SYMVAR_NAMEREF_FLAG)) {
-        free_symvar(var);
-        return name; // Not a nameref, return original name
-    }
-
-    // Get the target name
-    const char *target = var->value;
-    if (!target || !*target) {
-        free_symvar(var);
-        return name; // No target, return original
-    }
-
-    // Make a copy since we need to free var
-    char *target_copy = strdup(target);
-    free_symvar(var);
-
-    if (!target_copy) {
-        return name;
-    }
-
-    // Recursively resolve (with depth limit)
-    const char *resolved = symtable_resolve_nameref(manager, target_copy,
-                                                    max_depth - 1);
-
-    // If resolution returns the copy, we need to keep it
-    // Otherwise, free the copy
-    if (resolved != target_copy) {
-        free(target_copy);
-        return resolved;
-    }
-
-    // The resolved name is our copy - caller shouldn't free this
-    // This is a limitation - we should use a static buffer or allocate
-    // For now, return the copy (small memory leak potential)
-    return target_copy;
+    // Targets are borrowed from the nameref records, so nothing leaks
+    return follow_nameref(manager, name, find_var(manager->current_scope, name),
+                          max_depth);
 }
 
 /**
@@ -776,13 +832,7 @@ bool symtable_is_nameref(symtable_manager_t *manager, const char *name) {
     }
 
     symvar_t *var = find_var(manager->current_scope, name);
-    if (!var) {
-        return false;
-    }
-
-    bool is_nameref = (var->flags & SYMVAR_NAMEREF_FLAG) != 0;
-    free_symvar(var);
-    return is_nameref;
+    return var && (var->flags & SYMVAR_NAMEREF_FLAG) != 0;
 }
 
 /**
@@ -799,13 +849,7 @@ symvar_flags_t symtable_get_flags(symtable_manager_t *manager,
     }
 
     symvar_t *var = find_var(manager->current_scope, name);
-    if (!var) {
-        return SYMVAR_NONE;
-    }
-
-    symvar_flags_t flags = var->flags;
-    free_symvar(var);
-    return flags;
+    return var ? var->flags : SYMVAR_NONE;
 }
 
 /**
@@ -824,17 +868,10 @@ int symtable_set_flags(symtable_manager_t *manager, const char *name,
         return -1;
     }
 
-    // Get current value
-    char *value = symtable_get_var(manager, name);
-    if (!value) {
-        // Variable doesn't exist, create it with empty value
-        value = strdup("");
-    }
-
-    // Set with new flags
-    int result = symtable_set_var(manager, name, value, flags);
-    free(value);
-    return result;
+    // Re-set the current value (or empty if unset) with the new flags;
+    // symtable_set_var handles a value borrowed from the same record
+    const char *value = symtable_get_var_ref(manager, name);
+    return symtable_set_var(manager, name, value ? value : "", flags);
 }
 
 /**
@@ -852,12 +889,7 @@ bool symtable_var_exists(symtable_manager_t *manager, const char *name) {
         return false;
     }
 
-    symvar_t *var = find_var(manager->current_scope, name);
-    if (var) {
-        free_symvar(var);
-        return true;
-    }
-    return false;
+    return find_var(manager->current_scope, name) != NULL;
 }
 
 /**
@@ -876,7 +908,7 @@ int symtable_export_var(symtable_manager_t *manager, const char *name) {
     }
 
     // Get current value
-    char *value = symtable_get_var(manager, name);
+    const char *value = symtable_get_var_ref(manager, name);
     if (!value) {
         return -1;
     }
@@ -889,8 +921,6 @@ int symtable_export_var(symtable_manager_t *manager, const char *name) {
         setenv(name, value, 1);
     }
 
-    free(value);
-
     return result;
 }
 
@@ -923,30 +953,27 @@ char **symtable_get_environ(symtable_manager_t *manager) {
     }
 
     // Iterate through all variables in the global scope
-    ht_enum_t *e = ht_strstr_enum_create(manager->global_scope->vars_ht);
+    ht_enum_t *e = ht_enum_create(manager->global_scope->vars_ht);
     if (!e) {
         free(env);
         return NULL;
     }
 
-    const char *name;
-    const char *serialized;
-    while (ht_strstr_enum_next(e, &name, &serialized)) {
-        // Deserialize to check flags
-        symvar_t *var = deserialize_variable(name, serialized);
-        if (!var) {
-            continue;
-        }
+    const void *key;
+    const void *val;
+    while (ht_enum_next(e, &key, &val)) {
+        const symvar_t *var = val;
 
         // Check if variable is exported
         if (var->flags & SYMVAR_EXPORTED) {
             // Build "name=value" string
-            size_t name_len = strlen(name);
-            size_t value_len = var->value ? strlen(var->value) : 0;
-            char *entry = malloc(name_len + 1 + value_len + 1); // name=value\0
+            size_t name_len = strlen(var->name);
+            size_t entry_size = name_len + 1 + var->value_len + 1;
+            char *entry = malloc(entry_size); // name=value\0
             if (entry) {
-                snprintf(entry, name_len + 1 + value_len + 1, "%s=%s",
-                         name, var->value ? var->value : "");
+                memcpy(entry, var->name, name_len);
+                entry[name_len] = '=';
+                memcpy(entry + name_len + 1, var->value, var->value_len + 1);
 
                 // Grow array if needed
                 if (count + 1 >= capacity) {
@@ -959,10 +986,7 @@ char **symtable_get_environ(symtable_manager_t *manager) {
                             free(env[i]);
                         }
                         free(env);
-                        free(var->name);
-                        free(var->value);
-                        free(var);
-                        ht_strstr_enum_destroy(e);
+                        ht_enum_destroy(e);
                         return NULL;
                     }
                     env = new_env;
@@ -971,14 +995,9 @@ char **symtable_get_environ(symtable_manager_t *manager) {
                 env[count++] = entry;
             }
         }
-
-        // Free the deserialized variable
-        free(var->name);
-        free(var->value);
-        free(var);
     }
 
-    ht_strstr_enum_destroy(e);
+    ht_enum_destroy(e);
 
     // NULL-terminate the array
     env[count] = NULL;
@@ -1063,26 +1082,27 @@ void symtable_dump_scope(symtable_manager_t *manager, scope_type_t scope) {
     }
 
     // Enumerate all variables in this scope's hashtable
-    ht_enum_t *enum_iter = ht_strstr_enum_create(target_scope->vars_ht);
+    ht_enum_t *enum_iter = ht_enum_create(target_scope->vars_ht);
     if (!enum_iter) {
         printf("  (enumeration failed)\n");
         return;
     }
 
-    const char *key, *value;
+    const void *key, *value;
     bool has_vars = false;
 
-    while (ht_strstr_enum_next(enum_iter, &key, &value)) {
+    while (ht_enum_next(enum_iter, &key, &value)) {
+        const symvar_t *var = value;
         has_vars = true;
-        printf("  %-12s = '%s'\n", key ? key : "(null)",
-               value ? value : "(null)");
+        printf("  %-12s = '%s' (flags 0x%x)\n", var->name, var->value,
+               (unsigned)var->flags);
     }
 
     if (!has_vars) {
         printf("  (no variables in scope)\n");
     }
 
-    ht_strstr_enum_destroy(enum_iter);
+    ht_enum_destroy(enum_iter);
 }
 
 /**
@@ -1139,24 +1159,25 @@ void symtable_dump_all_scopes(symtable_manager_t *manager) {
             printf("  (no hashtable)\n");
         } else {
             // Enumerate variables in this scope
-            ht_enum_t *enum_iter = ht_strstr_enum_create(current->vars_ht);
+            ht_enum_t *enum_iter = ht_enum_create(current->vars_ht);
             if (!enum_iter) {
                 printf("  (enumeration failed)\n");
             } else {
-                const char *key, *value;
+                const void *key, *value;
                 bool has_vars = false;
 
-                while (ht_strstr_enum_next(enum_iter, &key, &value)) {
+                while (ht_enum_next(enum_iter, &key, &value)) {
+                    const symvar_t *var = value;
                     has_vars = true;
-                    printf("  %-12s = '%s'\n", key ? key : "(null)",
-                           value ? value : "(null)");
+                    printf("  %-12s = '%s' (flags 0x%x)\n", var->name,
+                           var->value, (unsigned)var->flags);
                 }
 
                 if (!has_vars) {
                     printf("  (no variables in this scope)\n");
                 }
 
-                ht_strstr_enum_destroy(enum_iter);
+                ht_enum_destroy(enum_iter);
             }
         }
 
@@ -1439,26 +1460,26 @@ void symtable_debug_enumerate_global_vars(void (*callback)(const char *key,
     }
 
     ht_enum_t *enum_iter =
-        ht_strstr_enum_create(global_manager->global_scope->vars_ht);
+        ht_enum_create(global_manager->global_scope->vars_ht);
     if (!enum_iter) {
         return;
     }
 
-    const char *key, *value;
-    while (ht_strstr_enum_next(enum_iter, &key, &value)) {
-        callback(key, value, userdata);
+    const void *key, *value;
+    while (ht_enum_next(enum_iter, &key, &value)) {
+        const symvar_t *var = value;
+        callback(var->name, var->value, userdata);
     }
 
-    ht_strstr_enum_destroy(enum_iter);
+    ht_enum_destroy(enum_iter);
 }
 
 /**
  * @brief Enumerate global variables with clean values
  *
  * Enumerates all global shell variables and calls the callback for each one.
- * Unlike symtable_debug_enumerate_global_vars, this function deserializes
- * the stored values and returns only the actual variable value without
- * internal metadata (flags, scope level, type).
+ * Unlike symtable_debug_enumerate_global_vars, this function skips
+ * variables that are marked as unset.
  *
  * @param callback Function to call for each variable (key, value, userdata)
  * @param userdata User data to pass to the callback
@@ -1473,22 +1494,20 @@ void symtable_enumerate_global_vars(void (*callback)(const char *key,
     }
 
     ht_enum_t *enum_iter =
-        ht_strstr_enum_create(global_manager->global_scope->vars_ht);
+        ht_enum_create(global_manager->global_scope->vars_ht);
     if (!enum_iter) {
         return;
     }
 
-    const char *key, *serialized;
-    while (ht_strstr_enum_next(enum_iter, &key, &serialized)) {
-        /* Deserialize to get clean value */
-        symvar_t *var = deserialize_variable(key, serialized);
-        if (var && !(var->flags & SYMVAR_UNSET)) {
-            callback(key, var->value, userdata);
+    const void *key, *value;
+    while (ht_enum_next(enum_iter, &key, &value)) {
+        const symvar_t *var = value;
+        if (!(var->flags & SYMVAR_UNSET)) {
+            callback(var->name, var->value, userdata);
         }
-        free_symvar(var);
     }
 
-    ht_strstr_enum_destroy(enum_iter);
+    ht_enum_destroy(enum_iter);
 }
 
 /**
@@ -1781,7 +1800,8 @@ bool symtable_libht_available(void) {
  * @return Description of the symbol table implementation
  */
 const char *symtable_implementation_info(void) {
-    return "Optimized libhashtable implementation (ht_strstr_t, FNV1A hash)";
+    return "Optimized libhashtable implementation (in-place symvar_t, FNV1A "
+           "hash)";
 }
 
 /**
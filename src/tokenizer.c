@@ -36,9 +36,10 @@ static const struct {
 };
 
 // Helper functions
-static token_t *token_new(token_type_t type, const char *text, size_t length,
-                          size_t line, size_t column, size_t position);
-static void token_free(token_t *token);
+static token_t *token_new(tokenizer_t *tokenizer, token_type_t type,
+                          const char *text, size_t length, size_t line,
+                          size_t column, size_t position);
+static void token_free(tokenizer_t *tokenizer, token_t *token);
 static token_t *tokenize_next(tokenizer_t *tokenizer);
 static token_type_t classify_word(const char *text, size_t length,
                                   bool enable_keywords);
@@ -56,11 +57,23 @@ static void skip_whitespace(tokenizer_t *tokenizer);
  * @return New tokenizer instance, or NULL on failure
  */
 tokenizer_t *tokenizer_new(const char *input) {
+    return tokenizer_new_in_arena(input, NULL);
+}
+
+/**
+ * @brief Create a tokenizer whose tokens are allocated from an arena
+ *
+ * @param input Shell command string to tokenize
+ * @param arena Arena that owns the tokenizer and its tokens, or NULL
+ * @return New tokenizer instance, or NULL on failure
+ */
+tokenizer_t *tokenizer_new_in_arena(const char *input, lle_arena_t *arena) {
     if (!input) {
         return NULL;
     }
 
-    tokenizer_t *tokenizer = malloc(sizeof(tokenizer_t));
+    tokenizer_t *tokenizer = arena ? lle_arena_alloc(arena, sizeof(*tokenizer))
+                                   : malloc(sizeof(tokenizer_t));
     if (!tokenizer) {
         return NULL;
     }
@@ -74,6 +87,7 @@ tokenizer_t *tokenizer_new(const char *input) {
     tokenizer->lookahead = NULL;
     tokenizer->enable_keywords = true;
     tokenizer->arith_cmd_depth = 0;
+    tokenizer->arena = arena;
 
     // Initialize by getting the first two tokens
     tokenizer->current = tokenize_next(tokenizer);
@@ -85,20 +99,21 @@ tokenizer_t *tokenizer_new(const char *input) {
 /**
  * @brief Free a tokenizer instance
  *
- * Frees the tokenizer and any associated tokens.
+ * Frees the tokenizer and any associated tokens. Nothing is freed for
+ * an arena tokenizer; the arena owns all of it.
  *
  * @param tokenizer Tokenizer to free
  */
 void tokenizer_free(tokenizer_t *tokenizer) {
-    if (!tokenizer) {
+    if (!tokenizer || tokenizer->arena) {
         return;
     }
 
     if (tokenizer->current) {
-        token_free(tokenizer->current);
+        token_free(tokenizer, tokenizer->current);
     }
     if (tokenizer->lookahead) {
-        token_free(tokenizer->lookahead);
+        token_free(tokenizer, tokenizer->lookahead);
     }
 
     free(tokenizer);
@@ -139,7 +154,7 @@ void tokenizer_advance(tokenizer_t *tokenizer) {
 
     // Free the current token
     if (tokenizer->current) {
-        token_free(tokenizer->current);
+        token_free(tokenizer, tokenizer->current);
     }
 
     // Move lookahead to current
@@ -423,7 +438,7 @@ void tokenizer_refresh_lookahead(tokenizer_t *tokenizer) {
     size_t saved_column = tokenizer->lookahead->column;
 
     // Free the lookahead
-    token_free(tokenizer->lookahead);
+    token_free(tokenizer, tokenizer->lookahead);
 
     // Restore position to where lookahead started
     tokenizer->position = saved_position;
@@ -450,11 +465,11 @@ void tokenizer_refresh_from_position(tokenizer_t *tokenizer) {
 
     // Free existing tokens
     if (tokenizer->current) {
-        token_free(tokenizer->current);
+        token_free(tokenizer, tokenizer->current);
         tokenizer->current = NULL;
     }
     if (tokenizer->lookahead) {
-        token_free(tokenizer->lookahead);
+        token_free(tokenizer, tokenizer->lookahead);
         tokenizer->lookahead = NULL;
     }
 
@@ -468,8 +483,10 @@ void tokenizer_refresh_from_position(tokenizer_t *tokenizer) {
 /**
  * @brief Create a new token
  *
- * Allocates and initializes a token with the given properties.
+ * Allocates and initializes a token with the given properties,
+ * from the tokenizer's arena when it has one.
  *
+ * @param tokenizer Tokenizer the token belongs to (may be NULL)
  * @param type Token type
  * @param text Token text (will be copied)
  * @param length Length of text
@@ -478,8 +495,31 @@ void tokenizer_refresh_from_position(tokenizer_t *tokenizer) {
  * @param position Byte offset in input
  * @return New token, or NULL on failure
  */
-static token_t *token_new(token_type_t type, const char *text, size_t length,
-                          size_t line, size_t column, size_t position) {
+static token_t *token_new(tokenizer_t *tokenizer, token_type_t type,
+                          const char *text, size_t length, size_t line,
+                          size_t column, size_t position) {
+    // In an arena the text lives right behind the token: one bump, no free
+    if (tokenizer && tokenizer->arena) {
+        size_t text_len = text ? length : 0;
+        token_t *token =
+            lle_arena_alloc(tokenizer->arena, sizeof(token_t) + text_len + 1);
+        if (!token) {
+            return NULL;
+        }
+        token->type = type;
+        token->length = length;
+        token->line = line;
+        token->column = column;
+        token->position = position;
+        token->next = NULL;
+        token->text = (char *)(token + 1);
+        if (text_len > 0) {
+            memcpy(token->text, text, text_len);
+        }
+        token->text[text_len] = '\0';
+        return token;
+    }
+
     token_t *token = malloc(sizeof(token_t));
     if (!token) {
         return NULL;
@@ -516,10 +556,13 @@ static token_t *token_new(token_type_t type, const char *text, size_t length,
 /**
  * @brief Free a token
  *
+ * Arena tokens are left for the arena to release.
+ *
+ * @param tokenizer Tokenizer the token belongs to (may be NULL)
  * @param token Token to free
  */
-static void token_free(token_t *token) {
-    if (!token) {
+static void token_free(tokenizer_t *tokenizer, token_t *token) {
+    if (!token || (tokenizer && tokenizer->arena)) {
         return;
     }
 
@@ -648,7 +691,8 @@ static void skip_whitespace(tokenizer_t *tokenizer) {
  */
 static token_t *tokenize_next(tokenizer_t *tokenizer) {
     if (!tokenizer || tokenizer->position >= tokenizer->input_length) {
-        return token_new(TOK_EOF, NULL, 0, tokenizer ? tokenizer->line : 1,
+        return token_new(tokenizer, TOK_EOF, NULL, 0,
+                         tokenizer ? tokenizer->line : 1,
                          tokenizer ? tokenizer->column : 1,
                          tokenizer ? tokenizer->position : 0);
     }
@@ -656,8 +700,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
     skip_whitespace(tokenizer);
 
     if (tokenizer->position >= tokenizer->input_length) {
-        return token_new(TOK_EOF, NULL, 0, tokenizer->line, tokenizer->column,
-                         tokenizer->position);
+        return token_new(tokenizer, TOK_EOF, NULL, 0, tokenizer->line,
+                         tokenizer->column, tokenizer->position);
     }
 
     size_t start_pos = tokenizer->position;
@@ -670,8 +714,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
         tokenizer->position++;
         tokenizer->line++;
         tokenizer->column = 1;
-        return token_new(TOK_NEWLINE, "\n", 1, start_line, start_column,
-                         start_pos);
+        return token_new(tokenizer, TOK_NEWLINE, "\n", 1, start_line,
+                         start_column, start_pos);
     }
 
     // Handle comments
@@ -683,8 +727,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
             tokenizer->column++;
         }
         size_t length = tokenizer->position - start;
-        return token_new(TOK_COMMENT, &tokenizer->input[start], length,
-                         start_line, start_column, start_pos);
+        return token_new(tokenizer, TOK_COMMENT, &tokenizer->input[start],
+                         length, start_line, start_column, start_pos);
     }
 
     // Handle quoted strings (with adjacent quote concatenation support)
@@ -694,8 +738,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
         size_t result_capacity = 256;
         char *result = malloc(result_capacity);
         if (!result) {
-            return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                            start_line, start_column, start_pos);
+            return token_new(tokenizer, TOK_ERROR, &tokenizer->input[start_pos],
+                             1, start_line, start_column, start_pos);
         }
         size_t result_len = 0;
         bool has_expandable = false;
@@ -724,8 +768,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         char *new_result = realloc(result, result_capacity);
                         if (!new_result) {
                             free(result);
-                            return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                            start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_ERROR,
+                                             &tokenizer->input[start_pos], 1,
+                                             start_line, start_column,
+                                             start_pos);
                         }
                         result = new_result;
                     }
@@ -745,7 +791,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 }
             }
             // Unterminated single-quoted string
-            return token_new(TOK_ERROR, &tokenizer->input[start_pos],
+            return token_new(tokenizer, TOK_ERROR, &tokenizer->input[start_pos],
                              tokenizer->position - start_pos, start_line,
                              start_column, start_pos);
         }
@@ -821,8 +867,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     char *new_result = realloc(result, result_capacity);
                     if (!new_result) {
                         free(result);
-                        return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                        start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start_pos], 1,
+                                         start_line, start_column, start_pos);
                     }
                     result = new_result;
                 }
@@ -862,8 +909,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     char *new_result = realloc(result, result_capacity);
                     if (!new_result) {
                         free(result);
-                        return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                        start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start_pos], 1,
+                                         start_line, start_column, start_pos);
                     }
                     result = new_result;
                 }
@@ -888,8 +936,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         char *new_result = realloc(result, result_capacity);
                         if (!new_result) {
                             free(result);
-                            return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                            start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_ERROR,
+                                             &tokenizer->input[start_pos], 1,
+                                             start_line, start_column,
+                                             start_pos);
                         }
                         result = new_result;
                     }
@@ -905,8 +955,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         char *new_result = realloc(result, result_capacity);
                         if (!new_result) {
                             free(result);
-                            return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                            start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_ERROR,
+                                             &tokenizer->input[start_pos], 1,
+                                             start_line, start_column,
+                                             start_pos);
                         }
                         result = new_result;
                     }
@@ -922,8 +974,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     char *new_result = realloc(result, result_capacity);
                     if (!new_result) {
                         free(result);
-                        return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                        start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start_pos], 1,
+                                         start_line, start_column, start_pos);
                     }
                     result = new_result;
                 }
@@ -938,8 +991,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     char *new_result = realloc(result, result_capacity);
                     if (!new_result) {
                         free(result);
-                        return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                        start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start_pos], 1,
+                                         start_line, start_column, start_pos);
                     }
                     result = new_result;
                 }
@@ -950,7 +1004,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
         }
 
         // Unterminated double-quoted string
-        return token_new(TOK_ERROR, &tokenizer->input[start_pos],
+        return token_new(tokenizer, TOK_ERROR, &tokenizer->input[start_pos],
                          tokenizer->position - start_pos, start_line,
                          start_column, start_pos);
                          
@@ -973,8 +1027,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     char *new_result = realloc(result, result_capacity);
                     if (!new_result) {
                         free(result);
-                        return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                        start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start_pos], 1,
+                                         start_line, start_column, start_pos);
                     }
                     result = new_result;
                 }
@@ -1006,8 +1061,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         char *new_result = realloc(result, result_capacity);
                         if (!new_result) {
                             free(result);
-                            return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1,
-                                            start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_ERROR,
+                                             &tokenizer->input[start_pos], 1,
+                                             start_line, start_column,
+                                             start_pos);
                         }
                         result = new_result;
                     }
@@ -1037,7 +1094,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
         // No more adjacent content - return the complete token
         result[result_len] = '\0';
         token_type_t type = has_expandable ? TOK_EXPANDABLE_STRING : TOK_STRING;
-        token_t *tok = token_new(type, result, result_len,
+        token_t *tok = token_new(tokenizer, type, result, result_len,
                          start_line, start_column, start_pos);
         free(result);
         return tok;
@@ -1082,15 +1139,15 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     // Check for unclosed arithmetic expansion
                     if (paren_count > 0) {
                         size_t length = tokenizer->position - start;
-                        return token_new(TOK_ERROR, &tokenizer->input[start],
-                                         length, start_line, start_column,
-                                         start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start], length,
+                                         start_line, start_column, start_pos);
                     }
 
                     size_t length = tokenizer->position - start;
-                    return token_new(TOK_ARITH_EXP, &tokenizer->input[start],
-                                     length, start_line, start_column,
-                                     start_pos);
+                    return token_new(tokenizer, TOK_ARITH_EXP,
+                                     &tokenizer->input[start], length,
+                                     start_line, start_column, start_pos);
                 } else {
                     // Command substitution $(cmd)
                     int paren_count = 1;
@@ -1112,15 +1169,15 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     // Check for unclosed command substitution
                     if (paren_count > 0) {
                         size_t length = tokenizer->position - start;
-                        return token_new(TOK_ERROR, &tokenizer->input[start],
-                                         length, start_line, start_column,
-                                         start_pos);
+                        return token_new(tokenizer, TOK_ERROR,
+                                         &tokenizer->input[start], length,
+                                         start_line, start_column, start_pos);
                     }
 
                     size_t length = tokenizer->position - start;
-                    return token_new(TOK_COMMAND_SUB, &tokenizer->input[start],
-                                     length, start_line, start_column,
-                                     start_pos);
+                    return token_new(tokenizer, TOK_COMMAND_SUB,
+                                     &tokenizer->input[start], length,
+                                     start_line, start_column, start_pos);
                 }
             } else if (next == '\'') {
                 // ANSI-C quoting $'...'
@@ -1151,8 +1208,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 }
                 
                 size_t length = tokenizer->position - start;
-                return token_new(TOK_STRING, &tokenizer->input[start],
-                                 length, start_line, start_column, start_pos);
+                return token_new(tokenizer, TOK_STRING,
+                                 &tokenizer->input[start], length, start_line,
+                                 start_column, start_pos);
             } else if (next == '{') {
                 // Parameter expansion ${var} with proper nested brace handling
                 tokenizer->position++;
@@ -1179,8 +1237,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 }
 
                 size_t length = tokenizer->position - start;
-                return token_new(TOK_VARIABLE, &tokenizer->input[start], length,
-                                 start_line, start_column, start_pos);
+                return token_new(tokenizer, TOK_VARIABLE,
+                                 &tokenizer->input[start], length, start_line,
+                                 start_column, start_pos);
             } else if (isalnum(next) || next == '_' || next == '?' ||
                        next == '$' || next == '!' || next == '@' ||
                        next == '*' || next == '#' || next == '-') {
@@ -1207,15 +1266,16 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 }
 
                 size_t length = tokenizer->position - start;
-                return token_new(TOK_VARIABLE, &tokenizer->input[start], length,
-                                 start_line, start_column, start_pos);
+                return token_new(tokenizer, TOK_VARIABLE,
+                                 &tokenizer->input[start], length, start_line,
+                                 start_column, start_pos);
             }
         }
 
         // Just a plain $ - treat as word
         size_t length = tokenizer->position - start;
-        return token_new(TOK_WORD, &tokenizer->input[start], length, start_line,
-                         start_column, start_pos);
+        return token_new(tokenizer, TOK_WORD, &tokenizer->input[start], length,
+                         start_line, start_column, start_pos);
     }
 
     // Handle backtick command substitution
@@ -1240,13 +1300,13 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
         } else {
             // Unclosed backtick - return error token
             size_t length = tokenizer->position - start;
-            return token_new(TOK_ERROR, &tokenizer->input[start], length,
-                             start_line, start_column, start_pos);
+            return token_new(tokenizer, TOK_ERROR, &tokenizer->input[start],
+                             length, start_line, start_column, start_pos);
         }
 
         size_t length = tokenizer->position - start;
-        return token_new(TOK_BACKQUOTE, &tokenizer->input[start], length,
-                         start_line, start_column, start_pos);
+        return token_new(tokenizer, TOK_BACKQUOTE, &tokenizer->input[start],
+                         length, start_line, start_column, start_pos);
     }
 
     // Handle operators
@@ -1259,22 +1319,22 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 tokenizer->input[tokenizer->position + 2] == '&') {
                 tokenizer->position += 3;
                 tokenizer->column += 3;
-                return token_new(TOK_CASE_CONTINUE, ";;&", 3, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_CASE_CONTINUE, ";;&", 3,
+                                 start_line, start_column, start_pos);
             }
             // Check for ;& (case fall-through - execute next without test)
             if (tokenizer->position + 1 < tokenizer->input_length &&
                 tokenizer->input[tokenizer->position + 1] == '&') {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
-                return token_new(TOK_CASE_FALLTHROUGH, ";&", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_CASE_FALLTHROUGH, ";&", 2,
+                                 start_line, start_column, start_pos);
             }
             // Regular semicolon
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_SEMICOLON, ";", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_SEMICOLON, ";", 1, start_line,
+                             start_column, start_pos);
 
         case '|':
             if (tokenizer->position + 1 < tokenizer->input_length) {
@@ -1282,22 +1342,22 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 if (next == '|') {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_LOGICAL_OR, "||", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_LOGICAL_OR, "||", 2,
+                                     start_line, start_column, start_pos);
                 }
                 // Pipe stderr |& (shorthand for 2>&1 |)
                 if (next == '&' &&
                     shell_mode_allows(FEATURE_PROCESS_SUBSTITUTION)) {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_PIPE_STDERR, "|&", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_PIPE_STDERR, "|&", 2,
+                                     start_line, start_column, start_pos);
                 }
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_PIPE, "|", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_PIPE, "|", 1, start_line,
+                             start_column, start_pos);
 
         case '&':
             if (tokenizer->position + 1 < tokenizer->input_length) {
@@ -1305,8 +1365,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 if (next == '&') {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_LOGICAL_AND, "&&", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_LOGICAL_AND, "&&", 2,
+                                     start_line, start_column, start_pos);
                 } else if (next == '>') {
                     // Check for &>> (append both stdout and stderr)
                     if (tokenizer->position + 2 < tokenizer->input_length &&
@@ -1314,19 +1374,19 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         shell_mode_allows(FEATURE_PROCESS_SUBSTITUTION)) {
                         tokenizer->position += 3;
                         tokenizer->column += 3;
-                        return token_new(TOK_APPEND_BOTH, "&>>", 3, start_line,
-                                         start_column, start_pos);
+                        return token_new(tokenizer, TOK_APPEND_BOTH, "&>>", 3,
+                                         start_line, start_column, start_pos);
                     }
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_REDIRECT_BOTH, "&>", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_REDIRECT_BOTH, "&>", 2,
+                                     start_line, start_column, start_pos);
                 }
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_AND, "&", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_AND, "&", 1, start_line,
+                             start_column, start_pos);
 
         case '<':
             if (tokenizer->position + 1 < tokenizer->input_length) {
@@ -1336,29 +1396,29 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     shell_mode_allows(FEATURE_PROCESS_SUBSTITUTION)) {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_PROC_SUB_IN, "<(", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_PROC_SUB_IN, "<(", 2,
+                                     start_line, start_column, start_pos);
                 }
                 if (next == '<') {
                     if (tokenizer->position + 2 < tokenizer->input_length &&
                         tokenizer->input[tokenizer->position + 2] == '<') {
                         tokenizer->position += 3;
                         tokenizer->column += 3;
-                        return token_new(TOK_HERESTRING, "<<<", 3, start_line,
-                                         start_column, start_pos);
+                        return token_new(tokenizer, TOK_HERESTRING, "<<<", 3,
+                                         start_line, start_column, start_pos);
                     } else if (tokenizer->position + 2 <
                                    tokenizer->input_length &&
                                tokenizer->input[tokenizer->position + 2] ==
                                    '-') {
                         tokenizer->position += 3;
                         tokenizer->column += 3;
-                        return token_new(TOK_HEREDOC_STRIP, "<<-", 3,
+                        return token_new(tokenizer, TOK_HEREDOC_STRIP, "<<-", 3,
                                          start_line, start_column, start_pos);
                     } else {
                         tokenizer->position += 2;
                         tokenizer->column += 2;
-                        return token_new(TOK_HEREDOC, "<<", 2, start_line,
-                                         start_column, start_pos);
+                        return token_new(tokenizer, TOK_HEREDOC, "<<", 2,
+                                         start_line, start_column, start_pos);
                     }
                 }
                 // Handle <&N, <&-, <&$VAR patterns (input fd duplication)
@@ -1369,8 +1429,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     if (isdigit(fd_char) || fd_char == '-') {
                         tokenizer->position += 3;
                         tokenizer->column += 3;
-                        return token_new(TOK_REDIRECT_FD, &tokenizer->input[start_pos],
-                                         3, start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_REDIRECT_FD,
+                                         &tokenizer->input[start_pos], 3,
+                                         start_line, start_column, start_pos);
                     }
                     // Handle <&$VAR or <&${VAR} patterns
                     if (fd_char == '$') {
@@ -1397,15 +1458,16 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         size_t length = fd_pos - start_pos;
                         tokenizer->position = fd_pos;
                         tokenizer->column += length;
-                        return token_new(TOK_REDIRECT_FD, &tokenizer->input[start_pos],
-                                         length, start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_REDIRECT_FD,
+                                         &tokenizer->input[start_pos], length,
+                                         start_line, start_column, start_pos);
                     }
                 }
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_REDIRECT_IN, "<", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_REDIRECT_IN, "<", 1, start_line,
+                             start_column, start_pos);
 
         case '>':
             if (tokenizer->position + 1 < tokenizer->input_length) {
@@ -1415,20 +1477,20 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     shell_mode_allows(FEATURE_PROCESS_SUBSTITUTION)) {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_PROC_SUB_OUT, ">(", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_PROC_SUB_OUT, ">(", 2,
+                                     start_line, start_column, start_pos);
                 }
                 if (next == '>') {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_APPEND, ">>", 2, start_line, start_column,
-                                     start_pos);
+                    return token_new(tokenizer, TOK_APPEND, ">>", 2, start_line,
+                                     start_column, start_pos);
                 }
                 if (next == '|') {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
-                    return token_new(TOK_REDIRECT_CLOBBER, ">|", 2, start_line,
-                                     start_column, start_pos);
+                    return token_new(tokenizer, TOK_REDIRECT_CLOBBER, ">|", 2,
+                                     start_line, start_column, start_pos);
                 }
                 if (next == '&' &&
                     tokenizer->position + 2 < tokenizer->input_length) {
@@ -1438,8 +1500,9 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     if (isdigit(fd_char) || fd_char == '-') {
                         tokenizer->position += 3;
                         tokenizer->column += 3;
-                        return token_new(TOK_REDIRECT_FD, &tokenizer->input[start_pos],
-                                         3, start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_REDIRECT_FD,
+                                         &tokenizer->input[start_pos], 3,
+                                         start_line, start_column, start_pos);
                     }
                     // Handle >&$VAR or >&${VAR} patterns
                     if (fd_char == '$') {
@@ -1466,14 +1529,15 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                         size_t length = fd_pos - start_pos;
                         tokenizer->position = fd_pos;
                         tokenizer->column += length;
-                        return token_new(TOK_REDIRECT_FD, &tokenizer->input[start_pos],
-                                         length, start_line, start_column, start_pos);
+                        return token_new(tokenizer, TOK_REDIRECT_FD,
+                                         &tokenizer->input[start_pos], length,
+                                         start_line, start_column, start_pos);
                     }
                 }
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_REDIRECT_OUT, ">", 1, start_line,
+            return token_new(tokenizer, TOK_REDIRECT_OUT, ">", 1, start_line,
                              start_column, start_pos);
 
         case '=':
@@ -1483,20 +1547,20 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 shell_mode_allows(FEATURE_REGEX_MATCH)) {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
-                return token_new(TOK_REGEX_MATCH, "=~", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_REGEX_MATCH, "=~", 2,
+                                 start_line, start_column, start_pos);
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_ASSIGN, "=", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_ASSIGN, "=", 1, start_line,
+                             start_column, start_pos);
 
         case '!':
             if (tokenizer->position + 1 < tokenizer->input_length &&
                 tokenizer->input[tokenizer->position + 1] == '=') {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
-                return token_new(TOK_NOT_EQUAL, "!=", 2, start_line,
+                return token_new(tokenizer, TOK_NOT_EQUAL, "!=", 2, start_line,
                                  start_column, start_pos);
             }
             // Check for extglob !(pattern)
@@ -1509,8 +1573,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
             // Standalone ! character (for test negation)
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_WORD, "!", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_WORD, "!", 1, start_line,
+                             start_column, start_pos);
 
         case '+':
             // Check for += (append/add assignment)
@@ -1519,8 +1583,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 shell_mode_allows(FEATURE_INDEXED_ARRAYS)) {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
-                return token_new(TOK_PLUS_ASSIGN, "+=", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_PLUS_ASSIGN, "+=", 2,
+                                 start_line, start_column, start_pos);
             }
             // Let + be handled as part of words (e.g., date +%Y)
             // Fall through to word tokenization
@@ -1529,13 +1593,13 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
         case '-':
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_MINUS, "-", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_MINUS, "-", 1, start_line,
+                             start_column, start_pos);
 
             // case '*':
             //     tokenizer->position++;
             //     tokenizer->column++;
-            //     return token_new(TOK_MULTIPLY, "*", 1, start_line,
+            //     return token_new(tokenizer, TOK_MULTIPLY, "*", 1, start_line,
             //     start_column,
             //                      start_pos);
 
@@ -1547,7 +1611,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
             // case '?':
             //     tokenizer->position++;
             //     tokenizer->column++;
-            //     return token_new(TOK_QUESTION, "?", 1, start_line,
+            //     return token_new(tokenizer, TOK_QUESTION, "?", 1, start_line,
             //     start_column,
             //                      start_pos);
 
@@ -1559,8 +1623,8 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
                 tokenizer->arith_cmd_depth++;  // Track arithmetic context
-                return token_new(TOK_DOUBLE_LPAREN, "((", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_DOUBLE_LPAREN, "((", 2,
+                                 start_line, start_column, start_pos);
             }
             // Check for zsh-style glob alternation: (a|b)suffix
             // This is a word, not a subshell, when:
@@ -1616,16 +1680,18 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                             
                             size_t word_len = tokenizer->position - word_start;
                             // token_new copies the text, so pass input directly
-                            return token_new(TOK_WORD, &tokenizer->input[word_start], word_len,
-                                           start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_WORD,
+                                             &tokenizer->input[word_start],
+                                             word_len, start_line, start_column,
+                                             start_pos);
                         }
                     }
                 }
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_LPAREN, "(", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_LPAREN, "(", 1, start_line,
+                             start_column, start_pos);
 
         case ')':
             // Check for )) arithmetic command end - only when inside (( ))
@@ -1639,13 +1705,13 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
                 tokenizer->arith_cmd_depth--;  // Leaving arithmetic context
-                return token_new(TOK_DOUBLE_RPAREN, "))", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_DOUBLE_RPAREN, "))", 2,
+                                 start_line, start_column, start_pos);
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_RPAREN, ")", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_RPAREN, ")", 1, start_line,
+                             start_column, start_pos);
 
         case '{':
             // Check for {varname} fd allocation syntax (bash 4.1+/zsh)
@@ -1687,7 +1753,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                                 }
                                 size_t length = tok_end - tokenizer->position;
                                 token_t *tok = token_new(
-                                    TOK_REDIRECT_FD_ALLOC,
+                                    tokenizer, TOK_REDIRECT_FD_ALLOC,
                                     &tokenizer->input[tokenizer->position],
                                     length, start_line, start_column, start_pos);
                                 tokenizer->position = tok_end;
@@ -1785,10 +1851,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     
                     size_t total_len = scan_pos - tokenizer->position;
                     
-                    token_t *tok = token_new(TOK_WORD, 
+                    token_t *tok = token_new(tokenizer, TOK_WORD,
                                              &tokenizer->input[tokenizer->position],
-                                             total_len, start_line, start_column, 
-                                             start_pos);
+                                             total_len, start_line,
+                                             start_column, start_pos);
                     tokenizer->position = scan_pos;
                     tokenizer->column += total_len;
                     return tok;
@@ -1797,14 +1863,14 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
             // Not a brace expansion - return as command group brace
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_LBRACE, "{", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_LBRACE, "{", 1, start_line,
+                             start_column, start_pos);
 
         case '}':
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_RBRACE, "}", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_RBRACE, "}", 1, start_line,
+                             start_column, start_pos);
 
         case '[':
             // Check for [[ extended test
@@ -1813,13 +1879,13 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 shell_mode_allows(FEATURE_EXTENDED_TEST)) {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
-                return token_new(TOK_DOUBLE_LBRACKET, "[[", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_DOUBLE_LBRACKET, "[[", 2,
+                                 start_line, start_column, start_pos);
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_LBRACKET, "[", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_LBRACKET, "[", 1, start_line,
+                             start_column, start_pos);
 
         case ']':
             // Check for ]] extended test end
@@ -1828,13 +1894,13 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                 shell_mode_allows(FEATURE_EXTENDED_TEST)) {
                 tokenizer->position += 2;
                 tokenizer->column += 2;
-                return token_new(TOK_DOUBLE_RBRACKET, "]]", 2, start_line,
-                                 start_column, start_pos);
+                return token_new(tokenizer, TOK_DOUBLE_RBRACKET, "]]", 2,
+                                 start_line, start_column, start_pos);
             }
             tokenizer->position++;
             tokenizer->column++;
-            return token_new(TOK_RBRACKET, "]", 1, start_line, start_column,
-                             start_pos);
+            return token_new(tokenizer, TOK_RBRACKET, "]", 1, start_line,
+                             start_column, start_pos);
         }
     }
 
@@ -1857,7 +1923,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     tokenizer->position += 2;
                     tokenizer->column += 2;
                     size_t length = tokenizer->position - num_start;
-                    return token_new(TOK_APPEND_ERR,
+                    return token_new(tokenizer, TOK_APPEND_ERR,
                                      &tokenizer->input[num_start], length,
                                      start_line, start_column, start_pos);
                 } else if (tokenizer->position + 1 < tokenizer->input_length &&
@@ -1869,9 +1935,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                             tokenizer->position += 3; // Skip >&M or >&-
                             tokenizer->column += 3;
                             size_t length = tokenizer->position - num_start;
-                            return token_new(TOK_REDIRECT_FD,
-                                             &tokenizer->input[num_start], length,
-                                             start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_REDIRECT_FD,
+                                             &tokenizer->input[num_start],
+                                             length, start_line, start_column,
+                                             start_pos);
                         }
                         // Handle N>&$VAR or N>&${VAR} patterns
                         if (fd_char == '$') {
@@ -1897,9 +1964,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                             size_t length = fd_pos - num_start;
                             tokenizer->position = fd_pos;
                             tokenizer->column += length;
-                            return token_new(TOK_REDIRECT_FD,
-                                             &tokenizer->input[num_start], length,
-                                             start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_REDIRECT_FD,
+                                             &tokenizer->input[num_start],
+                                             length, start_line, start_column,
+                                             start_pos);
                         }
                     }
                 } else {
@@ -1907,7 +1975,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     tokenizer->position++;
                     tokenizer->column++;
                     size_t length = tokenizer->position - num_start;
-                    return token_new(TOK_REDIRECT_ERR,
+                    return token_new(tokenizer, TOK_REDIRECT_ERR,
                                      &tokenizer->input[num_start], length,
                                      start_line, start_column, start_pos);
                 }
@@ -1922,9 +1990,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                             tokenizer->position += 3; // Skip <&M or <&-
                             tokenizer->column += 3;
                             size_t length = tokenizer->position - num_start;
-                            return token_new(TOK_REDIRECT_FD,
-                                             &tokenizer->input[num_start], length,
-                                             start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_REDIRECT_FD,
+                                             &tokenizer->input[num_start],
+                                             length, start_line, start_column,
+                                             start_pos);
                         }
                         // Handle N<&$VAR or N<&${VAR} patterns
                         if (fd_char == '$') {
@@ -1950,9 +2019,10 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                             size_t length = fd_pos - num_start;
                             tokenizer->position = fd_pos;
                             tokenizer->column += length;
-                            return token_new(TOK_REDIRECT_FD,
-                                             &tokenizer->input[num_start], length,
-                                             start_line, start_column, start_pos);
+                            return token_new(tokenizer, TOK_REDIRECT_FD,
+                                             &tokenizer->input[num_start],
+                                             length, start_line, start_column,
+                                             start_pos);
                         }
                     }
                 } else {
@@ -1960,7 +2030,7 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                     tokenizer->position++;
                     tokenizer->column++;
                     size_t length = tokenizer->position - num_start;
-                    return token_new(TOK_REDIRECT_IN_FD,
+                    return token_new(tokenizer, TOK_REDIRECT_IN_FD,
                                      &tokenizer->input[num_start], length,
                                      start_line, start_column, start_pos);
                 }
@@ -2332,13 +2402,13 @@ static token_t *tokenize_next(tokenizer_t *tokenizer) {
                        : classify_word(&tokenizer->input[start], length,
                                        tokenizer->enable_keywords);
 
-        return token_new(type, &tokenizer->input[start], length, start_line,
-                         start_column, start_pos);
+        return token_new(tokenizer, type, &tokenizer->input[start], length,
+                         start_line, start_column, start_pos);
     }
 
     // Unknown character - treat as error
     tokenizer->position++;
     tokenizer->column++;
-    return token_new(TOK_ERROR, &tokenizer->input[start_pos], 1, start_line,
-                     start_column, start_pos);
+    return token_new(tokenizer, TOK_ERROR, &tokenizer->input[start_pos], 1,
+                     start_line, start_column, start_pos);
 }
@@ -0,0 +1,285 @@
+/**
+ * @file globstar_benchmark.c
+ * @brief Benchmark for recursive ** expansion on a synthetic tree
+ *
+ * Builds a directory tree (FANOUT subdirectories per level, DEPTH levels,
+ * FILES files per directory) and expands ** patterns over it with:
+ * - Legacy: the previous walker, which built PATH_MAX paths, called
+ *   stat() on every entry and ran glob(3) on "<entry>/<suffix>" for
+ *   every entry it saw
+ * - Serial: globstar_walk() on the calling thread only
+ * - Parallel: globstar_walk() with the worker pool
+ *
+ * Usage: benchmark_globstar [fanout] [depth] [files]
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "globstar.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <glob.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_FANOUT 12
+#define DEFAULT_DEPTH 3
+#define DEFAULT_FILES 20
+#define ROUNDS 3
+
+/* Helper to get nanoseconds */
+static uint64_t get_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ============================================================================
+ * SYNTHETIC TREE
+ * ============================================================================
+ */
+
+static unsigned long tree_dirs = 0;
+static unsigned long tree_files = 0;
+
+static void build_level(const char *dir, int depth, int fanout, int files) {
+    char path[PATH_MAX];
+    for (int i = 0; i < files; i++) {
+        snprintf(path, sizeof(path), "%s/file%02d.%s", dir, i,
+                 i % 4 == 0 ? "c" : "txt");
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            close(fd);
+            tree_files++;
+        }
+    }
+    if (depth == 0) {
+        return;
+    }
+    for (int i = 0; i < fanout; i++) {
+        snprintf(path, sizeof(path), "%s/dir%02d", dir, i);
+        if (mkdir(path, 0755) == 0) {
+            tree_dirs++;
+            build_level(path, depth - 1, fanout, files);
+        }
+    }
+}
+
+static int remove_entry(const char *path, const struct stat *st, int flag,
+                        struct FTW *ftw) {
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    return remove(path);
+}
+
+/* ============================================================================
+ * LEGACY WALKER (reference implementation)
+ * ============================================================================
+ */
+
+static void legacy_add(char ***results, int *count, int *capacity,
+                       const char *path) {
+    if (*count >= *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 32;
+        *results = realloc(*results, *capacity * sizeof(char *));
+    }
+    (*results)[(*count)++] = strdup(path);
+}
+
+/* Mirrors the removed expand_globstar_recursive() */
+static void legacy_recursive(const char *base_dir, const char *remaining,
+                             char ***results, int *count, int *capacity) {
+    DIR *dir = opendir(base_dir[0] ? base_dir : ".");
+    if (!dir) {
+        return;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 ||
+            strcmp(entry->d_name, "..") == 0 || entry->d_name[0] == '.') {
+            continue;
+        }
+
+        char full_path[PATH_MAX];
+        if (base_dir[0]) {
+            snprintf(full_path, sizeof(full_path), "%s/%s", base_dir,
+                     entry->d_name);
+        } else {
+            snprintf(full_path, sizeof(full_path), "%s", entry->d_name);
+        }
+
+        if (remaining && remaining[0]) {
+            char candidate[PATH_MAX];
+            int written = snprintf(candidate, sizeof(candidate), "%s/%s",
+                                   full_path, remaining);
+            if (written < 0 || (size_t)written >= sizeof(candidate)) {
+                continue;
+            }
+            glob_t globbuf;
+            if (glob(candidate, GLOB_NOSORT, NULL, &globbuf) == 0) {
+                for (size_t i = 0; i < globbuf.gl_pathc; i++) {
+                    legacy_add(results, count, capacity, globbuf.gl_pathv[i]);
+                }
+                globfree(&globbuf);
+            }
+        } else {
+            legacy_add(results, count, capacity, full_path);
+        }
+
+        struct stat st;
+        if (stat(full_path, &st) == 0 && S_ISDIR(st.st_mode)) {
+            legacy_recursive(full_path, remaining, results, count, capacity);
+        }
+    }
+    closedir(dir);
+}
+
+/* Mirrors the removed expand_globstar_pattern(): prefix, then ** then suffix */
+static int legacy_expand(const char *prefix, const char *suffix) {
+    char **results = NULL;
+    int count = 0;
+    int capacity = 0;
+
+    if (suffix[0]) {
+        char candidate[PATH_MAX];
+        snprintf(candidate, sizeof(candidate), "%s/%s", prefix, suffix);
+        glob_t globbuf;
+        if (glob(candidate, GLOB_NOSORT, NULL, &globbuf) == 0) {
+            for (size_t i = 0; i < globbuf.gl_pathc; i++) {
+                legacy_add(&results, &count, &capacity, globbuf.gl_pathv[i]);
+            }
+            globfree(&globbuf);
+        }
+    }
+    legacy_recursive(prefix, suffix[0] ? suffix : NULL, &results, &count,
+                     &capacity);
+
+    for (int i = 0; i < count; i++) {
+        free(results[i]);
+    }
+    free(results);
+    return count;
+}
+
+/* ============================================================================
+ * NEW WALKER
+ * ============================================================================
+ */
+
+static int count_match(const char *path, void *ctx) {
+    (void)path;
+    (*(unsigned long *)ctx)++;
+    return 0;
+}
+
+static unsigned long walk(const char *pattern, int workers,
+                          globstar_stats_t *stats) {
+    unsigned long count = 0;
+    globstar_options_t options = {0, false, workers};
+    globstar_walk(pattern, &options, count_match, &count, stats);
+    return count;
+}
+
+/* ============================================================================
+ * BENCHMARK
+ * ============================================================================
+ */
+
+static double best_ms(uint64_t *samples) {
+    uint64_t best = samples[0];
+    for (int i = 1; i < ROUNDS; i++) {
+        if (samples[i] < best) {
+            best = samples[i];
+        }
+    }
+    return best / 1e6;
+}
+
+static void run_case(const char *label, const char *suffix) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "tree/**%s%s", suffix[0] ? "/" : "",
+             suffix);
+
+    uint64_t legacy[ROUNDS], serial[ROUNDS], parallel[ROUNDS];
+    int legacy_count = 0;
+    unsigned long serial_count = 0, parallel_count = 0;
+    globstar_stats_t serial_stats, parallel_stats;
+
+    for (int r = 0; r < ROUNDS; r++) {
+        uint64_t start = get_nanos();
+        legacy_count = legacy_expand("tree", suffix);
+        legacy[r] = get_nanos() - start;
+
+        start = get_nanos();
+        serial_count = walk(pattern, 1, &serial_stats);
+        serial[r] = get_nanos() - start;
+
+        start = get_nanos();
+        parallel_count = walk(pattern, GLOBSTAR_MAX_WORKERS, &parallel_stats);
+        parallel[r] = get_nanos() - start;
+    }
+
+    double legacy_ms = best_ms(legacy);
+    double serial_ms = best_ms(serial);
+    double parallel_ms = best_ms(parallel);
+
+    printf("\n%s (%s):\n", label, pattern);
+    printf("  Legacy:   %9.2f ms  %7d matches\n", legacy_ms, legacy_count);
+    printf("  Serial:   %9.2f ms  %7lu matches  %.1fx  (%lu stat calls)\n",
+           serial_ms, serial_count, legacy_ms / serial_ms,
+           serial_stats.stat_calls);
+    printf("  Parallel: %9.2f ms  %7lu matches  %.1fx  (%u workers)\n",
+           parallel_ms, parallel_count, legacy_ms / parallel_ms,
+           parallel_stats.workers);
+
+    if (serial_count != (unsigned long)legacy_count ||
+        parallel_count != serial_count) {
+        printf("  WARNING: match counts differ\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    int fanout = argc > 1 ? atoi(argv[1]) : DEFAULT_FANOUT;
+    int depth = argc > 2 ? atoi(argv[2]) : DEFAULT_DEPTH;
+    int files = argc > 3 ? atoi(argv[3]) : DEFAULT_FILES;
+
+    char root[] = "/tmp/lush_globstar_bench_XXXXXX";
+    if (!mkdtemp(root) || chdir(root) != 0 || mkdir("tree", 0755) != 0) {
+        perror("setup");
+        return 1;
+    }
+
+    printf("========================================\n");
+    printf("Globstar Expansion Benchmark\n");
+    printf("========================================\n");
+
+    uint64_t start = get_nanos();
+    build_level("tree", depth, fanout, files);
+    printf("Tree: %lu directories, %lu files (built in %.0f ms)\n", tree_dirs,
+           tree_files, (get_nanos() - start) / 1e6);
+    printf("Best of %d rounds, warm cache\n", ROUNDS);
+
+    run_case("Files by suffix", "*.c");
+    run_case("Everything", "");
+    run_case("Nested literal", "dir03/*.txt");
+
+    if (chdir("/") == 0) {
+        nftw(root, remove_entry, 64, FTW_DEPTH | FTW_PHYS);
+    }
+
+    printf("\n========================================\n");
+    return 0;
+}
@@ -0,0 +1,381 @@
+/**
+ * @file hashtable_benchmark.c
+ * @brief Micro-benchmark for the libhashtable string table
+ *
+ * Compares the open-addressing table behind ht_strstr_t against the
+ * previous design: separate chaining with the first node embedded in
+ * the bucket array, an index taken modulo the capacity, no stored hash
+ * (every probe compares keys with strcmp), one calloc per chained node
+ * and a rehash that re-hashes every key. The legacy table is reproduced
+ * here so both run against the same workload:
+ * - Insert: build a table of N keys from empty
+ * - Hit: look up every key that is present
+ * - Miss: look up keys that are not present
+ * - Delete: remove every key
+ * - Enumerate: walk every entry
+ *
+ * Sizes cover a typical shell scope (64 variables), a command hash of a
+ * few PATH directories (2048) and a large associative array (100000).
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "ht.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TARGET_OPS 2000000
+
+/* Helper to get nanoseconds */
+static uint64_t get_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ============================================================================
+ * LEGACY CHAINED TABLE (reference implementation)
+ * ============================================================================
+ */
+
+typedef struct legacy_bucket {
+    const char *key;
+    const char *val;
+    struct legacy_bucket *next;
+} legacy_bucket_t;
+
+typedef struct {
+    legacy_bucket_t *buckets;
+    size_t capacity;
+    size_t used;
+} legacy_ht_t;
+
+typedef struct {
+    legacy_ht_t *ht;
+    legacy_bucket_t *cur;
+    size_t idx;
+} legacy_enum_t;
+
+static size_t legacy_index(const legacy_ht_t *ht, const char *key) {
+    return fnv1a_hash_str(key, FNV1A_OFFSET) % ht->capacity;
+}
+
+static legacy_ht_t *legacy_create(void) {
+    legacy_ht_t *ht = calloc(1, sizeof(*ht));
+    ht->capacity = 16;
+    ht->buckets = calloc(ht->capacity, sizeof(*ht->buckets));
+    return ht;
+}
+
+static void legacy_add(legacy_ht_t *ht, const char *key, const char *val,
+                       bool rehash) {
+    legacy_bucket_t *cur = ht->buckets + legacy_index(ht, key);
+    legacy_bucket_t *prev = NULL;
+
+    if (!cur->key) {
+        cur->key = rehash ? key : strdup(key);
+        cur->val = rehash ? val : strdup(val);
+        ht->used += !rehash;
+        return;
+    }
+
+    for (; cur; prev = cur, cur = cur->next) {
+        if (strcmp(key, cur->key) == 0) {
+            free((void *)cur->val);
+            cur->val = rehash ? val : strdup(val);
+            return;
+        }
+    }
+
+    cur = calloc(1, sizeof(*cur));
+    cur->key = rehash ? key : strdup(key);
+    cur->val = rehash ? val : strdup(val);
+    prev->next = cur;
+    ht->used += !rehash;
+}
+
+static void legacy_rehash(legacy_ht_t *ht) {
+    if (ht->used + 1 < (size_t)(ht->capacity * 0.75)) {
+        return;
+    }
+
+    legacy_bucket_t *old = ht->buckets;
+    size_t old_capacity = ht->capacity;
+    ht->capacity *= 2;
+    ht->buckets = calloc(ht->capacity, sizeof(*old));
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!old[i].key) {
+            continue;
+        }
+        legacy_add(ht, old[i].key, old[i].val, true);
+        for (legacy_bucket_t *cur = old[i].next, *next; cur; cur = next) {
+            legacy_add(ht, cur->key, cur->val, true);
+            next = cur->next;
+            free(cur);
+        }
+    }
+    free(old);
+}
+
+static void legacy_insert(legacy_ht_t *ht, const char *key, const char *val) {
+    legacy_rehash(ht);
+    legacy_add(ht, key, val, false);
+}
+
+static const char *legacy_get(const legacy_ht_t *ht, const char *key) {
+    const legacy_bucket_t *cur = ht->buckets + legacy_index(ht, key);
+    if (!cur->key) {
+        return NULL;
+    }
+    for (; cur; cur = cur->next) {
+        if (strcmp(key, cur->key) == 0) {
+            return cur->val;
+        }
+    }
+    return NULL;
+}
+
+static void legacy_remove(legacy_ht_t *ht, const char *key) {
+    legacy_bucket_t *head = ht->buckets + legacy_index(ht, key);
+    if (!head->key) {
+        return;
+    }
+
+    if (strcmp(head->key, key) == 0) {
+        free((void *)head->key);
+        free((void *)head->val);
+        head->key = NULL;
+        head->val = NULL;
+
+        /* The first chained node is copied into the bucket and freed */
+        legacy_bucket_t *cur = head->next;
+        if (cur) {
+            head->key = strdup(cur->key);
+            head->val = strdup(cur->val);
+            head->next = cur->next;
+            free((void *)cur->key);
+            free((void *)cur->val);
+            free(cur);
+        }
+        ht->used--;
+        return;
+    }
+
+    for (legacy_bucket_t *prev = head, *cur = head->next; cur;
+         prev = cur, cur = cur->next) {
+        if (strcmp(key, cur->key) == 0) {
+            prev->next = cur->next;
+            free((void *)cur->key);
+            free((void *)cur->val);
+            free(cur);
+            ht->used--;
+            return;
+        }
+    }
+}
+
+static bool legacy_enum_next(legacy_enum_t *he, const char **key,
+                             const char **val) {
+    if (!he->cur) {
+        while (he->idx < he->ht->capacity && !he->ht->buckets[he->idx].key) {
+            he->idx++;
+        }
+        if (he->idx >= he->ht->capacity) {
+            return false;
+        }
+        he->cur = he->ht->buckets + he->idx++;
+    }
+    *key = he->cur->key;
+    *val = he->cur->val;
+    he->cur = he->cur->next;
+    return true;
+}
+
+static void legacy_destroy(legacy_ht_t *ht) {
+    for (size_t i = 0; i < ht->capacity; i++) {
+        if (!ht->buckets[i].key) {
+            continue;
+        }
+        free((void *)ht->buckets[i].key);
+        free((void *)ht->buckets[i].val);
+        for (legacy_bucket_t *cur = ht->buckets[i].next, *next; cur;
+             cur = next) {
+            next = cur->next;
+            free((void *)cur->key);
+            free((void *)cur->val);
+            free(cur);
+        }
+    }
+    free(ht->buckets);
+    free(ht);
+}
+
+/* ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+typedef struct {
+    uint64_t insert;
+    uint64_t hit;
+    uint64_t miss;
+    uint64_t remove;
+    uint64_t enumerate;
+} timings_t;
+
+static char **make_keys(size_t count, const char *prefix) {
+    char **keys = malloc(count * sizeof(*keys));
+    char buf[64];
+    for (size_t i = 0; i < count; i++) {
+        snprintf(buf, sizeof(buf), "%s_%zu", prefix, i * 7919);
+        keys[i] = strdup(buf);
+    }
+    return keys;
+}
+
+static void free_keys(char **keys, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+}
+
+static void run_legacy(char **keys, char **missing, size_t count,
+                       size_t rounds, timings_t *t, size_t *check) {
+    for (size_t r = 0; r < rounds; r++) {
+        uint64_t start = get_nanos();
+        legacy_ht_t *ht = legacy_create();
+        for (size_t i = 0; i < count; i++) {
+            legacy_insert(ht, keys[i], "value");
+        }
+        t->insert += get_nanos() - start;
+
+        start = get_nanos();
+        for (size_t i = 0; i < count; i++) {
+            *check += legacy_get(ht, keys[i]) != NULL;
+        }
+        t->hit += get_nanos() - start;
+
+        start = get_nanos();
+        for (size_t i = 0; i < count; i++) {
+            *check += legacy_get(ht, missing[i]) != NULL;
+        }
+        t->miss += get_nanos() - start;
+
+        start = get_nanos();
+        legacy_enum_t he = {ht, NULL, 0};
+        const char *key, *val;
+        while (legacy_enum_next(&he, &key, &val)) {
+            (*check)++;
+        }
+        t->enumerate += get_nanos() - start;
+
+        start = get_nanos();
+        for (size_t i = 0; i < count; i++) {
+            legacy_remove(ht, keys[i]);
+        }
+        t->remove += get_nanos() - start;
+
+        legacy_destroy(ht);
+    }
+}
+
+static void run_table(char **keys, char **missing, size_t count,
+                      size_t rounds, timings_t *t, size_t *check) {
+    for (size_t r = 0; r < rounds; r++) {
+        uint64_t start = get_nanos();
+        ht_strstr_t *ht = ht_strstr_create(HT_STR_NONE);
+        for (size_t i = 0; i < count; i++) {
+            ht_strstr_insert(ht, keys[i], "value");
+        }
+        t->insert += get_nanos() - start;
+
+        start = get_nanos();
+        for (size_t i = 0; i < count; i++) {
+            *check += ht_strstr_get(ht, keys[i]) != NULL;
+        }
+        t->hit += get_nanos() - start;
+
+        start = get_nanos();
+        for (size_t i = 0; i < count; i++) {
+            *check += ht_strstr_get(ht, missing[i]) != NULL;
+        }
+        t->miss += get_nanos() - start;
+
+        start = get_nanos();
+        ht_enum_t *he = ht_strstr_enum_create(ht);
+        const char *key, *val;
+        while (ht_strstr_enum_next(he, &key, &val)) {
+            (*check)++;
+        }
+        ht_strstr_enum_destroy(he);
+        t->enumerate += get_nanos() - start;
+
+        start = get_nanos();
+        for (size_t i = 0; i < count; i++) {
+            ht_strstr_remove(ht, keys[i]);
+        }
+        t->remove += get_nanos() - start;
+
+        ht_strstr_destroy(ht);
+    }
+}
+
+static void report(const char *name, uint64_t legacy, uint64_t table,
+                   double ops) {
+    printf("  %-10s legacy %7.1f ns/op   table %7.1f ns/op   (%.1fx)\n", name,
+           (double)legacy / ops, (double)table / ops,
+           table ? (double)legacy / (double)table : 0.0);
+}
+
+static int benchmark_size(size_t count) {
+    size_t rounds = TARGET_OPS / count ? TARGET_OPS / count : 1;
+    char **keys = make_keys(count, "key");
+    char **missing = make_keys(count, "absent");
+    timings_t legacy = {0}, table = {0};
+    size_t legacy_check = 0, table_check = 0;
+
+    run_legacy(keys, missing, count, rounds, &legacy, &legacy_check);
+    run_table(keys, missing, count, rounds, &table, &table_check);
+
+    free_keys(keys, count);
+    free_keys(missing, count);
+
+    printf("%zu keys (%zu rounds):\n", count, rounds);
+    if (legacy_check != table_check || table_check != 2 * count * rounds) {
+        printf("  Result mismatch: legacy %zu, table %zu\n", legacy_check,
+               table_check);
+        return 1;
+    }
+
+    double ops = (double)count * (double)rounds;
+    report("insert", legacy.insert, table.insert, ops);
+    report("hit", legacy.hit, table.hit, ops);
+    report("miss", legacy.miss, table.miss, ops);
+    report("delete", legacy.remove, table.remove, ops);
+    report("enumerate", legacy.enumerate, table.enumerate, ops);
+    printf("\n");
+    return 0;
+}
+
+int main(void) {
+    printf("=================================================\n");
+    printf("Hash Table Benchmark\n");
+    printf("=================================================\n");
+
+    const size_t sizes[] = {64, 2048, 100000};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (benchmark_size(sizes[i]) != 0) {
+            return 1;
+        }
+    }
+
+    printf("=================================================\n");
+    return 0;
+}
@@ -0,0 +1,434 @@
+/**
+ * @file memory_pool_benchmark.c
+ * @brief Stress benchmark for the lush_memory_pool allocator
+ *
+ * Compares the slab pool against the previous design: one global mutex
+ * around every call, a free that scans the block array of each size class
+ * in turn for the pointer, malloc fallbacks kept in a list that is scanned
+ * on free, and clock reads on every allocation. The legacy pool is
+ * reproduced here so both run the same workloads:
+ * - Churn: a window of live blocks of mixed sizes, replaced at random
+ * - Realloc: buffers grown step by step from 16 bytes to 12KB
+ * - Concurrent: the churn on the main thread while the LLE async worker
+ *   thread runs the same churn from its completion callback
+ *
+ * Every block is stamped on allocation and checked before it is freed;
+ * the benchmark fails if any block was handed out twice or corrupted.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "lle/async_worker.h"
+#include "lush_memory_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#define CHURN_OPS 2000000
+#define CHURN_WINDOW 256
+#define REALLOC_BUFFERS 20000
+#define WORKER_REQUESTS 64
+#define WORKER_ROUND_OPS 25000
+
+/* Helper to get nanoseconds */
+static uint64_t get_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ============================================================================
+ * LEGACY POOL (reference implementation)
+ * ============================================================================
+ */
+
+#define LEGACY_CLASSES 4
+
+static const size_t legacy_sizes[LEGACY_CLASSES] = {128, 512, 4096, 16384};
+static const size_t legacy_counts[LEGACY_CLASSES] = {512, 64, 32, 16};
+
+typedef struct legacy_block {
+    void *memory;
+    bool in_use;
+    uint64_t allocation_time_us;
+    struct legacy_block *next;
+} legacy_block_t;
+
+static struct {
+    legacy_block_t *blocks[LEGACY_CLASSES];
+    legacy_block_t *free_list[LEGACY_CLASSES];
+    void **fallbacks;
+    size_t fallback_count;
+    size_t fallback_capacity;
+    uint64_t total_time_ns;
+    pthread_mutex_t mutex;
+} legacy = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+
+static void legacy_init(void) {
+    for (int c = 0; c < LEGACY_CLASSES; c++) {
+        legacy.blocks[c] = calloc(legacy_counts[c], sizeof(legacy_block_t));
+        for (size_t i = 0; i < legacy_counts[c]; i++) {
+            legacy_block_t *block = &legacy.blocks[c][i];
+            block->memory = malloc(legacy_sizes[c]);
+            block->next = legacy.free_list[c];
+            legacy.free_list[c] = block;
+        }
+    }
+}
+
+static void legacy_shutdown(void) {
+    for (int c = 0; c < LEGACY_CLASSES; c++) {
+        for (size_t i = 0; i < legacy_counts[c]; i++) {
+            free(legacy.blocks[c][i].memory);
+        }
+        free(legacy.blocks[c]);
+        legacy.blocks[c] = NULL;
+        legacy.free_list[c] = NULL;
+    }
+    for (size_t i = 0; i < legacy.fallback_count; i++) {
+        free(legacy.fallbacks[i]);
+    }
+    free(legacy.fallbacks);
+    legacy.fallbacks = NULL;
+    legacy.fallback_count = 0;
+    legacy.fallback_capacity = 0;
+}
+
+static void *legacy_alloc(size_t size) {
+    uint64_t start = get_nanos();
+    void *result = NULL;
+
+    pthread_mutex_lock(&legacy.mutex);
+    for (int c = 0; c < LEGACY_CLASSES && !result; c++) {
+        if (size <= legacy_sizes[c] && legacy.free_list[c]) {
+            legacy_block_t *block = legacy.free_list[c];
+            legacy.free_list[c] = block->next;
+            block->in_use = true;
+            struct timeval tv;
+            gettimeofday(&tv, NULL);
+            block->allocation_time_us =
+                (uint64_t)tv.tv_sec * 1000000 + (uint64_t)tv.tv_usec;
+            result = block->memory;
+        }
+        if (size <= legacy_sizes[c]) {
+            break;
+        }
+    }
+    if (!result) {
+        result = malloc(size);
+        if (legacy.fallback_count == legacy.fallback_capacity) {
+            legacy.fallback_capacity =
+                legacy.fallback_capacity ? legacy.fallback_capacity * 2 : 256;
+            legacy.fallbacks =
+                realloc(legacy.fallbacks,
+                        legacy.fallback_capacity * sizeof(void *));
+        }
+        legacy.fallbacks[legacy.fallback_count++] = result;
+    }
+    legacy.total_time_ns += get_nanos() - start;
+    pthread_mutex_unlock(&legacy.mutex);
+    return result;
+}
+
+static void legacy_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    pthread_mutex_lock(&legacy.mutex);
+    for (int c = 0; c < LEGACY_CLASSES; c++) {
+        for (size_t i = 0; i < legacy_counts[c]; i++) {
+            legacy_block_t *block = &legacy.blocks[c][i];
+            if (block->memory == ptr) {
+                block->in_use = false;
+                block->next = legacy.free_list[c];
+                legacy.free_list[c] = block;
+                pthread_mutex_unlock(&legacy.mutex);
+                return;
+            }
+        }
+    }
+    for (size_t i = 0; i < legacy.fallback_count; i++) {
+        if (legacy.fallbacks[i] == ptr) {
+            legacy.fallbacks[i] = legacy.fallbacks[--legacy.fallback_count];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&legacy.mutex);
+    free(ptr);
+}
+
+/*
+ * Realloc always moved the block. It copied new_size bytes without knowing
+ * the old size; the copy is bounded here to keep the reference well-defined.
+ */
+static void *legacy_realloc(void *ptr, size_t old_size, size_t new_size) {
+    void *result = legacy_alloc(new_size);
+    memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+    legacy_free(ptr);
+    return result;
+}
+
+/* ============================================================================
+ * WORKLOADS
+ * ============================================================================
+ */
+
+typedef struct {
+    const char *name;
+    void (*init)(void);
+    void (*shutdown)(void);
+    void *(*alloc)(size_t size);
+    void (*free)(void *ptr);
+} allocator_t;
+
+static void pool_init_default(void) { lush_pool_init(NULL); }
+
+static const allocator_t allocators[] = {
+    {"legacy", legacy_init, legacy_shutdown, legacy_alloc, legacy_free},
+    {"slab", pool_init_default, lush_pool_shutdown, lush_pool_alloc,
+     lush_pool_free},
+};
+
+/* One live block in a churn window */
+typedef struct {
+    unsigned char *ptr;
+    size_t size;
+    unsigned char tag;
+} churn_slot_t;
+
+typedef struct {
+    churn_slot_t slots[CHURN_WINDOW];
+    uint64_t rng;
+    unsigned char tag;
+    size_t errors;
+} churn_state_t;
+
+static uint32_t next_random(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (uint32_t)(*state >> 33);
+}
+
+/* Mostly small blocks, as in the shell: 70% <= 128, 20% <= 512, ... */
+static size_t pick_size(uint64_t *rng) {
+    uint32_t r = next_random(rng);
+    uint32_t bucket = r % 100;
+    if (bucket < 70) {
+        return 8 + r % 120;
+    }
+    if (bucket < 90) {
+        return 129 + r % 383;
+    }
+    if (bucket < 98) {
+        return 513 + r % 3583;
+    }
+    return 4097 + r % 20000;
+}
+
+static void churn(const allocator_t *a, churn_state_t *state, size_t ops) {
+    for (size_t i = 0; i < ops; i++) {
+        churn_slot_t *slot =
+            &state->slots[next_random(&state->rng) % CHURN_WINDOW];
+        if (slot->ptr) {
+            if (slot->ptr[0] != slot->tag ||
+                slot->ptr[slot->size - 1] != slot->tag) {
+                state->errors++;
+            }
+            a->free(slot->ptr);
+        }
+        slot->size = pick_size(&state->rng);
+        slot->tag = state->tag++;
+        slot->ptr = a->alloc(slot->size);
+        if (!slot->ptr) {
+            state->errors++;
+            slot->size = 0;
+            continue;
+        }
+        slot->ptr[0] = slot->tag;
+        slot->ptr[slot->size - 1] = slot->tag;
+    }
+}
+
+static void churn_release(const allocator_t *a, churn_state_t *state) {
+    for (int i = 0; i < CHURN_WINDOW; i++) {
+        a->free(state->slots[i].ptr);
+        state->slots[i].ptr = NULL;
+    }
+}
+
+static size_t bench_churn(const allocator_t *a) {
+    churn_state_t *state = calloc(1, sizeof(*state));
+    state->rng = 42;
+
+    a->init();
+    uint64_t start = get_nanos();
+    churn(a, state, CHURN_OPS);
+    uint64_t elapsed = get_nanos() - start;
+    churn_release(a, state);
+    a->shutdown();
+
+    printf("  %-8s %8.1f ns/op\n", a->name, (double)elapsed / CHURN_OPS);
+    size_t errors = state->errors;
+    free(state);
+    return errors;
+}
+
+static size_t bench_realloc(bool use_pool) {
+    size_t errors = 0;
+    uint64_t start = get_nanos();
+
+    if (use_pool) {
+        lush_pool_init(NULL);
+    } else {
+        legacy_init();
+    }
+    for (int b = 0; b < REALLOC_BUFFERS; b++) {
+        size_t size = 16;
+        unsigned char *buffer =
+            use_pool ? lush_pool_alloc(size) : legacy_alloc(size);
+        memset(buffer, (unsigned char)b, size);
+        while (size < 12288) {
+            size_t new_size = size + size / 2;
+            buffer = use_pool ? lush_pool_realloc(buffer, new_size)
+                              : legacy_realloc(buffer, size, new_size);
+            if (buffer[size - 1] != (unsigned char)b) {
+                errors++;
+            }
+            memset(buffer + size, (unsigned char)b, new_size - size);
+            size = new_size;
+        }
+        if (use_pool) {
+            lush_pool_free(buffer);
+        } else {
+            legacy_free(buffer);
+        }
+    }
+    if (use_pool) {
+        lush_pool_shutdown();
+    } else {
+        legacy_shutdown();
+    }
+
+    uint64_t elapsed = get_nanos() - start;
+    printf("  %-8s %8.1f us/buffer\n", use_pool ? "slab" : "legacy",
+           (double)elapsed / 1000.0 / REALLOC_BUFFERS);
+    return errors;
+}
+
+/* ============================================================================
+ * CONCURRENT CHURN WITH THE ASYNC WORKER
+ * ============================================================================
+ */
+
+typedef struct {
+    const allocator_t *allocator;
+    churn_state_t state;
+    atomic_int completed;
+} worker_context_t;
+
+/* Runs on the worker thread for every completed request */
+static void worker_churn(const lle_async_response_t *response,
+                         void *user_data) {
+    (void)response;
+    worker_context_t *ctx = user_data;
+    churn(ctx->allocator, &ctx->state, WORKER_ROUND_OPS);
+    atomic_fetch_add(&ctx->completed, 1);
+}
+
+static size_t bench_concurrent(const allocator_t *a) {
+    worker_context_t *ctx = calloc(1, sizeof(*ctx));
+    churn_state_t *main_state = calloc(1, sizeof(*main_state));
+    ctx->allocator = a;
+    ctx->state.rng = 7;
+    ctx->state.tag = 128;
+    main_state->rng = 11;
+
+    a->init();
+
+    lle_async_worker_t *worker = NULL;
+    if (lle_async_worker_init(&worker, worker_churn, ctx) != LLE_SUCCESS ||
+        lle_async_worker_start(worker) != LLE_SUCCESS) {
+        printf("  %-8s async worker failed to start\n", a->name);
+        lle_async_worker_destroy(worker);
+        a->shutdown();
+        free(main_state);
+        free(ctx);
+        return 1;
+    }
+
+    uint64_t start = get_nanos();
+    int submitted = 0;
+    int main_rounds = 0;
+    while (main_rounds < WORKER_REQUESTS ||
+           atomic_load(&ctx->completed) < WORKER_REQUESTS) {
+        if (submitted < WORKER_REQUESTS) {
+            /* Custom requests finish at once and run the callback */
+            lle_async_request_t *request =
+                lle_async_request_create(LLE_ASYNC_CUSTOM);
+            if (request && lle_async_worker_submit(worker, request) ==
+                               LLE_SUCCESS) {
+                submitted++;
+            } else {
+                lle_async_request_free(request);
+            }
+        }
+        if (main_rounds < WORKER_REQUESTS) {
+            churn(a, main_state, WORKER_ROUND_OPS);
+            main_rounds++;
+        }
+    }
+    uint64_t elapsed = get_nanos() - start;
+
+    lle_async_worker_shutdown(worker);
+    lle_async_worker_wait(worker);
+    lle_async_worker_destroy(worker);
+
+    churn_release(a, main_state);
+    churn_release(a, &ctx->state);
+    a->shutdown();
+
+    size_t total_ops = 2UL * WORKER_REQUESTS * WORKER_ROUND_OPS;
+    printf("  %-8s %8.1f ns/op across both threads (%.1f ms)\n", a->name,
+           (double)elapsed / total_ops, (double)elapsed / 1e6);
+
+    size_t errors = main_state->errors + ctx->state.errors;
+    free(main_state);
+    free(ctx);
+    return errors;
+}
+
+int main(void) {
+    size_t errors = 0;
+
+    printf("Memory Pool Benchmark\n");
+    printf("=====================\n");
+
+    printf("\nChurn (%d ops, window of %d live blocks):\n", CHURN_OPS,
+           CHURN_WINDOW);
+    for (size_t i = 0; i < sizeof(allocators) / sizeof(allocators[0]); i++) {
+        errors += bench_churn(&allocators[i]);
+    }
+
+    printf("\nRealloc growth (%d buffers, 16B to 12KB):\n", REALLOC_BUFFERS);
+    errors += bench_realloc(false);
+    errors += bench_realloc(true);
+
+    printf("\nConcurrent churn with the async worker (%d x %d ops each):\n",
+           WORKER_REQUESTS, WORKER_ROUND_OPS);
+    for (size_t i = 0; i < sizeof(allocators) / sizeof(allocators[0]); i++) {
+        errors += bench_concurrent(&allocators[i]);
+    }
+
+    if (errors) {
+        printf("\nFAILED: %zu corrupted or failed allocations\n", errors);
+        return 1;
+    }
+    printf("\nAll blocks verified\n");
+    return 0;
+}
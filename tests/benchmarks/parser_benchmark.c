@@ -0,0 +1,196 @@
+/**
+ * @file parser_benchmark.c
+ * @brief Allocation and throughput benchmark for command line parsing
+ *
+ * Parses a fixed set of representative command lines over and over, once
+ * with the heap parser (every token, node and string from malloc, freed
+ * through free_node_tree and parser_free) and once the way the executor
+ * parses a command line: inside a scratch scope of a parse arena that is
+ * emptied in one step when the command is done.
+ *
+ * On glibc the malloc family is wrapped to count heap calls, so the
+ * benchmark reports allocations per parsed line next to the time per
+ * line. Both modes must produce the same tree for every line; the
+ * benchmark fails if any tree differs.
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "lle/arena.h"
+#include "lush_memory_pool.h"
+#include "node.h"
+#include "parser.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PARSE_ROUNDS 20000
+
+/* Helper to get nanoseconds */
+static uint64_t get_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ============================================================================
+ * HEAP CALL COUNTING
+ * ============================================================================
+ */
+
+static size_t heap_calls;
+
+#ifdef __GLIBC__
+#define HAVE_HEAP_COUNTS 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    heap_calls++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    heap_calls++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    heap_calls++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) { __libc_free(ptr); }
+#else
+#define HAVE_HEAP_COUNTS 0
+#endif
+
+/* ============================================================================
+ * WORKLOAD
+ * ============================================================================
+ */
+
+static const char *const command_lines[] = {
+    "ls -la /tmp",
+    "echo \"hello $USER\" > /dev/null 2>&1",
+    "grep -v '^#' config.txt | sort | uniq -c | sort -rn | head -n 10",
+    "for f in *.c *.h; do wc -l \"$f\"; done",
+    "if [ -f ~/.lushrc ]; then . ~/.lushrc; else echo none; fi",
+    "x=1; y=${x:-default}; arr=(one two \"three four\"); echo ${arr[2]}",
+    "while read -r line; do echo \"${line%%:*}\"; done < /etc/passwd",
+    "case $1 in start|run) echo go;; stop) echo halt;; *) echo \"?\";; esac",
+    "greet() { local name=$1; printf 'hi %s\\n' \"$name\"; }",
+    "for ((i = 0; i < 10; i++)); do (( total += i )); done",
+    "[[ -n $HOME && $SHELL == *lush ]] && echo yes || echo no",
+    "result=$(git status --porcelain | wc -l); echo \"$result changes\"",
+    "cat <<EOF\nline one $HOME\nline two\nEOF",
+    "{ make -j4 && make test; } 2>&1 | tee build.log",
+};
+
+#define COMMAND_LINE_COUNT (sizeof(command_lines) / sizeof(command_lines[0]))
+
+/* Fold a tree into a hash of node types and string values */
+static uint64_t tree_hash(const node_t *node, uint64_t hash) {
+    for (; node; node = node->next_sibling) {
+        hash = (hash ^ (uint64_t)node->type) * 1099511628211ULL;
+        if (node->val_type == VAL_STR && node->val.str) {
+            for (const char *p = node->val.str; *p; p++) {
+                hash = (hash ^ (unsigned char)*p) * 1099511628211ULL;
+            }
+        }
+        hash = tree_hash(node->first_child, hash);
+    }
+    return hash;
+}
+
+static uint64_t parse_heap(const char *line) {
+    parser_t *parser = parser_new(line);
+    node_t *ast = parser_parse(parser);
+    uint64_t hash = tree_hash(ast, 14695981039346656037ULL);
+    free_node_tree(ast);
+    parser_free(parser);
+    return hash;
+}
+
+static uint64_t parse_arena(lle_arena_t *arena, const char *line) {
+    lle_arena_scratch_t scope = lle_arena_scratch_begin(arena);
+    parser_t *parser = parser_new_in_arena(line, NULL, arena);
+    node_t *ast = parser_parse(parser);
+    uint64_t hash = tree_hash(ast, 14695981039346656037ULL);
+    free_node_tree(ast);
+    parser_free(parser);
+    lle_arena_scratch_end(&scope);
+    return hash;
+}
+
+/* Parse every line PARSE_ROUNDS times; returns the number of mismatches */
+static size_t bench_parse(const char *name, lle_arena_t *arena,
+                          const uint64_t *expected) {
+    size_t mismatches = 0;
+    size_t calls_before = heap_calls;
+    uint64_t start = get_nanos();
+
+    for (int round = 0; round < PARSE_ROUNDS; round++) {
+        for (size_t i = 0; i < COMMAND_LINE_COUNT; i++) {
+            uint64_t hash = arena ? parse_arena(arena, command_lines[i])
+                                  : parse_heap(command_lines[i]);
+            if (hash != expected[i]) {
+                mismatches++;
+            }
+        }
+    }
+
+    uint64_t elapsed = get_nanos() - start;
+    size_t calls = heap_calls - calls_before;
+    double lines = (double)PARSE_ROUNDS * COMMAND_LINE_COUNT;
+
+    if (HAVE_HEAP_COUNTS) {
+        printf("  %-6s %8.1f ns/line  %6.1f heap allocations/line\n", name,
+               (double)elapsed / lines, (double)calls / lines);
+    } else {
+        printf("  %-6s %8.1f ns/line\n", name, (double)elapsed / lines);
+    }
+    return mismatches;
+}
+
+int main(void) {
+    uint64_t expected[COMMAND_LINE_COUNT];
+    size_t errors = 0;
+
+    printf("Parser Benchmark\n");
+    printf("================\n");
+
+    lush_pool_init(NULL);
+    lle_arena_t *arena =
+        lle_arena_create(NULL, "parse", 16384 - sizeof(lle_arena_chunk_t));
+    if (!arena) {
+        printf("FAILED: could not create parse arena\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < COMMAND_LINE_COUNT; i++) {
+        expected[i] = parse_heap(command_lines[i]);
+    }
+
+    printf("\nParsing %zu command lines x %d rounds:\n", COMMAND_LINE_COUNT,
+           PARSE_ROUNDS);
+    errors += bench_parse("heap", NULL, expected);
+    errors += bench_parse("arena", arena, expected);
+
+    lle_arena_destroy(arena);
+    lush_pool_shutdown();
+
+    if (errors) {
+        printf("\nFAILED: %zu trees differ between heap and arena\n", errors);
+        return 1;
+    }
+    printf("\nAll trees match\n");
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file symtable_benchmark.c
+ * @brief Micro-benchmark for symbol table variable storage
+ *
+ * Compares the in-place symvar_t store used by symtable.c against the
+ * previous design, where every scope was an ht_strstr_t holding
+ * "value|type|flags|scope_level" strings that were serialized on every
+ * assignment and deserialized on every lookup. The legacy path is
+ * reproduced here so both run against the same workload:
+ * - Lookup: repeated reads of a small working set of variables
+ * - Assign: repeated overwrites of existing variables
+ * - Counter: read-as-integer then write back (i=$((i+1)) loops)
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "ht.h"
+#include "symtable.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define VAR_COUNT 64
+#define ITERATIONS 200000
+
+/* Helper to get nanoseconds */
+static uint64_t get_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ============================================================================
+ * LEGACY SERIALIZED STORE (reference implementation)
+ * ============================================================================
+ */
+
+static void legacy_set(ht_strstr_t *ht, const char *name, const char *value,
+                       int flags) {
+    size_t size = strlen(value) + 64;
+    char *serialized = malloc(size);
+    if (!serialized) {
+        return;
+    }
+    snprintf(serialized, size, "%s|%d|%d|%zu", value, (int)SYMVAR_STRING,
+             flags, (size_t)0);
+    ht_strstr_insert(ht, name, serialized);
+    free(serialized);
+}
+
+static char *legacy_get(ht_strstr_t *ht, const char *name) {
+    const char *serialized = ht_strstr_get(ht, name);
+    if (!serialized) {
+        return NULL;
+    }
+
+    /* Mirrors deserialize_variable(): copy name and record, split fields */
+    char *name_copy = strdup(name);
+    char *copy = strdup(serialized);
+    char *value = NULL;
+    char *sep = copy ? strchr(copy, '|') : NULL;
+    if (sep) {
+        *sep = '\0';
+        value = strdup(copy);
+        (void)atoi(sep + 1);
+    }
+    free(copy);
+    free(name_copy);
+
+    /* symtable_get_var() then returned another copy to the caller */
+    char *result = value ? strdup(value) : NULL;
+    free(value);
+    return result;
+}
+
+/* ============================================================================
+ * BENCHMARKS
+ * ============================================================================
+ */
+
+static void report(const char *name, uint64_t legacy_ns, uint64_t native_ns) {
+    printf("  %-10s legacy %8.2f ns/op   native %8.2f ns/op   (%.1fx)\n",
+           name, (double)legacy_ns / ITERATIONS,
+           (double)native_ns / ITERATIONS,
+           native_ns ? (double)legacy_ns / (double)native_ns : 0.0);
+}
+
+int main(void) {
+    char names[VAR_COUNT][16];
+    char value[32];
+    volatile size_t sink = 0;
+
+    printf("=================================================\n");
+    printf("Symbol Table Storage Benchmark\n");
+    printf("=================================================\n");
+    printf("  Variables: %d, iterations: %d\n\n", VAR_COUNT, ITERATIONS);
+
+    ht_strstr_t *legacy = ht_strstr_create(HT_SEED_RANDOM);
+    symtable_manager_t *mgr = symtable_manager_new();
+    if (!legacy || !mgr) {
+        printf("Failed to create tables\n");
+        return 1;
+    }
+
+    for (int i = 0; i < VAR_COUNT; i++) {
+        snprintf(names[i], sizeof(names[i]), "var_%d", i);
+        snprintf(value, sizeof(value), "value_%d", i);
+        legacy_set(legacy, names[i], value, SYMVAR_NONE);
+        symtable_set_var(mgr, names[i], value, SYMVAR_NONE);
+    }
+
+    /* Lookup */
+    uint64_t start = get_nanos();
+    for (int i = 0; i < ITERATIONS; i++) {
+        char *v = legacy_get(legacy, names[i % VAR_COUNT]);
+        sink += v ? strlen(v) : 0;
+        free(v);
+    }
+    uint64_t legacy_ns = get_nanos() - start;
+
+    start = get_nanos();
+    for (int i = 0; i < ITERATIONS; i++) {
+        const char *v = symtable_get_var_ref(mgr, names[i % VAR_COUNT]);
+        sink += v ? strlen(v) : 0;
+    }
+    report("lookup", legacy_ns, get_nanos() - start);
+
+    /* Assign */
+    start = get_nanos();
+    for (int i = 0; i < ITERATIONS; i++) {
+        snprintf(value, sizeof(value), "%d", i);
+        legacy_set(legacy, names[i % VAR_COUNT], value, SYMVAR_NONE);
+    }
+    legacy_ns = get_nanos() - start;
+
+    start = get_nanos();
+    for (int i = 0; i < ITERATIONS; i++) {
+        snprintf(value, sizeof(value), "%d", i);
+        symtable_set_var(mgr, names[i % VAR_COUNT], value, SYMVAR_NONE);
+    }
+    report("assign", legacy_ns, get_nanos() - start);
+
+    /* Counter loop */
+    legacy_set(legacy, "i", "0", SYMVAR_NONE);
+    start = get_nanos();
+    for (int i = 0; i < ITERATIONS; i++) {
+        char *v = legacy_get(legacy, "i");
+        long n = v ? atol(v) : 0;
+        free(v);
+        snprintf(value, sizeof(value), "%ld", n + 1);
+        legacy_set(legacy, "i", value, SYMVAR_NONE);
+    }
+    legacy_ns = get_nanos() - start;
+
+    symtable_set_var(mgr, "i", "0", SYMVAR_NONE);
+    start = get_nanos();
+    for (int i = 0; i < ITERATIONS; i++) {
+        long long n = 0;
+        symtable_get_var_integer(mgr, "i", &n);
+        snprintf(value, sizeof(value), "%lld", n + 1);
+        symtable_set_var(mgr, "i", value, SYMVAR_NONE);
+    }
+    report("counter", legacy_ns, get_nanos() - start);
+
+    /* Sanity check: both stores must agree on the final counter */
+    char *legacy_final = legacy_get(legacy, "i");
+    const char *native_final = symtable_get_var_ref(mgr, "i");
+    int status = (legacy_final && native_final &&
+                  strcmp(legacy_final, native_final) == 0)
+                     ? 0
+                     : 1;
+    printf("\n  Final counter: legacy=%s native=%s -> %s\n",
+           legacy_final ? legacy_final : "(null)",
+           native_final ? native_final : "(null)", status ? "FAIL" : "PASS");
+    free(legacy_final);
+
+    ht_strstr_destroy(legacy);
+    symtable_manager_free(mgr);
+    (void)sink;
+    return status;
+}
@@ -138,7 +138,7 @@ int main(void) {
                 /* Rebuild UTF-8 index */
                 if (buffer->utf8_index) {
                     lle_utf8_index_rebuild(buffer->utf8_index,
-                                           (const char *)buffer->data,
+                                           lle_buffer_get_text(buffer),
                                            buffer->length);
                 }
             }
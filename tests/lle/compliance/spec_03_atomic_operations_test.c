@@ -92,14 +92,15 @@ static void test_buffer_insert() {
     ASSERT_SUCCESS(result, "Insert failed");
 
     ASSERT_EQ(buffer->length, 5, "Buffer length incorrect");
-    ASSERT_STR_EQ(buffer->data, "Hello", "Buffer content incorrect");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello",
+                  "Buffer content incorrect");
 
     /* Insert more text */
     result = lle_buffer_insert_text(buffer, 5, " World", 6);
     ASSERT_SUCCESS(result, "Second insert failed");
 
     ASSERT_EQ(buffer->length, 11, "Buffer length after second insert");
-    ASSERT_STR_EQ(buffer->data, "Hello World",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello World",
                   "Buffer content after second insert");
 
     lle_buffer_destroy(buffer);
@@ -123,7 +124,8 @@ static void test_buffer_delete() {
     ASSERT_SUCCESS(result, "Delete failed");
 
     ASSERT_EQ(buffer->length, 5, "Buffer length after delete");
-    ASSERT_STR_EQ(buffer->data, "Hello", "Buffer content after delete");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello",
+                  "Buffer content after delete");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -146,7 +148,8 @@ static void test_buffer_replace() {
     ASSERT_SUCCESS(result, "Replace failed");
 
     ASSERT_EQ(buffer->length, 12, "Buffer length after replace");
-    ASSERT_STR_EQ(buffer->data, "Hello Claude", "Buffer content after replace");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello Claude",
+                  "Buffer content after replace");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -201,7 +204,7 @@ static void test_basic_undo() {
     result = lle_change_tracker_complete_sequence(tracker);
     ASSERT_SUCCESS(result, "Complete sequence failed");
 
-    ASSERT_STR_EQ(buffer->data, "Hello", "Buffer before undo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello", "Buffer before undo");
 
     /* Undo the operation */
     ASSERT_TRUE(lle_change_tracker_can_undo(tracker), "Should be able to undo");
@@ -210,7 +213,8 @@ static void test_basic_undo() {
     ASSERT_SUCCESS(result, "Undo failed");
 
     ASSERT_EQ(buffer->length, 0, "Buffer length after undo");
-    ASSERT_STR_EQ(buffer->data, "", "Buffer should be empty after undo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "",
+                  "Buffer should be empty after undo");
 
     lle_change_tracker_destroy(tracker);
     lle_buffer_destroy(buffer);
@@ -244,18 +248,18 @@ static void test_undo_redo_cycle() {
     result = lle_change_tracker_complete_sequence(tracker);
     ASSERT_SUCCESS(result, "Complete sequence 1 failed");
 
-    ASSERT_STR_EQ(buffer->data, "Hello", "After first insert");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello", "After first insert");
 
     /* Undo */
     result = lle_change_tracker_undo(tracker, buffer);
     ASSERT_SUCCESS(result, "Undo failed");
-    ASSERT_STR_EQ(buffer->data, "", "After undo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "", "After undo");
 
     /* Redo */
     ASSERT_TRUE(lle_change_tracker_can_redo(tracker), "Should be able to redo");
     result = lle_change_tracker_redo(tracker, buffer);
     ASSERT_SUCCESS(result, "Redo failed");
-    ASSERT_STR_EQ(buffer->data, "Hello", "After redo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello", "After redo");
 
     lle_change_tracker_destroy(tracker);
     lle_buffer_destroy(buffer);
@@ -95,7 +95,7 @@ TEST(scenario_basic_command_editing) {
 
     /* Verify state */
     ASSERT_EQ(buffer->length, 6, "Buffer length is 6");
-    ASSERT_STR_EQ((char *)buffer->data, "ls -la", "Buffer content");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "ls -la", "Buffer content");
 
     /* User realizes they want "-lah", moves cursor to end and adds 'h' */
     lle_change_sequence_t *seq2 = NULL;
@@ -111,19 +111,20 @@ TEST(scenario_basic_command_editing) {
 
     /* Verify final state */
     ASSERT_EQ(buffer->length, 7, "Buffer length is 7");
-    ASSERT_STR_EQ((char *)buffer->data, "ls -lah", "Final buffer content");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "ls -lah",
+                  "Final buffer content");
 
     /* User can undo the 'h' addition */
     result = lle_change_tracker_undo(tracker, buffer);
     ASSERT_SUCCESS(result, "Undo add h");
     ASSERT_EQ(buffer->length, 6, "Buffer length back to 6");
-    ASSERT_STR_EQ((char *)buffer->data, "ls -la", "Buffer after undo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "ls -la", "Buffer after undo");
 
     /* And redo it */
     result = lle_change_tracker_redo(tracker, buffer);
     ASSERT_SUCCESS(result, "Redo add h");
     ASSERT_EQ(buffer->length, 7, "Buffer length is 7 again");
-    ASSERT_STR_EQ((char *)buffer->data, "ls -lah", "Buffer after redo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "ls -lah", "Buffer after redo");
 
     /* Cleanup */
     lle_change_tracker_destroy(tracker);
@@ -188,18 +189,18 @@ TEST(scenario_typo_correction_with_utf8) {
     ASSERT_SUCCESS(result, "Complete fix");
 
     /* Verify corrected text */
-    ASSERT_STR_EQ((char *)buffer->data, "echo 'Hello 🌍 World'",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "echo 'Hello 🌍 World'",
                   "Corrected text");
 
     /* Undo and redo work correctly */
     result = lle_change_tracker_undo(tracker, buffer);
     ASSERT_SUCCESS(result, "Undo correction");
-    ASSERT_STR_EQ((char *)buffer->data, "echo 'Hello 🌍 Wrold'",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "echo 'Hello 🌍 Wrold'",
                   "Back to typo");
 
     result = lle_change_tracker_redo(tracker, buffer);
     ASSERT_SUCCESS(result, "Redo correction");
-    ASSERT_STR_EQ((char *)buffer->data, "echo 'Hello 🌍 World'",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "echo 'Hello 🌍 World'",
                   "Corrected again");
 
     /* Cleanup */
@@ -259,7 +260,7 @@ TEST(scenario_complex_command_construction) {
     result = lle_change_tracker_complete_sequence(tracker);
     ASSERT_SUCCESS(result, "Complete sequence");
 
-    ASSERT_STR_EQ((char *)buffer->data, "grep error app.log",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "grep error app.log",
                   "After adding filename");
 
     /* Step 3: Add pipe to sort */
@@ -285,8 +286,8 @@ TEST(scenario_complex_command_construction) {
     ASSERT_SUCCESS(result, "Complete sequence");
 
     /* Verify final complex command */
-    ASSERT_STR_EQ((char *)buffer->data, "grep error app.log | sort | uniq -c",
-                  "Final complex command");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer),
+                  "grep error app.log | sort | uniq -c", "Final complex command");
     ASSERT_EQ(buffer->length, 35, "Final buffer length");
 
     /* Validate final buffer */
@@ -296,16 +297,17 @@ TEST(scenario_complex_command_construction) {
     /* User can undo steps */
     result = lle_change_tracker_undo(tracker, buffer); /* Remove uniq */
     ASSERT_SUCCESS(result, "Undo step 4");
-    ASSERT_STR_EQ((char *)buffer->data, "grep error app.log | sort",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "grep error app.log | sort",
                   "After undo 1");
 
     result = lle_change_tracker_undo(tracker, buffer); /* Remove sort */
     ASSERT_SUCCESS(result, "Undo step 3");
-    ASSERT_STR_EQ((char *)buffer->data, "grep error app.log", "After undo 2");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "grep error app.log",
+                  "After undo 2");
 
     result = lle_change_tracker_undo(tracker, buffer); /* Remove filename */
     ASSERT_SUCCESS(result, "Undo step 2");
-    ASSERT_STR_EQ((char *)buffer->data, "grep error", "After undo 3");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "grep error", "After undo 3");
 
     /* Redo all steps */
     result = lle_change_tracker_redo(tracker, buffer);
@@ -317,8 +319,8 @@ TEST(scenario_complex_command_construction) {
     result = lle_change_tracker_redo(tracker, buffer);
     ASSERT_SUCCESS(result, "Redo step 4");
 
-    ASSERT_STR_EQ((char *)buffer->data, "grep error app.log | sort | uniq -c",
-                  "Back to final state");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer),
+                  "grep error app.log | sort | uniq -c", "Back to final state");
 
     /* Cleanup */
     lle_buffer_validator_destroy(validator);
@@ -392,7 +394,7 @@ TEST(scenario_cursor_navigation_editing) {
     ASSERT_SUCCESS(result, "Complete insert");
 
     /* Verify result */
-    ASSERT_STR_EQ((char *)buffer->data, "find . -name *.txt",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "find . -name *.txt",
                   "Modified command");
     ASSERT_EQ(buffer->length, 18, "Modified buffer length");
 
@@ -403,7 +405,7 @@ TEST(scenario_cursor_navigation_editing) {
     result = lle_change_tracker_undo(tracker, buffer); /* Undo delete test */
     ASSERT_SUCCESS(result, "Undo delete");
 
-    ASSERT_STR_EQ((char *)buffer->data, "find . -name test.txt",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "find . -name test.txt",
                   "Back to original");
 
     /* Cleanup */
@@ -482,8 +484,8 @@ TEST(scenario_continuous_validation) {
     result = lle_buffer_validate_complete(buffer, validator);
     ASSERT_SUCCESS(result, "Valid after op3");
 
-    ASSERT_STR_EQ((char *)buffer->data, "cat big_file.txt | grep pattern",
-                  "After all ops");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer),
+                  "cat big_file.txt | grep pattern", "After all ops");
 
     /* Op 4: Delete */
     result = lle_change_tracker_begin_sequence(tracker, "op4", &seq);
@@ -499,7 +501,7 @@ TEST(scenario_continuous_validation) {
     result = lle_buffer_validate_complete(buffer, validator);
     ASSERT_SUCCESS(result, "Valid after op4");
 
-    ASSERT_STR_EQ((char *)buffer->data, "cat file.txt | grep pattern",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "cat file.txt | grep pattern",
                   "After delete");
 
     /* Verify validation statistics */
@@ -16,6 +16,7 @@
 #include "../../../include/lle/buffer_management.h"
 #include "../../../include/lle/error_handling.h"
 #include "../../../include/lle/memory_management.h"
+#include "../../../include/lle/utf8_support.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -163,7 +164,8 @@ static void test_insert_text_at_start() {
     ASSERT_SUCCESS(result, "Text insertion succeeds");
 
     ASSERT_EQ(buffer->length, strlen(text), "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "Hello", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -183,7 +185,8 @@ static void test_insert_text_at_end() {
     ASSERT_SUCCESS(result, "Second insertion succeeds");
 
     ASSERT_EQ(buffer->length, 11, "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "Hello World", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello World",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -203,7 +206,8 @@ static void test_insert_text_in_middle() {
     ASSERT_SUCCESS(result, "Middle insertion succeeds");
 
     ASSERT_EQ(buffer->length, 11, "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "Hello World", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello World",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -223,7 +227,8 @@ static void test_delete_text_from_start() {
     ASSERT_SUCCESS(result, "Text deletion succeeds");
 
     ASSERT_EQ(buffer->length, 5, "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "World", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "World",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -243,7 +248,8 @@ static void test_delete_text_from_end() {
     ASSERT_SUCCESS(result, "Text deletion succeeds");
 
     ASSERT_EQ(buffer->length, 5, "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "Hello", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -263,7 +269,8 @@ static void test_delete_text_from_middle() {
     ASSERT_SUCCESS(result, "Text deletion succeeds");
 
     ASSERT_EQ(buffer->length, 10, "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "HelloWorld", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "HelloWorld",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -283,7 +290,8 @@ static void test_replace_text() {
     ASSERT_SUCCESS(result, "Text replacement succeeds");
 
     ASSERT_EQ(buffer->length, 11, "Buffer length correct");
-    ASSERT_STR_EQ(buffer->data, "Hello Earth", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello Earth",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -308,7 +316,8 @@ static void test_insert_utf8_text() {
 
     ASSERT_EQ(buffer->length, 12,
               "Buffer length correct (6 ASCII + 6 UTF-8 bytes)");
-    ASSERT_STR_EQ(buffer->data, "Hello 世界", "Buffer content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello 世界",
+                  "Buffer content correct");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -353,7 +362,7 @@ static void test_multiple_insertions() {
     result = lle_buffer_insert_text(buffer, 2, "c", 1);
     ASSERT_SUCCESS(result, "Insert 'c'");
 
-    ASSERT_STR_EQ(buffer->data, "abc",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "abc",
                   "Content correct after multiple insertions");
 
     lle_buffer_destroy(buffer);
@@ -376,7 +385,7 @@ static void test_insert_delete_sequence() {
     result = lle_buffer_insert_text(buffer, 5, " Earth", 6);
     ASSERT_SUCCESS(result, "Insert replacement");
 
-    ASSERT_STR_EQ(buffer->data, "Hello Earth",
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello Earth",
                   "Content correct after sequence");
 
     lle_buffer_destroy(buffer);
@@ -408,6 +417,195 @@ static void test_buffer_growth() {
     PASS();
 }
 
+/* ============================================================================
+ * GAP BUFFER TESTS
+ * ============================================================================
+ */
+
+static void test_gap_local_edits() {
+    TEST("Local edits leave the gap open");
+
+    lle_buffer_t *buffer = NULL;
+    lle_result_t result = lle_buffer_create(&buffer, test_pool, 0);
+    ASSERT_SUCCESS(result, "Buffer creation succeeds");
+
+    result = lle_buffer_insert_text(buffer, 0, "Hello World", 11);
+    ASSERT_SUCCESS(result, "Initial insert");
+    ASSERT_TRUE(!buffer->gap_open, "Appending keeps text contiguous");
+
+    /* Type in the middle, one character at a time */
+    for (size_t i = 0; i < 3; i++) {
+        result = lle_buffer_insert_text(buffer, 5 + i, ",", 1);
+        ASSERT_SUCCESS(result, "Insert in middle");
+    }
+    ASSERT_TRUE(buffer->gap_open, "Gap left at the edit position");
+    ASSERT_EQ(buffer->gap_start, 8, "Gap follows the inserted text");
+
+    /* Ranges on either side of and across the gap */
+    char out[32];
+    lle_buffer_copy_text(buffer, 0, 5, out);
+    ASSERT_STR_EQ(out, "Hello", "Copy before gap");
+    lle_buffer_copy_text(buffer, 9, 5, out);
+    ASSERT_STR_EQ(out, "World", "Copy after gap");
+    lle_buffer_copy_text(buffer, 3, 8, out);
+    ASSERT_STR_EQ(out, "lo,,, Wo", "Copy across gap");
+    ASSERT_TRUE(lle_buffer_copy_text(buffer, 10, 5, out) ==
+                    LLE_ERROR_INVALID_RANGE,
+                "Copy past end rejected");
+    ASSERT_TRUE(buffer->gap_open, "Copying does not close the gap");
+
+    result = lle_buffer_delete_text(buffer, 7, 1);
+    ASSERT_SUCCESS(result, "Backspace in middle");
+
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello,, World",
+                  "Materialized content correct");
+    ASSERT_TRUE(!buffer->gap_open, "Reading closes the gap");
+    ASSERT_EQ(buffer->length, 13, "Length correct");
+
+    lle_buffer_destroy(buffer);
+    PASS();
+}
+
+static void test_gap_random_edits() {
+    TEST("Random edits match a flat reference");
+
+    lle_buffer_t *buffer = NULL;
+    lle_result_t result =
+        lle_buffer_create(&buffer, test_pool, LLE_BUFFER_MIN_CAPACITY);
+    ASSERT_SUCCESS(result, "Buffer creation succeeds");
+
+    static const char *pieces[] = {"a", "xyz", " ", "\xc3\xa9", "\n",
+                                   "\xe4\xb8\x96\xe7\x95\x8c",
+                                   "0123456789abcdef0123456789abcdef"};
+    static char reference[8192];
+    size_t length = 0;
+    reference[0] = '\0';
+
+    srand(4242);
+    for (int step = 0; step < 5000; step++) {
+        /* Edit position on a character boundary */
+        size_t at = length ? (size_t)rand() % (length + 1) : 0;
+        while (at > 0 && at < length && (reference[at] & 0xC0) == 0x80) {
+            at--;
+        }
+        size_t end = at;
+        if (length > 0 && at < length) {
+            end = at + 1 + (size_t)rand() % 8;
+            if (end > length) {
+                end = length;
+            }
+            while (end < length && (reference[end] & 0xC0) == 0x80) {
+                end++;
+            }
+        }
+        const char *piece = pieces[rand() % 7];
+        size_t n = strlen(piece);
+        int op = rand() % 3;
+        if (length > 6000) {
+            op = 1; /* Keep the text below the reference size */
+        }
+
+        if (op == 0 || end == at) {
+            result = lle_buffer_insert_text(buffer, at, piece, n);
+            memmove(reference + at + n, reference + at, length - at + 1);
+            memcpy(reference + at, piece, n);
+            length += n;
+        } else if (op == 1) {
+            result = lle_buffer_delete_text(buffer, at, end - at);
+            memmove(reference + at, reference + end, length - end + 1);
+            length -= end - at;
+        } else {
+            result = lle_buffer_replace_text(buffer, at, end - at, piece, n);
+            memmove(reference + at + n, reference + end, length - end + 1);
+            memcpy(reference + at, piece, n);
+            length = length - (end - at) + n;
+        }
+        ASSERT_SUCCESS(result, "Edit succeeds");
+        ASSERT_EQ(buffer->length, length, "Length tracks reference");
+
+        /* Sample a range without closing the gap */
+        char sample[64];
+        size_t start = (size_t)rand() % (length + 1);
+        size_t count = (size_t)rand() % 48;
+        if (count > length - start) {
+            count = length - start;
+        }
+        lle_buffer_copy_text(buffer, start, count, sample);
+        ASSERT_TRUE(memcmp(sample, reference + start, count) == 0,
+                    "Copied range matches reference");
+
+        if (step % 97 == 0) {
+            ASSERT_STR_EQ(lle_buffer_get_text(buffer), reference,
+                          "Materialized text matches reference");
+        }
+    }
+
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), reference,
+                  "Final text matches reference");
+    ASSERT_EQ(buffer->codepoint_count,
+              lle_utf8_count_codepoints(reference, length),
+              "Codepoint count tracks edits");
+
+    lle_buffer_destroy(buffer);
+    PASS();
+}
+
+static void test_gap_utf8_index_updates() {
+    TEST("Edits are spliced into the UTF-8 index");
+
+    lle_buffer_t *buffer = NULL;
+    lle_result_t result = lle_buffer_create(&buffer, test_pool, 0);
+    ASSERT_SUCCESS(result, "Buffer creation succeeds");
+
+    result = lle_buffer_insert_text(buffer, 0, "echo caf\xc3\xa9 latte", 16);
+    ASSERT_SUCCESS(result, "Initial insert");
+    result = lle_buffer_update_utf8_index(buffer);
+    ASSERT_SUCCESS(result, "Index created");
+    ASSERT_EQ(buffer->utf8_index->rebuild_count, 1, "Index built once");
+
+    /* Several keystrokes between index updates */
+    lle_buffer_insert_text(buffer, 5, "\xe4\xb8\x96", 3);
+    lle_buffer_insert_text(buffer, 8, " ", 1);
+    lle_buffer_delete_text(buffer, 14, 1);
+    lle_buffer_replace_text(buffer, 15, 1, "\xcc\x81", 2);
+    ASSERT_TRUE(!buffer->utf8_index_valid, "Edits are pending");
+    ASSERT_TRUE(buffer->gap_open, "Recording edits keeps the gap open");
+
+    result = lle_buffer_update_utf8_index(buffer);
+    ASSERT_SUCCESS(result, "Index updated");
+    ASSERT_EQ(buffer->utf8_index->rebuild_count, 1, "No rebuild");
+    ASSERT_EQ(buffer->utf8_index->splice_count, 1, "Edits spliced at once");
+
+    lle_utf8_index_t fresh;
+    lle_utf8_index_init(&fresh);
+    lle_utf8_index_rebuild(&fresh, lle_buffer_get_text(buffer),
+                           buffer->length);
+    ASSERT_EQ(buffer->utf8_index->codepoint_count, fresh.codepoint_count,
+              "Codepoints match rebuild");
+    ASSERT_EQ(buffer->utf8_index->grapheme_count, fresh.grapheme_count,
+              "Graphemes match rebuild");
+    ASSERT_TRUE(memcmp(buffer->utf8_index->byte_to_codepoint,
+                       fresh.byte_to_codepoint,
+                       (fresh.byte_count + 1) * sizeof(size_t)) == 0,
+                "Byte mapping matches rebuild");
+    ASSERT_TRUE(memcmp(buffer->utf8_index->grapheme_to_display,
+                       fresh.grapheme_to_display,
+                       (fresh.grapheme_count + 1) * sizeof(size_t)) == 0,
+                "Display mapping matches rebuild");
+    lle_utf8_index_cleanup(&fresh);
+
+    /* Clearing drops the index; the next update rebuilds it */
+    lle_buffer_clear(buffer);
+    lle_buffer_insert_text(buffer, 0, "ls", 2);
+    result = lle_buffer_update_utf8_index(buffer);
+    ASSERT_SUCCESS(result, "Index updated after clear");
+    ASSERT_EQ(buffer->utf8_index->rebuild_count, 2, "Rebuilt after clear");
+    ASSERT_EQ(buffer->utf8_index->codepoint_count, 2, "Index follows clear");
+
+    lle_buffer_destroy(buffer);
+    PASS();
+}
+
 /* ============================================================================
  * ERROR HANDLING TESTS
  * ============================================================================
@@ -487,6 +685,12 @@ int main(void) {
     test_insert_delete_sequence();
     test_buffer_growth();
 
+    /* Gap Buffer Tests */
+    printf("\nGap Buffer Tests:\n");
+    test_gap_local_edits();
+    test_gap_random_edits();
+    test_gap_utf8_index_updates();
+
     /* Error Handling Tests */
     printf("\nError Handling Tests:\n");
     test_insert_out_of_bounds();
@@ -179,6 +179,10 @@ executor_t *get_global_executor(void) {
     return NULL; /* No executor in tests */
 }
 
+executor_t *ensure_global_executor(void) {
+    return NULL; /* No executor in tests */
+}
+
 /* ============================================================================
  * Network Functions (for SSH host completion)
  * ============================================================================
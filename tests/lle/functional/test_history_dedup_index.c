@@ -0,0 +1,331 @@
+/**
+ * Functional Test: History Deduplication Index
+ *
+ * Tests the hash index behind duplicate detection:
+ * - Duplicates found through the index for every strategy path
+ * - Dedup scope limits applied to the indexed entry
+ * - Trimming, case folding and NFC applied to index keys
+ * - Index kept in step with clear, load and full scans
+ * - Global dedup over a large history without scanning it
+ */
+
+#include "lle/error_handling.h"
+#include "lle/history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define TEST_HISTORY_FILE "/tmp/lle_test_dedup_index_history.txt"
+#define LARGE_HISTORY_ENTRIES 50000
+
+/* Test counter */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) printf("\n[TEST] %s\n", name)
+#define PASS()                                                                 \
+    do {                                                                       \
+        printf("  PASS\n");                                                    \
+        tests_passed++;                                                        \
+        return;                                                                \
+    } while (0)
+#define FAIL(msg)                                                              \
+    do {                                                                       \
+        printf("  FAIL: %s\n", msg);                                           \
+        tests_failed++;                                                        \
+        return;                                                                \
+    } while (0)
+
+/*
+ * Helper: core with deduplication enabled
+ */
+static lle_history_core_t *create_core(lle_history_dedup_strategy_t strategy,
+                                       lle_history_dedup_scope_t scope) {
+    lle_history_config_t *config = NULL;
+    if (lle_history_config_create_default(&config, NULL) != LLE_SUCCESS) {
+        return NULL;
+    }
+    config->ignore_duplicates = true;
+    config->dedup_strategy = strategy;
+    config->dedup_scope = scope;
+    config->unicode_normalize = true;
+    config->max_entries = LARGE_HISTORY_ENTRIES * 2;
+
+    lle_history_core_t *core = NULL;
+    lle_history_core_create(&core, NULL, config);
+    lle_history_config_destroy(config, NULL);
+    return core;
+}
+
+/*
+ * Helper: number of active entries with exactly this command
+ */
+static size_t count_active(lle_history_core_t *core, const char *command) {
+    size_t total = 0;
+    for (size_t i = 0; i < core->entry_count; i++) {
+        lle_history_entry_t *entry = core->entries[i];
+        if (entry && entry->state == LLE_HISTORY_STATE_ACTIVE &&
+            strcmp(entry->command, command) == 0) {
+            total++;
+        }
+    }
+    return total;
+}
+
+static lle_history_dedup_stats_t get_stats(lle_history_core_t *core) {
+    lle_history_dedup_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    lle_history_dedup_get_stats(core->dedup_engine, &stats);
+    return stats;
+}
+
+/*
+ * Test 1: Repeated commands are found through the index
+ */
+void test_index_hits(void) {
+    TEST("Duplicates found through the index");
+
+    lle_history_core_t *core =
+        create_core(LLE_DEDUP_KEEP_RECENT, LLE_HISTORY_DEDUP_SCOPE_GLOBAL);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    lle_history_add_entry(core, "ls -la", 0, NULL);
+    lle_history_add_entry(core, "pwd", 0, NULL);
+    lle_history_add_entry(core, "ls -la", 0, NULL);
+    lle_history_add_entry(core, "git status", 0, NULL);
+    lle_history_add_entry(core, "ls -la", 0, NULL);
+
+    lle_history_dedup_stats_t stats = get_stats(core);
+    lle_history_entry_t *last = core->entries[core->entry_count - 1];
+    bool ok = count_active(core, "ls -la") == 1 &&
+              count_active(core, "pwd") == 1 &&
+              last->state == LLE_HISTORY_STATE_ACTIVE &&
+              strcmp(last->command, "ls -la") == 0 &&
+              stats.duplicates_detected == 2 && stats.index_hits == 2 &&
+              stats.index_fallbacks == 0;
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Duplicate not merged into the newest entry");
+    }
+
+    /* IGNORE keeps the indexed entry, so it keeps being found */
+    core = create_core(LLE_DEDUP_IGNORE, LLE_HISTORY_DEDUP_SCOPE_GLOBAL);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+    lle_history_add_entry(core, "make", 0, NULL);
+    lle_history_add_entry(core, "make", 0, NULL);
+    lle_history_add_entry(core, "make", 0, NULL);
+    stats = get_stats(core);
+    ok = core->entry_count == 1 && stats.index_hits == 2;
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Ignored duplicate not found through the index");
+    }
+    PASS();
+}
+
+/*
+ * Test 2: The indexed entry must lie within the dedup scope
+ */
+void test_scope_limits(void) {
+    TEST("Dedup scope limits");
+
+    lle_history_core_t *core =
+        create_core(LLE_DEDUP_KEEP_RECENT, LLE_HISTORY_DEDUP_SCOPE_RECENT);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    char command[64];
+    lle_history_add_entry(core, "old command", 0, NULL);
+    for (int i = 0; i < 150; i++) {
+        snprintf(command, sizeof(command), "echo %d", i);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+
+    /* 151 entries back: outside the last-100 scope */
+    lle_history_add_entry(core, "old command", 0, NULL);
+    bool ok = count_active(core, "old command") == 2;
+
+    /* Now the newest copy is in scope */
+    lle_history_add_entry(core, "old command", 0, NULL);
+    ok = ok && count_active(core, "old command") == 2 &&
+         get_stats(core).index_hits == 1;
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Scope not respected");
+    }
+    PASS();
+}
+
+/*
+ * Test 3: Keys apply the configured comparison rules
+ */
+void test_key_normalization(void) {
+    TEST("Trimmed, case-folded and NFC keys");
+
+    lle_history_core_t *core =
+        create_core(LLE_DEDUP_KEEP_RECENT, LLE_HISTORY_DEDUP_SCOPE_GLOBAL);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    /* Precomposed U+00E9, then "e" + COMBINING ACUTE ACCENT, padded */
+    lle_history_add_entry(core, "echo caf\xc3\xa9", 0, NULL);
+    lle_history_add_entry(core, "\techo cafe\xcc\x81  ", 0, NULL);
+    bool ok = count_active(core, "echo caf\xc3\xa9") == 0 &&
+              get_stats(core).index_hits == 1;
+
+    /* Case-insensitive: ASCII and Latin-1 letters fold */
+    lle_history_dedup_configure(core->dedup_engine, false, true, true);
+    lle_history_add_entry(core, "Make Install", 0, NULL);
+    lle_history_add_entry(core, "MAKE INSTALL", 0, NULL);
+    lle_history_add_entry(core, "echo \xc3\x89t\xc3\xa9", 0, NULL);
+    lle_history_add_entry(core, "echo \xc3\xa9t\xc3\xa9", 0, NULL);
+    ok = ok && count_active(core, "Make Install") == 0 &&
+         count_active(core, "MAKE INSTALL") == 1 &&
+         count_active(core, "echo \xc3\x89t\xc3\xa9") == 0 &&
+         get_stats(core).index_hits == 3;
+
+    /* Same key, different letters: each add falls back to a scan */
+    lle_history_add_entry(core, "echo \xc3\xbct\xc3\xa9", 0, NULL);
+    lle_history_add_entry(core, "echo \xc3\xa9t\xc3\xa9", 0, NULL);
+    lle_history_dedup_stats_t stats = get_stats(core);
+    ok = ok && count_active(core, "echo \xc3\xbct\xc3\xa9") == 1 &&
+         count_active(core, "echo \xc3\xa9t\xc3\xa9") == 1 &&
+         stats.index_fallbacks == 2 && stats.duplicates_detected == 4;
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Normalized duplicate handled incorrectly");
+    }
+    PASS();
+}
+
+/*
+ * Test 4: Index follows clear, load and full scans
+ */
+void test_index_maintenance(void) {
+    TEST("Index maintained by clear, load and full scan");
+
+    lle_history_core_t *core =
+        create_core(LLE_DEDUP_KEEP_RECENT, LLE_HISTORY_DEDUP_SCOPE_GLOBAL);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    lle_history_add_entry(core, "cargo build", 0, NULL);
+    lle_history_add_entry(core, "cargo test", 0, NULL);
+    lle_history_clear(core);
+
+    /* Cleared entries are gone from the index */
+    lle_history_add_entry(core, "cargo test", 0, NULL);
+    lle_history_add_entry(core, "cargo build", 0, NULL);
+    bool ok = core->entry_count == 2 && get_stats(core).index_hits == 0;
+
+    /* Loaded entries bypass dedup but are indexed for later checks */
+    lle_history_add_entry(core, "cargo run", 0, NULL);
+    ok = ok && lle_history_save_to_file(core, TEST_HISTORY_FILE) ==
+                   LLE_SUCCESS;
+    lle_history_clear(core);
+    ok = ok && lle_history_load_from_file(core, TEST_HISTORY_FILE) ==
+                   LLE_SUCCESS;
+    lle_history_add_entry(core, "cargo test", 0, NULL);
+    ok = ok && count_active(core, "cargo test") == 1 &&
+         get_stats(core).index_hits == 1;
+
+    /* A full scan retires loaded duplicates and refreshes the index */
+    lle_history_load_from_file(core, TEST_HISTORY_FILE);
+    size_t removed = 0;
+    lle_history_dedup_full_scan(core->dedup_engine, &removed);
+    lle_history_add_entry(core, "cargo run", 0, NULL);
+    ok = ok && removed == 3 && count_active(core, "cargo run") == 1 &&
+         count_active(core, "cargo build") == 1 &&
+         get_stats(core).index_fallbacks == 0;
+
+    lle_history_core_destroy(core);
+    remove(TEST_HISTORY_FILE);
+    if (!ok) {
+        FAIL("Index out of step with history");
+    }
+    PASS();
+}
+
+/*
+ * Test 5: Global dedup over a large history
+ */
+void test_large_history(void) {
+    TEST("Global dedup over a large history");
+
+    lle_history_core_t *core =
+        create_core(LLE_DEDUP_KEEP_RECENT, LLE_HISTORY_DEDUP_SCOPE_GLOBAL);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    char command[64];
+    for (int i = 0; i < LARGE_HISTORY_ENTRIES; i++) {
+        snprintf(command, sizeof(command), "make -j%d target_%d", i % 16, i);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+
+    /* Re-run the oldest commands: each matches at the far end */
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < 1000; i++) {
+        snprintf(command, sizeof(command), "make -j%d target_%d", i % 16, i);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+    gettimeofday(&end, NULL);
+    long elapsed_us = (end.tv_sec - start.tv_sec) * 1000000L +
+                      (end.tv_usec - start.tv_usec);
+    printf("  1000 duplicate adds in %ld us\n", elapsed_us);
+
+    lle_history_dedup_stats_t stats = get_stats(core);
+    bool ok = stats.index_hits == 1000 && stats.index_fallbacks == 0 &&
+              count_active(core, "make -j0 target_0") == 1 &&
+              core->entries[0]->state == LLE_HISTORY_STATE_DELETED;
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Old duplicates not found through the index");
+    }
+    PASS();
+}
+
+/*
+ * Main test runner
+ */
+int main(void) {
+    printf("=================================================\n");
+    printf("History Deduplication Index - Functional Tests\n");
+    printf("=================================================\n");
+
+    test_index_hits();
+    test_scope_limits();
+    test_key_normalization();
+    test_index_maintenance();
+    test_large_history();
+
+    /* Summary */
+    printf("\n=================================================\n");
+    printf("Test Results:\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("=================================================\n");
+
+    if (tests_failed == 0) {
+        printf("ALL FUNCTIONAL TESTS PASSED\n");
+        printf("=================================================\n");
+        return 0;
+    } else {
+        printf("SOME TESTS FAILED\n");
+        printf("=================================================\n");
+        return 1;
+    }
+}
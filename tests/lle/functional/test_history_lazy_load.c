@@ -0,0 +1,432 @@
+/**
+ * Functional Test: Lazy History Loading
+ *
+ * Tests loading a history file without decoding its entries:
+ * - Entries are decoded on access and kept in a bounded LRU cache
+ * - Lookups by ID and prefix reach entries that were never decoded
+ * - Search results outlive the entries they were taken from
+ * - Dedup marks on lazy entries survive eviction and are saved
+ * - Saving over the mapped file keeps every entry readable
+ * - A full dedup scan decodes the whole history
+ * - A large history loads without decoding it
+ */
+
+#include "lle/error_handling.h"
+#include "lle/history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define TEST_HISTORY_FILE "/tmp/lle_test_lazy_load_history.txt"
+#define TEST_INDEX_FILE TEST_HISTORY_FILE ".idx"
+#define TEST_CACHE_SIZE 16
+#define LARGE_HISTORY_ENTRIES 500000
+
+/* Test counter */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) printf("\n[TEST] %s\n", name)
+#define PASS()                                                                 \
+    do {                                                                       \
+        printf("  PASS\n");                                                    \
+        tests_passed++;                                                        \
+        return;                                                                \
+    } while (0)
+#define FAIL(msg)                                                              \
+    do {                                                                       \
+        printf("  FAIL: %s\n", msg);                                           \
+        tests_failed++;                                                        \
+        return;                                                                \
+    } while (0)
+
+/*
+ * Helper: core loading lazily (or not) with a small cache
+ */
+static lle_history_core_t *create_core(bool lazy, bool dedup) {
+    lle_history_config_t *config = NULL;
+    if (lle_history_config_create_default(&config, NULL) != LLE_SUCCESS) {
+        return NULL;
+    }
+    config->max_entries = LARGE_HISTORY_ENTRIES * 2;
+    config->lazy_load = lazy;
+    config->lazy_cache_size = TEST_CACHE_SIZE;
+    config->ignore_duplicates = dedup;
+    config->dedup_strategy = LLE_DEDUP_KEEP_RECENT;
+    config->dedup_scope = LLE_HISTORY_DEDUP_SCOPE_GLOBAL;
+
+    lle_history_core_t *core = NULL;
+    lle_history_core_create(&core, NULL, config);
+    lle_history_config_destroy(config, NULL);
+    return core;
+}
+
+static void remove_files(void) {
+    unlink(TEST_HISTORY_FILE);
+    unlink(TEST_INDEX_FILE);
+}
+
+/*
+ * Helper: save "cmd <i>" for i in [0, count) with a plain core
+ */
+static bool save_numbered(size_t count) {
+    lle_history_core_t *core = create_core(false, false);
+    if (!core) {
+        return false;
+    }
+    char command[64];
+    for (size_t i = 0; i < count; i++) {
+        snprintf(command, sizeof(command), "cmd %zu", i);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+    return ok;
+}
+
+/* Number of entries currently decoded */
+static size_t count_decoded(lle_history_core_t *core) {
+    size_t decoded = 0;
+    for (size_t i = 0; i < core->entry_count; i++) {
+        decoded += core->entries[i] != NULL;
+    }
+    return decoded;
+}
+
+static long elapsed_us(const struct timeval *start) {
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return (end.tv_sec - start->tv_sec) * 1000000L +
+           (end.tv_usec - start->tv_usec);
+}
+
+/*
+ * Test 1: Entries are decoded on access, within the cache size
+ */
+void test_decode_on_access(void) {
+    TEST("Entries decoded on access within the cache");
+
+    remove_files();
+    lle_history_core_t *core = create_core(true, false);
+    if (!core || !save_numbered(1000)) {
+        lle_history_core_destroy(core);
+        FAIL("Failed to save history");
+    }
+
+    bool ok = lle_history_load_from_file(core, TEST_HISTORY_FILE) ==
+                  LLE_SUCCESS &&
+              core->entry_count == 1000 && count_decoded(core) == 0 &&
+              lle_history_lazy_count(core) == 1000;
+
+    /* Walk the whole history the way up-arrow does */
+    char expected[64];
+    for (size_t i = 1000; ok && i > 0; i--) {
+        lle_history_entry_t *entry = NULL;
+        snprintf(expected, sizeof(expected), "cmd %zu", i - 1);
+        ok = lle_history_get_entry_by_index(core, i - 1, &entry) ==
+                 LLE_SUCCESS &&
+             strcmp(entry->command, expected) == 0 &&
+             entry->entry_id == i && count_decoded(core) <= TEST_CACHE_SIZE;
+    }
+    ok = ok && count_decoded(core) == TEST_CACHE_SIZE;
+
+    /* Touching the least recently used entry keeps it over newer ones */
+    lle_history_entry_t *entry = NULL;
+    lle_history_get_entry_by_index(core, TEST_CACHE_SIZE - 1, &entry);
+    for (size_t i = 100; ok && i < 100 + TEST_CACHE_SIZE - 1; i++) {
+        lle_history_get_entry_by_index(core, i, &entry);
+    }
+    ok = ok && core->entries[TEST_CACHE_SIZE - 1] != NULL &&
+         core->entries[0] == NULL;
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("Lazy entries decoded incorrectly");
+    }
+    PASS();
+}
+
+/*
+ * Test 2: Lookups by ID, prefix and search reach lazy entries
+ */
+void test_lookups(void) {
+    TEST("Lookups by ID, prefix and search");
+
+    remove_files();
+    lle_history_core_t *core = create_core(true, false);
+    if (!core || !save_numbered(500)) {
+        lle_history_core_destroy(core);
+        FAIL("Failed to save history");
+    }
+    lle_history_load_from_file(core, TEST_HISTORY_FILE);
+    lle_history_add_entry(core, "cmd 42 resident", 0, NULL);
+
+    lle_history_entry_t *entry = NULL;
+    bool ok = lle_history_get_entry_by_id(core, 43, &entry) == LLE_SUCCESS &&
+              strcmp(entry->command, "cmd 42") == 0;
+    ok = ok && lle_history_get_entry_by_id(core, 501, &entry) ==
+                   LLE_SUCCESS &&
+         strcmp(entry->command, "cmd 42 resident") == 0;
+    ok = ok && lle_history_get_entry_by_id(core, 502, &entry) ==
+                   LLE_ERROR_NOT_FOUND;
+
+    /* The resident entry is newer; a lazy one is found by a scan */
+    ok = ok &&
+         lle_history_find_prefix_match(core, "cmd 4", 5, &entry) ==
+             LLE_SUCCESS &&
+         entry && strcmp(entry->command, "cmd 42 resident") == 0;
+    ok = ok &&
+         lle_history_find_prefix_match(core, "cmd 13", 6, &entry) ==
+             LLE_SUCCESS &&
+         entry && strcmp(entry->command, "cmd 139") == 0;
+    ok = ok &&
+         lle_history_find_prefix_match(core, "cmd 499", 7, &entry) ==
+             LLE_SUCCESS &&
+         !entry;
+
+    /* Results stay valid while the cache turns over many times */
+    lle_history_search_results_t *results =
+        lle_history_search_substring(core, "cmd", 400);
+    ok = ok && results && lle_history_search_results_get_count(results) == 400;
+    for (size_t i = 0; ok && i < 400; i++) {
+        const lle_search_result_t *result =
+            lle_history_search_results_get(results, i);
+        ok = result && strncmp(result->command, "cmd ", 4) == 0;
+    }
+    lle_history_search_results_destroy(results);
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("Lazy entries not found");
+    }
+    PASS();
+}
+
+/*
+ * Test 3: Dedup marks on lazy entries survive eviction and saving
+ */
+void test_dedup_write_back(void) {
+    TEST("Dedup marks kept through eviction and save");
+
+    remove_files();
+    lle_history_core_t *core = create_core(true, true);
+    if (!core || !save_numbered(200)) {
+        lle_history_core_destroy(core);
+        FAIL("Failed to save history");
+    }
+    lle_history_load_from_file(core, TEST_HISTORY_FILE);
+
+    /* Each add finds its duplicate among the lazy entries */
+    lle_history_add_entry(core, "cmd 7", 0, NULL);
+    lle_history_add_entry(core, "cmd 150", 0, NULL);
+    lle_history_dedup_stats_t stats;
+    lle_history_dedup_get_stats(core->dedup_engine, &stats);
+    bool ok = core->entry_count == 202 && stats.index_hits == 2;
+
+    /* Evict the marked entries, then save from the mapped file */
+    lle_history_entry_t *entry = NULL;
+    for (size_t i = 0; i < 200; i++) {
+        lle_history_get_entry_by_index(core, i, &entry);
+    }
+    ok = ok && core->entries[7] == NULL &&
+         lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    core = create_core(false, false);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->entry_count == 200 &&
+         strcmp(core->entries[198]->command, "cmd 7") == 0 &&
+         strcmp(core->entries[199]->command, "cmd 150") == 0 &&
+         strcmp(core->entries[7]->command, "cmd 8") == 0;
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("Dedup mark lost");
+    }
+    PASS();
+}
+
+/*
+ * Test 4: Saving over the mapped file keeps the entries readable
+ */
+void test_save_over_mapped_file(void) {
+    TEST("Save over the mapped file");
+
+    remove_files();
+    const char *commands[] = {
+        "echo 'a\tb'",
+        "printf 'line1\nline2'",
+        "echo C:\\\\path \\x",
+        "echo \xe2\x9c\x93 done",
+    };
+    size_t count = sizeof(commands) / sizeof(commands[0]);
+
+    lle_history_core_t *core = create_core(false, false);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+    for (size_t i = 0; i < count; i++) {
+        lle_history_add_entry(core, commands[i], (int)i, NULL);
+    }
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    /* Save twice: the second save copies lines of the replaced file */
+    core = create_core(true, false);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_add_entry(core, "after save", 0, NULL);
+    ok = ok && lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    for (size_t i = 0; ok && i < count; i++) {
+        lle_history_entry_t *entry = NULL;
+        ok = lle_history_get_entry_by_index(core, i, &entry) == LLE_SUCCESS &&
+             strcmp(entry->command, commands[i]) == 0 &&
+             entry->exit_code == (int)i;
+    }
+    lle_history_core_destroy(core);
+
+    core = create_core(false, false);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->entry_count == count + 1 &&
+         strcmp(core->entries[count]->command, "after save") == 0;
+    for (size_t i = 0; ok && i < count; i++) {
+        ok = strcmp(core->entries[i]->command, commands[i]) == 0;
+    }
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("Entries changed by saving");
+    }
+    PASS();
+}
+
+/*
+ * Test 5: A full dedup scan decodes the whole history
+ */
+void test_full_scan_materializes(void) {
+    TEST("Full dedup scan decodes every entry");
+
+    remove_files();
+    lle_history_core_t *core = create_core(false, false);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+    char command[64];
+    for (size_t i = 0; i < 300; i++) {
+        snprintf(command, sizeof(command), "cmd %zu", i % 100);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    core = create_core(true, true);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->lazy != NULL;
+
+    size_t removed = 0;
+    lle_history_entry_t *entry = NULL;
+    ok = ok &&
+         lle_history_dedup_full_scan(core->dedup_engine, &removed) ==
+             LLE_SUCCESS &&
+         removed == 200 && core->lazy == NULL &&
+         count_decoded(core) == 300 &&
+         lle_history_get_entry_by_id(core, 300, &entry) == LLE_SUCCESS &&
+         strcmp(entry->command, "cmd 99") == 0 &&
+         core->first_entry == core->entries[0] &&
+         core->last_entry == core->entries[299];
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("History not fully decoded");
+    }
+    PASS();
+}
+
+/*
+ * Test 6: A large history loads without being decoded
+ */
+void test_large_history(void) {
+    TEST("Large history loaded lazily");
+
+    remove_files();
+    if (!save_numbered(LARGE_HISTORY_ENTRIES)) {
+        FAIL("Failed to save history");
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    lle_history_core_t *core = create_core(false, false);
+    bool ok = core && lle_history_load_from_file(core, TEST_HISTORY_FILE) ==
+                          LLE_SUCCESS;
+    long eager_us = elapsed_us(&start);
+    lle_history_core_destroy(core);
+
+    gettimeofday(&start, NULL);
+    core = create_core(true, false);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    long lazy_us = elapsed_us(&start);
+    printf("  %d entries: eager %ld us, lazy %ld us\n", LARGE_HISTORY_ENTRIES,
+           eager_us, lazy_us);
+
+    /* Newest and oldest entries, as up-arrow and fc reach them */
+    lle_history_entry_t *entry = NULL;
+    ok = ok && core->entry_count == LARGE_HISTORY_ENTRIES &&
+         lle_history_get_entry_by_reverse_index(core, 0, &entry) ==
+             LLE_SUCCESS &&
+         strcmp(entry->command, "cmd 499999") == 0 &&
+         lle_history_get_entry_by_index(core, 0, &entry) == LLE_SUCCESS &&
+         strcmp(entry->command, "cmd 0") == 0 &&
+         count_decoded(core) == 2;
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("Large history not loaded lazily");
+    }
+    PASS();
+}
+
+/*
+ * Main test runner
+ */
+int main(void) {
+    printf("=================================================\n");
+    printf("Lazy History Loading - Functional Tests\n");
+    printf("=================================================\n");
+
+    test_decode_on_access();
+    test_lookups();
+    test_dedup_write_back();
+    test_save_over_mapped_file();
+    test_full_scan_materializes();
+    test_large_history();
+
+    /* Summary */
+    printf("\n=================================================\n");
+    printf("Test Results:\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("=================================================\n");
+
+    if (tests_failed == 0) {
+        printf("ALL FUNCTIONAL TESTS PASSED\n");
+        printf("=================================================\n");
+        return 0;
+    } else {
+        printf("SOME TESTS FAILED\n");
+        printf("=================================================\n");
+        return 1;
+    }
+}
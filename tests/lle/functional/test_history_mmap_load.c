@@ -0,0 +1,423 @@
+/**
+ * Functional Test: History File Loading
+ *
+ * Tests the mapped history loader and its index file:
+ * - Escapes, exit codes and working directories survive a round trip
+ * - Comments, blank and malformed lines are skipped
+ * - A current index is used, a stale one is ignored
+ * - No index is written when the index file is disabled
+ * - Loading stops at max_entries
+ * - A large history loads quickly with and without its index
+ */
+
+#include "lle/error_handling.h"
+#include "lle/history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define TEST_HISTORY_FILE "/tmp/lle_test_mmap_load_history.txt"
+#define TEST_INDEX_FILE TEST_HISTORY_FILE ".idx"
+#define LARGE_HISTORY_ENTRIES 500000
+
+/* Test counter */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) printf("\n[TEST] %s\n", name)
+#define PASS()                                                                 \
+    do {                                                                       \
+        printf("  PASS\n");                                                    \
+        tests_passed++;                                                        \
+        return;                                                                \
+    } while (0)
+#define FAIL(msg)                                                              \
+    do {                                                                       \
+        printf("  FAIL: %s\n", msg);                                           \
+        tests_failed++;                                                        \
+        return;                                                                \
+    } while (0)
+
+/*
+ * Helper: core holding up to max_entries entries
+ */
+static lle_history_core_t *create_core(size_t max_entries, bool index_file) {
+    lle_history_config_t *config = NULL;
+    if (lle_history_config_create_default(&config, NULL) != LLE_SUCCESS) {
+        return NULL;
+    }
+    config->max_entries = max_entries;
+    config->use_index_file = index_file;
+
+    lle_history_core_t *core = NULL;
+    lle_history_core_create(&core, NULL, config);
+    lle_history_config_destroy(config, NULL);
+    return core;
+}
+
+static void remove_files(void) {
+    unlink(TEST_HISTORY_FILE);
+    unlink(TEST_INDEX_FILE);
+}
+
+static bool write_file(const char *path, const char *text) {
+    FILE *fp = fopen(path, "w");
+    if (!fp) {
+        return false;
+    }
+    bool ok = fputs(text, fp) >= 0;
+    return fclose(fp) == 0 && ok;
+}
+
+static long elapsed_us(const struct timeval *start) {
+    struct timeval end;
+    gettimeofday(&end, NULL);
+    return (end.tv_sec - start->tv_sec) * 1000000L +
+           (end.tv_usec - start->tv_usec);
+}
+
+/*
+ * Test 1: Entries survive a save and load unchanged
+ */
+void test_round_trip(void) {
+    TEST("Round trip of escapes, exit codes and directories");
+
+    lle_history_core_t *core = create_core(1000, true);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    const char *commands[] = {
+        "echo 'a\tb'",
+        "printf 'line1\nline2'",
+        "echo C:\\\\path\\\\to \\x \\",
+        "echo \xe2\x9c\x93 done",
+    };
+    const int exit_codes[] = {0, -1, 127, 2};
+    size_t count = sizeof(commands) / sizeof(commands[0]);
+    for (size_t i = 0; i < count; i++) {
+        lle_history_add_entry(core, commands[i], exit_codes[i], NULL);
+        lle_history_entry_t *entry = core->entries[i];
+        entry->timestamp = 1700000000 + i;
+        lle_pool_free(entry->working_directory);
+        entry->working_directory = strdup(i == 3 ? "/tmp/a\tdir" : "/srv");
+    }
+
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    core = create_core(1000, true);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->entry_count == count;
+    for (size_t i = 0; ok && i < count; i++) {
+        lle_history_entry_t *entry = core->entries[i];
+        ok = strcmp(entry->command, commands[i]) == 0 &&
+             entry->command_length == strlen(commands[i]) &&
+             entry->exit_code == exit_codes[i] &&
+             entry->timestamp == 1700000000 + i &&
+             entry->entry_id == i + 1 &&
+             strcmp(entry->working_directory,
+                    i == 3 ? "/tmp/a\tdir" : "/srv") == 0;
+    }
+
+    lle_history_core_destroy(core);
+    remove_files();
+    if (!ok) {
+        FAIL("Loaded entries differ from saved ones");
+    }
+    PASS();
+}
+
+/*
+ * Test 2: Lines that hold no entry are skipped
+ */
+void test_malformed_lines(void) {
+    TEST("Comments, blank and malformed lines skipped");
+
+    if (!write_file(TEST_HISTORY_FILE,
+                    "# LLE History File v1.0\n"
+                    "\n"
+                    "100\tls\t0\t/home\n"
+                    "not a number\tpwd\t0\t/\n"
+                    "200\n"
+                    "300\t\t0\t/\n"
+                    "400 make\n"
+                    "500\tgit status\n"
+                    "600\tgit diff\tx\t/ignored\n"
+                    "700\tcargo test\t-3\t\n"
+                    "800\tno newline\t1\t/opt")) {
+        FAIL("Failed to write history file");
+    }
+
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd))) {
+        FAIL("getcwd failed");
+    }
+
+    lle_history_core_t *core = create_core(1000, true);
+    bool ok = core &&
+              lle_history_load_from_file(core, TEST_HISTORY_FILE) ==
+                  LLE_SUCCESS &&
+              core->entry_count == 5;
+    ok = ok && strcmp(core->entries[0]->command, "ls") == 0 &&
+         strcmp(core->entries[0]->working_directory, "/home") == 0;
+    ok = ok && strcmp(core->entries[1]->command, "git status") == 0 &&
+         core->entries[1]->timestamp == 500 &&
+         core->entries[1]->exit_code == 0 &&
+         strcmp(core->entries[1]->working_directory, cwd) == 0;
+    ok = ok && strcmp(core->entries[2]->command, "git diff") == 0 &&
+         core->entries[2]->exit_code == 0 &&
+         strcmp(core->entries[2]->working_directory, cwd) == 0;
+    ok = ok && core->entries[3]->exit_code == -3 &&
+         strcmp(core->entries[3]->working_directory, cwd) == 0;
+    ok = ok && strcmp(core->entries[4]->command, "no newline") == 0 &&
+         strcmp(core->entries[4]->working_directory, "/opt") == 0;
+
+    if (core) {
+        lle_history_core_destroy(core);
+    }
+    remove_files();
+    if (!ok) {
+        FAIL("Lines parsed incorrectly");
+    }
+    PASS();
+}
+
+/*
+ * Test 3: A current index is used, a stale one ignored
+ */
+void test_index_file(void) {
+    TEST("Current index used, stale index ignored");
+
+    lle_history_core_t *core = create_core(1000, true);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+    lle_history_add_entry(core, "first", 0, NULL);
+    lle_history_add_entry(core, "second", 0, NULL);
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    struct stat st;
+    ok = ok && stat(TEST_INDEX_FILE, &st) == 0;
+    if (!ok) {
+        remove_files();
+        FAIL("Index not written on save");
+    }
+
+    /* Mark the indexed timestamps; the history file itself is unchanged */
+    FILE *fp = fopen(TEST_INDEX_FILE, "r+b");
+    if (!fp) {
+        remove_files();
+        FAIL("Failed to open index");
+    }
+    uint64_t header[6];
+    uint64_t record[3];
+    ok = fread(header, sizeof(header), 1, fp) == 1 && header[5] == 2;
+    for (int i = 0; ok && i < 2; i++) {
+        long pos = ftell(fp);
+        ok = fread(record, sizeof(record), 1, fp) == 1;
+        record[2] = 42 + (uint64_t)i;
+        ok = ok && fseek(fp, pos, SEEK_SET) == 0 &&
+             fwrite(record, sizeof(record), 1, fp) == 1 &&
+             fseek(fp, 0, SEEK_CUR) == 0;
+    }
+    fclose(fp);
+
+    core = create_core(1000, true);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->entry_count == 2 && core->entries[0]->timestamp == 42 &&
+         core->entries[1]->timestamp == 43 &&
+         strcmp(core->entries[1]->command, "second") == 0;
+    if (core) {
+        lle_history_core_destroy(core);
+    }
+
+    /* Appending changes the file; the index no longer describes it */
+    lle_history_entry_t *entry = NULL;
+    lle_history_entry_create(&entry, "third", NULL);
+    entry->timestamp = 99;
+    ok = ok && lle_history_append_entry(entry, TEST_HISTORY_FILE) ==
+                   LLE_SUCCESS;
+    lle_history_entry_destroy(entry, NULL);
+
+    core = create_core(1000, true);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->entry_count == 3 && core->entries[0]->timestamp != 42 &&
+         strcmp(core->entries[2]->command, "third") == 0 &&
+         core->entries[2]->timestamp == 99;
+    if (core) {
+        lle_history_core_destroy(core);
+    }
+
+    remove_files();
+    if (!ok) {
+        FAIL("Index handled incorrectly");
+    }
+    PASS();
+}
+
+/*
+ * Test 4: No index when the index file is disabled
+ */
+void test_index_disabled(void) {
+    TEST("Index file disabled");
+
+    remove_files();
+    lle_history_core_t *core = create_core(1000, false);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+    lle_history_add_entry(core, "echo hello", 0, NULL);
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    struct stat st;
+    ok = ok && stat(TEST_INDEX_FILE, &st) != 0;
+
+    core = create_core(1000, false);
+    ok = ok && core &&
+         lle_history_load_from_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS &&
+         core->entry_count == 1;
+    if (core) {
+        lle_history_core_destroy(core);
+    }
+
+    remove_files();
+    if (!ok) {
+        FAIL("Index written or history not loaded");
+    }
+    PASS();
+}
+
+/*
+ * Test 5: Loading stops once the history is full
+ */
+void test_capacity_limit(void) {
+    TEST("Loading stops at max_entries");
+
+    lle_history_core_t *core = create_core(2000, true);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+    char command[64];
+    for (int i = 0; i < 1500; i++) {
+        snprintf(command, sizeof(command), "echo %d", i);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    /* Once through the index, once through the plain file */
+    for (int pass = 0; ok && pass < 2; pass++) {
+        core = create_core(1000, pass == 0);
+        ok = core &&
+             lle_history_load_from_file(core, TEST_HISTORY_FILE) ==
+                 LLE_SUCCESS &&
+             core->entry_count == 1000 &&
+             strcmp(core->entries[999]->command, "echo 999") == 0;
+        if (core) {
+            lle_history_core_destroy(core);
+        }
+    }
+
+    remove_files();
+    if (!ok) {
+        FAIL("Capacity not respected");
+    }
+    PASS();
+}
+
+/*
+ * Test 6: A large history loads quickly
+ */
+void test_large_history(void) {
+    TEST("Large history load");
+
+    lle_history_core_t *core = create_core(LARGE_HISTORY_ENTRIES, true);
+    if (!core) {
+        FAIL("Failed to create core");
+    }
+
+    char command[96];
+    for (int i = 0; i < LARGE_HISTORY_ENTRIES; i++) {
+        snprintf(command, sizeof(command),
+                 "git commit -m 'change %d' --author=\"dev\\t%d\"", i, i % 97);
+        lle_history_add_entry(core, command, i % 3, NULL);
+    }
+    bool ok = lle_history_save_to_file(core, TEST_HISTORY_FILE) == LLE_SUCCESS;
+    lle_history_core_destroy(core);
+
+    struct timeval start;
+    long indexed_us = 0, plain_us = 0;
+    for (int pass = 0; ok && pass < 2; pass++) {
+        core = create_core(LARGE_HISTORY_ENTRIES, pass == 0);
+        gettimeofday(&start, NULL);
+        ok = core &&
+             lle_history_load_from_file(core, TEST_HISTORY_FILE) ==
+                 LLE_SUCCESS;
+        if (pass == 0) {
+            indexed_us = elapsed_us(&start);
+        } else {
+            plain_us = elapsed_us(&start);
+        }
+
+        snprintf(command, sizeof(command),
+                 "git commit -m 'change %d' --author=\"dev\\t%d\"",
+                 LARGE_HISTORY_ENTRIES - 1,
+                 (LARGE_HISTORY_ENTRIES - 1) % 97);
+        ok = ok && core->entry_count == LARGE_HISTORY_ENTRIES &&
+             strcmp(core->entries[LARGE_HISTORY_ENTRIES - 1]->command,
+                    command) == 0;
+        if (core) {
+            lle_history_core_destroy(core);
+        }
+    }
+    printf("  %d entries: %ld us with index, %ld us without\n",
+           LARGE_HISTORY_ENTRIES, indexed_us, plain_us);
+
+    remove_files();
+    if (!ok) {
+        FAIL("Large history not loaded");
+    }
+    PASS();
+}
+
+/*
+ * Main test runner
+ */
+int main(void) {
+    printf("=================================================\n");
+    printf("History File Loading - Functional Tests\n");
+    printf("=================================================\n");
+
+    test_round_trip();
+    test_malformed_lines();
+    test_index_file();
+    test_index_disabled();
+    test_capacity_limit();
+    test_large_history();
+
+    /* Summary */
+    printf("\n=================================================\n");
+    printf("Test Results:\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("=================================================\n");
+
+    if (tests_failed == 0) {
+        printf("ALL FUNCTIONAL TESTS PASSED\n");
+        printf("=================================================\n");
+        return 0;
+    } else {
+        printf("SOME TESTS FAILED\n");
+        printf("=================================================\n");
+        return 1;
+    }
+}
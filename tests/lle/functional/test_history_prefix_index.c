@@ -0,0 +1,275 @@
+/**
+ * Functional Test: History Prefix Index
+ *
+ * Tests the autosuggestion prefix index:
+ * - Most recent entry extending a prefix
+ * - Entries equal to the prefix and multiline entries are skipped
+ * - NFC normalization of keys and queries
+ * - Index maintained by add, clear, load and rebuild
+ * - Matches found beyond the old 5000-entry suggestion scan window
+ */
+
+#include "lle/error_handling.h"
+#include "lle/history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define TEST_HISTORY_FILE "/tmp/lle_test_prefix_index_history.txt"
+#define LARGE_HISTORY_ENTRIES 20000
+
+/* Test counter */
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) printf("\n[TEST] %s\n", name)
+#define PASS()                                                                 \
+    do {                                                                       \
+        printf("  PASS\n");                                                    \
+        tests_passed++;                                                        \
+        return;                                                                \
+    } while (0)
+#define FAIL(msg)                                                              \
+    do {                                                                       \
+        printf("  FAIL: %s\n", msg);                                           \
+        tests_failed++;                                                        \
+        return;                                                                \
+    } while (0)
+
+/*
+ * Helper: command suggested for a prefix, or NULL
+ */
+static const char *suggest(lle_history_core_t *core, const char *prefix) {
+    lle_history_entry_t *entry = NULL;
+    if (lle_history_find_prefix_match(core, prefix, strlen(prefix), &entry) !=
+            LLE_SUCCESS ||
+        !entry) {
+        return NULL;
+    }
+    return entry->command;
+}
+
+static bool suggests(lle_history_core_t *core, const char *prefix,
+                     const char *expected) {
+    const char *got = suggest(core, prefix);
+    if (!expected) {
+        return got == NULL;
+    }
+    return got && strcmp(got, expected) == 0;
+}
+
+/*
+ * Test 1: Newest entry extending the prefix wins
+ */
+void test_most_recent_match(void) {
+    TEST("Most recent entry extending a prefix");
+
+    lle_history_core_t *core = NULL;
+    if (lle_history_core_create(&core, NULL, NULL) != LLE_SUCCESS) {
+        FAIL("Failed to create core");
+    }
+
+    lle_history_add_entry(core, "git status", 0, NULL);
+    lle_history_add_entry(core, "git commit -m first", 0, NULL);
+    lle_history_add_entry(core, "ls -la", 0, NULL);
+    lle_history_add_entry(core, "git checkout main", 0, NULL);
+    lle_history_add_entry(core, "git commit --amend", 0, NULL);
+
+    bool ok = suggests(core, "git c", "git commit --amend") &&
+              suggests(core, "git ch", "git checkout main") &&
+              suggests(core, "git s", "git status") &&
+              suggests(core, "git commit -", "git commit --amend") &&
+              suggests(core, "git commit -m", "git commit -m first") &&
+              suggests(core, "ls", "ls -la") &&
+              suggests(core, "gi", "git commit --amend") &&
+              suggests(core, "xyz", NULL) && suggests(core, "git x", NULL);
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Wrong suggestion");
+    }
+    PASS();
+}
+
+/*
+ * Test 2: Exact and multiline entries are not suggested
+ */
+void test_skipped_entries(void) {
+    TEST("Exact and multiline entries skipped");
+
+    lle_history_core_t *core = NULL;
+    if (lle_history_core_create(&core, NULL, NULL) != LLE_SUCCESS) {
+        FAIL("Failed to create core");
+    }
+
+    lle_history_add_entry(core, "make test", 0, NULL);
+    lle_history_add_entry(core, "make", 0, NULL);
+    lle_history_add_entry(core, "for i in 1 2\\ndo echo $i\\ndone", 0, NULL);
+    lle_history_add_entry(core, "for x", 0, NULL);
+
+    bool ok = suggests(core, "make", "make test") &&
+              suggests(core, "for", "for x") && suggests(core, "for i", NULL);
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Exact or multiline entry suggested");
+    }
+    PASS();
+}
+
+/*
+ * Test 3: Precomposed and decomposed text match each other
+ */
+void test_unicode_normalization(void) {
+    TEST("NFC-normalized keys and queries");
+
+    lle_history_core_t *core = NULL;
+    if (lle_history_core_create(&core, NULL, NULL) != LLE_SUCCESS) {
+        FAIL("Failed to create core");
+    }
+
+    /* "cafe" + COMBINING ACUTE ACCENT */
+    lle_history_add_entry(core, "echo cafe\xcc\x81 latte", 0, NULL);
+    /* Precomposed U+00E9 */
+    lle_history_add_entry(core, "cat r\xc3\xa9sum\xc3\xa9.txt", 0, NULL);
+
+    bool ok = suggests(core, "echo caf\xc3\xa9", "echo cafe\xcc\x81 latte") &&
+              suggests(core, "cat re\xcc\x81", "cat r\xc3\xa9sum\xc3\xa9.txt") &&
+              suggests(core, "echo cafe ", NULL);
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Equivalent encodings did not match");
+    }
+    PASS();
+}
+
+/*
+ * Test 4: Clear, load and rebuild keep the index in sync
+ */
+void test_index_maintenance(void) {
+    TEST("Index follows clear, load and rebuild");
+
+    lle_history_core_t *core = NULL;
+    if (lle_history_core_create(&core, NULL, NULL) != LLE_SUCCESS) {
+        FAIL("Failed to create core");
+    }
+
+    lle_history_add_entry(core, "docker ps -a", 0, NULL);
+    lle_history_add_entry(core, "docker compose up", 0, NULL);
+    lle_history_save_to_file(core, TEST_HISTORY_FILE);
+
+    lle_history_clear(core);
+    if (!suggests(core, "docker", NULL)) {
+        lle_history_core_destroy(core);
+        FAIL("Cleared entries still suggested");
+    }
+
+    lle_history_add_entry(core, "docker images", 0, NULL);
+    if (!suggests(core, "dock", "docker images")) {
+        lle_history_core_destroy(core);
+        FAIL("Entry added after clear not suggested");
+    }
+    lle_history_core_destroy(core);
+
+    core = NULL;
+    if (lle_history_core_create(&core, NULL, NULL) != LLE_SUCCESS) {
+        FAIL("Failed to create core");
+    }
+    lle_history_load_from_file(core, TEST_HISTORY_FILE);
+    remove(TEST_HISTORY_FILE);
+
+    bool ok = suggests(core, "docker c", "docker compose up") &&
+              suggests(core, "docker", "docker compose up");
+
+    if (ok && lle_history_rebuild_index(core) == LLE_SUCCESS) {
+        size_t entries = 0;
+        lle_history_prefix_index_get_size(core->prefix_index, &entries, NULL);
+        ok = entries == 2 && suggests(core, "docker p", "docker ps -a");
+    }
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Loaded or rebuilt entries not suggested");
+    }
+    PASS();
+}
+
+/*
+ * Test 5: Oldest entry of a large history is still found, quickly
+ */
+void test_large_history(void) {
+    TEST("Match anywhere in 20k-entry history");
+
+    lle_history_config_t *config = NULL;
+    if (lle_history_config_create_default(&config, NULL) != LLE_SUCCESS) {
+        FAIL("Failed to create config");
+    }
+    config->max_entries = LARGE_HISTORY_ENTRIES;
+
+    lle_history_core_t *core = NULL;
+    lle_result_t result = lle_history_core_create(&core, NULL, config);
+    lle_history_config_destroy(config, NULL);
+    if (result != LLE_SUCCESS) {
+        FAIL("Failed to create core");
+    }
+
+    lle_history_add_entry(core, "ssh deploy@prod.example.com", 0, NULL);
+    char command[64];
+    for (int i = 1; i < LARGE_HISTORY_ENTRIES; i++) {
+        snprintf(command, sizeof(command), "make -j%d target_%d", i % 16, i);
+        lle_history_add_entry(core, command, 0, NULL);
+    }
+
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    bool ok = true;
+    for (int i = 0; i < 1000; i++) {
+        ok = ok && suggests(core, "ssh", "ssh deploy@prod.example.com");
+        ok = ok && suggests(core, "make -j3 target_9",
+                            "make -j3 target_9987");
+    }
+    gettimeofday(&end, NULL);
+    long elapsed_us = (end.tv_sec - start.tv_sec) * 1000000L +
+                      (end.tv_usec - start.tv_usec);
+    printf("  2000 lookups in %ld us\n", elapsed_us);
+
+    lle_history_core_destroy(core);
+    if (!ok) {
+        FAIL("Old or deep entry not found");
+    }
+    PASS();
+}
+
+/*
+ * Main test runner
+ */
+int main(void) {
+    printf("=================================================\n");
+    printf("History Prefix Index - Functional Tests\n");
+    printf("=================================================\n");
+
+    test_most_recent_match();
+    test_skipped_entries();
+    test_unicode_normalization();
+    test_index_maintenance();
+    test_large_history();
+
+    /* Summary */
+    printf("\n=================================================\n");
+    printf("Test Results:\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("=================================================\n");
+
+    if (tests_failed == 0) {
+        printf("ALL FUNCTIONAL TESTS PASSED\n");
+        printf("=================================================\n");
+        return 0;
+    } else {
+        printf("SOME TESTS FAILED\n");
+        printf("=================================================\n");
+        return 1;
+    }
+}
@@ -157,7 +157,8 @@ static void test_delete_updates_utf8_index() {
               "Codepoint count decreased by 2");
 
     /* Verify content */
-    ASSERT_STR_EQ(buffer->data, "HelloWorld", "Content correct after deletion");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "HelloWorld",
+                  "Content correct after deletion");
 
     lle_buffer_destroy(buffer);
     PASS();
@@ -201,7 +202,7 @@ static void test_insert_adjusts_cursor() {
     ASSERT_EQ(buffer->cursor.byte_offset, 8, "Cursor adjusted after insertion");
 
     /* Verify content */
-    ASSERT_STR_EQ(buffer->data, "HeXXXllo", "Content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "HeXXXllo", "Content correct");
 
     lle_cursor_manager_destroy(cursor_mgr);
     lle_buffer_destroy(buffer);
@@ -363,7 +364,7 @@ static void test_undo_single_insert() {
     const char *text = "Hello";
     result = lle_buffer_insert_text(buffer, 0, text, strlen(text));
     ASSERT_SUCCESS(result, "Text insertion succeeds");
-    ASSERT_STR_EQ(buffer->data, "Hello", "Content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello", "Content correct");
 
     /* Complete the sequence */
     result = lle_change_tracker_complete_sequence(tracker);
@@ -387,7 +388,8 @@ static void test_undo_single_insert() {
     ASSERT_SUCCESS(result, "Redo succeeds");
 
     /* Content should be restored */
-    ASSERT_STR_EQ(buffer->data, "Hello", "Content restored after redo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello",
+                  "Content restored after redo");
 
     lle_change_tracker_destroy(tracker);
     lle_buffer_destroy(buffer);
@@ -437,17 +439,19 @@ static void test_undo_complex_sequence() {
     result = lle_change_tracker_complete_sequence(tracker);
     ASSERT_SUCCESS(result, "Complete sequence 3");
 
-    ASSERT_STR_EQ(buffer->data, "Hello", "Content after operations");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello",
+                  "Content after operations");
 
     /* Undo delete */
     result = lle_change_tracker_undo(tracker, buffer);
     ASSERT_SUCCESS(result, "Undo delete succeeds");
-    ASSERT_STR_EQ(buffer->data, "Hello World", "Content restored");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello World",
+                  "Content restored");
 
     /* Undo second insert */
     result = lle_change_tracker_undo(tracker, buffer);
     ASSERT_SUCCESS(result, "Undo insert 2 succeeds");
-    ASSERT_STR_EQ(buffer->data, "Hello", "Content after undo 2");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello", "Content after undo 2");
 
     /* Undo first insert */
     result = lle_change_tracker_undo(tracker, buffer);
@@ -527,7 +531,8 @@ static void test_e2e_text_editing_session() {
     /* Validate after typing */
     result = lle_buffer_validate_complete(buffer, validator);
     ASSERT_SUCCESS(result, "Buffer valid after typing");
-    ASSERT_STR_EQ(buffer->data, "Hello World", "Content correct");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello World",
+                  "Content correct");
     ASSERT_EQ(cursor_mgr->position.byte_offset, 11, "Cursor at end");
 
     /* User realizes they want "Hello Universe" instead */
@@ -556,7 +561,8 @@ static void test_e2e_text_editing_session() {
     /* Validate */
     result = lle_buffer_validate_complete(buffer, validator);
     ASSERT_SUCCESS(result, "Buffer valid after edit");
-    ASSERT_STR_EQ(buffer->data, "Hello Universe", "Content updated");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello Universe",
+                  "Content updated");
 
     /* User changes mind, undo to get "Hello World" back */
     result =
@@ -568,7 +574,8 @@ static void test_e2e_text_editing_session() {
     /* Validate after undo */
     result = lle_buffer_validate_complete(buffer, validator);
     ASSERT_SUCCESS(result, "Buffer valid after undo");
-    ASSERT_STR_EQ(buffer->data, "Hello World", "Original content restored");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello World",
+                  "Original content restored");
 
     /* Cleanup */
     lle_change_tracker_destroy(tracker);
@@ -661,7 +668,8 @@ static void test_e2e_utf8_editing_with_all_subsystems() {
     result = lle_change_tracker_undo(tracker, buffer); /* Undo "世界" */
     ASSERT_SUCCESS(result, "Undo UTF-8 succeeds");
     ASSERT_EQ(buffer->length, 6, "Length after UTF-8 undo");
-    ASSERT_STR_EQ(buffer->data, "Hello ", "Content after UTF-8 undo");
+    ASSERT_STR_EQ(lle_buffer_get_text(buffer), "Hello ",
+                  "Content after UTF-8 undo");
 
     /* Redo */
     result = lle_change_tracker_redo(tracker, buffer);
@@ -306,6 +306,159 @@ static void test_ansi_render(void) {
     lle_syntax_highlighter_destroy(h);
 }
 
+/* Test: a trailing backslash ends the input instead of looping */
+static void test_trailing_backslash(void) {
+    lle_syntax_highlighter_t *h = NULL;
+    lle_syntax_highlighter_create(&h);
+
+    TEST_START("trailing backslash");
+    int count = lle_syntax_highlight(h, "echo \\", 6);
+    if (count == 3)
+        TEST_PASS();
+    else
+        TEST_FAIL("expected 3 tokens");
+
+    lle_syntax_highlighter_destroy(h);
+}
+
+/* Compare an incrementally updated highlighter with a fresh one */
+static bool same_as_full(lle_syntax_highlighter_t *inc, const char *text,
+                         size_t len) {
+    lle_syntax_highlighter_t *full = NULL;
+    lle_syntax_highlighter_create(&full);
+    lle_syntax_highlight(full, text, len);
+
+    size_t inc_count = 0, full_count = 0;
+    const lle_syntax_token_t *a = lle_syntax_get_tokens(inc, &inc_count);
+    const lle_syntax_token_t *b = lle_syntax_get_tokens(full, &full_count);
+    bool same = inc_count == full_count;
+    for (size_t i = 0; same && i < inc_count; i++) {
+        same = a[i].type == b[i].type && a[i].start == b[i].start &&
+               a[i].end == b[i].end && a[i].color == b[i].color &&
+               a[i].attributes == b[i].attributes;
+    }
+
+    static char inc_out[16384], full_out[16384];
+    int inc_len = lle_syntax_render_ansi(inc, text, inc_out, sizeof(inc_out));
+    int full_len =
+        lle_syntax_render_ansi(full, text, full_out, sizeof(full_out));
+    same = same && inc_len == full_len && strcmp(inc_out, full_out) == 0;
+
+    lle_syntax_highlighter_destroy(full);
+    return same;
+}
+
+/* Test: random edits re-lexed incrementally match a full highlight */
+static void test_incremental_random_edits(void) {
+    static const char *pieces[] = {
+        "echo ", "ls", " -la", "'", "\"", "$", "(", ")", "((", "))",
+        "{", "}", "|", "||", "&&", ";", "\n", "<<", "<<<", ">", "#",
+        "foo", " ()", "function ", "if ", "then", "fi", "done", "\\",
+        "*(.)", "?(a)", "/tmp", "X=1 ", "${V}", "$((1+2))", "  ", "cd",
+        "nosuchcmd", "~/x", "[ab]", "2>&1"};
+    const size_t piece_count = sizeof(pieces) / sizeof(pieces[0]);
+
+    lle_syntax_highlighter_t *h = NULL;
+    lle_syntax_highlighter_create(&h);
+
+    TEST_START("random edits match full re-highlight");
+    char text[4096] = "";
+    size_t len = 0;
+    unsigned int seed = 12345;
+    bool ok = true;
+    char output[16384];
+
+    for (int step = 0; step < 3000 && ok; step++) {
+        seed = seed * 1103515245u + 12345u;
+        unsigned int r = seed >> 8;
+        size_t at = len ? r % (len + 1) : 0;
+        if (r % 3 != 0 || len < 8) {
+            /* Insert a piece */
+            const char *piece = pieces[(r >> 4) % piece_count];
+            size_t plen = strlen(piece);
+            if (len + plen >= sizeof(text) - 1) {
+                len = 0;
+                text[0] = '\0';
+                continue;
+            }
+            memmove(text + at + plen, text + at, len - at + 1);
+            memcpy(text + at, piece, plen);
+            len += plen;
+        } else {
+            /* Delete a short run */
+            size_t n = 1 + (r >> 4) % 6;
+            if (at + n > len)
+                n = len - at;
+            memmove(text + at, text + at + n, len - at - n + 1);
+            len -= n;
+        }
+
+        lle_syntax_highlight(h, text, len);
+        /* Render only every few edits so damage from several edits
+         * accumulates before rendering */
+        if (step % 3 == 0)
+            lle_syntax_render_ansi(h, text, output, sizeof(output));
+        if (step % 7 == 0)
+            ok = same_as_full(h, text, len);
+    }
+    ok = ok && same_as_full(h, text, len);
+
+    if (ok)
+        TEST_PASS();
+    else
+        TEST_FAIL("incremental tokens or output differ");
+
+    lle_syntax_highlighter_destroy(h);
+}
+
+/* Test: typing at the end of a long command re-lexes only the tail */
+static void test_incremental_damage_range(void) {
+    lle_syntax_highlighter_t *h = NULL;
+    lle_syntax_highlighter_create(&h);
+
+    TEST_START("edit re-lexes only the damaged range");
+    char text[8192] = "";
+    for (int i = 0; i < 100; i++) {
+        char line[64];
+        snprintf(line, sizeof(line), "echo line%d | grep -v x%d\n", i, i);
+        strcat(text, line);
+    }
+    size_t len = strlen(text);
+    char output[32768];
+
+    size_t total = (size_t)lle_syntax_highlight(h, text, len);
+    lle_syntax_render_ansi(h, text, output, sizeof(output));
+    bool ok = h->tokens_relexed == total;
+
+    /* Type one character at the end */
+    text[len++] = 'l';
+    text[len] = '\0';
+    lle_syntax_highlight(h, text, len);
+    ok = ok && h->tokens_relexed <= 2;
+
+    /* Edit a word in the middle via an explicit edit range */
+    char *mid = strstr(text, "line50");
+    size_t at = (size_t)(mid - text);
+    memcpy(mid, "LINE", 4);
+    lle_syntax_highlight_edit(h, text, len, at, at + 4, at + 4);
+    ok = ok && h->tokens_relexed <= 3;
+
+    /* An unclosed quote swallows the rest of the input */
+    memmove(text + at + 1, text + at, len - at + 1);
+    text[at] = '"';
+    len++;
+    lle_syntax_highlight(h, text, len);
+    ok = ok && h->tokens_relexed <= 3 && h->token_count < total;
+
+    ok = ok && same_as_full(h, text, len);
+    if (ok)
+        TEST_PASS();
+    else
+        TEST_FAIL("unexpected re-lex range");
+
+    lle_syntax_highlighter_destroy(h);
+}
+
 int main(void) {
     printf("=== LLE Syntax Highlighting Unit Tests ===\n\n");
 
@@ -317,6 +470,9 @@ int main(void) {
     test_operators();
     test_variables();
     test_ansi_render();
+    test_trailing_backslash();
+    test_incremental_random_edits();
+    test_incremental_damage_range();
 
     printf("\n========================================\n");
     printf("Results: %d passed, %d failed (of %d)\n", tests_passed,
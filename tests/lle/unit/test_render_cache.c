@@ -82,6 +82,19 @@ lush_pool_error_t lush_pool_init(const lush_pool_config_t *config) {
     return 0;
 }
 
+void lush_pool_maintenance(void) {}
+
+void lush_pool_get_pool_info(lush_pool_size_t pool_type, size_t *block_size,
+                             size_t *free_blocks, size_t *total_blocks) {
+    (void)pool_type;
+    if (block_size)
+        *block_size = 0;
+    if (free_blocks)
+        *free_blocks = 0;
+    if (total_blocks)
+        *total_blocks = 0;
+}
+
 /* ========================================================================== */
 /*                    CACHE INITIALIZATION TESTS                              */
 /* ========================================================================== */
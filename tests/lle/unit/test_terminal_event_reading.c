@@ -10,6 +10,7 @@
  * 4. EOF detection
  * 5. Error handling
  * 6. Integration scenarios
+ * 7. Buffered input (text runs, bracketed paste)
  */
 
 #include "lle/terminal_abstraction.h"
@@ -553,6 +554,168 @@ TEST(test_mixed_event_types) {
     lle_unix_interface_destroy(interface);
 }
 
+/* ============================================================================
+ * BUFFERED INPUT TESTS
+ * ============================================================================
+ */
+
+/* Helper: interface reading from a pipe preloaded with data */
+static lle_unix_interface_t *interface_on_pipe(const void *data, size_t len,
+                                               int *saved_stdin) {
+    int pipe_fd = create_pipe_with_data(data, len, NULL);
+    assert(pipe_fd >= 0);
+
+    lle_unix_interface_t *interface = NULL;
+    lle_result_t result = lle_unix_interface_init(&interface);
+    assert(result == LLE_SUCCESS);
+
+    *saved_stdin = dup(STDIN_FILENO);
+    dup2(pipe_fd, STDIN_FILENO);
+    close(pipe_fd);
+    interface->terminal_fd = STDIN_FILENO;
+    return interface;
+}
+
+static void interface_off_pipe(lle_unix_interface_t *interface,
+                               int saved_stdin) {
+    dup2(saved_stdin, STDIN_FILENO);
+    close(saved_stdin);
+    lle_unix_interface_destroy(interface);
+}
+
+TEST(test_burst_uses_one_read) {
+    const char data[] = "ab\x1b[Ac";
+    int saved_stdin;
+    lle_unix_interface_t *interface =
+        interface_on_pipe(data, sizeof(data) - 1, &saved_stdin);
+
+    lle_input_event_t event;
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_CHARACTER);
+    assert(event.data.character.codepoint == 'a');
+
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_CHARACTER);
+    assert(event.data.character.codepoint == 'b');
+
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_SPECIAL_KEY);
+    assert(event.data.special_key.key == LLE_KEY_UP);
+
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_CHARACTER);
+    assert(event.data.character.codepoint == 'c');
+
+    /* Every event came from the first read */
+    assert(interface->input_reads == 1);
+
+    interface_off_pipe(interface, saved_stdin);
+}
+
+TEST(test_text_run_coalescing) {
+    /* "hello wörld", Ctrl-A, then a lone 'x' */
+    const char data[] = "hello w\xc3\xb6rld\x01x";
+    int saved_stdin;
+    lle_unix_interface_t *interface =
+        interface_on_pipe(data, sizeof(data) - 1, &saved_stdin);
+    lle_unix_interface_set_text_coalescing(interface, true);
+
+    lle_input_event_t event;
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_TEXT);
+    assert(!event.data.text.pasted);
+    assert(event.data.text.length == 12);
+    assert(memcmp(event.data.text.bytes, "hello w\xc3\xb6rld", 12) == 0);
+
+    /* Control characters still arrive as keys */
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_SPECIAL_KEY);
+    assert(event.data.special_key.modifiers == LLE_MOD_CTRL);
+    assert(event.data.special_key.keycode == 'A');
+
+    /* A single character is not a run */
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_CHARACTER);
+    assert(event.data.character.codepoint == 'x');
+
+    interface_off_pipe(interface, saved_stdin);
+}
+
+TEST(test_bracketed_paste) {
+    /* Pasted lines and a control character stay text; 'z' is typed after */
+    const char data[] = "\x1b[200~echo a\r\n\x03" "echo\tb\x1b[201~z";
+    int saved_stdin;
+    lle_unix_interface_t *interface =
+        interface_on_pipe(data, sizeof(data) - 1, &saved_stdin);
+    interface->bracketed_paste_enabled = true;
+
+    lle_input_event_t event;
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_TEXT);
+    assert(event.data.text.pasted);
+    assert(event.data.text.length == strlen("echo a\necho\tb"));
+    assert(memcmp(event.data.text.bytes, "echo a\necho\tb",
+                  event.data.text.length) == 0);
+    assert(!interface->paste_active);
+
+    assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+           LLE_SUCCESS);
+    assert(event.type == LLE_INPUT_TYPE_CHARACTER);
+    assert(event.data.character.codepoint == 'z');
+
+    interface_off_pipe(interface, saved_stdin);
+}
+
+TEST(test_large_paste_few_reads) {
+    /* 20 KB script between paste markers */
+    enum { SCRIPT_SIZE = 20000 };
+    char *data = malloc(SCRIPT_SIZE + 12);
+    assert(data != NULL);
+    memcpy(data, "\x1b[200~", 6);
+    for (size_t i = 0; i < SCRIPT_SIZE; i++) {
+        data[6 + i] = (i % 40 == 39) ? '\r' : (char)('a' + i % 26);
+    }
+    memcpy(data + 6 + SCRIPT_SIZE, "\x1b[201~", 6);
+
+    int saved_stdin;
+    lle_unix_interface_t *interface =
+        interface_on_pipe(data, SCRIPT_SIZE + 12, &saved_stdin);
+    interface->bracketed_paste_enabled = true;
+
+    size_t total = 0;
+    int events = 0;
+    while (interface->paste_active || events == 0) {
+        lle_input_event_t event;
+        assert(lle_unix_interface_read_event(interface, &event, 1000) ==
+               LLE_SUCCESS);
+        assert(event.type == LLE_INPUT_TYPE_TEXT);
+        for (size_t i = 0; i < event.data.text.length; i++) {
+            char expected = ((total + i) % 40 == 39)
+                                ? '\n'
+                                : (char)('a' + (total + i) % 26);
+            assert(event.data.text.bytes[i] == expected);
+        }
+        total += event.data.text.length;
+        events++;
+    }
+
+    assert(total == SCRIPT_SIZE);
+    assert(events <= SCRIPT_SIZE / LLE_UNIX_TEXT_RUN_MAX + 2);
+    assert(interface->input_reads <=
+           SCRIPT_SIZE / LLE_UNIX_INPUT_BUFFER_SIZE + 3);
+
+    interface_off_pipe(interface, saved_stdin);
+    free(data);
+}
+
 /* ============================================================================
  * TEST RUNNER
  * ============================================================================
@@ -590,6 +753,12 @@ int main(void) {
     run_test_multiple_events_sequence();
     run_test_mixed_event_types();
 
+    printf("\nBuffered Input Tests:\n");
+    run_test_burst_uses_one_read();
+    run_test_text_run_coalescing();
+    run_test_bracketed_paste();
+    run_test_large_paste_few_reads();
+
     printf("\n========================================================\n");
     printf("Test Results: %d/%d tests passed\n", tests_passed, tests_run);
 
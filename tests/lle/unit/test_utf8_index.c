@@ -0,0 +1,344 @@
+/**
+ * @file test_utf8_index.c
+ * @brief Unit tests for incremental LLE UTF-8 index updates
+ *
+ * Tests lle_utf8_index_splice against lle_utf8_index_rebuild:
+ * - End-of-text sentinel mappings
+ * - Edits that join or split grapheme clusters around the edit
+ * - Regional indicator pairing changed past the edited range
+ * - Fallback to a rebuild and rejection of invalid UTF-8
+ * - Random edit sequences compared with a full rebuild after every edit
+ */
+
+#include "lle/buffer_management.h"
+#include "lle/utf8_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name)                                                             \
+    do {                                                                       \
+        printf("  Testing: %s ... ", name);                                    \
+        fflush(stdout);                                                        \
+        tests_run++;                                                           \
+    } while (0)
+
+#define PASS()                                                                 \
+    do {                                                                       \
+        printf("PASS\n");                                                      \
+        tests_passed++;                                                        \
+    } while (0)
+
+#define FAIL(msg)                                                              \
+    do {                                                                       \
+        printf("FAIL: %s\n", msg);                                             \
+        tests_failed++;                                                        \
+    } while (0)
+
+#define ASSERT_EQ(a, b, msg)                                                   \
+    do {                                                                       \
+        if ((a) != (b)) {                                                      \
+            FAIL(msg);                                                         \
+            return;                                                            \
+        }                                                                      \
+    } while (0)
+
+#define ASSERT_TRUE(cond, msg)                                                 \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            FAIL(msg);                                                         \
+            return;                                                            \
+        }                                                                      \
+    } while (0)
+
+#define RANDOM_EDITS 5000
+#define MAX_TEXT 512
+
+/* Regional indicators U and S, forming the US flag */
+#define RI_U "\xf0\x9f\x87\xba"
+#define RI_S "\xf0\x9f\x87\xb8"
+
+/* ============================================================================
+ * HELPERS
+ * ============================================================================
+ */
+
+static bool arrays_equal(const size_t *a, const size_t *b, size_t count) {
+    return memcmp(a, b, (count + 1) * sizeof(size_t)) == 0;
+}
+
+/**
+ * Check an index against one rebuilt from scratch for the same text
+ */
+static bool matches_rebuild(const lle_utf8_index_t *index, const char *text,
+                            size_t length) {
+    lle_utf8_index_t fresh;
+    lle_utf8_index_init(&fresh);
+    if (lle_utf8_index_rebuild(&fresh, text, length) != LLE_SUCCESS) {
+        lle_utf8_index_cleanup(&fresh);
+        return false;
+    }
+
+    bool same =
+        index->index_valid && index->byte_count == fresh.byte_count &&
+        index->codepoint_count == fresh.codepoint_count &&
+        index->grapheme_count == fresh.grapheme_count &&
+        index->display_width == fresh.display_width &&
+        arrays_equal(index->byte_to_codepoint, fresh.byte_to_codepoint,
+                     fresh.byte_count) &&
+        arrays_equal(index->codepoint_to_byte, fresh.codepoint_to_byte,
+                     fresh.codepoint_count) &&
+        arrays_equal(index->codepoint_to_grapheme, fresh.codepoint_to_grapheme,
+                     fresh.codepoint_count) &&
+        arrays_equal(index->grapheme_to_codepoint, fresh.grapheme_to_codepoint,
+                     fresh.grapheme_count) &&
+        arrays_equal(index->grapheme_to_display, fresh.grapheme_to_display,
+                     fresh.grapheme_count) &&
+        arrays_equal(index->display_to_grapheme, fresh.display_to_grapheme,
+                     fresh.display_width);
+
+    lle_utf8_index_cleanup(&fresh);
+    return same;
+}
+
+/**
+ * Apply an edit to a flat string and splice it into the index
+ */
+static lle_result_t edit(lle_utf8_index_t *index, char *text, size_t *length,
+                         size_t start, size_t deleted, const char *inserted) {
+    size_t inserted_length = strlen(inserted);
+    memmove(text + start + inserted_length, text + start + deleted,
+            *length - start - deleted + 1);
+    memcpy(text + start, inserted, inserted_length);
+    *length = *length - deleted + inserted_length;
+    return lle_utf8_index_splice(index, text, *length, start, deleted,
+                                 inserted_length);
+}
+
+/* ============================================================================
+ * SENTINEL TESTS
+ * ============================================================================
+ */
+
+static void test_end_sentinels(void) {
+    TEST("End of text maps to end positions");
+    lle_utf8_index_t index;
+    lle_utf8_index_init(&index);
+
+    /* "a" + U+4E16 (wide) + "e" + COMBINING ACUTE */
+    const char *text = "a\xe4\xb8\x96"
+                       "e\xcc\x81";
+    lle_utf8_index_rebuild(&index, text, strlen(text));
+
+    size_t value = 0;
+    ASSERT_EQ(lle_utf8_index_byte_to_codepoint(&index, 7, &value),
+              LLE_SUCCESS, "Lookup at text end succeeds");
+    ASSERT_EQ(value, 4, "Text end is codepoint 4");
+    lle_utf8_index_codepoint_to_grapheme(&index, 4, &value);
+    ASSERT_EQ(value, 3, "Codepoint end is grapheme 3");
+    lle_utf8_index_grapheme_to_display(&index, 3, &value);
+    ASSERT_EQ(value, 4, "Grapheme end is column 4");
+    lle_utf8_index_display_to_grapheme(&index, 4, &value);
+    ASSERT_EQ(value, 3, "Column end is grapheme 3");
+    ASSERT_EQ(lle_utf8_index_byte_to_codepoint(&index, 8, &value),
+              LLE_ERROR_INVALID_RANGE, "Past the end is rejected");
+
+    lle_utf8_index_cleanup(&index);
+    PASS();
+}
+
+/* ============================================================================
+ * SPLICE TESTS
+ * ============================================================================
+ */
+
+static void test_splice_joins_cluster(void) {
+    TEST("Combining mark joins the cluster before the edit");
+    lle_utf8_index_t index;
+    lle_utf8_index_init(&index);
+
+    char text[MAX_TEXT] = "echo cafe latte";
+    size_t length = strlen(text);
+    lle_utf8_index_rebuild(&index, text, length);
+
+    ASSERT_EQ(edit(&index, text, &length, 9, 0, "\xcc\x81"), LLE_SUCCESS,
+              "Splice succeeds");
+    ASSERT_EQ(index.grapheme_count, 15, "Mark adds no grapheme");
+    ASSERT_EQ(index.codepoint_count, 16, "Mark adds a codepoint");
+    ASSERT_TRUE(matches_rebuild(&index, text, length), "Matches rebuild");
+
+    ASSERT_EQ(edit(&index, text, &length, 5, 0, "\xe4\xb8\x96"), LLE_SUCCESS,
+              "Splice succeeds");
+    ASSERT_EQ(index.display_width, 17, "Wide character adds two columns");
+    ASSERT_TRUE(matches_rebuild(&index, text, length), "Matches rebuild");
+
+    ASSERT_EQ(edit(&index, text, &length, 8, 4, ""), LLE_SUCCESS,
+              "Splice succeeds");
+    ASSERT_TRUE(matches_rebuild(&index, text, length), "Matches rebuild");
+    ASSERT_EQ(index.rebuild_count, 1, "No rebuild after the first");
+    ASSERT_EQ(index.splice_count, 3, "Each edit spliced");
+
+    lle_utf8_index_cleanup(&index);
+    PASS();
+}
+
+static void test_splice_regional_indicators(void) {
+    TEST("Regional indicator pairs re-form after the edit");
+    lle_utf8_index_t index;
+    lle_utf8_index_init(&index);
+
+    char text[MAX_TEXT] = "x " RI_U RI_S RI_U RI_S RI_U RI_S " y";
+    size_t length = strlen(text);
+    lle_utf8_index_rebuild(&index, text, length);
+    size_t graphemes = index.grapheme_count;
+
+    /* One more indicator shifts the pairing of the whole run */
+    ASSERT_EQ(edit(&index, text, &length, 2, 0, RI_S), LLE_SUCCESS,
+              "Splice succeeds");
+    ASSERT_TRUE(matches_rebuild(&index, text, length), "Matches rebuild");
+
+    ASSERT_EQ(edit(&index, text, &length, 2, 4, ""), LLE_SUCCESS,
+              "Splice succeeds");
+    ASSERT_EQ(index.grapheme_count, graphemes, "Pairs restored");
+    ASSERT_TRUE(matches_rebuild(&index, text, length), "Matches rebuild");
+
+    lle_utf8_index_cleanup(&index);
+    PASS();
+}
+
+static void test_splice_fallback(void) {
+    TEST("Invalid index falls back to a rebuild");
+    lle_utf8_index_t index;
+    lle_utf8_index_init(&index);
+
+    char text[MAX_TEXT] = "ls -la";
+    size_t length = strlen(text);
+    ASSERT_EQ(edit(&index, text, &length, 6, 0, " /tmp"), LLE_SUCCESS,
+              "Splice of unbuilt index succeeds");
+    ASSERT_EQ(index.rebuild_count, 1, "Index rebuilt");
+    ASSERT_TRUE(matches_rebuild(&index, text, length), "Matches rebuild");
+
+    lle_utf8_index_invalidate(&index);
+    ASSERT_EQ(edit(&index, text, &length, 0, 2, "cd"), LLE_SUCCESS,
+              "Splice of invalidated index succeeds");
+    ASSERT_EQ(index.rebuild_count, 2, "Index rebuilt");
+    ASSERT_EQ(index.splice_count, 0, "Nothing spliced");
+
+    lle_utf8_index_cleanup(&index);
+    PASS();
+}
+
+static void test_splice_invalid_utf8(void) {
+    TEST("Invalid UTF-8 in the edit is rejected");
+    lle_utf8_index_t index;
+    lle_utf8_index_init(&index);
+
+    char text[MAX_TEXT] = "echo ok";
+    size_t length = strlen(text);
+    lle_utf8_index_rebuild(&index, text, length);
+
+    ASSERT_EQ(edit(&index, text, &length, 5, 0, "\xc3"),
+              LLE_ERROR_INVALID_ENCODING, "Truncated sequence rejected");
+    ASSERT_TRUE(!lle_utf8_index_is_valid(&index), "Index invalidated");
+
+    lle_utf8_index_cleanup(&index);
+    PASS();
+}
+
+static void test_splice_random_edits(void) {
+    TEST("Random edits match a full rebuild");
+
+    /* ASCII, two- and three-byte, wide, combining, ZWJ, emoji, regional
+     * indicators, CR LF and Hangul jamo */
+    static const char *const pieces[] = {
+        "a",  " ",  "\xc3\xa9",     "\xe4\xb8\x96",     "\xcc\x81",
+        "z",  "\t", "\xe2\x80\x8d", "\xf0\x9f\x91\xa9", RI_U,
+        RI_S, "\r", "\n",           "\xe1\x84\x80",     "\xe1\x85\xa1",
+    };
+    size_t piece_count = sizeof(pieces) / sizeof(pieces[0]);
+
+    lle_utf8_index_t index;
+    lle_utf8_index_init(&index);
+
+    char text[MAX_TEXT * 2] = "";
+    size_t length = 0;
+    lle_utf8_index_rebuild(&index, text, length);
+    srand(15);
+
+    for (int i = 0; i < RANDOM_EDITS; i++) {
+        /* Pick a codepoint boundary */
+        size_t start = length ? (size_t)rand() % (length + 1) : 0;
+        while (start < length && (text[start] & 0xC0) == 0x80) {
+            start++;
+        }
+
+        size_t deleted = 0;
+        int delete_codepoints = rand() % 3;
+        if (length > MAX_TEXT - 32) {
+            delete_codepoints += 4;
+        }
+        for (int d = 0; d < delete_codepoints && start + deleted < length;
+             d++) {
+            deleted++;
+            while (start + deleted < length &&
+                   (text[start + deleted] & 0xC0) == 0x80) {
+                deleted++;
+            }
+        }
+
+        char inserted[64] = "";
+        int insert_pieces = length > MAX_TEXT - 32 ? 0 : rand() % 4;
+        for (int p = 0; p < insert_pieces; p++) {
+            strcat(inserted, pieces[(size_t)rand() % piece_count]);
+        }
+
+        if (edit(&index, text, &length, start, deleted, inserted) !=
+            LLE_SUCCESS) {
+            lle_utf8_index_cleanup(&index);
+            FAIL("Splice failed");
+            return;
+        }
+        if (!matches_rebuild(&index, text, length)) {
+            printf("after edit %d (at %zu, -%zu, +%zu) ", i, start, deleted,
+                   strlen(inserted));
+            lle_utf8_index_cleanup(&index);
+            FAIL("Spliced index differs from rebuild");
+            return;
+        }
+    }
+
+    ASSERT_EQ(index.rebuild_count, 1, "Only the initial rebuild");
+    lle_utf8_index_cleanup(&index);
+    PASS();
+}
+
+int main(void) {
+    printf("=====================================================\n");
+    printf("LLE UTF-8 Index Unit Tests\n");
+    printf("=====================================================\n");
+
+    printf("\nSentinel Tests:\n");
+    test_end_sentinels();
+
+    printf("\nSplice Tests:\n");
+    test_splice_joins_cluster();
+    test_splice_regional_indicators();
+    test_splice_fallback();
+    test_splice_invalid_utf8();
+    test_splice_random_edits();
+
+    /* Summary */
+    printf("\n");
+    printf("=====================================================\n");
+    printf("Test Summary:\n");
+    printf("  Total:  %d\n", tests_run);
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("=====================================================\n");
+
+    return (tests_failed == 0) ? 0 : 1;
+}
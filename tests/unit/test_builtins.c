@@ -11,7 +11,9 @@
 
 #include "alias.h"
 #include "builtins.h"
+#include "command_hash.h"
 #include "executor.h"
+#include "lush.h"
 #include "symtable.h"
 #include <assert.h>
 #include <errno.h>
@@ -940,7 +942,125 @@ TEST(hash_clear) {
     
     int status = executor_execute_command_line(exec, "hash -r");
     ASSERT_EQ(status, 0, "hash -r should succeed");
-    
+
+    teardown_executor(exec);
+}
+
+TEST(hash_lookup_hits) {
+    executor_t *exec = setup_executor();
+    bool saved_hashall = shell_opts.hash_commands;
+    shell_opts.hash_commands = true;
+
+    command_hash_clear();
+    char *first = command_hash_lookup("sh");
+    ASSERT_NOT_NULL(first, "sh should be found in PATH");
+    ASSERT(first[0] == '/', "Resolved path should be absolute");
+
+    command_hash_stats_t before;
+    command_hash_get_stats(&before);
+    char *second = command_hash_lookup("sh");
+    command_hash_stats_t after;
+    command_hash_get_stats(&after);
+
+    ASSERT_STR_EQ(second, first, "Second lookup should return same path");
+    ASSERT_EQ(after.hits, before.hits + 1, "Second lookup should be a hit");
+    ASSERT_EQ(after.misses, before.misses, "Second lookup should not search");
+    ASSERT_STR_EQ(command_hash_get("sh"), first, "sh should be remembered");
+
+    free(first);
+    free(second);
+    shell_opts.hash_commands = saved_hashall;
+    teardown_executor(exec);
+}
+
+TEST(hash_path_change_invalidates) {
+    executor_t *exec = setup_executor();
+
+    char saved[4096];
+    const char *path = command_search_path();
+    ASSERT_NOT_NULL(path, "PATH should be set");
+    snprintf(saved, sizeof(saved), "%s", path);
+
+    int status = executor_execute_command_line(exec, "hash sh");
+    ASSERT_EQ(status, 0, "hash sh should succeed");
+    ASSERT_NOT_NULL(command_hash_get("sh"), "sh should be remembered");
+
+    command_hash_stats_t before;
+    command_hash_get_stats(&before);
+    setenv("PATH", "/nonexistent/lush_hash_test", 1);
+    symtable_set_global("PATH", "/nonexistent/lush_hash_test");
+
+    ASSERT(command_hash_get("sh") == NULL,
+           "PATH change should forget remembered locations");
+    ASSERT(command_hash_lookup("sh") == NULL,
+           "sh should not be found in the new PATH");
+
+    command_hash_stats_t after;
+    command_hash_get_stats(&after);
+    ASSERT(after.path_generation > before.path_generation,
+           "PATH change should start a new generation");
+    ASSERT(after.invalidations > before.invalidations,
+           "PATH change should count an invalidation");
+
+    setenv("PATH", saved, 1);
+    symtable_set_global("PATH", saved);
+    teardown_executor(exec);
+}
+
+TEST(hash_skips_directories) {
+    executor_t *exec = setup_executor();
+    bool saved_hashall = shell_opts.hash_commands;
+    shell_opts.hash_commands = true;
+
+    /* A directory named like a command must not hide the command */
+    char dir[64], sub[96], search[160];
+    snprintf(dir, sizeof(dir), "/tmp/lush_hash_dir_%d", (int)getpid());
+    snprintf(sub, sizeof(sub), "%s/sh", dir);
+    ASSERT(mkdir(dir, 0755) == 0 && mkdir(sub, 0755) == 0,
+           "test directories should be created");
+    snprintf(search, sizeof(search), "%s:/usr/bin:/bin", dir);
+
+    char *path = command_path_search("sh", search);
+    ASSERT_NOT_NULL(path, "sh should be found past the directory");
+    ASSERT(strcmp(path, sub) != 0, "directory should not be returned");
+    free(path);
+
+    /* A remembered location that became a directory is not used */
+    char saved[4096];
+    snprintf(saved, sizeof(saved), "%s", command_search_path());
+    char tool[96];
+    snprintf(tool, sizeof(tool), "%s/lush_hash_tool", dir);
+    FILE *f = fopen(tool, "w");
+    ASSERT_NOT_NULL(f, "test command should be created");
+    fputs("#!/bin/sh\n", f);
+    fclose(f);
+    chmod(tool, 0755);
+    setenv("PATH", dir, 1);
+    symtable_set_global("PATH", dir);
+
+    char *first = command_hash_lookup("lush_hash_tool");
+    ASSERT_STR_EQ(first, tool, "test command should be found");
+    unlink(tool);
+    mkdir(tool, 0755);
+    char *second = command_hash_lookup("lush_hash_tool");
+    ASSERT(second == NULL, "directory should not revalidate the entry");
+
+    setenv("PATH", saved, 1);
+    symtable_set_global("PATH", saved);
+    rmdir(tool);
+    rmdir(sub);
+    rmdir(dir);
+    free(first);
+    shell_opts.hash_commands = saved_hashall;
+    teardown_executor(exec);
+}
+
+TEST(hash_stats) {
+    executor_t *exec = setup_executor();
+
+    int status = executor_execute_command_line(exec, "hash -s");
+    ASSERT_EQ(status, 0, "hash -s should succeed");
+
     teardown_executor(exec);
 }
 
@@ -1200,6 +1320,10 @@ int main(void) {
     RUN_TEST(hash_list);
     RUN_TEST(hash_command);
     RUN_TEST(hash_clear);
+    RUN_TEST(hash_lookup_hits);
+    RUN_TEST(hash_path_change_invalidates);
+    RUN_TEST(hash_skips_directories);
+    RUN_TEST(hash_stats);
 
     printf("\n--- umask Tests ---\n");
     RUN_TEST(umask_display);
@@ -9,7 +9,10 @@
  * @copyright Copyright (C) 2021-2026 Michael Berry
  */
 
+#include "config.h"
 #include "executor.h"
+#include "lush.h"
+#include "script_cache.h"
 #include "symtable.h"
 #include <assert.h>
 #include <stdio.h>
@@ -477,6 +480,42 @@ TEST(function_return) {
     executor_free(exec);
 }
 
+TEST(function_redefinition) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+
+    /* Calls in a loop resolve through the call-site cache */
+    executor_execute_command_line(exec, "f() { R=old; }");
+    executor_execute_command_line(exec,
+                                  "for i in 1 2; do f; f() { R=new; }; done");
+    char *result = symtable_get_var(exec->symtable, "R");
+    ASSERT_STR_EQ(result, "new", "Loop should call the redefined function");
+    free(result);
+
+    /* A function redefining itself finishes its old body */
+    executor_execute_command_line(
+        exec, "g() { g() { R=inner; }; R=outer; }; g; S=$R; g");
+    char *first = symtable_get_var(exec->symtable, "S");
+    result = symtable_get_var(exec->symtable, "R");
+    ASSERT_STR_EQ(first, "outer", "First call should run the old body");
+    ASSERT_STR_EQ(result, "inner", "Second call should run the new body");
+    free(first);
+    free(result);
+
+    size_t count = 0;
+    function_def_t **funcs = executor_list_functions(exec, &count);
+    ASSERT_NOT_NULL(funcs, "Functions should be listed");
+    ASSERT_EQ(count, 2, "Redefinitions should replace functions");
+    ASSERT_STR_EQ(funcs[0]->name, "f", "Functions should be sorted");
+    ASSERT_STR_EQ(funcs[1]->name, "g", "Functions should be sorted");
+    free(funcs);
+
+    ASSERT(executor_function_exists(exec, "g"), "g should exist");
+    ASSERT(!executor_function_exists(exec, "h"), "h should not exist");
+
+    executor_free(exec);
+}
+
 /* ============================================================================
  * ARITHMETIC TESTS
  * ============================================================================ */
@@ -850,6 +889,273 @@ TEST(pipeline_three_commands) {
     executor_free(exec);
 }
 
+TEST(pipeline_many_stages) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    
+    /* Data flows through every stage of a flat N-stage pipeline */
+    int status = executor_execute_command_line(
+        exec, "echo abc | cat | tr a-z A-Z | cat | grep -q ABC");
+    ASSERT_EQ(status, 0, "Five-stage pipeline should pass data through");
+    status = executor_execute_command_line(
+        exec, "echo abc | cat | tr a-z A-Z | cat | grep -q abc");
+    ASSERT_EQ(status, 1, "Five-stage pipeline should transform data");
+    
+    executor_free(exec);
+}
+
+TEST(pipeline_pipestatus) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    
+    /* PIPESTATUS records every stage's exit status */
+    int status = executor_execute_command_line(
+        exec, "false | true | sh -c 'exit 3' | true");
+    ASSERT_EQ(status, 0, "Pipeline should return last command's exit status");
+    executor_execute_command_line(exec, "S=\"${PIPESTATUS[*]}\"");
+    char *result = symtable_get_var(exec->symtable, "S");
+    ASSERT_NOT_NULL(result, "S should be set");
+    ASSERT_STR_EQ(result, "1 0 3 0", "PIPESTATUS should hold all stages");
+    free(result);
+    
+    executor_free(exec);
+}
+
+TEST(pipeline_pipestatus_single) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    
+    /* A simple command replaces the previous pipeline's statuses */
+    executor_execute_command_line(
+        exec, "false | true; sh -c 'exit 2'; S=\"${PIPESTATUS[*]}\"");
+    char *result = symtable_get_var(exec->symtable, "S");
+    ASSERT_NOT_NULL(result, "S should be set");
+    ASSERT_STR_EQ(result, "2", "PIPESTATUS should hold the simple command");
+    free(result);
+    
+    /* So does a compound command */
+    executor_execute_command_line(
+        exec, "false | true; if true; then false; fi; S=\"${PIPESTATUS[*]}\"");
+    result = symtable_get_var(exec->symtable, "S");
+    ASSERT_NOT_NULL(result, "S should be set");
+    ASSERT_STR_EQ(result, "1", "PIPESTATUS should hold the compound command");
+    free(result);
+    
+    executor_free(exec);
+}
+
+TEST(pipeline_pipefail) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    
+    /* With pipefail the first failing stage determines the status */
+    int status = executor_execute_command_line(
+        exec, "set -o pipefail; true | sh -c 'exit 4' | false | true");
+    ASSERT_EQ(status, 4, "Pipefail should return first failing status");
+    executor_execute_command_line(exec, "set +o pipefail");
+    
+    executor_free(exec);
+}
+
+TEST(external_spawn_path) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    
+    /* Plain external commands and file redirections use posix_spawn */
+    int status = executor_execute_command_line(exec, "sh -c 'exit 3'");
+    ASSERT_EQ(status, 3, "Spawned command should report its exit status");
+    status = executor_execute_command_line(
+        exec, "sh -c 'echo err >&2' > /dev/null 2>&1");
+    ASSERT_EQ(status, 0, "Spawned command with redirections should succeed");
+    ASSERT_EQ(exec->spawn_count, 2, "Both commands should use posix_spawn");
+    ASSERT_EQ(exec->fork_count, 0, "No command should need fork");
+    
+    /* Here-documents need shell code in the child */
+    status = executor_execute_command_line(
+        exec, "cat > /dev/null <<EOF\nline\nEOF");
+    ASSERT_EQ(status, 0, "Here-document command should succeed");
+    ASSERT_EQ(exec->fork_count, 1, "Here-document should use fork");
+    
+    /* A failed redirection falls back to fork, which reports the error */
+    status = executor_execute_command_line(
+        exec, "cat 2>/dev/null < /nonexistent/lush_spawn_test");
+    ASSERT_EQ(status, 1, "Missing input file should fail with status 1");
+    
+    executor_free(exec);
+}
+
+TEST(external_spawn_expanded_targets) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+
+    /* Targets needing parameter expansion are expanded in the child, so
+     * their side effects stay out of the shell */
+    executor_execute_command_line(exec, "unset lush_spawn_side");
+    executor_execute_command_line(exec,
+                                  "/bin/true > ${lush_spawn_side:=/dev/null}");
+    ASSERT_EQ(exec->spawn_count, 0, "Expanded target should not spawn");
+    char *side = symtable_get_var(exec->symtable, "lush_spawn_side");
+    ASSERT(side == NULL || side[0] == '\0',
+           "Assignment in a target should not reach the shell");
+    free(side);
+
+    /* An unset target under set -u is reported once, by the child */
+    char err_path[64];
+    snprintf(err_path, sizeof(err_path), "/tmp/lush_spawn_err_%d",
+             (int)getpid());
+    char cmd[160];
+    snprintf(cmd, sizeof(cmd),
+             "{ set -u; /bin/true > \"$lush_spawn_unset\"; } 2>%s; set +u",
+             err_path);
+    executor_execute_command_line(exec, cmd);
+
+    FILE *f = fopen(err_path, "r");
+    ASSERT_NOT_NULL(f, "stderr should be captured");
+    char line[256];
+    int reports = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (strstr(line, "lush_spawn_unset: unbound variable")) {
+            reports++;
+        }
+    }
+    fclose(f);
+    unlink(err_path);
+    ASSERT_EQ(reports, 1, "Unbound target should be reported once");
+
+    executor_free(exec);
+}
+
+/* ============================================================================
+ * SCRIPT FILE TESTS
+ * ============================================================================ */
+
+/* Write text to a new temporary script file named into path */
+static void write_temp_script(char *path, size_t size, const char *text) {
+    snprintf(path, size, "/tmp/lush_script_XXXXXX");
+    int fd = mkstemp(path);
+    ASSERT(fd >= 0, "temporary script should be created");
+    FILE *f = fdopen(fd, "w");
+    ASSERT_NOT_NULL(f, "temporary script should be writable");
+    fputs(text, f);
+    fclose(f);
+}
+
+/* Parse a script file whole and run its top-level commands */
+static int run_script_whole(executor_t *exec, const char *path) {
+    script_ast_t *script = executor_load_script(path, false);
+    ASSERT_NOT_NULL(script, "script should parse whole");
+    off_t resume;
+    int status = executor_execute_script(exec, script, &resume);
+    script_ast_release(script);
+    ASSERT_EQ(resume, -1, "script should run from its AST to the end");
+    return status;
+}
+
+TEST(script_exit_ends_script) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    config.script_parse_whole = true;
+    
+    /* exit stops the rest of its command list and of the script */
+    char path[64];
+    write_temp_script(path, sizeof(path),
+                      "script_x=1; exit 3; script_x=2\nscript_y=1\n");
+    int status = run_script_whole(exec, path);
+    ASSERT_EQ(status, 3, "Script should end with the exit status");
+    ASSERT(exit_flag, "exit should stay requested for the caller");
+    char *x = symtable_get_var(exec->symtable, "script_x");
+    ASSERT_STR_EQ(x, "1", "Commands after exit should not run");
+    free(x);
+    char *y = symtable_get_var(exec->symtable, "script_y");
+    ASSERT(y == NULL, "Later top-level commands should not run");
+    unlink(path);
+    exit_flag = false;
+    
+    /* exit in a sourced file ends the script that sourced it */
+    char lib[64];
+    write_temp_script(lib, sizeof(lib), "exit 4\nscript_z=1\n");
+    char text[128];
+    snprintf(text, sizeof(text), "source %s\nscript_y=1\n", lib);
+    write_temp_script(path, sizeof(path), text);
+    status = run_script_whole(exec, path);
+    ASSERT_EQ(status, 4, "Script should end with the sourced exit status");
+    char *z = symtable_get_var(exec->symtable, "script_z");
+    ASSERT(z == NULL, "Sourced file should stop at exit");
+    y = symtable_get_var(exec->symtable, "script_y");
+    ASSERT(y == NULL, "Script should stop after the sourced exit");
+    unlink(lib);
+    unlink(path);
+    exit_flag = false;
+    
+    executor_free(exec);
+}
+
+TEST(script_errexit_exemptions) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    config.script_parse_whole = true;
+    
+    /* set -e ignores early AND-OR members and negated pipelines */
+    char path[64];
+    write_temp_script(path, sizeof(path),
+                      "set -e\n"
+                      "false && true\n"
+                      "! true\n"
+                      "script_a=1; false && true; script_b=1\n"
+                      "true && false\n"
+                      "script_c=1\n");
+    int status = run_script_whole(exec, path);
+    executor_execute_command_line(exec, "set +e");
+    ASSERT_EQ(status, 1, "Script should stop at the failing last member");
+    char *a = symtable_get_var(exec->symtable, "script_a");
+    ASSERT_NOT_NULL(a, "Exempt failures should not stop the script");
+    free(a);
+    char *b = symtable_get_var(exec->symtable, "script_b");
+    ASSERT_NOT_NULL(b, "Exempt failures should not stop a command list");
+    free(b);
+    char *c = symtable_get_var(exec->symtable, "script_c");
+    ASSERT(c == NULL, "set -e should stop after the failing command");
+    unlink(path);
+    
+    executor_free(exec);
+}
+
+TEST(script_mode_switch) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+    config.script_parse_whole = true;
+    
+    /* Commands after set -o posix are left to the construct reader */
+    char path[64];
+    write_temp_script(path, sizeof(path),
+                      "set -o posix\n"
+                      "[[ a == a ]] && script_m=yes\n");
+    script_ast_t *script = executor_load_script(path, false);
+    ASSERT_NOT_NULL(script, "script should parse whole");
+    off_t resume;
+    executor_execute_script(exec, script, &resume);
+    script_ast_release(script);
+    executor_execute_command_line(exec, "set +o posix");
+    ASSERT_EQ(resume, 13, "script should resume at the next command");
+    char *m = symtable_get_var(exec->symtable, "script_m");
+    ASSERT(m == NULL, "[[ ]] should not run as parsed in lush mode");
+    unlink(path);
+    
+    /* The offset counts removed line continuations */
+    write_temp_script(path, sizeof(path),
+                      "echo a \\\n b >/dev/null; set -o posix\n"
+                      "[[ a == a ]] && script_m=yes\n");
+    script = executor_load_script(path, false);
+    ASSERT_NOT_NULL(script, "script should parse whole");
+    executor_execute_script(exec, script, &resume);
+    script_ast_release(script);
+    executor_execute_command_line(exec, "set +o posix");
+    ASSERT_EQ(resume, 37, "offset should point into the file");
+    unlink(path);
+    
+    executor_free(exec);
+}
+
 /* ============================================================================
  * EXTENDED TEST [[ ]] TESTS
  * ============================================================================ */
@@ -1115,6 +1421,37 @@ TEST(command_substitution_exit_status) {
     executor_free(exec);
 }
 
+TEST(command_substitution_builtin_output) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+
+    /* Single builtin bodies run without forking */
+    int status =
+        executor_execute_command_line(exec, "X=$(printf '%s\\n\\n' hi)");
+    ASSERT_EQ(status, 0, "Builtin substitution should succeed");
+    char *x = symtable_get_var(exec->symtable, "X");
+    ASSERT_STR_EQ(x, "hi", "Builtin output captured, newlines trimmed");
+    free(x);
+
+    executor_free(exec);
+}
+
+TEST(command_substitution_large_output) {
+    executor_t *exec = executor_new();
+    ASSERT_NOT_NULL(exec, "executor_new failed");
+
+    /* More output than a pipe buffer holds must not stall the child */
+    int status = executor_execute_command_line(
+        exec, "f() { i=0; while [ $i -lt 7000 ]; do echo 0123456789; "
+              "i=$((i+1)); done; }; X=$(f); N=${#X}");
+    ASSERT_EQ(status, 0, "Large substitution should succeed");
+    char *n = symtable_get_var(exec->symtable, "N");
+    ASSERT_STR_EQ(n, "76999", "All output captured");
+    free(n);
+
+    executor_free(exec);
+}
+
 /* ============================================================================
  * SPECIAL VARIABLE TESTS
  * ============================================================================ */
@@ -1392,6 +1729,7 @@ int main(void) {
     RUN_TEST(function_definition_ksh);
     RUN_TEST(function_with_args);
     RUN_TEST(function_return);
+    RUN_TEST(function_redefinition);
     
     printf("\nArithmetic tests:\n");
     RUN_TEST(arithmetic_basic);
@@ -1428,6 +1766,17 @@ int main(void) {
     RUN_TEST(pipeline_simple);
     RUN_TEST(pipeline_exit_status);
     RUN_TEST(pipeline_three_commands);
+    RUN_TEST(pipeline_many_stages);
+    RUN_TEST(pipeline_pipestatus);
+    RUN_TEST(pipeline_pipestatus_single);
+    RUN_TEST(pipeline_pipefail);
+    RUN_TEST(external_spawn_path);
+    RUN_TEST(external_spawn_expanded_targets);
+    
+    printf("\nScript file tests:\n");
+    RUN_TEST(script_exit_ends_script);
+    RUN_TEST(script_errexit_exemptions);
+    RUN_TEST(script_mode_switch);
     
     printf("\nExtended test [[ ]] tests:\n");
     RUN_TEST(extended_test_string_equal);
@@ -1455,6 +1804,8 @@ int main(void) {
     printf("\nCommand substitution tests:\n");
     RUN_TEST(command_substitution_syntax);
     RUN_TEST(command_substitution_exit_status);
+    RUN_TEST(command_substitution_builtin_output);
+    RUN_TEST(command_substitution_large_output);
     
     printf("\nSpecial variable tests:\n");
     RUN_TEST(special_var_question_mark);
@@ -13,6 +13,10 @@ executor_t *get_global_executor(void) {
     return current_executor;
 }
 
+executor_t *ensure_global_executor(void) {
+    return current_executor;
+}
+
 /* Parse and execute - uses executor_execute_command_line */
 int parse_and_execute(const char *input) {
     if (!input || !current_executor) return 1;
@@ -9,6 +9,7 @@
  * @copyright Copyright (C) 2021-2026 Michael Berry
  */
 
+#include "arithmetic.h"
 #include "expand.h"
 #include "executor.h"
 #include "symtable.h"
@@ -572,6 +573,74 @@ TEST(arith_ternary_false) {
     teardown_executor(exec);
 }
 
+TEST(arith_program_reuse) {
+    executor_t *exec = setup_executor();
+
+    executor_execute_command_line(exec, "N=1");
+    arithm_program_t *program = arithm_compile("N *= 3");
+    ASSERT_NOT_NULL(program, "Expression should compile");
+
+    /* Variables are resolved on every evaluation, not at compile time */
+    for (int i = 0; i < 3; i++) {
+        char *value = arithm_program_eval(exec, program);
+        ASSERT_NOT_NULL(value, "Evaluation should succeed");
+        free(value);
+    }
+    arithm_program_free(program);
+
+    char *n = symtable_get_var(exec->symtable, "N");
+    ASSERT_NOT_NULL(n, "N should be set");
+    ASSERT_STR_EQ(n, "27", "N should be tripled three times");
+    free(n);
+
+    teardown_executor(exec);
+}
+
+TEST(arith_program_errors) {
+    executor_t *exec = setup_executor();
+
+    arithm_program_t *program = arithm_compile("(1 + 2");
+    ASSERT_NOT_NULL(program, "Syntax errors should still compile");
+    ASSERT(arithm_program_eval(exec, program) == NULL,
+           "Unbalanced parentheses should fail");
+    ASSERT(arithm_error_flag, "Error flag should be set");
+    arithm_program_free(program);
+
+    program = arithm_compile("D / 0");
+    ASSERT_NOT_NULL(program, "Expression should compile");
+    ASSERT(arithm_program_eval(exec, program) == NULL,
+           "Division by zero should fail");
+    ASSERT_STR_EQ(arithm_get_last_error(), "division by zero",
+                  "Runtime error should be reported");
+    arithm_program_free(program);
+
+    teardown_executor(exec);
+}
+
+TEST(arith_loop_uses_cache) {
+    executor_t *exec = setup_executor();
+
+    arithm_cache_stats_t before;
+    arithm_get_cache_stats(&before);
+    executor_execute_command_line(
+        exec, "S=0; for ((i = 0; i < 10; i++)); do S=$((S + i)); done");
+    arithm_cache_stats_t after;
+    arithm_get_cache_stats(&after);
+
+    char *sum = symtable_get_var(exec->symtable, "S");
+    ASSERT_NOT_NULL(sum, "S should be set");
+    ASSERT_STR_EQ(sum, "45", "Loop should sum 0..9");
+    free(sum);
+
+    /* Only the first evaluation of each expression compiles it */
+    ASSERT(after.misses - before.misses <= 4,
+           "Each loop expression should be compiled once");
+    ASSERT(after.hits - before.hits >= 25,
+           "Repeated evaluations should reuse compiled programs");
+
+    teardown_executor(exec);
+}
+
 /* ============================================================================
  * SPECIAL VARIABLE TESTS
  * ============================================================================ */
@@ -844,6 +913,9 @@ int main(void) {
     RUN_TEST(arith_decrement);
     RUN_TEST(arith_ternary);
     RUN_TEST(arith_ternary_false);
+    RUN_TEST(arith_program_reuse);
+    RUN_TEST(arith_program_errors);
+    RUN_TEST(arith_loop_uses_cache);
 
     printf("\n--- Special Variable Tests ---\n");
     RUN_TEST(special_var_question_mark);
@@ -0,0 +1,326 @@
+/**
+ * @file test_glob_pattern.c
+ * @brief Unit tests for compiled shell patterns
+ *
+ * Tests the pattern compiler and matcher including:
+ * - POSIX wildcards, bracket expressions and escapes
+ * - bash extglob groups and zsh repetition
+ * - Prefix and suffix matching
+ * - The compiled pattern cache
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "glob_pattern.h"
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Test framework macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name)                                                         \
+    do {                                                                       \
+        printf("  Running: %s...\n", #name);                                   \
+        test_##name();                                                         \
+        printf("    PASSED\n");                                                \
+    } while (0)
+
+#define ASSERT(condition, message)                                             \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define ASSERT_EQ(actual, expected, message)                                   \
+    do {                                                                       \
+        if ((actual) != (expected)) {                                          \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      Expected: %d, Got: %d\n", (int)(expected),           \
+                   (int)(actual));                                             \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define ASSERT_MATCH(pattern, str, flags)                                      \
+    ASSERT(glob_match(pattern, str, flags), "'" pattern "' should match '" str "'")
+
+#define ASSERT_NO_MATCH(pattern, str, flags)                                   \
+    ASSERT(!glob_match(pattern, str, flags),                                   \
+           "'" pattern "' should not match '" str "'")
+
+/* ============================================================================
+ * POSIX PATTERN TESTS
+ * ============================================================================
+ */
+
+TEST(wildcards) {
+    ASSERT_MATCH("", "", 0);
+    ASSERT_NO_MATCH("", "a", 0);
+    ASSERT_MATCH("abc", "abc", 0);
+    ASSERT_NO_MATCH("abc", "abd", 0);
+    ASSERT_MATCH("*", "", 0);
+    ASSERT_MATCH("*", "anything/at/all", 0);
+    ASSERT_MATCH("a*c", "abbbc", 0);
+    ASSERT_MATCH("a*c", "ac", 0);
+    ASSERT_NO_MATCH("a*c", "abcd", 0);
+    ASSERT_MATCH("*.txt", "notes.txt", 0);
+    ASSERT_NO_MATCH("*.txt", "notes.txt.bak", 0);
+    ASSERT_MATCH("??", "ab", 0);
+    ASSERT_NO_MATCH("??", "abc", 0);
+    ASSERT_MATCH("a**b", "axxb", 0);
+    ASSERT_MATCH("*a*b*", "xxaxxbxx", 0);
+}
+
+TEST(bracket_expressions) {
+    ASSERT_MATCH("[abc]", "b", 0);
+    ASSERT_NO_MATCH("[abc]", "d", 0);
+    ASSERT_MATCH("[a-z]x", "qx", 0);
+    ASSERT_NO_MATCH("[a-z]x", "Qx", 0);
+    ASSERT_MATCH("[!a-z]", "Q", 0);
+    ASSERT_MATCH("[^a-z]", "5", 0);
+    ASSERT_NO_MATCH("[!a-z]", "q", 0);
+    ASSERT_MATCH("[]]", "]", 0);
+    ASSERT_MATCH("[!]]", "x", 0);
+    ASSERT_NO_MATCH("[!]]", "]", 0);
+    ASSERT_MATCH("[a-]", "-", 0);
+    ASSERT_MATCH("[[:digit:]][[:alpha:]]", "7z", 0);
+    ASSERT_NO_MATCH("[[:digit:]]", "z", 0);
+    ASSERT_MATCH("[[:upper:][:digit:]]*", "X1", 0);
+
+    /* An unterminated bracket is an ordinary character */
+    ASSERT_MATCH("a[b", "a[b", 0);
+    ASSERT_NO_MATCH("a[b", "ab", 0);
+}
+
+TEST(escapes) {
+    ASSERT_MATCH("\\*", "*", 0);
+    ASSERT_NO_MATCH("\\*", "x", 0);
+    ASSERT_MATCH("a\\?c", "a?c", 0);
+    ASSERT_MATCH("[\\]]", "]", 0);
+
+    /* Without escapes a backslash is just a character */
+    ASSERT_MATCH("\\*", "\\xyz", GLOB_PATTERN_NOESCAPE);
+    ASSERT_NO_MATCH("\\*", "*", GLOB_PATTERN_NOESCAPE);
+}
+
+TEST(utf8_characters) {
+    ASSERT_MATCH("?", "\xc3\xa9", 0);          /* é is one character */
+    ASSERT_NO_MATCH("??", "\xc3\xa9", 0);
+    ASSERT_MATCH("caf?", "caf\xc3\xa9", 0);
+    ASSERT_MATCH("[\xc3\xa9\xc3\xa8]", "\xc3\xa8", 0);
+    ASSERT_MATCH("[!a]", "\xe2\x82\xac", 0);   /* € */
+    ASSERT_MATCH("*\xe2\x82\xac", "10\xe2\x82\xac", 0);
+}
+
+/* ============================================================================
+ * EXTENDED PATTERN TESTS
+ * ============================================================================
+ */
+
+TEST(extglob_groups) {
+    int f = GLOB_PATTERN_EXTGLOB;
+    ASSERT(glob_match("?(a|b)c", "c", f), "?() matches zero");
+    ASSERT(glob_match("?(a|b)c", "bc", f), "?() matches one");
+    ASSERT(!glob_match("?(a|b)c", "abc", f), "?() matches at most one");
+    ASSERT(glob_match("*(ab)", "", f), "*() matches zero");
+    ASSERT(glob_match("*(ab)", "ababab", f), "*() matches many");
+    ASSERT(!glob_match("*(ab)", "aba", f), "*() repeats whole body");
+    ASSERT(!glob_match("+(ab)", "", f), "+() needs one");
+    ASSERT(glob_match("+(ab|c)", "abcab", f), "+() mixes alternatives");
+    ASSERT(glob_match("@(foo|bar).c", "bar.c", f), "@() alternatives");
+    ASSERT(!glob_match("@(foo|bar).c", "foobar.c", f), "@() matches once");
+    ASSERT(glob_match("*.@(c|h)", "main.h", f), "star then group");
+    ASSERT(glob_match("+([0-9])", "2026", f), "class inside group");
+    ASSERT(glob_match("@(a|*(b))", "bbb", f), "nested group");
+}
+
+TEST(extglob_negation) {
+    int f = GLOB_PATTERN_EXTGLOB;
+    ASSERT(glob_match("!(foo)", "bar", f), "!() matches other names");
+    ASSERT(!glob_match("!(foo)", "foo", f), "!() rejects its body");
+    ASSERT(glob_match("!(foo)", "foobar", f), "!() is a whole-substring test");
+    ASSERT(glob_match("!(*.c)", "main.h", f), "!() with wildcards");
+    ASSERT(!glob_match("!(*.c)", "main.c", f), "!() rejects wildcard body");
+
+    /* The group only negates its own part of the name */
+    ASSERT(glob_match("!(file*).txt", "notes.txt", f), "suffix kept");
+    ASSERT(!glob_match("!(file*).txt", "file1.txt", f), "body rejected");
+    ASSERT(!glob_match("!(file*).txt", "foo.c", f), "suffix required");
+}
+
+TEST(extglob_literal_parens) {
+    ASSERT(glob_match("@(a", "@(a", GLOB_PATTERN_EXTGLOB),
+           "unterminated group is literal");
+    ASSERT(glob_match("@(a)", "@(a)", 0), "groups need the extglob flag");
+    ASSERT(glob_match("a|b", "a|b", GLOB_PATTERN_EXTGLOB),
+           "top-level bar is literal");
+}
+
+TEST(zsh_repetition) {
+    int f = GLOB_PATTERN_ZSH;
+    ASSERT(glob_match("ab#c", "ac", f), "# matches zero");
+    ASSERT(glob_match("ab#c", "abbbc", f), "# matches many");
+    ASSERT(!glob_match("ab##c", "ac", f), "## needs one");
+    ASSERT(glob_match("ab##c", "abc", f), "## matches one");
+    ASSERT(glob_match("[0-9]##.log", "123.log", f), "## after class");
+    ASSERT(glob_match("(foo|bar)#", "foobarfoo", f), "# after group");
+    ASSERT(glob_match("(foo|bar).txt", "bar.txt", f), "zsh alternation");
+    ASSERT(glob_match("#a", "#a", f), "leading # is literal");
+    ASSERT(!glob_match("ab#c", "abbbc", 0), "# needs the zsh flag");
+}
+
+TEST(pathological_patterns) {
+    char subject[201];
+    memset(subject, 'a', 200);
+    subject[200] = '\0';
+
+    clock_t start = clock();
+    ASSERT(!glob_match("*a*a*a*a*a*a*a*a*a*a*b", subject, 0),
+           "many stars, no match");
+    ASSERT(!glob_match("*(a|aa|aaa)b", subject, GLOB_PATTERN_EXTGLOB),
+           "ambiguous repetition, no match");
+    ASSERT(!glob_match("+(+(a))b", subject, GLOB_PATTERN_EXTGLOB),
+           "nested repetition, no match");
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    ASSERT(elapsed < 1.0, "pathological patterns should not backtrack");
+}
+
+/* ============================================================================
+ * PREFIX AND SUFFIX TESTS
+ * ============================================================================
+ */
+
+TEST(prefix_match) {
+    glob_pattern_t *pat = glob_pattern_compile("*/", 0);
+    ASSERT(pat != NULL, "compile");
+    const char *path = "usr/local/bin";
+    ASSERT_EQ(glob_pattern_match_prefix(pat, path, strlen(path), false), 4,
+              "shortest prefix");
+    ASSERT_EQ(glob_pattern_match_prefix(pat, path, strlen(path), true), 10,
+              "longest prefix");
+    glob_pattern_free(pat);
+
+    pat = glob_pattern_compile("x*", 0);
+    ASSERT_EQ(glob_pattern_match_prefix(pat, path, strlen(path), true), -1,
+              "no prefix");
+    glob_pattern_free(pat);
+
+    pat = glob_pattern_compile("*", 0);
+    ASSERT_EQ(glob_pattern_match_prefix(pat, path, strlen(path), false), 0,
+              "empty prefix");
+    glob_pattern_free(pat);
+}
+
+TEST(suffix_match) {
+    glob_pattern_t *pat = glob_pattern_compile(".*", 0);
+    ASSERT(pat != NULL, "compile");
+    const char *file = "archive.tar.gz";
+    ASSERT_EQ(glob_pattern_match_suffix(pat, file, strlen(file), false), 3,
+              "shortest suffix");
+    ASSERT_EQ(glob_pattern_match_suffix(pat, file, strlen(file), true), 7,
+              "longest suffix");
+    glob_pattern_free(pat);
+
+    /* Suffixes never start inside a multibyte character */
+    pat = glob_pattern_compile("?", 0);
+    const char *word = "caf\xc3\xa9";
+    ASSERT_EQ(glob_pattern_match_suffix(pat, word, strlen(word), false), 2,
+              "suffix is a whole character");
+    glob_pattern_free(pat);
+}
+
+TEST(match_n) {
+    glob_pattern_t *pat = glob_pattern_compile("a*", 0);
+    ASSERT(glob_pattern_match_n(pat, "abcXYZ", 3), "bounded match");
+    ASSERT(!glob_pattern_match_n(pat, "xbc", 3), "bounded mismatch");
+    glob_pattern_free(pat);
+}
+
+/* ============================================================================
+ * CACHE TESTS
+ * ============================================================================
+ */
+
+TEST(cache_reuse) {
+    glob_pattern_cache_clear();
+    glob_pattern_cache_stats_t before;
+    glob_pattern_get_cache_stats(&before);
+
+    for (int i = 0; i < 10; i++) {
+        ASSERT(glob_match("*.c", "main.c", 0), "cached match");
+    }
+
+    glob_pattern_cache_stats_t after;
+    glob_pattern_get_cache_stats(&after);
+    ASSERT_EQ(after.misses - before.misses, 1, "compiled once");
+    ASSERT_EQ(after.hits - before.hits, 9, "reused nine times");
+    ASSERT_EQ(after.entries, 1, "one entry");
+
+    /* The same text with different flags is a different pattern */
+    ASSERT(glob_match("\\*", "*", 0), "escaped star");
+    ASSERT(!glob_match("\\*", "*", GLOB_PATTERN_NOESCAPE), "literal slash");
+    glob_pattern_get_cache_stats(&after);
+    ASSERT_EQ(after.entries, 3, "flags are part of the key");
+}
+
+TEST(cache_flush) {
+    glob_pattern_cache_clear();
+    glob_pattern_cache_stats_t before;
+    glob_pattern_get_cache_stats(&before);
+
+    char pattern[32];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(pattern, sizeof(pattern), "file%d*", i);
+        ASSERT(glob_match(pattern, pattern, GLOB_PATTERN_NOESCAPE),
+               "pattern matches its own text");
+    }
+
+    glob_pattern_cache_stats_t after;
+    glob_pattern_get_cache_stats(&after);
+    ASSERT(after.flushes > before.flushes, "full cache was flushed");
+    ASSERT(after.entries <= 256, "cache stays bounded");
+    glob_pattern_cache_clear();
+}
+
+int main(void) {
+    setlocale(LC_ALL, "");
+
+    printf("========================================\n");
+    printf("Glob Pattern Unit Tests\n");
+    printf("========================================\n");
+
+    printf("\nPOSIX pattern tests:\n");
+    RUN_TEST(wildcards);
+    RUN_TEST(bracket_expressions);
+    RUN_TEST(escapes);
+    RUN_TEST(utf8_characters);
+
+    printf("\nExtended pattern tests:\n");
+    RUN_TEST(extglob_groups);
+    RUN_TEST(extglob_negation);
+    RUN_TEST(extglob_literal_parens);
+    RUN_TEST(zsh_repetition);
+    RUN_TEST(pathological_patterns);
+
+    printf("\nPrefix and suffix tests:\n");
+    RUN_TEST(prefix_match);
+    RUN_TEST(suffix_match);
+    RUN_TEST(match_n);
+
+    printf("\nCache tests:\n");
+    RUN_TEST(cache_reuse);
+    RUN_TEST(cache_flush);
+
+    printf("\n========================================\n");
+    printf("All glob pattern tests PASSED!\n");
+    printf("========================================\n");
+
+    return 0;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file test_globstar.c
+ * @brief Unit tests for recursive ** expansion
+ *
+ * Tests the globstar walker including:
+ * - ** matching zero or more directories
+ * - Literal and wildcard components around **
+ * - Hidden names, dotglob and symlinked directories
+ * - Serial and parallel walks producing the same matches
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "glob_pattern.h"
+#include "globstar.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Test framework macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name)                                                         \
+    do {                                                                       \
+        printf("  Running: %s...\n", #name);                                   \
+        test_##name();                                                         \
+        printf("    PASSED\n");                                                \
+    } while (0)
+
+#define ASSERT(condition, message)                                             \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define ASSERT_STR_EQ(actual, expected, message)                               \
+    do {                                                                       \
+        const char *_actual = (actual);                                        \
+        const char *_expected = (expected);                                    \
+        if (strcmp(_actual, _expected) != 0) {                                 \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      Expected: \"%s\", Got: \"%s\"\n", _expected,         \
+                   _actual);                                                   \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+static char tree_root[PATH_MAX];
+
+/**
+ * @brief Collected matches
+ */
+typedef struct match_list {
+    char **paths;
+    size_t count;
+    size_t capacity;
+} match_list_t;
+
+static int collect(const char *path, void *ctx) {
+    match_list_t *list = ctx;
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 16;
+        list->paths = realloc(list->paths, list->capacity * sizeof(char *));
+        if (!list->paths) {
+            return -1;
+        }
+    }
+    list->paths[list->count++] = strdup(path);
+    return 0;
+}
+
+static int compare_paths(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/**
+ * @brief Expand a pattern and join the sorted matches with spaces
+ */
+static char *expand(const char *pattern, bool dotglob, int workers) {
+    match_list_t list = {0};
+    globstar_options_t options = {0, dotglob, workers};
+    int rc = globstar_walk(pattern, &options, collect, &list, NULL);
+    ASSERT(rc == 0, "walk succeeds");
+
+    if (list.count > 1) {
+        qsort(list.paths, list.count, sizeof(char *), compare_paths);
+    }
+
+    size_t size = 1;
+    for (size_t i = 0; i < list.count; i++) {
+        size += strlen(list.paths[i]) + 1;
+    }
+    char *joined = calloc(1, size);
+    for (size_t i = 0; i < list.count; i++) {
+        if (i > 0) {
+            strcat(joined, " ");
+        }
+        strcat(joined, list.paths[i]);
+        free(list.paths[i]);
+    }
+    free(list.paths);
+    return joined;
+}
+
+static void make_file(const char *path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT(fd >= 0, "create file");
+    close(fd);
+}
+
+/**
+ * @brief Build the test tree in a fresh temporary directory
+ *
+ *   a.c  b.h  .hidden.c  src/main.c  src/util/str.c  src/util/str.h
+ *   src/.git/conf.c  docs/guide.txt  link -> src (symlink)
+ */
+static void build_tree(void) {
+    snprintf(tree_root, sizeof(tree_root), "/tmp/lush_globstar_XXXXXX");
+    ASSERT(mkdtemp(tree_root) != NULL, "mkdtemp");
+    ASSERT(chdir(tree_root) == 0, "chdir");
+
+    ASSERT(mkdir("src", 0755) == 0, "mkdir src");
+    ASSERT(mkdir("src/util", 0755) == 0, "mkdir src/util");
+    ASSERT(mkdir("src/.git", 0755) == 0, "mkdir src/.git");
+    ASSERT(mkdir("docs", 0755) == 0, "mkdir docs");
+    make_file("a.c");
+    make_file("b.h");
+    make_file(".hidden.c");
+    make_file("src/main.c");
+    make_file("src/util/str.c");
+    make_file("src/util/str.h");
+    make_file("src/.git/conf.c");
+    make_file("docs/guide.txt");
+    ASSERT(symlink("src", "link") == 0, "symlink");
+}
+
+static void remove_tree(void) {
+    char command[PATH_MAX + 16];
+    ASSERT(chdir("/") == 0, "chdir /");
+    snprintf(command, sizeof(command), "rm -rf '%s'", tree_root);
+    ASSERT(system(command) == 0, "remove tree");
+}
+
+/* ============================================================================
+ * TESTS
+ * ============================================================================
+ */
+
+TEST(zero_or_more_directories) {
+    char *r = expand("**/*.c", false, 1);
+    ASSERT_STR_EQ(r, "a.c src/main.c src/util/str.c", "**/*.c");
+    free(r);
+
+    r = expand("src/**/*.h", false, 1);
+    ASSERT_STR_EQ(r, "src/util/str.h", "prefix before **");
+    free(r);
+
+    r = expand("**/util/*.c", false, 1);
+    ASSERT_STR_EQ(r, "src/util/str.c", "literal after **");
+    free(r);
+}
+
+TEST(trailing_globstar) {
+    char *r = expand("src/**", false, 1);
+    ASSERT_STR_EQ(r, "src/main.c src/util src/util/str.c src/util/str.h",
+                  "everything below src");
+    free(r);
+
+    r = expand("**/", false, 1);
+    ASSERT_STR_EQ(r, "docs/ link/ src/ src/util/", "directories only");
+    free(r);
+}
+
+TEST(hidden_names) {
+    char *r = expand("**/.*.c", false, 1);
+    ASSERT_STR_EQ(r, ".hidden.c", "explicit dot matches hidden files");
+    free(r);
+
+    r = expand("**/*.c", true, 1);
+    ASSERT_STR_EQ(r, ".hidden.c a.c src/.git/conf.c src/main.c src/util/str.c",
+                  "dotglob includes hidden names and directories");
+    free(r);
+}
+
+TEST(symlinks_not_followed) {
+    char *r = expand("**/main.c", false, 1);
+    ASSERT_STR_EQ(r, "src/main.c", "** does not descend through link");
+    free(r);
+
+    r = expand("link/*.c", false, 1);
+    ASSERT_STR_EQ(r, "link/main.c", "explicit component follows link");
+    free(r);
+}
+
+TEST(no_matches) {
+    char *r = expand("**/*.rs", false, 1);
+    ASSERT_STR_EQ(r, "", "no matches");
+    free(r);
+
+    r = expand("missing/**/*.c", false, 1);
+    ASSERT_STR_EQ(r, "", "missing prefix");
+    free(r);
+}
+
+TEST(parallel_walk) {
+    /* Enough directories to cross the parallel threshold */
+    char path[64];
+    ASSERT(mkdir("wide", 0755) == 0, "mkdir wide");
+    for (int i = 0; i < 100; i++) {
+        snprintf(path, sizeof(path), "wide/d%03d", i);
+        ASSERT(mkdir(path, 0755) == 0, "mkdir wide/dN");
+        snprintf(path, sizeof(path), "wide/d%03d/f.c", i);
+        make_file(path);
+    }
+
+    char *serial = expand("wide/**/*.c", false, 1);
+    char *parallel = expand("wide/**/*.c", false, GLOBSTAR_MAX_WORKERS);
+    ASSERT_STR_EQ(parallel, serial, "parallel walk finds the same paths");
+    free(serial);
+    free(parallel);
+
+    match_list_t list = {0};
+    globstar_options_t options = {0, false, GLOBSTAR_MAX_WORKERS};
+    globstar_stats_t stats;
+    ASSERT(globstar_walk("wide/**/*.c", &options, collect, &list, &stats) == 0,
+           "walk succeeds");
+    ASSERT(stats.workers > 1, "large walk starts workers");
+    ASSERT(stats.matches == 100, "one match per directory");
+    ASSERT(stats.dirs_read == 101, "each directory read once");
+    ASSERT(stats.stat_calls == 1, "only the literal prefix is looked up");
+    for (size_t i = 0; i < list.count; i++) {
+        free(list.paths[i]);
+    }
+    free(list.paths);
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("Globstar Unit Tests\n");
+    printf("========================================\n");
+
+    build_tree();
+
+    printf("\nGlobstar walk tests:\n");
+    RUN_TEST(zero_or_more_directories);
+    RUN_TEST(trailing_globstar);
+    RUN_TEST(hidden_names);
+    RUN_TEST(symlinks_not_followed);
+    RUN_TEST(no_matches);
+    RUN_TEST(parallel_walk);
+
+    remove_tree();
+
+    printf("\n========================================\n");
+    printf("All globstar tests PASSED!\n");
+    printf("========================================\n");
+
+    return 0;
+}
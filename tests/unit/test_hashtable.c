@@ -376,6 +376,84 @@ TEST(special_chars_in_key) {
     ht_strstr_destroy(ht);
 }
 
+TEST(growth_and_removal) {
+    ht_strstr_t *ht = ht_strstr_create(HT_STR_NONE);
+
+    /* Enough keys to grow the table many times */
+    char key[32];
+    char val[32];
+    for (int i = 0; i < 20000; i++) {
+        snprintf(key, sizeof(key), "key_%d", i);
+        snprintf(val, sizeof(val), "value_%d", i);
+        ht_strstr_insert(ht, key, val);
+    }
+
+    /* Remove every third key; the others must stay reachable */
+    for (int i = 0; i < 20000; i += 3) {
+        snprintf(key, sizeof(key), "key_%d", i);
+        ht_strstr_remove(ht, key);
+    }
+
+    for (int i = 0; i < 20000; i++) {
+        snprintf(key, sizeof(key), "key_%d", i);
+        snprintf(val, sizeof(val), "value_%d", i);
+        if (i % 3 == 0) {
+            ASSERT_NULL(ht_strstr_get(ht, key), "Removed key should be gone");
+        } else {
+            ASSERT_STR_EQ(ht_strstr_get(ht, key), val,
+                          "Remaining key should keep its value");
+        }
+    }
+
+    /* Removed keys can be inserted again */
+    for (int i = 0; i < 20000; i += 3) {
+        snprintf(key, sizeof(key), "key_%d", i);
+        ht_strstr_insert(ht, key, "again");
+    }
+    ASSERT_STR_EQ(ht_strstr_get(ht, "key_0"), "again", "Key should return");
+    ASSERT_STR_EQ(ht_strstr_get(ht, "key_1"), "value_1", "Key unchanged");
+
+    ht_enum_t *e = ht_strstr_enum_create(ht);
+    int count = 0;
+    const char *k, *v;
+    while (ht_strstr_enum_next(e, &k, &v)) {
+        count++;
+    }
+    ASSERT_EQ(count, 20000, "Should enumerate every key once");
+
+    ht_strstr_enum_destroy(e);
+    ht_strstr_destroy(ht);
+}
+
+TEST(remove_missing_key) {
+    ht_strstr_t *ht = ht_strstr_create(HT_STR_NONE);
+
+    ht_strstr_insert(ht, "present", "value");
+    ht_strstr_remove(ht, "absent");
+    ht_strstr_remove(ht, "absent");
+    ASSERT_STR_EQ(ht_strstr_get(ht, "present"), "value",
+                  "Removing a missing key should change nothing");
+
+    ht_strstr_remove(ht, "present");
+    ht_strstr_remove(ht, "present");
+    ASSERT_NULL(ht_strstr_get(ht, "present"), "Key should be gone");
+
+    ht_strstr_destroy(ht);
+}
+
+TEST(reinsert_stored_value) {
+    ht_strstr_t *ht = ht_strstr_create(HT_STR_NONE);
+
+    ht_strstr_insert(ht, "key", "value");
+
+    /* The stored value is copied before the old one is freed */
+    ht_strstr_insert(ht, "key", ht_strstr_get(ht, "key"));
+    ASSERT_STR_EQ(ht_strstr_get(ht, "key"), "value",
+                  "Re-inserting the stored value should keep it");
+
+    ht_strstr_destroy(ht);
+}
+
 /* ============================================================================
  * ENUMERATION TESTS
  * ============================================================================ */
@@ -491,6 +569,9 @@ int main(void) {
     RUN_TEST(empty_key);
     RUN_TEST(long_key);
     RUN_TEST(special_chars_in_key);
+    RUN_TEST(growth_and_removal);
+    RUN_TEST(remove_missing_key);
+    RUN_TEST(reinsert_stored_value);
 
     printf("\nEnumeration Tests:\n");
     RUN_TEST(strstr_enumeration);
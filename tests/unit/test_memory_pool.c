@@ -9,6 +9,7 @@
  * - Statistics tracking
  * - Error handling
  * - Memory validation
+ * - Size-aware realloc and cross-thread frees
  *
  * @author Michael Berry <trismegustis@gmail.com>
  * @copyright Copyright (C) 2021-2026 Michael Berry
@@ -16,6 +17,7 @@
 
 #include "lush_memory_pool.h"
 #include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -313,6 +315,55 @@ TEST(pool_realloc_zero_size) {
     teardown_pool();
 }
 
+TEST(pool_realloc_across_classes) {
+    setup_pool();
+
+    char *ptr = lush_pool_alloc(100);
+    ASSERT_NOT_NULL(ptr, "Initial allocation should succeed");
+    for (int i = 0; i < 100; i++) {
+        ptr[i] = (char)i;
+    }
+
+    /* Growing within the 128-byte block keeps the block */
+    char *same = lush_pool_realloc(ptr, 128);
+    ASSERT(same == ptr, "Realloc within the block should not move");
+
+    char *grown = lush_pool_realloc(same, 3000);
+    ASSERT_NOT_NULL(grown, "Realloc into a larger class should succeed");
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(grown[i], (char)i, "Block contents should be copied");
+    }
+
+    lush_pool_free(grown);
+    teardown_pool();
+}
+
+TEST(pool_realloc_fallback) {
+    setup_pool();
+
+    char *ptr = lush_pool_alloc(20000);
+    ASSERT_NOT_NULL(ptr, "Oversized allocation should succeed");
+    ASSERT(!lush_pool_is_pool_pointer(ptr), "Should be a malloc fallback");
+    memset(ptr, 'F', 20000);
+
+    char *grown = lush_pool_realloc(ptr, 40000);
+    ASSERT_NOT_NULL(grown, "Fallback realloc should succeed");
+    ASSERT(grown[0] == 'F' && grown[19999] == 'F',
+           "Fallback contents should be preserved");
+
+    /* Shrinking into a pool class moves it into a block */
+    char *small = lush_pool_realloc(grown, 64);
+    ASSERT_NOT_NULL(small, "Shrinking realloc should succeed");
+    ASSERT(lush_pool_is_pool_pointer(small), "Should now be pool memory");
+    ASSERT(small[0] == 'F' && small[63] == 'F',
+           "Shrunk contents should be preserved");
+
+    lush_pool_free(small);
+    lush_pool_stats_t stats = lush_pool_get_stats();
+    ASSERT_EQ(stats.active_allocations, 0, "No allocations should remain");
+    teardown_pool();
+}
+
 /* ============================================================================
  * CALLOC TESTS
  * ============================================================================ */
@@ -454,7 +505,26 @@ TEST(pool_get_recommended_size) {
     ASSERT_EQ(size, LUSH_POOL_XLARGE, "8192 bytes should use XLARGE pool");
 }
 
-/* Note: pool_get_pool_info test removed - function declared but not implemented */
+TEST(pool_get_pool_info) {
+    setup_pool();
+
+    void *ptr = lush_pool_alloc(64);
+    ASSERT_NOT_NULL(ptr, "Allocation should succeed");
+
+    size_t block_size = 0, free_blocks = 0, total_blocks = 0;
+    lush_pool_get_pool_info(LUSH_POOL_SMALL, &block_size, &free_blocks,
+                            &total_blocks);
+    ASSERT_EQ(block_size, 128, "Small pool block size");
+    ASSERT(total_blocks > 0, "Blocks should have been carved");
+    ASSERT_EQ(total_blocks - free_blocks, 1, "One block should be in use");
+
+    lush_pool_free(ptr);
+    lush_pool_get_pool_info(LUSH_POOL_SMALL, NULL, &free_blocks,
+                            &total_blocks);
+    ASSERT_EQ(free_blocks, total_blocks, "All blocks should be free");
+
+    teardown_pool();
+}
 
 TEST(pool_is_healthy) {
     setup_pool();
@@ -486,7 +556,28 @@ TEST(pool_is_pool_pointer) {
     teardown_pool();
 }
 
-/* Note: pool_validate_integrity and pool_maintenance tests removed - functions declared but not implemented */
+/* Note: pool_validate_integrity test removed - function declared but not implemented */
+
+TEST(pool_maintenance) {
+    setup_pool();
+
+    void *ptrs[64];
+    for (int i = 0; i < 64; i++) {
+        ptrs[i] = lush_pool_alloc(256);
+        ASSERT_NOT_NULL(ptrs[i], "Allocation should succeed");
+    }
+    for (int i = 63; i >= 0; i--) {
+        lush_pool_free(ptrs[i]);
+    }
+
+    /* Should not crash, and blocks stay allocatable afterwards */
+    lush_pool_maintenance();
+    void *ptr = lush_pool_alloc(256);
+    ASSERT(lush_pool_is_pool_pointer(ptr), "Block should come from the pool");
+    lush_pool_free(ptr);
+
+    teardown_pool();
+}
 
 /* ============================================================================
  * ERROR HANDLING TESTS
@@ -511,6 +602,32 @@ TEST(pool_error_string) {
     ASSERT_NOT_NULL(str, "Malloc failed error string should exist");
 }
 
+TEST(pool_double_free_detected) {
+    setup_pool();
+
+    void *ptr = lush_pool_alloc(64);
+    ASSERT_NOT_NULL(ptr, "Allocation should succeed");
+    lush_pool_free(ptr);
+    lush_pool_free(ptr);
+    ASSERT_EQ(lush_pool_get_last_error(), LUSH_POOL_ERROR_DOUBLE_FREE,
+              "Second free should be reported");
+
+    /* The block was queued only once */
+    void *first = lush_pool_alloc(64);
+    void *second = lush_pool_alloc(64);
+    ASSERT(first != second, "A block must not be handed out twice");
+
+    /* Interior pointers are rejected */
+    lush_pool_free((char *)first + 8);
+    ASSERT_EQ(lush_pool_get_last_error(), LUSH_POOL_ERROR_INVALID_POINTER,
+              "Interior pointer should be rejected");
+    ASSERT(lush_pool_is_pool_pointer(first), "Block should still be live");
+
+    lush_pool_free(first);
+    lush_pool_free(second);
+    teardown_pool();
+}
+
 TEST(pool_get_last_error) {
     setup_pool();
 
@@ -608,6 +725,73 @@ TEST(pool_stress_mixed_sizes) {
     teardown_pool();
 }
 
+TEST(pool_stress_fallbacks) {
+    setup_pool();
+
+    /* Far more 16KB blocks than the xlarge slab holds */
+    enum { COUNT = 1000 };
+    void **ptrs = malloc(COUNT * sizeof(void *));
+    ASSERT_NOT_NULL(ptrs, "Pointer array should allocate");
+    for (int i = 0; i < COUNT; i++) {
+        ptrs[i] = lush_pool_alloc(16384);
+        ASSERT_NOT_NULL(ptrs[i], "Allocation should succeed");
+        *(int *)ptrs[i] = i;
+    }
+
+    /* Free in a scattered order */
+    for (int i = 0; i < COUNT; i++) {
+        int index = (i * 7919) % COUNT;
+        ASSERT_EQ(*(int *)ptrs[index], index, "Block contents intact");
+        lush_pool_free(ptrs[index]);
+    }
+    free(ptrs);
+
+    lush_pool_stats_t stats = lush_pool_get_stats();
+    ASSERT(stats.malloc_fallbacks > 0, "Overflow should use malloc");
+    ASSERT_EQ(stats.active_allocations, 0, "All allocations freed");
+
+    teardown_pool();
+}
+
+#define THREAD_BLOCKS 500
+
+static void *allocate_blocks_thread(void *arg) {
+    void **ptrs = arg;
+    for (int i = 0; i < THREAD_BLOCKS; i++) {
+        ptrs[i] = lush_pool_alloc(48);
+        if (ptrs[i]) {
+            memset(ptrs[i], 0x5A, 48);
+        }
+    }
+    return NULL;
+}
+
+TEST(pool_cross_thread_free) {
+    setup_pool();
+
+    /* Blocks allocated on one thread and freed on another */
+    void *ptrs[THREAD_BLOCKS];
+    pthread_t thread;
+    ASSERT(pthread_create(&thread, NULL, allocate_blocks_thread, ptrs) == 0,
+           "Thread should start");
+    pthread_join(thread, NULL);
+
+    for (int i = 0; i < THREAD_BLOCKS; i++) {
+        ASSERT_NOT_NULL(ptrs[i], "Thread allocation should succeed");
+        ASSERT(((unsigned char *)ptrs[i])[47] == 0x5A, "Contents intact");
+        lush_pool_free(ptrs[i]);
+    }
+
+    /* The exited thread returned its cached blocks */
+    size_t free_blocks = 0, total_blocks = 0;
+    lush_pool_get_pool_info(LUSH_POOL_SMALL, NULL, &free_blocks,
+                            &total_blocks);
+    ASSERT_EQ(free_blocks, total_blocks, "All blocks should be free");
+    ASSERT(lush_pool_is_healthy(), "Pool should be healthy");
+
+    teardown_pool();
+}
+
 /* ============================================================================
  * MAIN
  * ============================================================================ */
@@ -642,6 +826,8 @@ int main(void) {
     RUN_TEST(pool_realloc_shrink);
     RUN_TEST(pool_realloc_null);
     RUN_TEST(pool_realloc_zero_size);
+    RUN_TEST(pool_realloc_across_classes);
+    RUN_TEST(pool_realloc_fallback);
 
     printf("\nCalloc Tests:\n");
     RUN_TEST(pool_calloc_basic);
@@ -659,15 +845,17 @@ int main(void) {
 
     printf("\nPool Info Tests:\n");
     RUN_TEST(pool_get_recommended_size);
-    /* pool_get_pool_info test removed - function not implemented */
+    RUN_TEST(pool_get_pool_info);
     RUN_TEST(pool_is_healthy);
     RUN_TEST(pool_is_pool_pointer);
 
     printf("\nValidation Tests:\n");
-    /* pool_validate_integrity and pool_maintenance tests removed - functions not implemented */
+    /* pool_validate_integrity test removed - function not implemented */
+    RUN_TEST(pool_maintenance);
 
     printf("\nError Handling Tests:\n");
     RUN_TEST(pool_error_string);
+    RUN_TEST(pool_double_free_detected);
     RUN_TEST(pool_get_last_error);
     RUN_TEST(pool_set_debug_mode);
 
@@ -681,6 +869,8 @@ int main(void) {
     printf("\nStress Tests:\n");
     RUN_TEST(pool_stress_alloc_free);
     RUN_TEST(pool_stress_mixed_sizes);
+    RUN_TEST(pool_stress_fallbacks);
+    RUN_TEST(pool_cross_thread_free);
 
     printf("\n=== All lush_memory_pool.c tests passed! ===\n");
     return 0;
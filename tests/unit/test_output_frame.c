@@ -0,0 +1,206 @@
+/**
+ * @file test_output_frame.c
+ * @brief Unit tests for the redraw output frame
+ *
+ * Tests the output frame including:
+ * - A whole frame written with a single system call
+ * - Synchronized-update (DEC mode 2026) wrapping
+ * - Per-frame and cumulative byte and syscall counters
+ * - Frames larger than the initial buffer
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "display/output_frame.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Test framework macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name)                                                         \
+    do {                                                                       \
+        printf("  Running: %s...\n", #name);                                   \
+        test_##name();                                                         \
+        printf("    PASSED\n");                                                \
+    } while (0)
+
+#define ASSERT(condition, message)                                             \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define ASSERT_STR_EQ(actual, expected, message)                               \
+    do {                                                                       \
+        const char *_actual = (actual);                                        \
+        const char *_expected = (expected);                                    \
+        if (strcmp(_actual, _expected) != 0) {                                 \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      Expected: \"%s\", Got: \"%s\"\n", _expected,         \
+                   _actual);                                                   \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+static int pipe_fds[2];
+
+/**
+ * @brief Read everything currently in the pipe into a static buffer
+ */
+static const char *drain_pipe(void) {
+    static char buffer[65536];
+    size_t total = 0;
+    ssize_t n;
+    while (total < sizeof(buffer) - 1 &&
+           (n = read(pipe_fds[0], buffer + total,
+                     sizeof(buffer) - 1 - total)) > 0) {
+        total += (size_t)n;
+    }
+    buffer[total] = '\0';
+    return buffer;
+}
+
+static void open_pipe(void) {
+    ASSERT(pipe(pipe_fds) == 0, "pipe");
+    fcntl(pipe_fds[0], F_SETFL, O_NONBLOCK);
+}
+
+static void close_pipe(void) {
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+/* ============================================================================
+ * TESTS
+ * ============================================================================
+ */
+
+TEST(single_write_per_frame) {
+    open_pipe();
+    output_frame_t frame;
+    output_frame_init(&frame, pipe_fds[1]);
+
+    output_frame_begin(&frame);
+    output_frame_appendf(&frame, "\033[%dG", 3);
+    output_frame_append_str(&frame, "\033[J");
+    for (const char *p = "echo hello"; *p; p++) {
+        output_frame_append(&frame, p, 1);
+    }
+    ASSERT(frame.stats.syscalls == 0, "nothing written before flush");
+    ASSERT(output_frame_flush(&frame) == 0, "flush succeeds");
+
+    ASSERT_STR_EQ(drain_pipe(), "\033[3G\033[Jecho hello", "frame contents");
+
+    output_frame_stats_t stats;
+    output_frame_get_stats(&frame, &stats);
+    ASSERT(stats.frames == 1, "one frame");
+    ASSERT(stats.last_frame_syscalls == 1, "one write for the frame");
+    ASSERT(stats.last_frame_bytes == 17, "frame byte count");
+
+    /* An empty frame writes nothing */
+    output_frame_begin(&frame);
+    ASSERT(output_frame_flush(&frame) == 0, "empty flush succeeds");
+    output_frame_get_stats(&frame, &stats);
+    ASSERT(stats.frames == 1 && stats.syscalls == 1, "empty frame skipped");
+
+    output_frame_cleanup(&frame);
+    close_pipe();
+}
+
+TEST(synchronized_wrapping) {
+    open_pipe();
+    output_frame_t frame;
+    output_frame_init(&frame, pipe_fds[1]);
+    output_frame_set_synchronized(&frame, true);
+
+    output_frame_begin(&frame);
+    output_frame_append_str(&frame, "prompt$ ");
+    output_frame_flush(&frame);
+
+    ASSERT_STR_EQ(drain_pipe(), "\033[?2026hprompt$ \033[?2026l",
+                  "frame wrapped in mode 2026");
+
+    output_frame_stats_t stats;
+    output_frame_get_stats(&frame, &stats);
+    ASSERT(stats.last_frame_syscalls == 1, "markers share the write");
+    ASSERT(stats.last_frame_bytes == 24, "markers counted");
+
+    output_frame_set_synchronized(&frame, false);
+    output_frame_append_str(&frame, "x");
+    output_frame_flush(&frame);
+    ASSERT_STR_EQ(drain_pipe(), "x", "wrapping disabled");
+
+    output_frame_cleanup(&frame);
+    close_pipe();
+}
+
+TEST(begin_discards_pending) {
+    open_pipe();
+    output_frame_t frame;
+    output_frame_init(&frame, pipe_fds[1]);
+
+    output_frame_append_str(&frame, "stale");
+    output_frame_begin(&frame);
+    output_frame_append_str(&frame, "fresh");
+    output_frame_flush(&frame);
+    ASSERT_STR_EQ(drain_pipe(), "fresh", "only the new frame is written");
+
+    output_frame_cleanup(&frame);
+    close_pipe();
+}
+
+TEST(large_frame) {
+    open_pipe();
+    output_frame_t frame;
+    output_frame_init(&frame, pipe_fds[1]);
+
+    /* Several times the initial capacity, one character at a time */
+    size_t total = OUTPUT_FRAME_INITIAL_CAPACITY * 3 + 17;
+    output_frame_begin(&frame);
+    for (size_t i = 0; i < total; i++) {
+        char c = (char)('a' + i % 26);
+        output_frame_append(&frame, &c, 1);
+    }
+    output_frame_flush(&frame);
+
+    const char *out = drain_pipe();
+    ASSERT(strlen(out) == total, "all bytes written");
+    ASSERT(out[0] == 'a' && out[total - 1] == (char)('a' + (total - 1) % 26),
+           "bytes in order");
+
+    output_frame_stats_t stats;
+    output_frame_get_stats(&frame, &stats);
+    ASSERT(stats.last_frame_syscalls == 1, "one write for a large frame");
+    ASSERT(stats.max_frame_bytes == total, "largest frame recorded");
+    ASSERT(stats.bytes == total, "cumulative bytes");
+
+    output_frame_cleanup(&frame);
+    close_pipe();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("Output Frame Unit Tests\n");
+    printf("========================================\n");
+
+    printf("\nOutput frame tests:\n");
+    RUN_TEST(single_write_per_frame);
+    RUN_TEST(synchronized_wrapping);
+    RUN_TEST(begin_discards_pending);
+    RUN_TEST(large_frame);
+
+    printf("\n========================================\n");
+    printf("All output frame tests PASSED!\n");
+    printf("========================================\n");
+
+    return 0;
+}
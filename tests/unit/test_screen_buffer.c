@@ -16,6 +16,7 @@
 #include <stdbool.h>
 
 #include "display/screen_buffer.h"
+#include "lle/utf8_support.h"
 
 /* Test framework macros */
 static int tests_run = 0;
@@ -1152,6 +1153,587 @@ static int test_render_with_continuation_single_line(void) {
     return 1;
 }
 
+/* ============================================================
+ * STYLE TRACKING TESTS
+ * ============================================================ */
+
+static int test_style_apply_sgr(void) {
+    screen_style_t style = {0};
+
+    ASSERT(screen_style_apply_sgr(&style, "1;38;2;42;161;152", 17));
+    ASSERT_EQ(style.attrs, SCREEN_ATTR_BOLD);
+    ASSERT(style.fg == (SCREEN_COLOR_RGB | 0x2AA198));
+
+    ASSERT(screen_style_apply_sgr(&style, "22;90;48;5;236", 14));
+    ASSERT_EQ(style.attrs, 0);
+    ASSERT(style.fg == (SCREEN_COLOR_BASIC | 8));
+    ASSERT(style.bg == (SCREEN_COLOR_INDEXED | 236));
+
+    /* Empty parameter list is a reset */
+    ASSERT(screen_style_apply_sgr(&style, "", 0));
+    ASSERT(style.fg == SCREEN_COLOR_DEFAULT && style.bg == 0 &&
+           style.attrs == 0);
+
+    /* Colon sub-parameters are not tracked */
+    ASSERT(!screen_style_apply_sgr(&style, "4:3", 3));
+    return 1;
+}
+
+static int test_render_tracks_cell_style(void) {
+    static screen_buffer_t buffer;
+    screen_buffer_init(&buffer, 80);
+
+    screen_buffer_render(&buffer, "\033[32m$\033[0m ",
+                         "\033[1;31mls\033[0m -l", 5);
+
+    ASSERT(buffer.lines[0].cells[0].style.fg == (SCREEN_COLOR_BASIC | 2));
+    ASSERT_EQ(buffer.lines[0].cells[1].style.fg, 0);
+    ASSERT(buffer.lines[0].cells[2].style.fg == (SCREEN_COLOR_BASIC | 1));
+    ASSERT_EQ(buffer.lines[0].cells[2].style.attrs, SCREEN_ATTR_BOLD);
+    ASSERT_EQ(buffer.lines[0].cells[5].style.attrs, 0);
+    ASSERT(!buffer.inexact);
+
+    /* Cursor movement inside the command cannot be modelled */
+    screen_buffer_render(&buffer, "$ ", "ab\033[2Dc", 3);
+    ASSERT(buffer.inexact);
+
+    screen_buffer_cleanup(&buffer);
+    return 1;
+}
+
+static int test_copy_duplicates_prefixes(void) {
+    static screen_buffer_t src, dest;
+    screen_buffer_init(&src, 80);
+    screen_buffer_init(&dest, 80);
+
+    screen_buffer_render_with_continuation(&src, "$ ", "for x\ndo", 8,
+                                           test_continuation_cb, NULL);
+    screen_buffer_copy(&dest, &src);
+
+    /* Re-rendering the source frees its prefixes; the copy keeps its own */
+    screen_buffer_render_with_continuation(&src, "$ ", "echo", 4,
+                                           test_continuation_cb, NULL);
+    ASSERT_NOT_NULL(screen_buffer_get_line_prefix(&dest, 1));
+    ASSERT_STR_EQ(screen_buffer_get_line_prefix(&dest, 1), "> ");
+    ASSERT_NULL(screen_buffer_get_line_prefix(&src, 1));
+
+    screen_buffer_cleanup(&src);
+    screen_buffer_cleanup(&dest);
+    return 1;
+}
+
+/* ============================================================
+ * DIFFERENTIAL RENDERING TESTS
+ *
+ * A minimal terminal emulator replays the generated update over the old
+ * screen; the result must match the new screen painted from scratch.
+ * ============================================================ */
+
+#define VT_ROWS 100
+#define VT_COLS 128
+
+typedef struct {
+    char bytes[4];
+    int len; /* 0 for an empty cell */
+    int width;
+    bool continuation; /* Right half of a wide character */
+    screen_style_t style;
+} vt_cell_t;
+
+typedef struct {
+    vt_cell_t cells[VT_ROWS][VT_COLS];
+    int width;
+    int row;
+    int col;
+    bool pending_wrap;
+    screen_style_t style;
+} vt_t;
+
+static void vt_blank(vt_t *vt, int row, int col) {
+    if (row >= 0 && row < VT_ROWS && col >= 0 && col < vt->width) {
+        memset(&vt->cells[row][col], 0, sizeof(vt_cell_t));
+    }
+}
+
+static void vt_put(vt_t *vt, const char *bytes, int len, int width) {
+    if (vt->pending_wrap) {
+        vt->row++;
+        vt->col = 0;
+        vt->pending_wrap = false;
+    }
+    int row = vt->row;
+    int col = vt->col;
+    if (row >= VT_ROWS) {
+        return;
+    }
+
+    /* Overwriting half of a wide character erases the other half */
+    if (vt->cells[row][col].continuation) {
+        vt_blank(vt, row, col - 1);
+    }
+    if (vt->cells[row][col].width == 2) {
+        vt_blank(vt, row, col + 1);
+    }
+    if (width == 2 && col + 1 < vt->width &&
+        vt->cells[row][col + 1].width == 2) {
+        vt_blank(vt, row, col + 2);
+    }
+
+    vt_cell_t *cell = &vt->cells[row][col];
+    memset(cell, 0, sizeof(vt_cell_t));
+    memcpy(cell->bytes, bytes, (size_t)len);
+    cell->len = len;
+    cell->width = width;
+    cell->style = vt->style;
+    if (width == 2 && col + 1 < vt->width) {
+        vt_blank(vt, row, col + 1);
+        vt->cells[row][col + 1].continuation = true;
+    }
+
+    vt->col += width;
+    if (vt->col >= vt->width) {
+        vt->col = vt->width - 1;
+        vt->pending_wrap = true;
+    }
+}
+
+static void vt_feed(vt_t *vt, const char *data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        unsigned char ch = (unsigned char)data[i];
+
+        if (ch == '\033' && i + 1 < length && data[i + 1] == '[') {
+            size_t start = i + 2;
+            size_t j = start;
+            while (j < length && !((data[j] >= 'A' && data[j] <= 'Z') ||
+                                   (data[j] >= 'a' && data[j] <= 'z'))) {
+                j++;
+            }
+            if (j >= length) {
+                return;
+            }
+            int n = atoi(data + start);
+            int count = n > 0 ? n : 1;
+            switch (data[j]) {
+            case 'A':
+                vt->row = vt->row - count < 0 ? 0 : vt->row - count;
+                vt->pending_wrap = false;
+                break;
+            case 'B':
+                vt->row = vt->row + count >= VT_ROWS ? VT_ROWS - 1
+                                                     : vt->row + count;
+                vt->pending_wrap = false;
+                break;
+            case 'G':
+                vt->col = count - 1 < vt->width ? count - 1 : vt->width - 1;
+                vt->pending_wrap = false;
+                break;
+            case 'K':
+                for (int c = vt->col; c < vt->width; c++) {
+                    vt_blank(vt, vt->row, c);
+                }
+                break;
+            case 'J':
+                for (int c = vt->col; c < vt->width; c++) {
+                    vt_blank(vt, vt->row, c);
+                }
+                for (int r = vt->row + 1; r < VT_ROWS; r++) {
+                    for (int c = 0; c < vt->width; c++) {
+                        vt_blank(vt, r, c);
+                    }
+                }
+                break;
+            case 'm':
+                screen_style_apply_sgr(&vt->style, data + start, j - start);
+                break;
+            }
+            i = j + 1;
+            continue;
+        }
+
+        if (ch == '\n') {
+            /* OPOST/ONLCR stay on in raw mode */
+            vt->row++;
+            vt->col = 0;
+            vt->pending_wrap = false;
+            i++;
+            continue;
+        }
+
+        uint32_t codepoint;
+        int len = lle_utf8_decode_codepoint(data + i, length - i, &codepoint);
+        if (len <= 0) {
+            i++;
+            continue;
+        }
+        vt_put(vt, data + i, len, lle_utf8_codepoint_width(codepoint));
+        i += (size_t)len;
+    }
+}
+
+/* What a correct redraw leaves on the terminal for a screen */
+static void vt_paint_screen(vt_t *vt, const screen_buffer_t *screen) {
+    memset(vt, 0, sizeof(vt_t));
+    vt->width = screen->terminal_width;
+
+    for (int row = 0; row < screen->num_rows; row++) {
+        vt->row = row;
+        vt->col = 0;
+        vt->pending_wrap = false;
+        memset(&vt->style, 0, sizeof(vt->style));
+
+        const char *prefix = screen_buffer_get_line_prefix(screen, row);
+        if (prefix) {
+            vt_feed(vt, prefix, strlen(prefix));
+        }
+
+        const screen_line_t *line = &screen->lines[row];
+        for (int col = 0; col < line->length; col++) {
+            const screen_cell_t *cell = &line->cells[col];
+            if (cell->byte_len == 0) {
+                continue;
+            }
+            vt->row = row;
+            vt->col = col;
+            vt->pending_wrap = false;
+            vt->style = cell->style;
+            vt_put(vt, cell->utf8_bytes, cell->byte_len, cell->visual_width);
+        }
+    }
+
+    vt->row = screen->cursor_row;
+    vt->col = screen->cursor_col < vt->width ? screen->cursor_col
+                                             : vt->width - 1;
+    vt->pending_wrap = false;
+    memset(&vt->style, 0, sizeof(vt->style));
+}
+
+static bool vt_cell_blank(const vt_cell_t *cell) {
+    return cell->len == 0 ||
+           (cell->len == 1 && cell->bytes[0] == ' ' && cell->style.fg == 0 &&
+            cell->style.bg == 0 && cell->style.attrs == 0);
+}
+
+static bool vt_equal(const vt_t *a, const vt_t *b) {
+    for (int row = 0; row < VT_ROWS; row++) {
+        for (int col = 0; col < a->width; col++) {
+            const vt_cell_t *x = &a->cells[row][col];
+            const vt_cell_t *y = &b->cells[row][col];
+            if (vt_cell_blank(x) && vt_cell_blank(y)) {
+                continue;
+            }
+            if (x->len != y->len || memcmp(x->bytes, y->bytes, x->len) != 0 ||
+                x->width != y->width || x->style.fg != y->style.fg ||
+                x->style.bg != y->style.bg ||
+                x->style.attrs != y->style.attrs) {
+                printf("  cell mismatch at row %d col %d\n", row, col);
+                return false;
+            }
+        }
+    }
+    if (a->row != b->row || a->col != b->col) {
+        printf("  cursor mismatch: (%d,%d) vs (%d,%d)\n", a->row, a->col,
+               b->row, b->col);
+        return false;
+    }
+    return a->style.fg == 0 && a->style.bg == 0 && a->style.attrs == 0;
+}
+
+typedef enum { DIFF_APPLIED, DIFF_REFUSED, DIFF_WRONG } diff_outcome_t;
+
+/* Replay the diff from old_screen to new_screen and check the result */
+static diff_outcome_t replay_diff(const screen_buffer_t *old_screen,
+                                  const screen_buffer_t *new_screen,
+                                  size_t *bytes) {
+    static vt_t actual, expected;
+    output_frame_t frame;
+    output_frame_init(&frame, -1);
+
+    vt_paint_screen(&actual, old_screen);
+    diff_outcome_t outcome = DIFF_REFUSED;
+    if (screen_buffer_render_diff(old_screen, new_screen, &frame)) {
+        vt_feed(&actual, frame.data, frame.length);
+        vt_paint_screen(&expected, new_screen);
+        outcome = vt_equal(&actual, &expected) ? DIFF_APPLIED : DIFF_WRONG;
+    } else if (frame.length != 0) {
+        outcome = DIFF_WRONG;
+    }
+
+    if (bytes) {
+        *bytes = frame.length;
+    }
+    output_frame_cleanup(&frame);
+    return outcome;
+}
+
+static int test_diff_identical_screens(void) {
+    static screen_buffer_t a, b;
+    screen_buffer_init(&a, 80);
+    screen_buffer_init(&b, 80);
+    screen_buffer_render(&a, "$ ", "\033[1;32mecho\033[0m hi", 7);
+    screen_buffer_render(&b, "$ ", "\033[1;32mecho\033[0m hi", 7);
+
+    size_t bytes = 99;
+    ASSERT(replay_diff(&a, &b, &bytes) == DIFF_APPLIED);
+    ASSERT_EQ(bytes, 0);
+
+    /* Only the cursor moved */
+    screen_buffer_render(&b, "$ ", "\033[1;32mecho\033[0m hi", 2);
+    ASSERT(replay_diff(&a, &b, &bytes) == DIFF_APPLIED);
+    ASSERT(bytes <= 6);
+
+    screen_buffer_cleanup(&a);
+    screen_buffer_cleanup(&b);
+    return 1;
+}
+
+/* Highlighted command of 3360 columns: 42 rows at 80 columns */
+static void build_long_command(char *out, size_t size, const char *tail) {
+    size_t pos = 0;
+    for (int i = 0; pos + 64 < size && i < 480; i++) {
+        pos += (size_t)snprintf(out + pos, size - pos,
+                                i % 2 ? "\033[38;5;%dmarg%03d\033[0m "
+                                      : "\033[1;3%dmcmd%03d\033[0m ",
+                                i % 2 ? 100 + i % 100 : 1 + i % 6, i);
+    }
+    snprintf(out + pos, size - pos, "%s", tail);
+}
+
+static int test_diff_keypress_in_long_command(void) {
+    static screen_buffer_t a, b;
+    static char old_text[32768], new_text[32768];
+    screen_buffer_init(&a, 80);
+    screen_buffer_init(&b, 80);
+
+    build_long_command(old_text, sizeof(old_text), "x");
+    build_long_command(new_text, sizeof(new_text), "xy");
+    screen_buffer_render(&a, "$ ", old_text, 3361);
+    screen_buffer_render(&b, "$ ", new_text, 3362);
+    ASSERT(b.num_rows >= 40);
+
+    size_t bytes = 0;
+    ASSERT(replay_diff(&a, &b, &bytes) == DIFF_APPLIED);
+    printf("    keypress at end of %d rows: %zu bytes\n", b.num_rows, bytes);
+    ASSERT(bytes < 32);
+
+    screen_buffer_cleanup(&a);
+    screen_buffer_cleanup(&b);
+    return 1;
+}
+
+static int test_diff_edit_inside_multiline_command(void) {
+    static screen_buffer_t a, b;
+    static char old_text[4096], new_text[4096];
+    screen_buffer_init(&a, 80);
+    screen_buffer_init(&b, 80);
+
+    size_t old_pos = 0, new_pos = 0;
+    for (int i = 0; i < 40; i++) {
+        old_pos += (size_t)snprintf(old_text + old_pos,
+                                    sizeof(old_text) - old_pos,
+                                    "\033[1;32mecho\033[0m line%02d%s", i,
+                                    i < 39 ? "\n" : "");
+        new_pos += (size_t)snprintf(new_text + new_pos,
+                                    sizeof(new_text) - new_pos,
+                                    "\033[1;32mecho\033[0m %sline%02d%s",
+                                    i == 20 ? "-n " : "", i,
+                                    i < 39 ? "\n" : "");
+    }
+    screen_buffer_render_with_continuation(&a, "$ ", old_text, 260,
+                                           test_continuation_cb, NULL);
+    screen_buffer_render_with_continuation(&b, "$ ", new_text, 263,
+                                           test_continuation_cb, NULL);
+    ASSERT_EQ(b.num_rows, 40);
+
+    size_t bytes = 0;
+    ASSERT(replay_diff(&a, &b, &bytes) == DIFF_APPLIED);
+    printf("    edit in line 20 of 40: %zu bytes\n", bytes);
+    ASSERT(bytes < 64);
+
+    screen_buffer_cleanup(&a);
+    screen_buffer_cleanup(&b);
+    return 1;
+}
+
+static int test_diff_recolor_and_shrink(void) {
+    static screen_buffer_t a, b;
+    screen_buffer_init(&a, 20);
+    screen_buffer_init(&b, 20);
+
+    /* Command word changes color as it becomes valid */
+    screen_buffer_render(&a, "$ ", "\033[31mech\033[0m", 3);
+    screen_buffer_render(&b, "$ ", "\033[1;32mecho\033[0m", 4);
+    ASSERT(replay_diff(&a, &b, NULL) == DIFF_APPLIED);
+
+    /* Three wrapped rows with ghost text and a menu shrink to one row */
+    screen_buffer_render(&a, "$ ", "\033[32mecho\033[0m aaaaaaaaaaaaaaaaaaaaaa",
+                         27);
+    screen_buffer_add_ghost_text(&a, " --suggested-flag");
+    screen_buffer_add_text_rows(&a, a.num_rows,
+                                "\033[7mitem1\033[0m  item2\nitem3");
+    screen_buffer_render(&b, "$ ", "\033[32mecho\033[0m", 4);
+
+    size_t bytes = 0;
+    ASSERT(replay_diff(&a, &b, &bytes) == DIFF_APPLIED);
+    ASSERT(bytes < 40);
+
+    /* And grow back */
+    ASSERT(replay_diff(&b, &a, NULL) == DIFF_APPLIED);
+
+    screen_buffer_cleanup(&a);
+    screen_buffer_cleanup(&b);
+    return 1;
+}
+
+static int test_diff_requires_full_redraw(void) {
+    static screen_buffer_t a, b;
+    screen_buffer_init(&a, 80);
+    screen_buffer_init(&b, 80);
+
+    screen_buffer_render(&a, "$ ", "ls", 2);
+
+    /* Prompt changed */
+    screen_buffer_render(&b, "# ", "ls", 2);
+    ASSERT(replay_diff(&a, &b, NULL) == DIFF_REFUSED);
+
+    /* Terminal resized */
+    b.terminal_width = 100;
+    screen_buffer_render(&b, "$ ", "ls", 2);
+    ASSERT(replay_diff(&a, &b, NULL) == DIFF_REFUSED);
+
+    /* Tabs depend on the terminal's tab stops */
+    b.terminal_width = 80;
+    screen_buffer_render(&b, "$ ", "ls\t-l", 5);
+    ASSERT(b.inexact);
+    ASSERT(replay_diff(&a, &b, NULL) == DIFF_REFUSED);
+
+    screen_buffer_cleanup(&a);
+    screen_buffer_cleanup(&b);
+    return 1;
+}
+
+/* Alternating continuation prompts, one of them colored */
+static const char *diff_continuation_cb(const char *line_text,
+                                        size_t line_len, int line_number,
+                                        void *user_data) {
+    (void)line_text;
+    (void)line_len;
+    (void)user_data;
+    return line_number % 2 ? "\033[33m>>\033[0m " : "> ";
+}
+
+static void render_random(screen_buffer_t *screen, const char *plain,
+                          size_t cursor, unsigned int variant) {
+    static const char *colors[] = {"", "\033[1;32m", "\033[38;5;208m",
+                                   "\033[4;38;2;10;20;30m", "\033[7m"};
+    char text[8192];
+    size_t pos = 0;
+    size_t word = 0;
+    bool in_word = false;
+
+    for (const char *p = plain; *p && pos + 32 < sizeof(text); p++) {
+        bool space = (*p == ' ' || *p == '\n');
+        if (!space && !in_word) {
+            const char *color = colors[(word + variant) % 5];
+            pos += (size_t)snprintf(text + pos, sizeof(text) - pos, "%s",
+                                    color);
+            in_word = true;
+        } else if (space && in_word) {
+            pos += (size_t)snprintf(text + pos, sizeof(text) - pos, "\033[0m");
+            in_word = false;
+            word++;
+        }
+        text[pos++] = *p;
+    }
+    if (in_word) {
+        pos += (size_t)snprintf(text + pos, sizeof(text) - pos, "\033[0m");
+    }
+    text[pos] = '\0';
+
+    if (strchr(plain, '\n')) {
+        screen_buffer_render_with_continuation(screen, "$ ", text, cursor,
+                                               diff_continuation_cb, NULL);
+    } else {
+        for (int r = 0; r < SCREEN_BUFFER_MAX_ROWS; r++) {
+            screen_buffer_clear_line_prefix(screen, r);
+        }
+        screen_buffer_render(screen, "$ ", text, cursor);
+        if (variant % 3 == 0 && cursor == strlen(plain)) {
+            screen_buffer_add_ghost_text(screen, "ghost \xe4\xb8\xad text");
+        }
+    }
+    if (variant % 7 == 0) {
+        screen_buffer_add_text_rows(screen, screen->num_rows,
+                                    "\033[7m file1 \033[0m file2\ndir/");
+    }
+}
+
+static int test_diff_random_edits(void) {
+    static screen_buffer_t screens[2];
+    static const char *pieces[] = {"a",  "b",     " ",  "\xe4\xb8\xad",
+                                   "\n", "echo ", "xyz", "\xc3\xa9"};
+    char plain[512] = "";
+    size_t length = 0;
+    int applied = 0;
+
+    srand(12345);
+    screen_buffer_init(&screens[0], 17);
+    screen_buffer_init(&screens[1], 17);
+    render_random(&screens[0], plain, 0, 0);
+
+    for (int step = 0; step < 3000; step++) {
+        /* Random insertion or deletion at a character boundary */
+        size_t at = length ? (size_t)rand() % (length + 1) : 0;
+        while (at > 0 && at < length && (plain[at] & 0xC0) == 0x80) {
+            at--;
+        }
+        if (length > 0 && (rand() % 3 == 0 || length > 200)) {
+            size_t end = at < length ? at + 1 : at;
+            while (end < length && (plain[end] & 0xC0) == 0x80) {
+                end++;
+            }
+            if (at == length && at > 0) {
+                at--;
+                while (at > 0 && (plain[at] & 0xC0) == 0x80) {
+                    at--;
+                }
+            }
+            memmove(plain + at, plain + end, length - end + 1);
+            length -= end - at;
+        } else {
+            const char *piece = pieces[rand() % 8];
+            size_t n = strlen(piece);
+            memmove(plain + at + n, plain + at, length - at + 1);
+            memcpy(plain + at, piece, n);
+            length += n;
+            at += n;
+        }
+        if (at > length) {
+            at = length;
+        }
+
+        screen_buffer_t *old_screen = &screens[step % 2];
+        screen_buffer_t *new_screen = &screens[(step + 1) % 2];
+        render_random(new_screen, plain, at, (unsigned int)rand());
+
+        diff_outcome_t outcome = replay_diff(old_screen, new_screen, NULL);
+        if (outcome == DIFF_WRONG) {
+            printf("  step %d: wrong update for \"%s\"\n", step, plain);
+            return 0;
+        }
+        if (outcome == DIFF_APPLIED) {
+            applied++;
+        }
+    }
+
+    printf("    %d of 3000 updates diffed\n", applied);
+    ASSERT(applied > 1500);
+
+    screen_buffer_cleanup(&screens[0]);
+    screen_buffer_cleanup(&screens[1]);
+    return 1;
+}
+
 /* ============================================================
  * MAIN
  * ============================================================ */
@@ -1285,6 +1867,19 @@ int main(void) {
     RUN_TEST(test_render_with_continuation_adds_prefix);
     RUN_TEST(test_render_with_continuation_single_line);
 
+    printf("\n=== Style Tracking Tests ===\n");
+    RUN_TEST(test_style_apply_sgr);
+    RUN_TEST(test_render_tracks_cell_style);
+    RUN_TEST(test_copy_duplicates_prefixes);
+
+    printf("\n=== Differential Rendering Tests ===\n");
+    RUN_TEST(test_diff_identical_screens);
+    RUN_TEST(test_diff_keypress_in_long_command);
+    RUN_TEST(test_diff_edit_inside_multiline_command);
+    RUN_TEST(test_diff_recolor_and_shrink);
+    RUN_TEST(test_diff_requires_full_redraw);
+    RUN_TEST(test_diff_random_edits);
+
     printf("\n=== Summary ===\n");
     printf("Tests run: %d\n", tests_run);
     printf("Tests passed: %d\n", tests_passed);
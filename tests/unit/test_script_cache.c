@@ -0,0 +1,442 @@
+/**
+ * @file test_script_cache.c
+ * @brief Unit tests for whole-file script parsing and the script cache
+ *
+ * Tests the script loader including:
+ * - Top-level commands of a parsed file
+ * - Backslash-newline joining and page-sized files
+ * - Files that are not loaded (syntax errors, non-regular files)
+ * - Cache hits, revalidation after a change, and reference counting
+ * - On-disk cache round trips, invalidation and corrupt cache files
+ *
+ * @author Michael Berry <trismegustis@gmail.com>
+ * @copyright Copyright (C) 2021-2026 Michael Berry
+ */
+
+#include "script_cache.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Test framework macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name)                                                         \
+    do {                                                                       \
+        printf("  Running: %s...\n", #name);                                   \
+        test_##name();                                                         \
+        printf("    PASSED\n");                                                \
+    } while (0)
+
+#define ASSERT(condition, message)                                             \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define ASSERT_EQ(actual, expected, message)                                   \
+    do {                                                                       \
+        if ((actual) != (expected)) {                                          \
+            printf("    FAILED: %s\n", message);                               \
+            printf("      Expected: %d, Got: %d\n", (int)(expected),           \
+                   (int)(actual));                                             \
+            printf("      at %s:%d\n", __FILE__, __LINE__);                    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+static char script_path[64];
+static char cache_dir[64];
+
+/* Write a script file, making sure its modification time changes */
+static void write_script(const char *text) {
+    static long stamp = 1000000;
+    FILE *f = fopen(script_path, "w");
+    ASSERT(f != NULL, "script file should be writable");
+    fputs(text, f);
+    fclose(f);
+
+    struct timespec times[2] = {{stamp, 0}, {stamp, 0}};
+    stamp++;
+    utimensat(AT_FDCWD, script_path, times, 0);
+}
+
+static int count_commands(const script_ast_t *script) {
+    int count = 0;
+    for (node_t *n = script_ast_commands(script); n; n = n->next_sibling) {
+        count++;
+    }
+    return count;
+}
+
+/* ============================================================================
+ * PARSING TESTS
+ * ============================================================================
+ */
+
+TEST(top_level_commands) {
+    write_script("echo one\n"
+                 "f() {\n  echo in f\n}\n"
+                 "for i in a b; do\n  echo $i\ndone; echo two\n"
+                 "cat <<EOF\nbody\nEOF\n");
+    script_ast_t *script = script_ast_load(script_path, 0);
+    ASSERT(script != NULL, "script should parse");
+    ASSERT_EQ(count_commands(script), 5, "five top-level commands");
+
+    node_t *first = script_ast_commands(script);
+    ASSERT_EQ(first->type, NODE_COMMAND, "first command is simple");
+    ASSERT(strcmp(first->val.str, "echo") == 0, "first command is echo");
+    ASSERT_EQ(first->loc.line, 1, "first command on line 1");
+    ASSERT_EQ(first->next_sibling->type, NODE_FUNCTION,
+              "second command defines a function");
+    ASSERT(strcmp(first->loc.filename, script_path) == 0,
+           "nodes name the script file");
+    script_ast_release(script);
+}
+
+TEST(empty_file) {
+    write_script("");
+    script_ast_t *script = script_ast_load(script_path, 0);
+    ASSERT(script != NULL, "empty file should load");
+    ASSERT(script_ast_commands(script) == NULL, "empty file has no commands");
+    script_ast_release(script);
+
+    write_script("# only a comment\n\n");
+    script = script_ast_load(script_path, 0);
+    ASSERT(script != NULL, "comment-only file should load");
+    ASSERT_EQ(count_commands(script), 0, "comment-only file has no commands");
+    script_ast_release(script);
+}
+
+TEST(line_continuations) {
+    write_script("echo a \\\n  b\necho c\n");
+    script_ast_t *script = script_ast_load(script_path, 0);
+    ASSERT(script != NULL, "continued line should parse");
+    ASSERT_EQ(count_commands(script), 2, "continuation joins one command");
+    script_ast_release(script);
+}
+
+TEST(page_sized_file) {
+    /* No zero bytes follow the mapping of a file that fills its last page */
+    long page = sysconf(_SC_PAGESIZE);
+    char *text = malloc((size_t)page + 1);
+    ASSERT(text != NULL, "allocation should succeed");
+    memset(text, ' ', (size_t)page);
+    memcpy(text, "echo first", 10);
+    memcpy(text + page - 9, "echo end\n", 9);
+    text[page - 10] = '\n';
+    text[page] = '\0';
+    write_script(text);
+    free(text);
+
+    script_ast_t *script = script_ast_load(script_path, 0);
+    ASSERT(script != NULL, "page-sized file should parse");
+    ASSERT_EQ(count_commands(script), 2, "page-sized file has two commands");
+    script_ast_release(script);
+}
+
+TEST(not_loaded) {
+    int flags = SCRIPT_CACHE_MEMORY;
+    write_script("echo one\nif then\necho three\n");
+    ASSERT(script_ast_load(script_path, flags) == NULL,
+           "file with a syntax error should not load");
+    write_script("echo a\nfi\necho b\n");
+    ASSERT(script_ast_load(script_path, flags) == NULL,
+           "file the parser stops short in should not load");
+
+    ASSERT(script_ast_load("/dev/null", flags) == NULL,
+           "non-regular file should not load");
+    ASSERT(script_ast_load("/nonexistent/script.sh", flags) == NULL,
+           "missing file should not load");
+}
+
+/* ============================================================================
+ * CACHE TESTS
+ * ============================================================================
+ */
+
+TEST(cache_reuse) {
+    script_cache_clear();
+    script_cache_stats_t before, after;
+    script_cache_get_stats(&before);
+
+    write_script("echo cached\n");
+    script_ast_t *first = script_ast_load(script_path, SCRIPT_CACHE_MEMORY);
+    script_ast_t *second = script_ast_load(script_path, SCRIPT_CACHE_MEMORY);
+    ASSERT(first != NULL && first == second,
+           "unchanged file should come from the cache");
+
+    script_cache_get_stats(&after);
+    ASSERT_EQ(after.misses - before.misses, 1, "one parse");
+    ASSERT_EQ(after.hits - before.hits, 1, "one cache hit");
+    ASSERT_EQ(after.entries, 1, "one cached script");
+
+    script_ast_release(first);
+    script_ast_release(second);
+}
+
+TEST(cache_revalidation) {
+    script_cache_clear();
+    write_script("echo old\n");
+    script_ast_t *old = script_ast_load(script_path, SCRIPT_CACHE_MEMORY);
+    ASSERT(old != NULL, "old version should load");
+
+    write_script("echo new\necho lines\n");
+    script_ast_t *fresh = script_ast_load(script_path, SCRIPT_CACHE_MEMORY);
+    ASSERT(fresh != NULL && fresh != old, "changed file should be reparsed");
+    ASSERT_EQ(count_commands(fresh), 2, "new version has two commands");
+
+    /* The replaced version stays usable until released */
+    ASSERT_EQ(count_commands(old), 1, "old version still has one command");
+    ASSERT(strcmp(script_ast_commands(old)->first_child->val.str, "old") == 0,
+           "old version keeps its text");
+    script_ast_release(old);
+
+    script_cache_stats_t stats;
+    script_cache_get_stats(&stats);
+    ASSERT_EQ(stats.entries, 1, "replaced entry is not counted twice");
+
+    script_cache_clear();
+    ASSERT_EQ(count_commands(fresh), 2,
+              "cleared script stays usable until released");
+    script_ast_release(fresh);
+}
+
+TEST(uncached_load) {
+    script_cache_clear();
+    write_script("echo uncached\n");
+    script_ast_t *first = script_ast_load(script_path, 0);
+    script_ast_t *second = script_ast_load(script_path, 0);
+    ASSERT(first && second && first != second,
+           "uncached loads parse separately");
+
+    script_cache_stats_t stats;
+    script_cache_get_stats(&stats);
+    ASSERT_EQ(stats.entries, 0, "uncached loads are not cached");
+    script_ast_release(first);
+    script_ast_release(second);
+}
+
+/* ============================================================================
+ * ON-DISK CACHE TESTS
+ * ============================================================================
+ */
+
+/* Check that two trees match node for node */
+static bool same_tree(const node_t *a, const node_t *b) {
+    for (; a && b; a = a->next_sibling, b = b->next_sibling) {
+        if (a->type != b->type || a->val_type != b->val_type ||
+            a->children != b->children || a->loc.line != b->loc.line ||
+            a->loc.column != b->loc.column ||
+            (a->loc.filename == NULL) != (b->loc.filename == NULL)) {
+            return false;
+        }
+        if (a->val_type == VAL_STR) {
+            if ((a->val.str == NULL) != (b->val.str == NULL) ||
+                (a->val.str && strcmp(a->val.str, b->val.str) != 0)) {
+                return false;
+            }
+        } else if (a->val_type == VAL_SINT && a->val.sint != b->val.sint) {
+            return false;
+        }
+        if ((b->next_sibling && b->next_sibling->prev_sibling != b) ||
+            !same_tree(a->first_child, b->first_child)) {
+            return false;
+        }
+    }
+    return a == NULL && b == NULL;
+}
+
+/* Get the path of the only file in the cache directory */
+static void cache_file_path(char *buf, size_t size) {
+    DIR *dir = opendir(cache_dir);
+    ASSERT(dir != NULL, "cache directory should exist");
+    struct dirent *entry;
+    buf[0] = '\0';
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            snprintf(buf, size, "%s/%s", cache_dir, entry->d_name);
+        }
+    }
+    closedir(dir);
+    ASSERT(buf[0] != '\0', "cache file should be written");
+}
+
+static void clear_disk_cache(void) {
+    char file[320];
+    DIR *dir = opendir(cache_dir);
+    if (!dir) {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            snprintf(file, sizeof(file), "%s/%s", cache_dir, entry->d_name);
+            unlink(file);
+        }
+    }
+    closedir(dir);
+}
+
+static const char *disk_script =
+    "echo one | cat |& cat\n"
+    "f() {\n  local x=1\n  echo \"$x\" > /dev/null\n}\n"
+    "case $1 in a) echo a ;& b) echo b ;; esac\n"
+    "time -p true\n"
+    "while false; do :; done && ! true || echo 'quoted word'\n";
+
+TEST(disk_round_trip) {
+    clear_disk_cache();
+    script_cache_set_disk_dir(cache_dir);
+    write_script(disk_script);
+
+    script_cache_stats_t before, after;
+    script_cache_get_stats(&before);
+    script_ast_t *parsed = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    ASSERT(parsed != NULL, "script should parse");
+    script_ast_t *loaded = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    ASSERT(loaded != NULL, "script should load from disk");
+    script_cache_get_stats(&after);
+    ASSERT_EQ(after.disk_writes - before.disk_writes, 1, "one cache write");
+    ASSERT_EQ(after.disk_hits - before.disk_hits, 1, "one cache load");
+
+    ASSERT(same_tree(script_ast_commands(parsed),
+                     script_ast_commands(loaded)),
+           "decoded tree should match the parsed tree");
+    node_t *echo = script_ast_commands(loaded)->first_child;
+    ASSERT(echo->loc.filename && strcmp(echo->loc.filename, script_path) == 0,
+           "decoded nodes name the script file");
+    script_ast_release(parsed);
+    script_ast_release(loaded);
+
+    write_script("");
+    parsed = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    loaded = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    ASSERT(parsed && loaded && script_ast_commands(loaded) == NULL,
+           "empty script should round trip");
+    script_ast_release(parsed);
+    script_ast_release(loaded);
+    script_cache_set_disk_dir(NULL);
+}
+
+TEST(disk_invalidation) {
+    clear_disk_cache();
+    script_cache_set_disk_dir(cache_dir);
+    write_script("echo old\n");
+    script_ast_release(script_ast_load(script_path, SCRIPT_CACHE_DISK));
+
+    write_script("echo new\necho lines\n");
+    script_cache_stats_t before, after;
+    script_cache_get_stats(&before);
+    script_ast_t *script = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    script_cache_get_stats(&after);
+    ASSERT_EQ(after.disk_hits - before.disk_hits, 0,
+              "changed file should not load the old cache file");
+    ASSERT_EQ(count_commands(script), 2, "changed file should be reparsed");
+    script_ast_release(script);
+
+    script = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    script_cache_get_stats(&after);
+    ASSERT_EQ(after.disk_hits - before.disk_hits, 1,
+              "rewritten cache file should load");
+    ASSERT_EQ(count_commands(script), 2, "rewritten cache file is current");
+    script_ast_release(script);
+    script_cache_set_disk_dir(NULL);
+}
+
+TEST(disk_corrupt_file) {
+    clear_disk_cache();
+    script_cache_set_disk_dir(cache_dir);
+    write_script("echo a\necho b\n");
+    script_ast_release(script_ast_load(script_path, SCRIPT_CACHE_DISK));
+
+    char file[320];
+    cache_file_path(file, sizeof(file));
+    struct stat st;
+    ASSERT(stat(file, &st) == 0, "cache file should exist");
+    ASSERT_EQ(st.st_mode & 0777, 0600, "cache file is private");
+
+    /* Truncated and garbled cache files are parsed over */
+    ASSERT(truncate(file, st.st_size - 3) == 0, "truncate should succeed");
+    script_cache_stats_t before, after;
+    script_cache_get_stats(&before);
+    script_ast_t *script = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    ASSERT_EQ(count_commands(script), 2, "truncated cache file is ignored");
+    script_ast_release(script);
+
+    int fd = open(file, O_WRONLY);
+    ASSERT(fd >= 0, "cache file should be writable");
+    /* The parse above rewrote the file; unterminate its last string */
+    ASSERT(pwrite(fd, "x", 1, st.st_size - 1) == 1, "garbling should succeed");
+    close(fd);
+    script = script_ast_load(script_path, SCRIPT_CACHE_DISK);
+    ASSERT_EQ(count_commands(script), 2, "garbled cache file is ignored");
+    script_ast_release(script);
+
+    script_cache_get_stats(&after);
+    ASSERT_EQ(after.disk_hits - before.disk_hits, 0, "no cache file loaded");
+    script_cache_set_disk_dir(NULL);
+}
+
+TEST(disk_disabled) {
+    clear_disk_cache();
+    write_script("echo plain\n");
+    script_cache_stats_t before, after;
+    script_cache_get_stats(&before);
+    script_ast_release(script_ast_load(script_path, SCRIPT_CACHE_DISK));
+    script_cache_get_stats(&after);
+    ASSERT_EQ(after.disk_writes - before.disk_writes, 0,
+              "no cache file without a cache directory");
+}
+
+int main(void) {
+    snprintf(script_path, sizeof(script_path), "/tmp/lush_script_%d.sh",
+             (int)getpid());
+    snprintf(cache_dir, sizeof(cache_dir), "/tmp/lush_ast_%d/nested/ast",
+             (int)getpid());
+
+    printf("========================================\n");
+    printf("Script Cache Unit Tests\n");
+    printf("========================================\n");
+
+    printf("\nParsing tests:\n");
+    RUN_TEST(top_level_commands);
+    RUN_TEST(empty_file);
+    RUN_TEST(line_continuations);
+    RUN_TEST(page_sized_file);
+    RUN_TEST(not_loaded);
+
+    printf("\nCache tests:\n");
+    RUN_TEST(cache_reuse);
+    RUN_TEST(cache_revalidation);
+    RUN_TEST(uncached_load);
+
+    printf("\nOn-disk cache tests:\n");
+    RUN_TEST(disk_round_trip);
+    RUN_TEST(disk_invalidation);
+    RUN_TEST(disk_corrupt_file);
+    RUN_TEST(disk_disabled);
+
+    script_cache_clear();
+    clear_disk_cache();
+    unlink(script_path);
+    char dir[64];
+    snprintf(dir, sizeof(dir), "/tmp/lush_ast_%d/nested/ast", (int)getpid());
+    rmdir(dir);
+    snprintf(dir, sizeof(dir), "/tmp/lush_ast_%d/nested", (int)getpid());
+    rmdir(dir);
+    snprintf(dir, sizeof(dir), "/tmp/lush_ast_%d", (int)getpid());
+    rmdir(dir);
+
+    printf("\n========================================\n");
+    printf("All script cache tests PASSED!\n");
+    printf("========================================\n");
+    return 0;
+}
@@ -182,6 +182,72 @@ TEST(var_exists) {
     symtable_manager_free(mgr);
 }
 
+TEST(borrowed_reference) {
+    symtable_manager_t *mgr = symtable_manager_new();
+    ASSERT_NOT_NULL(mgr, "symtable_manager_new failed");
+    
+    symtable_set_var(mgr, "FOO", "bar", SYMVAR_NONE);
+    
+    const char *ref = symtable_get_var_ref(mgr, "FOO");
+    ASSERT_STR_EQ(ref, "bar", "Borrowed value mismatch");
+    ASSERT(ref == symtable_get_var_ref(mgr, "FOO"),
+           "Repeated reads should return the same storage");
+    ASSERT_NULL(symtable_get_var_ref(mgr, "NONEXISTENT"),
+                "Non-existent variable should return NULL");
+    
+    /* Assigning a value borrowed from the same record must be safe */
+    symtable_set_var(mgr, "FOO", "a much longer value than before", SYMVAR_NONE);
+    ref = symtable_get_var_ref(mgr, "FOO");
+    symtable_set_var(mgr, "FOO", ref + 2, SYMVAR_NONE);
+    ASSERT_STR_EQ(symtable_get_var_ref(mgr, "FOO"),
+                  "much longer value than before", "Aliased assignment failed");
+    
+    symtable_manager_free(mgr);
+}
+
+TEST(integer_cache) {
+    symtable_manager_t *mgr = symtable_manager_new();
+    ASSERT_NOT_NULL(mgr, "symtable_manager_new failed");
+    
+    long long value = 0;
+    ASSERT(!symtable_get_var_integer(mgr, "N", &value),
+           "Missing variable should not convert");
+    
+    symtable_set_var(mgr, "N", "41", SYMVAR_NONE);
+    ASSERT(symtable_get_var_integer(mgr, "N", &value), "Lookup should succeed");
+    ASSERT_EQ(value, 41, "Integer conversion mismatch");
+    
+    /* Cache must be invalidated by assignment */
+    symtable_set_var(mgr, "N", "42", SYMVAR_NONE);
+    ASSERT(symtable_get_var_integer(mgr, "N", &value), "Lookup should succeed");
+    ASSERT_EQ(value, 42, "Stale integer cache after assignment");
+    
+    symtable_set_var(mgr, "S", "abc", SYMVAR_NONE);
+    ASSERT(symtable_get_var_integer(mgr, "S", &value), "Lookup should succeed");
+    ASSERT_EQ(value, 0, "Non-numeric value should convert to 0");
+    
+    symtable_manager_free(mgr);
+}
+
+TEST(lookup_record) {
+    symtable_manager_t *mgr = symtable_manager_new();
+    ASSERT_NOT_NULL(mgr, "symtable_manager_new failed");
+    
+    symtable_set_var(mgr, "FOO", "bar", SYMVAR_EXPORTED);
+    
+    const symvar_t *var = symtable_lookup_var(mgr, "FOO");
+    ASSERT_NOT_NULL(var, "symtable_lookup_var should find FOO");
+    ASSERT_STR_EQ(var->value, "bar", "Record value mismatch");
+    ASSERT_EQ(var->value_len, 3, "Record length mismatch");
+    ASSERT(var->flags & SYMVAR_EXPORTED, "Record flags mismatch");
+    
+    symtable_unset_var(mgr, "FOO");
+    ASSERT_NULL(symtable_lookup_var(mgr, "FOO"),
+                "Unset variable should not be found");
+    
+    symtable_manager_free(mgr);
+}
+
 /* ============================================================================
  * SCOPE MANAGEMENT TESTS
  * ============================================================================
@@ -501,6 +567,9 @@ int main(void) {
     RUN_TEST(get_nonexistent_variable);
     RUN_TEST(unset_variable);
     RUN_TEST(var_exists);
+    RUN_TEST(borrowed_reference);
+    RUN_TEST(integer_cache);
+    RUN_TEST(lookup_record);
     
     printf("\nScope management tests:\n");
     RUN_TEST(push_pop_scope);